@@ -50,6 +50,7 @@
 #define MATPARTITIONING_PARMETIS 'parmetis'
 
 #define MATCOARSEN_MIS 'mis'
+#define MATCOARSEN_MIS2 'mis2'
 
 #define MATCOLORINGNATURAL 'natural'
 #define MATCOLORINGSL      'sl'
@@ -113,8 +113,10 @@
       PetscEnum PC_MG_FULL
       PetscEnum PC_MG_KASKADE
       PetscEnum PC_MG_CASCADE
+      PetscEnum PC_MG_MULTIADDITIVE
       parameter (PC_MG_MULTIPLICATIVE=0,PC_MG_ADDITIVE=1)
       parameter (PC_MG_FULL=2,PC_MG_KASKADE=3)
+      parameter (PC_MG_MULTIADDITIVE=4)
       parameter (PC_MG_CASCADE=3)
 
 ! PCMGCycleType
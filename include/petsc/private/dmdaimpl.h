@@ -41,6 +41,8 @@ typedef struct {
   Vec                   natural;            /* global vector for storing items in natural order */
   VecScatter            gton;               /* vector scatter from global to natural */
   PetscMPIInt           *neighbors;         /* ranks of all neighbors and self */
+  PetscBool             topologyaware;      /* place neighboring subdomains on the same node, see DMDASetTopologyAware() */
+  PetscMPIInt           *rankmap;           /* rank owning each subdomain in lexicographic order, or NULL if it is the subdomain index */
 
   ISColoring            localcoloring;       /* set by DMCreateColoring() */
   ISColoring            ghostedcoloring;
@@ -94,7 +96,8 @@ PETSC_EXTERN PetscErrorCode DMView_DA_Binary(DM,PetscViewer);
 PETSC_EXTERN PetscErrorCode DMView_DA_VTK(DM,PetscViewer);
 PETSC_EXTERN PetscErrorCode DMDAVTKWriteAll(PetscObject,PetscViewer);
 PETSC_EXTERN PetscErrorCode DMDASelectFields(DM,PetscInt*,PetscInt**);
+PETSC_INTERN PetscErrorCode DMDASetUpRankMap_Private(DM,PetscInt,PetscInt,PetscInt,PetscMPIInt*);
 
-PETSC_EXTERN PetscLogEvent DMDA_LocalADFunction;
+PETSC_EXTERN PetscLogEvent DMDA_LocalADFunction, DMDA_StencilMult;
 
 #endif
@@ -9,7 +9,7 @@
 #include <petsc/private/isimpl.h>     /* for inline access to atlasOff */
 #include <../src/sys/utils/hash.h>
 
-PETSC_EXTERN PetscLogEvent DMPLEX_Interpolate, PETSCPARTITIONER_Partition, DMPLEX_Distribute, DMPLEX_DistributeCones, DMPLEX_DistributeLabels, DMPLEX_DistributeSF, DMPLEX_DistributeOverlap, DMPLEX_DistributeField, DMPLEX_DistributeData, DMPLEX_Migrate, DMPLEX_Stratify, DMPLEX_Preallocate, DMPLEX_ResidualFEM, DMPLEX_JacobianFEM, DMPLEX_InterpolatorFEM, DMPLEX_InjectorFEM, DMPLEX_IntegralFEM, DMPLEX_CreateGmsh;
+PETSC_EXTERN PetscLogEvent DMPLEX_Interpolate, PETSCPARTITIONER_Partition, DMPLEX_Distribute, DMPLEX_DistributeCones, DMPLEX_DistributeLabels, DMPLEX_DistributeSF, DMPLEX_DistributeOverlap, DMPLEX_DistributeField, DMPLEX_DistributeData, DMPLEX_Migrate, DMPLEX_Rebalance, DMPLEX_Reorder, DMPLEX_Adapt, DMPLEX_Stratify, DMPLEX_Preallocate, DMPLEX_ResidualFEM, DMPLEX_JacobianFEM, DMPLEX_JacobianActionFEM, DMPLEX_InterpolatorFEM, DMPLEX_InjectorFEM, DMPLEX_IntegralFEM, DMPLEX_CreateGmsh;
 
 PETSC_EXTERN PetscBool      PetscPartitionerRegisterAllCalled;
 PETSC_EXTERN PetscErrorCode PetscPartitionerRegisterAll(void);
@@ -28,7 +28,7 @@ typedef enum {REFINER_NOOP = 0,
 
 typedef struct _PetscPartitionerOps *PetscPartitionerOps;
 struct _PetscPartitionerOps {
-  PetscErrorCode (*setfromoptions)(PetscPartitioner);
+  PetscErrorCode (*setfromoptions)(PetscOptions*,PetscPartitioner);
   PetscErrorCode (*setup)(PetscPartitioner);
   PetscErrorCode (*view)(PetscPartitioner,PetscViewer);
   PetscErrorCode (*destroy)(PetscPartitioner);
@@ -39,6 +39,13 @@ struct _p_PetscPartitioner {
   PETSCHEADER(struct _PetscPartitionerOps);
   void           *data;             /* Implementation object */
   PetscInt        height;           /* Height of points to partition into non-overlapping subsets */
+  PetscInt        ncon;             /* Number of weights per graph vertex, 0 for an unweighted graph */
+  PetscInt        numWeights;       /* Number of points with user weights */
+  PetscInt       *weights;          /* User weights, ncon for each point of the partitioned stratum */
+  PetscBool       faceDofWeights;   /* Weight graph edges by the dofs in the closure of the shared face */
+  PetscBool       topologyAware;    /* Number the parts so that neighboring parts go to processes on the same node */
+  PetscInt       *vwgt;             /* Vertex weights of the graph being partitioned, or NULL */
+  PetscInt       *adjwgt;           /* Edge weights of the graph being partitioned, or NULL */
 };
 
 typedef struct {
@@ -58,11 +65,16 @@ typedef struct {
   PetscInt dummy;
 } PetscPartitioner_Simple;
 
+typedef struct {
+  PetscInt maxIts; /* Maximum number of bisection steps to find each cut */
+} PetscPartitioner_RCB;
+
 /* This is an integer map, in addition it is also a container class
    Design points:
      - Low storage is the most important design point
      - We want flexible insertion and deletion
      - We can live with O(log) query, but we need O(1) iteration over strata
+     - Point and value lookup go through hash tables built on demand, so that they stay O(1) for large meshes
 */
 struct _n_DMLabel {
   PetscInt    refct;
@@ -75,6 +87,9 @@ struct _n_DMLabel {
   PetscInt  **points;         /* Points for each stratum, always sorted */
   /* Hashtable for fast insertion */
   PetscHashI *ht;             /* Hash table for fast insertion */
+  /* Hashtables for fast lookup */
+  PetscHashI  valueht;        /* Map from value to stratum, built on demand */
+  PetscHashI  pointht;        /* Map from point to the first stratum containing it, built on demand */
   /* Index for fast search */
   PetscInt    pStart, pEnd;   /* Bounds for index lookup */
   PetscBT     bt;             /* A bit-wise index */
@@ -143,11 +158,15 @@ typedef struct {
 
   /* Hierarchy */
   DM                   coarseMesh;        /* This mesh was obtained from coarse mesh using DMRefineHierarchy() */
+  DMLabel              adaptMarker;       /* Cells of coarseMesh marked for refinement by DMPlexAdaptLabel() */
+  IS                   adaptParents;      /* Cell of coarseMesh from which each cell was created by DMPlexAdaptLabel() */
+  PetscReal            adaptRebalanceThreshold; /* Redistribute after DMPlexAdaptLabel() when the cell imbalance exceeds this ratio, ignored if not positive */
 
   /* Generation */
   char                *tetgenOpts;
   char                *triangleOpts;
   PetscPartitioner     partitioner;
+  DMPlexReorderType    reorderType;       /* Reordering of local points applied after distribution */
 
   /* Submesh */
   DMLabel              subpointMap;       /* Label each original mesh point in the submesh with its depth, subpoint are the implicit numbering */
@@ -178,6 +197,9 @@ typedef struct {
   PetscBool            useClosure;        /* Use the transitive closure when defining adjacency */
   PetscBool            useAnchors;        /* Replace constrained points with their anchors in adjacency lists */
 
+  /* Closure */
+  PetscBool            closureDofIndex;   /* Index the dofs in the closure of each cell, off by default */
+
   /* Projection */
   PetscInt             maxProjectionHeight; /* maximum height of cells used in DMPlexProject functions */
 
@@ -204,6 +226,9 @@ PETSC_EXTERN PetscErrorCode VecView_Plex_Local(Vec,PetscViewer);
 PETSC_EXTERN PetscErrorCode VecView_Plex(Vec,PetscViewer);
 PETSC_EXTERN PetscErrorCode VecLoad_Plex_Local(Vec,PetscViewer);
 PETSC_EXTERN PetscErrorCode VecLoad_Plex(Vec,PetscViewer);
+PETSC_EXTERN PetscErrorCode indicesPoint_private(PetscSection,PetscInt,PetscInt,PetscInt *,PetscBool,PetscInt,PetscInt[]);
+PETSC_EXTERN PetscErrorCode indicesPointFields_private(PetscSection,PetscInt,PetscInt,PetscInt[],PetscBool,PetscInt,PetscInt[]);
+PETSC_EXTERN PetscErrorCode DMPlexGetClosureDofIndex_Internal(DM, PetscSection, PetscSection, PetscInt *, PetscInt *, const PetscInt *[], const PetscInt *[]);
 PETSC_EXTERN PetscErrorCode DMPlexGetFieldType_Internal(DM, PetscSection, PetscInt, PetscInt *, PetscInt *, PetscViewerVTKFieldType *);
 #if defined(PETSC_HAVE_HDF5)
 PETSC_EXTERN PetscErrorCode VecView_Plex_Local_HDF5(Vec, PetscViewer);
@@ -223,6 +248,7 @@ PETSC_EXTERN PetscErrorCode CellRefinerGetAffineTransforms_Internal(CellRefiner,
 PETSC_EXTERN PetscErrorCode CellRefinerRestoreAffineTransforms_Internal(CellRefiner, PetscInt *, PetscReal *[], PetscReal *[], PetscReal *[]);
 PETSC_EXTERN PetscErrorCode CellRefinerInCellTest_Internal(CellRefiner, const PetscReal[], PetscBool *);
 PETSC_EXTERN PetscErrorCode DMPlexCreateGmsh_ReadElement(PetscViewer, PetscInt, PetscBool, PetscBool, GmshElement **);
+PETSC_EXTERN PetscErrorCode DMPlexSetLabelFromVertexSlabs_Internal(DM, PetscSF, const char[], PetscInt, const PetscInt[], const PetscInt[], const PetscInt[]);
 PETSC_EXTERN PetscErrorCode DMPlexInvertCell_Internal(PetscInt, PetscInt, PetscInt[]);
 PETSC_EXTERN PetscErrorCode DMPlexLocalizeCoordinate_Internal(DM, PetscInt, const PetscScalar[], const PetscScalar[], PetscScalar[]);
 PETSC_EXTERN PetscErrorCode DMPlexLocalizeCoordinateReal_Internal(DM, PetscInt, const PetscReal[], const PetscReal[], PetscReal[]);
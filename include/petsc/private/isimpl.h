@@ -95,6 +95,11 @@ struct _p_PetscSection {
   PetscObject                   clObj;        /* Key for the closure (right now we only have one) */
   PetscSection                  clSection;    /* Section giving the number of points in each closure */
   IS                            clPoints;     /* Points in each closure */
+  PetscObjectId                 clDofId;      /* Id of the key for the closure dof index, or 0; its address may be reused */
+  PetscObjectState              clDofState;   /* State of the key when the closure dof index was made */
+  PetscInt                      clDofStart, clDofEnd; /* The points with an entry in the closure dof index */
+  PetscInt                     *clDofOff;     /* Offset of the closure of each point in clDofs */
+  PetscInt                     *clDofs;       /* Dof indices in each closure, with orientations applied and constrained dofs stored as -(index+1) */
 };
 
 
@@ -22,6 +22,7 @@ typedef struct gamg_TAG {
   PetscInt  setup_count;
   PetscBool repart;
   PetscBool reuse_prol;
+  PetscBool ptap_coarse;    /* all coarse operators were made by MatPtAP(), so a resetup can reuse the symbolic products */
   PetscBool use_aggs_in_gasm;
   PetscInt  min_eq_proc;
   PetscInt  coarse_eq_limit;
@@ -30,13 +30,24 @@ typedef struct {
   PetscLogEvent eventsmoothsolve;
   PetscLogEvent eventresidual;
   PetscLogEvent eventinterprestrict;
+
+  PetscSubcomm  aggsubcomm;                    /* processes holding the level when it is agglomerated (color 0), NULL otherwise */
+  IS            aggis;                         /* rows of the agglomerated level held by this process */
+  Mat           *aggAseq;                      /* these rows of the level operator */
+  Mat           aggA;                          /* level operator on the subcommunicator */
+  KSP           aggsmoothd,aggsmoothu;         /* smoothers on the subcommunicator */
+  Vec           aggb,aggx,aggr;                /* level vectors on the subcommunicator, they share the arrays of b, x and r */
+  Mat           agginterp,aggrestrct;          /* transfers to the next coarser level when it is agglomerated */
+
+  Vec           l1dinv;                        /* inverse l1 row sums of the operator, for the multiadditive cycle */
+  Vec           work;                          /* work vector of the multiadditive cycle */
 } PC_MG_Levels;
 
 /*
     This data structure is shared by all the levels.
 */
 typedef struct {
-  PCMGType  am;                               /* Multiplicative, additive or full */
+  PCMGType  am;                               /* Multiplicative, additive, full, Kaskade or multiadditive */
   PetscInt  cyclesperpcapply;                 /* Number of cycles to use in each PCApply(), multiplicative only*/
   PetscInt  maxlevels;                        /* total number of levels allocated */
   PetscInt  galerkin;                         /* use Galerkin process to compute coarser matrices, 0=no, 1=yes, 2=yes but computed externally */
@@ -51,12 +62,20 @@ typedef struct {
   void          *innerctx;                    /* optional data for preconditioner, like PCEXOTIC that inherits off of PCMG */
   PetscLogStage stageApply;
   PetscErrorCode (*view)(PC,PetscViewer);     /* GAMG and other objects that use PCMG can set their own viewer here */
+  PetscInt      proceqlim;                    /* coarse levels with fewer equations per process are agglomerated */
+  PetscBool     l1dinvvalid;                  /* the scaling of the multiadditive cycle matches the current operators */
 } PC_MG;
 
 PETSC_INTERN PetscErrorCode PCSetUp_MG(PC);
 PETSC_INTERN PetscErrorCode PCDestroy_MG(PC);
 PETSC_INTERN PetscErrorCode PCSetFromOptions_MG(PetscOptions *PetscOptionsObject,PC);
 PETSC_INTERN PetscErrorCode PCView_MG(PC,PetscViewer);
+PETSC_INTERN PetscErrorCode PCMGLevelSmooth_Private(PC_MG_Levels*,KSP);
+PETSC_INTERN PetscErrorCode PCMGLevelResidual_Private(PC_MG_Levels*,Vec,Vec,Vec);
+
+/* The transfers used in the cycles, they are in the agglomerated layouts when the coarser level is agglomerated */
+PETSC_STATIC_INLINE Mat PCMGLevelRestriction(PC_MG_Levels *mglevels) {return mglevels->aggrestrct ? mglevels->aggrestrct : mglevels->restrct;}
+PETSC_STATIC_INLINE Mat PCMGLevelInterpolation(PC_MG_Levels *mglevels) {return mglevels->agginterp ? mglevels->agginterp : mglevels->interpolate;}
 PETSC_DEPRECATED("Use PCMGResidualDefault()") PETSC_STATIC_INLINE PetscErrorCode PCMGResidual_Default(Mat A,Vec b,Vec x,Vec r) {
   return PCMGResidualDefault(A,b,x,r);
 }
@@ -29,6 +29,8 @@ struct _p_PetscDS {
   PetscPointJac    *g;    /* Weak form integrands g_0, g_1, g_2, g_3 */
   PetscBdPointFunc *fBd;  /* Weak form boundary integrands f_0, f_1 */
   PetscBdPointJac  *gBd;  /* Weak form boundary integrands g_0, g_1, g_2, g_3 */
+  PetscPointFuncBatch *fBatch; /* Batched weak form integrands f_0, f_1, evaluated on blocks of quadrature points */
+  PetscPointJacBatch  *gBatch; /* Batched weak form integrands g_0, g_1, g_2, g_3, evaluated on blocks of quadrature points */
   PetscRiemannFunc *r;    /* Riemann solvers */
   void       **ctx;       /* User contexts for each field */
   PetscInt     dim;       /* The spatial dimension */
@@ -40,6 +42,7 @@ struct _p_PetscDS {
   PetscInt    *offDer,    *offDerBd;   /* Derivative offsets for each field */
   PetscReal  **basis,    **basisBd;    /* Default basis tabulation for each field */
   PetscReal  **basisDer, **basisDerBd; /* Default basis derivative tabulation for each field */
+  PetscReal  **basisT,   **basisDerT;  /* Point-minor copies of the default tabulation, built on demand for batched evaluation */
   PetscScalar *u;                      /* Field evaluation */
   PetscScalar *u_t;                    /* Field time derivative evaluation */
   PetscScalar *u_x;                    /* Field gradient evaluation */
@@ -141,6 +141,9 @@ typedef struct {
   PetscInt     *embedding;      /* Map from subelements dofs to element dofs */
 } PetscFE_Composite;
 
+/* Target number of quadrature points passed to a batched pointwise function in one call */
+#define PETSCFE_BATCH_POINTS 128
+
 /* Utility functions */
 #undef __FUNCT__
 #define __FUNCT__ "CoordinatesRefToReal"
@@ -53,6 +53,7 @@ typedef struct _TSTrajectoryOps *TSTrajectoryOps;
 struct _TSTrajectoryOps {
   PetscErrorCode (*view)(TSTrajectory,PetscViewer);
   PetscErrorCode (*destroy)(TSTrajectory);
+  PetscErrorCode (*setfromoptions)(PetscOptions*,TSTrajectory);
   PetscErrorCode (*set)(TSTrajectory,TS,PetscInt,PetscReal,Vec);
   PetscErrorCode (*get)(TSTrajectory,TS,PetscInt,PetscReal*);
 };
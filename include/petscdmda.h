@@ -102,6 +102,8 @@ PETSC_EXTERN PetscErrorCode DMDASetOwnershipRanges(DM,const PetscInt[],const Pet
 PETSC_EXTERN PetscErrorCode DMDAGetOwnershipRanges(DM,const PetscInt**,const PetscInt**,const PetscInt**);
 PETSC_EXTERN PetscErrorCode DMDASetNumProcs(DM, PetscInt, PetscInt, PetscInt);
 PETSC_EXTERN PetscErrorCode DMDASetStencilType(DM, DMDAStencilType);
+PETSC_EXTERN PetscErrorCode DMDASetTopologyAware(DM,PetscBool);
+PETSC_EXTERN PetscErrorCode DMDAGetTopologyAware(DM,PetscBool*);
 
 PETSC_EXTERN PetscErrorCode DMDAVecGetArray(DM,Vec,void *);
 PETSC_EXTERN PetscErrorCode DMDAVecRestoreArray(DM,Vec,void *);
@@ -181,6 +183,8 @@ PETSC_EXTERN PetscErrorCode MatCreateDAAD(DM,Mat*);
 PETSC_EXTERN PetscErrorCode MatCreateSeqUSFFT(Vec,DM,Mat*);
 
 PETSC_EXTERN PetscErrorCode DMDASetGetMatrix(DM,PetscErrorCode (*)(DM, Mat *));
+PETSC_EXTERN PetscErrorCode DMDACreateStencilOperator(DM,PetscInt,const PetscInt[],const MatStencil[],const PetscScalar[],Mat*);
+PETSC_EXTERN PetscErrorCode DMDAStencilOperatorSetCoefficients(Mat,Vec);
 PETSC_EXTERN PetscErrorCode DMDASetBlockFills(DM,const PetscInt*,const PetscInt*);
 PETSC_EXTERN PetscErrorCode DMDASetRefinementFactor(DM,PetscInt,PetscInt,PetscInt);
 PETSC_EXTERN PetscErrorCode DMDAGetRefinementFactor(DM,PetscInt*,PetscInt*,PetscInt*);
@@ -24,6 +24,7 @@ typedef const char *PetscPartitionerType;
 #define PETSCPARTITIONERPARMETIS "parmetis"
 #define PETSCPARTITIONERSHELL    "shell"
 #define PETSCPARTITIONERSIMPLE   "simple"
+#define PETSCPARTITIONERRCB      "rcb"
 
 PETSC_EXTERN PetscFunctionList PetscPartitionerList;
 PETSC_EXTERN PetscErrorCode PetscPartitionerCreate(MPI_Comm, PetscPartitioner *);
@@ -38,12 +39,18 @@ PETSC_EXTERN PetscErrorCode PetscPartitionerRegister(const char [], PetscErrorCo
 PETSC_EXTERN PetscErrorCode PetscPartitionerRegisterDestroy(void);
 
 PETSC_EXTERN PetscErrorCode PetscPartitionerPartition(PetscPartitioner, DM, PetscSection, IS *);
+PETSC_EXTERN PetscErrorCode PetscPartitionerSetVertexWeights(PetscPartitioner, PetscInt, PetscInt, const PetscInt[]);
+PETSC_EXTERN PetscErrorCode PetscPartitionerSetFaceDofWeights(PetscPartitioner, PetscBool);
+PETSC_EXTERN PetscErrorCode PetscPartitionerGetFaceDofWeights(PetscPartitioner, PetscBool *);
+PETSC_EXTERN PetscErrorCode PetscPartitionerSetTopologyAware(PetscPartitioner, PetscBool);
+PETSC_EXTERN PetscErrorCode PetscPartitionerGetTopologyAware(PetscPartitioner, PetscBool *);
 
 PETSC_EXTERN PetscErrorCode PetscPartitionerShellSetPartition(PetscPartitioner, PetscInt, const PetscInt[], const PetscInt[]);
 
 PETSC_EXTERN PetscErrorCode DMPlexCreate(MPI_Comm, DM*);
 PETSC_EXTERN PetscErrorCode DMPlexCreateCohesiveSubmesh(DM, PetscBool, const char [], PetscInt, DM *);
 PETSC_EXTERN PetscErrorCode DMPlexCreateFromCellList(MPI_Comm, PetscInt, PetscInt, PetscInt, PetscInt, PetscBool, const int[], PetscInt, const double[], DM*);
+PETSC_EXTERN PetscErrorCode DMPlexCreateFromCellListParallel(MPI_Comm, PetscInt, PetscInt, PetscInt, PetscInt, PetscBool, const int[], PetscInt, const double[], PetscSF*, DM*);
 PETSC_EXTERN PetscErrorCode DMPlexCreateFromDAG(DM, PetscInt, const PetscInt [], const PetscInt [], const PetscInt [], const PetscInt [], const PetscScalar []);
 PETSC_EXTERN PetscErrorCode DMPlexCreateReferenceCell(MPI_Comm, PetscInt, PetscBool, DM*);
 PETSC_EXTERN PetscErrorCode DMPlexGetChart(DM, PetscInt *, PetscInt *);
@@ -108,12 +115,15 @@ PETSC_EXTERN PetscErrorCode DMLabelGetValue(DMLabel, PetscInt, PetscInt *);
 PETSC_EXTERN PetscErrorCode DMLabelSetValue(DMLabel, PetscInt, PetscInt);
 PETSC_EXTERN PetscErrorCode DMLabelClearValue(DMLabel, PetscInt, PetscInt);
 PETSC_EXTERN PetscErrorCode DMLabelInsertIS(DMLabel, IS, PetscInt);
+PETSC_EXTERN PetscErrorCode DMLabelSetStratumIS(DMLabel, PetscInt, IS);
 PETSC_EXTERN PetscErrorCode DMLabelGetNumValues(DMLabel, PetscInt *);
 PETSC_EXTERN PetscErrorCode DMLabelGetStratumBounds(DMLabel, PetscInt, PetscInt *, PetscInt *);
 PETSC_EXTERN PetscErrorCode DMLabelGetValueIS(DMLabel, IS *);
 PETSC_EXTERN PetscErrorCode DMLabelStratumHasPoint(DMLabel, PetscInt, PetscInt, PetscBool *);
 PETSC_EXTERN PetscErrorCode DMLabelGetStratumSize(DMLabel, PetscInt, PetscInt *);
 PETSC_EXTERN PetscErrorCode DMLabelGetStratumIS(DMLabel, PetscInt, IS *);
+PETSC_EXTERN PetscErrorCode DMLabelGetStrataUnion(DMLabel, PetscInt, const PetscInt[], IS *);
+PETSC_EXTERN PetscErrorCode DMLabelGetStrataIntersection(DMLabel, PetscInt, const PetscInt[], IS *);
 PETSC_EXTERN PetscErrorCode DMLabelClearStratum(DMLabel, PetscInt);
 PETSC_EXTERN PetscErrorCode DMLabelCreateIndex(DMLabel, PetscInt, PetscInt);
 PETSC_EXTERN PetscErrorCode DMLabelDestroyIndex(DMLabel);
@@ -200,6 +210,7 @@ PETSC_EXTERN PetscErrorCode DMPlexDistributeField(DM,PetscSF,PetscSection,Vec,Pe
 PETSC_EXTERN PetscErrorCode DMPlexDistributeFieldIS(DM, PetscSF, PetscSection, IS, PetscSection, IS *);
 PETSC_EXTERN PetscErrorCode DMPlexDistributeData(DM,PetscSF,PetscSection,MPI_Datatype,void*,PetscSection,void**);
 PETSC_EXTERN PetscErrorCode DMPlexMigrate(DM, PetscSF, DM);
+PETSC_EXTERN PetscErrorCode DMPlexRebalance(DM, PetscInt *, PetscSF *, DM *);
 PETSC_EXTERN PetscErrorCode DMPlexSetAdjacencyUseCone(DM,PetscBool);
 PETSC_EXTERN PetscErrorCode DMPlexGetAdjacencyUseCone(DM,PetscBool*);
 PETSC_EXTERN PetscErrorCode DMPlexSetAdjacencyUseClosure(DM,PetscBool);
@@ -211,6 +222,24 @@ PETSC_EXTERN PetscErrorCode DMPlexGetAdjacency(DM, PetscInt, PetscInt *, PetscIn
 PETSC_EXTERN PetscErrorCode DMPlexGetOrdering(DM, MatOrderingType, IS *);
 PETSC_EXTERN PetscErrorCode DMPlexPermute(DM, IS, DM *);
 
+/*E
+  DMPlexReorderType - Reordering of the local mesh points for cache locality
+
+$  DMPLEX_REORDER_NONE    - Keep the order produced by distribution
+$  DMPLEX_REORDER_RCM     - Reverse Cuthill-McKee ordering of the cell adjacency graph
+$  DMPLEX_REORDER_HILBERT - Order cells by their centroid along a Hilbert curve
+$  DMPLEX_REORDER_MORTON  - Order cells by their centroid along a Morton (Z-order) curve
+
+  Level: intermediate
+
+.seealso: DMPlexReorder(), DMPlexSetReorderType()
+E*/
+typedef enum {DMPLEX_REORDER_NONE, DMPLEX_REORDER_RCM, DMPLEX_REORDER_HILBERT, DMPLEX_REORDER_MORTON} DMPlexReorderType;
+PETSC_EXTERN const char *const DMPlexReorderTypes[];
+PETSC_EXTERN PetscErrorCode DMPlexSetReorderType(DM, DMPlexReorderType);
+PETSC_EXTERN PetscErrorCode DMPlexGetReorderType(DM, DMPlexReorderType *);
+PETSC_EXTERN PetscErrorCode DMPlexReorder(DM, DMPlexReorderType, IS *, DM *);
+
 PETSC_EXTERN PetscErrorCode DMPlexCreateProcessSF(DM, PetscSF, IS *, PetscSF *);
 PETSC_EXTERN PetscErrorCode DMPlexCreateTwoSidedProcessSF(DM, PetscSF, PetscSection, IS, PetscSection, IS, IS *, PetscSF *);
 PETSC_EXTERN PetscErrorCode DMPlexDistributeOwnership(DM, PetscSection, IS *, PetscSection, IS *);
@@ -238,6 +267,23 @@ PETSC_EXTERN PetscErrorCode DMPlexGetCoarseDM(DM, DM *);
 PETSC_EXTERN PetscErrorCode DMPlexSetCoarseDM(DM, DM);
 PETSC_EXTERN PetscErrorCode DMPlexCreateCoarsePointIS(DM, IS *);
 
+/*E
+  DMPlexAdaptFlag - Marker values understood by DMPlexAdaptLabel()
+
+$  DMPLEX_ADAPT_KEEP    - Leave the cell as it is
+$  DMPLEX_ADAPT_REFINE  - Refine the cell
+$  DMPLEX_ADAPT_COARSEN - Merge the cell back into its parent
+
+  Level: intermediate
+
+.seealso: DMPlexAdaptLabel()
+E*/
+typedef enum {DMPLEX_ADAPT_KEEP, DMPLEX_ADAPT_REFINE, DMPLEX_ADAPT_COARSEN} DMPlexAdaptFlag;
+PETSC_EXTERN PetscErrorCode DMPlexAdaptLabel(DM, DMLabel, DM *);
+PETSC_EXTERN PetscErrorCode DMPlexGetAdaptParents(DM, IS *);
+PETSC_EXTERN PetscErrorCode DMPlexSetAdaptRebalanceThreshold(DM, PetscReal);
+PETSC_EXTERN PetscErrorCode DMPlexGetAdaptRebalanceThreshold(DM, PetscReal *);
+
 /* Support for cell-vertex meshes */
 PETSC_EXTERN PetscErrorCode DMPlexGetNumFaceVertices(DM, PetscInt, PetscInt, PetscInt *);
 PETSC_EXTERN PetscErrorCode DMPlexGetOrientedFace(DM, PetscInt, PetscInt, const PetscInt [], PetscInt, PetscInt [], PetscInt [], PetscInt [], PetscBool *);
@@ -266,6 +312,11 @@ PETSC_EXTERN PetscErrorCode DMPlexMatSetClosure(DM, PetscSection, PetscSection,
 PETSC_EXTERN PetscErrorCode DMPlexMatSetClosureRefined(DM, PetscSection, PetscSection, DM, PetscSection, PetscSection, Mat, PetscInt, const PetscScalar[], InsertMode);
 PETSC_EXTERN PetscErrorCode DMPlexMatGetClosureIndicesRefined(DM, PetscSection, PetscSection, DM, PetscSection, PetscSection, PetscInt, PetscInt[], PetscInt[]);
 PETSC_EXTERN PetscErrorCode DMPlexCreateClosureIndex(DM, PetscSection);
+PETSC_EXTERN PetscErrorCode DMPlexSetUseClosureDofIndex(DM, PetscBool);
+PETSC_EXTERN PetscErrorCode DMPlexGetUseClosureDofIndex(DM, PetscBool*);
+PETSC_EXTERN PetscErrorCode DMPlexVecGetClosures(DM, PetscSection, Vec, PetscInt, PetscInt, PetscInt, PetscScalar[]);
+PETSC_EXTERN PetscErrorCode DMPlexVecSetClosures(DM, PetscSection, Vec, PetscInt, PetscInt, PetscInt, const PetscScalar[], InsertMode);
+PETSC_EXTERN PetscErrorCode DMPlexMatSetClosures(DM, PetscSection, PetscSection, Mat, PetscInt, PetscInt, PetscInt, const PetscScalar[], InsertMode);
 
 PETSC_EXTERN PetscErrorCode DMPlexCreateFromFile(MPI_Comm, const char[], PetscBool, DM *);
 PETSC_EXTERN PetscErrorCode DMPlexCreateExodus(MPI_Comm, PetscInt, PetscBool, DM *);
@@ -320,6 +371,9 @@ PETSC_EXTERN PetscErrorCode DMPlexCreateRigidBody(DM, MatNullSpace *);
 
 PETSC_EXTERN PetscErrorCode DMPlexSNESComputeResidualFEM(DM, Vec, Vec, void *);
 PETSC_EXTERN PetscErrorCode DMPlexSNESComputeJacobianFEM(DM, Vec, Mat, Mat,void *);
+PETSC_EXTERN PetscErrorCode DMPlexComputeJacobianActionFEM(DM, Vec, Vec, Vec, void *);
+PETSC_EXTERN PetscErrorCode DMPlexComputeJacobianDiagonalFEM(DM, Vec, Vec, void *);
+PETSC_EXTERN PetscErrorCode DMPlexSNESCreateJacobianMF(DM, Vec, void *, Mat *);
 
 PETSC_EXTERN PetscErrorCode DMPlexTSComputeRHSFunctionFVM(DM, PetscReal, Vec, Vec, void *);
 PETSC_EXTERN PetscErrorCode DMPlexTSComputeIFunctionFEM(DM, PetscReal, Vec, Vec, Vec, void *);
@@ -37,6 +37,14 @@ typedef void (*PetscBdPointJac)(PetscInt, PetscInt, PetscInt,
                                 const PetscInt[], const PetscInt[], const PetscScalar[], const PetscScalar[], const PetscScalar[],
                                 const PetscInt[], const PetscInt[], const PetscScalar[], const PetscScalar[], const PetscScalar[],
                                 PetscReal, PetscReal, const PetscReal[], const PetscReal[], PetscScalar[]);
+typedef void (*PetscPointFuncBatch)(PetscInt, PetscInt, PetscInt,
+                                    const PetscInt[], const PetscInt[], const PetscScalar[], const PetscScalar[], const PetscScalar[],
+                                    const PetscInt[], const PetscInt[], const PetscScalar[], const PetscScalar[], const PetscScalar[],
+                                    PetscReal, PetscInt, const PetscReal[], PetscScalar[]);
+typedef void (*PetscPointJacBatch)(PetscInt, PetscInt, PetscInt,
+                                   const PetscInt[], const PetscInt[], const PetscScalar[], const PetscScalar[], const PetscScalar[],
+                                   const PetscInt[], const PetscInt[], const PetscScalar[], const PetscScalar[], const PetscScalar[],
+                                   PetscReal, PetscReal, PetscInt, const PetscReal[], PetscScalar[]);
 typedef void (*PetscRiemannFunc)(PetscInt, PetscInt, const PetscReal[], const PetscReal[], const PetscScalar[], const PetscScalar[], PetscScalar[], void *);
 
 
@@ -138,6 +146,10 @@ PETSC_EXTERN PetscErrorCode PetscDSSetJacobian(PetscDS, PetscInt, PetscInt,
                                                         const PetscInt[], const PetscInt[], const PetscScalar[], const PetscScalar[], const PetscScalar[],
                                                         const PetscInt[], const PetscInt[], const PetscScalar[], const PetscScalar[], const PetscScalar[],
                                                         PetscReal, PetscReal, const PetscReal[], PetscScalar[]));
+PETSC_EXTERN PetscErrorCode PetscDSGetResidualBatch(PetscDS, PetscInt, PetscPointFuncBatch *, PetscPointFuncBatch *);
+PETSC_EXTERN PetscErrorCode PetscDSSetResidualBatch(PetscDS, PetscInt, PetscPointFuncBatch, PetscPointFuncBatch);
+PETSC_EXTERN PetscErrorCode PetscDSGetJacobianBatch(PetscDS, PetscInt, PetscInt, PetscPointJacBatch *, PetscPointJacBatch *, PetscPointJacBatch *, PetscPointJacBatch *);
+PETSC_EXTERN PetscErrorCode PetscDSSetJacobianBatch(PetscDS, PetscInt, PetscInt, PetscPointJacBatch, PetscPointJacBatch, PetscPointJacBatch, PetscPointJacBatch);
 PETSC_EXTERN PetscErrorCode PetscDSGetRiemannSolver(PetscDS, PetscInt,
                                                     void (**)(PetscInt, PetscInt, const PetscReal[], const PetscReal[], const PetscScalar[], const PetscScalar[], PetscScalar[], void *));
 PETSC_EXTERN PetscErrorCode PetscDSSetRiemannSolver(PetscDS, PetscInt,
@@ -197,6 +209,7 @@ PETSC_EXTERN PetscErrorCode PetscDSSetBdJacobian(PetscDS, PetscInt, PetscInt,
                                                           const PetscInt[], const PetscInt[], const PetscScalar[], const PetscScalar[], const PetscScalar[],
                                                           PetscReal, PetscReal, const PetscReal[], const PetscReal[], PetscScalar[]));
 PETSC_EXTERN PetscErrorCode PetscDSGetTabulation(PetscDS, PetscReal ***, PetscReal ***);
+PETSC_EXTERN PetscErrorCode PetscDSGetBatchTabulation(PetscDS, PetscReal ***, PetscReal ***);
 PETSC_EXTERN PetscErrorCode PetscDSGetBdTabulation(PetscDS, PetscReal ***, PetscReal ***);
 PETSC_EXTERN PetscErrorCode PetscDSGetEvaluationArrays(PetscDS, PetscScalar **, PetscScalar **, PetscScalar **);
 PETSC_EXTERN PetscErrorCode PetscDSGetWeakFormArrays(PetscDS, PetscScalar **, PetscScalar **, PetscScalar **, PetscScalar **, PetscScalar **, PetscScalar **);
@@ -343,6 +343,8 @@ PETSC_EXTERN PetscErrorCode PetscSectionGetField(PetscSection, PetscInt, PetscSe
 
 PETSC_EXTERN PetscErrorCode PetscSectionSetClosureIndex(PetscSection, PetscObject, PetscSection, IS);
 PETSC_EXTERN PetscErrorCode PetscSectionGetClosureIndex(PetscSection, PetscObject, PetscSection *, IS *);
+PETSC_EXTERN PetscErrorCode PetscSectionSetClosureDofIndex(PetscSection, PetscObject, PetscInt, PetscInt, PetscInt[], PetscInt[]);
+PETSC_EXTERN PetscErrorCode PetscSectionGetClosureDofIndex(PetscSection, PetscObject, PetscInt *, PetscInt *, const PetscInt *[], const PetscInt *[]);
 
 /* PetscSF support */
 PETSC_EXTERN PetscErrorCode PetscSFConvertPartition(PetscSF, PetscSection, IS, ISLocalToGlobalMapping *, PetscSF *);
@@ -45,6 +45,7 @@ typedef const char* PCType;
 #define PCNN              "nn"
 #define PCCHOLESKY        "cholesky"
 #define PCPBJACOBI        "pbjacobi"
+#define PCVPBJACOBI       "vpbjacobi"
 #define PCMAT             "mat"
 #define PCHYPRE           "hypre"
 #define PCPARMS           "parms"
@@ -253,13 +254,16 @@ typedef const char *PCGAMGClassicalType;
             to the next, performs a cycle etc. This is much like the F-cycle presented in "Multigrid" by Trottenberg, Oosterlee, Schuller page 49, but that
             algorithm supports smoothing on before the restriction on each level in the initial restriction to the coarsest stage. In addition that algorithm
             calls the V-cycle only on the coarser level and has a post-smoother instead.
--  PC_MG_KASKADE - like full multigrid except one never goes back to a coarser level
+.  PC_MG_KASKADE - like full multigrid except one never goes back to a coarser level
                from a finer
+-  PC_MG_MULTIADDITIVE - additive multigrid with the transfers smoothed by an l1-Jacobi sweep, so
+               the restricted right hand sides already contain the effect of the finer smoothing and
+               each level is solved independently of the others. This only uses the down smoother
 
 .seealso: PCMGSetType()
 
 E*/
-typedef enum { PC_MG_MULTIPLICATIVE,PC_MG_ADDITIVE,PC_MG_FULL,PC_MG_KASKADE } PCMGType;
+typedef enum { PC_MG_MULTIPLICATIVE,PC_MG_ADDITIVE,PC_MG_FULL,PC_MG_KASKADE,PC_MG_MULTIADDITIVE } PCMGType;
 PETSC_EXTERN const char *const PCMGTypes[];
 #define PC_MG_CASCADE PC_MG_KASKADE;
 
@@ -2517,6 +2517,10 @@ typedef enum {PETSC_BINARY_SEEK_SET = 0,PETSC_BINARY_SEEK_CUR = 1,PETSC_BINARY_S
 PETSC_EXTERN PetscErrorCode PetscBinarySeek(int,off_t,PetscBinarySeekType,off_t*);
 PETSC_EXTERN PetscErrorCode PetscBinarySynchronizedSeek(MPI_Comm,int,off_t,PetscBinarySeekType,off_t*);
 PETSC_EXTERN PetscErrorCode PetscByteSwap(void *,PetscDataType,PetscInt);
+PETSC_EXTERN PetscErrorCode PetscByteShuffle(const void*,void*,size_t,size_t);
+PETSC_EXTERN PetscErrorCode PetscByteUnshuffle(const void*,void*,size_t,size_t);
+PETSC_EXTERN PetscErrorCode PetscLZCompress(const void*,size_t,void*,size_t,size_t*);
+PETSC_EXTERN PetscErrorCode PetscLZDecompress(const void*,size_t,void*,size_t);
 
 PETSC_EXTERN PetscErrorCode PetscSetDebugTerminal(const char[]);
 PETSC_EXTERN PetscErrorCode PetscSetDebugger(const char[],PetscBool );
@@ -2555,6 +2559,8 @@ PETSC_EXTERN const char *const PetscBuildTwoSidedTypes[];
 PETSC_EXTERN PetscErrorCode PetscCommBuildTwoSidedSetType(MPI_Comm,PetscBuildTwoSidedType);
 PETSC_EXTERN PetscErrorCode PetscCommBuildTwoSidedGetType(MPI_Comm,PetscBuildTwoSidedType*);
 
+PETSC_EXTERN PetscErrorCode PetscCommGetNodeLayout(MPI_Comm,PetscMPIInt*,PetscMPIInt*[],PetscMPIInt*,PetscMPIInt*[],PetscMPIInt*[]);
+
 PETSC_EXTERN PetscErrorCode PetscSSEIsEnabled(MPI_Comm,PetscBool  *,PetscBool  *);
 
 /*E
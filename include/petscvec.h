@@ -111,6 +111,7 @@ typedef const char* VecType;
 
 /* Logging support */
 #define    VEC_FILE_CLASSID 1211214
+#define    VEC_FILE_COMPRESSED_CLASSID 1211226
 PETSC_EXTERN PetscClassId VEC_CLASSID;
 PETSC_EXTERN PetscClassId VEC_SCATTER_CLASSID;
 
@@ -173,6 +173,8 @@ PETSC_EXTERN PetscErrorCode PetscViewerBinarySetSkipOptions(PetscViewer,PetscBoo
 PETSC_EXTERN PetscErrorCode PetscViewerBinaryGetSkipOptions(PetscViewer,PetscBool *);
 PETSC_EXTERN PetscErrorCode PetscViewerBinarySetSkipHeader(PetscViewer,PetscBool);
 PETSC_EXTERN PetscErrorCode PetscViewerBinaryGetSkipHeader(PetscViewer,PetscBool*);
+PETSC_EXTERN PetscErrorCode PetscViewerBinarySetVecCompression(PetscViewer,PetscBool,PetscReal);
+PETSC_EXTERN PetscErrorCode PetscViewerBinaryGetVecCompression(PetscViewer,PetscBool*,PetscReal*);
 PETSC_EXTERN PetscErrorCode PetscViewerBinaryReadStringArray(PetscViewer,char***);
 PETSC_EXTERN PetscErrorCode PetscViewerBinaryWriteStringArray(PetscViewer,char**);
 
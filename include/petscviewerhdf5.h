@@ -10,6 +10,8 @@
 PETSC_EXTERN PetscErrorCode PetscViewerHDF5GetFileId(PetscViewer,hid_t*);
 PETSC_EXTERN PetscErrorCode PetscViewerHDF5OpenGroup(PetscViewer, hid_t *, hid_t *);
 PETSC_EXTERN PetscErrorCode PetscViewerHDF5ReadSizes(PetscViewer, const char[], PetscInt *, PetscInt *);
+PETSC_EXTERN PetscErrorCode PetscViewerHDF5GetWriteTimestep(PetscViewer, hid_t, const char[], PetscInt *);
+PETSC_EXTERN PetscErrorCode PetscViewerHDF5CreateDatasetProperties(PetscViewer, int, const hsize_t[], const hsize_t[], hid_t *);
 
 /* On 32 bit systems HDF5 is limited by size of integer, because hsize_t is defined as size_t */
 #define PETSC_HDF5_INT_MAX  2147483647
@@ -59,6 +61,15 @@ PETSC_EXTERN PetscErrorCode PetscViewerHDF5GetBaseDimension2(PetscViewer,PetscBo
 PETSC_EXTERN PetscErrorCode PetscViewerHDF5SetSPOutput(PetscViewer,PetscBool);
 PETSC_EXTERN PetscErrorCode PetscViewerHDF5GetSPOutput(PetscViewer,PetscBool*);
 
+PETSC_EXTERN PetscErrorCode PetscViewerHDF5SetChunkPartition(PetscViewer,PetscBool);
+PETSC_EXTERN PetscErrorCode PetscViewerHDF5GetChunkPartition(PetscViewer,PetscBool*);
+PETSC_EXTERN PetscErrorCode PetscViewerHDF5SetCompress(PetscViewer,PetscInt);
+PETSC_EXTERN PetscErrorCode PetscViewerHDF5GetCompress(PetscViewer,PetscInt*);
+PETSC_EXTERN PetscErrorCode PetscViewerHDF5SetCollectiveMetadata(PetscViewer,PetscBool);
+PETSC_EXTERN PetscErrorCode PetscViewerHDF5GetCollectiveMetadata(PetscViewer,PetscBool*);
+PETSC_EXTERN PetscErrorCode PetscViewerHDF5SetTimestepAppend(PetscViewer,PetscBool);
+PETSC_EXTERN PetscErrorCode PetscViewerHDF5GetTimestepAppend(PetscViewer,PetscBool*);
+
 /* Reset __FUNCT__ in case the user does not define it themselves */
 #undef __FUNCT__
 #define __FUNCT__ "User provided function"
@@ -338,6 +338,12 @@ static PetscErrorCode PetscDSDestroyStructs_Static(PetscDS prob)
   ierr = PetscFree4(prob->basis,prob->basisDer,prob->basisBd,prob->basisDerBd);CHKERRQ(ierr);
   ierr = PetscFree5(prob->u,prob->u_t,prob->u_x,prob->x,prob->refSpaceDer);CHKERRQ(ierr);
   ierr = PetscFree6(prob->f0,prob->f1,prob->g0,prob->g1,prob->g2,prob->g3);CHKERRQ(ierr);
+  if (prob->basisT) {
+    PetscInt f;
+
+    for (f = 0; f < prob->Nf; ++f) {ierr = PetscFree2(prob->basisT[f],prob->basisDerT[f]);CHKERRQ(ierr);}
+    ierr = PetscFree2(prob->basisT,prob->basisDerT);CHKERRQ(ierr);
+  }
   PetscFunctionReturn(0);
 }
 
@@ -351,6 +357,8 @@ static PetscErrorCode PetscDSEnlarge_Static(PetscDS prob, PetscInt NfNew)
   PetscPointJac    *tmpg;
   PetscBdPointFunc *tmpfbd;
   PetscBdPointJac  *tmpgbd;
+  PetscPointFuncBatch *tmpfb;
+  PetscPointJacBatch  *tmpgb;
   PetscRiemannFunc *tmpr;
   void            **tmpctx;
   PetscInt          Nf = prob->Nf, f, i;
@@ -395,6 +403,12 @@ static PetscErrorCode PetscDSEnlarge_Static(PetscDS prob, PetscInt NfNew)
   ierr = PetscFree2(prob->fBd, prob->gBd);CHKERRQ(ierr);
   prob->fBd = tmpfbd;
   prob->gBd = tmpgbd;
+  ierr = PetscCalloc2(NfNew*2, &tmpfb, NfNew*NfNew*4, &tmpgb);CHKERRQ(ierr);
+  for (f = 0; f < Nf*2; ++f) tmpfb[f] = prob->fBatch[f];
+  for (f = 0; f < Nf*Nf*4; ++f) tmpgb[f] = prob->gBatch[f];
+  ierr = PetscFree2(prob->fBatch, prob->gBatch);CHKERRQ(ierr);
+  prob->fBatch = tmpfb;
+  prob->gBatch = tmpgb;
   PetscFunctionReturn(0);
 }
 
@@ -431,6 +445,7 @@ PetscErrorCode PetscDSDestroy(PetscDS *prob)
   ierr = PetscFree4((*prob)->disc, (*prob)->discBd, (*prob)->implicit, (*prob)->adjacency);CHKERRQ(ierr);
   ierr = PetscFree5((*prob)->obj,(*prob)->f,(*prob)->g,(*prob)->r,(*prob)->ctx);CHKERRQ(ierr);
   ierr = PetscFree2((*prob)->fBd,(*prob)->gBd);CHKERRQ(ierr);
+  ierr = PetscFree2((*prob)->fBatch,(*prob)->gBatch);CHKERRQ(ierr);
   if ((*prob)->ops->destroy) {ierr = (*(*prob)->ops->destroy)(*prob);CHKERRQ(ierr);}
   ierr = PetscHeaderDestroy(prob);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -1243,6 +1258,168 @@ PetscErrorCode PetscDSSetJacobian(PetscDS prob, PetscInt f, PetscInt g,
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "PetscDSGetResidualBatch"
+/*@C
+  PetscDSGetResidualBatch - Get the batched residual functions for a given test field
+
+  Not collective
+
+  Input Parameters:
++ prob - The PetscDS
+- f    - The test field number
+
+  Output Parameters:
++ f0 - batched integrand for the test function term
+- f1 - batched integrand for the test function gradient term
+
+  Level: intermediate
+
+.seealso: PetscDSSetResidualBatch(), PetscDSGetResidual()
+@*/
+PetscErrorCode PetscDSGetResidualBatch(PetscDS prob, PetscInt f, PetscPointFuncBatch *f0, PetscPointFuncBatch *f1)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(prob, PETSCDS_CLASSID, 1);
+  if ((f < 0) || (f >= prob->Nf)) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Field number %d must be in [0, %d)", f, prob->Nf);
+  if (f0) {PetscValidPointer(f0, 3); *f0 = prob->fBatch[f*2+0];}
+  if (f1) {PetscValidPointer(f1, 4); *f1 = prob->fBatch[f*2+1];}
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscDSSetResidualBatch"
+/*@C
+  PetscDSSetResidualBatch - Set batched residual functions for a given test field, which are called once for a whole block of quadrature points
+
+  Not collective
+
+  Input Parameters:
++ prob - The PetscDS
+. f    - The test field number
+. f0 - batched integrand for the test function term
+- f1 - batched integrand for the test function gradient term
+
+  Note: The weak form is the same as for PetscDSSetResidual(), but the callbacks receive the field jets for Np points at once,
+  stored point-minor (structure of arrays), so that the loop over points can be vectorized by the compiler:
+
+$ f0(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+$    const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+$    const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+$    PetscReal t, PetscInt Np, const PetscReal x[], PetscScalar f0[])
+
+  Component c of field g at point p is u[(uOff[g]+c)*Np+p], its derivative in direction d is u_x[(uOff_x[g]+c*dim+d)*Np+p],
+  and coordinate d of the point is x[d*Np+p]. The output is f0[c*Np+p] for f0, and f1[(c*dim+d)*Np+p] for f1, and the output
+  arrays are zeroed before the call. Auxiliary fields follow the same layout.
+
+  When batched functions are set for a field they are used instead of the pointwise functions from PetscDSSetResidual().
+
+  Level: intermediate
+
+.seealso: PetscDSGetResidualBatch(), PetscDSSetResidual(), PetscDSSetJacobianBatch()
+@*/
+PetscErrorCode PetscDSSetResidualBatch(PetscDS prob, PetscInt f, PetscPointFuncBatch f0, PetscPointFuncBatch f1)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(prob, PETSCDS_CLASSID, 1);
+  if (f0) PetscValidFunction(f0, 3);
+  if (f1) PetscValidFunction(f1, 4);
+  if (f < 0) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Field number %d must be non-negative", f);
+  ierr = PetscDSEnlarge_Static(prob, f+1);CHKERRQ(ierr);
+  prob->fBatch[f*2+0] = f0;
+  prob->fBatch[f*2+1] = f1;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscDSGetJacobianBatch"
+/*@C
+  PetscDSGetJacobianBatch - Get the batched Jacobian functions for given test and basis fields
+
+  Not collective
+
+  Input Parameters:
++ prob - The PetscDS
+. f    - The test field number
+- g    - The field number
+
+  Output Parameters:
++ g0 - batched integrand for the test and basis function term
+. g1 - batched integrand for the test function and basis function gradient term
+. g2 - batched integrand for the test function gradient and basis function term
+- g3 - batched integrand for the test function gradient and basis function gradient term
+
+  Level: intermediate
+
+.seealso: PetscDSSetJacobianBatch(), PetscDSGetJacobian()
+@*/
+PetscErrorCode PetscDSGetJacobianBatch(PetscDS prob, PetscInt f, PetscInt g, PetscPointJacBatch *g0, PetscPointJacBatch *g1, PetscPointJacBatch *g2, PetscPointJacBatch *g3)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(prob, PETSCDS_CLASSID, 1);
+  if ((f < 0) || (f >= prob->Nf)) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Field number %d must be in [0, %d)", f, prob->Nf);
+  if ((g < 0) || (g >= prob->Nf)) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Field number %d must be in [0, %d)", g, prob->Nf);
+  if (g0) {PetscValidPointer(g0, 4); *g0 = prob->gBatch[(f*prob->Nf + g)*4+0];}
+  if (g1) {PetscValidPointer(g1, 5); *g1 = prob->gBatch[(f*prob->Nf + g)*4+1];}
+  if (g2) {PetscValidPointer(g2, 6); *g2 = prob->gBatch[(f*prob->Nf + g)*4+2];}
+  if (g3) {PetscValidPointer(g3, 7); *g3 = prob->gBatch[(f*prob->Nf + g)*4+3];}
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscDSSetJacobianBatch"
+/*@C
+  PetscDSSetJacobianBatch - Set batched Jacobian functions for given test and basis fields, which are called once for a whole block of quadrature points
+
+  Not collective
+
+  Input Parameters:
++ prob - The PetscDS
+. f    - The test field number
+. g    - The field number
+. g0 - batched integrand for the test and basis function term
+. g1 - batched integrand for the test function and basis function gradient term
+. g2 - batched integrand for the test function gradient and basis function term
+- g3 - batched integrand for the test function gradient and basis function gradient term
+
+  Note: The weak form is the same as for PetscDSSetJacobian(), and the inputs are laid out as described in PetscDSSetResidualBatch():
+
+$ g0(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+$    const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+$    const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+$    PetscReal t, PetscReal u_tShift, PetscInt Np, const PetscReal x[], PetscScalar g0[])
+
+  For NcI test components and NcJ basis components the outputs are g0[(fc*NcJ+gc)*Np+p], g1[((fc*NcJ+gc)*dim+d)*Np+p],
+  g2[((fc*NcJ+gc)*dim+d)*Np+p], and g3[(((fc*NcJ+gc)*dim+d)*dim+d2)*Np+p], and they are zeroed before the call.
+
+  When batched functions are set for a pair of fields they are used instead of the pointwise functions from PetscDSSetJacobian().
+
+  Level: intermediate
+
+.seealso: PetscDSGetJacobianBatch(), PetscDSSetJacobian(), PetscDSSetResidualBatch()
+@*/
+PetscErrorCode PetscDSSetJacobianBatch(PetscDS prob, PetscInt f, PetscInt g, PetscPointJacBatch g0, PetscPointJacBatch g1, PetscPointJacBatch g2, PetscPointJacBatch g3)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(prob, PETSCDS_CLASSID, 1);
+  if (g0) PetscValidFunction(g0, 4);
+  if (g1) PetscValidFunction(g1, 5);
+  if (g2) PetscValidFunction(g2, 6);
+  if (g3) PetscValidFunction(g3, 7);
+  if (f < 0) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Field number %d must be non-negative", f);
+  if (g < 0) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Field number %d must be non-negative", g);
+  ierr = PetscDSEnlarge_Static(prob, PetscMax(f, g)+1);CHKERRQ(ierr);
+  prob->gBatch[(f*prob->Nf + g)*4+0] = g0;
+  prob->gBatch[(f*prob->Nf + g)*4+1] = g1;
+  prob->gBatch[(f*prob->Nf + g)*4+2] = g2;
+  prob->gBatch[(f*prob->Nf + g)*4+3] = g3;
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "PetscDSGetRiemannSolver"
 /*@C
@@ -1900,6 +2077,66 @@ PetscErrorCode PetscDSGetTabulation(PetscDS prob, PetscReal ***basis, PetscReal
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "PetscDSGetBatchTabulation"
+/*@C
+  PetscDSGetBatchTabulation - Return the basis tabulation at quadrature points stored point-minor, for batched evaluation
+
+  Not collective
+
+  Input Parameter:
+. prob - The PetscDS object
+
+  Output Parameters:
++ basis - The basis function tabulation, basis[f][(b*Nc+c)*Nq+q] for field f
+- basisDer - The basis function derivative tabulation, basisDer[f][((b*Nc+c)*dim+d)*Nq+q] for field f
+
+  Note: This is the transpose of the layout from PetscDSGetTabulation(), so that a loop over the quadrature points of a cell
+  is unit stride. It is built the first time it is requested. Finite volume fields have a NULL tabulation.
+
+  Level: developer
+
+.seealso: PetscDSGetTabulation(), PetscDSSetResidualBatch()
+@*/
+PetscErrorCode PetscDSGetBatchTabulation(PetscDS prob, PetscReal ***basis, PetscReal ***basisDer)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(prob, PETSCDS_CLASSID, 1);
+  ierr = PetscDSSetUp(prob);CHKERRQ(ierr);
+  if (!prob->basisT) {
+    PetscInt dim, f;
+
+    ierr = PetscDSGetSpatialDimension(prob, &dim);CHKERRQ(ierr);
+    ierr = PetscCalloc2(prob->Nf,&prob->basisT,prob->Nf,&prob->basisDerT);CHKERRQ(ierr);
+    for (f = 0; f < prob->Nf; ++f) {
+      PetscObject     obj;
+      PetscClassId    id;
+      PetscQuadrature quad;
+      PetscInt        Nb, Nc, Nq, i, q, d;
+
+      ierr = PetscDSGetDiscretization(prob, f, &obj);CHKERRQ(ierr);
+      ierr = PetscObjectGetClassId(obj, &id);CHKERRQ(ierr);
+      if (id != PETSCFE_CLASSID) continue;
+      ierr = PetscFEGetDimension((PetscFE) obj, &Nb);CHKERRQ(ierr);
+      ierr = PetscFEGetNumComponents((PetscFE) obj, &Nc);CHKERRQ(ierr);
+      ierr = PetscFEGetQuadrature((PetscFE) obj, &quad);CHKERRQ(ierr);
+      ierr = PetscQuadratureGetData(quad, NULL, &Nq, NULL, NULL);CHKERRQ(ierr);
+      ierr = PetscMalloc2(Nb*Nc*Nq,&prob->basisT[f],Nb*Nc*dim*Nq,&prob->basisDerT[f]);CHKERRQ(ierr);
+      for (i = 0; i < Nb*Nc; ++i) {
+        for (q = 0; q < Nq; ++q) {
+          prob->basisT[f][i*Nq+q] = prob->basis[f][q*Nb*Nc+i];
+          for (d = 0; d < dim; ++d) prob->basisDerT[f][(i*dim+d)*Nq+q] = prob->basisDer[f][(q*Nb*Nc+i)*dim+d];
+        }
+      }
+    }
+  }
+  if (basis)    {PetscValidPointer(basis, 2);    *basis    = prob->basisT;}
+  if (basisDer) {PetscValidPointer(basisDer, 3); *basisDer = prob->basisDerT;}
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "PetscDSGetBdTabulation"
 /*@C
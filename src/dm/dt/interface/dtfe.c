@@ -3344,6 +3344,350 @@ PetscErrorCode PetscFEIntegrate_Basic(PetscFE fem, PetscDS prob, PetscInt field,
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "EvaluateFieldJetsBatch_Static"
+/*
+  Evaluate the field jets at all quadrature points of the Ne cells in a block. The output is stored point-minor, so that
+  component c at quadrature point q of cell e is u[c*Np + e*Nq+q] with Np = Ne*Nq. The work array refSpaceDer must hold
+  NcMax*dim*Nq values.
+*/
+static PetscErrorCode EvaluateFieldJetsBatch_Static(PetscDS prob, PetscInt Ne, PetscInt Nq, const PetscFECellGeom geom[], const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscScalar u[], PetscScalar u_x[], PetscScalar u_t[], PetscScalar refSpaceDer[])
+{
+  const PetscInt Np = Ne*Nq;
+  PetscReal    **basisField, **basisFieldDer;
+  PetscInt       dim, Nf, Nc, totDim, fOffset = 0, dOffset = 0, f, i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!prob) PetscFunctionReturn(0);
+  ierr = PetscDSGetSpatialDimension(prob, &dim);CHKERRQ(ierr);
+  ierr = PetscDSGetNumFields(prob, &Nf);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalComponents(prob, &Nc);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalDimension(prob, &totDim);CHKERRQ(ierr);
+  ierr = PetscDSGetBatchTabulation(prob, &basisField, &basisFieldDer);CHKERRQ(ierr);
+  for (i = 0; i < Nc*Np; ++i)                  u[i]   = 0.0;
+  for (i = 0; i < Nc*dim*Np; ++i)              u_x[i] = 0.0;
+  if (u_t) {for (i = 0; i < Nc*Np; ++i)        u_t[i] = 0.0;}
+  for (f = 0; f < Nf; ++f) {
+    const PetscReal *basis    = basisField[f];
+    const PetscReal *basisDer = basisFieldDer[f];
+    PetscFE          fe;
+    PetscQuadrature  quad;
+    PetscInt         Nb, Ncf, Nqf, e;
+
+    if (!basis) SETERRQ1(PetscObjectComm((PetscObject) prob), PETSC_ERR_SUP, "Batched evaluation only supports PetscFE discretizations, not field %d", f);
+    ierr = PetscDSGetDiscretization(prob, f, (PetscObject *) &fe);CHKERRQ(ierr);
+    ierr = PetscFEGetDimension(fe, &Nb);CHKERRQ(ierr);
+    ierr = PetscFEGetNumComponents(fe, &Ncf);CHKERRQ(ierr);
+    ierr = PetscFEGetQuadrature(fe, &quad);CHKERRQ(ierr);
+    ierr = PetscQuadratureGetData(quad, NULL, &Nqf, NULL, NULL);CHKERRQ(ierr);
+    if (Nqf != Nq) SETERRQ3(PetscObjectComm((PetscObject) prob), PETSC_ERR_SUP, "Batched evaluation needs the same quadrature for all fields, field %d has %d points instead of %d", f, Nqf, Nq);
+    for (e = 0; e < Ne; ++e) {
+      const PetscScalar *coeff   = &coefficients[e*totDim+dOffset];
+      const PetscScalar *coeff_t = coefficients_t ? &coefficients_t[e*totDim+dOffset] : NULL;
+      const PetscReal   *invJ    = geom[e].invJ;
+      const PetscInt     p0      = e*Nq;
+      PetscInt           b, c, d, d2, q;
+
+      for (i = 0; i < Ncf*dim*Nq; ++i) refSpaceDer[i] = 0.0;
+      for (b = 0; b < Nb; ++b) {
+        for (c = 0; c < Ncf; ++c) {
+          const PetscInt    cidx = b*Ncf+c;
+          const PetscScalar cf   = coeff[cidx];
+          PetscScalar      *uc   = &u[(fOffset+c)*Np+p0];
+
+          for (q = 0; q < Nq; ++q) uc[q] += cf*basis[cidx*Nq+q];
+          for (d = 0; d < dim; ++d) {
+            PetscScalar *rc = &refSpaceDer[(c*dim+d)*Nq];
+
+            for (q = 0; q < Nq; ++q) rc[q] += cf*basisDer[(cidx*dim+d)*Nq+q];
+          }
+          if (u_t) {
+            const PetscScalar cft  = coeff_t[cidx];
+            PetscScalar      *utc  = &u_t[(fOffset+c)*Np+p0];
+
+            for (q = 0; q < Nq; ++q) utc[q] += cft*basis[cidx*Nq+q];
+          }
+        }
+      }
+      for (c = 0; c < Ncf; ++c) {
+        for (d = 0; d < dim; ++d) {
+          PetscScalar *uxc = &u_x[((fOffset+c)*dim+d)*Np+p0];
+
+          for (d2 = 0; d2 < dim; ++d2) {
+            const PetscReal    iJ = invJ[d2*dim+d];
+            const PetscScalar *rc = &refSpaceDer[(c*dim+d2)*Nq];
+
+            for (q = 0; q < Nq; ++q) uxc[q] += iJ*rc[q];
+          }
+        }
+      }
+    }
+    fOffset += Ncf;
+    dOffset += Nb*Ncf;
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "CoordinatesRefToRealBatch_Static"
+/* Map the quadrature points of Ne cells to real space, storing coordinate d of point q in cell e at x[d*Np + e*Nq+q] */
+static void CoordinatesRefToRealBatch_Static(PetscInt dim, PetscInt Ne, PetscInt Nq, const PetscFECellGeom geom[], const PetscReal quadPoints[], PetscReal x[])
+{
+  const PetscInt Np = Ne*Nq;
+  PetscInt       e, q, d, d2;
+
+  for (e = 0; e < Ne; ++e) {
+    const PetscReal *v0 = geom[e].v0;
+    const PetscReal *J  = geom[e].J;
+
+    for (d = 0; d < dim; ++d) {
+      PetscReal *xd = &x[d*Np+e*Nq];
+
+      for (q = 0; q < Nq; ++q) xd[q] = v0[d];
+      for (d2 = 0; d2 < dim; ++d2) for (q = 0; q < Nq; ++q) xd[q] += J[d*dim+d2]*(quadPoints[q*dim+d2] + 1.0);
+    }
+  }
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscFEIntegrateResidualBatch_Static"
+/*
+  Residual integration for fields with batched pointwise functions. Cells are processed in blocks of about
+  PETSCFE_BATCH_POINTS quadrature points, and the pointwise functions are called once per block.
+*/
+static PetscErrorCode PetscFEIntegrateResidualBatch_Static(PetscFE fem, PetscDS prob, PetscInt field, PetscInt Ne, PetscFECellGeom *geom,
+                                                           const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscDS probAux, const PetscScalar coefficientsAux[], PetscScalar elemVec[])
+{
+  PetscPointFuncBatch f0_func, f1_func;
+  PetscQuadrature     quad;
+  const PetscReal    *quadPoints, *quadWeights;
+  PetscReal         **basisField, **basisFieldDer, *basis, *basisDer, *x;
+  PetscScalar        *u, *u_t, *u_x, *a = NULL, *a_x = NULL, *refSpaceDer, *f0, *f1;
+  PetscInt           *uOff, *uOff_x, *aOff = NULL, *aOff_x = NULL;
+  PetscInt            dim, Nf, NfAux = 0, Nb, Nc, Nq, NcTot, NcAux = 0, totDim, totDimAux = 0, fOffset, NeBlock, NpMax, eStart;
+  PetscErrorCode      ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFEGetSpatialDimension(fem, &dim);CHKERRQ(ierr);
+  ierr = PetscFEGetQuadrature(fem, &quad);CHKERRQ(ierr);
+  ierr = PetscFEGetDimension(fem, &Nb);CHKERRQ(ierr);
+  ierr = PetscFEGetNumComponents(fem, &Nc);CHKERRQ(ierr);
+  ierr = PetscQuadratureGetData(quad, NULL, &Nq, &quadPoints, &quadWeights);CHKERRQ(ierr);
+  ierr = PetscDSGetNumFields(prob, &Nf);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalDimension(prob, &totDim);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalComponents(prob, &NcTot);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentOffsets(prob, &uOff);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentDerivativeOffsets(prob, &uOff_x);CHKERRQ(ierr);
+  ierr = PetscDSGetFieldOffset(prob, field, &fOffset);CHKERRQ(ierr);
+  ierr = PetscDSGetResidualBatch(prob, field, &f0_func, &f1_func);CHKERRQ(ierr);
+  ierr = PetscDSGetBatchTabulation(prob, &basisField, &basisFieldDer);CHKERRQ(ierr);
+  basis    = basisField[field];
+  basisDer = basisFieldDer[field];
+  if (probAux) {
+    ierr = PetscDSGetNumFields(probAux, &NfAux);CHKERRQ(ierr);
+    ierr = PetscDSGetTotalDimension(probAux, &totDimAux);CHKERRQ(ierr);
+    ierr = PetscDSGetTotalComponents(probAux, &NcAux);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentOffsets(probAux, &aOff);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentDerivativeOffsets(probAux, &aOff_x);CHKERRQ(ierr);
+  }
+  NeBlock = PetscMax(1, PETSCFE_BATCH_POINTS/Nq);
+  NpMax   = NeBlock*Nq;
+  ierr = PetscMalloc5(dim*NpMax,&x,NcTot*NpMax,&u,NcTot*dim*NpMax,&u_x,PetscMax(NcTot,NcAux)*dim*Nq,&refSpaceDer,Nc*(dim+1)*NpMax,&f0);CHKERRQ(ierr);
+  ierr = PetscMalloc3(coefficients_t ? NcTot*NpMax : 0,&u_t,NcAux*NpMax,&a,NcAux*dim*NpMax,&a_x);CHKERRQ(ierr);
+  for (eStart = 0; eStart < Ne; eStart += NeBlock) {
+    const PetscInt Nbe = PetscMin(NeBlock, Ne-eStart);
+    const PetscInt Np  = Nbe*Nq;
+    PetscInt       e, i;
+
+    CoordinatesRefToRealBatch_Static(dim, Nbe, Nq, &geom[eStart], quadPoints, x);
+    ierr = EvaluateFieldJetsBatch_Static(prob,    Nbe, Nq, &geom[eStart], &coefficients[eStart*totDim], coefficients_t ? &coefficients_t[eStart*totDim] : NULL, u, u_x, coefficients_t ? u_t : NULL, refSpaceDer);CHKERRQ(ierr);
+    ierr = EvaluateFieldJetsBatch_Static(probAux, Nbe, Nq, &geom[eStart], probAux ? &coefficientsAux[eStart*totDimAux] : NULL, NULL, a, a_x, NULL, refSpaceDer);CHKERRQ(ierr);
+    for (i = 0; i < Nc*(dim+1)*Np; ++i) f0[i] = 0.0;
+    f1 = &f0[Nc*Np];
+    if (f0_func) f0_func(dim, Nf, NfAux, uOff, uOff_x, u, coefficients_t ? u_t : NULL, u_x, aOff, aOff_x, probAux ? a : NULL, NULL, probAux ? a_x : NULL, 0.0, Np, x, f0);
+    if (f1_func) f1_func(dim, Nf, NfAux, uOff, uOff_x, u, coefficients_t ? u_t : NULL, u_x, aOff, aOff_x, probAux ? a : NULL, NULL, probAux ? a_x : NULL, 0.0, Np, x, f1);
+    for (e = 0; e < Nbe; ++e) {
+      const PetscReal *invJ    = geom[eStart+e].invJ;
+      const PetscReal  detJ    = geom[eStart+e].detJ;
+      const PetscInt   p0      = e*Nq;
+      PetscScalar     *elemVecE = &elemVec[(eStart+e)*totDim+fOffset];
+      PetscInt         b, c, d, d2, q;
+
+      /* Move f_1 to real space in the per-cell work array and apply the quadrature weights */
+      for (c = 0; c < Nc; ++c) {
+        for (q = 0; q < Nq; ++q) f0[c*Np+p0+q] *= detJ*quadWeights[q];
+        for (d = 0; d < dim; ++d) {
+          PetscScalar *rc = &refSpaceDer[(c*dim+d)*Nq];
+
+          for (q = 0; q < Nq; ++q) rc[q] = 0.0;
+          for (d2 = 0; d2 < dim; ++d2) {
+            const PetscReal    iJ = invJ[d*dim+d2];
+            const PetscScalar *fc = &f1[(c*dim+d2)*Np+p0];
+
+            for (q = 0; q < Nq; ++q) rc[q] += iJ*fc[q];
+          }
+          for (q = 0; q < Nq; ++q) rc[q] *= detJ*quadWeights[q];
+        }
+      }
+      for (b = 0; b < Nb; ++b) {
+        for (c = 0; c < Nc; ++c) {
+          const PetscInt     cidx = b*Nc+c;
+          const PetscScalar *fc   = &f0[c*Np+p0];
+          PetscScalar        val  = 0.0;
+
+          for (q = 0; q < Nq; ++q) val += basis[cidx*Nq+q]*fc[q];
+          for (d = 0; d < dim; ++d) {
+            const PetscScalar *rc = &refSpaceDer[(c*dim+d)*Nq];
+
+            for (q = 0; q < Nq; ++q) val += basisDer[(cidx*dim+d)*Nq+q]*rc[q];
+          }
+          elemVecE[cidx] = val;
+        }
+      }
+    }
+  }
+  ierr = PetscFree5(x,u,u_x,refSpaceDer,f0);CHKERRQ(ierr);
+  ierr = PetscFree3(u_t,a,a_x);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscFEIntegrateJacobianBatch_Static"
+/*
+  Jacobian integration for pairs of fields with batched pointwise functions, blocked in the same way as
+  PetscFEIntegrateResidualBatch_Static(). The element matrix is accumulated into, as in the pointwise version.
+*/
+static PetscErrorCode PetscFEIntegrateJacobianBatch_Static(PetscFE fem, PetscDS prob, PetscInt fieldI, PetscInt fieldJ, PetscInt Ne, PetscFECellGeom *geom,
+                                                           const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscDS probAux, const PetscScalar coefficientsAux[], PetscScalar elemMat[])
+{
+  PetscPointJacBatch g0_func, g1_func, g2_func, g3_func;
+  PetscFE            fe;
+  PetscQuadrature    quad;
+  const PetscReal   *quadPoints, *quadWeights;
+  PetscReal        **basisField, **basisFieldDer, *basisI, *basisDerI, *basisJ, *basisDerJ, *x;
+  PetscScalar       *u, *u_t, *u_x, *a = NULL, *a_x = NULL, *refSpaceDer, *g0, *g1, *g2, *g3, *tmp;
+  PetscInt          *uOff, *uOff_x, *aOff = NULL, *aOff_x = NULL;
+  PetscInt           dim, Nf, NfAux = 0, NbI, NcI, NbJ, NcJ, Nq, NcTot, NcAux = 0, totDim, totDimAux = 0, offsetI, offsetJ, NcIJ, NeBlock, NpMax, eStart;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFEGetSpatialDimension(fem, &dim);CHKERRQ(ierr);
+  ierr = PetscFEGetQuadrature(fem, &quad);CHKERRQ(ierr);
+  ierr = PetscQuadratureGetData(quad, NULL, &Nq, &quadPoints, &quadWeights);CHKERRQ(ierr);
+  ierr = PetscDSGetNumFields(prob, &Nf);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalDimension(prob, &totDim);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalComponents(prob, &NcTot);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentOffsets(prob, &uOff);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentDerivativeOffsets(prob, &uOff_x);CHKERRQ(ierr);
+  ierr = PetscDSGetJacobianBatch(prob, fieldI, fieldJ, &g0_func, &g1_func, &g2_func, &g3_func);CHKERRQ(ierr);
+  ierr = PetscDSGetBatchTabulation(prob, &basisField, &basisFieldDer);CHKERRQ(ierr);
+  ierr = PetscDSGetDiscretization(prob, fieldI, (PetscObject *) &fe);CHKERRQ(ierr);
+  ierr = PetscFEGetDimension(fe, &NbI);CHKERRQ(ierr);
+  ierr = PetscFEGetNumComponents(fe, &NcI);CHKERRQ(ierr);
+  ierr = PetscDSGetFieldOffset(prob, fieldI, &offsetI);CHKERRQ(ierr);
+  ierr = PetscDSGetDiscretization(prob, fieldJ, (PetscObject *) &fe);CHKERRQ(ierr);
+  ierr = PetscFEGetDimension(fe, &NbJ);CHKERRQ(ierr);
+  ierr = PetscFEGetNumComponents(fe, &NcJ);CHKERRQ(ierr);
+  ierr = PetscDSGetFieldOffset(prob, fieldJ, &offsetJ);CHKERRQ(ierr);
+  if (probAux) {
+    ierr = PetscDSGetNumFields(probAux, &NfAux);CHKERRQ(ierr);
+    ierr = PetscDSGetTotalDimension(probAux, &totDimAux);CHKERRQ(ierr);
+    ierr = PetscDSGetTotalComponents(probAux, &NcAux);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentOffsets(probAux, &aOff);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentDerivativeOffsets(probAux, &aOff_x);CHKERRQ(ierr);
+  }
+  basisI    = basisField[fieldI];
+  basisJ    = basisField[fieldJ];
+  basisDerI = basisFieldDer[fieldI];
+  basisDerJ = basisFieldDer[fieldJ];
+  NcIJ      = NcI*NcJ;
+  NeBlock   = PetscMax(1, PETSCFE_BATCH_POINTS/Nq);
+  NpMax     = NeBlock*Nq;
+  ierr = PetscMalloc5(dim*NpMax,&x,NcTot*NpMax,&u,NcTot*dim*NpMax,&u_x,PetscMax(NcTot,NcAux)*dim*Nq,&refSpaceDer,NcIJ*PetscSqr(dim+1)*NpMax,&g0);CHKERRQ(ierr);
+  ierr = PetscMalloc4(coefficients_t ? NcTot*NpMax : 0,&u_t,NcAux*NpMax,&a,NcAux*dim*NpMax,&a_x,dim*dim,&tmp);CHKERRQ(ierr);
+  for (eStart = 0; eStart < Ne; eStart += NeBlock) {
+    const PetscInt Nbe = PetscMin(NeBlock, Ne-eStart);
+    const PetscInt Np  = Nbe*Nq;
+    PetscInt       e, i;
+
+    CoordinatesRefToRealBatch_Static(dim, Nbe, Nq, &geom[eStart], quadPoints, x);
+    ierr = EvaluateFieldJetsBatch_Static(prob,    Nbe, Nq, &geom[eStart], &coefficients[eStart*totDim], coefficients_t ? &coefficients_t[eStart*totDim] : NULL, u, u_x, coefficients_t ? u_t : NULL, refSpaceDer);CHKERRQ(ierr);
+    ierr = EvaluateFieldJetsBatch_Static(probAux, Nbe, Nq, &geom[eStart], probAux ? &coefficientsAux[eStart*totDimAux] : NULL, NULL, a, a_x, NULL, refSpaceDer);CHKERRQ(ierr);
+    g1   = &g0[NcIJ*Np];
+    g2   = &g1[NcIJ*dim*Np];
+    g3   = &g2[NcIJ*dim*Np];
+    for (i = 0; i < NcIJ*PetscSqr(dim+1)*Np; ++i) g0[i] = 0.0;
+    if (g0_func) g0_func(dim, Nf, NfAux, uOff, uOff_x, u, coefficients_t ? u_t : NULL, u_x, aOff, aOff_x, probAux ? a : NULL, NULL, probAux ? a_x : NULL, 0.0, 0.0, Np, x, g0);
+    if (g1_func) g1_func(dim, Nf, NfAux, uOff, uOff_x, u, coefficients_t ? u_t : NULL, u_x, aOff, aOff_x, probAux ? a : NULL, NULL, probAux ? a_x : NULL, 0.0, 0.0, Np, x, g1);
+    if (g2_func) g2_func(dim, Nf, NfAux, uOff, uOff_x, u, coefficients_t ? u_t : NULL, u_x, aOff, aOff_x, probAux ? a : NULL, NULL, probAux ? a_x : NULL, 0.0, 0.0, Np, x, g2);
+    if (g3_func) g3_func(dim, Nf, NfAux, uOff, uOff_x, u, coefficients_t ? u_t : NULL, u_x, aOff, aOff_x, probAux ? a : NULL, NULL, probAux ? a_x : NULL, 0.0, 0.0, Np, x, g3);
+    for (e = 0; e < Nbe; ++e) {
+      const PetscReal *invJ    = geom[eStart+e].invJ;
+      const PetscReal  detJ    = geom[eStart+e].detJ;
+      const PetscInt   p0      = e*Nq;
+      PetscScalar     *elemMatE = &elemMat[(eStart+e)*PetscSqr(totDim)];
+      PetscInt         c, d, d2, d3, d4, q, f, fc, g, gc;
+
+      /* Move the integrands to real space in place and apply the quadrature weights */
+      for (c = 0; c < NcIJ; ++c) {
+        for (q = 0; q < Nq; ++q) {
+          const PetscReal w = detJ*quadWeights[q];
+
+          g0[c*Np+p0+q] *= w;
+          if (g1_func) {
+            for (d = 0; d < dim; ++d) {tmp[d] = 0.0; for (d2 = 0; d2 < dim; ++d2) tmp[d] += invJ[d*dim+d2]*g1[(c*dim+d2)*Np+p0+q];}
+            for (d = 0; d < dim; ++d) g1[(c*dim+d)*Np+p0+q] = tmp[d]*w;
+          }
+          if (g2_func) {
+            for (d = 0; d < dim; ++d) {tmp[d] = 0.0; for (d2 = 0; d2 < dim; ++d2) tmp[d] += invJ[d*dim+d2]*g2[(c*dim+d2)*Np+p0+q];}
+            for (d = 0; d < dim; ++d) g2[(c*dim+d)*Np+p0+q] = tmp[d]*w;
+          }
+          if (g3_func) {
+            for (d = 0; d < dim; ++d) {
+              for (d2 = 0; d2 < dim; ++d2) {
+                tmp[d*dim+d2] = 0.0;
+                for (d3 = 0; d3 < dim; ++d3) for (d4 = 0; d4 < dim; ++d4) tmp[d*dim+d2] += invJ[d*dim+d3]*g3[((c*dim+d3)*dim+d4)*Np+p0+q]*invJ[d2*dim+d4];
+              }
+            }
+            for (d = 0; d < dim*dim; ++d) g3[(c*dim*dim+d)*Np+p0+q] = tmp[d]*w;
+          }
+        }
+      }
+      for (f = 0; f < NbI; ++f) {
+        for (fc = 0; fc < NcI; ++fc) {
+          const PetscInt fidx = f*NcI+fc; /* Test function basis index */
+          const PetscInt i    = offsetI+fidx; /* Element matrix row */
+
+          for (g = 0; g < NbJ; ++g) {
+            for (gc = 0; gc < NcJ; ++gc) {
+              const PetscInt gidx = g*NcJ+gc; /* Trial function basis index */
+              const PetscInt j    = offsetJ+gidx; /* Element matrix column */
+              const PetscInt c    = fc*NcJ+gc;
+              PetscScalar    val  = 0.0;
+
+              if (g0_func) for (q = 0; q < Nq; ++q) val += basisI[fidx*Nq+q]*g0[c*Np+p0+q]*basisJ[gidx*Nq+q];
+              for (d = 0; d < dim; ++d) {
+                if (g1_func) for (q = 0; q < Nq; ++q) val += basisI[fidx*Nq+q]*g1[(c*dim+d)*Np+p0+q]*basisDerJ[(gidx*dim+d)*Nq+q];
+                if (g2_func) for (q = 0; q < Nq; ++q) val += basisDerI[(fidx*dim+d)*Nq+q]*g2[(c*dim+d)*Np+p0+q]*basisJ[gidx*Nq+q];
+                if (g3_func) {
+                  for (d2 = 0; d2 < dim; ++d2) {
+                    for (q = 0; q < Nq; ++q) val += basisDerI[(fidx*dim+d)*Nq+q]*g3[((c*dim+d)*dim+d2)*Np+p0+q]*basisDerJ[(gidx*dim+d2)*Nq+q];
+                  }
+                }
+              }
+              elemMatE[i*totDim+j] += val;
+            }
+          }
+        }
+      }
+    }
+  }
+  ierr = PetscFree5(x,u,u_x,refSpaceDer,g0);CHKERRQ(ierr);
+  ierr = PetscFree4(u_t,a,a_x,tmp);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "PetscFEIntegrateResidual_Basic"
 PetscErrorCode PetscFEIntegrateResidual_Basic(PetscFE fem, PetscDS prob, PetscInt field, PetscInt Ne, PetscFECellGeom *geom,
@@ -3352,6 +3696,7 @@ PetscErrorCode PetscFEIntegrateResidual_Basic(PetscFE fem, PetscDS prob, PetscIn
   const PetscInt  debug = 0;
   PetscPointFunc  f0_func;
   PetscPointFunc  f1_func;
+  PetscPointFuncBatch f0_batch, f1_batch;
   PetscQuadrature quad;
   PetscReal     **basisField, **basisFieldDer;
   PetscScalar    *f0, *f1, *u, *u_t = NULL, *u_x, *a, *a_x, *refSpaceDer;
@@ -3361,6 +3706,11 @@ PetscErrorCode PetscFEIntegrateResidual_Basic(PetscFE fem, PetscDS prob, PetscIn
   PetscErrorCode  ierr;
 
   PetscFunctionBegin;
+  ierr = PetscDSGetResidualBatch(prob, field, &f0_batch, &f1_batch);CHKERRQ(ierr);
+  if (f0_batch || f1_batch) {
+    ierr = PetscFEIntegrateResidualBatch_Static(fem, prob, field, Ne, geom, coefficients, coefficients_t, probAux, coefficientsAux, elemVec);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = PetscFEGetSpatialDimension(fem, &dim);CHKERRQ(ierr);
   ierr = PetscFEGetQuadrature(fem, &quad);CHKERRQ(ierr);
   ierr = PetscFEGetDimension(fem, &Nb);CHKERRQ(ierr);
@@ -3498,6 +3848,7 @@ PetscErrorCode PetscFEIntegrateJacobian_Basic(PetscFE fem, PetscDS prob, PetscIn
   PetscPointJac   g1_func;
   PetscPointJac   g2_func;
   PetscPointJac   g3_func;
+  PetscPointJacBatch g0_batch, g1_batch, g2_batch, g3_batch;
   PetscFE         fe;
   PetscInt        cOffset    = 0; /* Offset into coefficients[] for element e */
   PetscInt        cOffsetAux = 0; /* Offset into coefficientsAux[] for element e */
@@ -3514,6 +3865,11 @@ PetscErrorCode PetscFEIntegrateJacobian_Basic(PetscFE fem, PetscDS prob, PetscIn
   PetscErrorCode  ierr;
 
   PetscFunctionBegin;
+  ierr = PetscDSGetJacobianBatch(prob, fieldI, fieldJ, &g0_batch, &g1_batch, &g2_batch, &g3_batch);CHKERRQ(ierr);
+  if (g0_batch || g1_batch || g2_batch || g3_batch) {
+    ierr = PetscFEIntegrateJacobianBatch_Static(fem, prob, fieldI, fieldJ, Ne, geom, coefficients, coefficients_t, probAux, coefficientsAux, elemMat);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = PetscFEGetSpatialDimension(fem, &dim);CHKERRQ(ierr);
   ierr = PetscFEGetQuadrature(fem, &quad);CHKERRQ(ierr);
   ierr = PetscDSGetNumFields(prob, &Nf);CHKERRQ(ierr);
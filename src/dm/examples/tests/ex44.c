@@ -0,0 +1,145 @@
+static char help[] = "Tests DMDACreateStencilOperator() against the assembled matrix.\n\n";
+
+/*
+Use the options
+     -dim <d>       - dimension of the DMDA
+     -dof <n>       - number of components, 1 or 2, coupled by the stencil when 2
+     -periodic      - use periodic boundaries in all directions
+     -box           - add entries offset in several directions, on a DMDA_STENCIL_BOX DMDA
+     -variable      - use random variable coefficients
+*/
+
+#include <petscdm.h>
+#include <petscdmda.h>
+
+#undef __FUNCT__
+#define __FUNCT__ "main"
+int main(int argc,char **argv)
+{
+  DM              da,cda;
+  Mat             A,B;
+  Vec             x,y,z,coef = NULL;
+  PetscRandom     rnd;
+  MatStencil      col[32],row,cst;
+  PetscInt        rowc[32],dim = 2,dof = 1,n = 0,e,d,c,i,j,k,xs,ys,zs,xm,ym,zm,M,N,P;
+  PetscScalar     v[32],val,*ca;
+  PetscReal       nrm,err;
+  PetscBool       periodic = PETSC_FALSE,box = PETSC_FALSE,variable = PETSC_FALSE;
+  DMBoundaryType  bt;
+  DMDAStencilType st;
+  PetscErrorCode  ierr;
+
+  PetscInitialize(&argc,&argv,(char*)0,help);
+  ierr = PetscOptionsGetInt(NULL,"-dim",&dim,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,"-dof",&dof,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,"-periodic",&periodic,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,"-box",&box,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,"-variable",&variable,NULL);CHKERRQ(ierr);
+  bt = periodic ? DM_BOUNDARY_PERIODIC : DM_BOUNDARY_NONE;
+  st = box ? DMDA_STENCIL_BOX : DMDA_STENCIL_STAR;
+  switch (dim) {
+  case 1:
+    ierr = DMDACreate1d(PETSC_COMM_WORLD,bt,-13,dof,1,NULL,&da);CHKERRQ(ierr);
+    break;
+  case 2:
+    ierr = DMDACreate2d(PETSC_COMM_WORLD,bt,bt,st,-9,-7,PETSC_DECIDE,PETSC_DECIDE,dof,1,NULL,NULL,&da);CHKERRQ(ierr);
+    break;
+  case 3:
+    ierr = DMDACreate3d(PETSC_COMM_WORLD,bt,bt,bt,st,-7,-6,-5,PETSC_DECIDE,PETSC_DECIDE,PETSC_DECIDE,dof,1,NULL,NULL,NULL,&da);CHKERRQ(ierr);
+    break;
+  default: SETERRQ1(PETSC_COMM_WORLD,PETSC_ERR_SUP,"No support for %D dimensions",dim);
+  }
+
+  /* A diffusion stencil for each component, with an upwind advection term in x, couplings between the components, and diagonal neighbors */
+  for (c = 0; c < dof; ++c) {
+    col[n].i = col[n].j = col[n].k = 0; col[n].c = c; rowc[n] = c; v[n++] = 2.0*dim + 0.5 + c;
+    for (d = 0; d < dim; ++d) {
+      for (e = -1; e <= 1; e += 2) {
+        col[n].i = col[n].j = col[n].k = 0; col[n].c = c; rowc[n] = c; v[n] = -1.0 - 0.1*d;
+        if (d == 0) {col[n].i = e; if (e < 0) v[n] -= 0.5;}
+        if (d == 1) col[n].j = e;
+        if (d == 2) col[n].k = e;
+        ++n;
+      }
+    }
+  }
+  if (dof > 1) {
+    col[n].i = col[n].j = col[n].k = 0; col[n].c = 1; rowc[n] = 0; v[n++] = 0.3;
+    col[n].i = 1; col[n].j = col[n].k = 0; col[n].c = 0; rowc[n] = 1; v[n++] = -0.2;
+  }
+  if (box && dim > 1) {
+    col[n].i = 1; col[n].j = -1; col[n].k = dim > 2 ? 1 : 0; col[n].c = 0; rowc[n] = 0; v[n++] = 0.05;
+    col[n].i = -1; col[n].j = 1; col[n].k = 0; col[n].c = dof-1; rowc[n] = 0; v[n++] = -0.07;
+  }
+
+  ierr = DMDACreateStencilOperator(da,n,rowc,col,v,&A);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rnd);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rnd);CHKERRQ(ierr);
+  if (variable) {
+    ierr = DMDAGetReducedDMDA(da,n,&cda);CHKERRQ(ierr);
+    ierr = DMCreateGlobalVector(cda,&coef);CHKERRQ(ierr);
+    ierr = VecSetRandom(coef,rnd);CHKERRQ(ierr);
+    ierr = DMDAStencilOperatorSetCoefficients(A,coef);CHKERRQ(ierr);
+    ierr = DMDestroy(&cda);CHKERRQ(ierr);
+  }
+
+  /* Assemble the same operator, dropping the entries outside the domain */
+  ierr = DMCreateMatrix(da,&B);CHKERRQ(ierr);
+  ierr = MatSetOption(B,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_FALSE);CHKERRQ(ierr);
+  ierr = DMDAGetInfo(da,NULL,&M,&N,&P,NULL,NULL,NULL,NULL,NULL,NULL,NULL,NULL,NULL);CHKERRQ(ierr);
+  ierr = DMDAGetCorners(da,&xs,&ys,&zs,&xm,&ym,&zm);CHKERRQ(ierr);
+  if (coef) {ierr = VecGetArray(coef,&ca);CHKERRQ(ierr);}
+  for (k = zs; k < zs+zm; ++k) {
+    for (j = ys; j < ys+ym; ++j) {
+      for (i = xs; i < xs+xm; ++i) {
+        for (e = 0; e < n; ++e) {
+          row.i = i; row.j = j; row.k = k; row.c = rowc[e];
+          cst.i = i+col[e].i; cst.j = j+col[e].j; cst.k = k+col[e].k; cst.c = col[e].c;
+          if (!periodic && (cst.i < 0 || cst.i >= M || cst.j < 0 || cst.j >= N || cst.k < 0 || cst.k >= P)) continue;
+          val = v[e];
+          if (coef) val *= ca[(((k-zs)*ym + j-ys)*xm + i-xs)*n + e];
+          ierr = MatSetValuesStencil(B,1,&row,1,&cst,&val,ADD_VALUES);CHKERRQ(ierr);
+        }
+      }
+    }
+  }
+  if (coef) {ierr = VecRestoreArray(coef,&ca);CHKERRQ(ierr);}
+  ierr = MatAssemblyBegin(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+
+  ierr = DMCreateGlobalVector(da,&x);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&y);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&z);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,rnd);CHKERRQ(ierr);
+  ierr = MatMult(A,x,y);CHKERRQ(ierr);
+  ierr = MatMult(B,x,z);CHKERRQ(ierr);
+  ierr = VecNorm(z,NORM_2,&nrm);CHKERRQ(ierr);
+  ierr = VecAXPY(z,-1.0,y);CHKERRQ(ierr);
+  ierr = VecNorm(z,NORM_2,&err);CHKERRQ(ierr);
+  if (err > 1.e-12*nrm) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Relative error in MatMult() %g\n",(double)(err/nrm));CHKERRQ(ierr);}
+  else                  {ierr = PetscPrintf(PETSC_COMM_WORLD,"MatMult() agrees with the assembled matrix\n");CHKERRQ(ierr);}
+  ierr = MatMultAdd(B,x,x,z);CHKERRQ(ierr);
+  ierr = MatMultAdd(A,x,x,y);CHKERRQ(ierr);
+  ierr = VecAXPY(z,-1.0,y);CHKERRQ(ierr);
+  ierr = VecNorm(z,NORM_2,&err);CHKERRQ(ierr);
+  if (err > 1.e-12*nrm) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Relative error in MatMultAdd() %g\n",(double)(err/nrm));CHKERRQ(ierr);}
+  else                  {ierr = PetscPrintf(PETSC_COMM_WORLD,"MatMultAdd() agrees with the assembled matrix\n");CHKERRQ(ierr);}
+  ierr = MatGetDiagonal(A,y);CHKERRQ(ierr);
+  ierr = MatGetDiagonal(B,z);CHKERRQ(ierr);
+  ierr = VecNorm(z,NORM_2,&nrm);CHKERRQ(ierr);
+  ierr = VecAXPY(z,-1.0,y);CHKERRQ(ierr);
+  ierr = VecNorm(z,NORM_2,&err);CHKERRQ(ierr);
+  if (err > 1.e-12*nrm) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Relative error in MatGetDiagonal() %g\n",(double)(err/nrm));CHKERRQ(ierr);}
+  else                  {ierr = PetscPrintf(PETSC_COMM_WORLD,"MatGetDiagonal() agrees with the assembled matrix\n");CHKERRQ(ierr);}
+
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&z);CHKERRQ(ierr);
+  ierr = VecDestroy(&coef);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rnd);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = DMDestroy(&da);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return 0;
+}
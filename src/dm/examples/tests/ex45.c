@@ -0,0 +1,161 @@
+static char help[] = "Tests the dataset layout options of the HDF5 viewer with VecView()/VecLoad() of MPI and DMDA vectors.\n\n";
+
+/*
+Use the options
+     -nsteps <n> - number of timesteps written with -viewer_hdf5_timestep_append
+
+   and the HDF5 viewer options -viewer_hdf5_chunk_partition, -viewer_hdf5_compress <level>,
+   -viewer_hdf5_collective_metadata and -viewer_hdf5_timestep_append
+*/
+
+#include <petscdm.h>
+#include <petscdmda.h>
+#include <petscviewerhdf5.h>
+
+#undef __FUNCT__
+#define __FUNCT__ "SetTestValues"
+/* Fills x with non-integer values that depend on the global index and the timestep */
+static PetscErrorCode SetTestValues(Vec x,PetscInt step)
+{
+  PetscInt       i,rstart,rend;
+  PetscScalar    v;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecGetOwnershipRange(x,&rstart,&rend);CHKERRQ(ierr);
+  for (i=rstart; i<rend; i++) {
+    v    = 100.0*PetscSinReal(0.37*i) + i/3.0 + 0.5*step;
+    ierr = VecSetValues(x,1,&i,&v,INSERT_VALUES);CHKERRQ(ierr);
+  }
+  ierr = VecAssemblyBegin(x);CHKERRQ(ierr);
+  ierr = VecAssemblyEnd(x);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "CheckLayout"
+/*
+   Prints the layout of the dataset name: its time dimension, its sizes, how it is chunked and the number of filters.
+   lsizes[] holds the sizes of the part of the dataset written by this process, without the time dimension.
+*/
+static PetscErrorCode CheckLayout(PetscViewer viewer,const char name[],PetscInt dim,const PetscInt lsizes[])
+{
+  hid_t          file_id,dset_id,filespace,plist;
+  hsize_t        dims[6],maxDims[6],chunk[6];
+  PetscInt       gsizes[6],d,t;
+  PetscBool      whole = PETSC_TRUE,partition = PETSC_TRUE;
+  int            rdim,nfilters;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MPI_Allreduce((void*)lsizes,gsizes,dim,MPIU_INT,MPI_MAX,PETSC_COMM_WORLD);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5GetFileId(viewer,&file_id);CHKERRQ(ierr);
+  PetscStackCallHDF5Return(dset_id,H5Dopen2,(file_id,name,H5P_DEFAULT));
+  PetscStackCallHDF5Return(filespace,H5Dget_space,(dset_id));
+  PetscStackCallHDF5Return(rdim,H5Sget_simple_extent_dims,(filespace,dims,maxDims));
+  PetscStackCallHDF5Return(plist,H5Dget_create_plist,(dset_id));
+  PetscStackCallHDF5Return(nfilters,H5Pget_nfilters,(plist));
+  t    = (maxDims[0] == H5S_UNLIMITED) ? 1 : 0;
+  if (rdim < dim+t) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"Dataset %s has %d dimensions, expected at least %D",name,rdim,dim+t);
+  if (H5Pget_layout(plist) == H5D_CHUNKED) {
+    PetscStackCallHDF5Return(rdim,H5Pget_chunk,(plist,6,chunk));
+    if (t && chunk[0] != 1) whole = partition = PETSC_FALSE;
+    for (d=0; d<dim; d++) {
+      if (chunk[t+d] != dims[t+d])           whole     = PETSC_FALSE;
+      if (chunk[t+d] != (hsize_t) gsizes[d]) partition = PETSC_FALSE;
+    }
+  } else whole = partition = PETSC_FALSE;
+  PetscStackCallHDF5(H5Pclose,(plist));
+  PetscStackCallHDF5(H5Sclose,(filespace));
+  PetscStackCallHDF5(H5Dclose,(dset_id));
+
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Dataset %s:",name);CHKERRQ(ierr);
+  if (t) {ierr = PetscPrintf(PETSC_COMM_WORLD," %D timesteps,",(PetscInt)dims[0]);CHKERRQ(ierr);}
+  ierr = PetscPrintf(PETSC_COMM_WORLD," dimensions");CHKERRQ(ierr);
+  for (d=0; d<dim; d++) {ierr = PetscPrintf(PETSC_COMM_WORLD," %D",(PetscInt)dims[t+d]);CHKERRQ(ierr);}
+  ierr = PetscPrintf(PETSC_COMM_WORLD,", chunks %s, %d filters\n",whole ? "hold a whole timestep" : (partition ? "match the partition" : "have other sizes"),nfilters);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "CheckLoad"
+/* Loads every timestep of the vector named as y and compares it with the values written */
+static PetscErrorCode CheckLoad(PetscViewer viewer,Vec y,PetscInt nsteps,PetscBool append)
+{
+  Vec            x;
+  PetscInt       step;
+  PetscReal      nrm,err,maxerr = 0.0;
+  const char     *name;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetName((PetscObject)y,&name);CHKERRQ(ierr);
+  ierr = VecDuplicate(y,&x);CHKERRQ(ierr);
+  for (step=0; step<nsteps; step++) {
+    if (append) {ierr = PetscViewerHDF5SetTimestep(viewer,step);CHKERRQ(ierr);}
+    ierr   = VecLoad(y,viewer);CHKERRQ(ierr);
+    ierr   = SetTestValues(x,step);CHKERRQ(ierr);
+    ierr   = VecNorm(x,NORM_INFINITY,&nrm);CHKERRQ(ierr);
+    ierr   = VecAXPY(y,-1.0,x);CHKERRQ(ierr);
+    ierr   = VecNorm(y,NORM_INFINITY,&err);CHKERRQ(ierr);
+    maxerr = PetscMax(maxerr,err/nrm);
+  }
+  if (maxerr > 1.e-12) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Vector %s read back with relative error %g\n",name,(double)maxerr);CHKERRQ(ierr);}
+  else                 {ierr = PetscPrintf(PETSC_COMM_WORLD,"Vector %s read back correctly\n",name);CHKERRQ(ierr);}
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "main"
+int main(int argc,char **argv)
+{
+  DM             da;
+  Vec            x,u;
+  PetscViewer    viewer;
+  PetscInt       nsteps = 3,step,n,xs,ys,xm,ym,dof = 2,lsizes[3];
+  PetscBool      append;
+  PetscErrorCode ierr;
+
+  PetscInitialize(&argc,&argv,(char*)0,help);
+  ierr = PetscOptionsGetInt(NULL,"-nsteps",&nsteps,NULL);CHKERRQ(ierr);
+
+  ierr = VecCreate(PETSC_COMM_WORLD,&x);CHKERRQ(ierr);
+  ierr = VecSetSizes(x,PETSC_DECIDE,25);CHKERRQ(ierr);
+  ierr = VecSetFromOptions(x);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject)x,"x");CHKERRQ(ierr);
+
+  ierr = DMDACreate2d(PETSC_COMM_WORLD,DM_BOUNDARY_NONE,DM_BOUNDARY_NONE,DMDA_STENCIL_STAR,9,7,PETSC_DECIDE,PETSC_DECIDE,dof,1,NULL,NULL,&da);CHKERRQ(ierr);
+  ierr = DMCreateGlobalVector(da,&u);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject)u,"u");CHKERRQ(ierr);
+
+  /* Write the vectors, as a sequence of timesteps if they are appended */
+  ierr = PetscViewerHDF5Open(PETSC_COMM_WORLD,"ex45.h5",FILE_MODE_WRITE,&viewer);CHKERRQ(ierr);
+  ierr = PetscViewerSetFromOptions(viewer);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5GetTimestepAppend(viewer,&append);CHKERRQ(ierr);
+  if (!append) nsteps = 1;
+  for (step=0; step<nsteps; step++) {
+    ierr = SetTestValues(x,step);CHKERRQ(ierr);
+    ierr = VecView(x,viewer);CHKERRQ(ierr);
+    ierr = SetTestValues(u,step);CHKERRQ(ierr);
+    ierr = VecView(u,viewer);CHKERRQ(ierr);
+  }
+  ierr = PetscViewerDestroy(&viewer);CHKERRQ(ierr);
+
+  /* Check the layout of the datasets and read them back */
+  ierr = PetscViewerHDF5Open(PETSC_COMM_WORLD,"ex45.h5",FILE_MODE_READ,&viewer);CHKERRQ(ierr);
+  ierr = VecGetLocalSize(x,&n);CHKERRQ(ierr);
+  ierr = CheckLayout(viewer,"x",1,&n);CHKERRQ(ierr);
+  ierr = DMDAGetCorners(da,&xs,&ys,NULL,&xm,&ym,NULL);CHKERRQ(ierr);
+  lsizes[0] = ym; lsizes[1] = xm; lsizes[2] = dof;
+  ierr = CheckLayout(viewer,"u",3,lsizes);CHKERRQ(ierr);
+  ierr = CheckLoad(viewer,x,nsteps,append);CHKERRQ(ierr);
+  ierr = CheckLoad(viewer,u,nsteps,append);CHKERRQ(ierr);
+  ierr = PetscViewerDestroy(&viewer);CHKERRQ(ierr);
+
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&u);CHKERRQ(ierr);
+  ierr = DMDestroy(&da);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return 0;
+}
@@ -951,6 +951,7 @@ PetscErrorCode  DMRefine_DA(DM da,MPI_Comm comm,DM *daref)
   /* da2->ops->createinterpolation = da->ops->createinterpolation; this causes problem with SNESVI */
   da2->ops->getcoloring = da->ops->getcoloring;
   dd2->interptype       = dd->interptype;
+  dd2->topologyaware    = dd->topologyaware;
 
   /* copy fill information if given */
   if (dd->dfill) {
@@ -1081,6 +1082,7 @@ PetscErrorCode  DMCoarsen_DA(DM da, MPI_Comm comm,DM *daref)
   da2->ops->creatematrix = da->ops->creatematrix;
   da2->ops->getcoloring  = da->ops->getcoloring;
   dd2->interptype        = dd->interptype;
+  dd2->topologyaware     = dd->topologyaware;
 
   /* copy fill information if given */
   if (dd->dfill) {
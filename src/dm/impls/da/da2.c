@@ -235,7 +235,7 @@ PetscErrorCode  DMSetUp_DA_2D(DM da)
   PetscInt         *lx          = dd->lx;
   PetscInt         *ly          = dd->ly;
   MPI_Comm         comm;
-  PetscMPIInt      rank,size;
+  PetscMPIInt      rank,size,pos;
   PetscInt         xs,xe,ys,ye,x,y,Xs,Xe,Ys,Ye,IXs,IXe,IYs,IYe;
   PetscInt         up,down,left,right,i,n0,n1,n2,n3,n5,n6,n7,n8,*idx,nn;
   PetscInt         xbase,*bases,*ldims,j,x_t,y_t,s_t,base,count;
@@ -291,6 +291,9 @@ PetscErrorCode  DMSetUp_DA_2D(DM da)
   if (M < m) SETERRQ2(comm,PETSC_ERR_ARG_OUTOFRANGE,"Partition in x direction is too fine! %D %D",M,m);
   if (N < n) SETERRQ2(comm,PETSC_ERR_ARG_OUTOFRANGE,"Partition in y direction is too fine! %D %D",N,n);
 
+  /* pos is the lexicographic index of our subdomain, which is our rank unless the subdomains are placed by topology */
+  ierr = DMDASetUpRankMap_Private(da,m,n,1,&pos);CHKERRQ(ierr);
+
   /*
      Determine locally owned region
      xs is the first local node number, x is the number of local nodes
@@ -302,14 +305,14 @@ PetscErrorCode  DMSetUp_DA_2D(DM da)
       lx[i] = M/m + ((M % m) > i);
     }
   }
-  x  = lx[rank % m];
+  x  = lx[pos % m];
   xs = 0;
-  for (i=0; i<(rank % m); i++) {
+  for (i=0; i<(pos % m); i++) {
     xs += lx[i];
   }
 #if defined(PETSC_USE_DEBUG)
   left = xs;
-  for (i=(rank % m); i<m; i++) {
+  for (i=(pos % m); i<m; i++) {
     left += lx[i];
   }
   if (left != M) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Sum of lx across processors not equal to M: %D %D",left,M);
@@ -326,14 +329,14 @@ PetscErrorCode  DMSetUp_DA_2D(DM da)
       ly[i] = N/n + ((N % n) > i);
     }
   }
-  y  = ly[rank/m];
+  y  = ly[pos/m];
   ys = 0;
-  for (i=0; i<(rank/m); i++) {
+  for (i=0; i<(pos/m); i++) {
     ys += ly[i];
   }
 #if defined(PETSC_USE_DEBUG)
   left = ys;
-  for (i=(rank/m); i<n; i++) {
+  for (i=(pos/m); i<n; i++) {
     left += ly[i];
   }
   if (left != N) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Sum of ly across processors not equal to N: %D %D",left,N);
@@ -420,7 +423,12 @@ PetscErrorCode  DMSetUp_DA_2D(DM da)
   for (i=1; i<=size; i++) {
     bases[i] += bases[i-1];
   }
-  base = bases[rank]*dof;
+  if (dd->rankmap) {
+    /* index the starts by subdomain, as the neighbors n0, n1, ... below are */
+    ierr = PetscMemcpy(ldims,bases,size*sizeof(PetscInt));CHKERRQ(ierr);
+    for (i=0; i<size; i++) bases[i] = ldims[dd->rankmap[i]];
+  }
+  base = bases[pos]*dof;
 
   /* allocate the base parallel and sequential vectors */
   dd->Nlocal = x*y*dof;
@@ -495,26 +503,26 @@ PetscErrorCode  DMSetUp_DA_2D(DM da)
   */
 
   /* Assume the Non-Periodic Case */
-  n1 = rank - m;
-  if (rank % m) {
+  n1 = pos - m;
+  if (pos % m) {
     n0 = n1 - 1;
   } else {
     n0 = -1;
   }
-  if ((rank+1) % m) {
+  if ((pos+1) % m) {
     n2 = n1 + 1;
-    n5 = rank + 1;
-    n8 = rank + m + 1; if (n8 >= m*n) n8 = -1;
+    n5 = pos + 1;
+    n8 = pos + m + 1; if (n8 >= m*n) n8 = -1;
   } else {
     n2 = -1; n5 = -1; n8 = -1;
   }
-  if (rank % m) {
-    n3 = rank - 1;
+  if (pos % m) {
+    n3 = pos - 1;
     n6 = n3 + m; if (n6 >= m*n) n6 = -1;
   } else {
     n3 = -1; n6 = -1;
   }
-  n7 = rank + m; if (n7 >= m*n) n7 = -1;
+  n7 = pos + m; if (n7 >= m*n) n7 = -1;
 
   if (bx == DM_BOUNDARY_PERIODIC && by == DM_BOUNDARY_PERIODIC) {
     /* Modify for Periodic Cases */
@@ -525,34 +533,34 @@ PetscErrorCode  DMSetUp_DA_2D(DM da)
     if ((n0 < 0) && (n3 < 0) && (n1 < 0)) n0 = size-1;
 
     /* Handle Top and Bottom Sides */
-    if (n1 < 0) n1 = rank + m * (n-1);
-    if (n7 < 0) n7 = rank - m * (n-1);
-    if ((n3 >= 0) && (n0 < 0)) n0 = size - m + rank - 1;
-    if ((n3 >= 0) && (n6 < 0)) n6 = (rank%m)-1;
-    if ((n5 >= 0) && (n2 < 0)) n2 = size - m + rank + 1;
-    if ((n5 >= 0) && (n8 < 0)) n8 = (rank%m)+1;
+    if (n1 < 0) n1 = pos + m * (n-1);
+    if (n7 < 0) n7 = pos - m * (n-1);
+    if ((n3 >= 0) && (n0 < 0)) n0 = size - m + pos - 1;
+    if ((n3 >= 0) && (n6 < 0)) n6 = (pos%m)-1;
+    if ((n5 >= 0) && (n2 < 0)) n2 = size - m + pos + 1;
+    if ((n5 >= 0) && (n8 < 0)) n8 = (pos%m)+1;
 
     /* Handle Left and Right Sides */
-    if (n3 < 0) n3 = rank + (m-1);
-    if (n5 < 0) n5 = rank - (m-1);
-    if ((n1 >= 0) && (n0 < 0)) n0 = rank-1;
-    if ((n1 >= 0) && (n2 < 0)) n2 = rank-2*m+1;
-    if ((n7 >= 0) && (n6 < 0)) n6 = rank+2*m-1;
-    if ((n7 >= 0) && (n8 < 0)) n8 = rank+1;
+    if (n3 < 0) n3 = pos + (m-1);
+    if (n5 < 0) n5 = pos - (m-1);
+    if ((n1 >= 0) && (n0 < 0)) n0 = pos-1;
+    if ((n1 >= 0) && (n2 < 0)) n2 = pos-2*m+1;
+    if ((n7 >= 0) && (n6 < 0)) n6 = pos+2*m-1;
+    if ((n7 >= 0) && (n8 < 0)) n8 = pos+1;
   } else if (by == DM_BOUNDARY_PERIODIC) {  /* Handle Top and Bottom Sides */
-    if (n1 < 0) n1 = rank + m * (n-1);
-    if (n7 < 0) n7 = rank - m * (n-1);
-    if ((n3 >= 0) && (n0 < 0)) n0 = size - m + rank - 1;
-    if ((n3 >= 0) && (n6 < 0)) n6 = (rank%m)-1;
-    if ((n5 >= 0) && (n2 < 0)) n2 = size - m + rank + 1;
-    if ((n5 >= 0) && (n8 < 0)) n8 = (rank%m)+1;
+    if (n1 < 0) n1 = pos + m * (n-1);
+    if (n7 < 0) n7 = pos - m * (n-1);
+    if ((n3 >= 0) && (n0 < 0)) n0 = size - m + pos - 1;
+    if ((n3 >= 0) && (n6 < 0)) n6 = (pos%m)-1;
+    if ((n5 >= 0) && (n2 < 0)) n2 = size - m + pos + 1;
+    if ((n5 >= 0) && (n8 < 0)) n8 = (pos%m)+1;
   } else if (bx == DM_BOUNDARY_PERIODIC) { /* Handle Left and Right Sides */
-    if (n3 < 0) n3 = rank + (m-1);
-    if (n5 < 0) n5 = rank - (m-1);
-    if ((n1 >= 0) && (n0 < 0)) n0 = rank-1;
-    if ((n1 >= 0) && (n2 < 0)) n2 = rank-2*m+1;
-    if ((n7 >= 0) && (n6 < 0)) n6 = rank+2*m-1;
-    if ((n7 >= 0) && (n8 < 0)) n8 = rank+1;
+    if (n3 < 0) n3 = pos + (m-1);
+    if (n5 < 0) n5 = pos - (m-1);
+    if ((n1 >= 0) && (n0 < 0)) n0 = pos-1;
+    if ((n1 >= 0) && (n2 < 0)) n2 = pos-2*m+1;
+    if ((n7 >= 0) && (n6 < 0)) n6 = pos+2*m-1;
+    if ((n7 >= 0) && (n8 < 0)) n8 = pos+1;
   }
 
   ierr = PetscMalloc1(9,&dd->neighbors);CHKERRQ(ierr);
@@ -566,6 +574,9 @@ PetscErrorCode  DMSetUp_DA_2D(DM da)
   dd->neighbors[6] = n6;
   dd->neighbors[7] = n7;
   dd->neighbors[8] = n8;
+  if (dd->rankmap) {
+    for (i=0; i<9; i++) if (i != 4 && dd->neighbors[i] >= 0) dd->neighbors[i] = dd->rankmap[dd->neighbors[i]];
+  }
 
   if (stencil_type == DMDA_STENCIL_STAR) {
     /* save corner processor numbers */
@@ -576,7 +587,7 @@ PetscErrorCode  DMSetUp_DA_2D(DM da)
   ierr = PetscMalloc1((Xe-Xs)*(Ye-Ys),&idx);CHKERRQ(ierr);
 
   nn = 0;
-  xbase = bases[rank];
+  xbase = bases[pos];
   for (i=1; i<=s_y; i++) {
     if (n0 >= 0) { /* left below */
       x_t = lx[n0 % m];
@@ -591,7 +602,7 @@ PetscErrorCode  DMSetUp_DA_2D(DM da)
       s_t = bases[n1] + x_t*y_t - (s_y+1-i)*x_t;
       for (j=0; j<x_t; j++) idx[nn++] = s_t++;
     } else if (by == DM_BOUNDARY_MIRROR) {
-      for (j=0; j<x; j++) idx[nn++] = bases[rank] + x*(s_y - i + 1)  + j;
+      for (j=0; j<x; j++) idx[nn++] = bases[pos] + x*(s_y - i + 1)  + j;
     }
 
     if (n2 >= 0) { /* right below */
@@ -609,7 +620,7 @@ PetscErrorCode  DMSetUp_DA_2D(DM da)
       s_t = bases[n3] + (i+1)*x_t - s_x;
       for (j=0; j<s_x; j++) idx[nn++] = s_t++;
     } else if (bx == DM_BOUNDARY_MIRROR) {
-      for (j=0; j<s_x; j++) idx[nn++] = bases[rank] + x*i + s_x - j;
+      for (j=0; j<s_x; j++) idx[nn++] = bases[pos] + x*i + s_x - j;
     }
 
     for (j=0; j<x; j++) idx[nn++] = xbase++; /* interior */
@@ -620,7 +631,7 @@ PetscErrorCode  DMSetUp_DA_2D(DM da)
       s_t = bases[n5] + (i)*x_t;
       for (j=0; j<s_x; j++) idx[nn++] = s_t++;
     } else if (bx == DM_BOUNDARY_MIRROR) {
-      for (j=0; j<s_x; j++) idx[nn++] = bases[rank] + x*(i + 1) - 2 - j;
+      for (j=0; j<s_x; j++) idx[nn++] = bases[pos] + x*(i + 1) - 2 - j;
     }
   }
 
@@ -638,7 +649,7 @@ PetscErrorCode  DMSetUp_DA_2D(DM da)
       s_t = bases[n7] + (i-1)*x_t;
       for (j=0; j<x_t; j++) idx[nn++] = s_t++;
     } else if (by == DM_BOUNDARY_MIRROR) {
-      for (j=0; j<x; j++) idx[nn++] = bases[rank] + x*(y - i - 1)  + j;
+      for (j=0; j<x; j++) idx[nn++] = bases[pos] + x*(y - i - 1)  + j;
     }
 
     if (n8 >= 0) { /* right above */
@@ -668,7 +679,7 @@ PetscErrorCode  DMSetUp_DA_2D(DM da)
       but not periodic indices.
     */
     nn    = 0;
-    xbase = bases[rank];
+    xbase = bases[pos];
     for (i=1; i<=s_y; i++) {
       if (n0 >= 0) { /* left below */
         x_t = lx[n0 % m];
@@ -685,7 +696,7 @@ PetscErrorCode  DMSetUp_DA_2D(DM da)
         for (j=0; j<x_t; j++) idx[nn++] = s_t++;
       } else if (ys-Ys > 0) {
         if (by == DM_BOUNDARY_MIRROR) {
-          for (j=0; j<x; j++) idx[nn++] = bases[rank] + x*(s_y - i + 1)  + j;
+          for (j=0; j<x; j++) idx[nn++] = bases[pos] + x*(s_y - i + 1)  + j;
         } else {
           for (j=0; j<x; j++) idx[nn++] = -1;
         }
@@ -708,7 +719,7 @@ PetscErrorCode  DMSetUp_DA_2D(DM da)
         for (j=0; j<s_x; j++) idx[nn++] = s_t++;
       } else if (xs-Xs > 0) {
         if (bx == DM_BOUNDARY_MIRROR) {
-          for (j=0; j<s_x; j++) idx[nn++] = bases[rank] + x*i + s_x - j;
+          for (j=0; j<s_x; j++) idx[nn++] = bases[pos] + x*i + s_x - j;
         } else {
           for (j=0; j<s_x; j++) idx[nn++] = -1;
         }
@@ -723,7 +734,7 @@ PetscErrorCode  DMSetUp_DA_2D(DM da)
         for (j=0; j<s_x; j++) idx[nn++] = s_t++;
       } else if (Xe-xe > 0) {
         if (bx == DM_BOUNDARY_MIRROR) {
-          for (j=0; j<s_x; j++) idx[nn++] = bases[rank] + x*(i + 1) - 2 - j;
+          for (j=0; j<s_x; j++) idx[nn++] = bases[pos] + x*(i + 1) - 2 - j;
         } else {
           for (j=0; j<s_x; j++) idx[nn++] = -1;
         }
@@ -746,7 +757,7 @@ PetscErrorCode  DMSetUp_DA_2D(DM da)
         for (j=0; j<x_t; j++) idx[nn++] = s_t++;
       } else if (Ye-ye > 0) {
         if (by == DM_BOUNDARY_MIRROR) {
-          for (j=0; j<x; j++) idx[nn++] = bases[rank] + x*(y - i - 1)  + j;
+          for (j=0; j<x; j++) idx[nn++] = bases[pos] + x*(y - i - 1)  + j;
         } else {
           for (j=0; j<x; j++) idx[nn++] = -1;
         }
@@ -187,7 +187,7 @@ PetscErrorCode  DMSetUp_DA_3D(DM da)
   PetscInt         *ly          = dd->ly;
   PetscInt         *lz          = dd->lz;
   MPI_Comm         comm;
-  PetscMPIInt      rank,size;
+  PetscMPIInt      rank,size,pos;
   PetscInt         xs = 0,xe,ys = 0,ye,zs = 0,ze,x = 0,y = 0,z = 0;
   PetscInt         Xs,Xe,Ys,Ye,Zs,Ze,IXs,IXe,IYs,IYe,IZs,IZe,pm;
   PetscInt         left,right,up,down,bottom,top,i,j,k,*idx,nn;
@@ -293,6 +293,9 @@ PetscErrorCode  DMSetUp_DA_3D(DM da)
   if (N < n) SETERRQ2(PetscObjectComm((PetscObject)da),PETSC_ERR_ARG_OUTOFRANGE,"Partition in y direction is too fine! %D %D",N,n);
   if (P < p) SETERRQ2(PetscObjectComm((PetscObject)da),PETSC_ERR_ARG_OUTOFRANGE,"Partition in z direction is too fine! %D %D",P,p);
 
+  /* pos is the lexicographic index of our subdomain, which is our rank unless the subdomains are placed by topology */
+  ierr = DMDASetUpRankMap_Private(da,m,n,p,&pos);CHKERRQ(ierr);
+
   /*
      Determine locally owned region
      [x, y, or z]s is the first local node number, [x, y, z] is the number of local nodes
@@ -303,9 +306,9 @@ PetscErrorCode  DMSetUp_DA_3D(DM da)
     lx   = dd->lx;
     for (i=0; i<m; i++) lx[i] = M/m + ((M % m) > (i % m));
   }
-  x  = lx[rank % m];
+  x  = lx[pos % m];
   xs = 0;
-  for (i=0; i<(rank%m); i++) xs += lx[i];
+  for (i=0; i<(pos%m); i++) xs += lx[i];
   if ((x < s) && ((m > 1) || (bx == DM_BOUNDARY_PERIODIC))) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Local x-width of domain x %D is smaller than stencil width s %D",x,s);
 
   if (!ly) {
@@ -313,18 +316,18 @@ PetscErrorCode  DMSetUp_DA_3D(DM da)
     ly   = dd->ly;
     for (i=0; i<n; i++) ly[i] = N/n + ((N % n) > (i % n));
   }
-  y = ly[(rank % (m*n))/m];
+  y = ly[(pos % (m*n))/m];
   if ((y < s) && ((n > 1) || (by == DM_BOUNDARY_PERIODIC))) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Local y-width of domain y %D is smaller than stencil width s %D",y,s);
 
   ys = 0;
-  for (i=0; i<(rank % (m*n))/m; i++) ys += ly[i];
+  for (i=0; i<(pos % (m*n))/m; i++) ys += ly[i];
 
   if (!lz) {
     ierr = PetscMalloc1(p, &dd->lz);CHKERRQ(ierr);
     lz = dd->lz;
     for (i=0; i<p; i++) lz[i] = P/p + ((P % p) > (i % p));
   }
-  z = lz[rank/(m*n)];
+  z = lz[pos/(m*n)];
 
   /* note this is different than x- and y-, as we will handle as an important special
    case when p=P=1 and DM_BOUNDARY_PERIODIC and s > z.  This is to deal with 2D problems
@@ -333,7 +336,7 @@ PetscErrorCode  DMSetUp_DA_3D(DM da)
   if (P == 1) twod = PETSC_TRUE;
   else if ((z < s) && ((p > 1) || (bz == DM_BOUNDARY_PERIODIC))) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Local z-width of domain z %D is smaller than stencil width s %D",z,s);
   zs = 0;
-  for (i=0; i<(rank/(m*n)); i++) zs += lz[i];
+  for (i=0; i<(pos/(m*n)); i++) zs += lz[i];
   ye = ys + y;
   xe = xs + x;
   ze = zs + z;
@@ -418,7 +421,12 @@ PetscErrorCode  DMSetUp_DA_3D(DM da)
   bases[0] = 0;
   for (i=1; i<=size; i++) bases[i] = ldims[i-1];
   for (i=1; i<=size; i++) bases[i] += bases[i-1];
-  base = bases[rank]*dof;
+  if (dd->rankmap) {
+    /* index the starts by subdomain, as the neighbors n0, n1, ... below are */
+    ierr = PetscMemcpy(ldims,bases,size*sizeof(PetscInt));CHKERRQ(ierr);
+    for (i=0; i<size; i++) bases[i] = ldims[dd->rankmap[i]];
+  }
+  base = bases[pos]*dof;
 
   /* allocate the base parallel and sequential vectors */
   dd->Nlocal = x*y*z*dof;
@@ -507,179 +515,179 @@ PetscErrorCode  DMSetUp_DA_3D(DM da)
 
   /* Solve for X,Y, and Z Periodic Case First, Then Modify Solution */
   /* Assume Nodes are Internal to the Cube */
-  n0 = rank - m*n - m - 1;
-  n1 = rank - m*n - m;
-  n2 = rank - m*n - m + 1;
-  n3 = rank - m*n -1;
-  n4 = rank - m*n;
-  n5 = rank - m*n + 1;
-  n6 = rank - m*n + m - 1;
-  n7 = rank - m*n + m;
-  n8 = rank - m*n + m + 1;
-
-  n9  = rank - m - 1;
-  n10 = rank - m;
-  n11 = rank - m + 1;
-  n12 = rank - 1;
-  n14 = rank + 1;
-  n15 = rank + m - 1;
-  n16 = rank + m;
-  n17 = rank + m + 1;
-
-  n18 = rank + m*n - m - 1;
-  n19 = rank + m*n - m;
-  n20 = rank + m*n - m + 1;
-  n21 = rank + m*n - 1;
-  n22 = rank + m*n;
-  n23 = rank + m*n + 1;
-  n24 = rank + m*n + m - 1;
-  n25 = rank + m*n + m;
-  n26 = rank + m*n + m + 1;
+  n0 = pos - m*n - m - 1;
+  n1 = pos - m*n - m;
+  n2 = pos - m*n - m + 1;
+  n3 = pos - m*n -1;
+  n4 = pos - m*n;
+  n5 = pos - m*n + 1;
+  n6 = pos - m*n + m - 1;
+  n7 = pos - m*n + m;
+  n8 = pos - m*n + m + 1;
+
+  n9  = pos - m - 1;
+  n10 = pos - m;
+  n11 = pos - m + 1;
+  n12 = pos - 1;
+  n14 = pos + 1;
+  n15 = pos + m - 1;
+  n16 = pos + m;
+  n17 = pos + m + 1;
+
+  n18 = pos + m*n - m - 1;
+  n19 = pos + m*n - m;
+  n20 = pos + m*n - m + 1;
+  n21 = pos + m*n - 1;
+  n22 = pos + m*n;
+  n23 = pos + m*n + 1;
+  n24 = pos + m*n + m - 1;
+  n25 = pos + m*n + m;
+  n26 = pos + m*n + m + 1;
 
   /* Assume Pieces are on Faces of Cube */
 
   if (xs == 0) { /* First assume not corner or edge */
-    n0  = rank       -1 - (m*n);
-    n3  = rank + m   -1 - (m*n);
-    n6  = rank + 2*m -1 - (m*n);
-    n9  = rank       -1;
-    n12 = rank + m   -1;
-    n15 = rank + 2*m -1;
-    n18 = rank       -1 + (m*n);
-    n21 = rank + m   -1 + (m*n);
-    n24 = rank + 2*m -1 + (m*n);
+    n0  = pos       -1 - (m*n);
+    n3  = pos + m   -1 - (m*n);
+    n6  = pos + 2*m -1 - (m*n);
+    n9  = pos       -1;
+    n12 = pos + m   -1;
+    n15 = pos + 2*m -1;
+    n18 = pos       -1 + (m*n);
+    n21 = pos + m   -1 + (m*n);
+    n24 = pos + 2*m -1 + (m*n);
   }
 
   if (xe == M) { /* First assume not corner or edge */
-    n2  = rank -2*m +1 - (m*n);
-    n5  = rank - m  +1 - (m*n);
-    n8  = rank      +1 - (m*n);
-    n11 = rank -2*m +1;
-    n14 = rank - m  +1;
-    n17 = rank      +1;
-    n20 = rank -2*m +1 + (m*n);
-    n23 = rank - m  +1 + (m*n);
-    n26 = rank      +1 + (m*n);
+    n2  = pos -2*m +1 - (m*n);
+    n5  = pos - m  +1 - (m*n);
+    n8  = pos      +1 - (m*n);
+    n11 = pos -2*m +1;
+    n14 = pos - m  +1;
+    n17 = pos      +1;
+    n20 = pos -2*m +1 + (m*n);
+    n23 = pos - m  +1 + (m*n);
+    n26 = pos      +1 + (m*n);
   }
 
   if (ys==0) { /* First assume not corner or edge */
-    n0  = rank + m * (n-1) -1 - (m*n);
-    n1  = rank + m * (n-1)    - (m*n);
-    n2  = rank + m * (n-1) +1 - (m*n);
-    n9  = rank + m * (n-1) -1;
-    n10 = rank + m * (n-1);
-    n11 = rank + m * (n-1) +1;
-    n18 = rank + m * (n-1) -1 + (m*n);
-    n19 = rank + m * (n-1)    + (m*n);
-    n20 = rank + m * (n-1) +1 + (m*n);
+    n0  = pos + m * (n-1) -1 - (m*n);
+    n1  = pos + m * (n-1)    - (m*n);
+    n2  = pos + m * (n-1) +1 - (m*n);
+    n9  = pos + m * (n-1) -1;
+    n10 = pos + m * (n-1);
+    n11 = pos + m * (n-1) +1;
+    n18 = pos + m * (n-1) -1 + (m*n);
+    n19 = pos + m * (n-1)    + (m*n);
+    n20 = pos + m * (n-1) +1 + (m*n);
   }
 
   if (ye == N) { /* First assume not corner or edge */
-    n6  = rank - m * (n-1) -1 - (m*n);
-    n7  = rank - m * (n-1)    - (m*n);
-    n8  = rank - m * (n-1) +1 - (m*n);
-    n15 = rank - m * (n-1) -1;
-    n16 = rank - m * (n-1);
-    n17 = rank - m * (n-1) +1;
-    n24 = rank - m * (n-1) -1 + (m*n);
-    n25 = rank - m * (n-1)    + (m*n);
-    n26 = rank - m * (n-1) +1 + (m*n);
+    n6  = pos - m * (n-1) -1 - (m*n);
+    n7  = pos - m * (n-1)    - (m*n);
+    n8  = pos - m * (n-1) +1 - (m*n);
+    n15 = pos - m * (n-1) -1;
+    n16 = pos - m * (n-1);
+    n17 = pos - m * (n-1) +1;
+    n24 = pos - m * (n-1) -1 + (m*n);
+    n25 = pos - m * (n-1)    + (m*n);
+    n26 = pos - m * (n-1) +1 + (m*n);
   }
 
   if (zs == 0) { /* First assume not corner or edge */
-    n0 = size - (m*n) + rank - m - 1;
-    n1 = size - (m*n) + rank - m;
-    n2 = size - (m*n) + rank - m + 1;
-    n3 = size - (m*n) + rank - 1;
-    n4 = size - (m*n) + rank;
-    n5 = size - (m*n) + rank + 1;
-    n6 = size - (m*n) + rank + m - 1;
-    n7 = size - (m*n) + rank + m;
-    n8 = size - (m*n) + rank + m + 1;
+    n0 = size - (m*n) + pos - m - 1;
+    n1 = size - (m*n) + pos - m;
+    n2 = size - (m*n) + pos - m + 1;
+    n3 = size - (m*n) + pos - 1;
+    n4 = size - (m*n) + pos;
+    n5 = size - (m*n) + pos + 1;
+    n6 = size - (m*n) + pos + m - 1;
+    n7 = size - (m*n) + pos + m;
+    n8 = size - (m*n) + pos + m + 1;
   }
 
   if (ze == P) { /* First assume not corner or edge */
-    n18 = (m*n) - (size-rank) - m - 1;
-    n19 = (m*n) - (size-rank) - m;
-    n20 = (m*n) - (size-rank) - m + 1;
-    n21 = (m*n) - (size-rank) - 1;
-    n22 = (m*n) - (size-rank);
-    n23 = (m*n) - (size-rank) + 1;
-    n24 = (m*n) - (size-rank) + m - 1;
-    n25 = (m*n) - (size-rank) + m;
-    n26 = (m*n) - (size-rank) + m + 1;
+    n18 = (m*n) - (size-pos) - m - 1;
+    n19 = (m*n) - (size-pos) - m;
+    n20 = (m*n) - (size-pos) - m + 1;
+    n21 = (m*n) - (size-pos) - 1;
+    n22 = (m*n) - (size-pos);
+    n23 = (m*n) - (size-pos) + 1;
+    n24 = (m*n) - (size-pos) + m - 1;
+    n25 = (m*n) - (size-pos) + m;
+    n26 = (m*n) - (size-pos) + m + 1;
   }
 
   if ((xs==0) && (zs==0)) { /* Assume an edge, not corner */
-    n0 = size - m*n + rank + m-1 - m;
-    n3 = size - m*n + rank + m-1;
-    n6 = size - m*n + rank + m-1 + m;
+    n0 = size - m*n + pos + m-1 - m;
+    n3 = size - m*n + pos + m-1;
+    n6 = size - m*n + pos + m-1 + m;
   }
 
   if ((xs==0) && (ze==P)) { /* Assume an edge, not corner */
-    n18 = m*n - (size - rank) + m-1 - m;
-    n21 = m*n - (size - rank) + m-1;
-    n24 = m*n - (size - rank) + m-1 + m;
+    n18 = m*n - (size - pos) + m-1 - m;
+    n21 = m*n - (size - pos) + m-1;
+    n24 = m*n - (size - pos) + m-1 + m;
   }
 
   if ((xs==0) && (ys==0)) { /* Assume an edge, not corner */
-    n0  = rank + m*n -1 - m*n;
-    n9  = rank + m*n -1;
-    n18 = rank + m*n -1 + m*n;
+    n0  = pos + m*n -1 - m*n;
+    n9  = pos + m*n -1;
+    n18 = pos + m*n -1 + m*n;
   }
 
   if ((xs==0) && (ye==N)) { /* Assume an edge, not corner */
-    n6  = rank - m*(n-1) + m-1 - m*n;
-    n15 = rank - m*(n-1) + m-1;
-    n24 = rank - m*(n-1) + m-1 + m*n;
+    n6  = pos - m*(n-1) + m-1 - m*n;
+    n15 = pos - m*(n-1) + m-1;
+    n24 = pos - m*(n-1) + m-1 + m*n;
   }
 
   if ((xe==M) && (zs==0)) { /* Assume an edge, not corner */
-    n2 = size - (m*n-rank) - (m-1) - m;
-    n5 = size - (m*n-rank) - (m-1);
-    n8 = size - (m*n-rank) - (m-1) + m;
+    n2 = size - (m*n-pos) - (m-1) - m;
+    n5 = size - (m*n-pos) - (m-1);
+    n8 = size - (m*n-pos) - (m-1) + m;
   }
 
   if ((xe==M) && (ze==P)) { /* Assume an edge, not corner */
-    n20 = m*n - (size - rank) - (m-1) - m;
-    n23 = m*n - (size - rank) - (m-1);
-    n26 = m*n - (size - rank) - (m-1) + m;
+    n20 = m*n - (size - pos) - (m-1) - m;
+    n23 = m*n - (size - pos) - (m-1);
+    n26 = m*n - (size - pos) - (m-1) + m;
   }
 
   if ((xe==M) && (ys==0)) { /* Assume an edge, not corner */
-    n2  = rank + m*(n-1) - (m-1) - m*n;
-    n11 = rank + m*(n-1) - (m-1);
-    n20 = rank + m*(n-1) - (m-1) + m*n;
+    n2  = pos + m*(n-1) - (m-1) - m*n;
+    n11 = pos + m*(n-1) - (m-1);
+    n20 = pos + m*(n-1) - (m-1) + m*n;
   }
 
   if ((xe==M) && (ye==N)) { /* Assume an edge, not corner */
-    n8  = rank - m*n +1 - m*n;
-    n17 = rank - m*n +1;
-    n26 = rank - m*n +1 + m*n;
+    n8  = pos - m*n +1 - m*n;
+    n17 = pos - m*n +1;
+    n26 = pos - m*n +1 + m*n;
   }
 
   if ((ys==0) && (zs==0)) { /* Assume an edge, not corner */
-    n0 = size - m + rank -1;
-    n1 = size - m + rank;
-    n2 = size - m + rank +1;
+    n0 = size - m + pos -1;
+    n1 = size - m + pos;
+    n2 = size - m + pos +1;
   }
 
   if ((ys==0) && (ze==P)) { /* Assume an edge, not corner */
-    n18 = m*n - (size - rank) + m*(n-1) -1;
-    n19 = m*n - (size - rank) + m*(n-1);
-    n20 = m*n - (size - rank) + m*(n-1) +1;
+    n18 = m*n - (size - pos) + m*(n-1) -1;
+    n19 = m*n - (size - pos) + m*(n-1);
+    n20 = m*n - (size - pos) + m*(n-1) +1;
   }
 
   if ((ye==N) && (zs==0)) { /* Assume an edge, not corner */
-    n6 = size - (m*n-rank) - m * (n-1) -1;
-    n7 = size - (m*n-rank) - m * (n-1);
-    n8 = size - (m*n-rank) - m * (n-1) +1;
+    n6 = size - (m*n-pos) - m * (n-1) -1;
+    n7 = size - (m*n-pos) - m * (n-1);
+    n8 = size - (m*n-pos) - m * (n-1) +1;
   }
 
   if ((ye==N) && (ze==P)) { /* Assume an edge, not corner */
-    n24 = rank - (size-m) -1;
-    n25 = rank - (size-m);
-    n26 = rank - (size-m) +1;
+    n24 = pos - (size-m) -1;
+    n25 = pos - (size-m);
+    n26 = pos - (size-m) +1;
   }
 
   /* Check for Corners */
@@ -741,6 +749,9 @@ PetscErrorCode  DMSetUp_DA_3D(DM da)
   dd->neighbors[24] = n24;
   dd->neighbors[25] = n25;
   dd->neighbors[26] = n26;
+  if (dd->rankmap) {
+    for (i=0; i<27; i++) if (i != 13 && dd->neighbors[i] >= 0) dd->neighbors[i] = dd->rankmap[dd->neighbors[i]];
+  }
 
   /* If star stencil then delete the corner neighbors */
   if (stencil_type == DMDA_STENCIL_STAR) {
@@ -883,7 +894,7 @@ PetscErrorCode  DMSetUp_DA_3D(DM da)
       }
 
       /* Interior */
-      s_t = bases[rank] + i*x + k*x*y;
+      s_t = bases[pos] + i*x + k*x*y;
       for (j=0; j<x; j++) idx[nn++] = s_t++;
 
       if (n14 >= 0) { /* directly right */
@@ -1185,7 +1196,7 @@ PetscErrorCode  DMSetUp_DA_3D(DM da)
         }
 
         /* Interior */
-        s_t = bases[rank] + i*x + k*x*y;
+        s_t = bases[pos] + i*x + k*x*y;
         for (j=0; j<x; j++) idx[nn++] = s_t++;
 
         if (n14 >= 0) { /* directly right */
@@ -391,10 +391,20 @@ PetscErrorCode  DMDAGetReducedDMDA(DM da,PetscInt nfields,DM *nda)
   ierr = DMDAGetOwnershipRanges(da,&lx,&ly,&lz);CHKERRQ(ierr);
   if (dim == 1) {
     ierr = DMDACreate1d(PetscObjectComm((PetscObject)da),bx,M,nfields,s,dd->lx,nda);CHKERRQ(ierr);
-  } else if (dim == 2) {
-    ierr = DMDACreate2d(PetscObjectComm((PetscObject)da),bx,by,stencil_type,M,N,m,n,nfields,s,lx,ly,nda);CHKERRQ(ierr);
-  } else if (dim == 3) {
-    ierr = DMDACreate3d(PetscObjectComm((PetscObject)da),bx,by,bz,stencil_type,M,N,P,m,n,p,nfields,s,lx,ly,lz,nda);CHKERRQ(ierr);
+  } else {
+    /* as DMDACreate2d() and DMDACreate3d(), but the reduced DMDA must keep the placement of the subdomains */
+    ierr = DMDACreate(PetscObjectComm((PetscObject)da),nda);CHKERRQ(ierr);
+    ierr = DMSetDimension(*nda,dim);CHKERRQ(ierr);
+    ierr = DMDASetSizes(*nda,M,N,dim == 3 ? P : 1);CHKERRQ(ierr);
+    ierr = DMDASetNumProcs(*nda,m,n,dim == 3 ? p : PETSC_DECIDE);CHKERRQ(ierr);
+    ierr = DMDASetBoundaryType(*nda,bx,by,dim == 3 ? bz : DM_BOUNDARY_NONE);CHKERRQ(ierr);
+    ierr = DMDASetDof(*nda,nfields);CHKERRQ(ierr);
+    ierr = DMDASetStencilType(*nda,stencil_type);CHKERRQ(ierr);
+    ierr = DMDASetStencilWidth(*nda,s);CHKERRQ(ierr);
+    ierr = DMDASetOwnershipRanges(*nda,lx,ly,dim == 3 ? lz : NULL);CHKERRQ(ierr);
+    ierr = DMDASetTopologyAware(*nda,dd->topologyaware);CHKERRQ(ierr);
+    ierr = DMSetFromOptions(*nda);CHKERRQ(ierr);
+    ierr = DMSetUp(*nda);CHKERRQ(ierr);
   }
   if (da->coordinates) {
     ierr = PetscObjectReference((PetscObject)da->coordinates);CHKERRQ(ierr);
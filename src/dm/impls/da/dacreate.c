@@ -47,6 +47,7 @@ PetscErrorCode  DMSetFromOptions_DA(PetscOptions *PetscOptionsObject,DM da)
   ierr = PetscOptionsInt("-da_processors_x","Number of processors in x direction","DMDASetNumProcs",dd->m,&dd->m,NULL);CHKERRQ(ierr);
   if (dim > 1) {ierr = PetscOptionsInt("-da_processors_y","Number of processors in y direction","DMDASetNumProcs",dd->n,&dd->n,NULL);CHKERRQ(ierr);}
   if (dim > 2) {ierr = PetscOptionsInt("-da_processors_z","Number of processors in z direction","DMDASetNumProcs",dd->p,&dd->p,NULL);CHKERRQ(ierr);}
+  ierr = PetscOptionsBool("-da_topology_aware","Place neighboring subdomains on the same node","DMDASetTopologyAware",dd->topologyaware,&dd->topologyaware,NULL);CHKERRQ(ierr);
   /* Handle DMDA refinement */
   ierr = PetscOptionsInt("-da_refine_x","Refinement ratio in x direction","DMDASetRefinementFactor",dd->refine_x,&dd->refine_x,NULL);CHKERRQ(ierr);
   if (dim > 1) {ierr = PetscOptionsInt("-da_refine_y","Refinement ratio in y direction","DMDASetRefinementFactor",dd->refine_y,&dd->refine_y,NULL);CHKERRQ(ierr);}
@@ -391,6 +392,7 @@ PETSC_EXTERN PetscErrorCode DMCreate_DA(DM da)
   dd->lx           = NULL;
   dd->ly           = NULL;
   dd->lz           = NULL;
+  dd->rankmap      = NULL;
 
   dd->elementtype = DMDA_ELEMENT_Q1;
 
@@ -33,7 +33,7 @@ PetscErrorCode DMDACreatePatchIS(DM da,MatStencil *lower,MatStencil *upper,IS *i
   PetscInt       ox,oy,oz;
   PetscInt       m,n,p,M,N,P,dof;
   PetscInt       nindices;
-  PetscInt       *indices;
+  PetscInt       *indices,*starts = NULL,*sizes = NULL;
   DM_DA          *dd = (DM_DA*)da->data;
   PetscErrorCode ierr;
 
@@ -46,6 +46,15 @@ PetscErrorCode DMDACreatePatchIS(DM da,MatStencil *lower,MatStencil *upper,IS *i
   ierr = DMDAGetOwnershipRanges(da,&lx,&ly,&lz);CHKERRQ(ierr);
   nindices = (upper->i - lower->i)*(upper->j - lower->j)*(upper->k - lower->k)*dof;
   ierr = PetscMalloc1(nindices,&indices);CHKERRQ(ierr);
+  if (dd->rankmap) {
+    PetscInt q,r;
+
+    /* the subdomains are not numbered in rank order, so find the global start of each one */
+    ierr = PetscMalloc2(m*n*p,&starts,m*n*p+1,&sizes);CHKERRQ(ierr);
+    for (q=0; q<m*n*p; q++) sizes[dd->rankmap[q]+1] = lx[q % m]*(ly ? ly[(q/m) % n] : 1)*(lz ? lz[q/(m*n)] : 1);
+    for (r=0,sizes[0]=0; r<m*n*p; r++) sizes[r+1] += sizes[r];
+    for (q=0; q<m*n*p; q++) starts[q] = sizes[dd->rankmap[q]];
+  }
   /* start at index 0 on processor 0 */
   mr = 0;
   nr = 0;
@@ -110,7 +119,8 @@ PetscErrorCode DMDACreatePatchIS(DM da,MatStencil *lower,MatStencil *upper,IS *i
         xm = me - ms;
         ym = ne - ns;
         zm = pe - ps;
-        base = ms*ym*zm + ns*M*zm + ps*M*N;
+        if (starts) base = starts[(pr*n + nr)*m + mr];
+        else        base = ms*ym*zm + ns*M*zm + ps*M*N;
         /* compute the local coordinates on owning processor */
         si = ii - ms;
         sj = jj - ns;
@@ -122,6 +132,7 @@ PetscErrorCode DMDACreatePatchIS(DM da,MatStencil *lower,MatStencil *upper,IS *i
       }
     }
   }
+  if (starts) {ierr = PetscFree2(starts,sizes);CHKERRQ(ierr);}
   ISCreateGeneral(PETSC_COMM_SELF,idx,indices,PETSC_OWN_POINTER,is);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -6,7 +6,7 @@
 #include <petsc/private/dmdaimpl.h>    /*I   "petscdmda.h"   I*/
 
 /* Logging support */
-PetscLogEvent DMDA_LocalADFunction;
+PetscLogEvent DMDA_LocalADFunction, DMDA_StencilMult;
 
 #undef __FUNCT__
 #define __FUNCT__ "DMDestroy_Private"
@@ -77,6 +77,7 @@ PetscErrorCode  DMDestroy_DA(DM da)
   ierr = PetscFree(dd->lx);CHKERRQ(ierr);
   ierr = PetscFree(dd->ly);CHKERRQ(ierr);
   ierr = PetscFree(dd->lz);CHKERRQ(ierr);
+  ierr = PetscFree(dd->rankmap);CHKERRQ(ierr);
 
   if (dd->fieldname) {
     for (i=0; i<dd->w; i++) {
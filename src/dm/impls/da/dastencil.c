@@ -0,0 +1,361 @@
+/*
+  Matrix-free application of a constant or variable coefficient stencil on a DMDA
+*/
+
+#include <petsc/private/dmdaimpl.h>    /*I   "petscdmda.h"   I*/
+
+typedef struct {
+  DM              da;
+  PetscInt        dof;        /* Components per grid point */
+  PetscInt        n;          /* Number of stencil entries */
+  PetscInt       *rowc;       /* Component of the output point each entry adds to */
+  PetscInt       *colc;       /* Component of the input point each entry reads */
+  PetscInt       *off;        /* Offsets (i,j,k) of the input point of each entry */
+  PetscScalar    *v;          /* Weight of each entry */
+  Vec             coef;       /* Optional coefficients, n per owned grid point, scaling the weights */
+  PetscInt        M[3];       /* Global grid size */
+  PetscBool       periodic[3];
+  PetscInt        xs[3], xm[3];   /* Owned corner and size */
+  PetscInt        gxs[3], gxm[3]; /* Ghosted corner and size */
+  PetscInt        is[3], ie[3];   /* Interior points, whose stencil stays in the owned region */
+  PetscBool       ghosts;     /* Some process needs ghost values */
+  PetscInt        tile[2];    /* Cache block size in the i and j directions */
+  Vec             xl;         /* Local work vector */
+} DMDAStencilCtx;
+
+#undef __FUNCT__
+#define __FUNCT__ "DMDAStencilApplyBox_Static"
+/*
+  Add the stencil applied to x to the owned output points in the box [b,e) of y. x holds the box of points starting at
+  xo[] with xd[] points in each direction, which is either the owned or the ghosted region. The box is swept in tiles
+  of i and j, each tile through all k, so that the neighboring planes of a tile stay in cache. Rows of the box are clipped
+  to the physical boundary in non-periodic directions, so that the inner loops over i have no tests.
+*/
+static PetscErrorCode DMDAStencilApplyBox_Static(DMDAStencilCtx *ctx, const PetscInt b[], const PetscInt e[], const PetscScalar *x, const PetscInt xo[], const PetscInt xd[], PetscScalar *y, const PetscScalar *c)
+{
+  const PetscInt dof = ctx->dof, n = ctx->n, *xs = ctx->xs, *xm = ctx->xm;
+  PetscInt       ib, jb, ie, je, i, j, k, s, i0, i1;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (b[0] >= e[0] || b[1] >= e[1] || b[2] >= e[2]) PetscFunctionReturn(0);
+  for (jb = b[1]; jb < e[1]; jb += ctx->tile[1]) {
+    je = PetscMin(jb + ctx->tile[1], e[1]);
+    for (ib = b[0]; ib < e[0]; ib += ctx->tile[0]) {
+      ie = PetscMin(ib + ctx->tile[0], e[0]);
+      for (k = b[2]; k < e[2]; ++k) {
+        for (j = jb; j < je; ++j) {
+          for (s = 0; s < n; ++s) {
+            const PetscInt                    oi = ctx->off[s*3+0], oj = ctx->off[s*3+1], ok = ctx->off[s*3+2];
+            const PetscScalar                 w  = ctx->v[s];
+            const PetscScalar *PETSC_RESTRICT xr, *PETSC_RESTRICT cr;
+            PetscScalar       *PETSC_RESTRICT yr;
+
+            if (!ctx->periodic[1] && (j+oj < 0 || j+oj >= ctx->M[1])) continue;
+            if (!ctx->periodic[2] && (k+ok < 0 || k+ok >= ctx->M[2])) continue;
+            i0 = ib; i1 = ie;
+            if (!ctx->periodic[0]) {i0 = PetscMax(i0, -oi); i1 = PetscMin(i1, ctx->M[0]-oi);}
+            if (i0 >= i1) continue;
+            /* Rows are shifted so that they are indexed by the output i */
+            xr = x + (((k+ok-xo[2])*xd[1] + (j+oj-xo[1]))*xd[0] + (i0+oi-xo[0]))*dof + ctx->colc[s];
+            yr = y + (((k-xs[2])*xm[1] + (j-xs[1]))*xm[0] + (i0-xs[0]))*dof + ctx->rowc[s];
+            i1 -= i0;
+            if (c) {
+              cr = c + (((k-xs[2])*xm[1] + (j-xs[1]))*xm[0] + (i0-xs[0]))*n + s;
+              if (dof == 1) for (i = 0; i < i1; ++i) yr[i] += w*cr[i*n]*xr[i];
+              else          for (i = 0; i < i1; ++i) yr[i*dof] += w*cr[i*n]*xr[i*dof];
+            } else {
+              if (dof == 1) for (i = 0; i < i1; ++i) yr[i] += w*xr[i];
+              else          for (i = 0; i < i1; ++i) yr[i*dof] += w*xr[i*dof];
+            }
+          }
+        }
+      }
+    }
+  }
+  ierr = PetscLogFlops((c ? 3.0 : 2.0)*n*(e[0]-b[0])*(e[1]-b[1])*(e[2]-b[2]));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMDAStencilApply_Static"
+/* Add the stencil applied to X to Y, computing the interior while the ghost values are communicated */
+static PetscErrorCode DMDAStencilApply_Static(DMDAStencilCtx *ctx, Vec X, Vec Y)
+{
+  const PetscInt    *os = ctx->xs, *is = ctx->is, *ie = ctx->ie;
+  PetscInt           oe[3], b[3], e[3], d;
+  const PetscScalar *x, *xl, *c = NULL;
+  PetscScalar       *y;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscLogEventBegin(DMDA_StencilMult,ctx->da,X,Y,0);CHKERRQ(ierr);
+  for (d = 0; d < 3; ++d) oe[d] = os[d] + ctx->xm[d];
+  if (ctx->ghosts) {ierr = DMGlobalToLocalBegin(ctx->da,X,INSERT_VALUES,ctx->xl);CHKERRQ(ierr);}
+  ierr = VecGetArrayRead(X,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(Y,&y);CHKERRQ(ierr);
+  if (ctx->coef) {ierr = VecGetArrayRead(ctx->coef,&c);CHKERRQ(ierr);}
+  ierr = DMDAStencilApplyBox_Static(ctx,is,ie,x,os,ctx->xm,y,c);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(X,&x);CHKERRQ(ierr);
+  if (ctx->ghosts) {
+    ierr = DMGlobalToLocalEnd(ctx->da,X,INSERT_VALUES,ctx->xl);CHKERRQ(ierr);
+    ierr = VecGetArrayRead(ctx->xl,&xl);CHKERRQ(ierr);
+    /* The owned points outside the interior: the slabs below and above it in k, then in j, then in i */
+    b[0] = os[0]; e[0] = oe[0]; b[1] = os[1]; e[1] = oe[1]; b[2] = os[2]; e[2] = is[2];
+    ierr = DMDAStencilApplyBox_Static(ctx,b,e,xl,ctx->gxs,ctx->gxm,y,c);CHKERRQ(ierr);
+    b[2] = ie[2]; e[2] = oe[2];
+    ierr = DMDAStencilApplyBox_Static(ctx,b,e,xl,ctx->gxs,ctx->gxm,y,c);CHKERRQ(ierr);
+    b[2] = is[2]; e[2] = ie[2]; b[1] = os[1]; e[1] = is[1];
+    ierr = DMDAStencilApplyBox_Static(ctx,b,e,xl,ctx->gxs,ctx->gxm,y,c);CHKERRQ(ierr);
+    b[1] = ie[1]; e[1] = oe[1];
+    ierr = DMDAStencilApplyBox_Static(ctx,b,e,xl,ctx->gxs,ctx->gxm,y,c);CHKERRQ(ierr);
+    b[1] = is[1]; e[1] = ie[1]; b[0] = os[0]; e[0] = is[0];
+    ierr = DMDAStencilApplyBox_Static(ctx,b,e,xl,ctx->gxs,ctx->gxm,y,c);CHKERRQ(ierr);
+    b[0] = ie[0]; e[0] = oe[0];
+    ierr = DMDAStencilApplyBox_Static(ctx,b,e,xl,ctx->gxs,ctx->gxm,y,c);CHKERRQ(ierr);
+    ierr = VecRestoreArrayRead(ctx->xl,&xl);CHKERRQ(ierr);
+  }
+  if (ctx->coef) {ierr = VecRestoreArrayRead(ctx->coef,&c);CHKERRQ(ierr);}
+  ierr = VecRestoreArray(Y,&y);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(DMDA_StencilMult,ctx->da,X,Y,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatMult_DMDAStencil"
+static PetscErrorCode MatMult_DMDAStencil(Mat A, Vec X, Vec Y)
+{
+  DMDAStencilCtx *ctx;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(A,&ctx);CHKERRQ(ierr);
+  ierr = VecZeroEntries(Y);CHKERRQ(ierr);
+  ierr = DMDAStencilApply_Static(ctx,X,Y);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatMultAdd_DMDAStencil"
+static PetscErrorCode MatMultAdd_DMDAStencil(Mat A, Vec X, Vec Y, Vec Z)
+{
+  DMDAStencilCtx *ctx;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(A,&ctx);CHKERRQ(ierr);
+  if (Y != Z) {ierr = VecCopy(Y,Z);CHKERRQ(ierr);}
+  ierr = DMDAStencilApply_Static(ctx,X,Z);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatGetDiagonal_DMDAStencil"
+static PetscErrorCode MatGetDiagonal_DMDAStencil(Mat A, Vec D)
+{
+  DMDAStencilCtx    *ctx;
+  const PetscScalar *c = NULL;
+  PetscScalar       *d;
+  PetscInt           npoints, p, s;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(A,&ctx);CHKERRQ(ierr);
+  ierr = VecZeroEntries(D);CHKERRQ(ierr);
+  ierr = VecGetArray(D,&d);CHKERRQ(ierr);
+  if (ctx->coef) {ierr = VecGetArrayRead(ctx->coef,&c);CHKERRQ(ierr);}
+  npoints = ctx->xm[0]*ctx->xm[1]*ctx->xm[2];
+  for (s = 0; s < ctx->n; ++s) {
+    if (ctx->off[s*3+0] || ctx->off[s*3+1] || ctx->off[s*3+2] || ctx->rowc[s] != ctx->colc[s]) continue;
+    if (c) for (p = 0; p < npoints; ++p) d[p*ctx->dof+ctx->rowc[s]] += ctx->v[s]*c[p*ctx->n+s];
+    else   for (p = 0; p < npoints; ++p) d[p*ctx->dof+ctx->rowc[s]] += ctx->v[s];
+  }
+  if (ctx->coef) {ierr = VecRestoreArrayRead(ctx->coef,&c);CHKERRQ(ierr);}
+  ierr = VecRestoreArray(D,&d);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatDestroy_DMDAStencil"
+static PetscErrorCode MatDestroy_DMDAStencil(Mat A)
+{
+  DMDAStencilCtx *ctx;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(A,&ctx);CHKERRQ(ierr);
+  ierr = PetscFree4(ctx->rowc,ctx->colc,ctx->off,ctx->v);CHKERRQ(ierr);
+  ierr = VecDestroy(&ctx->coef);CHKERRQ(ierr);
+  ierr = VecDestroy(&ctx->xl);CHKERRQ(ierr);
+  ierr = DMDestroy(&ctx->da);CHKERRQ(ierr);
+  ierr = PetscFree(ctx);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"DMDAStencilOperatorSetCoefficients_C",NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMDAStencilOperatorSetCoefficients_DMDAStencil"
+static PetscErrorCode DMDAStencilOperatorSetCoefficients_DMDAStencil(Mat A, Vec coef)
+{
+  DMDAStencilCtx *ctx;
+  PetscInt       nloc;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(A,&ctx);CHKERRQ(ierr);
+  if (coef) {
+    ierr = VecGetLocalSize(coef,&nloc);CHKERRQ(ierr);
+    if (nloc != ctx->n*ctx->xm[0]*ctx->xm[1]*ctx->xm[2]) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_SIZ,"Coefficient vector has local size %D, but %D are needed, one per stencil entry and owned grid point",nloc,ctx->n*ctx->xm[0]*ctx->xm[1]*ctx->xm[2]);
+    ierr = PetscObjectReference((PetscObject)coef);CHKERRQ(ierr);
+  }
+  ierr = VecDestroy(&ctx->coef);CHKERRQ(ierr);
+  ctx->coef = coef;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMDAStencilOperatorSetCoefficients"
+/*@
+   DMDAStencilOperatorSetCoefficients - Makes the weights of a stencil operator vary over the grid
+
+   Logically Collective on Mat
+
+   Input Parameters:
++  A    - the operator from DMDACreateStencilOperator()
+-  coef - the coefficients, or NULL to use the constant weights again
+
+   Level: intermediate
+
+   Notes:
+   coef holds, for each owned grid point in the usual DMDA order, one value per stencil entry, which multiplies the weight
+   of that entry for the output point. The global vector of DMDAGetReducedDMDA(da,n,&cda), with n the number of
+   stencil entries, has this layout, so the coefficients can be set with DMDAVecGetArrayDOF(). The operator keeps a
+   reference to coef and reads it at each MatMult(), so later changes to its values are seen.
+
+.keywords: distributed array, stencil, matrix-free
+
+.seealso: DMDACreateStencilOperator(), DMDAGetReducedDMDA()
+@*/
+PetscErrorCode DMDAStencilOperatorSetCoefficients(Mat A,Vec coef)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(A,MAT_CLASSID,1);
+  if (coef) PetscValidHeaderSpecific(coef,VEC_CLASSID,2);
+  ierr = PetscUseMethod(A,"DMDAStencilOperatorSetCoefficients_C",(Mat,Vec),(A,coef));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMDACreateStencilOperator"
+/*@
+   DMDACreateStencilOperator - Creates a matrix-free operator which applies a stencil on a DMDA
+
+   Collective on DMDA
+
+   Input Parameters:
++  da   - the distributed array
+.  n    - the number of stencil entries
+.  rowc - the component of the output point each entry adds to, or NULL to use col[].c
+.  col  - the offsets col[].i, col[].j, col[].k of the input point of each entry from the output point, and its component col[].c
+-  v    - the weight of each entry
+
+   Output Parameter:
+.  A - the operator, a MATSHELL supporting MatMult(), MatMultAdd() and MatGetDiagonal()
+
+   Options Database Key:
+.  -da_stencil_tile <ti,tj> - the number of grid points in the i and j directions of a cache block
+
+   Level: intermediate
+
+   Notes:
+   Entry e adds v[e] times component col[e].c at grid point (i+col[e].i,j+col[e].j,k+col[e].k) to component rowc[e] at
+   grid point (i,j,k), as MatSetValuesStencil() would on a matrix from DMCreateMatrix(). Entries whose input point is
+   outside the domain in a non-periodic direction are dropped, which gives homogeneous Dirichlet conditions. The
+   offsets must not exceed the stencil width of the DMDA, and entries offset in more than one direction need a
+   DMDA_STENCIL_BOX DMDA.
+
+   The operator is applied with contiguous loops over i for each row of grid points and each entry, in blocks of
+   grid points that are swept through k so that neighboring planes stay in cache. The points whose stencil stays
+   in the owned region are computed while the ghost values are communicated.
+
+   Use DMDAStencilOperatorSetCoefficients() for variable coefficients. The diagonal from MatGetDiagonal() allows Jacobi
+   and Chebyshev smoothing without assembling a matrix.
+
+.keywords: distributed array, stencil, matrix-free
+
+.seealso: DMDAStencilOperatorSetCoefficients(), DMCreateMatrix(), MatSetValuesStencil(), MatCreateShell()
+@*/
+PetscErrorCode DMDACreateStencilOperator(DM da,PetscInt n,const PetscInt rowc[],const MatStencil col[],const PetscScalar v[],Mat *A)
+{
+  DMDAStencilCtx  *ctx;
+  DMBoundaryType  bt[3];
+  DMDAStencilType st;
+  PetscInt        dim, sw, e, d, lo, hi, m, N, nmax = 2;
+  PetscBool       ghosts = PETSC_FALSE;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(da,DM_CLASSID,1);
+  if (n) {
+    PetscValidPointer(col,4);
+    PetscValidScalarPointer(v,5);
+  }
+  PetscValidPointer(A,6);
+  ierr = PetscNew(&ctx);CHKERRQ(ierr);
+  ierr = DMDAGetInfo(da,&dim,&ctx->M[0],&ctx->M[1],&ctx->M[2],NULL,NULL,NULL,&ctx->dof,&sw,&bt[0],&bt[1],&bt[2],&st);CHKERRQ(ierr);
+  ierr = DMDAGetCorners(da,&ctx->xs[0],&ctx->xs[1],&ctx->xs[2],&ctx->xm[0],&ctx->xm[1],&ctx->xm[2]);CHKERRQ(ierr);
+  ierr = DMDAGetGhostCorners(da,&ctx->gxs[0],&ctx->gxs[1],&ctx->gxs[2],&ctx->gxm[0],&ctx->gxm[1],&ctx->gxm[2]);CHKERRQ(ierr);
+  ctx->n = n;
+  ierr = PetscMalloc4(n,&ctx->rowc,n,&ctx->colc,3*n,&ctx->off,n,&ctx->v);CHKERRQ(ierr);
+  for (e = 0; e < n; ++e) {
+    PetscInt nz = 0;
+
+    ctx->colc[e]     = col[e].c;
+    ctx->rowc[e]     = rowc ? rowc[e] : col[e].c;
+    ctx->off[e*3+0]  = col[e].i;
+    ctx->off[e*3+1]  = col[e].j;
+    ctx->off[e*3+2]  = col[e].k;
+    ctx->v[e]        = v[e];
+    if (ctx->rowc[e] < 0 || ctx->rowc[e] >= ctx->dof || ctx->colc[e] < 0 || ctx->colc[e] >= ctx->dof) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Stencil entry %D couples components %D and %D, which are not in the DMDA",e,ctx->rowc[e],ctx->colc[e]);
+    for (d = 0; d < 3; ++d) {
+      if (d >= dim && ctx->off[e*3+d]) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Stencil entry %D has an offset in direction %D, which the DMDA does not have",e,d);
+      if (PetscAbsInt(ctx->off[e*3+d]) > sw) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Stencil entry %D has offset %D, larger than the stencil width %D",e,ctx->off[e*3+d],sw);
+      if (ctx->off[e*3+d]) ++nz;
+    }
+    if (nz > 1 && st == DMDA_STENCIL_STAR) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONG,"Stencil entry %D is offset in several directions, which needs a DMDA_STENCIL_BOX DMDA",e);
+  }
+  /* The interior points only need owned input values, since their stencil stays in the owned region, or is clipped by the physical boundary */
+  for (d = 0; d < 3; ++d) {
+    ctx->periodic[d] = bt[d] == DM_BOUNDARY_PERIODIC ? PETSC_TRUE : PETSC_FALSE;
+    for (e = 0, lo = 0, hi = 0; e < n; ++e) {
+      lo = PetscMax(lo,-ctx->off[e*3+d]);
+      hi = PetscMax(hi, ctx->off[e*3+d]);
+    }
+    ctx->is[d] = ctx->xs[d] + ((ctx->periodic[d] || ctx->xs[d] > 0) ? lo : 0);
+    ctx->ie[d] = ctx->xs[d] + ctx->xm[d] - ((ctx->periodic[d] || ctx->xs[d]+ctx->xm[d] < ctx->M[d]) ? hi : 0);
+    if (ctx->is[d] != ctx->xs[d] || ctx->ie[d] != ctx->xs[d]+ctx->xm[d]) ghosts = PETSC_TRUE;
+  }
+  for (d = 0; d < 3; ++d) if (ctx->ie[d] <= ctx->is[d]) break;
+  if (d < 3) for (d = 0; d < 3; ++d) ctx->is[d] = ctx->ie[d] = ctx->xs[d];
+  ierr = MPI_Allreduce(&ghosts,&ctx->ghosts,1,MPIU_BOOL,MPI_LOR,PetscObjectComm((PetscObject)da));CHKERRQ(ierr);
+  if (ctx->ghosts) {ierr = DMCreateLocalVector(da,&ctx->xl);CHKERRQ(ierr);}
+  ctx->tile[0] = 512;
+  ctx->tile[1] = 8;
+  ierr = PetscOptionsGetIntArray(((PetscObject)da)->prefix,"-da_stencil_tile",ctx->tile,&nmax,NULL);CHKERRQ(ierr);
+  if (ctx->tile[0] < 1 || ctx->tile[1] < 1) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Stencil tile %D by %D must be positive",ctx->tile[0],ctx->tile[1]);
+  ierr = PetscObjectReference((PetscObject)da);CHKERRQ(ierr);
+  ctx->da = da;
+
+  m = ctx->dof*ctx->xm[0]*ctx->xm[1]*ctx->xm[2];
+  N = ctx->dof*ctx->M[0]*ctx->M[1]*ctx->M[2];
+  ierr = MatCreateShell(PetscObjectComm((PetscObject)da),m,m,N,N,ctx,A);CHKERRQ(ierr);
+  ierr = MatShellSetOperation(*A,MATOP_MULT,        (void (*)(void))MatMult_DMDAStencil);CHKERRQ(ierr);
+  ierr = MatShellSetOperation(*A,MATOP_MULT_ADD,    (void (*)(void))MatMultAdd_DMDAStencil);CHKERRQ(ierr);
+  ierr = MatShellSetOperation(*A,MATOP_GET_DIAGONAL,(void (*)(void))MatGetDiagonal_DMDAStencil);CHKERRQ(ierr);
+  ierr = MatShellSetOperation(*A,MATOP_DESTROY,     (void (*)(void))MatDestroy_DMDAStencil);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)*A,"DMDAStencilOperatorSetCoefficients_C",DMDAStencilOperatorSetCoefficients_DMDAStencil);CHKERRQ(ierr);
+  ierr = MatSetDM(*A,da);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
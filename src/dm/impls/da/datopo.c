@@ -0,0 +1,189 @@
+#include <petsc/private/dmdaimpl.h>    /*I   "petscdmda.h"   I*/
+
+#undef __FUNCT__
+#define __FUNCT__ "DMDASetTopologyAware"
+/*@
+   DMDASetTopologyAware - Places neighboring subdomains of the DMDA on processes that share a compute node, and within a
+   node a socket, so that most ghost point communication stays in shared memory
+
+   Logically Collective on DMDA
+
+   Input Parameters:
++  da  - the distributed array
+-  flg - PETSC_TRUE to map subdomains to processes using the machine topology
+
+   Options Database Key:
+.  -da_topology_aware - map subdomains to processes using the machine topology
+
+   Level: intermediate
+
+   Notes:
+   By default subdomain (i,j,k) of the m by n by p process grid belongs to rank i + m*(j + n*k), so a node holding
+   consecutive ranks owns a thin slab of the domain. With this option the process grid is cut into one brick of
+   subdomains per node, with the smallest cut surface, and each brick is again cut into one brick per socket. Nodes and
+   sockets are found with PetscCommGetNodeLayout(). If the nodes do not all hold the same number of processes, or that
+   number does not factor into the process grid, the default placement is kept.
+
+   The placement only changes which rank owns each subdomain. DMDAGetCorners(), DMDAGetNeighbors() and the global
+   numbering, which is still contiguous on each rank, account for it. Refined, coarsened and coordinate DMDAs inherit
+   the flag, and so the placement. One dimensional DMDAs are not affected.
+
+   This must be called before DMSetUp().
+
+.keywords:  distributed array, topology, node, socket
+
+.seealso: DMDAGetTopologyAware(), DMDASetNumProcs(), PetscCommGetNodeLayout(), PetscPartitionerSetTopologyAware()
+@*/
+PetscErrorCode  DMDASetTopologyAware(DM da,PetscBool flg)
+{
+  DM_DA *dd = (DM_DA*)da->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(da,DM_CLASSID,1);
+  PetscValidLogicalCollectiveBool(da,flg,2);
+  if (da->setupcalled) SETERRQ(PetscObjectComm((PetscObject)da),PETSC_ERR_ARG_WRONGSTATE,"This function must be called before DMSetUp()");
+  dd->topologyaware = flg;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMDAGetTopologyAware"
+/*@
+   DMDAGetTopologyAware - Tells whether subdomains of the DMDA are mapped to processes using the machine topology
+
+   Not Collective
+
+   Input Parameter:
+.  da - the distributed array
+
+   Output Parameter:
+.  flg - PETSC_TRUE if the subdomains are mapped using the machine topology
+
+   Level: intermediate
+
+.keywords:  distributed array, topology, node, socket
+
+.seealso: DMDASetTopologyAware()
+@*/
+PetscErrorCode  DMDAGetTopologyAware(DM da,PetscBool *flg)
+{
+  DM_DA *dd = (DM_DA*)da->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(da,DM_CLASSID,1);
+  PetscValidPointer(flg,2);
+  *flg = dd->topologyaware;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMDAFindBrick_Static"
+/*
+   Find the brick of a by b by c subdomains, with abc = count and a|dims[0], b|dims[1], c|dims[2], whose faces interior
+   to the process grid have the smallest area. ext[] is the size of a subdomain in each direction.
+*/
+static PetscErrorCode DMDAFindBrick_Static(const PetscInt dims[],const PetscReal ext[],PetscInt count,PetscInt brick[],PetscBool *found)
+{
+  PetscReal best = PETSC_MAX_REAL,cost;
+  PetscInt  a,b,c;
+
+  PetscFunctionBegin;
+  *found = PETSC_FALSE;
+  for (a=1; a<=dims[0]; a++) {
+    if (dims[0] % a || count % a) continue;
+    for (b=1; b<=dims[1]; b++) {
+      if (dims[1] % b || (count/a) % b) continue;
+      c = count/(a*b);
+      if (dims[2] % c) continue;
+      cost = 0.0;
+      if (a < dims[0]) cost += b*ext[1]*c*ext[2];
+      if (b < dims[1]) cost += a*ext[0]*c*ext[2];
+      if (c < dims[2]) cost += a*ext[0]*b*ext[1];
+      if (cost < best) {
+        best     = cost;
+        brick[0] = a; brick[1] = b; brick[2] = c;
+        *found   = PETSC_TRUE;
+      }
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMDASetUpRankMap_Private"
+/*
+   DMDASetUpRankMap_Private - Decides which rank owns each subdomain of the m by n by p process grid, storing it in
+   dd->rankmap unless it is the default lexicographic placement
+
+   Output Parameter:
+.  pos - the lexicographic index of the subdomain owned by this process
+
+   The placement depends only on the process grid and the machine layout, so every DMDA with the same process grid on
+   the same communicator gets the same placement, as interpolation between them requires.
+*/
+PetscErrorCode DMDASetUpRankMap_Private(DM da,PetscInt m,PetscInt n,PetscInt p,PetscMPIInt *pos)
+{
+  DM_DA          *dd = (DM_DA*)da->data;
+  MPI_Comm       comm;
+  PetscMPIInt    size,rank,numNodes,numSockets,*nodeOffsets,*socketOffsets,*ranks,g;
+  PetscInt       dims[3],node[3],sock[3],nodeSize,socketSize,i,j,k,q,nb,sb,l;
+  PetscReal      ext[3];
+  PetscBool      found,identity = PETSC_TRUE;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)da,&comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
+  ierr = PetscFree(dd->rankmap);CHKERRQ(ierr);
+  *pos = rank;
+  if (!dd->topologyaware || size == 1) PetscFunctionReturn(0);
+  ierr = PetscCommGetNodeLayout(comm,&numNodes,&nodeOffsets,&numSockets,&socketOffsets,&ranks);CHKERRQ(ierr);
+  dims[0] = m; dims[1] = n; dims[2] = p;
+  ext[0]  = ((PetscReal)dd->M)/m; ext[1] = ((PetscReal)dd->N)/n; ext[2] = ((PetscReal)dd->P)/p;
+  nodeSize = nodeOffsets[1];
+  for (g=0; g<numNodes; g++) if (nodeOffsets[g+1]-nodeOffsets[g] != nodeSize) break;
+  if (g < numNodes) {
+    ierr = PetscInfo(da,"Nodes hold different numbers of processes, keeping the default placement\n");CHKERRQ(ierr);
+    goto cleanup;
+  }
+  ierr = DMDAFindBrick_Static(dims,ext,nodeSize,node,&found);CHKERRQ(ierr);
+  if (!found) {
+    ierr = PetscInfo4(da,"Cannot cut the %D by %D by %D process grid into nodes of %D processes, keeping the default placement\n",m,n,p,nodeSize);CHKERRQ(ierr);
+    goto cleanup;
+  }
+  /* Sockets are a refinement of the node brick, and are ignored unless they all have the same size */
+  socketSize = socketOffsets[1];
+  for (g=0; g<numSockets; g++) if (socketOffsets[g+1]-socketOffsets[g] != socketSize) break;
+  found = PETSC_FALSE;
+  if (g == numSockets && socketSize < nodeSize) {ierr = DMDAFindBrick_Static(node,ext,socketSize,sock,&found);CHKERRQ(ierr);}
+  if (!found) {
+    socketSize = nodeSize;
+    sock[0] = node[0]; sock[1] = node[1]; sock[2] = node[2];
+  }
+  ierr = PetscInfo6(da,"Placing bricks of %D by %D by %D subdomains on each node, and %D by %D by %D on each socket\n",node[0],node[1],node[2],sock[0],sock[1],sock[2]);CHKERRQ(ierr);
+
+  ierr = PetscMalloc1(m*n*p,&dd->rankmap);CHKERRQ(ierr);
+  for (k=0; k<p; k++) {
+    for (j=0; j<n; j++) {
+      for (i=0; i<m; i++) {
+        const PetscInt ii = i % node[0],jj = j % node[1],kk = k % node[2];
+
+        q  = (k*n + j)*m + i;
+        nb = ((k/node[2])*(n/node[1]) + j/node[1])*(m/node[0]) + i/node[0];
+        sb = ((kk/sock[2])*(node[1]/sock[1]) + jj/sock[1])*(node[0]/sock[0]) + ii/sock[0];
+        l  = ((kk % sock[2])*sock[1] + jj % sock[1])*sock[0] + ii % sock[0];
+        dd->rankmap[q] = ranks[nb*nodeSize + sb*socketSize + l];
+        if (dd->rankmap[q] == rank) *pos = (PetscMPIInt) q;
+        if (dd->rankmap[q] != q) identity = PETSC_FALSE;
+      }
+    }
+  }
+  if (identity) {ierr = PetscFree(dd->rankmap);CHKERRQ(ierr);}
+
+cleanup:
+  ierr = PetscFree(nodeOffsets);CHKERRQ(ierr);
+  ierr = PetscFree(socketOffsets);CHKERRQ(ierr);
+  ierr = PetscFree(ranks);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
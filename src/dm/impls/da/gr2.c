@@ -453,7 +453,8 @@ PetscErrorCode VecView_MPI_HDF5_DA(Vec xin,PetscViewer viewer)
 
   PetscFunctionBegin;
   ierr = PetscViewerHDF5OpenGroup(viewer, &file_id, &group);CHKERRQ(ierr);
-  ierr = PetscViewerHDF5GetTimestep(viewer, &timestep);CHKERRQ(ierr);
+  ierr = PetscObjectGetName((PetscObject)xin,&vecname);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5GetWriteTimestep(viewer, group, vecname, &timestep);CHKERRQ(ierr);
   ierr = PetscViewerHDF5GetBaseDimension2(viewer,&dim2);CHKERRQ(ierr);
   ierr = PetscViewerHDF5GetSPOutput(viewer,&spoutput);CHKERRQ(ierr);
 
@@ -524,25 +525,38 @@ PetscErrorCode VecView_MPI_HDF5_DA(Vec xin,PetscViewer viewer)
   else filescalartype = H5T_NATIVE_DOUBLE;
 #endif
 
+  /* The sizes of the local part also determine the chunks with -viewer_hdf5_chunk_partition */
+  dim = 0;
+  if (timestep >= 0) {
+    count[dim] = 1;
+    ++dim;
+  }
+  if (dimension == 3) {ierr = PetscHDF5IntCast(da->ze - da->zs,count + dim++);CHKERRQ(ierr);}
+  if (dimension > 1)  {ierr = PetscHDF5IntCast(da->ye - da->ys,count + dim++);CHKERRQ(ierr);}
+  ierr = PetscHDF5IntCast((da->xe - da->xs)/da->w,count + dim++);CHKERRQ(ierr);
+  if (da->w > 1 || dim2) {ierr = PetscHDF5IntCast(da->w,count + dim++);CHKERRQ(ierr);}
+#if defined(PETSC_USE_COMPLEX)
+  count[dim++] = 2;
+#endif
+
   /* Create the dataset with default properties and close filespace */
-  ierr = PetscObjectGetName((PetscObject)xin,&vecname);CHKERRQ(ierr);
   if (!H5Lexists(group, vecname, H5P_DEFAULT)) {
     /* Create chunk */
-    PetscStackCallHDF5Return(chunkspace,H5Pcreate,(H5P_DATASET_CREATE));
-    PetscStackCallHDF5(H5Pset_chunk,(chunkspace, dim, chunkDims));
+    ierr = PetscViewerHDF5CreateDatasetProperties(viewer, dim, count, chunkDims, &chunkspace);CHKERRQ(ierr);
 
 #if (H5_VERS_MAJOR * 10000 + H5_VERS_MINOR * 100 + H5_VERS_RELEASE >= 10800)
     PetscStackCallHDF5Return(dset_id,H5Dcreate2,(group, vecname, filescalartype, filespace, H5P_DEFAULT, chunkspace, H5P_DEFAULT));
 #else
     PetscStackCallHDF5Return(dset_id,H5Dcreate,(group, vecname, filescalartype, filespace, H5P_DEFAULT));
 #endif
+    PetscStackCallHDF5(H5Pclose,(chunkspace));
   } else {
     PetscStackCallHDF5Return(dset_id,H5Dopen2,(group, vecname, H5P_DEFAULT));
     PetscStackCallHDF5(H5Dset_extent,(dset_id, dims));
   }
   PetscStackCallHDF5(H5Sclose,(filespace));
 
-  /* Each process defines a dataset and writes it to the hyperslab in the file */
+  /* Each process writes its part to the hyperslab in the file */
   dim = 0;
   if (timestep >= 0) {
     offset[dim] = timestep;
@@ -554,18 +568,6 @@ PetscErrorCode VecView_MPI_HDF5_DA(Vec xin,PetscViewer viewer)
   if (da->w > 1 || dim2) offset[dim++] = 0;
 #if defined(PETSC_USE_COMPLEX)
   offset[dim++] = 0;
-#endif
-  dim = 0;
-  if (timestep >= 0) {
-    count[dim] = 1;
-    ++dim;
-  }
-  if (dimension == 3) {ierr = PetscHDF5IntCast(da->ze - da->zs,count + dim++);CHKERRQ(ierr);}
-  if (dimension > 1)  {ierr = PetscHDF5IntCast(da->ye - da->ys,count + dim++);CHKERRQ(ierr);}
-  ierr = PetscHDF5IntCast((da->xe - da->xs)/da->w,count + dim++);CHKERRQ(ierr);
-  if (da->w > 1 || dim2) {ierr = PetscHDF5IntCast(da->w,count + dim++);CHKERRQ(ierr);}
-#if defined(PETSC_USE_COMPLEX)
-  count[dim++] = 2;
 #endif
   PetscStackCallHDF5Return(memspace,H5Screate_simple,(dim, count, NULL));
   PetscStackCallHDF5Return(filespace,H5Dget_space,(dset_id));
@@ -1,6 +1,7 @@
 static char help[] = "Run C version of TetGen to construct and refine a mesh\n\n";
 
 #include <petscdmplex.h>
+#include <petscsf.h>
 
 typedef struct {
   DM            dm;                /* REQUIRED in order to use SNES evaluation functions */
@@ -9,11 +10,16 @@ typedef struct {
   /* Domain and mesh definition */
   PetscInt      dim;                          /* The topological mesh dimension */
   PetscBool     interpolate;                  /* Generate intermediate mesh elements */
+  PetscBool     interpolateDistributed;       /* Generate intermediate mesh elements after distribution */
   PetscReal     refinementLimit;              /* The largest allowable cell volume */
   PetscBool     cellSimplex;                  /* Use simplices or hexes */
   char          filename[PETSC_MAX_PATH_LEN]; /* Import mesh from file */
   PetscBool     testPartition;                /* Use a fixed partitioning for testing */
   PetscInt      overlap;                      /* The cell overlap to use during partitioning */
+  PetscInt      adaptRefine;                  /* The number of local refinements around the origin */
+  PetscBool     adaptCoarsen;                 /* Coarsen the last local refinement back */
+  PetscBool     rebalance;                    /* Incrementally rebalance the mesh along with a cell field */
+  PetscInt      partitionWeight;              /* The partitioner weight of cells near the origin */
 } AppCtx;
 
 #undef __FUNCT__
@@ -26,27 +32,269 @@ PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
   options->debug             = 0;
   options->dim               = 2;
   options->interpolate       = PETSC_FALSE;
+  options->interpolateDistributed = PETSC_FALSE;
   options->refinementLimit   = 0.0;
   options->cellSimplex       = PETSC_TRUE;
   options->filename[0]       = '\0';
   options->testPartition     = PETSC_FALSE;
   options->overlap           = PETSC_FALSE;
+  options->adaptRefine       = 0;
+  options->adaptCoarsen      = PETSC_FALSE;
+  options->rebalance         = PETSC_FALSE;
+  options->partitionWeight   = 1;
 
   ierr = PetscOptionsBegin(comm, "", "Meshing Problem Options", "DMPLEX");CHKERRQ(ierr);
   ierr = PetscOptionsInt("-debug", "The debugging level", "ex1.c", options->debug, &options->debug, NULL);CHKERRQ(ierr);
   ierr = PetscOptionsInt("-dim", "The topological mesh dimension", "ex1.c", options->dim, &options->dim, NULL);CHKERRQ(ierr);
   ierr = PetscOptionsBool("-interpolate", "Generate intermediate mesh elements", "ex1.c", options->interpolate, &options->interpolate, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-interpolate_distributed", "Generate intermediate mesh elements after distributing the mesh", "ex1.c", options->interpolateDistributed, &options->interpolateDistributed, NULL);CHKERRQ(ierr);
   ierr = PetscOptionsReal("-refinement_limit", "The largest allowable cell volume", "ex1.c", options->refinementLimit, &options->refinementLimit, NULL);CHKERRQ(ierr);
   ierr = PetscOptionsBool("-cell_simplex", "Use simplices if true, otherwise hexes", "ex1.c", options->cellSimplex, &options->cellSimplex, NULL);CHKERRQ(ierr);
   ierr = PetscOptionsString("-filename", "The mesh file", "ex1.c", options->filename, options->filename, PETSC_MAX_PATH_LEN, NULL);CHKERRQ(ierr);
   ierr = PetscOptionsBool("-test_partition", "Use a fixed partition for testing", "ex1.c", options->testPartition, &options->testPartition, NULL);CHKERRQ(ierr);
   ierr = PetscOptionsInt("-overlap", "The cell overlap for partitioning", "ex1.c", options->overlap, &options->overlap, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-adapt_refine", "The number of local refinements around the origin", "ex1.c", options->adaptRefine, &options->adaptRefine, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-adapt_coarsen", "Coarsen the last local refinement back", "ex1.c", options->adaptCoarsen, &options->adaptCoarsen, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-rebalance", "Incrementally rebalance the mesh along with a cell field", "ex1.c", options->rebalance, &options->rebalance, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-partition_weight", "The partitioner weight of cells within 0.5 of the origin", "ex1.c", options->partitionWeight, &options->partitionWeight, NULL);CHKERRQ(ierr);
   ierr = PetscOptionsEnd();
 
   ierr = PetscLogEventRegister("CreateMesh",          DM_CLASSID,   &options->createMeshEvent);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 };
 
+#undef __FUNCT__
+#define __FUNCT__ "CheckAdaptedMesh"
+/* Check the topology, that shared vertices have the coordinates of their owner, and report global sizes */
+PetscErrorCode CheckAdaptedMesh(DM dm, const char name[])
+{
+  MPI_Comm           comm;
+  PetscSF            sf;
+  PetscSection       coordSection;
+  Vec                coordinates;
+  const PetscScalar *coords;
+  PetscScalar       *lcoords, *rcoords;
+  const PetscInt    *leaves;
+  PetscInt           nroots, nleaves, pStart, pEnd, cStart, cEnd, vStart, vEnd, c, v, l, lsizes[2] = {0, 0}, gsizes[2];
+  PetscReal          area = 0.0, garea;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject) dm, &comm);CHKERRQ(ierr);
+  ierr = DMPlexCheckSymmetry(dm);CHKERRQ(ierr);
+  ierr = DMPlexCheckSkeleton(dm, PETSC_TRUE, 0);CHKERRQ(ierr);
+  ierr = DMPlexCheckFaces(dm, PETSC_TRUE, 0);CHKERRQ(ierr);
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetDepthStratum(dm, 0, &vStart, &vEnd);CHKERRQ(ierr);
+  ierr = DMGetPointSF(dm, &sf);CHKERRQ(ierr);
+  ierr = PetscSFGetGraph(sf, &nroots, &nleaves, &leaves, NULL);CHKERRQ(ierr);
+  if (nroots < 0) {nleaves = 0; leaves = NULL;}
+  ierr = DMGetCoordinateSection(dm, &coordSection);CHKERRQ(ierr);
+  ierr = DMGetCoordinatesLocal(dm, &coordinates);CHKERRQ(ierr);
+  ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
+  ierr = PetscCalloc2((pEnd-pStart)*2, &lcoords, (pEnd-pStart)*2, &rcoords);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(coordinates, &coords);CHKERRQ(ierr);
+  for (v = vStart; v < vEnd; ++v) {
+    PetscInt off;
+
+    ierr = PetscSectionGetOffset(coordSection, v, &off);CHKERRQ(ierr);
+    lcoords[v*2+0] = rcoords[v*2+0] = coords[off+0];
+    lcoords[v*2+1] = rcoords[v*2+1] = coords[off+1];
+  }
+  ierr = VecRestoreArrayRead(coordinates, &coords);CHKERRQ(ierr);
+  if (nroots >= 0) {
+    MPI_Datatype coordType;
+
+    ierr = MPI_Type_contiguous(2, MPIU_SCALAR, &coordType);CHKERRQ(ierr);
+    ierr = MPI_Type_commit(&coordType);CHKERRQ(ierr);
+    ierr = PetscSFBcastBegin(sf, coordType, lcoords, rcoords);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sf, coordType, lcoords, rcoords);CHKERRQ(ierr);
+    ierr = MPI_Type_free(&coordType);CHKERRQ(ierr);
+  }
+  for (v = vStart*2; v < vEnd*2; ++v) {
+    if (PetscAbsScalar(rcoords[v] - lcoords[v]) > 1.0e-10) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Shared vertex %D does not match its owner", v/2);
+  }
+  ierr = PetscFree2(lcoords, rcoords);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {
+    PetscReal vol;
+
+    ierr = PetscFindInt(c, nleaves, leaves, &l);CHKERRQ(ierr);
+    if (l >= 0) continue;
+    ierr = DMPlexComputeCellGeometryFVM(dm, c, &vol, NULL, NULL);CHKERRQ(ierr);
+    area += vol;
+    ++lsizes[0];
+  }
+  for (v = vStart; v < vEnd; ++v) {
+    ierr = PetscFindInt(v, nleaves, leaves, &l);CHKERRQ(ierr);
+    if (l < 0) ++lsizes[1];
+  }
+  ierr = MPI_Allreduce(lsizes, gsizes, 2, MPIU_INT, MPI_SUM, comm);CHKERRQ(ierr);
+  ierr = MPI_Allreduce(&area, &garea, 1, MPIU_REAL, MPIU_SUM, comm);CHKERRQ(ierr);
+  ierr = PetscPrintf(comm, "%s mesh: %D cells %D vertices area %g\n", name, gsizes[0], gsizes[1], (double) garea);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "AdaptMesh"
+/* Refine the cells within a shrinking radius of the origin, and optionally coarsen the last refinement back */
+PetscErrorCode AdaptMesh(AppCtx *user, DM *dm)
+{
+  PetscInt       r;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = CheckAdaptedMesh(*dm, "Initial");CHKERRQ(ierr);
+  for (r = 0; r < user->adaptRefine; ++r) {
+    DM        dmAdapted;
+    DMLabel   adapt;
+    PetscReal radius = 0.5/(r+1);
+    PetscInt  cStart, cEnd, c;
+
+    ierr = DMLabelCreate("adapt", &adapt);CHKERRQ(ierr);
+    ierr = DMPlexGetHeightStratum(*dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+    for (c = cStart; c < cEnd; ++c) {
+      PetscReal centroid[3];
+
+      ierr = DMPlexComputeCellGeometryFVM(*dm, c, NULL, centroid, NULL);CHKERRQ(ierr);
+      if (PetscSqrtReal(PetscSqr(centroid[0]) + PetscSqr(centroid[1])) < radius) {ierr = DMLabelSetValue(adapt, c, DMPLEX_ADAPT_REFINE);CHKERRQ(ierr);}
+    }
+    ierr = DMPlexAdaptLabel(*dm, adapt, &dmAdapted);CHKERRQ(ierr);
+    ierr = DMLabelDestroy(&adapt);CHKERRQ(ierr);
+    if (dmAdapted) {
+      ierr = DMDestroy(dm);CHKERRQ(ierr);
+      *dm  = dmAdapted;
+    }
+    ierr = CheckAdaptedMesh(*dm, "Refined");CHKERRQ(ierr);
+  }
+  if (user->adaptCoarsen) {
+    DM       dmAdapted;
+    DMLabel  adapt;
+    PetscInt cStart, cEnd, c;
+
+    ierr = DMLabelCreate("adapt", &adapt);CHKERRQ(ierr);
+    ierr = DMPlexGetHeightStratum(*dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+    for (c = cStart; c < cEnd; ++c) {ierr = DMLabelSetValue(adapt, c, DMPLEX_ADAPT_COARSEN);CHKERRQ(ierr);}
+    ierr = DMPlexAdaptLabel(*dm, adapt, &dmAdapted);CHKERRQ(ierr);
+    ierr = DMLabelDestroy(&adapt);CHKERRQ(ierr);
+    if (dmAdapted) {
+      ierr = DMDestroy(dm);CHKERRQ(ierr);
+      *dm  = dmAdapted;
+    }
+    ierr = CheckAdaptedMesh(*dm, "Coarsened");CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "CreateCentroidField"
+/* Store the first centroid coordinate of each cell in a cell field */
+PetscErrorCode CreateCentroidField(DM dm, PetscSection *section, Vec *field)
+{
+  PetscScalar   *a;
+  PetscInt       cStart, cEnd, c;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  ierr = PetscSectionCreate(PetscObjectComm((PetscObject) dm), section);CHKERRQ(ierr);
+  ierr = PetscSectionSetChart(*section, cStart, cEnd);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {ierr = PetscSectionSetDof(*section, c, 1);CHKERRQ(ierr);}
+  ierr = PetscSectionSetUp(*section);CHKERRQ(ierr);
+  ierr = VecCreateSeq(PETSC_COMM_SELF, cEnd-cStart, field);CHKERRQ(ierr);
+  ierr = VecGetArray(*field, &a);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {
+    PetscReal centroid[3];
+
+    ierr = DMPlexComputeCellGeometryFVM(dm, c, NULL, centroid, NULL);CHKERRQ(ierr);
+    a[c-cStart] = centroid[0];
+  }
+  ierr = VecRestoreArray(*field, &a);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "RebalanceMesh"
+/* Rebalance the mesh, migrating a cell field with it, and check the field against the new mesh */
+PetscErrorCode RebalanceMesh(DM *dm)
+{
+  DM             dmBalanced;
+  PetscSF        sf;
+  PetscSection   section, newSection, checkSection;
+  Vec            field, newField, checkField;
+  PetscReal      error, gerror;
+  PetscInt       numMigrated, cStart, cEnd, numCells, minCells, maxCells;
+  MPI_Comm       comm;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject) *dm, &comm);CHKERRQ(ierr);
+  ierr = CreateCentroidField(*dm, &section, &field);CHKERRQ(ierr);
+  ierr = DMPlexRebalance(*dm, &numMigrated, &sf, &dmBalanced);CHKERRQ(ierr);
+  ierr = PetscPrintf(comm, "Rebalance migrated %D cells\n", numMigrated);CHKERRQ(ierr);
+  if (dmBalanced) {
+    ierr = PetscSectionCreate(comm, &newSection);CHKERRQ(ierr);
+    ierr = VecCreate(PETSC_COMM_SELF, &newField);CHKERRQ(ierr);
+    ierr = DMPlexDistributeField(*dm, sf, section, field, newSection, newField);CHKERRQ(ierr);
+    ierr = CreateCentroidField(dmBalanced, &checkSection, &checkField);CHKERRQ(ierr);
+    ierr = VecAXPY(checkField, -1.0, newField);CHKERRQ(ierr);
+    ierr = VecNorm(checkField, NORM_INFINITY, &error);CHKERRQ(ierr);
+    ierr = MPI_Allreduce(&error, &gerror, 1, MPIU_REAL, MPIU_MAX, comm);CHKERRQ(ierr);
+    if (gerror > 1.0e-10) SETERRQ1(comm, PETSC_ERR_PLIB, "Migrated cell field has error %g", (double) gerror);
+    ierr = PetscSectionDestroy(&newSection);CHKERRQ(ierr);
+    ierr = PetscSectionDestroy(&checkSection);CHKERRQ(ierr);
+    ierr = VecDestroy(&newField);CHKERRQ(ierr);
+    ierr = VecDestroy(&checkField);CHKERRQ(ierr);
+    ierr = PetscSFDestroy(&sf);CHKERRQ(ierr);
+    ierr = DMDestroy(dm);CHKERRQ(ierr);
+    *dm  = dmBalanced;
+  }
+  ierr = PetscSectionDestroy(&section);CHKERRQ(ierr);
+  ierr = VecDestroy(&field);CHKERRQ(ierr);
+  ierr = DMPlexGetHeightStratum(*dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  numCells = cEnd - cStart;
+  ierr = MPI_Allreduce(&numCells, &minCells, 1, MPIU_INT, MPI_MIN, comm);CHKERRQ(ierr);
+  ierr = MPI_Allreduce(&numCells, &maxCells, 1, MPIU_INT, MPI_MAX, comm);CHKERRQ(ierr);
+  ierr = PetscPrintf(comm, "Local cell counts between %D and %D\n", minCells, maxCells);CHKERRQ(ierr);
+  ierr = CheckAdaptedMesh(*dm, "Rebalanced");CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "InterpolateDistributedMesh"
+/* Interpolates a distributed mesh, checks it, and prints the number of points in each stratum counted through the point SF */
+PetscErrorCode InterpolateDistributedMesh(DM *dm, PetscBool cellSimplex)
+{
+  DM             idm = NULL;
+  IS             globalPointNumbers;
+  const PetscInt *gp;
+  PetscInt       depth, d, pStart, pEnd, p, numPoints, globalNumPoints;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMPlexInterpolate(*dm, &idm);CHKERRQ(ierr);
+  ierr = DMPlexCopyCoordinates(*dm, idm);CHKERRQ(ierr);
+  ierr = DMPlexCopyLabels(*dm, idm);CHKERRQ(ierr);
+  ierr = DMDestroy(dm);CHKERRQ(ierr);
+  *dm  = idm;
+  ierr = DMPlexCheckSymmetry(*dm);CHKERRQ(ierr);
+  ierr = DMPlexCheckSkeleton(*dm, cellSimplex, 0);CHKERRQ(ierr);
+  ierr = DMPlexCheckFaces(*dm, cellSimplex, 0);CHKERRQ(ierr);
+  /* Shared points are only numbered by their owner, so the totals agree with the sequential mesh if the point SF is correct */
+  ierr = DMPlexGetDepth(*dm, &depth);CHKERRQ(ierr);
+  ierr = DMPlexCreatePointNumbering(*dm, &globalPointNumbers);CHKERRQ(ierr);
+  ierr = ISGetIndices(globalPointNumbers, &gp);CHKERRQ(ierr);
+  ierr = DMPlexGetChart(*dm, &pStart, NULL);CHKERRQ(ierr);
+  for (d = 0; d <= depth; ++d) {
+    ierr = DMPlexGetDepthStratum(*dm, d, &p, &pEnd);CHKERRQ(ierr);
+    for (numPoints = 0; p < pEnd; ++p) if (gp[p-pStart] >= 0) ++numPoints;
+    ierr = MPI_Allreduce(&numPoints, &globalNumPoints, 1, MPIU_INT, MPI_SUM, PetscObjectComm((PetscObject) *dm));CHKERRQ(ierr);
+    ierr = PetscPrintf(PetscObjectComm((PetscObject) *dm), "Number of points of depth %D: %D\n", d, globalNumPoints);CHKERRQ(ierr);
+  }
+  ierr = ISRestoreIndices(globalPointNumbers, &gp);CHKERRQ(ierr);
+  ierr = ISDestroy(&globalPointNumbers);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "CreateMesh"
 PetscErrorCode CreateMesh(MPI_Comm comm, AppCtx *user, DM *dm)
@@ -97,12 +345,31 @@ PetscErrorCode CreateMesh(MPI_Comm comm, AppCtx *user, DM *dm)
       ierr = PetscPartitionerSetType(part, PETSCPARTITIONERSHELL);CHKERRQ(ierr);
       ierr = PetscPartitionerShellSetPartition(part, numProcs, sizes, points);CHKERRQ(ierr);
     }
+    if (user->partitionWeight != 1) {
+      PetscPartitioner part;
+      PetscInt        *weights;
+      PetscInt         cStart, cEnd, c;
+
+      ierr = DMPlexGetHeightStratum(*dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+      ierr = PetscMalloc1(cEnd-cStart, &weights);CHKERRQ(ierr);
+      for (c = cStart; c < cEnd; ++c) {
+        PetscReal centroid[3];
+
+        ierr = DMPlexComputeCellGeometryFVM(*dm, c, NULL, centroid, NULL);CHKERRQ(ierr);
+        weights[c-cStart] = PetscSqrtReal(PetscSqr(centroid[0]) + PetscSqr(centroid[1])) < 0.5 ? user->partitionWeight : 1;
+      }
+      ierr = DMPlexGetPartitioner(*dm, &part);CHKERRQ(ierr);
+      ierr = PetscPartitionerSetFromOptions(part);CHKERRQ(ierr);
+      ierr = PetscPartitionerSetVertexWeights(part, 1, cEnd-cStart, weights);CHKERRQ(ierr);
+      ierr = PetscFree(weights);CHKERRQ(ierr);
+    }
     /* Distribute mesh over processes */
     ierr = DMPlexDistribute(*dm, 0, NULL, &distributedMesh);CHKERRQ(ierr);
     if (distributedMesh) {
       ierr = DMDestroy(dm);CHKERRQ(ierr);
       *dm  = distributedMesh;
     }
+    if (user->interpolateDistributed) {ierr = InterpolateDistributedMesh(dm, cellSimplex);CHKERRQ(ierr);}
     /* Refine mesh using a volume constraint */
     ierr = DMPlexSetRefinementUniform(*dm, PETSC_FALSE);CHKERRQ(ierr);
     ierr = DMPlexSetRefinementLimit(*dm, refinementLimit);CHKERRQ(ierr);
@@ -113,6 +380,8 @@ PetscErrorCode CreateMesh(MPI_Comm comm, AppCtx *user, DM *dm)
     }
   }
   ierr = DMSetFromOptions(*dm);CHKERRQ(ierr);
+  if (user->adaptRefine || user->adaptCoarsen) {ierr = AdaptMesh(user, dm);CHKERRQ(ierr);}
+  if (user->rebalance) {ierr = RebalanceMesh(dm);CHKERRQ(ierr);}
   if (user->overlap) {
     DM overlapMesh = NULL;
     /* Add the level-1 overlap to refined mesh */
@@ -25,6 +25,8 @@ typedef struct {
   PetscBool constraints;       /* Test local constraints */
   PetscBool tree;              /* Test tree routines */
   PetscInt  treeCell;          /* Cell to refine in tree test */
+  PetscBool batch;             /* Compare batched pointwise functions with the pointwise versions */
+  PetscBool mf;                /* Compare the matrix-free Jacobian with the assembled one */
   PetscReal constants[3];      /* Constant values for each dimension */
 } AppCtx;
 
@@ -135,6 +137,8 @@ static PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
   options->constraints     = PETSC_FALSE;
   options->tree            = PETSC_FALSE;
   options->treeCell        = 0;
+  options->batch           = PETSC_FALSE;
+  options->mf              = PETSC_FALSE;
 
   ierr = PetscOptionsBegin(comm, "", "Projection Test Options", "DMPlex");CHKERRQ(ierr);
   ierr = PetscOptionsInt("-debug", "The debugging level", "ex3.c", options->debug, &options->debug, NULL);CHKERRQ(ierr);
@@ -150,6 +154,8 @@ static PetscErrorCode ProcessOptions(MPI_Comm comm, AppCtx *options)
   ierr = PetscOptionsBool("-constraints", "Test local constraints (serial only)", "ex3.c", options->constraints, &options->constraints, NULL);CHKERRQ(ierr);
   ierr = PetscOptionsBool("-tree", "Test tree routines", "ex3.c", options->tree, &options->tree, NULL);CHKERRQ(ierr);
   ierr = PetscOptionsInt("-tree_cell", "cell to refine in tree test", "ex3.c", options->treeCell, &options->treeCell, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-batch", "Compare batched pointwise functions with the pointwise versions", "ex3.c", options->batch, &options->batch, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-mf", "Compare the matrix-free Jacobian with the assembled one", "ex3.c", options->mf, &options->mf, NULL);CHKERRQ(ierr);
   ierr = PetscOptionsEnd();
 
   PetscFunctionReturn(0);
@@ -249,6 +255,33 @@ static void simple_mass(PetscInt dim, PetscInt Nf, PetscInt NfAux,
   }
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "simple_mass_batch"
+static void simple_mass_batch(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                              const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                              const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                              PetscReal t, PetscReal u_tShift, PetscInt Np, const PetscReal x[], PetscScalar g0[])
+{
+  PetscInt d, p;
+  for (d = 0; d < dim; d++) {
+    for (p = 0; p < Np; p++) g0[(d*dim+d)*Np+p] = 1.;
+  }
+}
+
+/* The linearization of < v, u + u^3/3 >, which depends on the state */
+#undef __FUNCT__
+#define __FUNCT__ "nonlinear_mass"
+static void nonlinear_mass(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                           const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                           const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                           PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscScalar g0[])
+{
+  const PetscInt Nc = uOff[1] - uOff[0];
+  PetscInt       c;
+
+  for (c = 0; c < Nc; ++c) g0[c*Nc+c] = 1.0 + u[c]*u[c];
+}
+
 /* < \nabla v, 1/2(\nabla u + {\nabla u}^T) > */
 #undef __FUNCT__
 #define __FUNCT__ "symmetric_gradient_inner_product"
@@ -278,6 +311,62 @@ static void symmetric_gradient_inner_product(PetscInt dim, PetscInt Nf, PetscInt
   }
 }
 
+/* The batched version of symmetric_gradient_inner_product() */
+#undef __FUNCT__
+#define __FUNCT__ "symmetric_gradient_inner_product_batch"
+static void symmetric_gradient_inner_product_batch(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                                                   const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                                                   const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                                                   PetscReal t, PetscReal u_tShift, PetscInt Np, const PetscReal x[], PetscScalar C[])
+{
+  PetscInt compI, compJ, d, e, p;
+
+  for (compI = 0; compI < dim; ++compI) {
+    for (compJ = 0; compJ < dim; ++compJ) {
+      for (d = 0; d < dim; ++d) {
+        for (e = 0; e < dim; e++) {
+          PetscScalar val = 0.0;
+
+          if (d == e && d == compI && d == compJ) val = 1.0;
+          else if ((d == compJ && e == compI) || (d == e && compI == compJ)) val = 0.5;
+          for (p = 0; p < Np; ++p) C[(((compI*dim+compJ)*dim+d)*dim+e)*Np+p] = val;
+        }
+      }
+    }
+  }
+}
+
+/* The residual whose Jacobian is symmetric_gradient_inner_product() */
+#undef __FUNCT__
+#define __FUNCT__ "symmetric_gradient"
+static void symmetric_gradient(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                               const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                               const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                               PetscReal t, const PetscReal x[], PetscScalar f1[])
+{
+  PetscInt c, d;
+
+  for (c = 0; c < dim; ++c) {
+    for (d = 0; d < dim; ++d) f1[c*dim+d] = 0.5*(u_x[c*dim+d] + u_x[d*dim+c]);
+  }
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "symmetric_gradient_batch"
+static void symmetric_gradient_batch(PetscInt dim, PetscInt Nf, PetscInt NfAux,
+                                     const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[],
+                                     const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[],
+                                     PetscReal t, PetscInt Np, const PetscReal x[], PetscScalar f1[])
+{
+  PetscInt c, d, p;
+
+  for (c = 0; c < dim; ++c) {
+    for (d = 0; d < dim; ++d) {
+      for (p = 0; p < Np; ++p) f1[(c*dim+d)*Np+p] = 0.5*(u_x[(c*dim+d)*Np+p] + u_x[(d*dim+c)*Np+p]);
+    }
+  }
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "SetupSection"
 static PetscErrorCode SetupSection(DM dm, AppCtx *user)
@@ -420,6 +509,19 @@ static PetscErrorCode SetupSection(DM dm, AppCtx *user)
       ierr = PetscDSSetJacobian(ds, 0, 0, simple_mass, NULL,  NULL, NULL);CHKERRQ(ierr);
       /* build the mass matrix */
       ierr = DMPlexSNESComputeJacobianFEM(dm,local,mass,mass,NULL);CHKERRQ(ierr);
+      if (user->batch) {
+        Mat       massBatch;
+        PetscReal norm;
+
+        ierr = PetscDSSetJacobianBatch(ds, 0, 0, simple_mass_batch, NULL, NULL, NULL);CHKERRQ(ierr);
+        ierr = DMCreateMatrix(dm,&massBatch);CHKERRQ(ierr);
+        ierr = DMPlexSNESComputeJacobianFEM(dm,local,massBatch,massBatch,NULL);CHKERRQ(ierr);
+        ierr = MatAXPY(massBatch,-1.0,mass,DIFFERENT_NONZERO_PATTERN);CHKERRQ(ierr);
+        ierr = MatNorm(massBatch,NORM_INFINITY,&norm);CHKERRQ(ierr);
+        if (norm > 1.0e-10) {ierr = PetscPrintf(PetscObjectComm((PetscObject) dm), "Batched mass matrix differs from the pointwise one by %g\n", (double) norm);CHKERRQ(ierr);}
+        ierr = MatDestroy(&massBatch);CHKERRQ(ierr);
+        ierr = PetscDSSetJacobianBatch(ds, 0, 0, NULL, NULL, NULL, NULL);CHKERRQ(ierr);
+      }
       ierr = MatView(mass,PETSC_VIEWER_STDOUT_WORLD);CHKERRQ(ierr);
       ierr = MatDestroy(&mass);CHKERRQ(ierr);
       ierr = DMRestoreLocalVector(dm,&local);CHKERRQ(ierr);
@@ -470,9 +572,79 @@ static PetscErrorCode SetupSection(DM dm, AppCtx *user)
     ierr = DMPlexCreateRigidBody(dm,&sp);CHKERRQ(ierr);
     ierr = MatNullSpaceTest(sp,E,&isNullSpace);CHKERRQ(ierr);
     ierr = MatNullSpaceDestroy(&sp);CHKERRQ(ierr);
+    if (user->batch) {
+      Mat       EBatch;
+      Vec       X, F, FBatch;
+      PetscReal norm;
+
+      ierr = PetscDSSetJacobianBatch(ds,0,0,NULL,NULL,NULL,symmetric_gradient_inner_product_batch);CHKERRQ(ierr);
+      ierr = DMCreateMatrix(dm,&EBatch);CHKERRQ(ierr);
+      ierr = DMPlexSNESComputeJacobianFEM(dm,local,EBatch,EBatch,NULL);CHKERRQ(ierr);
+      ierr = MatAXPY(EBatch,-1.0,E,DIFFERENT_NONZERO_PATTERN);CHKERRQ(ierr);
+      ierr = MatNorm(EBatch,NORM_INFINITY,&norm);CHKERRQ(ierr);
+      if (norm > 1.0e-10) {ierr = PetscPrintf(PetscObjectComm((PetscObject) dm), "Batched Jacobian differs from the pointwise one by %g\n", (double) norm);CHKERRQ(ierr);}
+      ierr = MatDestroy(&EBatch);CHKERRQ(ierr);
+      ierr = PetscDSSetJacobianBatch(ds,0,0,NULL,NULL,NULL,NULL);CHKERRQ(ierr);
+      /* The residual is linear, so compare it on an arbitrary state */
+      ierr = DMGetLocalVector(dm,&X);CHKERRQ(ierr);
+      ierr = DMGetLocalVector(dm,&F);CHKERRQ(ierr);
+      ierr = DMGetLocalVector(dm,&FBatch);CHKERRQ(ierr);
+      ierr = VecSetRandom(X,NULL);CHKERRQ(ierr);
+      ierr = PetscDSSetResidual(ds,0,NULL,symmetric_gradient);CHKERRQ(ierr);
+      ierr = DMPlexSNESComputeResidualFEM(dm,X,F,NULL);CHKERRQ(ierr);
+      ierr = PetscDSSetResidualBatch(ds,0,NULL,symmetric_gradient_batch);CHKERRQ(ierr);
+      ierr = DMPlexSNESComputeResidualFEM(dm,X,FBatch,NULL);CHKERRQ(ierr);
+      ierr = PetscDSSetResidualBatch(ds,0,NULL,NULL);CHKERRQ(ierr);
+      ierr = VecAXPY(FBatch,-1.0,F);CHKERRQ(ierr);
+      ierr = VecNorm(FBatch,NORM_INFINITY,&norm);CHKERRQ(ierr);
+      if (norm > 1.0e-10) {ierr = PetscPrintf(PetscObjectComm((PetscObject) dm), "Batched residual differs from the pointwise one by %g\n", (double) norm);CHKERRQ(ierr);}
+      ierr = DMRestoreLocalVector(dm,&FBatch);CHKERRQ(ierr);
+      ierr = DMRestoreLocalVector(dm,&F);CHKERRQ(ierr);
+      ierr = DMRestoreLocalVector(dm,&X);CHKERRQ(ierr);
+    }
     ierr = MatDestroy(&E);CHKERRQ(ierr);
     ierr = DMRestoreLocalVector(dm,&local);CHKERRQ(ierr);
   }
+  if (user->mf && isPlex) {
+    Mat       J, Jmf;
+    Vec       U, local, X, Y, Ymf;
+    PetscDS   ds;
+    PetscReal norm, diff;
+
+    ierr = DMGetDS(dm,&ds);CHKERRQ(ierr);
+    ierr = PetscDSSetJacobian(ds,0,0,nonlinear_mass,NULL,NULL,user->numComponents == user->dim ? symmetric_gradient_inner_product : NULL);CHKERRQ(ierr);
+    ierr = DMGetGlobalVector(dm,&U);CHKERRQ(ierr);
+    ierr = DMGetLocalVector(dm,&local);CHKERRQ(ierr);
+    ierr = VecSetRandom(U,NULL);CHKERRQ(ierr);
+    ierr = DMGlobalToLocalBegin(dm,U,INSERT_VALUES,local);CHKERRQ(ierr);
+    ierr = DMGlobalToLocalEnd(dm,U,INSERT_VALUES,local);CHKERRQ(ierr);
+    ierr = DMCreateMatrix(dm,&J);CHKERRQ(ierr);
+    ierr = DMPlexSNESComputeJacobianFEM(dm,local,J,J,NULL);CHKERRQ(ierr);
+    ierr = DMPlexSNESCreateJacobianMF(dm,local,NULL,&Jmf);CHKERRQ(ierr);
+    ierr = VecDuplicate(U,&X);CHKERRQ(ierr);
+    ierr = VecDuplicate(U,&Y);CHKERRQ(ierr);
+    ierr = VecDuplicate(U,&Ymf);CHKERRQ(ierr);
+    ierr = VecSetRandom(X,NULL);CHKERRQ(ierr);
+    ierr = MatMult(J,X,Y);CHKERRQ(ierr);
+    ierr = MatMult(Jmf,X,Ymf);CHKERRQ(ierr);
+    ierr = VecNorm(Y,NORM_INFINITY,&norm);CHKERRQ(ierr);
+    ierr = VecAXPY(Ymf,-1.0,Y);CHKERRQ(ierr);
+    ierr = VecNorm(Ymf,NORM_INFINITY,&diff);CHKERRQ(ierr);
+    if (diff > 1.0e-10*norm) {ierr = PetscPrintf(PetscObjectComm((PetscObject) dm), "Matrix-free Jacobian action differs from the assembled one by %g\n", (double) diff);CHKERRQ(ierr);}
+    ierr = MatGetDiagonal(J,Y);CHKERRQ(ierr);
+    ierr = MatGetDiagonal(Jmf,Ymf);CHKERRQ(ierr);
+    ierr = VecNorm(Y,NORM_INFINITY,&norm);CHKERRQ(ierr);
+    ierr = VecAXPY(Ymf,-1.0,Y);CHKERRQ(ierr);
+    ierr = VecNorm(Ymf,NORM_INFINITY,&diff);CHKERRQ(ierr);
+    if (diff > 1.0e-10*norm) {ierr = PetscPrintf(PetscObjectComm((PetscObject) dm), "Matrix-free Jacobian diagonal differs from the assembled one by %g\n", (double) diff);CHKERRQ(ierr);}
+    ierr = VecDestroy(&X);CHKERRQ(ierr);
+    ierr = VecDestroy(&Y);CHKERRQ(ierr);
+    ierr = VecDestroy(&Ymf);CHKERRQ(ierr);
+    ierr = MatDestroy(&Jmf);CHKERRQ(ierr);
+    ierr = MatDestroy(&J);CHKERRQ(ierr);
+    ierr = DMRestoreLocalVector(dm,&local);CHKERRQ(ierr);
+    ierr = DMRestoreGlobalVector(dm,&U);CHKERRQ(ierr);
+  }
   PetscFunctionReturn(0);
 }
 
@@ -86,6 +86,70 @@ PetscErrorCode TestLookup(DMLabel label, AppCtx *user)
   PetscFunctionReturn(0);
 };
 
+#undef __FUNCT__
+#define __FUNCT__ "TestBulk"
+PetscErrorCode TestBulk(DMLabel label, AppCtx *user)
+{
+  IS              valueIS, pointIS;
+  const PetscInt *values;
+  PetscInt        numValues, n, m, p, v;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  /* The union of all strata is every labeled point */
+  ierr = DMLabelGetNumValues(label, &numValues);CHKERRQ(ierr);
+  ierr = DMLabelGetValueIS(label, &valueIS);CHKERRQ(ierr);
+  ierr = ISGetIndices(valueIS, &values);CHKERRQ(ierr);
+  ierr = DMLabelGetStrataUnion(label, numValues, values, &pointIS);CHKERRQ(ierr);
+  ierr = ISGetLocalSize(pointIS, &n);CHKERRQ(ierr);
+  if (n != user->size) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Union of strata has %d points, not %d", n, user->size);
+  ierr = ISDestroy(&pointIS);CHKERRQ(ierr);
+  /* The intersection of the first two strata */
+  if (numValues > 1) {
+    for (m = 0, p = user->pStart; p < user->pEnd; ++p) {
+      PetscBool has0, has1;
+
+      ierr = DMLabelStratumHasPoint(label, values[0], p, &has0);CHKERRQ(ierr);
+      ierr = DMLabelStratumHasPoint(label, values[1], p, &has1);CHKERRQ(ierr);
+      if (has0 && has1) ++m;
+    }
+    ierr = DMLabelGetStrataIntersection(label, 2, values, &pointIS);CHKERRQ(ierr);
+    ierr = ISGetLocalSize(pointIS, &n);CHKERRQ(ierr);
+    if (n != m) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Intersection of strata has %d points, not %d", n, m);
+    ierr = ISDestroy(&pointIS);CHKERRQ(ierr);
+  }
+  ierr = ISRestoreIndices(valueIS, &values);CHKERRQ(ierr);
+  ierr = ISDestroy(&valueIS);CHKERRQ(ierr);
+  /* Replace a stratum, and check that lookup follows */
+  ierr = ISCreateStride(PETSC_COMM_SELF, 10, user->pStart, 1, &pointIS);CHKERRQ(ierr);
+  ierr = DMLabelSetStratumIS(label, 0, pointIS);CHKERRQ(ierr);
+  ierr = ISDestroy(&pointIS);CHKERRQ(ierr);
+  ierr = DMLabelGetStratumSize(label, 0, &n);CHKERRQ(ierr);
+  if (n != 10) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Replaced stratum has %d points, not 10", n);
+  for (p = user->pStart; p < user->pStart+10; ++p) {
+    ierr = DMLabelGetValue(label, p, &v);CHKERRQ(ierr);
+    if (v != 0) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Point %d has value %d, not 0", p, v);
+  }
+  /* Clearing a value exposes the next stratum containing the point */
+  ierr = DMLabelSetValue(label, user->pStart, user->numStrata);CHKERRQ(ierr);
+  ierr = DMLabelClearValue(label, user->pStart, 0);CHKERRQ(ierr);
+  ierr = DMLabelGetNumValues(label, &numValues);CHKERRQ(ierr);
+  ierr = DMLabelGetValueIS(label, &valueIS);CHKERRQ(ierr);
+  ierr = ISGetIndices(valueIS, &values);CHKERRQ(ierr);
+  for (m = 0; m < numValues; ++m) {
+    PetscBool has;
+
+    ierr = DMLabelStratumHasPoint(label, values[m], user->pStart, &has);CHKERRQ(ierr);
+    if (has) break;
+  }
+  ierr = DMLabelGetValue(label, user->pStart, &v);CHKERRQ(ierr);
+  if (m >= numValues || v != values[m]) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Point %d has the wrong value %d after clearing", user->pStart, v);
+  ierr = ISRestoreIndices(valueIS, &values);CHKERRQ(ierr);
+  ierr = ISDestroy(&valueIS);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_SELF, "Bulk label operations pass\n");CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+};
+
 #undef __FUNCT__
 #define __FUNCT__ "main"
 int main(int argc, char **argv)
@@ -99,6 +163,7 @@ int main(int argc, char **argv)
   ierr = DMLabelCreate("Test Label", &label);CHKERRQ(ierr);
   ierr = TestSetup(label, &user);CHKERRQ(ierr);
   ierr = TestLookup(label, &user);CHKERRQ(ierr);
+  ierr = TestBulk(label, &user);CHKERRQ(ierr);
   ierr = DMLabelDestroy(&label);CHKERRQ(ierr);
   ierr = PetscFinalize();
   return 0;
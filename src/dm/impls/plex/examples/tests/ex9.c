@@ -365,6 +365,98 @@ static PetscErrorCode TestVecClosure(DM dm, PetscBool useIndex, AppCtx *user)
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "CheckVecClosures"
+/* Compare the indexed closures of dm with the unindexed closures in refValues, and their assembly with refw */
+static PetscErrorCode CheckVecClosures(DM dm, PetscSection s, Vec v, PetscInt cStart, PetscInt cEnd, PetscInt csize, const PetscScalar refValues[], Vec refw)
+{
+  PetscScalar   *values;
+  PetscInt       clStart, clEnd, i;
+  Vec            w;
+  PetscReal      norm;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscMalloc1((cEnd-cStart)*csize, &values);CHKERRQ(ierr);
+  ierr = DMPlexVecGetClosures(dm, s, v, cStart, cEnd, csize, values);CHKERRQ(ierr);
+  ierr = PetscSectionGetClosureDofIndex(s, (PetscObject) dm, &clStart, &clEnd, NULL, NULL);CHKERRQ(ierr);
+  if ((clStart != cStart) || (clEnd != cEnd)) SETERRQ4(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Closure dof index covers [%D, %D) instead of the cells [%D, %D)", clStart, clEnd, cStart, cEnd);
+  for (i = 0; i < (cEnd-cStart)*csize; ++i) {
+    if (values[i] != refValues[i]) SETERRQ4(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Closure of cell %D entry %D is %g != %g", cStart+i/csize, i%csize, (double) PetscRealPart(values[i]), (double) PetscRealPart(refValues[i]));
+  }
+  ierr = DMGetLocalVector(dm, &w);CHKERRQ(ierr);
+  ierr = VecSet(w, 0.0);CHKERRQ(ierr);
+  ierr = DMPlexVecSetClosures(dm, s, w, cStart, cEnd, csize, values, ADD_VALUES);CHKERRQ(ierr);
+  ierr = VecAXPY(w, -1.0, refw);CHKERRQ(ierr);
+  ierr = VecNorm(w, NORM_INFINITY, &norm);CHKERRQ(ierr);
+  if (norm > 0.0) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Assembled closures differ by %g", (double) norm);
+  ierr = DMRestoreLocalVector(dm, &w);CHKERRQ(ierr);
+  ierr = PetscFree(values);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "TestVecClosures"
+/*
+  Compare the indexed closures with the unindexed ones. The section is shared with a clone, so its index must move to
+  the clone, must not be handed to a new clone after the first is destroyed, and must be rebuilt for the original DM.
+*/
+static PetscErrorCode TestVecClosures(DM dm, AppCtx *user)
+{
+  DM             cdm;
+  PetscSection   s;
+  Vec            v, refw;
+  PetscScalar   *refValues, *array;
+  PetscInt       cStart, cEnd, clStart, clEnd, csize, size, vsize, c, i;
+  PetscBool      useIndex;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMPlexGetUseClosureDofIndex(dm, &useIndex);CHKERRQ(ierr);
+  ierr = DMPlexSetUseClosureDofIndex(dm, PETSC_FALSE);CHKERRQ(ierr);
+  ierr = DMPlexCreateSection(dm, user->dim, user->numFields, user->numComponents, user->numDof, 0, NULL, NULL, NULL, NULL, &s);CHKERRQ(ierr);
+  ierr = DMSetDefaultSection(dm, s);CHKERRQ(ierr);
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(dm, &v);CHKERRQ(ierr);
+  ierr = VecGetLocalSize(v, &vsize);CHKERRQ(ierr);
+  ierr = VecGetArray(v, &array);CHKERRQ(ierr);
+  for (i = 0; i < vsize; ++i) array[i] = i;
+  ierr = VecRestoreArray(v, &array);CHKERRQ(ierr);
+  /* Unindexed closures and their assembly */
+  ierr = DMPlexVecGetClosure(dm, s, v, cStart, &csize, NULL);CHKERRQ(ierr);
+  ierr = PetscMalloc1((cEnd-cStart)*csize, &refValues);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(dm, &refw);CHKERRQ(ierr);
+  ierr = VecSet(refw, 0.0);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {
+    PetscScalar *cvalues = &refValues[(c-cStart)*csize];
+
+    size = csize;
+    ierr = DMPlexVecGetClosure(dm, s, v, c, &size, &cvalues);CHKERRQ(ierr);
+    ierr = DMPlexVecSetClosure(dm, s, refw, c, cvalues, ADD_VALUES);CHKERRQ(ierr);
+  }
+  ierr = PetscSectionGetClosureDofIndex(s, (PetscObject) dm, &clStart, &clEnd, NULL, NULL);CHKERRQ(ierr);
+  if (clEnd > clStart) SETERRQ(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Closure dofs were indexed although the index is off");
+  /* The clone shares the mesh data, and so the flag, and takes over the index of the shared section */
+  ierr = DMPlexSetUseClosureDofIndex(dm, PETSC_TRUE);CHKERRQ(ierr);
+  ierr = DMClone(dm, &cdm);CHKERRQ(ierr);
+  ierr = DMSetDefaultSection(cdm, s);CHKERRQ(ierr);
+  ierr = CheckVecClosures(cdm, s, v, cStart, cEnd, csize, refValues, refw);CHKERRQ(ierr);
+  ierr = DMDestroy(&cdm);CHKERRQ(ierr);
+  /* A new clone, which may reuse the address of the old one, must not see its index */
+  ierr = DMClone(dm, &cdm);CHKERRQ(ierr);
+  ierr = PetscSectionGetClosureDofIndex(s, (PetscObject) cdm, &clStart, &clEnd, NULL, NULL);CHKERRQ(ierr);
+  if (clEnd > clStart) SETERRQ(PETSC_COMM_SELF, PETSC_ERR_PLIB, "A new DM was given the closure dof index of a destroyed DM");
+  ierr = DMDestroy(&cdm);CHKERRQ(ierr);
+  /* The original DM rebuilds the index */
+  ierr = CheckVecClosures(dm, s, v, cStart, cEnd, csize, refValues, refw);CHKERRQ(ierr);
+  ierr = PetscFree(refValues);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(dm, &refw);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(dm, &v);CHKERRQ(ierr);
+  ierr = PetscSectionDestroy(&s);CHKERRQ(ierr);
+  ierr = DMPlexSetUseClosureDofIndex(dm, useIndex);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "CleanupContext"
 static PetscErrorCode CleanupContext(AppCtx *user)
@@ -393,6 +485,7 @@ int main(int argc, char **argv)
   ierr = TestTransitiveClosure(dm, &user);CHKERRQ(ierr);
   ierr = TestVecClosure(dm, PETSC_FALSE, &user);CHKERRQ(ierr);
   ierr = TestVecClosure(dm, PETSC_TRUE,  &user);CHKERRQ(ierr);
+  ierr = TestVecClosures(dm, &user);CHKERRQ(ierr);
   ierr = DMDestroy(&dm);CHKERRQ(ierr);
   ierr = CleanupContext(&user);CHKERRQ(ierr);
   ierr = PetscFinalize();
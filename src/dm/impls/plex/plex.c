@@ -4,7 +4,7 @@
 #include <petscds.h>
 
 /* Logging support */
-PetscLogEvent DMPLEX_Interpolate, PETSCPARTITIONER_Partition, DMPLEX_Distribute, DMPLEX_DistributeCones, DMPLEX_DistributeLabels, DMPLEX_DistributeSF, DMPLEX_DistributeOverlap, DMPLEX_DistributeField, DMPLEX_DistributeData, DMPLEX_Migrate, DMPLEX_Stratify, DMPLEX_Preallocate, DMPLEX_ResidualFEM, DMPLEX_JacobianFEM, DMPLEX_InterpolatorFEM, DMPLEX_InjectorFEM, DMPLEX_IntegralFEM, DMPLEX_CreateGmsh;
+PetscLogEvent DMPLEX_Interpolate, PETSCPARTITIONER_Partition, DMPLEX_Distribute, DMPLEX_DistributeCones, DMPLEX_DistributeLabels, DMPLEX_DistributeSF, DMPLEX_DistributeOverlap, DMPLEX_DistributeField, DMPLEX_DistributeData, DMPLEX_Migrate, DMPLEX_Rebalance, DMPLEX_Reorder, DMPLEX_Adapt, DMPLEX_Stratify, DMPLEX_Preallocate, DMPLEX_ResidualFEM, DMPLEX_JacobianFEM, DMPLEX_JacobianActionFEM, DMPLEX_InterpolatorFEM, DMPLEX_InjectorFEM, DMPLEX_IntegralFEM, DMPLEX_CreateGmsh;
 
 PETSC_EXTERN PetscErrorCode VecView_Seq(Vec, PetscViewer);
 PETSC_EXTERN PetscErrorCode VecView_MPI(Vec, PetscViewer);
@@ -662,6 +662,8 @@ PetscErrorCode DMDestroy_Plex(DM dm)
     next = tmp;
   }
   ierr = DMDestroy(&mesh->coarseMesh);CHKERRQ(ierr);
+  ierr = DMLabelDestroy(&mesh->adaptMarker);CHKERRQ(ierr);
+  ierr = ISDestroy(&mesh->adaptParents);CHKERRQ(ierr);
   ierr = DMLabelDestroy(&mesh->subpointMap);CHKERRQ(ierr);
   ierr = ISDestroy(&mesh->globalVertexNumbers);CHKERRQ(ierr);
   ierr = ISDestroy(&mesh->globalCellNumbers);CHKERRQ(ierr);
@@ -811,6 +813,7 @@ PetscErrorCode DMPlexSetChart(DM dm, PetscInt pStart, PetscInt pEnd)
   PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
   ierr = PetscSectionSetChart(mesh->coneSection, pStart, pEnd);CHKERRQ(ierr);
   ierr = PetscSectionSetChart(mesh->supportSection, pStart, pEnd);CHKERRQ(ierr);
+  ierr = PetscObjectStateIncrease((PetscObject) dm);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -991,6 +994,7 @@ PetscErrorCode DMPlexSetCone(DM dm, PetscInt p, const PetscInt cone[])
     if ((cone[c] < pStart) || (cone[c] >= pEnd)) SETERRQ3(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "Cone point %D is not in the valid range [%D, %D)", cone[c], pStart, pEnd);
     mesh->cones[off+c] = cone[c];
   }
+  ierr = PetscObjectStateIncrease((PetscObject) dm);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1087,6 +1091,7 @@ PetscErrorCode DMPlexSetConeOrientation(DM dm, PetscInt p, const PetscInt coneOr
     if (o && ((o < -(cdof+1)) || (o >= cdof))) SETERRQ3(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "Cone orientation %D is not in the valid range [%D. %D)", o, -(cdof+1), cdof);
     mesh->coneOrientations[off+c] = o;
   }
+  ierr = PetscObjectStateIncrease((PetscObject) dm);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1108,6 +1113,7 @@ PetscErrorCode DMPlexInsertCone(DM dm, PetscInt p, PetscInt conePos, PetscInt co
   ierr = PetscSectionGetOffset(mesh->coneSection, p, &off);CHKERRQ(ierr);
   if ((conePos < 0) || (conePos >= dof)) SETERRQ3(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "Cone position %D of point %D is not in the valid range [0, %D)", conePos, p, dof);
   mesh->cones[off+conePos] = conePoint;
+  ierr = PetscObjectStateIncrease((PetscObject) dm);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1128,6 +1134,7 @@ PetscErrorCode DMPlexInsertConeOrientation(DM dm, PetscInt p, PetscInt conePos,
   ierr = PetscSectionGetOffset(mesh->coneSection, p, &off);CHKERRQ(ierr);
   if ((conePos < 0) || (conePos >= dof)) SETERRQ3(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "Cone position %D of point %D is not in the valid range [0, %D)", conePos, p, dof);
   mesh->coneOrientations[off+conePos] = coneOrientation;
+  ierr = PetscObjectStateIncrease((PetscObject) dm);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1767,6 +1774,7 @@ PetscErrorCode DMPlexSymmetrize(DM dm)
     }
   }
   ierr = PetscFree(offsets);CHKERRQ(ierr);
+  ierr = PetscObjectStateIncrease((PetscObject) dm);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1869,6 +1877,7 @@ PetscErrorCode DMPlexStratify(DM dm)
     ierr = ISDestroy(&pointIS);CHKERRQ(ierr);
   }
   ierr = PetscLogEventEnd(DMPLEX_Stratify,dm,0,0,0);CHKERRQ(ierr);
+  ierr = PetscObjectStateIncrease((PetscObject) dm);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -3333,6 +3342,38 @@ PETSC_STATIC_INLINE PetscErrorCode DMPlexVecGetClosure_Fields_Static(PetscSectio
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexVecGetClosure_Indexed_Static"
+PETSC_STATIC_INLINE PetscErrorCode DMPlexVecGetClosure_Indexed_Static(DM dm, Vec v, PetscInt numDofs, const PetscInt dofs[], PetscInt *csize, PetscScalar *values[])
+{
+  const PetscScalar *vArray;
+  PetscScalar       *array;
+  PetscInt           d;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBeginHot;
+  if (!values) {
+    if (csize) *csize = numDofs;
+    PetscFunctionReturn(0);
+  }
+  if (!*values) {
+    ierr = DMGetWorkArray(dm, numDofs, PETSC_SCALAR, &array);CHKERRQ(ierr);
+  } else {
+    if (numDofs > *csize) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Size of input array %d < actual size %d", *csize, numDofs);
+    array = *values;
+  }
+  ierr = VecGetArrayRead(v, &vArray);CHKERRQ(ierr);
+  for (d = 0; d < numDofs; ++d) array[d] = vArray[dofs[d] < 0 ? -(dofs[d]+1) : dofs[d]];
+  ierr = VecRestoreArrayRead(v, &vArray);CHKERRQ(ierr);
+  if (!*values) {
+    if (csize) *csize = numDofs;
+    *values = array;
+  } else {
+    *csize = numDofs;
+  }
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "DMPlexVecGetClosure"
 /*@C
@@ -3366,8 +3407,8 @@ PetscErrorCode DMPlexVecGetClosure(DM dm, PetscSection section, Vec v, PetscInt
   IS              clPoints;
   PetscScalar    *array, *vArray;
   PetscInt       *points = NULL;
-  const PetscInt *clp;
-  PetscInt        depth, numFields, numPoints, size;
+  const PetscInt *clp, *clOff, *clDofs;
+  PetscInt        depth, numFields, numPoints, size, cStart, cEnd;
   PetscErrorCode  ierr;
 
   PetscFunctionBeginHot;
@@ -3375,6 +3416,13 @@ PetscErrorCode DMPlexVecGetClosure(DM dm, PetscSection section, Vec v, PetscInt
   if (!section) {ierr = DMGetDefaultSection(dm, &section);CHKERRQ(ierr);}
   PetscValidHeaderSpecific(section, PETSC_SECTION_CLASSID, 2);
   PetscValidHeaderSpecific(v, VEC_CLASSID, 3);
+  ierr = DMPlexGetClosureDofIndex_Internal(dm, section, NULL, &cStart, &cEnd, &clOff, &clDofs);CHKERRQ(ierr);
+  if ((point >= cStart) && (point < cEnd)) {
+    const PetscInt c = point - cStart;
+
+    ierr = DMPlexVecGetClosure_Indexed_Static(dm, v, clOff[c+1]-clOff[c], &clDofs[clOff[c]], csize, values);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = DMPlexGetDepth(dm, &depth);CHKERRQ(ierr);
   ierr = PetscSectionGetNumFields(section, &numFields);CHKERRQ(ierr);
   if (depth == 1 && numFields < 2) {
@@ -3702,6 +3750,36 @@ PETSC_STATIC_INLINE PetscErrorCode DMPlexVecSetClosure_Static(DM dm, PetscSectio
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexVecSetClosure_Indexed_Static"
+/* Constrained dofs are stored as -(dof+1), and are skipped unless the mode sets boundary values */
+PETSC_STATIC_INLINE PetscErrorCode DMPlexVecSetClosure_Indexed_Static(PetscInt numDofs, const PetscInt dofs[], const PetscScalar values[], InsertMode mode, PetscScalar array[])
+{
+  PetscInt d;
+
+  PetscFunctionBeginHot;
+  switch (mode) {
+  case INSERT_VALUES:
+    for (d = 0; d < numDofs; ++d) if (dofs[d] >= 0) array[dofs[d]] = values[d];
+    break;
+  case INSERT_ALL_VALUES:
+    for (d = 0; d < numDofs; ++d) array[dofs[d] < 0 ? -(dofs[d]+1) : dofs[d]] = values[d];
+    break;
+  case INSERT_BC_VALUES:
+    for (d = 0; d < numDofs; ++d) if (dofs[d] < 0) array[-(dofs[d]+1)] = values[d];
+    break;
+  case ADD_VALUES:
+    for (d = 0; d < numDofs; ++d) if (dofs[d] >= 0) array[dofs[d]] += values[d];
+    break;
+  case ADD_ALL_VALUES:
+    for (d = 0; d < numDofs; ++d) array[dofs[d] < 0 ? -(dofs[d]+1) : dofs[d]] += values[d];
+    break;
+  default:
+    SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Invalid insert mode %D", mode);
+  }
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "DMPlexVecSetClosure"
 /*@C
@@ -3730,8 +3808,8 @@ PetscErrorCode DMPlexVecSetClosure(DM dm, PetscSection section, Vec v, PetscInt
   IS              clPoints;
   PetscScalar    *array;
   PetscInt       *points = NULL;
-  const PetscInt *clp;
-  PetscInt        depth, numFields, numPoints, p;
+  const PetscInt *clp, *clOff, *clDofs;
+  PetscInt        depth, numFields, numPoints, p, cStart, cEnd;
   PetscErrorCode  ierr;
 
   PetscFunctionBeginHot;
@@ -3739,6 +3817,15 @@ PetscErrorCode DMPlexVecSetClosure(DM dm, PetscSection section, Vec v, PetscInt
   if (!section) {ierr = DMGetDefaultSection(dm, &section);CHKERRQ(ierr);}
   PetscValidHeaderSpecific(section, PETSC_SECTION_CLASSID, 2);
   PetscValidHeaderSpecific(v, VEC_CLASSID, 3);
+  ierr = DMPlexGetClosureDofIndex_Internal(dm, section, NULL, &cStart, &cEnd, &clOff, &clDofs);CHKERRQ(ierr);
+  if ((point >= cStart) && (point < cEnd)) {
+    const PetscInt c = point - cStart;
+
+    ierr = VecGetArray(v, &array);CHKERRQ(ierr);
+    ierr = DMPlexVecSetClosure_Indexed_Static(clOff[c+1]-clOff[c], &clDofs[clOff[c]], values, mode, array);CHKERRQ(ierr);
+    ierr = VecRestoreArray(v, &array);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = DMPlexGetDepth(dm, &depth);CHKERRQ(ierr);
   ierr = PetscSectionGetNumFields(section, &numFields);CHKERRQ(ierr);
   if (depth == 1 && numFields < 2 && mode == ADD_VALUES) {
@@ -3858,6 +3945,156 @@ PetscErrorCode DMPlexVecSetClosure(DM dm, PetscSection section, Vec v, PetscInt
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexGetClosureSize_Static"
+PETSC_STATIC_INLINE PetscErrorCode DMPlexGetClosureSize_Static(DM dm, PetscSection section, PetscInt point, PetscInt *size)
+{
+  PetscInt      *points = NULL;
+  PetscInt       numPoints, pStart, pEnd, dof, p;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscSectionGetChart(section, &pStart, &pEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetTransitiveClosure(dm, point, PETSC_TRUE, &numPoints, &points);CHKERRQ(ierr);
+  for (p = 0, *size = 0; p < numPoints*2; p += 2) {
+    if ((points[p] < pStart) || (points[p] >= pEnd)) continue;
+    ierr = PetscSectionGetDof(section, points[p], &dof);CHKERRQ(ierr);
+    *size += dof;
+  }
+  ierr = DMPlexRestoreTransitiveClosure(dm, point, PETSC_TRUE, &numPoints, &points);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexCheckClosureSizes_Static"
+/* Check that each cell in [cStart, cEnd) has a closure of size csize, and return the flattened dofs if they are indexed */
+PETSC_STATIC_INLINE PetscErrorCode DMPlexCheckClosureSizes_Static(DM dm, PetscSection section, PetscSection globalSection, PetscInt cStart, PetscInt cEnd, PetscInt csize, const PetscInt *dofs[])
+{
+  const PetscInt *clOff, *clDofs;
+  PetscInt        clStart, clEnd, size = 0, c;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr  = DMPlexGetClosureDofIndex_Internal(dm, section, globalSection, &clStart, &clEnd, &clOff, &clDofs);CHKERRQ(ierr);
+  *dofs = NULL;
+  for (c = cStart; c < cEnd; ++c) {
+    if ((c >= clStart) && (c < clEnd)) size = clOff[c-clStart+1] - clOff[c-clStart];
+    else {ierr = DMPlexGetClosureSize_Static(dm, section, c, &size);CHKERRQ(ierr);}
+    if (size != csize) SETERRQ3(PETSC_COMM_SELF, PETSC_ERR_ARG_SIZ, "Closure of cell %D has size %D != %D", c, size, csize);
+  }
+  if ((cStart >= clStart) && (cEnd <= clEnd)) *dofs = &clDofs[clOff[cStart-clStart]];
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexVecGetClosures"
+/*@C
+  DMPlexVecGetClosures - Get the values on the closure of each cell in a range
+
+  Not collective
+
+  Input Parameters:
++ dm - The DM
+. section - The section describing the layout in v, or NULL to use the default section
+. v - The local vector
+. cStart - The first cell
+. cEnd - One past the last cell
+- csize - The number of values in the closure of each cell
+
+  Output Parameter:
+. values - The closure values, an array of size (cEnd-cStart)*csize where the closure of cell c starts at values[(c-cStart)*csize]
+
+  Note: All cells in the range must have closures of size csize. When the closure dofs are indexed, see
+  DMPlexSetUseClosureDofIndex(), this is a single indexed copy, and otherwise DMPlexVecGetClosure() is called for each cell.
+
+  Level: intermediate
+
+.seealso DMPlexVecGetClosure(), DMPlexVecSetClosures(), DMPlexMatSetClosures()
+@*/
+PetscErrorCode DMPlexVecGetClosures(DM dm, PetscSection section, Vec v, PetscInt cStart, PetscInt cEnd, PetscInt csize, PetscScalar values[])
+{
+  const PetscInt *dofs;
+  PetscInt        c;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  if (!section) {ierr = DMGetDefaultSection(dm, &section);CHKERRQ(ierr);}
+  PetscValidHeaderSpecific(section, PETSC_SECTION_CLASSID, 2);
+  PetscValidHeaderSpecific(v, VEC_CLASSID, 3);
+  if (cEnd <= cStart) PetscFunctionReturn(0);
+  PetscValidScalarPointer(values, 7);
+  ierr = DMPlexCheckClosureSizes_Static(dm, section, NULL, cStart, cEnd, csize, &dofs);CHKERRQ(ierr);
+  if (dofs) {
+    const PetscScalar *vArray;
+    PetscInt           d;
+
+    ierr = VecGetArrayRead(v, &vArray);CHKERRQ(ierr);
+    for (d = 0; d < (cEnd-cStart)*csize; ++d) values[d] = vArray[dofs[d] < 0 ? -(dofs[d]+1) : dofs[d]];
+    ierr = VecRestoreArrayRead(v, &vArray);CHKERRQ(ierr);
+  } else {
+    for (c = cStart; c < cEnd; ++c) {
+      PetscScalar *cvalues = &values[(c-cStart)*csize];
+      PetscInt     size    = csize;
+
+      ierr = DMPlexVecGetClosure(dm, section, v, c, &size, &cvalues);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexVecSetClosures"
+/*@C
+  DMPlexVecSetClosures - Set the values on the closure of each cell in a range
+
+  Not collective
+
+  Input Parameters:
++ dm - The DM
+. section - The section describing the layout in v, or NULL to use the default section
+. v - The local vector
+. cStart - The first cell
+. cEnd - One past the last cell
+. csize - The number of values in the closure of each cell
+. values - The closure values, where the closure of cell c starts at values[(c-cStart)*csize]
+- mode - The insert mode, where INSERT_ALL_VALUES and ADD_ALL_VALUES also overwrite boundary conditions
+
+  Note: All cells in the range must have closures of size csize. The cells are processed in order, so with INSERT_VALUES
+  a dof shared between cells gets the value from the last one.
+
+  Level: intermediate
+
+.seealso DMPlexVecSetClosure(), DMPlexVecGetClosures(), DMPlexMatSetClosures()
+@*/
+PetscErrorCode DMPlexVecSetClosures(DM dm, PetscSection section, Vec v, PetscInt cStart, PetscInt cEnd, PetscInt csize, const PetscScalar values[], InsertMode mode)
+{
+  const PetscInt *dofs;
+  PetscInt        c;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  if (!section) {ierr = DMGetDefaultSection(dm, &section);CHKERRQ(ierr);}
+  PetscValidHeaderSpecific(section, PETSC_SECTION_CLASSID, 2);
+  PetscValidHeaderSpecific(v, VEC_CLASSID, 3);
+  if (cEnd <= cStart) PetscFunctionReturn(0);
+  PetscValidScalarPointer(values, 7);
+  ierr = DMPlexCheckClosureSizes_Static(dm, section, NULL, cStart, cEnd, csize, &dofs);CHKERRQ(ierr);
+  if (dofs) {
+    PetscScalar *array;
+
+    ierr = VecGetArray(v, &array);CHKERRQ(ierr);
+    ierr = DMPlexVecSetClosure_Indexed_Static((cEnd-cStart)*csize, dofs, values, mode, array);CHKERRQ(ierr);
+    ierr = VecRestoreArray(v, &array);CHKERRQ(ierr);
+  } else {
+    for (c = cStart; c < cEnd; ++c) {
+      ierr = DMPlexVecSetClosure(dm, section, v, c, &values[(c-cStart)*csize], mode);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "DMPlexVecSetFieldClosure_Internal"
 PetscErrorCode DMPlexVecSetFieldClosure_Internal(DM dm, PetscSection section, Vec v, PetscBool fieldActive[], PetscInt point, const PetscScalar values[], InsertMode mode)
@@ -4590,7 +4827,8 @@ PetscErrorCode DMPlexMatSetClosure(DM dm, PetscSection section, PetscSection glo
   const PetscInt *clp;
   PetscInt       *indices;
   PetscInt        offsets[32];
-  PetscInt        numFields, numPoints, newNumPoints, numIndices, newNumIndices, dof, off, globalOff, pStart, pEnd, p, q, f;
+  const PetscInt *clOff, *clDofs;
+  PetscInt        numFields, numPoints, newNumPoints, numIndices, newNumIndices, dof, off, globalOff, pStart, pEnd, p, q, f, cStart, cEnd;
   PetscScalar    *newValues;
   PetscErrorCode  ierr;
 
@@ -4601,6 +4839,30 @@ PetscErrorCode DMPlexMatSetClosure(DM dm, PetscSection section, PetscSection glo
   if (!globalSection) {ierr = DMGetDefaultGlobalSection(dm, &globalSection);CHKERRQ(ierr);}
   PetscValidHeaderSpecific(globalSection, PETSC_SECTION_CLASSID, 3);
   PetscValidHeaderSpecific(A, MAT_CLASSID, 4);
+  ierr = DMPlexGetClosureDofIndex_Internal(dm, section, globalSection, &cStart, &cEnd, &clOff, &clDofs);CHKERRQ(ierr);
+  if ((point >= cStart) && (point < cEnd)) {
+    const PetscInt *cindices = &clDofs[clOff[point-cStart]];
+
+    numIndices = clOff[point-cStart+1] - clOff[point-cStart];
+    if (mesh->printSetValues) {ierr = DMPlexPrintMatSetValues(PETSC_VIEWER_STDOUT_SELF, A, point, numIndices, cindices, 0, NULL, values);CHKERRQ(ierr);}
+    ierr = MatSetValues(A, numIndices, cindices, numIndices, cindices, values, mode);
+    if (mesh->printFEM > 1) {
+      PetscInt i;
+      ierr = PetscPrintf(PETSC_COMM_SELF, "  Indices:");CHKERRQ(ierr);
+      for (i = 0; i < numIndices; ++i) {ierr = PetscPrintf(PETSC_COMM_SELF, " %d", cindices[i]);CHKERRQ(ierr);}
+      ierr = PetscPrintf(PETSC_COMM_SELF, "\n");CHKERRQ(ierr);
+    }
+    if (ierr) {
+      PetscMPIInt    rank;
+      PetscErrorCode ierr2;
+
+      ierr2 = MPI_Comm_rank(PetscObjectComm((PetscObject)A), &rank);CHKERRQ(ierr2);
+      ierr2 = (*PetscErrorPrintf)("[%d]ERROR in DMPlexMatSetClosure\n", rank);CHKERRQ(ierr2);
+      ierr2 = DMPlexPrintMatSetValues(PETSC_VIEWER_STDERR_SELF, A, point, numIndices, cindices, 0, NULL, values);CHKERRQ(ierr2);
+      CHKERRQ(ierr);
+    }
+    PetscFunctionReturn(0);
+  }
   ierr = PetscSectionGetNumFields(section, &numFields);CHKERRQ(ierr);
   if (numFields > 31) SETERRQ1(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "Number of fields %D limited to 31", numFields);
   ierr = PetscMemzero(offsets, 32 * sizeof(PetscInt));CHKERRQ(ierr);
@@ -4698,6 +4960,53 @@ PetscErrorCode DMPlexMatSetClosure(DM dm, PetscSection section, PetscSection glo
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexMatSetClosures"
+/*@C
+  DMPlexMatSetClosures - Set the element matrix on the closure of each cell in a range
+
+  Not collective
+
+  Input Parameters:
++ dm - The DM
+. section - The section describing the layout in v, or NULL to use the default section
+. globalSection - The section describing the global layout, or NULL to use the default global section
+. A - The matrix
+. cStart - The first cell
+. cEnd - One past the last cell
+. csize - The number of values in the closure of each cell
+. values - The element matrices, where the matrix for cell c starts at values[(c-cStart)*csize*csize]
+- mode - The insert mode
+
+  Note: All cells in the range must have closures of size csize
+
+  Level: intermediate
+
+.seealso DMPlexMatSetClosure(), DMPlexVecGetClosures(), DMPlexVecSetClosures()
+@*/
+PetscErrorCode DMPlexMatSetClosures(DM dm, PetscSection section, PetscSection globalSection, Mat A, PetscInt cStart, PetscInt cEnd, PetscInt csize, const PetscScalar values[], InsertMode mode)
+{
+  const PetscInt *dofs;
+  PetscInt        c;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  if (!section) {ierr = DMGetDefaultSection(dm, &section);CHKERRQ(ierr);}
+  PetscValidHeaderSpecific(section, PETSC_SECTION_CLASSID, 2);
+  if (!globalSection) {ierr = DMGetDefaultGlobalSection(dm, &globalSection);CHKERRQ(ierr);}
+  PetscValidHeaderSpecific(globalSection, PETSC_SECTION_CLASSID, 3);
+  PetscValidHeaderSpecific(A, MAT_CLASSID, 4);
+  if (cEnd <= cStart) PetscFunctionReturn(0);
+  PetscValidScalarPointer(values, 8);
+  ierr = DMPlexCheckClosureSizes_Static(dm, section, globalSection, cStart, cEnd, csize, &dofs);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {
+    if (dofs) {ierr = MatSetValues(A, csize, &dofs[(c-cStart)*csize], csize, &dofs[(c-cStart)*csize], &values[(c-cStart)*csize*csize], mode);CHKERRQ(ierr);}
+    else      {ierr = DMPlexMatSetClosure(dm, section, globalSection, A, c, &values[(c-cStart)*csize*csize], mode);CHKERRQ(ierr);}
+  }
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "DMPlexMatSetClosureRefined"
 PetscErrorCode DMPlexMatSetClosureRefined(DM dmf, PetscSection fsection, PetscSection globalFSection, DM dmc, PetscSection csection, PetscSection globalCSection, Mat A, PetscInt point, const PetscScalar values[], InsertMode mode)
@@ -5127,12 +5436,14 @@ PetscErrorCode DMPlexCreatePointNumbering(DM dm, IS *globalPointNumbers)
 {
   IS             nums[4];
   PetscInt       depths[4];
-  PetscInt       depth, d, shift = 0;
+  PetscInt       depth, localDepth, d, shift = 0;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
-  ierr = DMPlexGetDepth(dm, &depth);CHKERRQ(ierr);
+  ierr = DMPlexGetDepth(dm, &localDepth);CHKERRQ(ierr);
+  /* An empty local mesh has depth -1, but every process must create the same strata */
+  ierr = MPI_Allreduce(&localDepth, &depth, 1, MPIU_INT, MPI_MAX, PetscObjectComm((PetscObject) dm));CHKERRQ(ierr);
   /* For unstratified meshes use dim instead of depth */
   if (depth < 0) {ierr = DMGetDimension(dm, &depth);CHKERRQ(ierr);}
   depths[0] = depth; depths[1] = 0;
@@ -0,0 +1,660 @@
+#include <petsc/private/dmpleximpl.h>   /*I      "petscdmplex.h"   I*/
+
+/*
+  Local adaptive refinement of interpolated triangle meshes, red-green style:
+
+  - Every edge of a marked cell is split. A cell with two split edges has its third edge split as well, and this
+    closure is iterated, exchanging edge marks over the point SF, until every cell has 0, 1 or 3 split edges.
+  - Cells with 3 split edges are refined regularly into 4 triangles, cells with 1 split edge are bisected into 2
+    triangles by joining the midpoint to the opposite vertex, and all other cells are copied.
+  - Each new point is a child of exactly one old point, and the children of a point are numbered identically on
+    every process sharing it, since they only depend on the cone of the point and the synchronized edge marks.
+    The refined point SF is therefore obtained by broadcasting the offset of the first child of each root.
+
+  The new mesh is laid out as cells, vertices, then edges, like the uniform refiners. The child offset and count of
+  each old point are stored per new depth d in off[p*3+d] and num[p*3+d].
+*/
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexAdaptSyncMarks_Static"
+/* Make a mark over the chart consistent across processes: the maximum over all copies of each point wins */
+static PetscErrorCode DMPlexAdaptSyncMarks_Static(DM dm, PetscInt marks[])
+{
+  PetscSF        sf;
+  PetscInt       nroots;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMGetPointSF(dm, &sf);CHKERRQ(ierr);
+  ierr = PetscSFGetGraph(sf, &nroots, NULL, NULL, NULL);CHKERRQ(ierr);
+  if (nroots < 0) PetscFunctionReturn(0);
+  ierr = PetscSFReduceBegin(sf, MPIU_INT, marks, marks, MPI_MAX);CHKERRQ(ierr);
+  ierr = PetscSFReduceEnd(sf, MPIU_INT, marks, marks, MPI_MAX);CHKERRQ(ierr);
+  ierr = PetscSFBcastBegin(sf, MPIU_INT, marks, marks);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(sf, MPIU_INT, marks, marks);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* The child of split edge e containing the old vertex v */
+PETSC_STATIC_INLINE PetscInt DMPlexAdaptHalfEdge_Static(const PetscInt off[], const PetscInt num[], const PetscInt cone[], PetscInt e, PetscInt v)
+{
+  if (num[e*3+1] == 1) return off[e*3+1];
+  return off[e*3+1] + (cone[0] == v ? 0 : 1);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexAdaptSetTriangle_Static"
+/* Set the cone of triangle p with vertices verts[] in order, where edge i joins vertex i to vertex i+1 */
+static PetscErrorCode DMPlexAdaptSetTriangle_Static(DM rdm, PetscInt p, const PetscInt verts[], const PetscInt edges[])
+{
+  PetscInt       ornt[3], i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (i = 0; i < 3; ++i) {
+    const PetscInt *cone;
+
+    ierr = DMPlexGetCone(rdm, edges[i], &cone);CHKERRQ(ierr);
+    if      ((cone[0] == verts[i]) && (cone[1] == verts[(i+1)%3])) ornt[i] = 0;
+    else if ((cone[1] == verts[i]) && (cone[0] == verts[(i+1)%3])) ornt[i] = -2;
+    else SETERRQ5(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Edge %D (%D, %D) of cell %D does not start at vertex %D", edges[i], cone[0], cone[1], p, verts[i]);
+  }
+  ierr = DMPlexSetCone(rdm, p, edges);CHKERRQ(ierr);
+  ierr = DMPlexSetConeOrientation(rdm, p, ornt);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexAdaptCreateSF_Static"
+static PetscErrorCode DMPlexAdaptCreateSF_Static(DM dm, const PetscInt off[], const PetscInt num[], DM rdm)
+{
+  PetscSF            sf, sfNew;
+  MPI_Datatype       childType;
+  const PetscInt    *localPoints;
+  const PetscSFNode *remotePoints;
+  PetscInt          *roff, *localNew, *rankNew, *indexNew;
+  PetscSFNode       *remoteNew;
+  PetscInt           numRoots, numLeaves, numLeavesNew = 0, pStart, pEnd, pStartNew, pEndNew, l, n, d, k;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = DMGetPointSF(dm, &sf);CHKERRQ(ierr);
+  ierr = DMGetPointSF(rdm, &sfNew);CHKERRQ(ierr);
+  ierr = PetscSFGetGraph(sf, &numRoots, &numLeaves, &localPoints, &remotePoints);CHKERRQ(ierr);
+  if (numRoots < 0) PetscFunctionReturn(0);
+  ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetChart(rdm, &pStartNew, &pEndNew);CHKERRQ(ierr);
+  ierr = PetscMalloc1((pEnd-pStart)*3, &roff);CHKERRQ(ierr);
+  ierr = MPI_Type_contiguous(3, MPIU_INT, &childType);CHKERRQ(ierr);
+  ierr = MPI_Type_commit(&childType);CHKERRQ(ierr);
+  ierr = PetscSFBcastBegin(sf, childType, off, roff);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(sf, childType, off, roff);CHKERRQ(ierr);
+  ierr = MPI_Type_free(&childType);CHKERRQ(ierr);
+  for (l = 0; l < numLeaves; ++l) {
+    const PetscInt p = localPoints ? localPoints[l] : l;
+
+    for (d = 0; d < 3; ++d) numLeavesNew += num[p*3+d];
+  }
+  ierr = PetscMalloc3(numLeavesNew, &localNew, numLeavesNew, &rankNew, numLeavesNew, &indexNew);CHKERRQ(ierr);
+  for (l = 0, n = 0; l < numLeaves; ++l) {
+    const PetscInt p = localPoints ? localPoints[l] : l;
+
+    for (d = 0; d < 3; ++d) {
+      for (k = 0; k < num[p*3+d]; ++k, ++n) {
+        localNew[n] = off[p*3+d] + k;
+        rankNew[n]  = remotePoints[l].rank;
+        indexNew[n] = roff[p*3+d] + k;
+      }
+    }
+  }
+  ierr = PetscSortIntWithArrayPair(numLeavesNew, localNew, rankNew, indexNew);CHKERRQ(ierr);
+  ierr = PetscMalloc1(numLeavesNew, &remoteNew);CHKERRQ(ierr);
+  for (n = 0; n < numLeavesNew; ++n) {
+    remoteNew[n].rank  = rankNew[n];
+    remoteNew[n].index = indexNew[n];
+  }
+  ierr = PetscSFSetGraph(sfNew, pEndNew-pStartNew, numLeavesNew, localNew, PETSC_COPY_VALUES, remoteNew, PETSC_OWN_POINTER);CHKERRQ(ierr);
+  ierr = PetscFree3(localNew, rankNew, indexNew);CHKERRQ(ierr);
+  ierr = PetscFree(roff);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexAdaptSetCoordinates_Static"
+static PetscErrorCode DMPlexAdaptSetCoordinates_Static(DM dm, const PetscInt off[], const PetscInt num[], DM rdm)
+{
+  DM             cdmNew;
+  PetscSF        sfNew;
+  PetscSection   coordSection, coordSectionNew;
+  Vec            coordinates, coordinatesNew;
+  PetscScalar   *coords, *coordsNew;
+  PetscInt       spaceDim, bs, coordSizeNew, vStart, vEnd, eStart, eEnd, vStartNew, vEndNew, v, e, d;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMPlexGetDepthStratum(dm, 0, &vStart, &vEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetDepthStratum(dm, 1, &eStart, &eEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetDepthStratum(rdm, 0, &vStartNew, &vEndNew);CHKERRQ(ierr);
+  ierr = DMGetCoordinateSection(dm, &coordSection);CHKERRQ(ierr);
+  ierr = PetscSectionGetFieldComponents(coordSection, 0, &spaceDim);CHKERRQ(ierr);
+  ierr = PetscSectionCreate(PetscObjectComm((PetscObject) dm), &coordSectionNew);CHKERRQ(ierr);
+  ierr = PetscSectionSetNumFields(coordSectionNew, 1);CHKERRQ(ierr);
+  ierr = PetscSectionSetFieldComponents(coordSectionNew, 0, spaceDim);CHKERRQ(ierr);
+  ierr = PetscSectionSetChart(coordSectionNew, vStartNew, vEndNew);CHKERRQ(ierr);
+  for (v = vStartNew; v < vEndNew; ++v) {
+    ierr = PetscSectionSetDof(coordSectionNew, v, spaceDim);CHKERRQ(ierr);
+    ierr = PetscSectionSetFieldDof(coordSectionNew, v, 0, spaceDim);CHKERRQ(ierr);
+  }
+  ierr = PetscSectionSetUp(coordSectionNew);CHKERRQ(ierr);
+  ierr = DMSetCoordinateSection(rdm, PETSC_DETERMINE, coordSectionNew);CHKERRQ(ierr);
+  ierr = PetscSectionDestroy(&coordSectionNew);CHKERRQ(ierr);
+  ierr = DMGetCoordinateSection(rdm, &coordSectionNew);CHKERRQ(ierr);
+  ierr = DMGetCoordinatesLocal(dm, &coordinates);CHKERRQ(ierr);
+  ierr = PetscSectionGetStorageSize(coordSectionNew, &coordSizeNew);CHKERRQ(ierr);
+  ierr = VecCreate(PETSC_COMM_SELF, &coordinatesNew);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) coordinatesNew, "coordinates");CHKERRQ(ierr);
+  ierr = VecSetSizes(coordinatesNew, coordSizeNew, PETSC_DETERMINE);CHKERRQ(ierr);
+  ierr = VecGetBlockSize(coordinates, &bs);CHKERRQ(ierr);
+  ierr = VecSetBlockSize(coordinatesNew, bs);CHKERRQ(ierr);
+  ierr = VecSetType(coordinatesNew, VECSTANDARD);CHKERRQ(ierr);
+  ierr = VecGetArray(coordinates, &coords);CHKERRQ(ierr);
+  ierr = VecGetArray(coordinatesNew, &coordsNew);CHKERRQ(ierr);
+  /* Old vertices keep their coordinates */
+  for (v = vStart; v < vEnd; ++v) {
+    PetscInt o, onew;
+
+    ierr = PetscSectionGetOffset(coordSection, v, &o);CHKERRQ(ierr);
+    ierr = PetscSectionGetOffset(coordSectionNew, off[v*3+0], &onew);CHKERRQ(ierr);
+    for (d = 0; d < spaceDim; ++d) coordsNew[onew+d] = coords[o+d];
+  }
+  /* Edge vertices sit at the midpoint */
+  for (e = eStart; e < eEnd; ++e) {
+    const PetscInt *cone;
+    PetscInt        o0, o1, onew;
+
+    if (!num[e*3+0]) continue;
+    ierr = DMPlexGetCone(dm, e, &cone);CHKERRQ(ierr);
+    ierr = PetscSectionGetOffset(coordSection, cone[0], &o0);CHKERRQ(ierr);
+    ierr = PetscSectionGetOffset(coordSection, cone[1], &o1);CHKERRQ(ierr);
+    ierr = PetscSectionGetOffset(coordSectionNew, off[e*3+0], &onew);CHKERRQ(ierr);
+    for (d = 0; d < spaceDim; ++d) coordsNew[onew+d] = 0.5*(coords[o0+d] + coords[o1+d]);
+  }
+  ierr = VecRestoreArray(coordinates, &coords);CHKERRQ(ierr);
+  ierr = VecRestoreArray(coordinatesNew, &coordsNew);CHKERRQ(ierr);
+  ierr = DMSetCoordinatesLocal(rdm, coordinatesNew);CHKERRQ(ierr);
+  ierr = VecDestroy(&coordinatesNew);CHKERRQ(ierr);
+  ierr = DMGetPointSF(rdm, &sfNew);CHKERRQ(ierr);
+  ierr = DMGetCoordinateDM(rdm, &cdmNew);CHKERRQ(ierr);
+  ierr = DMSetPointSF(cdmNew, sfNew);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexAdaptCreateLabels_Static"
+/* Every child inherits the label values of its parent */
+static PetscErrorCode DMPlexAdaptCreateLabels_Static(DM dm, const PetscInt off[], const PetscInt num[], DM rdm)
+{
+  PetscInt       numLabels, l;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMPlexGetNumLabels(dm, &numLabels);CHKERRQ(ierr);
+  for (l = 0; l < numLabels; ++l) {
+    DMLabel         label, labelNew;
+    const char     *lname;
+    PetscBool       isDepth;
+    IS              valueIS;
+    const PetscInt *values;
+    PetscInt        numValues, val;
+
+    ierr = DMPlexGetLabelName(dm, l, &lname);CHKERRQ(ierr);
+    ierr = PetscStrcmp(lname, "depth", &isDepth);CHKERRQ(ierr);
+    if (isDepth) continue;
+    ierr = DMPlexCreateLabel(rdm, lname);CHKERRQ(ierr);
+    ierr = DMPlexGetLabel(dm, lname, &label);CHKERRQ(ierr);
+    ierr = DMPlexGetLabel(rdm, lname, &labelNew);CHKERRQ(ierr);
+    ierr = DMLabelGetValueIS(label, &valueIS);CHKERRQ(ierr);
+    ierr = ISGetLocalSize(valueIS, &numValues);CHKERRQ(ierr);
+    ierr = ISGetIndices(valueIS, &values);CHKERRQ(ierr);
+    for (val = 0; val < numValues; ++val) {
+      IS              pointIS;
+      const PetscInt *points;
+      PetscInt        numPoints, n, d, k;
+
+      ierr = DMLabelGetStratumIS(label, values[val], &pointIS);CHKERRQ(ierr);
+      ierr = ISGetLocalSize(pointIS, &numPoints);CHKERRQ(ierr);
+      ierr = ISGetIndices(pointIS, &points);CHKERRQ(ierr);
+      for (n = 0; n < numPoints; ++n) {
+        const PetscInt p = points[n];
+
+        for (d = 0; d < 3; ++d) {
+          for (k = 0; k < num[p*3+d]; ++k) {ierr = DMLabelSetValue(labelNew, off[p*3+d]+k, values[val]);CHKERRQ(ierr);}
+        }
+      }
+      ierr = ISRestoreIndices(pointIS, &points);CHKERRQ(ierr);
+      ierr = ISDestroy(&pointIS);CHKERRQ(ierr);
+    }
+    ierr = ISRestoreIndices(valueIS, &values);CHKERRQ(ierr);
+    ierr = ISDestroy(&valueIS);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexAdaptRefine_Static"
+/* Refine the cells c with cmarks[c-cStart] set, which must be consistent across processes */
+static PetscErrorCode DMPlexAdaptRefine_Static(DM dm, const PetscInt cmarks[], DM *dmRefined)
+{
+  MPI_Comm       comm;
+  DM             rdm;
+  DM_Plex       *rmesh;
+  PetscInt      *emarks, *off, *num, *parents;
+  PetscInt       dim, depth, pStart, pEnd, cStart, cEnd, eStart, eEnd, vStart, vEnd, cMax, c, e, v, d;
+  PetscInt       numCellsNew = 0, numVertsNew, numEdgesNew = 0, cOff, vOff, eOff, changed;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject) dm, &comm);CHKERRQ(ierr);
+  ierr = DMGetDimension(dm, &dim);CHKERRQ(ierr);
+  ierr = DMPlexGetDepth(dm, &depth);CHKERRQ(ierr);
+  if (dim != 2) SETERRQ1(comm, PETSC_ERR_SUP, "Adaptive refinement is only implemented for triangles, not dimension %D", dim);
+  if (depth != dim) SETERRQ(comm, PETSC_ERR_ARG_WRONG, "Mesh must be interpolated for adaptive refinement");
+  ierr = DMPlexGetHybridBounds(dm, &cMax, NULL, NULL, NULL);CHKERRQ(ierr);
+  if (cMax >= 0) SETERRQ(comm, PETSC_ERR_SUP, "Adaptive refinement of hybrid meshes is not supported");
+  ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetDepthStratum(dm, 1, &eStart, &eEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetDepthStratum(dm, 0, &vStart, &vEnd);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {
+    PetscInt coneSize;
+
+    ierr = DMPlexGetConeSize(dm, c, &coneSize);CHKERRQ(ierr);
+    if (coneSize != 3) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_SUP, "Adaptive refinement is only implemented for triangles, cell %D has cone size %D", c, coneSize);
+  }
+  /* Mark edges, closing the marking so that each cell has 0, 1 or 3 split edges */
+  ierr = PetscCalloc1(pEnd-pStart, &emarks);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {
+    const PetscInt *cone;
+
+    if (!cmarks[c-cStart]) continue;
+    ierr = DMPlexGetCone(dm, c, &cone);CHKERRQ(ierr);
+    for (d = 0; d < 3; ++d) emarks[cone[d]] = 1;
+  }
+  do {
+    PetscInt lchanged = 0;
+
+    ierr = DMPlexAdaptSyncMarks_Static(dm, emarks);CHKERRQ(ierr);
+    for (c = cStart; c < cEnd; ++c) {
+      const PetscInt *cone;
+
+      ierr = DMPlexGetCone(dm, c, &cone);CHKERRQ(ierr);
+      if (emarks[cone[0]] + emarks[cone[1]] + emarks[cone[2]] == 2) {
+        for (d = 0; d < 3; ++d) emarks[cone[d]] = 1;
+        lchanged = 1;
+      }
+    }
+    ierr = MPI_Allreduce(&lchanged, &changed, 1, MPIU_INT, MPI_MAX, comm);CHKERRQ(ierr);
+  } while (changed);
+  /* Count and number children: cells, then vertices, then edges */
+  ierr = PetscCalloc2((pEnd-pStart)*3, &off, (pEnd-pStart)*3, &num);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {
+    const PetscInt *cone;
+    PetscInt        n;
+
+    ierr = DMPlexGetCone(dm, c, &cone);CHKERRQ(ierr);
+    n    = emarks[cone[0]] + emarks[cone[1]] + emarks[cone[2]];
+    num[c*3+2] = n == 3 ? 4 : n+1;
+    num[c*3+1] = n;
+    numCellsNew += num[c*3+2];
+  }
+  for (v = vStart; v < vEnd; ++v) num[v*3+0] = 1;
+  numVertsNew = vEnd - vStart;
+  for (e = eStart; e < eEnd; ++e) {
+    num[e*3+0]   = emarks[e];
+    num[e*3+1]   = emarks[e] + 1;
+    numVertsNew += num[e*3+0];
+    numEdgesNew += num[e*3+1];
+  }
+  for (c = cStart; c < cEnd; ++c) numEdgesNew += num[c*3+1];
+  cOff = 0;
+  vOff = numCellsNew;
+  eOff = numCellsNew + numVertsNew;
+  for (c = cStart; c < cEnd; ++c) {off[c*3+2] = cOff; cOff += num[c*3+2];}
+  for (v = vStart; v < vEnd; ++v) {off[v*3+0] = vOff; vOff += num[v*3+0];}
+  for (e = eStart; e < eEnd; ++e) {off[e*3+0] = vOff; vOff += num[e*3+0];}
+  for (e = eStart; e < eEnd; ++e) {off[e*3+1] = eOff; eOff += num[e*3+1];}
+  for (c = cStart; c < cEnd; ++c) {off[c*3+1] = eOff; eOff += num[c*3+1];}
+  /* Create topology */
+  ierr = DMCreate(comm, &rdm);CHKERRQ(ierr);
+  ierr = DMSetType(rdm, DMPLEX);CHKERRQ(ierr);
+  ierr = DMSetDimension(rdm, dim);CHKERRQ(ierr);
+  ierr = DMPlexSetChart(rdm, 0, eOff);CHKERRQ(ierr);
+  for (c = 0; c < numCellsNew; ++c) {ierr = DMPlexSetConeSize(rdm, c, 3);CHKERRQ(ierr);}
+  for (e = numCellsNew+numVertsNew; e < eOff; ++e) {ierr = DMPlexSetConeSize(rdm, e, 2);CHKERRQ(ierr);}
+  ierr = DMSetUp(rdm);CHKERRQ(ierr);
+  for (e = eStart; e < eEnd; ++e) {
+    const PetscInt *cone;
+    PetscInt        coneNew[2];
+
+    ierr = DMPlexGetCone(dm, e, &cone);CHKERRQ(ierr);
+    if (emarks[e]) {
+      coneNew[0] = off[cone[0]*3+0]; coneNew[1] = off[e*3+0];
+      ierr = DMPlexSetCone(rdm, off[e*3+1]+0, coneNew);CHKERRQ(ierr);
+      coneNew[0] = off[e*3+0];       coneNew[1] = off[cone[1]*3+0];
+      ierr = DMPlexSetCone(rdm, off[e*3+1]+1, coneNew);CHKERRQ(ierr);
+    } else {
+      coneNew[0] = off[cone[0]*3+0]; coneNew[1] = off[cone[1]*3+0];
+      ierr = DMPlexSetCone(rdm, off[e*3+1], coneNew);CHKERRQ(ierr);
+    }
+  }
+  for (c = cStart; c < cEnd; ++c) {
+    const PetscInt *cone, *ornt, *econe[3];
+    PetscInt        V[3], NV[3], verts[3], edges[3], coneNew[2], n, i;
+
+    ierr = DMPlexGetCone(dm, c, &cone);CHKERRQ(ierr);
+    ierr = DMPlexGetConeOrientation(dm, c, &ornt);CHKERRQ(ierr);
+    for (i = 0; i < 3; ++i) {
+      ierr  = DMPlexGetCone(dm, cone[i], &econe[i]);CHKERRQ(ierr);
+      V[i]  = ornt[i] < 0 ? econe[i][1] : econe[i][0];
+      NV[i] = off[V[i]*3+0];
+    }
+    n = num[c*3+1];
+    if (n == 0) {
+      for (i = 0; i < 3; ++i) edges[i] = off[cone[i]*3+1];
+      ierr = DMPlexAdaptSetTriangle_Static(rdm, off[c*3+2], NV, edges);CHKERRQ(ierr);
+    } else if (n == 1) {
+      /* Bisect from the midpoint m of the split edge i to the opposite vertex w */
+      PetscInt m, w, f;
+
+      for (i = 0; i < 3; ++i) if (emarks[cone[i]]) break;
+      m = off[cone[i]*3+0];
+      w = NV[(i+2)%3];
+      f = off[c*3+1];
+      coneNew[0] = m; coneNew[1] = w;
+      ierr = DMPlexSetCone(rdm, f, coneNew);CHKERRQ(ierr);
+      verts[0] = NV[i]; verts[1] = m; verts[2] = w;
+      edges[0] = DMPlexAdaptHalfEdge_Static(off, num, econe[i], cone[i], V[i]);
+      edges[1] = f;
+      edges[2] = off[cone[(i+2)%3]*3+1];
+      ierr = DMPlexAdaptSetTriangle_Static(rdm, off[c*3+2]+0, verts, edges);CHKERRQ(ierr);
+      verts[0] = m; verts[1] = NV[(i+1)%3]; verts[2] = w;
+      edges[0] = DMPlexAdaptHalfEdge_Static(off, num, econe[i], cone[i], V[(i+1)%3]);
+      edges[1] = off[cone[(i+1)%3]*3+1];
+      edges[2] = f;
+      ierr = DMPlexAdaptSetTriangle_Static(rdm, off[c*3+2]+1, verts, edges);CHKERRQ(ierr);
+    } else {
+      /* Regular refinement: corner triangles at each vertex and the middle triangle */
+      PetscInt M[3], F[3];
+
+      for (i = 0; i < 3; ++i) {M[i] = off[cone[i]*3+0]; F[i] = off[c*3+1]+i;}
+      coneNew[0] = M[2]; coneNew[1] = M[0];
+      ierr = DMPlexSetCone(rdm, F[0], coneNew);CHKERRQ(ierr);
+      coneNew[0] = M[0]; coneNew[1] = M[1];
+      ierr = DMPlexSetCone(rdm, F[1], coneNew);CHKERRQ(ierr);
+      coneNew[0] = M[1]; coneNew[1] = M[2];
+      ierr = DMPlexSetCone(rdm, F[2], coneNew);CHKERRQ(ierr);
+      verts[0] = NV[0]; verts[1] = M[0]; verts[2] = M[2];
+      edges[0] = DMPlexAdaptHalfEdge_Static(off, num, econe[0], cone[0], V[0]);
+      edges[1] = F[0];
+      edges[2] = DMPlexAdaptHalfEdge_Static(off, num, econe[2], cone[2], V[0]);
+      ierr = DMPlexAdaptSetTriangle_Static(rdm, off[c*3+2]+0, verts, edges);CHKERRQ(ierr);
+      verts[0] = M[0]; verts[1] = NV[1]; verts[2] = M[1];
+      edges[0] = DMPlexAdaptHalfEdge_Static(off, num, econe[0], cone[0], V[1]);
+      edges[1] = DMPlexAdaptHalfEdge_Static(off, num, econe[1], cone[1], V[1]);
+      edges[2] = F[1];
+      ierr = DMPlexAdaptSetTriangle_Static(rdm, off[c*3+2]+1, verts, edges);CHKERRQ(ierr);
+      verts[0] = M[2]; verts[1] = M[1]; verts[2] = NV[2];
+      edges[0] = F[2];
+      edges[1] = DMPlexAdaptHalfEdge_Static(off, num, econe[1], cone[1], V[2]);
+      edges[2] = DMPlexAdaptHalfEdge_Static(off, num, econe[2], cone[2], V[2]);
+      ierr = DMPlexAdaptSetTriangle_Static(rdm, off[c*3+2]+2, verts, edges);CHKERRQ(ierr);
+      verts[0] = M[0]; verts[1] = M[1]; verts[2] = M[2];
+      edges[0] = F[1]; edges[1] = F[2]; edges[2] = F[0];
+      ierr = DMPlexAdaptSetTriangle_Static(rdm, off[c*3+2]+3, verts, edges);CHKERRQ(ierr);
+    }
+  }
+  ierr = DMPlexSymmetrize(rdm);CHKERRQ(ierr);
+  ierr = DMPlexStratify(rdm);CHKERRQ(ierr);
+  ierr = DMPlexAdaptCreateSF_Static(dm, off, num, rdm);CHKERRQ(ierr);
+  ierr = DMPlexAdaptSetCoordinates_Static(dm, off, num, rdm);CHKERRQ(ierr);
+  ierr = DMPlexAdaptCreateLabels_Static(dm, off, num, rdm);CHKERRQ(ierr);
+  /* Remember the parent of each new cell for coarsening */
+  ierr = PetscMalloc1(numCellsNew, &parents);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {
+    PetscInt k;
+
+    for (k = 0; k < num[c*3+2]; ++k) parents[off[c*3+2]+k] = c;
+  }
+  rmesh = (DM_Plex *) rdm->data;
+  ierr  = ISCreateGeneral(PETSC_COMM_SELF, numCellsNew, parents, PETSC_OWN_POINTER, &rmesh->adaptParents);CHKERRQ(ierr);
+  ierr  = DMLabelCreate("adapt", &rmesh->adaptMarker);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {
+    if (cmarks[c-cStart]) {ierr = DMLabelSetValue(rmesh->adaptMarker, c, DMPLEX_ADAPT_REFINE);CHKERRQ(ierr);}
+  }
+  ierr = DMPlexSetCoarseDM(rdm, dm);CHKERRQ(ierr);
+  ierr = DMPlexCopyBoundary(dm, rdm);CHKERRQ(ierr);
+  rmesh->adaptRebalanceThreshold = ((DM_Plex *) dm->data)->adaptRebalanceThreshold;
+  ierr = PetscFree(emarks);CHKERRQ(ierr);
+  ierr = PetscFree2(off, num);CHKERRQ(ierr);
+  *dmRefined = rdm;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexAdaptRebalance_Static"
+/* Incrementally rebalance the mesh if the ratio of the largest to the mean local cell count exceeds the threshold */
+static PetscErrorCode DMPlexAdaptRebalance_Static(DM *dm)
+{
+  DM_Plex       *mesh = (DM_Plex *) (*dm)->data;
+  MPI_Comm       comm;
+  DM             dmBalanced = NULL;
+  PetscMPIInt    numProcs;
+  PetscInt       cStart, cEnd, numCells, maxCells, sumCells;
+  PetscReal      imbalance;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (mesh->adaptRebalanceThreshold <= 0.0) PetscFunctionReturn(0);
+  ierr = PetscObjectGetComm((PetscObject) *dm, &comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm, &numProcs);CHKERRQ(ierr);
+  if (numProcs == 1) PetscFunctionReturn(0);
+  ierr = DMPlexGetHeightStratum(*dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  numCells = cEnd - cStart;
+  ierr = MPI_Allreduce(&numCells, &maxCells, 1, MPIU_INT, MPI_MAX, comm);CHKERRQ(ierr);
+  ierr = MPI_Allreduce(&numCells, &sumCells, 1, MPIU_INT, MPI_SUM, comm);CHKERRQ(ierr);
+  imbalance = sumCells ? ((PetscReal) maxCells*numProcs)/sumCells : 1.0;
+  ierr = PetscInfo2(*dm, "Cell imbalance %g after adaptation, threshold %g\n", (double) imbalance, (double) mesh->adaptRebalanceThreshold);CHKERRQ(ierr);
+  if (imbalance <= mesh->adaptRebalanceThreshold) PetscFunctionReturn(0);
+  ierr = DMPlexRebalance(*dm, NULL, NULL, &dmBalanced);CHKERRQ(ierr);
+  if (dmBalanced) {
+    ierr = DMPlexSetAdaptRebalanceThreshold(dmBalanced, mesh->adaptRebalanceThreshold);CHKERRQ(ierr);
+    ierr = DMDestroy(dm);CHKERRQ(ierr);
+    *dm  = dmBalanced;
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexAdaptLabel"
+/*@
+  DMPlexAdaptLabel - Locally refine or coarsen a distributed mesh according to a cell marker, without gathering it
+
+  Collective on DM
+
+  Input Parameters:
++ dm         - The DMPlex object, an interpolated triangle mesh
+- adaptLabel - A DMLabel marking cells with DMPLEX_ADAPT_REFINE or DMPLEX_ADAPT_COARSEN
+
+  Output Parameter:
+. dmAdapted - The adapted mesh, or NULL if no cell was marked
+
+  Notes:
+  Marked cells are refined regularly, and a red-green closure bisects neighboring cells so that the result is
+  conforming. The closure is computed in parallel, and the point SF of the new mesh is derived from the old one, so
+  that the mesh is never redistributed to refine it.
+
+  A cell marked for coarsening is merged back into its parent in the mesh given by DMPlexGetCoarseDM(), when all its
+  sibling cells are also marked. This is only possible for a mesh produced by DMPlexAdaptLabel(), and only undoes the
+  last adaptation. A single call cannot both refine and coarsen.
+
+  When DMPlexSetAdaptRebalanceThreshold() was given a positive threshold, the adapted mesh is redistributed with the
+  PetscPartitioner once the ratio of the largest to the mean number of local cells exceeds it. The redistributed mesh
+  no longer remembers its coarse mesh.
+
+  Level: intermediate
+
+.seealso: DMPlexGetAdaptParents(), DMPlexSetAdaptRebalanceThreshold(), DMPlexGetCoarseDM(), DMRefine()
+@*/
+PetscErrorCode DMPlexAdaptLabel(DM dm, DMLabel adaptLabel, DM *dmAdapted)
+{
+  DM_Plex       *mesh = (DM_Plex *) dm->data;
+  MPI_Comm       comm;
+  PetscInt      *marks;
+  PetscInt       pStart, pEnd, cStart, cEnd, c, lcount[2], gcount[2];
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  PetscValidPointer(adaptLabel, 2);
+  PetscValidPointer(dmAdapted, 3);
+  ierr = PetscObjectGetComm((PetscObject) dm, &comm);CHKERRQ(ierr);
+  *dmAdapted = NULL;
+  ierr = PetscLogEventBegin(DMPLEX_Adapt,dm,0,0,0);CHKERRQ(ierr);
+  ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  ierr = PetscCalloc1(pEnd-pStart, &marks);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {
+    PetscInt val;
+
+    ierr = DMLabelGetValue(adaptLabel, c, &val);CHKERRQ(ierr);
+    if (val == DMPLEX_ADAPT_REFINE || val == DMPLEX_ADAPT_COARSEN) marks[c] = val;
+  }
+  ierr = DMPlexAdaptSyncMarks_Static(dm, marks);CHKERRQ(ierr);
+  lcount[0] = lcount[1] = 0;
+  for (c = cStart; c < cEnd; ++c) {
+    if (marks[c] == DMPLEX_ADAPT_REFINE)  ++lcount[0];
+    if (marks[c] == DMPLEX_ADAPT_COARSEN) ++lcount[1];
+  }
+  ierr = MPI_Allreduce(lcount, gcount, 2, MPIU_INT, MPI_SUM, comm);CHKERRQ(ierr);
+  if (gcount[0] && gcount[1]) SETERRQ(comm, PETSC_ERR_ARG_WRONG, "Cannot refine and coarsen in the same adaptation");
+  if (gcount[0]) {
+    for (c = cStart; c < cEnd; ++c) marks[c-cStart] = marks[c] == DMPLEX_ADAPT_REFINE ? 1 : 0;
+    ierr = DMPlexAdaptRefine_Static(dm, marks, dmAdapted);CHKERRQ(ierr);
+  } else if (gcount[1]) {
+    DM              cdm = mesh->coarseMesh;
+    PetscInt       *cmarks;
+    const PetscInt *parents;
+    PetscInt        cpStart, cpEnd, ccStart, ccEnd, numParents, gcmarks;
+
+    if (!cdm || !mesh->adaptParents || !mesh->adaptMarker) SETERRQ(comm, PETSC_ERR_ARG_WRONGSTATE, "Coarsening requires a mesh created by DMPlexAdaptLabel()");
+    ierr = DMPlexGetChart(cdm, &cpStart, &cpEnd);CHKERRQ(ierr);
+    ierr = DMPlexGetHeightStratum(cdm, 0, &ccStart, &ccEnd);CHKERRQ(ierr);
+    ierr = PetscCalloc1(cpEnd-cpStart, &cmarks);CHKERRQ(ierr);
+    /* A refined parent is kept refined if any of its children, on any process, is not marked for coarsening */
+    ierr = ISGetLocalSize(mesh->adaptParents, &numParents);CHKERRQ(ierr);
+    if (numParents != cEnd-cStart) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Number of cell parents %D != %D number of cells", numParents, cEnd-cStart);
+    ierr = ISGetIndices(mesh->adaptParents, &parents);CHKERRQ(ierr);
+    for (c = cStart; c < cEnd; ++c) if (marks[c] != DMPLEX_ADAPT_COARSEN) cmarks[parents[c-cStart]] = 1;
+    ierr = ISRestoreIndices(mesh->adaptParents, &parents);CHKERRQ(ierr);
+    ierr = DMPlexAdaptSyncMarks_Static(cdm, cmarks);CHKERRQ(ierr);
+    lcount[0] = 0;
+    for (c = ccStart; c < ccEnd; ++c) {
+      PetscBool refined;
+
+      ierr = DMLabelStratumHasPoint(mesh->adaptMarker, DMPLEX_ADAPT_REFINE, c, &refined);CHKERRQ(ierr);
+      cmarks[c-ccStart] = refined && cmarks[c] ? 1 : 0;
+      lcount[0]        += cmarks[c-ccStart];
+    }
+    ierr = MPI_Allreduce(&lcount[0], &gcmarks, 1, MPIU_INT, MPI_SUM, comm);CHKERRQ(ierr);
+    if (gcmarks) {
+      ierr = DMPlexAdaptRefine_Static(cdm, cmarks, dmAdapted);CHKERRQ(ierr);
+    } else {
+      ierr = PetscObjectReference((PetscObject) cdm);CHKERRQ(ierr);
+      *dmAdapted = cdm;
+    }
+    ierr = PetscFree(cmarks);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(marks);CHKERRQ(ierr);
+  if (*dmAdapted) {ierr = DMPlexAdaptRebalance_Static(dmAdapted);CHKERRQ(ierr);}
+  ierr = PetscLogEventEnd(DMPLEX_Adapt,dm,0,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexGetAdaptParents"
+/*@
+  DMPlexGetAdaptParents - Get the cell of the coarse mesh from which each cell was created by DMPlexAdaptLabel()
+
+  Not collective
+
+  Input Parameter:
+. dm - The DMPlex object
+
+  Output Parameter:
+. parents - The IS of coarse cells, indexed by cell, or NULL if the mesh was not created by DMPlexAdaptLabel()
+
+  Level: advanced
+
+.seealso: DMPlexAdaptLabel(), DMPlexGetCoarseDM()
+@*/
+PetscErrorCode DMPlexGetAdaptParents(DM dm, IS *parents)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  PetscValidPointer(parents, 2);
+  *parents = ((DM_Plex *) dm->data)->adaptParents;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexSetAdaptRebalanceThreshold"
+/*@
+  DMPlexSetAdaptRebalanceThreshold - Set the cell imbalance above which DMPlexAdaptLabel() redistributes the mesh
+
+  Logically collective on DM
+
+  Input Parameters:
++ dm        - The DMPlex object
+- threshold - The largest tolerated ratio of the maximum to the mean number of local cells, or 0 to never redistribute
+
+  Options Database Key:
+. -dm_plex_adapt_rebalance_threshold <ratio> - Set the threshold
+
+  Level: intermediate
+
+.seealso: DMPlexGetAdaptRebalanceThreshold(), DMPlexAdaptLabel(), DMPlexDistribute()
+@*/
+PetscErrorCode DMPlexSetAdaptRebalanceThreshold(DM dm, PetscReal threshold)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  PetscValidLogicalCollectiveReal(dm, threshold, 2);
+  ((DM_Plex *) dm->data)->adaptRebalanceThreshold = threshold;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexGetAdaptRebalanceThreshold"
+/*@
+  DMPlexGetAdaptRebalanceThreshold - Get the cell imbalance above which DMPlexAdaptLabel() redistributes the mesh
+
+  Not collective
+
+  Input Parameter:
+. dm - The DMPlex object
+
+  Output Parameter:
+. threshold - The largest tolerated ratio of the maximum to the mean number of local cells, or 0 to never redistribute
+
+  Level: intermediate
+
+.seealso: DMPlexSetAdaptRebalanceThreshold(), DMPlexAdaptLabel()
+@*/
+PetscErrorCode DMPlexGetAdaptRebalanceThreshold(DM dm, PetscReal *threshold)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  PetscValidPointer(threshold, 2);
+  *threshold = ((DM_Plex *) dm->data)->adaptRebalanceThreshold;
+  PetscFunctionReturn(0);
+}
@@ -1116,6 +1116,14 @@ PetscErrorCode  DMSetFromOptions_NonRefinement_Plex(PetscOptions *PetscOptionsOb
   ierr = PetscOptionsReal("-dm_plex_print_tol", "Tolerance for FEM output", "DMView", mesh->printTol, &mesh->printTol, NULL);CHKERRQ(ierr);
   /* Projection behavior */
   ierr = PetscOptionsInt("-dm_plex_max_projection_height", "Maxmimum mesh point height used to project locally", "DMPlexSetMaxProjectionHeight", 0, &mesh->maxProjectionHeight, NULL);CHKERRQ(ierr);
+  /* Reordering after distribution */
+  ierr = PetscOptionsEnum("-dm_plex_reorder", "Reordering of local mesh points after distribution", "DMPlexSetReorderType", DMPlexReorderTypes, (PetscEnum) mesh->reorderType, (PetscEnum *) &mesh->reorderType, NULL);CHKERRQ(ierr);
+  /* Adaptation */
+  ierr = PetscOptionsReal("-dm_plex_adapt_rebalance_threshold", "Redistribute an adapted mesh when the ratio of largest to mean cell count exceeds this", "DMPlexSetAdaptRebalanceThreshold", mesh->adaptRebalanceThreshold, &mesh->adaptRebalanceThreshold, NULL);CHKERRQ(ierr);
+  /* Partitioning */
+  ierr = PetscPartitionerSetFromOptions(mesh->partitioner);CHKERRQ(ierr);
+  /* Closure behavior */
+  ierr = PetscOptionsBool("-dm_plex_closure_dof_index", "Index the dofs in the closure of each cell", "DMPlexSetUseClosureDofIndex", mesh->closureDofIndex, &mesh->closureDofIndex, NULL);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1310,6 +1318,11 @@ PETSC_EXTERN PetscErrorCode DMCreate_Plex(DM dm)
   mesh->triangleOpts = NULL;
   ierr = PetscPartitionerCreate(PetscObjectComm((PetscObject)dm), &mesh->partitioner);CHKERRQ(ierr);
   ierr = PetscPartitionerSetTypeFromOptions_Internal(mesh->partitioner);CHKERRQ(ierr);
+  mesh->reorderType  = DMPLEX_REORDER_NONE;
+
+  mesh->adaptMarker             = NULL;
+  mesh->adaptParents            = NULL;
+  mesh->adaptRebalanceThreshold = 0.0;
 
   mesh->subpointMap = NULL;
 
@@ -1338,6 +1351,8 @@ PETSC_EXTERN PetscErrorCode DMCreate_Plex(DM dm)
 
   mesh->maxProjectionHeight = 0;
 
+  mesh->closureDofIndex = PETSC_FALSE;
+
   mesh->printSetValues = PETSC_FALSE;
   mesh->printFEM       = 0;
   mesh->printTol       = 1.0e-10;
@@ -1492,7 +1507,7 @@ $        3
 
   Level: beginner
 
-.seealso: DMPlexCreateFromDAG(), DMPlexCreate()
+.seealso: DMPlexCreateFromCellListParallel(), DMPlexCreateFromDAG(), DMPlexCreate()
 @*/
 PetscErrorCode DMPlexCreateFromCellList(MPI_Comm comm, PetscInt dim, PetscInt numCells, PetscInt numVertices, PetscInt numCorners, PetscBool interpolate, const int cells[], PetscInt spaceDim, const double vertexCoords[], DM *dm)
 {
@@ -1514,6 +1529,361 @@ PetscErrorCode DMPlexCreateFromCellList(MPI_Comm comm, PetscInt dim, PetscInt nu
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexBuildFromCellListParallel_Private"
+/*
+  This takes as input the common mesh generator output, a list of the vertices for each cell, but with global vertex numbers.
+  The vertices are divided into contiguous slabs, one per process, and the vertex SF maps the local vertices to the slabs.
+*/
+PetscErrorCode DMPlexBuildFromCellListParallel_Private(DM dm, PetscInt numCells, PetscInt numVertices, PetscInt numCorners, const int cells[], PetscSF *sfVert)
+{
+  MPI_Comm        comm;
+  PetscSF         sfPoint;
+  PetscLayout     vLayout;
+  PetscSFNode    *remoteVerticesAdj, *vertexLocal, *vertexOwner, *remoteVertices;
+  const PetscInt *vrange;
+  PetscInt       *verts, *cone, *localVertices, numVerticesAdj, numLeaves, c, p, v;
+  PetscMPIInt     rank, numProcs;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject) dm, &comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm, &rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm, &numProcs);CHKERRQ(ierr);
+  ierr = PetscLayoutCreate(comm, &vLayout);CHKERRQ(ierr);
+  ierr = PetscLayoutSetLocalSize(vLayout, numVertices);CHKERRQ(ierr);
+  ierr = PetscLayoutSetBlockSize(vLayout, 1);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(vLayout);CHKERRQ(ierr);
+  ierr = PetscLayoutGetRanges(vLayout, &vrange);CHKERRQ(ierr);
+  /* Find the vertices referenced by the local cells, these are numbered after the cells in their global order */
+  ierr = PetscMalloc1(numCells*numCorners, &verts);CHKERRQ(ierr);
+  for (p = 0; p < numCells*numCorners; ++p) verts[p] = cells[p];
+  numVerticesAdj = numCells*numCorners;
+  ierr = PetscSortRemoveDupsInt(&numVerticesAdj, verts);CHKERRQ(ierr);
+  if (numVerticesAdj && ((verts[0] < 0) || (verts[numVerticesAdj-1] >= vrange[numProcs]))) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Cell vertex %D not in [0, %D)", verts[0] < 0 ? verts[0] : verts[numVerticesAdj-1], vrange[numProcs]);
+  /* Create cell-vertex mesh */
+  ierr = DMPlexSetChart(dm, 0, numCells+numVerticesAdj);CHKERRQ(ierr);
+  for (c = 0; c < numCells; ++c) {
+    ierr = DMPlexSetConeSize(dm, c, numCorners);CHKERRQ(ierr);
+  }
+  ierr = DMSetUp(dm);CHKERRQ(ierr);
+  ierr = DMGetWorkArray(dm, numCorners, PETSC_INT, &cone);CHKERRQ(ierr);
+  for (c = 0; c < numCells; ++c) {
+    for (p = 0; p < numCorners; ++p) {
+      ierr = PetscFindInt(cells[c*numCorners+p], numVerticesAdj, verts, &v);CHKERRQ(ierr);
+      cone[p] = v+numCells;
+    }
+    ierr = DMPlexSetCone(dm, c, cone);CHKERRQ(ierr);
+  }
+  ierr = DMRestoreWorkArray(dm, numCorners, PETSC_INT, &cone);CHKERRQ(ierr);
+  ierr = DMPlexSymmetrize(dm);CHKERRQ(ierr);
+  ierr = DMPlexStratify(dm);CHKERRQ(ierr);
+  /* Create the vertex SF: leaf v is the local vertex numCells+v and its root is the entry in the owning slab */
+  ierr = PetscMalloc1(numVerticesAdj, &remoteVerticesAdj);CHKERRQ(ierr);
+  for (v = 0; v < numVerticesAdj; ++v) {
+    PetscInt owner;
+
+    ierr = PetscLayoutFindOwner(vLayout, verts[v], &owner);CHKERRQ(ierr);
+    remoteVerticesAdj[v].rank  = owner;
+    remoteVerticesAdj[v].index = verts[v] - vrange[owner];
+  }
+  ierr = PetscSFCreate(comm, sfVert);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(*sfVert, numVertices, numVerticesAdj, NULL, PETSC_OWN_POINTER, remoteVerticesAdj, PETSC_OWN_POINTER);CHKERRQ(ierr);
+  /* Point ownership vote: Process with highest rank owns shared vertices */
+  ierr = PetscMalloc2(numVerticesAdj, &vertexLocal, numVertices, &vertexOwner);CHKERRQ(ierr);
+  for (v = 0; v < numVerticesAdj; ++v) {
+    vertexLocal[v].rank  = rank;
+    vertexLocal[v].index = v+numCells;
+  }
+  for (v = 0; v < numVertices; ++v) {
+    vertexOwner[v].rank  = -1;
+    vertexOwner[v].index = -1;
+  }
+  ierr = PetscSFReduceBegin(*sfVert, MPIU_2INT, vertexLocal, vertexOwner, MPI_MAXLOC);CHKERRQ(ierr);
+  ierr = PetscSFReduceEnd(*sfVert, MPIU_2INT, vertexLocal, vertexOwner, MPI_MAXLOC);CHKERRQ(ierr);
+  ierr = PetscSFBcastBegin(*sfVert, MPIU_2INT, vertexOwner, vertexLocal);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(*sfVert, MPIU_2INT, vertexOwner, vertexLocal);CHKERRQ(ierr);
+  /* Create the point SF from the vertices owned by other processes */
+  for (numLeaves = 0, v = 0; v < numVerticesAdj; ++v) if (vertexLocal[v].rank != rank) ++numLeaves;
+  ierr = PetscMalloc1(numLeaves, &localVertices);CHKERRQ(ierr);
+  ierr = PetscMalloc1(numLeaves, &remoteVertices);CHKERRQ(ierr);
+  for (numLeaves = 0, v = 0; v < numVerticesAdj; ++v) {
+    if (vertexLocal[v].rank == rank) continue;
+    localVertices[numLeaves]  = v+numCells;
+    remoteVertices[numLeaves] = vertexLocal[v];
+    ++numLeaves;
+  }
+  ierr = DMGetPointSF(dm, &sfPoint);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(sfPoint, numCells+numVerticesAdj, numLeaves, localVertices, PETSC_OWN_POINTER, remoteVertices, PETSC_OWN_POINTER);CHKERRQ(ierr);
+  ierr = PetscFree2(vertexLocal, vertexOwner);CHKERRQ(ierr);
+  ierr = PetscFree(verts);CHKERRQ(ierr);
+  ierr = PetscLayoutDestroy(&vLayout);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexBuildCoordinatesParallel_Private"
+/*
+  This takes as input the coordinates for each vertex in the local slab, and uses the vertex SF to send them to the local vertices
+*/
+PetscErrorCode DMPlexBuildCoordinatesParallel_Private(DM dm, PetscInt spaceDim, PetscSF sfVert, const double vertexCoords[])
+{
+  PetscSection   coordSection;
+  Vec            coordinates;
+  MPI_Datatype   coordType;
+  PetscScalar   *coords;
+  double        *coordsAdj;
+  PetscInt       numVerticesAdj, coordSize, vStart, vEnd, v, d;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscSFGetGraph(sfVert, NULL, &numVerticesAdj, NULL, NULL);CHKERRQ(ierr);
+  ierr = DMPlexGetDepthStratum(dm, 0, &vStart, &vEnd);CHKERRQ(ierr);
+  if (vEnd-vStart != numVerticesAdj) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_ARG_SIZ, "Number of local vertices %D != %D leaves in the vertex SF", vEnd-vStart, numVerticesAdj);
+  ierr = DMGetCoordinateSection(dm, &coordSection);CHKERRQ(ierr);
+  ierr = PetscSectionSetNumFields(coordSection, 1);CHKERRQ(ierr);
+  ierr = PetscSectionSetFieldComponents(coordSection, 0, spaceDim);CHKERRQ(ierr);
+  ierr = PetscSectionSetChart(coordSection, vStart, vEnd);CHKERRQ(ierr);
+  for (v = vStart; v < vEnd; ++v) {
+    ierr = PetscSectionSetDof(coordSection, v, spaceDim);CHKERRQ(ierr);
+    ierr = PetscSectionSetFieldDof(coordSection, v, 0, spaceDim);CHKERRQ(ierr);
+  }
+  ierr = PetscSectionSetUp(coordSection);CHKERRQ(ierr);
+  ierr = PetscSectionGetStorageSize(coordSection, &coordSize);CHKERRQ(ierr);
+  ierr = VecCreate(PetscObjectComm((PetscObject)dm), &coordinates);CHKERRQ(ierr);
+  ierr = VecSetBlockSize(coordinates, spaceDim);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) coordinates, "coordinates");CHKERRQ(ierr);
+  ierr = VecSetSizes(coordinates, coordSize, PETSC_DETERMINE);CHKERRQ(ierr);
+  ierr = VecSetType(coordinates,VECSTANDARD);CHKERRQ(ierr);
+  ierr = PetscMalloc1(numVerticesAdj*spaceDim, &coordsAdj);CHKERRQ(ierr);
+  ierr = MPI_Type_contiguous(spaceDim, MPI_DOUBLE, &coordType);CHKERRQ(ierr);
+  ierr = MPI_Type_commit(&coordType);CHKERRQ(ierr);
+  ierr = PetscSFBcastBegin(sfVert, coordType, vertexCoords, coordsAdj);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(sfVert, coordType, vertexCoords, coordsAdj);CHKERRQ(ierr);
+  ierr = MPI_Type_free(&coordType);CHKERRQ(ierr);
+  ierr = VecGetArray(coordinates, &coords);CHKERRQ(ierr);
+  for (v = 0; v < numVerticesAdj; ++v) {
+    for (d = 0; d < spaceDim; ++d) {
+      coords[v*spaceDim+d] = coordsAdj[v*spaceDim+d];
+    }
+  }
+  ierr = VecRestoreArray(coordinates, &coords);CHKERRQ(ierr);
+  ierr = PetscFree(coordsAdj);CHKERRQ(ierr);
+  ierr = DMSetCoordinatesLocal(dm, coordinates);CHKERRQ(ierr);
+  ierr = VecDestroy(&coordinates);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexCreateFromCellListParallel"
+/*@C
+  DMPlexCreateFromCellListParallel - This takes as input common mesh generator output, a list of the vertices for each cell, distributed over all processes, and produces a distributed DM
+
+  Collective on comm
+
+  Input Parameters:
++ comm - The communicator
+. dim - The topological dimension of the mesh
+. numCells - The number of cells owned by this process
+. numVertices - The number of vertices in the slab owned by this process
+. numCorners - The number of vertices for each cell
+. interpolate - Flag indicating that intermediate mesh entities (faces, edges) should be created automatically
+. cells - An array of numCells*numCorners numbers, the global vertex numbers for each cell
+. spaceDim - The spatial dimension used for coordinates
+- vertexCoords - An array of numVertices*spaceDim numbers, the coordinates of each vertex in the slab
+
+  Output Parameters:
++ vertexSF - (Optional) The SF from the local vertices to the vertex slabs, which can be used to move vertex data
+- dm - The DM
+
+  Notes: The global vertex numbers are divided into contiguous slabs, so that process p holds the coordinates of the
+  numVertices vertices following those of the processes before p. No process needs the whole mesh, so this can be used
+  by a parallel reader, and the resulting DM is then balanced with DMPlexDistribute(). The local cells are numbered
+  first, in the given order, followed by the local vertices in order of their global number. A vertex shared by
+  several processes is owned by the one with the highest rank.
+
+  Level: intermediate
+
+.seealso: DMPlexCreateFromCellList(), DMPlexCreateFromDAG(), DMPlexDistribute(), DMPlexCreate()
+@*/
+PetscErrorCode DMPlexCreateFromCellListParallel(MPI_Comm comm, PetscInt dim, PetscInt numCells, PetscInt numVertices, PetscInt numCorners, PetscBool interpolate, const int cells[], PetscInt spaceDim, const double vertexCoords[], PetscSF *vertexSF, DM *dm)
+{
+  PetscSF        sfVert;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMCreate(comm, dm);CHKERRQ(ierr);
+  ierr = DMSetType(*dm, DMPLEX);CHKERRQ(ierr);
+  ierr = DMSetDimension(*dm, dim);CHKERRQ(ierr);
+  ierr = DMPlexBuildFromCellListParallel_Private(*dm, numCells, numVertices, numCorners, cells, &sfVert);CHKERRQ(ierr);
+  if (interpolate) {
+    DM idm = NULL;
+
+    ierr = DMPlexInterpolate(*dm, &idm);CHKERRQ(ierr);
+    ierr = DMDestroy(dm);CHKERRQ(ierr);
+    *dm  = idm;
+  }
+  ierr = DMPlexBuildCoordinatesParallel_Private(*dm, spaceDim, sfVert, vertexCoords);CHKERRQ(ierr);
+  if (vertexSF) *vertexSF = sfVert;
+  else {ierr = PetscSFDestroy(&sfVert);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexSetLabelFromVertexSlabs_Internal"
+/*
+  DMPlexSetLabelFromVertexSlabs_Internal - Labels the points of a mesh made by DMPlexCreateFromCellListParallel() given by their global vertices
+
+  Each entry is the vertex itself (size 1), or a list of at most 4 vertices whose join is labeled. An entry can be given
+  on any process. It is sent to the owner of the slab of its first vertex, which forwards it to every process referencing
+  that vertex. The label is created on all processes, so that they hold the same labels.
+*/
+PetscErrorCode DMPlexSetLabelFromVertexSlabs_Internal(DM dm, PetscSF vertexSF, const char name[], PetscInt numEntries, const PetscInt entrySizes[], const PetscInt entryVertices[], const PetscInt values[])
+{
+  MPI_Comm           comm;
+  PetscMPIInt        rank, numProcs, r;
+  PetscSF            sfProcess;
+  PetscSFNode       *remoteProc;
+  PetscSection       sendSection, recvSection;
+  PetscLayout        vLayout;
+  MPI_Datatype       entryType;
+  const PetscSFNode *remoteVertices;
+  const PetscInt    *vrange, *degree;
+  PetscInt          *leafRanks, *rootRanks, *rootOffsets, *gverts, *lverts, *entries, *recvEntries, *fwdEntries, *counts;
+  PetscInt           numRoots, numLeaves, numMulti, numRecv, numFwd, vStart, vEnd, e, k, v;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject) dm, &comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm, &rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm, &numProcs);CHKERRQ(ierr);
+  ierr = DMPlexCreateLabel(dm, name);CHKERRQ(ierr);
+  ierr = PetscSFGetGraph(vertexSF, &numRoots, &numLeaves, NULL, &remoteVertices);CHKERRQ(ierr);
+  ierr = DMPlexGetDepthStratum(dm, 0, &vStart, &vEnd);CHKERRQ(ierr);
+  if (vEnd-vStart != numLeaves) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_ARG_SIZ, "Number of local vertices %D != %D leaves in the vertex SF", vEnd-vStart, numLeaves);
+  ierr = PetscLayoutCreate(comm, &vLayout);CHKERRQ(ierr);
+  ierr = PetscLayoutSetLocalSize(vLayout, numRoots);CHKERRQ(ierr);
+  ierr = PetscLayoutSetBlockSize(vLayout, 1);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(vLayout);CHKERRQ(ierr);
+  ierr = PetscLayoutGetRanges(vLayout, &vrange);CHKERRQ(ierr);
+  /* Global numbers of the local vertices, sorted for lookup */
+  ierr = PetscMalloc2(numLeaves, &gverts, numLeaves, &lverts);CHKERRQ(ierr);
+  for (v = 0; v < numLeaves; ++v) {
+    gverts[v] = vrange[remoteVertices[v].rank] + remoteVertices[v].index;
+    lverts[v] = v+vStart;
+  }
+  ierr = PetscSortIntWithArray(numLeaves, gverts, lverts);CHKERRQ(ierr);
+  /* Gather the processes referencing each vertex of the local slab */
+  ierr = PetscSFComputeDegreeBegin(vertexSF, &degree);CHKERRQ(ierr);
+  ierr = PetscSFComputeDegreeEnd(vertexSF, &degree);CHKERRQ(ierr);
+  ierr = PetscMalloc1(numRoots+1, &rootOffsets);CHKERRQ(ierr);
+  for (rootOffsets[0] = 0, v = 0; v < numRoots; ++v) rootOffsets[v+1] = rootOffsets[v] + degree[v];
+  numMulti = rootOffsets[numRoots];
+  ierr = PetscMalloc2(numLeaves, &leafRanks, numMulti, &rootRanks);CHKERRQ(ierr);
+  for (v = 0; v < numLeaves; ++v) leafRanks[v] = rank;
+  ierr = PetscSFGatherBegin(vertexSF, MPIU_INT, leafRanks, rootRanks);CHKERRQ(ierr);
+  ierr = PetscSFGatherEnd(vertexSF, MPIU_INT, leafRanks, rootRanks);CHKERRQ(ierr);
+  /* Pack the entries as [value, size, v0, v1, v2, v3] by the owner of the slab of their first vertex */
+  ierr = PetscSectionCreate(comm, &sendSection);CHKERRQ(ierr);
+  ierr = PetscSectionSetChart(sendSection, 0, numProcs);CHKERRQ(ierr);
+  ierr = PetscMalloc3(numEntries*6, &entries, numProcs, &counts, numProcs, &remoteProc);CHKERRQ(ierr);
+  for (e = 0, k = 0; e < numEntries; k += entrySizes[e++]) {
+    PetscInt owner;
+
+    if ((entrySizes[e] < 1) || (entrySizes[e] > 4)) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Entry %D has %D vertices, not in [1, 4]", e, entrySizes[e]);
+    ierr = PetscLayoutFindOwner(vLayout, entryVertices[k], &owner);CHKERRQ(ierr);
+    ierr = PetscSectionAddDof(sendSection, owner, 1);CHKERRQ(ierr);
+  }
+  ierr = PetscSectionSetUp(sendSection);CHKERRQ(ierr);
+  ierr = PetscMemzero(counts, numProcs*sizeof(PetscInt));CHKERRQ(ierr);
+  for (e = 0, k = 0; e < numEntries; k += entrySizes[e++]) {
+    PetscInt owner, off;
+
+    ierr = PetscLayoutFindOwner(vLayout, entryVertices[k], &owner);CHKERRQ(ierr);
+    ierr = PetscSectionGetOffset(sendSection, owner, &off);CHKERRQ(ierr);
+    off += counts[owner]++;
+    entries[off*6+0] = values[e];
+    entries[off*6+1] = entrySizes[e];
+    for (v = 0; v < 4; ++v) entries[off*6+2+v] = v < entrySizes[e] ? entryVertices[k+v] : -1;
+  }
+  /* Build a global process SF */
+  for (r = 0; r < numProcs; ++r) {
+    remoteProc[r].rank  = r;
+    remoteProc[r].index = rank;
+  }
+  ierr = PetscSFCreate(comm, &sfProcess);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(sfProcess, numProcs, numProcs, NULL, PETSC_OWN_POINTER, remoteProc, PETSC_COPY_VALUES);CHKERRQ(ierr);
+  ierr = MPI_Type_contiguous(6, MPIU_INT, &entryType);CHKERRQ(ierr);
+  ierr = MPI_Type_commit(&entryType);CHKERRQ(ierr);
+  ierr = PetscSectionCreate(comm, &recvSection);CHKERRQ(ierr);
+  ierr = DMPlexDistributeData(dm, sfProcess, sendSection, entryType, entries, recvSection, (void **) &recvEntries);CHKERRQ(ierr);
+  ierr = PetscSectionGetStorageSize(recvSection, &numRecv);CHKERRQ(ierr);
+  ierr = PetscFree3(entries, counts, remoteProc);CHKERRQ(ierr);
+  /* Forward each entry to the processes referencing its first vertex */
+  ierr = PetscSectionDestroy(&sendSection);CHKERRQ(ierr);
+  ierr = PetscSectionCreate(comm, &sendSection);CHKERRQ(ierr);
+  ierr = PetscSectionSetChart(sendSection, 0, numProcs);CHKERRQ(ierr);
+  for (e = 0; e < numRecv; ++e) {
+    const PetscInt root = recvEntries[e*6+2] - vrange[rank];
+
+    for (k = rootOffsets[root]; k < rootOffsets[root+1]; ++k) {ierr = PetscSectionAddDof(sendSection, rootRanks[k], 1);CHKERRQ(ierr);}
+  }
+  ierr = PetscSectionSetUp(sendSection);CHKERRQ(ierr);
+  ierr = PetscSectionGetStorageSize(sendSection, &numFwd);CHKERRQ(ierr);
+  ierr = PetscMalloc2(numFwd*6, &fwdEntries, numProcs, &counts);CHKERRQ(ierr);
+  ierr = PetscMemzero(counts, numProcs*sizeof(PetscInt));CHKERRQ(ierr);
+  for (e = 0; e < numRecv; ++e) {
+    const PetscInt root = recvEntries[e*6+2] - vrange[rank];
+
+    for (k = rootOffsets[root]; k < rootOffsets[root+1]; ++k) {
+      PetscInt off;
+
+      ierr = PetscSectionGetOffset(sendSection, rootRanks[k], &off);CHKERRQ(ierr);
+      off += counts[rootRanks[k]]++;
+      ierr = PetscMemcpy(&fwdEntries[off*6], &recvEntries[e*6], 6*sizeof(PetscInt));CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscFree(recvEntries);CHKERRQ(ierr);
+  ierr = PetscSectionDestroy(&recvSection);CHKERRQ(ierr);
+  ierr = PetscSectionCreate(comm, &recvSection);CHKERRQ(ierr);
+  ierr = DMPlexDistributeData(dm, sfProcess, sendSection, entryType, fwdEntries, recvSection, (void **) &recvEntries);CHKERRQ(ierr);
+  ierr = PetscSectionGetStorageSize(recvSection, &numRecv);CHKERRQ(ierr);
+  /* Label the local points */
+  for (e = 0; e < numRecv; ++e) {
+    const PetscInt *entry = &recvEntries[e*6];
+    PetscInt        points[4], idx;
+    PetscBool       local = PETSC_TRUE;
+
+    for (v = 0; v < entry[1]; ++v) {
+      ierr = PetscFindInt(entry[2+v], numLeaves, gverts, &idx);CHKERRQ(ierr);
+      if (idx < 0) {local = PETSC_FALSE; break;}
+      points[v] = lverts[idx];
+    }
+    if (!local) continue;
+    if (entry[1] == 1) {
+      ierr = DMPlexSetLabelValue(dm, name, points[0], entry[0]);CHKERRQ(ierr);
+    } else {
+      const PetscInt *join;
+      PetscInt        joinSize;
+
+      ierr = DMPlexGetFullJoin(dm, entry[1], points, &joinSize, &join);CHKERRQ(ierr);
+      if (joinSize == 1) {ierr = DMPlexSetLabelValue(dm, name, join[0], entry[0]);CHKERRQ(ierr);}
+      ierr = DMPlexRestoreJoin(dm, entry[1], points, &joinSize, &join);CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscFree(recvEntries);CHKERRQ(ierr);
+  ierr = PetscFree2(fwdEntries, counts);CHKERRQ(ierr);
+  ierr = PetscFree2(leafRanks, rootRanks);CHKERRQ(ierr);
+  ierr = PetscFree(rootOffsets);CHKERRQ(ierr);
+  ierr = PetscFree2(gverts, lverts);CHKERRQ(ierr);
+  ierr = PetscSectionDestroy(&sendSection);CHKERRQ(ierr);
+  ierr = PetscSectionDestroy(&recvSection);CHKERRQ(ierr);
+  ierr = MPI_Type_free(&entryType);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sfProcess);CHKERRQ(ierr);
+  ierr = PetscLayoutDestroy(&vLayout);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "DMPlexCreateFromDAG"
 /*@
@@ -1383,7 +1383,8 @@ PetscErrorCode DMPlexCreatePointSF(DM dm, PetscSF migrationSF, PetscBool ownersh
 PetscErrorCode DMPlexMigrate(DM dm, PetscSF sf, DM targetDM)
 {
   MPI_Comm               comm;
-  PetscInt               dim, nroots;
+  PetscInt               dim, nroots, conesSize = 0;
+  PetscInt              *cones = NULL, *localCones = NULL;
   PetscSF                sfPoint;
   ISLocalToGlobalMapping ltogMigration;
   PetscBool              flg;
@@ -1402,8 +1403,8 @@ PetscErrorCode DMPlexMigrate(DM dm, PetscSF sf, DM targetDM)
   if (nroots >= 0) {
     IS                     isOriginal;
     ISLocalToGlobalMapping ltogOriginal;
-    PetscInt               n, size, nleaves, conesSize;
-    PetscInt              *numbering_orig, *numbering_new, *cones;
+    PetscInt               n, size, nleaves;
+    PetscInt              *numbering_orig, *numbering_new;
     PetscSection           coneSection;
     /* Get the original point numbering */
     ierr = DMPlexCreatePointNumbering(dm, &isOriginal);CHKERRQ(ierr);
@@ -1419,10 +1420,12 @@ PetscErrorCode DMPlexMigrate(DM dm, PetscSF sf, DM targetDM)
     ierr = PetscSFBcastEnd(sf, MPIU_INT, (PetscInt *) numbering_orig, numbering_new);CHKERRQ(ierr);
     ierr = ISLocalToGlobalMappingCreate(comm, 1, nleaves, (const PetscInt*) numbering_new, PETSC_OWN_POINTER, &ltogMigration);CHKERRQ(ierr);
     ierr = ISLocalToGlobalMappingRestoreIndices(ltogOriginal, (const PetscInt**)&numbering_orig);CHKERRQ(ierr);
-    /* Convert cones to global numbering before migrating them */
+    /* Convert cones to global numbering before migrating them, keeping the local cones to restore the source DM */
     ierr = DMPlexGetConeSection(dm, &coneSection);CHKERRQ(ierr);
     ierr = PetscSectionGetStorageSize(coneSection, &conesSize);CHKERRQ(ierr);
     ierr = DMPlexGetCones(dm, &cones);CHKERRQ(ierr);
+    ierr = PetscMalloc1(conesSize, &localCones);CHKERRQ(ierr);
+    ierr = PetscMemcpy(localCones, cones, conesSize * sizeof(PetscInt));CHKERRQ(ierr);
     ierr = ISLocalToGlobalMappingApplyBlock(ltogOriginal, conesSize, cones, cones);CHKERRQ(ierr);
     ierr = ISDestroy(&isOriginal);CHKERRQ(ierr);
     ierr = ISLocalToGlobalMappingDestroy(&ltogOriginal);CHKERRQ(ierr);
@@ -1437,6 +1440,10 @@ PetscErrorCode DMPlexMigrate(DM dm, PetscSF sf, DM targetDM)
   }
   /* Migrate DM data to target DM */
   ierr = DMPlexDistributeCones(dm, sf, ltogMigration, targetDM);CHKERRQ(ierr);
+  if (localCones) {
+    ierr = PetscMemcpy(cones, localCones, conesSize * sizeof(PetscInt));CHKERRQ(ierr);
+    ierr = PetscFree(localCones);CHKERRQ(ierr);
+  }
   ierr = DMPlexDistributeCoordinates(dm, sf, targetDM);CHKERRQ(ierr);
   ierr = DMPlexDistributeLabels(dm, sf, targetDM);CHKERRQ(ierr);
   ierr = DMPlexDistributeSetupHybrid(dm, sf, ltogMigration, targetDM);CHKERRQ(ierr);
@@ -1467,10 +1474,13 @@ PetscErrorCode DMPlexMigrate(DM dm, PetscSF sf, DM targetDM)
   DMPlexSetAdjacencyUseClosure(). They should choose the combination appropriate for the function
   representation on the mesh.
 
+  The local points of the distributed mesh can be renumbered for cache locality using DMPlexSetReorderType() or
+  -dm_plex_reorder, in which case the leaves of the returned SF follow the new numbering.
+
   Level: intermediate
 
 .keywords: mesh, elements
-.seealso: DMPlexCreate(), DMPlexDistributeByFace(), DMPlexSetAdjacencyUseCone(), DMPlexSetAdjacencyUseClosure()
+.seealso: DMPlexCreate(), DMPlexDistributeByFace(), DMPlexSetAdjacencyUseCone(), DMPlexSetAdjacencyUseClosure(), DMPlexReorder()
 @*/
 PetscErrorCode DMPlexDistribute(DM dm, PetscInt overlap, PetscSF *sf, DM *dmParallel)
 {
@@ -1481,6 +1491,7 @@ PetscErrorCode DMPlexDistribute(DM dm, PetscInt overlap, PetscSF *sf, DM *dmPara
   DM                     dmCoord;
   DMLabel                lblPartition, lblMigration;
   PetscSF                sfProcess, sfMigration, sfStratified, sfPoint;
+  DMPlexReorderType      reorderType;
   PetscBool              flg;
   PetscMPIInt            rank, numProcs, p;
   PetscErrorCode         ierr;
@@ -1592,6 +1603,39 @@ PetscErrorCode DMPlexDistribute(DM dm, PetscInt overlap, PetscSF *sf, DM *dmPara
   ierr = DMLabelDestroy(&lblMigration);CHKERRQ(ierr);
   ierr = PetscSectionDestroy(&cellPartSection);CHKERRQ(ierr);
   ierr = ISDestroy(&cellPart);CHKERRQ(ierr);
+  /* Reorder local points for cache locality */
+  ierr = DMPlexGetReorderType(dm, &reorderType);CHKERRQ(ierr);
+  ierr = PetscOptionsGetEnum(((PetscObject) dm)->prefix, "-dm_plex_reorder", DMPlexReorderTypes, (PetscEnum *) &reorderType, NULL);CHKERRQ(ierr);
+  if (reorderType != DMPLEX_REORDER_NONE) {
+    DM                 dmReordered;
+    IS                 perm;
+    const PetscInt    *pperm, *ilocal;
+    const PetscSFNode *oldRemote;
+    PetscSFNode       *newRemote;
+    PetscSF            sfReordered;
+    PetscInt           nroots, nleaves, pStart, pEnd, l;
+
+    ierr = DMPlexReorder(*dmParallel, reorderType, &perm, &dmReordered);CHKERRQ(ierr);
+    if (dmReordered) {
+      ierr = DMDestroy(dmParallel);CHKERRQ(ierr);
+      *dmParallel = dmReordered;
+      ierr = PetscObjectSetName((PetscObject) *dmParallel, "Parallel Mesh");CHKERRQ(ierr);
+      ierr = DMPlexSetReorderType(*dmParallel, reorderType);CHKERRQ(ierr);
+      /* Re-map the leaves of the migration SF to the new point numbers */
+      ierr = PetscSFGetGraph(sfMigration, &nroots, &nleaves, &ilocal, &oldRemote);CHKERRQ(ierr);
+      ierr = DMPlexGetChart(*dmParallel, &pStart, &pEnd);CHKERRQ(ierr);
+      if (nleaves != pEnd-pStart) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Number of migrated points %D != %D number of mesh points", nleaves, pEnd-pStart);
+      ierr = PetscMalloc1(nleaves, &newRemote);CHKERRQ(ierr);
+      ierr = ISGetIndices(perm, &pperm);CHKERRQ(ierr);
+      for (l = 0; l < nleaves; ++l) newRemote[pperm[ilocal ? ilocal[l] : l]] = oldRemote[l];
+      ierr = ISRestoreIndices(perm, &pperm);CHKERRQ(ierr);
+      ierr = PetscSFCreate(comm, &sfReordered);CHKERRQ(ierr);
+      ierr = PetscSFSetGraph(sfReordered, nroots, nleaves, NULL, PETSC_OWN_POINTER, newRemote, PETSC_OWN_POINTER);CHKERRQ(ierr);
+      ierr = PetscSFDestroy(&sfMigration);CHKERRQ(ierr);
+      sfMigration = sfReordered;
+    }
+    ierr = ISDestroy(&perm);CHKERRQ(ierr);
+  }
   /* Copy BC */
   ierr = DMPlexCopyBoundary(dm, *dmParallel);CHKERRQ(ierr);
   /* Cleanup */
@@ -1685,3 +1729,350 @@ PetscErrorCode DMPlexDistributeOverlap(DM dm, PetscInt overlap, PetscSF *sf, DM
   ierr = PetscLogEventEnd(DMPLEX_DistributeOverlap, dm, 0, 0, 0);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexRebalanceComputeFlow_Static"
+/* First order diffusion of the cell load over the process graph, flow[n] is the number of cells to send to nbrs[n] */
+static PetscErrorCode DMPlexRebalanceComputeFlow_Static(DM dm, PetscInt numCells, PetscInt numNbrs, const PetscInt nbrs[], PetscReal tol, PetscReal flow[], PetscReal *imbalance)
+{
+  MPI_Comm       comm;
+  PetscMPIInt    numProcs;
+  PetscSF        sfNbr;
+  PetscSFNode   *remote;
+  PetscReal     *alpha, *nload, load, mean, dev, gdev;
+  PetscInt      *ndegree, maxCells, sumCells, it, n;
+  const PetscInt maxIt = 1000;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject) dm, &comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm, &numProcs);CHKERRQ(ierr);
+  ierr = MPI_Allreduce(&numCells, &maxCells, 1, MPIU_INT, MPI_MAX, comm);CHKERRQ(ierr);
+  ierr = MPI_Allreduce(&numCells, &sumCells, 1, MPIU_INT, MPI_SUM, comm);CHKERRQ(ierr);
+  mean       = ((PetscReal) sumCells)/numProcs;
+  *imbalance = sumCells ? maxCells/mean : 1.0;
+  for (n = 0; n < numNbrs; ++n) flow[n] = 0.0;
+  if (*imbalance <= 1.0 + tol) PetscFunctionReturn(0);
+  /* Each neighbor is a leaf pointing to the single root on its process */
+  ierr = PetscMalloc1(numNbrs, &remote);CHKERRQ(ierr);
+  for (n = 0; n < numNbrs; ++n) {
+    remote[n].rank  = nbrs[n];
+    remote[n].index = 0;
+  }
+  ierr = PetscSFCreate(comm, &sfNbr);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(sfNbr, 1, numNbrs, NULL, PETSC_OWN_POINTER, remote, PETSC_OWN_POINTER);CHKERRQ(ierr);
+  ierr = PetscMalloc3(numNbrs, &ndegree, numNbrs, &alpha, numNbrs, &nload);CHKERRQ(ierr);
+  ierr = PetscSFBcastBegin(sfNbr, MPIU_INT, &numNbrs, ndegree);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(sfNbr, MPIU_INT, &numNbrs, ndegree);CHKERRQ(ierr);
+  for (n = 0; n < numNbrs; ++n) alpha[n] = 1.0/(PetscMax(numNbrs, ndegree[n]) + 1);
+  load = numCells;
+  for (it = 0; it < maxIt; ++it) {
+    PetscReal delta = 0.0;
+
+    ierr = PetscSFBcastBegin(sfNbr, MPIU_REAL, &load, nload);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sfNbr, MPIU_REAL, &load, nload);CHKERRQ(ierr);
+    for (n = 0; n < numNbrs; ++n) {
+      const PetscReal f = alpha[n]*(load - nload[n]);
+
+      flow[n] += f;
+      delta   += f;
+    }
+    load -= delta;
+    if (it%10 == 9) {
+      dev  = PetscAbsReal(load - mean);
+      ierr = MPI_Allreduce(&dev, &gdev, 1, MPIU_REAL, MPIU_MAX, comm);CHKERRQ(ierr);
+      if (gdev <= tol*mean) break;
+    }
+  }
+  ierr = PetscInfo2(dm, "Load diffusion took %D iterations, predicted local load %g\n", it, (double) load);CHKERRQ(ierr);
+  ierr = PetscFree3(ndegree, alpha, nload);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sfNbr);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexRebalanceSelectCells_Static"
+/*
+  Choose quota[n] owned cells to send to nbrs[n], growing a front of face neighbors from the owned cells touching points
+  shared with that process, so that the migrated cells stay close to the interface. On output, target[c-cStart] is
+  the new owner of each owned cell.
+*/
+static PetscErrorCode DMPlexRebalanceSelectCells_Static(DM dm, const PetscInt cellNum[], PetscInt numNbrs, const PetscInt nbrs[], const PetscInt quota[], PetscInt target[])
+{
+  PetscSF            sfPoint;
+  const PetscInt    *leaves, *degree;
+  const PetscSFNode *remotes;
+  PetscInt          *owner, *leafRanks, *rootRanks, *rootOff, *seedOff, *seeds, *lastSeen, *queue, *queued, *order, *adj = NULL;
+  PetscInt           nroots, nleaves, numMulti = 0, pStart, pEnd, cStart, cEnd, c, l, n, p, numOwned = 0, numSent = 0, pass;
+  PetscMPIInt        rank;
+  PetscBool          useCone, useClosure;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_rank(PetscObjectComm((PetscObject) dm), &rank);CHKERRQ(ierr);
+  ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  ierr = DMGetPointSF(dm, &sfPoint);CHKERRQ(ierr);
+  ierr = PetscSFGetGraph(sfPoint, &nroots, &nleaves, &leaves, &remotes);CHKERRQ(ierr);
+  /* Gather the ranks sharing each root, and record the owner of each leaf */
+  ierr = PetscMalloc3(pEnd-pStart, &owner, pEnd-pStart, &leafRanks, pEnd-pStart+1, &rootOff);CHKERRQ(ierr);
+  for (p = pStart; p < pEnd; ++p) {owner[p] = -1; leafRanks[p] = rank;}
+  for (l = 0; l < nleaves; ++l) owner[leaves ? leaves[l] : l] = remotes[l].rank;
+  ierr = PetscSFComputeDegreeBegin(sfPoint, &degree);CHKERRQ(ierr);
+  ierr = PetscSFComputeDegreeEnd(sfPoint, &degree);CHKERRQ(ierr);
+  rootOff[0] = 0;
+  for (p = pStart; p < pEnd; ++p) rootOff[p+1] = rootOff[p] + (p < nroots ? degree[p] : 0);
+  numMulti = rootOff[pEnd];
+  ierr = PetscMalloc1(numMulti, &rootRanks);CHKERRQ(ierr);
+  ierr = PetscSFGatherBegin(sfPoint, MPIU_INT, leafRanks, rootRanks);CHKERRQ(ierr);
+  ierr = PetscSFGatherEnd(sfPoint, MPIU_INT, leafRanks, rootRanks);CHKERRQ(ierr);
+  /* Seed cells for each neighbor, in CSR form */
+  ierr = PetscCalloc2(numNbrs+1, &seedOff, numNbrs, &lastSeen);CHKERRQ(ierr);
+  for (pass = 0; pass < 2; ++pass) {
+    if (pass) {
+      for (n = 0; n < numNbrs; ++n) seedOff[n+1] += seedOff[n];
+      ierr = PetscMalloc1(seedOff[numNbrs], &seeds);CHKERRQ(ierr);
+    }
+    for (n = 0; n < numNbrs; ++n) lastSeen[n] = -1;
+    for (c = cStart; c < cEnd; ++c) {
+      PetscInt *closure = NULL, clSize, cl;
+
+      if (cellNum[c-cStart] < 0) continue;
+      ierr = DMPlexGetTransitiveClosure(dm, c, PETSC_TRUE, &clSize, &closure);CHKERRQ(ierr);
+      for (cl = 0; cl < clSize*2; cl += 2) {
+        const PetscInt q = closure[cl];
+        PetscInt       s, r;
+
+        for (s = rootOff[q]-1; s < rootOff[q+1]; ++s) {
+          r = s < rootOff[q] ? owner[q] : rootRanks[s];
+          if (r < 0) continue;
+          ierr = PetscFindInt(r, numNbrs, nbrs, &n);CHKERRQ(ierr);
+          if (n < 0 || lastSeen[n] == c) continue;
+          lastSeen[n] = c;
+          if (pass) seeds[seedOff[n]++] = c;
+          else      ++seedOff[n+1];
+        }
+      }
+      ierr = DMPlexRestoreTransitiveClosure(dm, c, PETSC_TRUE, &clSize, &closure);CHKERRQ(ierr);
+    }
+  }
+  for (n = numNbrs; n > 0; --n) seedOff[n] = seedOff[n-1];
+  seedOff[0] = 0;
+  /* Grow a front from the seeds of each neighbor, largest quota first */
+  for (c = cStart; c < cEnd; ++c) {
+    target[c-cStart] = rank;
+    if (cellNum[c-cStart] >= 0) ++numOwned;
+  }
+  ierr = PetscMalloc3(cEnd-cStart, &queue, cEnd-cStart, &queued, numNbrs, &order);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) queued[c-cStart] = -1;
+  for (n = 0; n < numNbrs; ++n) order[n] = n;
+  ierr = PetscSortIntWithPermutation(numNbrs, quota, order);CHKERRQ(ierr);
+  ierr = DMPlexGetAdjacencyUseCone(dm, &useCone);CHKERRQ(ierr);
+  ierr = DMPlexGetAdjacencyUseClosure(dm, &useClosure);CHKERRQ(ierr);
+  ierr = DMPlexSetAdjacencyUseCone(dm, PETSC_TRUE);CHKERRQ(ierr);
+  ierr = DMPlexSetAdjacencyUseClosure(dm, PETSC_FALSE);CHKERRQ(ierr);
+  for (p = numNbrs-1; p >= 0; --p) {
+    const PetscInt nb = order[p];
+    PetscInt       head = 0, tail = 0, sent = 0, next = cStart, s;
+
+    for (s = seedOff[nb]; s < seedOff[nb+1]; ++s) {
+      const PetscInt cell = seeds[s];
+
+      if (target[cell-cStart] != rank || queued[cell-cStart] == nb) continue;
+      queued[cell-cStart] = nb;
+      queue[tail++]       = cell;
+    }
+    while (sent < quota[nb] && numSent < numOwned) {
+      PetscInt cell, adjSize = PETSC_DETERMINE, a;
+
+      /* A disconnected local partition can exhaust the front, so restart it from the next cell we still own */
+      if (head == tail) {
+        for (; next < cEnd; ++next) if (cellNum[next-cStart] >= 0 && target[next-cStart] == rank && queued[next-cStart] != nb) break;
+        if (next == cEnd) break;
+        queued[next-cStart] = nb;
+        queue[tail++]       = next;
+      }
+      cell = queue[head++];
+      if (target[cell-cStart] != rank) continue;
+      target[cell-cStart] = nbrs[nb];
+      ++sent; ++numSent;
+      ierr = DMPlexGetAdjacency(dm, cell, &adjSize, &adj);CHKERRQ(ierr);
+      for (a = 0; a < adjSize; ++a) {
+        const PetscInt ac = adj[a];
+
+        if (ac < cStart || ac >= cEnd || cellNum[ac-cStart] < 0) continue;
+        if (target[ac-cStart] != rank || queued[ac-cStart] == nb) continue;
+        queued[ac-cStart] = nb;
+        queue[tail++]     = ac;
+      }
+    }
+  }
+  ierr = DMPlexSetAdjacencyUseCone(dm, useCone);CHKERRQ(ierr);
+  ierr = DMPlexSetAdjacencyUseClosure(dm, useClosure);CHKERRQ(ierr);
+  ierr = PetscFree(adj);CHKERRQ(ierr);
+  ierr = PetscFree3(queue, queued, order);CHKERRQ(ierr);
+  ierr = PetscFree(seeds);CHKERRQ(ierr);
+  ierr = PetscFree2(seedOff, lastSeen);CHKERRQ(ierr);
+  ierr = PetscFree(rootRanks);CHKERRQ(ierr);
+  ierr = PetscFree3(owner, leafRanks, rootOff);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexRebalance"
+/*@C
+  DMPlexRebalance - Incrementally repartition an already distributed mesh, and migrate it
+
+  Collective on DM
+
+  Input Parameter:
+. dm - The non-overlapping distributed DMPlex object
+
+  Output Parameters:
++ numMigrated - The number of cells which changed process, summed over all processes, or NULL
+. sf          - The PetscSF describing the point migration, or NULL
+- dmBalanced  - The rebalanced DMPlex object, or NULL if the mesh was already balanced
+
+  Options Database Key:
+. -dm_plex_rebalance_tol <tol> - The tolerated relative deviation of a local cell count from the mean, default 0.05
+
+  Notes:
+  The number of cells to exchange with each neighboring process is computed by first order diffusion of the cell
+  counts over the graph of processes sharing points, so cells only move between neighbors and the amount migrated is
+  small compared to a fresh partition. The cells sent to a neighbor are grown from the cells touching the interface
+  with it.
+
+  Labels and coordinates are migrated with the mesh, as are the default PetscSection and the PetscDS. Other data
+  can be moved with the returned SF, using DMPlexDistributeField() for a Vec or PetscSFDistributeSection() for a
+  PetscSection. The migration cost is reported in numMigrated and with -info.
+
+  Level: intermediate
+
+.seealso: DMPlexDistribute(), DMPlexMigrate(), DMPlexDistributeField(), DMPlexSetAdaptRebalanceThreshold()
+@*/
+PetscErrorCode DMPlexRebalance(DM dm, PetscInt *numMigrated, PetscSF *sf, DM *dmBalanced)
+{
+  MPI_Comm        comm;
+  PetscMPIInt     rank, numProcs, p, *toranks, *fromranks;
+  PetscSF         sfPoint, sfProcess, sfMigration, sfStratified, sfPointNew;
+  PetscSFNode    *remoteProc;
+  DMLabel         lblPartition, lblMigration;
+  DM              dmCoord;
+  PetscDS         prob;
+  IS              cellNumbering;
+  const PetscInt *cellNum;
+  const PetscSFNode *remotes;
+  PetscInt       *nbrs, *quota, *target, *todata, *fromdata;
+  PetscReal      *flow, tol = 0.05, imbalance = 1.0;
+  PetscInt        nroots, nleaves, nto, nfrom, numNbrs, numOwned = 0, numSend, gnumSend, lsent = 0, gsent, cStart, cEnd, c, l, n;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  if (numMigrated) PetscValidPointer(numMigrated, 2);
+  if (sf) PetscValidPointer(sf, 3);
+  PetscValidPointer(dmBalanced, 4);
+  ierr = PetscObjectGetComm((PetscObject) dm, &comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm, &rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm, &numProcs);CHKERRQ(ierr);
+  *dmBalanced = NULL;
+  if (sf) *sf = NULL;
+  if (numMigrated) *numMigrated = 0;
+  if (numProcs == 1) PetscFunctionReturn(0);
+  ierr = DMGetPointSF(dm, &sfPoint);CHKERRQ(ierr);
+  ierr = PetscSFGetGraph(sfPoint, &nroots, &nleaves, NULL, &remotes);CHKERRQ(ierr);
+  if (nroots < 0) SETERRQ(comm, PETSC_ERR_ARG_WRONGSTATE, "The mesh must be distributed, use DMPlexDistribute()");
+  ierr = PetscLogEventBegin(DMPLEX_Rebalance,dm,0,0,0);CHKERRQ(ierr);
+  ierr = PetscOptionsGetReal(((PetscObject) dm)->prefix, "-dm_plex_rebalance_tol", &tol, NULL);CHKERRQ(ierr);
+  /* The process graph is made symmetric, since only owners know about the processes holding their points */
+  ierr = PetscMalloc2(nleaves, &toranks, nleaves, &todata);CHKERRQ(ierr);
+  for (l = 0; l < nleaves; ++l) toranks[l] = remotes[l].rank;
+  ierr = PetscSortRemoveDupsMPIInt(&nleaves, toranks);CHKERRQ(ierr);
+  nto  = nleaves;
+  for (l = 0; l < nto; ++l) todata[l] = rank;
+  ierr = PetscCommBuildTwoSided(comm, 1, MPIU_INT, nto, toranks, todata, &nfrom, &fromranks, &fromdata);CHKERRQ(ierr);
+  ierr = PetscMalloc1(nto+nfrom, &nbrs);CHKERRQ(ierr);
+  for (n = 0; n < nto;   ++n) nbrs[n]     = toranks[n];
+  for (n = 0; n < nfrom; ++n) nbrs[nto+n] = fromranks[n];
+  numNbrs = nto+nfrom;
+  ierr = PetscSortRemoveDupsInt(&numNbrs, nbrs);CHKERRQ(ierr);
+  ierr = PetscFree2(toranks, todata);CHKERRQ(ierr);
+  ierr = PetscFree(fromranks);CHKERRQ(ierr);
+  ierr = PetscFree(fromdata);CHKERRQ(ierr);
+  /* Compute how many cells go to each neighbor */
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetCellNumbering(dm, &cellNumbering);CHKERRQ(ierr);
+  ierr = ISGetIndices(cellNumbering, &cellNum);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) if (cellNum[c-cStart] >= 0) ++numOwned;
+  ierr = PetscMalloc3(numNbrs, &flow, numNbrs, &quota, cEnd-cStart, &target);CHKERRQ(ierr);
+  ierr = DMPlexRebalanceComputeFlow_Static(dm, numOwned, numNbrs, nbrs, tol, flow, &imbalance);CHKERRQ(ierr);
+  for (n = 0, numSend = 0; n < numNbrs; ++n) {
+    quota[n] = flow[n] > 0.0 ? (PetscInt) PetscFloorReal(flow[n] + 0.5) : 0;
+    numSend += quota[n];
+  }
+  ierr = MPI_Allreduce(&numSend, &gnumSend, 1, MPIU_INT, MPI_SUM, comm);CHKERRQ(ierr);
+  if (!gnumSend) {
+    ierr = PetscInfo1(dm, "Mesh is balanced, cell imbalance %g\n", (double) imbalance);CHKERRQ(ierr);
+    ierr = ISRestoreIndices(cellNumbering, &cellNum);CHKERRQ(ierr);
+    ierr = PetscFree3(flow, quota, target);CHKERRQ(ierr);
+    ierr = PetscFree(nbrs);CHKERRQ(ierr);
+    ierr = PetscLogEventEnd(DMPLEX_Rebalance,dm,0,0,0);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = DMPlexRebalanceSelectCells_Static(dm, cellNum, numNbrs, nbrs, quota, target);CHKERRQ(ierr);
+  /* Convert the new owners to a partition label */
+  ierr = DMLabelCreate("Point Partition", &lblPartition);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {
+    if (cellNum[c-cStart] < 0) continue;
+    ierr = DMLabelSetValue(lblPartition, c, target[c-cStart]);CHKERRQ(ierr);
+    if (target[c-cStart] != rank) ++lsent;
+  }
+  ierr = ISRestoreIndices(cellNumbering, &cellNum);CHKERRQ(ierr);
+  ierr = PetscFree3(flow, quota, target);CHKERRQ(ierr);
+  ierr = PetscFree(nbrs);CHKERRQ(ierr);
+  ierr = MPI_Allreduce(&lsent, &gsent, 1, MPIU_INT, MPI_SUM, comm);CHKERRQ(ierr);
+  ierr = PetscInfo2(dm, "Migrating %D cells to rebalance a cell imbalance of %g\n", gsent, (double) imbalance);CHKERRQ(ierr);
+  ierr = DMPlexPartitionLabelClosure(dm, lblPartition);CHKERRQ(ierr);
+  ierr = PetscMalloc1(numProcs, &remoteProc);CHKERRQ(ierr);
+  for (p = 0; p < numProcs; ++p) {
+    remoteProc[p].rank  = p;
+    remoteProc[p].index = rank;
+  }
+  ierr = PetscSFCreate(comm, &sfProcess);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) sfProcess, "Process SF");CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(sfProcess, numProcs, numProcs, NULL, PETSC_OWN_POINTER, remoteProc, PETSC_OWN_POINTER);CHKERRQ(ierr);
+  ierr = DMLabelCreate("Point migration", &lblMigration);CHKERRQ(ierr);
+  ierr = DMPlexPartitionLabelInvert(dm, lblPartition, sfProcess, lblMigration);CHKERRQ(ierr);
+  ierr = DMPlexPartitionLabelCreateSF(dm, lblMigration, &sfMigration);CHKERRQ(ierr);
+  ierr = DMPlexStratifyMigrationSF(dm, sfMigration, &sfStratified);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sfMigration);CHKERRQ(ierr);
+  sfMigration = sfStratified;
+  ierr = PetscSFDestroy(&sfProcess);CHKERRQ(ierr);
+  ierr = DMLabelDestroy(&lblPartition);CHKERRQ(ierr);
+  ierr = DMLabelDestroy(&lblMigration);CHKERRQ(ierr);
+  /* Migrate the mesh and the data attached to the DM */
+  ierr = DMPlexCreate(comm, dmBalanced);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) *dmBalanced, "Parallel Mesh");CHKERRQ(ierr);
+  ierr = DMPlexMigrate(dm, sfMigration, *dmBalanced);CHKERRQ(ierr);
+  ierr = DMPlexCreatePointSF(*dmBalanced, sfMigration, PETSC_TRUE, &sfPointNew);CHKERRQ(ierr);
+  ierr = DMSetPointSF(*dmBalanced, sfPointNew);CHKERRQ(ierr);
+  ierr = DMGetCoordinateDM(*dmBalanced, &dmCoord);CHKERRQ(ierr);
+  if (dmCoord) {ierr = DMSetPointSF(dmCoord, sfPointNew);CHKERRQ(ierr);}
+  ierr = PetscSFDestroy(&sfPointNew);CHKERRQ(ierr);
+  ierr = DMPlexCopyBoundary(dm, *dmBalanced);CHKERRQ(ierr);
+  ierr = DMGetDS(dm, &prob);CHKERRQ(ierr);
+  ierr = DMSetDS(*dmBalanced, prob);CHKERRQ(ierr);
+  if (dm->defaultSection) {
+    PetscSection section;
+
+    ierr = PetscSectionCreate(comm, &section);CHKERRQ(ierr);
+    ierr = PetscSFDistributeSection(sfMigration, dm->defaultSection, NULL, section);CHKERRQ(ierr);
+    ierr = DMSetDefaultSection(*dmBalanced, section);CHKERRQ(ierr);
+    ierr = PetscSectionDestroy(&section);CHKERRQ(ierr);
+  }
+  if (numMigrated) *numMigrated = gsent;
+  if (sf) *sf = sfMigration;
+  else    {ierr = PetscSFDestroy(&sfMigration);CHKERRQ(ierr);}
+  ierr = PetscLogEventEnd(DMPLEX_Rebalance,dm,0,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -6,6 +6,164 @@
 #include <exodusII.h>
 #endif
 
+#if defined(PETSC_HAVE_EXODUSII)
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexCreateExodus_Parallel_Private"
+/*
+  DMPlexCreateExodus_Parallel_Private - Each process reads a slab of the cells, vertices and vertex sets, using the exoid opened
+  on that process, and the mesh is assembled with DMPlexCreateFromCellListParallel(). The side sets are surface sized, so they
+  are read on the first process and sent to the processes holding their faces.
+*/
+static PetscErrorCode DMPlexCreateExodus_Parallel_Private(MPI_Comm comm, int exoid, PetscBool interpolate, DM *dm)
+{
+  PetscMPIInt    num_proc, rank;
+  PetscSF        vertexSF;
+  double        *vertexCoords;
+  float         *x, *y, *z;
+  int           *cells, *cs_id, *cs_size;
+  PetscInt      *cellValues, *entrySizes, *entryVertices, *entryValues;
+  PetscInt       cStart, cEnd, vStart, vEnd, numEntries, numCorners = -1, c, v, e;
+  PetscErrorCode ierr;
+  /* Read from ex_get_init() */
+  char title[PETSC_MAX_PATH_LEN+1];
+  int  dim    = 0, numVertices = 0, numCells = 0;
+  int  num_cs = 0, num_vs = 0, num_fs = 0;
+  int  cs, off;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_rank(comm, &rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm, &num_proc);CHKERRQ(ierr);
+  ierr = PetscMemzero(title,(PETSC_MAX_PATH_LEN+1)*sizeof(char));CHKERRQ(ierr);
+  ierr = ex_get_init(exoid, title, &dim, &numVertices, &numCells, &num_cs, &num_vs, &num_fs);
+  if (ierr) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"ExodusII ex_get_init() failed with error code %D\n",ierr);
+  if (!num_cs) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Exodus file does not contain any cell set\n");
+  cStart = rank*(numCells/num_proc) + PetscMin(rank, numCells%num_proc);
+  cEnd   = cStart + numCells/num_proc + (numCells%num_proc > rank ? 1 : 0);
+  vStart = rank*(numVertices/num_proc) + PetscMin(rank, numVertices%num_proc);
+  vEnd   = vStart + numVertices/num_proc + (numVertices%num_proc > rank ? 1 : 0);
+  /* Read the pieces of the cell sets overlapping the local cell slab. Cells in cell sets are numbered sequentially. */
+  ierr = PetscMalloc2(num_cs, &cs_id, num_cs, &cs_size);CHKERRQ(ierr);
+  ierr = ex_get_elem_blk_ids(exoid, cs_id);CHKERRQ(ierr);
+  for (cs = 0; cs < num_cs; ++cs) {
+    char buffer[PETSC_MAX_PATH_LEN+1];
+    int  num_vertex_per_cell, num_attr;
+
+    ierr = ex_get_elem_block(exoid, cs_id[cs], buffer, &cs_size[cs], &num_vertex_per_cell, &num_attr);CHKERRQ(ierr);
+    if ((numCorners >= 0) && (num_vertex_per_cell != numCorners)) SETERRQ2(comm, PETSC_ERR_SUP, "Parallel ExodusII reading requires a single cell type, not cells with %D and %d vertices", numCorners, num_vertex_per_cell);
+    numCorners = num_vertex_per_cell;
+  }
+  ierr = PetscMalloc2((cEnd-cStart)*numCorners, &cells, cEnd-cStart, &cellValues);CHKERRQ(ierr);
+  for (cs = 0, off = 0; cs < num_cs; off += cs_size[cs], ++cs) {
+    const PetscInt lo = PetscMax(off, cStart), hi = PetscMin(off+cs_size[cs], cEnd);
+
+    if (lo >= hi) continue;
+    ierr = ex_get_n_elem_conn(exoid, cs_id[cs], lo-off+1, hi-lo, &cells[(lo-cStart)*numCorners]);CHKERRQ(ierr);
+    for (c = lo-cStart; c < hi-cStart; ++c) {
+      int *cone = &cells[c*numCorners];
+
+      /* EXO uses Fortran-based indexing */
+      for (v = 0; v < numCorners; ++v) --cone[v];
+      if (dim == 3) {
+        /* Tetrahedra are inverted */
+        if (numCorners == 4) {
+          int tmp = cone[0];
+          cone[0] = cone[1];
+          cone[1] = tmp;
+        }
+        /* Hexahedra are inverted */
+        if (numCorners == 8) {
+          int tmp = cone[1];
+          cone[1] = cone[3];
+          cone[3] = tmp;
+        }
+      }
+      cellValues[c] = cs_id[cs];
+    }
+  }
+  ierr = PetscFree2(cs_id, cs_size);CHKERRQ(ierr);
+  /* Read the local vertex slab */
+  ierr = PetscMalloc4((vEnd-vStart)*dim, &vertexCoords, vEnd-vStart, &x, vEnd-vStart, &y, vEnd-vStart, &z);CHKERRQ(ierr);
+  if (vEnd > vStart) {ierr = ex_get_n_coord(exoid, vStart+1, vEnd-vStart, x, y, z);CHKERRQ(ierr);}
+  for (v = 0; v < vEnd-vStart; ++v) {
+    if (dim > 0) vertexCoords[v*dim+0] = x[v];
+    if (dim > 1) vertexCoords[v*dim+1] = y[v];
+    if (dim > 2) vertexCoords[v*dim+2] = z[v];
+  }
+  ierr = DMPlexCreateFromCellListParallel(comm, dim, cEnd-cStart, vEnd-vStart, numCorners, interpolate, cells, dim, vertexCoords, &vertexSF, dm);CHKERRQ(ierr);
+  ierr = PetscFree4(vertexCoords, x, y, z);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) *dm, title);CHKERRQ(ierr);
+  /* Local cells keep their order in the slab */
+  ierr = DMPlexCreateLabel(*dm, "Cell Sets");CHKERRQ(ierr);
+  for (c = 0; c < cEnd-cStart; ++c) {ierr = DMPlexSetLabelValue(*dm, "Cell Sets", c, cellValues[c]);CHKERRQ(ierr);}
+  ierr = PetscFree2(cells, cellValues);CHKERRQ(ierr);
+
+  /* Create vertex set label from a slab of each vertex set */
+  if (num_vs > 0) {
+    int *vs_id, *vs_size, *vs_vertex_list, vs, num_attr;
+
+    ierr = PetscMalloc2(num_vs, &vs_id, num_vs, &vs_size);CHKERRQ(ierr);
+    ierr = ex_get_node_set_ids(exoid, vs_id);CHKERRQ(ierr);
+    for (vs = 0, numEntries = 0; vs < num_vs; ++vs) {
+      ierr = ex_get_node_set_param(exoid, vs_id[vs], &vs_size[vs], &num_attr);CHKERRQ(ierr);
+      numEntries += vs_size[vs]/num_proc + (vs_size[vs]%num_proc > rank ? 1 : 0);
+    }
+    ierr = PetscMalloc4(numEntries, &entrySizes, numEntries, &entryVertices, numEntries, &entryValues, numEntries, &vs_vertex_list);CHKERRQ(ierr);
+    for (vs = 0, e = 0; vs < num_vs; ++vs) {
+      const PetscInt start = rank*(vs_size[vs]/num_proc) + PetscMin(rank, vs_size[vs]%num_proc);
+      const PetscInt n     = vs_size[vs]/num_proc + (vs_size[vs]%num_proc > rank ? 1 : 0);
+
+      if (!n) continue;
+      ierr = ex_get_n_node_set(exoid, vs_id[vs], start+1, n, vs_vertex_list);CHKERRQ(ierr);
+      for (v = 0; v < n; ++v, ++e) {
+        entrySizes[e]    = 1;
+        entryVertices[e] = vs_vertex_list[v]-1;
+        entryValues[e]   = vs_id[vs];
+      }
+    }
+    ierr = DMPlexSetLabelFromVertexSlabs_Internal(*dm, vertexSF, "Vertex Sets", numEntries, entrySizes, entryVertices, entryValues);CHKERRQ(ierr);
+    ierr = PetscFree4(entrySizes, entryVertices, entryValues, vs_vertex_list);CHKERRQ(ierr);
+    ierr = PetscFree2(vs_id, vs_size);CHKERRQ(ierr);
+  }
+
+  /* Create side set label */
+  if (interpolate && (num_fs > 0)) {
+    int fs, f, num_side_in_set, num_dist_fact_in_set;
+    int *fs_id = NULL, *fs_vertex_count_list = NULL, *fs_vertex_list = NULL;
+    PetscInt numEntryVertices = 0;
+
+    numEntries = 0;
+    if (!rank) {
+      ierr = PetscMalloc1(num_fs, &fs_id);CHKERRQ(ierr);
+      ierr = ex_get_side_set_ids(exoid, fs_id);CHKERRQ(ierr);
+      for (fs = 0; fs < num_fs; ++fs) {
+        ierr = ex_get_side_set_param(exoid, fs_id[fs], &num_side_in_set, &num_dist_fact_in_set);CHKERRQ(ierr);
+        numEntries += num_side_in_set;
+      }
+    }
+    ierr = PetscMalloc3(numEntries, &entrySizes, numEntries*4, &entryVertices, numEntries, &entryValues);CHKERRQ(ierr);
+    if (!rank) {
+      for (fs = 0, e = 0; fs < num_fs; ++fs) {
+        ierr = ex_get_side_set_param(exoid, fs_id[fs], &num_side_in_set, &num_dist_fact_in_set);CHKERRQ(ierr);
+        ierr = PetscMalloc2(num_side_in_set,&fs_vertex_count_list,num_side_in_set*4,&fs_vertex_list);CHKERRQ(ierr);
+        ierr = ex_get_side_set_node_list(exoid, fs_id[fs], fs_vertex_count_list, fs_vertex_list);CHKERRQ(ierr);
+        for (f = 0, off = 0; f < num_side_in_set; ++f, ++e) {
+          if (fs_vertex_count_list[f] > 4) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "ExodusII side cannot have %d > 4 vertices", fs_vertex_count_list[f]);
+          entrySizes[e]  = fs_vertex_count_list[f];
+          entryValues[e] = fs_id[fs];
+          for (v = 0; v < entrySizes[e]; ++v, ++off) entryVertices[numEntryVertices++] = fs_vertex_list[off]-1;
+        }
+        ierr = PetscFree2(fs_vertex_count_list,fs_vertex_list);CHKERRQ(ierr);
+      }
+      ierr = PetscFree(fs_id);CHKERRQ(ierr);
+    }
+    ierr = DMPlexSetLabelFromVertexSlabs_Internal(*dm, vertexSF, "Face Sets", numEntries, entrySizes, entryVertices, entryValues);CHKERRQ(ierr);
+    ierr = PetscFree3(entrySizes, entryVertices, entryValues);CHKERRQ(ierr);
+  }
+  ierr = PetscSFDestroy(&vertexSF);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+#endif
+
 #undef __FUNCT__
 #define __FUNCT__ "DMPlexCreateExodusFromFile"
 /*@C
@@ -21,14 +179,21 @@
   Output Parameter:
 . dm  - The DM object representing the mesh
 
+  Options Database:
+. -dm_plex_exodus_parallel - Every process reads a slab of the file, and the mesh is built with DMPlexCreateFromCellListParallel()
+
+  Note: When reading in parallel, all cells must have the same shape, and the resulting mesh is only balanced in size, so it
+  should be redistributed with DMPlexDistribute().
+
   Level: beginner
 
 .keywords: mesh,ExodusII
-.seealso: DMPLEX, DMCreate(), DMPlexCreateExodus()
+.seealso: DMPLEX, DMCreate(), DMPlexCreateExodus(), DMPlexCreateFromCellListParallel(), DMPlexDistribute()
 @*/
 PetscErrorCode DMPlexCreateExodusFromFile(MPI_Comm comm, const char filename[], PetscBool interpolate, DM *dm)
 {
   PetscMPIInt    rank;
+  PetscBool      parallel = PETSC_FALSE;
   PetscErrorCode ierr;
 #if defined(PETSC_HAVE_EXODUSII)
   int   CPU_word_size = 0, IO_word_size = 0, exoid = -1;
@@ -38,13 +203,15 @@ PetscErrorCode DMPlexCreateExodusFromFile(MPI_Comm comm, const char filename[],
   PetscFunctionBegin;
   PetscValidCharPointer(filename, 2);
   ierr = MPI_Comm_rank(comm, &rank);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL, "-dm_plex_exodus_parallel", &parallel, NULL);CHKERRQ(ierr);
 #if defined(PETSC_HAVE_EXODUSII)
-  if (!rank) {
+  if (!rank || parallel) {
     exoid = ex_open(filename, EX_READ, &CPU_word_size, &IO_word_size, &version);
     if (exoid <= 0) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_LIB, "ex_open(\"%s\",...) did not return a valid file ID", filename);
   }
-  ierr = DMPlexCreateExodus(comm, exoid, interpolate, dm);CHKERRQ(ierr);
-  if (!rank) {ierr = ex_close(exoid);CHKERRQ(ierr);}
+  if (parallel) {ierr = DMPlexCreateExodus_Parallel_Private(comm, exoid, interpolate, dm);CHKERRQ(ierr);}
+  else          {ierr = DMPlexCreateExodus(comm, exoid, interpolate, dm);CHKERRQ(ierr);}
+  if (!rank || parallel) {ierr = ex_close(exoid);CHKERRQ(ierr);}
 #else
   SETERRQ(comm, PETSC_ERR_SUP, "This method requires ExodusII support. Reconfigure using --download-exodusii");
 #endif
@@ -63,6 +63,296 @@ PetscErrorCode DMPlexCreateGmshFromFile(MPI_Comm comm, const char filename[], Pe
 }
 
 
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexCreateGmsh_ReadHeader_Private"
+static PetscErrorCode DMPlexCreateGmsh_ReadHeader_Private(PetscViewer viewer, PetscBool binary, PetscBool *bswap)
+{
+  char           line[PETSC_MAX_PATH_LEN];
+  int            fileType, dataSize, snum;
+  float          version;
+  PetscBool      match;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  *bswap = PETSC_FALSE;
+  ierr = PetscViewerRead(viewer, line, 1, NULL, PETSC_STRING);CHKERRQ(ierr);
+  ierr = PetscStrncmp(line, "$MeshFormat", PETSC_MAX_PATH_LEN, &match);CHKERRQ(ierr);
+  if (!match) SETERRQ(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "File is not a valid Gmsh file");
+  ierr = PetscViewerRead(viewer, line, 3, NULL, PETSC_STRING);CHKERRQ(ierr);
+  snum = sscanf(line, "%f %d %d", &version, &fileType, &dataSize);
+  if (snum != 3) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Unable to parse Gmsh file header: %s", line);
+  if (version < 2.0) SETERRQ(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Gmsh file must be at least version 2.0");
+  if (dataSize != sizeof(double)) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Data size %d is not valid for a Gmsh file", dataSize);
+  if (binary) {
+    int checkInt;
+    ierr = PetscViewerRead(viewer, &checkInt, 1, NULL, PETSC_ENUM);CHKERRQ(ierr);
+    if (checkInt != 1) {
+      ierr = PetscByteSwap(&checkInt, PETSC_ENUM, 1);CHKERRQ(ierr);
+      if (checkInt == 1) *bswap = PETSC_TRUE;
+      else SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "File type %d is not a valid Gmsh binary file", fileType);
+    }
+  } else if (fileType) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "File type %d is not a valid Gmsh ASCII file", fileType);
+  ierr = PetscViewerRead(viewer, line, 1, NULL, PETSC_STRING);CHKERRQ(ierr);
+  ierr = PetscStrncmp(line, "$EndMeshFormat", PETSC_MAX_PATH_LEN, &match);CHKERRQ(ierr);
+  if (!match) SETERRQ(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "File is not a valid Gmsh file");
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexCreateGmsh_ReadSection_Private"
+/* Reads a section marker, such as $Nodes, and the count following it if requested */
+static PetscErrorCode DMPlexCreateGmsh_ReadSection_Private(PetscViewer viewer, const char marker[], PetscInt *count)
+{
+  char           line[PETSC_MAX_PATH_LEN];
+  int            n, snum;
+  PetscBool      match;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscViewerRead(viewer, line, 1, NULL, PETSC_STRING);CHKERRQ(ierr);
+  ierr = PetscStrncmp(line, marker, PETSC_MAX_PATH_LEN, &match);CHKERRQ(ierr);
+  if (!match) SETERRQ(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "File is not a valid Gmsh file");
+  if (count) {
+    ierr = PetscViewerRead(viewer, line, 1, NULL, PETSC_STRING);CHKERRQ(ierr);
+    snum = sscanf(line, "%d", &n);
+    if (snum != 1) SETERRQ(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "File is not a valid Gmsh file");
+    *count = n;
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexCreateGmsh_ReadNodes_Private"
+/* Reads the coordinates of the next numVertices nodes, starting with node number vStart+1 */
+static PetscErrorCode DMPlexCreateGmsh_ReadNodes_Private(PetscViewer viewer, PetscBool binary, PetscBool bswap, PetscInt vStart, PetscInt numVertices, double coords[])
+{
+  PetscInt       v;
+  int            i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (binary) {
+    size_t doubleSize, intSize;
+    PetscInt elementSize;
+    char *buffer;
+    ierr = PetscDataTypeGetSize(PETSC_ENUM, &intSize);CHKERRQ(ierr);
+    ierr = PetscDataTypeGetSize(PETSC_DOUBLE, &doubleSize);CHKERRQ(ierr);
+    elementSize = (intSize + 3*doubleSize);
+    ierr = PetscMalloc1(elementSize*numVertices, &buffer);CHKERRQ(ierr);
+    ierr = PetscViewerRead(viewer, buffer, elementSize*numVertices, NULL, PETSC_CHAR);CHKERRQ(ierr);
+    if (bswap) {ierr = PetscByteSwap(buffer, PETSC_CHAR, elementSize*numVertices);CHKERRQ(ierr);}
+    for (v = 0; v < numVertices; ++v) {
+      ierr = PetscMemcpy(&coords[v*3], buffer+v*elementSize+intSize, 3*doubleSize);CHKERRQ(ierr);
+    }
+    ierr = PetscFree(buffer);CHKERRQ(ierr);
+  } else {
+    for (v = 0; v < numVertices; ++v) {
+      ierr = PetscViewerRead(viewer, &i, 1, NULL, PETSC_ENUM);CHKERRQ(ierr);
+      ierr = PetscViewerRead(viewer, &(coords[v*3]), 3, NULL, PETSC_DOUBLE);CHKERRQ(ierr);
+      if (i != (int)(vStart+v)+1) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Invalid node number %d should be %d", i, vStart+v+1);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexCreateGmsh_ReadElements_Private"
+/*
+  Reads the next numCells elements. The binary format stores elements in blocks of the same type, and block holds the
+  type, remaining size, and number of tags of the current block, so that a block can be read across several calls.
+*/
+static PetscErrorCode DMPlexCreateGmsh_ReadElements_Private(PetscViewer viewer, PetscInt numCells, PetscBool binary, PetscBool byteSwap, int block[], GmshElement elements[])
+{
+  PetscInt       c, p;
+  int            cellType, dim, numNodes, numTags;
+  int            ibuf[16];
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (c = 0; c < numCells; ++c) {
+    if (binary) {
+      if (!block[1]) {
+        ierr = PetscViewerRead(viewer, block, 3, NULL, PETSC_ENUM);CHKERRQ(ierr);
+        if (byteSwap) {ierr = PetscByteSwap(block, PETSC_ENUM, 3);CHKERRQ(ierr);}
+      }
+      cellType = block[0];
+      numTags  = block[2];
+      --block[1];
+    } else {
+      ierr = PetscViewerRead(viewer, &ibuf, 3, NULL, PETSC_ENUM);CHKERRQ(ierr);
+      elements[c].id = ibuf[0];
+      cellType = ibuf[1];
+      numTags = ibuf[2];
+    }
+    switch (cellType) {
+    case 1: /* 2-node line */
+      dim = 1;
+      numNodes = 2;
+      break;
+    case 2: /* 3-node triangle */
+      dim = 2;
+      numNodes = 3;
+      break;
+    case 3: /* 4-node quadrangle */
+      dim = 2;
+      numNodes = 4;
+      break;
+    case 4: /* 4-node tetrahedron */
+      dim  = 3;
+      numNodes = 4;
+      break;
+    case 5: /* 8-node hexahedron */
+      dim = 3;
+      numNodes = 8;
+      break;
+    case 15: /* 1-node vertex */
+      dim = 0;
+      numNodes = 1;
+      break;
+    default:
+      SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Unsupported Gmsh element type %d", cellType);
+    }
+    elements[c].dim = dim;
+    elements[c].numNodes = numNodes;
+    elements[c].numTags = numTags;
+    if (binary) {
+      const PetscInt nint = numNodes + numTags + 1;
+
+      ierr = PetscViewerRead(viewer, &ibuf, nint, NULL, PETSC_ENUM);CHKERRQ(ierr);
+      if (byteSwap) {ierr = PetscByteSwap(&ibuf, PETSC_ENUM, nint);CHKERRQ(ierr);}
+      elements[c].id = ibuf[0];
+      for (p = 0; p < numTags; p++) elements[c].tags[p] = ibuf[1 + p];
+      for (p = 0; p < numNodes; p++) elements[c].nodes[p] = ibuf[1 + numTags + p];
+    } else {
+      ierr = PetscViewerRead(viewer, elements[c].tags, elements[c].numTags, NULL, PETSC_ENUM);CHKERRQ(ierr);
+      ierr = PetscViewerRead(viewer, elements[c].nodes, elements[c].numNodes, NULL, PETSC_ENUM);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexCreateGmsh_Parallel_Private"
+/*
+  The first process reads the file through its own viewer and streams it out in slabs, so that process p receives the
+  p-th contiguous slab of the nodes and of the elements, and no process holds more than two slabs.
+*/
+static PetscErrorCode DMPlexCreateGmsh_Parallel_Private(MPI_Comm comm, PetscViewer viewer, PetscBool interpolate, DM *dm)
+{
+  PetscViewer     vroot = NULL;
+  PetscViewerType vtype;
+  GmshElement    *elements, *elemBuf = NULL;
+  PetscSF         vertexSF;
+  double         *vertexCoords, *coordBuf = NULL;
+  int            *cells;
+  PetscInt       *facetSizes, *facetVertices, *facetValues;
+  PetscInt        counts[2] = {0, 0}, numVertices, numElements, numCells, numFacets, numFacetVertices, numCorners[2], dim = 0, c, v, d, n;
+  PetscBool       binary, bswap = PETSC_FALSE;
+  PetscMPIInt     rank, numProcs, r;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_rank(comm, &rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm, &numProcs);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(DMPLEX_CreateGmsh,0,0,0,0);CHKERRQ(ierr);
+  ierr = PetscViewerGetType(viewer, &vtype);CHKERRQ(ierr);
+  ierr = PetscStrcmp(vtype, PETSCVIEWERBINARY, &binary);CHKERRQ(ierr);
+  if (!rank) {
+    const char *filename;
+
+    ierr = PetscViewerFileGetName(viewer, &filename);CHKERRQ(ierr);
+    ierr = PetscViewerCreate(PETSC_COMM_SELF, &vroot);CHKERRQ(ierr);
+    ierr = PetscViewerSetType(vroot, vtype);CHKERRQ(ierr);
+    ierr = PetscViewerFileSetMode(vroot, FILE_MODE_READ);CHKERRQ(ierr);
+    ierr = PetscViewerFileSetName(vroot, filename);CHKERRQ(ierr);
+    ierr = DMPlexCreateGmsh_ReadHeader_Private(vroot, binary, &bswap);CHKERRQ(ierr);
+    ierr = DMPlexCreateGmsh_ReadSection_Private(vroot, "$Nodes", &counts[0]);CHKERRQ(ierr);
+  }
+  ierr = MPI_Bcast(counts, 1, MPIU_INT, 0, comm);CHKERRQ(ierr);
+  /* Stream the nodes */
+  numVertices = counts[0]/numProcs + (counts[0]%numProcs > rank ? 1 : 0);
+  ierr = PetscMalloc1(numVertices*3, &vertexCoords);CHKERRQ(ierr);
+  if (!rank) {
+    PetscInt vStart = 0;
+
+    ierr = PetscMalloc1((counts[0]/numProcs+1)*3, &coordBuf);CHKERRQ(ierr);
+    for (r = 0; r < numProcs; ++r) {
+      n = counts[0]/numProcs + (counts[0]%numProcs > r ? 1 : 0);
+      ierr = DMPlexCreateGmsh_ReadNodes_Private(vroot, binary, bswap, vStart, n, r ? coordBuf : vertexCoords);CHKERRQ(ierr);
+      if (r) {ierr = MPI_Send(coordBuf, (PetscMPIInt) n*3, MPI_DOUBLE, r, 0, comm);CHKERRQ(ierr);}
+      vStart += n;
+    }
+    ierr = PetscFree(coordBuf);CHKERRQ(ierr);
+    ierr = DMPlexCreateGmsh_ReadSection_Private(vroot, "$EndNodes", NULL);CHKERRQ(ierr);
+    ierr = DMPlexCreateGmsh_ReadSection_Private(vroot, "$Elements", &counts[1]);CHKERRQ(ierr);
+  } else {
+    ierr = MPI_Recv(vertexCoords, (PetscMPIInt) numVertices*3, MPI_DOUBLE, 0, 0, comm, MPI_STATUS_IGNORE);CHKERRQ(ierr);
+  }
+  ierr = MPI_Bcast(&counts[1], 1, MPIU_INT, 0, comm);CHKERRQ(ierr);
+  /* Stream the elements, reading binary element blocks across slab boundaries */
+  numElements = counts[1]/numProcs + (counts[1]%numProcs > rank ? 1 : 0);
+  ierr = PetscMalloc1(numElements, &elements);CHKERRQ(ierr);
+  if (!rank) {
+    int block[3] = {0, 0, 0};
+
+    ierr = PetscMalloc1(counts[1]/numProcs+1, &elemBuf);CHKERRQ(ierr);
+    for (r = 0; r < numProcs; ++r) {
+      n = counts[1]/numProcs + (counts[1]%numProcs > r ? 1 : 0);
+      ierr = DMPlexCreateGmsh_ReadElements_Private(vroot, n, binary, bswap, block, r ? elemBuf : elements);CHKERRQ(ierr);
+      if (r) {ierr = MPI_Send(elemBuf, (PetscMPIInt) (n*sizeof(GmshElement)), MPI_BYTE, r, 0, comm);CHKERRQ(ierr);}
+    }
+    ierr = PetscFree(elemBuf);CHKERRQ(ierr);
+    ierr = DMPlexCreateGmsh_ReadSection_Private(vroot, "$EndElements", NULL);CHKERRQ(ierr);
+    ierr = PetscViewerDestroy(&vroot);CHKERRQ(ierr);
+  } else {
+    ierr = MPI_Recv(elements, (PetscMPIInt) (numElements*sizeof(GmshElement)), MPI_BYTE, 0, 0, comm, MPI_STATUS_IGNORE);CHKERRQ(ierr);
+  }
+  /* The elements of the highest dimension are the cells, which must all have the same shape */
+  for (c = 0; c < numElements; ++c) dim = PetscMax(dim, elements[c].dim);
+  ierr = MPI_Allreduce(MPI_IN_PLACE, &dim, 1, MPIU_INT, MPI_MAX, comm);CHKERRQ(ierr);
+  numCorners[0] = 0; numCorners[1] = -PETSC_MAX_INT;
+  for (numCells = 0, numFacets = 0, numFacetVertices = 0, c = 0; c < numElements; ++c) {
+    if (elements[c].dim == dim) {
+      numCorners[0] = PetscMax(numCorners[0], elements[c].numNodes);
+      numCorners[1] = PetscMax(numCorners[1], -elements[c].numNodes);
+      ++numCells;
+    } else if (elements[c].dim == dim-1) {
+      numFacetVertices += elements[c].numNodes;
+      ++numFacets;
+    }
+  }
+  ierr = MPI_Allreduce(MPI_IN_PLACE, numCorners, 2, MPIU_INT, MPI_MAX, comm);CHKERRQ(ierr);
+  if (numCorners[0] != -numCorners[1]) SETERRQ2(comm, PETSC_ERR_SUP, "Parallel Gmsh reading requires a single cell type, not cells with %D and %D vertices", -numCorners[1], numCorners[0]);
+  ierr = PetscMalloc1(numCells*numCorners[0], &cells);CHKERRQ(ierr);
+  ierr = PetscMalloc3(numFacets, &facetSizes, numFacetVertices, &facetVertices, numFacets, &facetValues);CHKERRQ(ierr);
+  for (numCells = 0, numFacets = 0, numFacetVertices = 0, c = 0; c < numElements; ++c) {
+    if (elements[c].dim == dim) {
+      for (v = 0; v < elements[c].numNodes; ++v) cells[numCells*numCorners[0]+v] = elements[c].nodes[v]-1;
+      ++numCells;
+    } else if (elements[c].dim == dim-1) {
+      for (v = 0; v < elements[c].numNodes; ++v) facetVertices[numFacetVertices++] = elements[c].nodes[v]-1;
+      facetSizes[numFacets]  = elements[c].numNodes;
+      facetValues[numFacets] = elements[c].tags[0];
+      ++numFacets;
+    }
+  }
+  ierr = PetscFree(elements);CHKERRQ(ierr);
+  /* Gmsh always stores three coordinates */
+  for (v = 0; v < numVertices; ++v) {
+    for (d = 0; d < dim; ++d) vertexCoords[v*dim+d] = vertexCoords[v*3+d];
+  }
+  ierr = DMPlexCreateFromCellListParallel(comm, dim, numCells, numVertices, numCorners[0], interpolate, cells, dim, vertexCoords, &vertexSF, dm);CHKERRQ(ierr);
+  /* Apply boundary IDs by finding the relevant facets with vertex joins */
+  ierr = MPI_Allreduce(MPI_IN_PLACE, &numFacetVertices, 1, MPIU_INT, MPI_SUM, comm);CHKERRQ(ierr);
+  if (numFacetVertices) {ierr = DMPlexSetLabelFromVertexSlabs_Internal(*dm, vertexSF, "Face Sets", numFacets, facetSizes, facetVertices, facetValues);CHKERRQ(ierr);}
+  ierr = PetscFree3(facetSizes, facetVertices, facetValues);CHKERRQ(ierr);
+  ierr = PetscFree(cells);CHKERRQ(ierr);
+  ierr = PetscFree(vertexCoords);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&vertexSF);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(DMPLEX_CreateGmsh,0,0,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "DMPlexCreateGmsh"
 /*@
@@ -78,13 +368,20 @@ PetscErrorCode DMPlexCreateGmshFromFile(MPI_Comm comm, const char filename[], Pe
   Output Parameter:
 . dm  - The DM object representing the mesh
 
+  Options Database:
+. -dm_plex_gmsh_parallel - Give each process a contiguous slab of the nodes and elements, instead of building the whole mesh on the first process
+
   Note: http://www.geuz.org/gmsh/doc/texinfo/#MSH-ASCII-file-format
   and http://www.geuz.org/gmsh/doc/texinfo/#MSH-binary-file-format
 
+  With -dm_plex_gmsh_parallel the file is still read by the first process, but it is streamed out one slab at a time,
+  so no process holds the whole mesh. The slabs are not a good partition, so the mesh should be balanced with
+  DMPlexDistribute(). All cells must have the same type.
+
   Level: beginner
 
 .keywords: mesh,Gmsh
-.seealso: DMPLEX, DMCreate()
+.seealso: DMPLEX, DMCreate(), DMPlexCreateFromCellListParallel(), DMPlexDistribute()
 @*/
 PetscErrorCode DMPlexCreateGmsh(MPI_Comm comm, PetscViewer viewer, PetscBool interpolate, DM *dm)
 {
@@ -92,15 +389,21 @@ PetscErrorCode DMPlexCreateGmsh(MPI_Comm comm, PetscViewer viewer, PetscBool int
   GmshElement   *gmsh_elem;
   PetscSection   coordSection;
   Vec            coordinates;
-  PetscScalar   *coords, *coordsIn = NULL;
+  PetscScalar   *coords;
+  double        *coordsIn = NULL;
   PetscInt       dim = 0, coordSize, c, v, d, cell;
-  int            i, numVertices = 0, numCells = 0, trueNumCells = 0, snum;
+  int            numVertices = 0, numCells = 0, trueNumCells = 0, snum;
   PetscMPIInt    num_proc, rank;
   char           line[PETSC_MAX_PATH_LEN];
-  PetscBool      match, binary, bswap = PETSC_FALSE;
+  PetscBool      match, binary, bswap = PETSC_FALSE, parallel = PETSC_FALSE;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
+  ierr = PetscOptionsGetBool(NULL, "-dm_plex_gmsh_parallel", &parallel, NULL);CHKERRQ(ierr);
+  if (parallel) {
+    ierr = DMPlexCreateGmsh_Parallel_Private(comm, viewer, interpolate, dm);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = MPI_Comm_rank(comm, &rank);CHKERRQ(ierr);
   ierr = MPI_Comm_size(comm, &num_proc);CHKERRQ(ierr);
   ierr = DMCreate(comm, dm);CHKERRQ(ierr);
@@ -110,30 +413,8 @@ PetscErrorCode DMPlexCreateGmsh(MPI_Comm comm, PetscViewer viewer, PetscBool int
   ierr = PetscStrcmp(vtype, PETSCVIEWERBINARY, &binary);CHKERRQ(ierr);
   if (!rank || binary) {
     PetscBool match;
-    int       fileType, dataSize;
-    float     version;
 
-    /* Read header */
-    ierr = PetscViewerRead(viewer, line, 1, NULL, PETSC_STRING);CHKERRQ(ierr);
-    ierr = PetscStrncmp(line, "$MeshFormat", PETSC_MAX_PATH_LEN, &match);CHKERRQ(ierr);
-    if (!match) SETERRQ(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "File is not a valid Gmsh file");
-    ierr = PetscViewerRead(viewer, line, 3, NULL, PETSC_STRING);CHKERRQ(ierr);
-    snum = sscanf(line, "%f %d %d", &version, &fileType, &dataSize);
-    if (snum != 3) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Unable to parse Gmsh file header: %s", line);
-    if (version < 2.0) SETERRQ(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Gmsh file must be at least version 2.0");
-    if (dataSize != sizeof(double)) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Data size %d is not valid for a Gmsh file", dataSize);
-    if (binary) {
-      int checkInt;
-      ierr = PetscViewerRead(viewer, &checkInt, 1, NULL, PETSC_ENUM);CHKERRQ(ierr);
-      if (checkInt != 1) {
-        ierr = PetscByteSwap(&checkInt, PETSC_ENUM, 1);CHKERRQ(ierr);
-        if (checkInt == 1) bswap = PETSC_TRUE;
-        else SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "File type %d is not a valid Gmsh binary file", fileType);
-      }
-    } else if (fileType) SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "File type %d is not a valid Gmsh ASCII file", fileType);
-    ierr = PetscViewerRead(viewer, line, 1, NULL, PETSC_STRING);CHKERRQ(ierr);
-    ierr = PetscStrncmp(line, "$EndMeshFormat", PETSC_MAX_PATH_LEN, &match);CHKERRQ(ierr);
-    if (!match) SETERRQ(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "File is not a valid Gmsh file");
+    ierr = DMPlexCreateGmsh_ReadHeader_Private(viewer, binary, &bswap);CHKERRQ(ierr);
     /* Read vertices */
     ierr = PetscViewerRead(viewer, line, 1, NULL, PETSC_STRING);CHKERRQ(ierr);
     ierr = PetscStrncmp(line, "$Nodes", PETSC_MAX_PATH_LEN, &match);CHKERRQ(ierr);
@@ -142,31 +423,7 @@ PetscErrorCode DMPlexCreateGmsh(MPI_Comm comm, PetscViewer viewer, PetscBool int
     snum = sscanf(line, "%d", &numVertices);
     if (snum != 1) SETERRQ(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "File is not a valid Gmsh file");
     ierr = PetscMalloc1(numVertices*3, &coordsIn);CHKERRQ(ierr);
-    if (binary) {
-      size_t doubleSize, intSize;
-      PetscInt elementSize;
-      char *buffer;
-      PetscScalar *baseptr;
-      ierr = PetscDataTypeGetSize(PETSC_ENUM, &intSize);CHKERRQ(ierr);
-      ierr = PetscDataTypeGetSize(PETSC_DOUBLE, &doubleSize);CHKERRQ(ierr);
-      elementSize = (intSize + 3*doubleSize);
-      ierr = PetscMalloc1(elementSize*numVertices, &buffer);CHKERRQ(ierr);
-      ierr = PetscViewerRead(viewer, buffer, elementSize*numVertices, NULL, PETSC_CHAR);CHKERRQ(ierr);
-      if (bswap) ierr = PetscByteSwap(buffer, PETSC_CHAR, elementSize*numVertices);CHKERRQ(ierr);
-      for (v = 0; v < numVertices; ++v) {
-        baseptr = ((PetscScalar*)(buffer+v*elementSize+intSize));
-        coordsIn[v*3+0] = baseptr[0];
-        coordsIn[v*3+1] = baseptr[1];
-        coordsIn[v*3+2] = baseptr[2];
-      }
-      ierr = PetscFree(buffer);CHKERRQ(ierr);
-    } else {
-      for (v = 0; v < numVertices; ++v) {
-        ierr = PetscViewerRead(viewer, &i, 1, NULL, PETSC_ENUM);CHKERRQ(ierr);
-        ierr = PetscViewerRead(viewer, &(coordsIn[v*3]), 3, NULL, PETSC_DOUBLE);CHKERRQ(ierr);
-        if (i != (int)v+1) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Invalid node number %d should be %d", i, v+1);
-      }
-    }
+    ierr = DMPlexCreateGmsh_ReadNodes_Private(viewer, binary, bswap, 0, numVertices, coordsIn);CHKERRQ(ierr);
     ierr = PetscViewerRead(viewer, line, 1, NULL, PETSC_STRING);CHKERRQ(ierr);;
     ierr = PetscStrncmp(line, "$EndNodes", PETSC_MAX_PATH_LEN, &match);CHKERRQ(ierr);
     if (!match) SETERRQ(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "File is not a valid Gmsh file");
@@ -288,78 +545,13 @@ PetscErrorCode DMPlexCreateGmsh(MPI_Comm comm, PetscViewer viewer, PetscBool int
 #define __FUNCT__ "DMPlexCreateGmsh_ReadElement"
 PetscErrorCode DMPlexCreateGmsh_ReadElement(PetscViewer viewer, PetscInt numCells, PetscBool binary, PetscBool byteSwap, GmshElement **gmsh_elems)
 {
-  PetscInt       c, p;
   GmshElement   *elements;
-  int            i, cellType, dim, numNodes, numElem, numTags;
-  int            ibuf[16];
+  int            block[3] = {0, 0, 0};
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
   ierr = PetscMalloc1(numCells, &elements);CHKERRQ(ierr);
-  for (c = 0; c < numCells;) {
-    ierr = PetscViewerRead(viewer, &ibuf, 3, NULL, PETSC_ENUM);CHKERRQ(ierr);
-    if (byteSwap) ierr = PetscByteSwap(&ibuf, PETSC_ENUM, 3);CHKERRQ(ierr);
-    if (binary) {
-      cellType = ibuf[0];
-      numElem = ibuf[1];
-      numTags = ibuf[2];
-    } else {
-      elements[c].id = ibuf[0];
-      cellType = ibuf[1];
-      numTags = ibuf[2];
-      numElem = 1;
-    }
-    switch (cellType) {
-    case 1: /* 2-node line */
-      dim = 1;
-      numNodes = 2;
-      break;
-    case 2: /* 3-node triangle */
-      dim = 2;
-      numNodes = 3;
-      break;
-    case 3: /* 4-node quadrangle */
-      dim = 2;
-      numNodes = 4;
-      break;
-    case 4: /* 4-node tetrahedron */
-      dim  = 3;
-      numNodes = 4;
-      break;
-    case 5: /* 8-node hexahedron */
-      dim = 3;
-      numNodes = 8;
-      break;
-    case 15: /* 1-node vertex */
-      dim = 0;
-      numNodes = 1;
-      break;
-    default:
-      SETERRQ1(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Unsupported Gmsh element type %d", cellType);
-    }
-    if (binary) {
-      const PetscInt nint = numNodes + numTags + 1;
-      for (i = 0; i < numElem; ++i, ++c) {
-        /* Loop over inner binary element block */
-        elements[c].dim = dim;
-        elements[c].numNodes = numNodes;
-        elements[c].numTags = numTags;
-
-        ierr = PetscViewerRead(viewer, &ibuf, nint, NULL, PETSC_ENUM);CHKERRQ(ierr);
-        if (byteSwap) ierr = PetscByteSwap( &ibuf, PETSC_ENUM, nint);CHKERRQ(ierr);
-        elements[c].id = ibuf[0];
-        for (p = 0; p < numTags; p++) elements[c].tags[p] = ibuf[1 + p];
-        for (p = 0; p < numNodes; p++) elements[c].nodes[p] = ibuf[1 + numTags + p];
-      }
-    } else {
-      elements[c].dim = dim;
-      elements[c].numNodes = numNodes;
-      elements[c].numTags = numTags;
-      ierr = PetscViewerRead(viewer, elements[c].tags, elements[c].numTags, NULL, PETSC_ENUM);CHKERRQ(ierr);
-      ierr = PetscViewerRead(viewer, elements[c].nodes, elements[c].numNodes, NULL, PETSC_ENUM);CHKERRQ(ierr);
-      c++;
-    }
-  }
+  ierr = DMPlexCreateGmsh_ReadElements_Private(viewer, numCells, binary, byteSwap, block, elements);CHKERRQ(ierr);
   *gmsh_elems = elements;
   PetscFunctionReturn(0);
 }
@@ -73,3 +73,225 @@ PetscErrorCode DMPlexCreateClosureIndex(DM dm, PetscSection section)
   ierr = PetscSectionSetClosureIndex(section, (PetscObject) dm, closureSection, closureIS);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexSetUseClosureDofIndex"
+/*@
+  DMPlexSetUseClosureDofIndex - Index the dofs in the closure of each cell the first time a closure operation needs them
+
+  Not collective
+
+  Input Parameters:
++ dm  - The DM
+- use - PETSC_TRUE to build the index
+
+  Options Database Key:
+. -dm_plex_closure_dof_index - Index the dofs in the closure of each cell
+
+  Note:
+  The index makes DMPlexVecGetClosures(), DMPlexVecSetClosures() and DMPlexMatSetClosures() a single indexed copy, at the
+  cost of storing the dofs in the closure of every cell for each section used. It is off by default.
+
+  Level: intermediate
+
+.seealso DMPlexGetUseClosureDofIndex(), DMPlexCreateClosureIndex(), DMPlexVecGetClosures(), DMPlexMatSetClosures()
+@*/
+PetscErrorCode DMPlexSetUseClosureDofIndex(DM dm, PetscBool use)
+{
+  DM_Plex *mesh = (DM_Plex *) dm->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  mesh->closureDofIndex = use;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexGetUseClosureDofIndex"
+/*@
+  DMPlexGetUseClosureDofIndex - Query whether the dofs in the closure of each cell are indexed
+
+  Not collective
+
+  Input Parameter:
+. dm  - The DM
+
+  Output Parameter:
+. use - PETSC_TRUE if the index is built
+
+  Level: intermediate
+
+.seealso DMPlexSetUseClosureDofIndex(), DMPlexCreateClosureIndex()
+@*/
+PetscErrorCode DMPlexGetUseClosureDofIndex(DM dm, PetscBool *use)
+{
+  DM_Plex *mesh = (DM_Plex *) dm->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  PetscValidIntPointer(use, 2);
+  *use = mesh->closureDofIndex;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexCreateClosureDofIndex_Private"
+/* Flatten the dofs in the closure of each cell, in the order used by DMPlexVecGetClosure() and DMPlexMatSetClosure(). If
+   globalSection is given the indices are global, as passed to MatSetValues(), and otherwise they are local offsets. */
+static PetscErrorCode DMPlexCreateClosureDofIndex_Private(DM dm, PetscSection section, PetscSection globalSection)
+{
+  PetscInt      *clOff, *clDofs;
+  PetscInt       numFields, pStart, pEnd, cStart, cEnd, c;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscSectionGetNumFields(section, &numFields);CHKERRQ(ierr);
+  ierr = PetscSectionGetChart(section, &pStart, &pEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  ierr = PetscMalloc1(cEnd-cStart+1, &clOff);CHKERRQ(ierr);
+  clOff[0] = 0;
+  for (c = cStart; c < cEnd; ++c) {
+    PetscInt *points = NULL, numPoints, p, dof, size = 0;
+
+    ierr = DMPlexGetTransitiveClosure(dm, c, PETSC_TRUE, &numPoints, &points);CHKERRQ(ierr);
+    for (p = 0; p < numPoints*2; p += 2) {
+      if ((points[p] < pStart) || (points[p] >= pEnd)) continue;
+      ierr = PetscSectionGetDof(section, points[p], &dof);CHKERRQ(ierr);
+      size += dof;
+    }
+    ierr = DMPlexRestoreTransitiveClosure(dm, c, PETSC_TRUE, &numPoints, &points);CHKERRQ(ierr);
+    clOff[c-cStart+1] = clOff[c-cStart] + size;
+  }
+  ierr = PetscMalloc1(clOff[cEnd-cStart], &clDofs);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {
+    PetscInt *points = NULL, *dofs = &clDofs[clOff[c-cStart]];
+    PetscInt  numPoints, p, q;
+
+    ierr = DMPlexGetTransitiveClosure(dm, c, PETSC_TRUE, &numPoints, &points);CHKERRQ(ierr);
+    /* Compress out points not in the section */
+    for (p = 0, q = 0; p < numPoints*2; p += 2) {
+      if ((points[p] >= pStart) && (points[p] < pEnd)) {
+        points[q*2]   = points[p];
+        points[q*2+1] = points[p+1];
+        ++q;
+      }
+    }
+    numPoints = q;
+    if (globalSection) {
+      PetscInt globalOff, off = 0;
+
+      if (numFields) {
+        PetscInt foffs[32], fdof, f;
+
+        ierr = PetscMemzero(foffs, 32 * sizeof(PetscInt));CHKERRQ(ierr);
+        for (p = 0; p < numPoints*2; p += 2) {
+          for (f = 0; f < numFields; ++f) {
+            ierr = PetscSectionGetFieldDof(section, points[p], f, &fdof);CHKERRQ(ierr);
+            foffs[f+1] += fdof;
+          }
+        }
+        for (f = 1; f < numFields; ++f) foffs[f+1] += foffs[f];
+        for (p = 0; p < numPoints*2; p += 2) {
+          ierr = PetscSectionGetOffset(globalSection, points[p], &globalOff);CHKERRQ(ierr);
+          ierr = indicesPointFields_private(section, points[p], globalOff < 0 ? -(globalOff+1) : globalOff, foffs, PETSC_FALSE, points[p+1], dofs);CHKERRQ(ierr);
+        }
+      } else {
+        for (p = 0; p < numPoints*2; p += 2) {
+          ierr = PetscSectionGetOffset(globalSection, points[p], &globalOff);CHKERRQ(ierr);
+          ierr = indicesPoint_private(section, points[p], globalOff < 0 ? -(globalOff+1) : globalOff, &off, PETSC_FALSE, points[p+1], dofs);CHKERRQ(ierr);
+        }
+      }
+    } else if (numFields) {
+      PetscInt offset = 0, f;
+
+      for (f = 0; f < numFields; ++f) {
+        PetscInt fcomp;
+
+        ierr = PetscSectionGetFieldComponents(section, f, &fcomp);CHKERRQ(ierr);
+        for (p = 0; p < numPoints*2; p += 2) {
+          const PetscInt  o = points[p+1];
+          const PetscInt *fcdofs;
+          PetscInt        fdof, fcdof, foff, cind = 0, k;
+
+          ierr = PetscSectionGetFieldDof(section, points[p], f, &fdof);CHKERRQ(ierr);
+          ierr = PetscSectionGetFieldOffset(section, points[p], f, &foff);CHKERRQ(ierr);
+          ierr = PetscSectionGetFieldConstraintDof(section, points[p], f, &fcdof);CHKERRQ(ierr);
+          if (fcdof) {ierr = PetscSectionGetFieldConstraintIndices(section, points[p], f, &fcdofs);CHKERRQ(ierr);}
+          for (k = 0; k < fdof; ++k) {
+            const PetscInt loc = o >= 0 ? k : (fdof/fcomp-1-k/fcomp)*fcomp + k%fcomp;
+
+            if ((cind < fcdof) && (k == fcdofs[cind])) {dofs[offset+loc] = -(foff+k+1); ++cind;}
+            else                                       {dofs[offset+loc] = foff+k;}
+          }
+          offset += fdof;
+        }
+      }
+    } else {
+      PetscInt offset = 0;
+
+      for (p = 0; p < numPoints*2; p += 2) {
+        const PetscInt  o = points[p+1];
+        const PetscInt *cdofs;
+        PetscInt        dof, cdof, off, cind = 0, k;
+
+        ierr = PetscSectionGetDof(section, points[p], &dof);CHKERRQ(ierr);
+        ierr = PetscSectionGetOffset(section, points[p], &off);CHKERRQ(ierr);
+        ierr = PetscSectionGetConstraintDof(section, points[p], &cdof);CHKERRQ(ierr);
+        if (cdof) {ierr = PetscSectionGetConstraintIndices(section, points[p], &cdofs);CHKERRQ(ierr);}
+        for (k = 0; k < dof; ++k) {
+          const PetscInt loc = o >= 0 ? k : dof-k-1;
+
+          if ((cind < cdof) && (k == cdofs[cind])) {dofs[offset+loc] = -(off+k+1); ++cind;}
+          else                                     {dofs[offset+loc] = off+k;}
+        }
+        offset += dof;
+      }
+    }
+    ierr = DMPlexRestoreTransitiveClosure(dm, c, PETSC_TRUE, &numPoints, &points);CHKERRQ(ierr);
+  }
+  ierr = PetscSectionSetClosureDofIndex(globalSection ? globalSection : section, (PetscObject) dm, cStart, cEnd, clOff, clDofs);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexGetClosureDofIndex_Internal"
+/*
+  DMPlexGetClosureDofIndex_Internal - Get the dofs in the closure of each cell, building the index if necessary
+
+  Input Parameters:
++ dm            - The DM
+. section       - The local section
+- globalSection - The global section, or NULL for local offsets
+
+  Output Parameters:
++ cStart  - The first cell in the index
+. cEnd    - One past the last cell in the index, so that the range is empty if there is no index
+. clOff   - The offset of the closure of cell c in clDofs is clOff[c-cStart]
+- clDofs  - The dofs in each closure, with orientations applied and constrained dofs stored as -(dof+1)
+
+  Note: The index is only built if it has been turned on with DMPlexSetUseClosureDofIndex() or -dm_plex_closure_dof_index,
+  and not if global indices are requested for a section which is not the default or for a mesh with anchors, since then
+  DMPlexMatSetClosure() must modify the element matrix. A section holds the index for a single DM, so if it is shared
+  with another DM, for example a clone, the index is rebuilt each time the DM using it changes.
+*/
+PetscErrorCode DMPlexGetClosureDofIndex_Internal(DM dm, PetscSection section, PetscSection globalSection, PetscInt *cStart, PetscInt *cEnd, const PetscInt *clOff[], const PetscInt *clDofs[])
+{
+  DM_Plex       *mesh   = (DM_Plex *) dm->data;
+  PetscSection   target = globalSection ? globalSection : section, aSec;
+  PetscInt       numFields;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscSectionGetClosureDofIndex(target, (PetscObject) dm, cStart, cEnd, clOff, clDofs);CHKERRQ(ierr);
+  if ((*cEnd > *cStart) || !mesh->closureDofIndex) PetscFunctionReturn(0);
+  if (globalSection) {
+    if (section != dm->defaultSection) PetscFunctionReturn(0);
+    ierr = PetscSectionGetNumFields(section, &numFields);CHKERRQ(ierr);
+    if (numFields > 31) PetscFunctionReturn(0);
+    ierr = DMPlexGetAnchors(dm, &aSec, NULL);CHKERRQ(ierr);
+    if (aSec) PetscFunctionReturn(0);
+  }
+  ierr = DMPlexCreateClosureDofIndex_Private(dm, section, globalSection);CHKERRQ(ierr);
+  ierr = PetscSectionGetClosureDofIndex(target, (PetscObject) dm, cStart, cEnd, clOff, clDofs);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
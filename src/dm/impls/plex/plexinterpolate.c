@@ -140,19 +140,45 @@ PetscErrorCode DMPlexGetRawFaces_Internal(DM dm, PetscInt dim, PetscInt coneSize
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexGetCanonicalFace_Private"
+/*
+  Orders the vertices of a face independently of the cell it was extracted from: the vertex with the smallest
+  global number comes first, followed by its neighbor with the smaller global number. This makes the cone of
+  a face shared between processes identical on all of them. Only faces whose vertices are all shared, which have
+  nonnegative vertexNumbers, can be shared, so the others are left as they are and isCanon is set to PETSC_FALSE.
+*/
+static PetscErrorCode DMPlexGetCanonicalFace_Private(PetscInt faceSize, const PetscInt face[], PetscInt vStart, const PetscInt vertexNumbers[], PetscInt canonFace[], PetscBool *isCanon)
+{
+  PetscInt i, m = 0;
+
+  PetscFunctionBegin;
+  *isCanon = PETSC_FALSE;
+  for (i = 0; i < faceSize; ++i) if (vertexNumbers[face[i]-vStart] < 0) PetscFunctionReturn(0);
+  *isCanon = PETSC_TRUE;
+  for (i = 1; i < faceSize; ++i) if (vertexNumbers[face[i]-vStart] < vertexNumbers[face[m]-vStart]) m = i;
+  if ((faceSize == 2) || (vertexNumbers[face[(m+1)%faceSize]-vStart] < vertexNumbers[face[(m+faceSize-1)%faceSize]-vStart])) {
+    for (i = 0; i < faceSize; ++i) canonFace[i] = face[(m+i)%faceSize];
+  } else {
+    for (i = 0; i < faceSize; ++i) canonFace[i] = face[(m+faceSize-i)%faceSize];
+  }
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "DMPlexInterpolateFaces_Internal"
-/* This interpolates faces for cells at some stratum */
-static PetscErrorCode DMPlexInterpolateFaces_Internal(DM dm, PetscInt cellDepth, DM idm)
+/* This interpolates faces for cells at some stratum, vertexNumbers gives global numbers of the shared vertices, and -1 for the others, to orient shared faces consistently in parallel */
+static PetscErrorCode DMPlexInterpolateFaces_Internal(DM dm, PetscInt cellDepth, const PetscInt vertexNumbers[], DM idm)
 {
   DMLabel        subpointMap;
   PetscHashIJKL  faceTable;
   PetscInt      *pStart, *pEnd;
-  PetscInt       cellDim, depth, faceDepth = cellDepth, numPoints = 0, faceSizeAll = 0, face, c, d;
+  PetscInt       cellDim, depth, faceDepth = cellDepth, numPoints = 0, faceSizeAll = 0, face, c, d, vStart;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
   ierr = DMGetDimension(dm, &cellDim);CHKERRQ(ierr);
+  ierr = DMPlexGetDepthStratum(dm, 0, &vStart, NULL);CHKERRQ(ierr);
   /* HACK: I need a better way to determine face dimension, or an alternative to GetFaces() */
   ierr = DMPlexGetSubpointMap(dm, &subpointMap);CHKERRQ(ierr);
   if (subpointMap) ++cellDim;
@@ -249,6 +275,8 @@ static PetscErrorCode DMPlexInterpolateFaces_Internal(DM dm, PetscInt cellDepth,
     if (faceSize != faceSizeAll) SETERRQ3(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Inconsistent face for cell %D of size %D != %D", c, faceSize, faceSizeAll);
     for (cf = 0; cf < numCellFaces; ++cf) {
       const PetscInt  *cellFace = &cellFaces[cf*faceSize];
+      PetscInt         canonFace[4];
+      PetscBool        isCanon = PETSC_FALSE;
       PetscHashIJKLKey key;
       PetscHashIJKLIter missing, iter;
 
@@ -262,7 +290,8 @@ static PetscErrorCode DMPlexInterpolateFaces_Internal(DM dm, PetscInt cellDepth,
         ierr = PetscSortInt(faceSize, (PetscInt *) &key);CHKERRQ(ierr);
       }
       ierr = PetscHashIJKLPut(faceTable, key, &missing, &iter);CHKERRQ(ierr);
-      if (missing) {
+      if (missing && vertexNumbers) {ierr = DMPlexGetCanonicalFace_Private(faceSize, cellFace, vStart, vertexNumbers, canonFace, &isCanon);CHKERRQ(ierr);}
+      if (missing && !isCanon) {
         ierr = DMPlexSetCone(idm, face, cellFace);CHKERRQ(ierr);
         ierr = PetscHashIJKLSet(faceTable, iter, face);CHKERRQ(ierr);
         ierr = DMPlexInsertCone(idm, c, cf, face++);CHKERRQ(ierr);
@@ -270,7 +299,14 @@ static PetscErrorCode DMPlexInterpolateFaces_Internal(DM dm, PetscInt cellDepth,
         const PetscInt *cone;
         PetscInt        coneSize, ornt, i, j, f;
 
-        ierr = PetscHashIJKLGet(faceTable, iter, &f);CHKERRQ(ierr);
+        if (missing) {
+          /* The face is oriented globally, so even its first cell may see it with a nonzero orientation */
+          ierr = DMPlexSetCone(idm, face, canonFace);CHKERRQ(ierr);
+          ierr = PetscHashIJKLSet(faceTable, iter, face);CHKERRQ(ierr);
+          f    = face++;
+        } else {
+          ierr = PetscHashIJKLGet(faceTable, iter, &f);CHKERRQ(ierr);
+        }
         ierr = DMPlexInsertCone(idm, c, cf, f);CHKERRQ(ierr);
         /* Orient face: Do not allow reverse orientation at the first vertex */
         ierr = DMPlexGetConeSize(idm, f, &coneSize);CHKERRQ(ierr);
@@ -305,6 +341,174 @@ static PetscErrorCode DMPlexInterpolateFaces_Internal(DM dm, PetscInt cellDepth,
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexInterpolatePointSF_Private"
+/*
+  DMPlexInterpolatePointSF_Private - Extends the point SF of a distributed cell-vertex mesh to the faces and edges created by interpolation
+
+  The points of dm keep their numbers in idm, and vertexNumbers holds the global numbers of the shared vertices and -1
+  for the others. A new point can only be shared if all its vertices are shared, so each process sends these points,
+  keyed by the sorted global numbers of their vertices, to the owner of the smallest vertex.
+  There the lowest process holding a point is chosen as its owner, and the answer is returned to all processes holding it.
+*/
+static PetscErrorCode DMPlexInterpolatePointSF_Private(DM dm, const PetscInt vertexNumbers[], DM idm)
+{
+  MPI_Comm           comm;
+  PetscMPIInt        rank, numProcs, r;
+  PetscSF            sfPoint, sfPointInt, sfProcess;
+  PetscSFNode       *remoteProc, *owners, *remotePointsInt;
+  PetscSection       keySection, answerSection;
+  PetscLayout        vertexLayout;
+  PetscHashIJKL      keyTable;
+  MPI_Datatype       keyType, answerType;
+  const PetscSFNode *remotePoints;
+  const PetscInt    *localPoints;
+  PetscInt          *keys, *recvKeys, *answers, *recvAnswers, *localPointsInt;
+  PetscInt           numRoots, numLeaves, numLeavesInt, numOwned, numKeys, numRecv, pStart, pEnd, pEndOld, vStart, vEnd, p, l, k, n;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject) dm, &comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm, &rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm, &numProcs);CHKERRQ(ierr);
+  ierr = DMGetPointSF(dm, &sfPoint);CHKERRQ(ierr);
+  ierr = PetscSFGetGraph(sfPoint, &numRoots, &numLeaves, &localPoints, &remotePoints);CHKERRQ(ierr);
+  ierr = DMPlexGetChart(dm, NULL, &pEndOld);CHKERRQ(ierr);
+  ierr = DMPlexGetChart(idm, &pStart, &pEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetDepthStratum(dm, 0, &vStart, &vEnd);CHKERRQ(ierr);
+  for (numOwned = vEnd-vStart, l = 0; l < numLeaves; ++l) {
+    const PetscInt q = localPoints ? localPoints[l] : l;
+
+    if ((q >= vStart) && (q < vEnd)) --numOwned;
+  }
+  ierr = PetscLayoutCreate(comm, &vertexLayout);CHKERRQ(ierr);
+  ierr = PetscLayoutSetLocalSize(vertexLayout, numOwned);CHKERRQ(ierr);
+  ierr = PetscLayoutSetBlockSize(vertexLayout, 1);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(vertexLayout);CHKERRQ(ierr);
+  /* Key every new point whose vertices are all shared with the sorted global vertex numbers, and send it to the owner of the first vertex */
+  ierr = PetscSectionCreate(comm, &keySection);CHKERRQ(ierr);
+  ierr = PetscSectionSetChart(keySection, 0, numProcs);CHKERRQ(ierr);
+  ierr = PetscMalloc1((pEnd-pEndOld)*5, &keys);CHKERRQ(ierr);
+  for (numKeys = 0, p = pEndOld; p < pEnd; ++p) {
+    PetscInt *closure = NULL, closureSize, cl, numVerts = 0, *key = &keys[numKeys*5];
+    PetscBool isShared = PETSC_TRUE;
+
+    ierr = DMPlexGetTransitiveClosure(idm, p, PETSC_TRUE, &closureSize, &closure);CHKERRQ(ierr);
+    for (cl = 0; cl < closureSize*2; cl += 2) {
+      const PetscInt q = closure[cl];
+
+      if ((q < vStart) || (q >= vEnd)) continue;
+      if ((vertexNumbers[q-vStart] < 0) || (numVerts >= 4)) {isShared = PETSC_FALSE; break;}
+      key[numVerts++] = vertexNumbers[q-vStart];
+    }
+    ierr = DMPlexRestoreTransitiveClosure(idm, p, PETSC_TRUE, &closureSize, &closure);CHKERRQ(ierr);
+    if (!isShared) continue;
+    ierr = PetscSortInt(numVerts, key);CHKERRQ(ierr);
+    for (k = numVerts; k < 4; ++k) key[k] = -1;
+    key[4] = p;
+    ++numKeys;
+  }
+  /* Keys are packed by destination */
+  {
+    PetscInt *sorted, *perm, *dest;
+
+    ierr = PetscMalloc3(numKeys*5, &sorted, numKeys, &perm, numKeys, &dest);CHKERRQ(ierr);
+    for (k = 0; k < numKeys; ++k) {
+      PetscInt owner;
+
+      ierr = PetscLayoutFindOwner(vertexLayout, keys[k*5], &owner);CHKERRQ(ierr);
+      dest[k] = owner;
+      perm[k] = k;
+      ierr = PetscSectionAddDof(keySection, owner, 1);CHKERRQ(ierr);
+    }
+    ierr = PetscSortIntWithArray(numKeys, dest, perm);CHKERRQ(ierr);
+    for (k = 0; k < numKeys; ++k) {ierr = PetscMemcpy(&sorted[k*5], &keys[perm[k]*5], 5*sizeof(PetscInt));CHKERRQ(ierr);}
+    ierr = PetscMemcpy(keys, sorted, numKeys*5*sizeof(PetscInt));CHKERRQ(ierr);
+    ierr = PetscFree3(sorted, perm, dest);CHKERRQ(ierr);
+  }
+  ierr = PetscSectionSetUp(keySection);CHKERRQ(ierr);
+  ierr = PetscLayoutDestroy(&vertexLayout);CHKERRQ(ierr);
+  /* Build a global process SF */
+  ierr = PetscMalloc1(numProcs, &remoteProc);CHKERRQ(ierr);
+  for (r = 0; r < numProcs; ++r) {
+    remoteProc[r].rank  = r;
+    remoteProc[r].index = rank;
+  }
+  ierr = PetscSFCreate(comm, &sfProcess);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(sfProcess, numProcs, numProcs, NULL, PETSC_OWN_POINTER, remoteProc, PETSC_OWN_POINTER);CHKERRQ(ierr);
+  ierr = MPI_Type_contiguous(5, MPIU_INT, &keyType);CHKERRQ(ierr);
+  ierr = MPI_Type_commit(&keyType);CHKERRQ(ierr);
+  ierr = MPI_Type_contiguous(3, MPIU_INT, &answerType);CHKERRQ(ierr);
+  ierr = MPI_Type_commit(&answerType);CHKERRQ(ierr);
+  ierr = PetscSectionCreate(comm, &answerSection);CHKERRQ(ierr);
+  ierr = DMPlexDistributeData(idm, sfProcess, keySection, keyType, keys, answerSection, (void **) &recvKeys);CHKERRQ(ierr);
+  /* The first process sending a key, the lowest rank, owns the point */
+  ierr = PetscSectionGetStorageSize(answerSection, &numRecv);CHKERRQ(ierr);
+  ierr = PetscMalloc1(numRecv*3, &answers);CHKERRQ(ierr);
+  ierr = PetscHashIJKLCreate(&keyTable);CHKERRQ(ierr);
+  for (r = 0; r < numProcs; ++r) {
+    PetscInt dof, off;
+
+    ierr = PetscSectionGetDof(answerSection, r, &dof);CHKERRQ(ierr);
+    ierr = PetscSectionGetOffset(answerSection, r, &off);CHKERRQ(ierr);
+    for (k = off; k < off+dof; ++k) {
+      const PetscInt   *key = &recvKeys[k*5];
+      PetscHashIJKLKey  hkey;
+      PetscHashIJKLIter missing, iter;
+      PetscInt          first;
+
+      hkey.i = key[0]; hkey.j = key[1]; hkey.k = key[2]; hkey.l = key[3];
+      ierr = PetscHashIJKLPut(keyTable, hkey, &missing, &iter);CHKERRQ(ierr);
+      answers[k*3+0] = key[4];
+      if (missing) {
+        ierr = PetscHashIJKLSet(keyTable, iter, k);CHKERRQ(ierr);
+        answers[k*3+1] = r;
+        answers[k*3+2] = key[4];
+      } else {
+        ierr = PetscHashIJKLGet(keyTable, iter, &first);CHKERRQ(ierr);
+        answers[k*3+1] = answers[first*3+1];
+        answers[k*3+2] = answers[first*3+2];
+      }
+    }
+  }
+  ierr = PetscHashIJKLDestroy(&keyTable);CHKERRQ(ierr);
+  ierr = PetscFree(recvKeys);CHKERRQ(ierr);
+  ierr = PetscSectionDestroy(&keySection);CHKERRQ(ierr);
+  ierr = PetscSectionCreate(comm, &keySection);CHKERRQ(ierr);
+  ierr = DMPlexDistributeData(idm, sfProcess, answerSection, answerType, answers, keySection, (void **) &recvAnswers);CHKERRQ(ierr);
+  ierr = PetscSectionGetStorageSize(keySection, &numRecv);CHKERRQ(ierr);
+  /* Combine the original leaves with the new ones */
+  ierr = PetscMalloc1(pEnd-pStart, &owners);CHKERRQ(ierr);
+  for (p = pStart; p < pEnd; ++p) {owners[p-pStart].rank = -1; owners[p-pStart].index = -1;}
+  for (l = 0; l < numLeaves; ++l) owners[(localPoints ? localPoints[l] : l)-pStart] = remotePoints[l];
+  for (k = 0; k < numRecv; ++k) {
+    if (recvAnswers[k*3+1] == rank) continue;
+    owners[recvAnswers[k*3+0]-pStart].rank  = recvAnswers[k*3+1];
+    owners[recvAnswers[k*3+0]-pStart].index = recvAnswers[k*3+2];
+  }
+  for (numLeavesInt = 0, p = pStart; p < pEnd; ++p) if (owners[p-pStart].rank >= 0) ++numLeavesInt;
+  ierr = PetscMalloc1(numLeavesInt, &localPointsInt);CHKERRQ(ierr);
+  ierr = PetscMalloc1(numLeavesInt, &remotePointsInt);CHKERRQ(ierr);
+  for (n = 0, p = pStart; p < pEnd; ++p) {
+    if (owners[p-pStart].rank < 0) continue;
+    localPointsInt[n]  = p;
+    remotePointsInt[n] = owners[p-pStart];
+    ++n;
+  }
+  ierr = DMGetPointSF(idm, &sfPointInt);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(sfPointInt, pEnd-pStart, numLeavesInt, localPointsInt, PETSC_OWN_POINTER, remotePointsInt, PETSC_OWN_POINTER);CHKERRQ(ierr);
+  ierr = PetscFree(owners);CHKERRQ(ierr);
+  ierr = PetscFree(recvAnswers);CHKERRQ(ierr);
+  ierr = PetscFree(answers);CHKERRQ(ierr);
+  ierr = PetscFree(keys);CHKERRQ(ierr);
+  ierr = PetscSectionDestroy(&keySection);CHKERRQ(ierr);
+  ierr = PetscSectionDestroy(&answerSection);CHKERRQ(ierr);
+  ierr = MPI_Type_free(&keyType);CHKERRQ(ierr);
+  ierr = MPI_Type_free(&answerType);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sfProcess);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "DMPlexInterpolate"
 /*@C
@@ -319,21 +523,61 @@ static PetscErrorCode DMPlexInterpolateFaces_Internal(DM dm, PetscInt cellDepth,
   Output Parameter:
 . dmInt - The complete DMPlex object
 
+  Note: The mesh may be distributed. If the point SF of a distributed cell-vertex mesh shares points, it is extended
+  to the new faces and edges. In this case faces whose vertices are all shared get their cones ordered by the global
+  vertex numbers, instead of following the first cell containing them, so that they are identical on all processes.
+  Meshes that are not distributed, or that share no points, are interpolated as before.
+
   Level: intermediate
 
 .keywords: mesh
-.seealso: DMPlexUninterpolate(), DMPlexCreateFromCellList()
+.seealso: DMPlexUninterpolate(), DMPlexCreateFromCellList(), DMPlexCreateFromCellListParallel()
 @*/
 PetscErrorCode DMPlexInterpolate(DM dm, DM *dmInt)
 {
   DM             idm, odm = dm;
-  PetscInt       depth, dim, d;
+  PetscSF        sfPoint;
+  PetscInt      *vertexNumbers = NULL;
+  PetscInt       depth, dim, d, numRoots, numLeaves, local[2], global[2];
+  PetscMPIInt    numProcs;
+  PetscBool      distributed = PETSC_FALSE;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
   ierr = PetscLogEventBegin(DMPLEX_Interpolate,dm,0,0,0);CHKERRQ(ierr);
   ierr = DMPlexGetDepth(dm, &depth);CHKERRQ(ierr);
   ierr = DMGetDimension(dm, &dim);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(PetscObjectComm((PetscObject) dm), &numProcs);CHKERRQ(ierr);
+  ierr = DMGetPointSF(dm, &sfPoint);CHKERRQ(ierr);
+  ierr = PetscSFGetGraph(sfPoint, &numRoots, &numLeaves, NULL, NULL);CHKERRQ(ierr);
+  if ((numProcs > 1) && (numRoots >= 0)) {
+    /* An empty local mesh has depth -1, and a mesh with no shared points needs no parallel treatment */
+    local[0] = depth;
+    local[1] = numLeaves > 0 ? 1 : 0;
+    ierr = MPI_Allreduce(local, global, 2, MPIU_INT, MPI_MAX, PetscObjectComm((PetscObject) dm));CHKERRQ(ierr);
+    distributed = (dim > 1) && (global[0] == 1) && global[1] ? PETSC_TRUE : PETSC_FALSE;
+  }
+  if (distributed) {
+    IS              globalVertexNumbers;
+    const PetscInt *gv, *degree, *localPoints;
+    PetscInt        vStart, vEnd, v, l;
+
+    /* Shared faces are oriented by the global numbers of their vertices, the other vertices are marked with -1 */
+    ierr = DMPlexGetDepthStratum(dm, 0, &vStart, &vEnd);CHKERRQ(ierr);
+    ierr = PetscSFGetGraph(sfPoint, NULL, NULL, &localPoints, NULL);CHKERRQ(ierr);
+    ierr = PetscSFComputeDegreeBegin(sfPoint, &degree);CHKERRQ(ierr);
+    ierr = PetscSFComputeDegreeEnd(sfPoint, &degree);CHKERRQ(ierr);
+    ierr = DMPlexGetVertexNumbering(dm, &globalVertexNumbers);CHKERRQ(ierr);
+    ierr = ISGetIndices(globalVertexNumbers, &gv);CHKERRQ(ierr);
+    ierr = PetscMalloc1(vEnd-vStart, &vertexNumbers);CHKERRQ(ierr);
+    for (v = 0; v < vEnd-vStart; ++v) vertexNumbers[v] = degree[v+vStart] > 0 ? gv[v] : -1;
+    for (l = 0; l < numLeaves; ++l) {
+      const PetscInt q = localPoints ? localPoints[l] : l;
+
+      if ((q >= vStart) && (q < vEnd)) vertexNumbers[q-vStart] = -(gv[q-vStart]+1);
+    }
+    ierr = ISRestoreIndices(globalVertexNumbers, &gv);CHKERRQ(ierr);
+  }
   if (dim <= 1) {
     ierr = PetscObjectReference((PetscObject) dm);CHKERRQ(ierr);
     idm  = dm;
@@ -344,10 +588,20 @@ PetscErrorCode DMPlexInterpolate(DM dm, DM *dmInt)
     else                        {ierr = DMCreate(PetscObjectComm((PetscObject)dm), &idm);CHKERRQ(ierr);}
     ierr = DMSetType(idm, DMPLEX);CHKERRQ(ierr);
     ierr = DMSetDimension(idm, dim);CHKERRQ(ierr);
-    if (depth > 0) {ierr = DMPlexInterpolateFaces_Internal(odm, 1, idm);CHKERRQ(ierr);}
+    if (depth > 0) {ierr = DMPlexInterpolateFaces_Internal(odm, 1, vertexNumbers, idm);CHKERRQ(ierr);}
+    else if (depth < 0) {
+      /* A process with an empty mesh still takes part in building the point SF */
+      ierr = DMPlexSetChart(idm, 0, 0);CHKERRQ(ierr);
+      ierr = DMSetUp(idm);CHKERRQ(ierr);
+      ierr = DMPlexStratify(idm);CHKERRQ(ierr);
+    }
     if (odm != dm) {ierr = DMDestroy(&odm);CHKERRQ(ierr);}
     odm  = idm;
   }
+  if (distributed) {
+    ierr = DMPlexInterpolatePointSF_Private(dm, vertexNumbers, idm);CHKERRQ(ierr);
+    ierr = PetscFree(vertexNumbers);CHKERRQ(ierr);
+  }
   *dmInt = idm;
   ierr = PetscLogEventEnd(DMPLEX_Interpolate,dm,0,0,0);CHKERRQ(ierr);
   PetscFunctionReturn(0);
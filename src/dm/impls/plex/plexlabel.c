@@ -18,6 +18,8 @@ PetscErrorCode DMLabelCreate(const char name[], DMLabel *label)
   (*label)->stratumSizes   = NULL;
   (*label)->points         = NULL;
   (*label)->ht             = NULL;
+  (*label)->valueht        = NULL;
+  (*label)->pointht        = NULL;
   (*label)->pStart         = -1;
   (*label)->pEnd           = -1;
   (*label)->bt             = NULL;
@@ -86,6 +88,75 @@ static PetscErrorCode DMLabelMakeInvalid_Private(DMLabel label, PetscInt v)
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "DMLabelLookupStratum_Private"
+/* Get the stratum index for a value, or -1 if the value is not present */
+static PetscErrorCode DMLabelLookupStratum_Private(DMLabel label, PetscInt value, PetscInt *index)
+{
+  PetscInt v;
+
+  PetscFunctionBegin;
+  if (!label->valueht) {
+    PetscHashICreate(label->valueht);
+    for (v = label->numStrata-1; v >= 0; --v) PetscHashIAdd(label->valueht, label->stratumValues[v], v);
+  }
+  PetscHashIMap(label->valueht, value, v);
+  *index = v;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMLabelStratumContains_Private"
+static PetscErrorCode DMLabelStratumContains_Private(DMLabel label, PetscInt v, PetscInt point, PetscBool *contains)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (label->arrayValid[v]) {
+    PetscInt i;
+
+    ierr = PetscFindInt(point, label->stratumSizes[v], label->points[v], &i);CHKERRQ(ierr);
+    *contains = i >= 0 ? PETSC_TRUE : PETSC_FALSE;
+  } else {
+    PetscHashIHasKey(label->ht[v], point, *contains);
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMLabelCreatePointIndex_Private"
+/* Map each point to the first stratum containing it, which is the value returned by DMLabelGetValue() */
+static PetscErrorCode DMLabelCreatePointIndex_Private(DMLabel label)
+{
+  PetscInt       v, p, n = 0;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (label->pointht) PetscFunctionReturn(0);
+  ierr = DMLabelMakeAllValid_Private(label);CHKERRQ(ierr);
+  for (v = 0; v < label->numStrata; ++v) n += label->stratumSizes[v];
+  PetscHashICreate(label->pointht);
+  PetscHashIResize(label->pointht, n);
+  for (v = label->numStrata-1; v >= 0; --v) {
+    for (p = 0; p < label->stratumSizes[v]; ++p) PetscHashIAdd(label->pointht, label->points[v][p], v);
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMLabelPointIndexAdd_Private"
+/* Record that the point is now in stratum v */
+static PetscErrorCode DMLabelPointIndexAdd_Private(DMLabel label, PetscInt point, PetscInt v)
+{
+  PetscInt w;
+
+  PetscFunctionBegin;
+  if (!label->pointht) PetscFunctionReturn(0);
+  PetscHashIMap(label->pointht, point, w);
+  if (w < 0 || v < w) PetscHashIAdd(label->pointht, point, v);
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "DMLabelAddStratum_Private"
 static PetscErrorCode DMLabelAddStratum_Private(DMLabel label, PetscInt value)
@@ -111,6 +182,7 @@ static PetscErrorCode DMLabelAddStratum_Private(DMLabel label, PetscInt value)
   }
   tmpV[v] = value;
   tmpS[v] = 0;
+  if (label->valueht) PetscHashIAdd(label->valueht, value, v);
   PetscHashICreate(tmpH[v]);
   tmpP[v] = NULL;
   tmpB[v] = PETSC_TRUE;
@@ -213,6 +285,8 @@ PetscErrorCode DMLabelDestroy(DMLabel *label)
     for (v = 0; v < (*label)->numStrata; ++v) {PetscHashIDestroy((*label)->ht[v]);}
     ierr = PetscFree((*label)->ht);CHKERRQ(ierr);
   }
+  PetscHashIDestroy((*label)->valueht);
+  PetscHashIDestroy((*label)->pointht);
   ierr = PetscBTDestroy(&(*label)->bt);CHKERRQ(ierr);
   ierr = PetscFree(*label);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -250,9 +324,11 @@ PetscErrorCode DMLabelDuplicate(DMLabel label, DMLabel *labelnew)
       }
     }
   }
-  (*labelnew)->pStart = -1;
-  (*labelnew)->pEnd   = -1;
-  (*labelnew)->bt     = NULL;
+  (*labelnew)->valueht = NULL;
+  (*labelnew)->pointht = NULL;
+  (*labelnew)->pStart  = -1;
+  (*labelnew)->pEnd    = -1;
+  (*labelnew)->bt      = NULL;
   PetscFunctionReturn(0);
 }
 
@@ -315,14 +391,13 @@ PetscErrorCode DMLabelDestroyIndex(DMLabel label)
 @*/
 PetscErrorCode DMLabelHasValue(DMLabel label, PetscInt value, PetscBool *contains)
 {
-  PetscInt v;
+  PetscInt       v;
+  PetscErrorCode ierr;
 
   PetscFunctionBegin;
   PetscValidPointer(contains, 3);
-  for (v = 0; v < label->numStrata; ++v) {
-    if (value == label->stratumValues[v]) break;
-  }
-  *contains = (v < label->numStrata ? PETSC_TRUE : PETSC_FALSE);
+  ierr = DMLabelLookupStratum_Private(label, value, &v);CHKERRQ(ierr);
+  *contains = v < 0 ? PETSC_FALSE : PETSC_TRUE;
   PetscFunctionReturn(0);
 }
 
@@ -384,27 +459,8 @@ PetscErrorCode DMLabelStratumHasPoint(DMLabel label, PetscInt value, PetscInt po
   PetscFunctionBegin;
   PetscValidPointer(contains, 4);
   *contains = PETSC_FALSE;
-  for (v = 0; v < label->numStrata; ++v) {
-    if (label->stratumValues[v] == value) {
-      if (label->arrayValid[v]) {
-        PetscInt i;
-
-        ierr = PetscFindInt(point, label->stratumSizes[v], &label->points[v][0], &i);CHKERRQ(ierr);
-        if (i >= 0) {
-          *contains = PETSC_TRUE;
-          break;
-        }
-      } else {
-        PetscBool has;
-
-        PetscHashIHasKey(label->ht[v], point, has);
-        if (has) {
-          *contains = PETSC_TRUE;
-          break;
-        }
-      }
-    }
-  }
+  ierr = DMLabelLookupStratum_Private(label, value, &v);CHKERRQ(ierr);
+  if (v >= 0) {ierr = DMLabelStratumContains_Private(label, v, point, contains);CHKERRQ(ierr);}
   PetscFunctionReturn(0);
 }
 
@@ -420,6 +476,9 @@ PetscErrorCode DMLabelStratumHasPoint(DMLabel label, PetscInt value, PetscInt po
   Output Parameter:
 . value - The point value, or -1
 
+  Note: The first call builds a hash table from points to values, which is then kept up to date by DMLabelSetValue() and
+  DMLabelClearValue(), so that lookups take constant time.
+
   Level: intermediate
 
 .seealso: DMLabelCreate(), DMLabelSetValue(), DMLabelClearValue()
@@ -431,26 +490,9 @@ PetscErrorCode DMLabelGetValue(DMLabel label, PetscInt point, PetscInt *value)
 
   PetscFunctionBegin;
   PetscValidPointer(value, 3);
-  *value = -1;
-  for (v = 0; v < label->numStrata; ++v) {
-    if (label->arrayValid[v]) {
-      PetscInt i;
-
-      ierr = PetscFindInt(point, label->stratumSizes[v], &label->points[v][0], &i);CHKERRQ(ierr);
-      if (i >= 0) {
-        *value = label->stratumValues[v];
-        break;
-      }
-    } else {
-      PetscBool has;
-
-      PetscHashIHasKey(label->ht[v], point, has);
-      if (has) {
-        *value = label->stratumValues[v];
-        break;
-      }
-    }
-  }
+  ierr = DMLabelCreatePointIndex_Private(label);CHKERRQ(ierr);
+  PetscHashIMap(label->pointht, point, v);
+  *value = v < 0 ? -1 : label->stratumValues[v];
   PetscFunctionReturn(0);
 }
 
@@ -476,16 +518,16 @@ PetscErrorCode DMLabelSetValue(DMLabel label, PetscInt point, PetscInt value)
 
   PetscFunctionBegin;
   /* Find, or add, label value */
-  for (v = 0; v < label->numStrata; ++v) {
-    if (label->stratumValues[v] == value) break;
-  }
+  ierr = DMLabelLookupStratum_Private(label, value, &v);CHKERRQ(ierr);
   /* Create new table */
-  if (v >= label->numStrata) {
+  if (v < 0) {
     ierr = DMLabelAddStratum_Private(label, value);CHKERRQ(ierr);
+    v    = label->numStrata-1;
   }
   ierr = DMLabelMakeInvalid_Private(label, v);CHKERRQ(ierr);
   /* Set key */
   PetscHashIPut(label->ht[v], point, ret, iter);
+  ierr = DMLabelPointIndexAdd_Private(label, point, v);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -510,10 +552,8 @@ PetscErrorCode DMLabelClearValue(DMLabel label, PetscInt point, PetscInt value)
 
   PetscFunctionBegin;
   /* Find label value */
-  for (v = 0; v < label->numStrata; ++v) {
-    if (label->stratumValues[v] == value) break;
-  }
-  if (v >= label->numStrata) PetscFunctionReturn(0);
+  ierr = DMLabelLookupStratum_Private(label, value, &v);CHKERRQ(ierr);
+  if (v < 0) PetscFunctionReturn(0);
   if (label->arrayValid[v]) {
     /* Check whether point exists */
     ierr = PetscFindInt(point, label->stratumSizes[v], &label->points[v][0], &p);CHKERRQ(ierr);
@@ -528,6 +568,21 @@ PetscErrorCode DMLabelClearValue(DMLabel label, PetscInt point, PetscInt value)
   } else {
     ierr = PetscHashIDelKey(label->ht[v], point);CHKERRQ(ierr);
   }
+  if (label->pointht) {
+    PetscInt w;
+
+    /* Only later strata can still contain the point */
+    PetscHashIMap(label->pointht, point, w);
+    if (w == v) {
+      ierr = PetscHashIDelKey(label->pointht, point);CHKERRQ(ierr);
+      for (w = v+1; w < label->numStrata; ++w) {
+        PetscBool has;
+
+        ierr = DMLabelStratumContains_Private(label, w, point, &has);CHKERRQ(ierr);
+        if (has) {PetscHashIAdd(label->pointht, point, w); break;}
+      }
+    }
+  }
   PetscFunctionReturn(0);
 }
 
@@ -546,17 +601,78 @@ PetscErrorCode DMLabelClearValue(DMLabel label, PetscInt point, PetscInt value)
 .seealso: DMLabelCreate(), DMLabelGetValue(), DMLabelSetValue(), DMLabelClearValue()
 @*/
 PetscErrorCode DMLabelInsertIS(DMLabel label, IS is, PetscInt value)
+{
+  PETSC_UNUSED PetscHashIIter iter, ret;
+  const PetscInt             *points;
+  PetscInt                    n, p, v;
+  PetscErrorCode              ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(is, IS_CLASSID, 2);
+  ierr = DMLabelLookupStratum_Private(label, value, &v);CHKERRQ(ierr);
+  if (v < 0) {
+    ierr = DMLabelAddStratum_Private(label, value);CHKERRQ(ierr);
+    v    = label->numStrata-1;
+  }
+  ierr = DMLabelMakeInvalid_Private(label, v);CHKERRQ(ierr);
+  ierr = ISGetLocalSize(is, &n);CHKERRQ(ierr);
+  ierr = ISGetIndices(is, &points);CHKERRQ(ierr);
+  for (p = 0; p < n; ++p) {
+    PetscHashIPut(label->ht[v], points[p], ret, iter);
+    ierr = DMLabelPointIndexAdd_Private(label, points[p], v);CHKERRQ(ierr);
+  }
+  ierr = ISRestoreIndices(is, &points);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMLabelSetStratumIS"
+/*@
+  DMLabelSetStratumIS - Replace the points in a stratum by the points in the IS
+
+  Input Parameters:
++ label - the DMLabel
+. value - the stratum value
+- is    - the point IS
+
+  Note: This is much cheaper than clearing the stratum and calling DMLabelSetValue() for each point, since the sorted
+  stratum is built directly.
+
+  Level: intermediate
+
+.seealso: DMLabelInsertIS(), DMLabelGetStratumIS(), DMLabelClearStratum()
+@*/
+PetscErrorCode DMLabelSetStratumIS(DMLabel label, PetscInt value, IS is)
 {
   const PetscInt *points;
-  PetscInt        n, p;
+  PetscInt        n, p, v;
   PetscErrorCode  ierr;
 
   PetscFunctionBegin;
-  PetscValidHeaderSpecific(is, IS_CLASSID, 2);
+  PetscValidHeaderSpecific(is, IS_CLASSID, 3);
+  ierr = DMLabelLookupStratum_Private(label, value, &v);CHKERRQ(ierr);
+  if (v < 0) {
+    ierr = DMLabelAddStratum_Private(label, value);CHKERRQ(ierr);
+    v    = label->numStrata-1;
+  }
+  ierr = DMLabelMakeValid_Private(label, v);CHKERRQ(ierr);
+  ierr = DMLabelClearStratum(label, value);CHKERRQ(ierr);
+  ierr = PetscFree(label->points[v]);CHKERRQ(ierr);
   ierr = ISGetLocalSize(is, &n);CHKERRQ(ierr);
   ierr = ISGetIndices(is, &points);CHKERRQ(ierr);
-  for (p = 0; p < n; ++p) {ierr = DMLabelSetValue(label, points[p], value);CHKERRQ(ierr);}
+  ierr = PetscMalloc1(n, &label->points[v]);CHKERRQ(ierr);
+  ierr = PetscMemcpy(label->points[v], points, n * sizeof(PetscInt));CHKERRQ(ierr);
   ierr = ISRestoreIndices(is, &points);CHKERRQ(ierr);
+  ierr = PetscSortRemoveDupsInt(&n, label->points[v]);CHKERRQ(ierr);
+  label->stratumSizes[v] = n;
+  if (label->bt) {
+    for (p = 0; p < n; ++p) {
+      const PetscInt point = label->points[v][p];
+
+      if ((point < label->pStart) || (point >= label->pEnd)) SETERRQ3(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Label point %d is not in [%d, %d)", point, label->pStart, label->pEnd);
+      ierr = PetscBTSet(label->bt, point - label->pStart);CHKERRQ(ierr);
+    }
+  }
   PetscFunctionReturn(0);
 }
 
@@ -592,13 +708,10 @@ PetscErrorCode DMLabelGetStratumSize(DMLabel label, PetscInt value, PetscInt *si
   PetscFunctionBegin;
   PetscValidPointer(size, 3);
   *size = 0;
-  for (v = 0; v < label->numStrata; ++v) {
-    if (label->stratumValues[v] == value) {
-      ierr = DMLabelMakeValid_Private(label, v);CHKERRQ(ierr);
-      *size = label->stratumSizes[v];
-      break;
-    }
-  }
+  ierr = DMLabelLookupStratum_Private(label, value, &v);CHKERRQ(ierr);
+  if (v < 0) PetscFunctionReturn(0);
+  ierr = DMLabelMakeValid_Private(label, v);CHKERRQ(ierr);
+  *size = label->stratumSizes[v];
   PetscFunctionReturn(0);
 }
 
@@ -612,13 +725,11 @@ PetscErrorCode DMLabelGetStratumBounds(DMLabel label, PetscInt value, PetscInt *
   PetscFunctionBegin;
   if (start) {PetscValidPointer(start, 3); *start = 0;}
   if (end)   {PetscValidPointer(end,   4); *end   = 0;}
-  for (v = 0; v < label->numStrata; ++v) {
-    if (label->stratumValues[v] != value) continue;
-    ierr = DMLabelMakeValid_Private(label, v);CHKERRQ(ierr);
-    if (start) *start = label->points[v][0];
-    if (end)   *end   = label->points[v][label->stratumSizes[v]-1]+1;
-    break;
-  }
+  ierr = DMLabelLookupStratum_Private(label, value, &v);CHKERRQ(ierr);
+  if (v < 0) PetscFunctionReturn(0);
+  ierr = DMLabelMakeValid_Private(label, v);CHKERRQ(ierr);
+  if (start) *start = label->points[v][0];
+  if (end)   *end   = label->points[v][label->stratumSizes[v]-1]+1;
   PetscFunctionReturn(0);
 }
 
@@ -632,18 +743,109 @@ PetscErrorCode DMLabelGetStratumIS(DMLabel label, PetscInt value, IS *points)
   PetscFunctionBegin;
   PetscValidPointer(points, 3);
   *points = NULL;
-  for (v = 0; v < label->numStrata; ++v) {
-    if (label->stratumValues[v] == value) {
-      ierr = DMLabelMakeValid_Private(label, v);CHKERRQ(ierr);
-      if (label->arrayValid[v]) {
-        ierr = ISCreateGeneral(PETSC_COMM_SELF, label->stratumSizes[v], &label->points[v][0], PETSC_COPY_VALUES, points);CHKERRQ(ierr);
-        ierr = PetscObjectSetName((PetscObject) *points, "indices");CHKERRQ(ierr);
-      } else {
-        SETERRQ(PETSC_COMM_SELF, PETSC_ERR_SUP, "Need to implement this to speedup Stratify");
+  ierr = DMLabelLookupStratum_Private(label, value, &v);CHKERRQ(ierr);
+  if (v < 0) PetscFunctionReturn(0);
+  ierr = DMLabelMakeValid_Private(label, v);CHKERRQ(ierr);
+  ierr = ISCreateGeneral(PETSC_COMM_SELF, label->stratumSizes[v], &label->points[v][0], PETSC_COPY_VALUES, points);CHKERRQ(ierr);
+  ierr = PetscObjectSetName((PetscObject) *points, "indices");CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMLabelGetStrataUnion"
+/*@
+  DMLabelGetStrataUnion - Get the points contained in any of the given strata
+
+  Input Parameters:
++ label     - the DMLabel
+. numValues - the number of stratum values
+- values    - the stratum values
+
+  Output Parameter:
+. points - the sorted points
+
+  Level: intermediate
+
+.seealso: DMLabelGetStrataIntersection(), DMLabelGetStratumIS()
+@*/
+PetscErrorCode DMLabelGetStrataUnion(DMLabel label, PetscInt numValues, const PetscInt values[], IS *points)
+{
+  PetscInt      *idx;
+  PetscInt       n = 0, i, v;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (numValues) PetscValidIntPointer(values, 3);
+  PetscValidPointer(points, 4);
+  for (i = 0; i < numValues; ++i) {
+    ierr = DMLabelLookupStratum_Private(label, values[i], &v);CHKERRQ(ierr);
+    if (v < 0) continue;
+    ierr = DMLabelMakeValid_Private(label, v);CHKERRQ(ierr);
+    n   += label->stratumSizes[v];
+  }
+  ierr = PetscMalloc1(n, &idx);CHKERRQ(ierr);
+  for (n = 0, i = 0; i < numValues; ++i) {
+    ierr = DMLabelLookupStratum_Private(label, values[i], &v);CHKERRQ(ierr);
+    if (v < 0) continue;
+    ierr = PetscMemcpy(&idx[n], label->points[v], label->stratumSizes[v] * sizeof(PetscInt));CHKERRQ(ierr);
+    n   += label->stratumSizes[v];
+  }
+  ierr = PetscSortRemoveDupsInt(&n, idx);CHKERRQ(ierr);
+  ierr = ISCreateGeneral(PETSC_COMM_SELF, n, idx, PETSC_OWN_POINTER, points);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMLabelGetStrataIntersection"
+/*@
+  DMLabelGetStrataIntersection - Get the points contained in all of the given strata
+
+  Input Parameters:
++ label     - the DMLabel
+. numValues - the number of stratum values
+- values    - the stratum values
+
+  Output Parameter:
+. points - the sorted points
+
+  Level: intermediate
+
+.seealso: DMLabelGetStrataUnion(), DMLabelGetStratumIS()
+@*/
+PetscErrorCode DMLabelGetStrataIntersection(DMLabel label, PetscInt numValues, const PetscInt values[], IS *points)
+{
+  PetscInt      *idx = NULL;
+  PetscInt       n = 0, i, v;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (numValues) PetscValidIntPointer(values, 3);
+  PetscValidPointer(points, 4);
+  for (i = 0; i < numValues; ++i) {
+    ierr = DMLabelLookupStratum_Private(label, values[i], &v);CHKERRQ(ierr);
+    if (v < 0) {n = 0; break;}
+    ierr = DMLabelMakeValid_Private(label, v);CHKERRQ(ierr);
+    if (!i) {
+      n    = label->stratumSizes[v];
+      ierr = PetscMalloc1(n, &idx);CHKERRQ(ierr);
+      ierr = PetscMemcpy(idx, label->points[v], n * sizeof(PetscInt));CHKERRQ(ierr);
+    } else {
+      const PetscInt *spoints = label->points[v];
+      const PetscInt  ssize   = label->stratumSizes[v];
+      PetscInt        j = 0, k = 0, m = 0;
+
+      /* Both lists are sorted */
+      while (j < n && k < ssize) {
+        if      (idx[j] < spoints[k]) ++j;
+        else if (idx[j] > spoints[k]) ++k;
+        else {idx[m++] = idx[j]; ++j; ++k;}
       }
-      break;
+      n = m;
     }
+    if (!n) break;
   }
+  ierr = ISCreateGeneral(PETSC_COMM_SELF, n, idx, PETSC_COPY_VALUES, points);CHKERRQ(ierr);
+  ierr = PetscFree(idx);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -655,10 +857,9 @@ PetscErrorCode DMLabelClearStratum(DMLabel label, PetscInt value)
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
-  for (v = 0; v < label->numStrata; ++v) {
-    if (label->stratumValues[v] == value) break;
-  }
-  if (v >= label->numStrata) PetscFunctionReturn(0);
+  ierr = DMLabelLookupStratum_Private(label, value, &v);CHKERRQ(ierr);
+  if (v < 0) PetscFunctionReturn(0);
+  PetscHashIDestroy(label->pointht);
   if (label->bt) {
     PetscInt i;
 
@@ -686,6 +887,7 @@ PetscErrorCode DMLabelFilter(DMLabel label, PetscInt start, PetscInt end)
 
   PetscFunctionBegin;
   ierr = DMLabelMakeAllValid_Private(label);CHKERRQ(ierr);
+  PetscHashIDestroy(label->pointht);
   label->pStart = start;
   label->pEnd   = end;
   if (label->bt) {ierr = PetscBTDestroy(&label->bt);CHKERRQ(ierr);}
@@ -746,11 +948,12 @@ PetscErrorCode DMLabelDistribute(DMLabel label, PetscSF sf, DMLabel *labelNew)
   PetscSection   rootSection, leafSection;
   PetscSF        labelSF;
   PetscInt       p, pStart, pEnd, l, lStart, lEnd, s, nroots, nleaves, size, dof, offset, stratum;
-  PetscInt      *remoteOffsets, *rootStrata, *rootIdx, *leafStrata, *strataIdx;
+  PetscInt      *remoteOffsets, *rootStrata, *rootIdx, *leafStrata, *strataIdx, *values, *sortedValues, *strataMap, numValues;
+  PetscBool     *used;
   char          *name;
   PetscInt       nameSize;
   size_t         len = 0;
-  PetscMPIInt    rank, numProcs;
+  PetscMPIInt    rank, numProcs, numStrata, r, *recvCounts, *displs;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
@@ -767,13 +970,34 @@ PetscErrorCode DMLabelDistribute(DMLabel label, PetscSF sf, DMLabel *labelNew)
   ierr = MPI_Bcast(name, nameSize+1, MPI_CHAR, 0, comm);CHKERRQ(ierr);
   ierr = DMLabelCreate(name, labelNew);CHKERRQ(ierr);
   ierr = PetscFree(name);CHKERRQ(ierr);
-  /* Bcast numStrata */
-  if (!rank) (*labelNew)->numStrata = label->numStrata;
-  ierr = MPI_Bcast(&(*labelNew)->numStrata, 1, MPIU_INT, 0, comm);CHKERRQ(ierr);
-  /* Bcast stratumValues */
+  /* Gather stratumValues, a label created in parallel may have different strata on each process */
+  numStrata = label ? label->numStrata : 0;
+  ierr = PetscMalloc2(numProcs, &recvCounts, numProcs+1, &displs);CHKERRQ(ierr);
+  ierr = MPI_Allgather(&numStrata, 1, MPI_INT, recvCounts, 1, MPI_INT, comm);CHKERRQ(ierr);
+  for (displs[0] = 0, r = 0; r < numProcs; ++r) displs[r+1] = displs[r] + recvCounts[r];
+  ierr = PetscMalloc3(displs[numProcs], &values, displs[numProcs], &sortedValues, displs[numProcs], &used);CHKERRQ(ierr);
+  ierr = MPI_Allgatherv(label ? label->stratumValues : NULL, numStrata, MPIU_INT, values, recvCounts, displs, MPIU_INT, comm);CHKERRQ(ierr);
+  /* Keep the strata in order of appearance, starting with those of process 0 */
+  numValues = displs[numProcs];
+  ierr = PetscMemcpy(sortedValues, values, numValues * sizeof(PetscInt));CHKERRQ(ierr);
+  ierr = PetscSortRemoveDupsInt(&numValues, sortedValues);CHKERRQ(ierr);
+  ierr = PetscMemzero(used, numValues * sizeof(PetscBool));CHKERRQ(ierr);
+  (*labelNew)->numStrata = numValues;
   ierr = PetscMalloc1((*labelNew)->numStrata, &(*labelNew)->stratumValues);CHKERRQ(ierr);
-  if (!rank) {ierr = PetscMemcpy((*labelNew)->stratumValues, label->stratumValues, label->numStrata * sizeof(PetscInt));CHKERRQ(ierr);}
-  ierr = MPI_Bcast((*labelNew)->stratumValues, (*labelNew)->numStrata, MPIU_INT, 0, comm);CHKERRQ(ierr);
+  for (s = 0, l = 0; l < displs[numProcs]; ++l) {
+    PetscInt idx;
+
+    ierr = PetscFindInt(values[l], numValues, sortedValues, &idx);CHKERRQ(ierr);
+    if (!used[idx]) {(*labelNew)->stratumValues[s++] = values[l]; used[idx] = PETSC_TRUE;}
+  }
+  /* Map the local strata to the new ones */
+  ierr = PetscMalloc1(numStrata, &strataMap);CHKERRQ(ierr);
+  for (s = 0; s < numStrata; ++s) {
+    for (l = 0; l < numValues; ++l) if ((*labelNew)->stratumValues[l] == label->stratumValues[s]) break;
+    strataMap[s] = l;
+  }
+  ierr = PetscFree3(values, sortedValues, used);CHKERRQ(ierr);
+  ierr = PetscFree2(recvCounts, displs);CHKERRQ(ierr);
   ierr = PetscMalloc1((*labelNew)->numStrata, &(*labelNew)->arrayValid);CHKERRQ(ierr);
   for (s = 0; s < (*labelNew)->numStrata; ++s) (*labelNew)->arrayValid[s] = PETSC_TRUE;
 
@@ -805,7 +1029,7 @@ PetscErrorCode DMLabelDistribute(DMLabel label, PetscSF sf, DMLabel *labelNew)
       for (l=lStart; l<lEnd; l++) {
         p = label->points[s][l];
         ierr = PetscSectionGetOffset(rootSection, p, &offset);CHKERRQ(ierr);
-        rootStrata[offset+rootIdx[p]++] = s;
+        rootStrata[offset+rootIdx[p]++] = strataMap[s];
       }
     }
   }
@@ -849,6 +1073,7 @@ PetscErrorCode DMLabelDistribute(DMLabel label, PetscSF sf, DMLabel *labelNew)
       (*labelNew)->points[stratum][strataIdx[stratum]++] = p;
     }
   }
+  ierr = PetscFree(strataMap);CHKERRQ(ierr);
   ierr = PetscFree(rootStrata);CHKERRQ(ierr);
   ierr = PetscFree(leafStrata);CHKERRQ(ierr);
   ierr = PetscFree(rootIdx);CHKERRQ(ierr);
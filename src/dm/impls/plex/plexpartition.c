@@ -75,13 +75,13 @@ PetscErrorCode DMPlexCreatePartitionerGraph(DM dm, PetscInt height, PetscInt *nu
   ierr = DMPlexGetAdjacencyUseClosure(dm, &useClosure);CHKERRQ(ierr);
   ierr = DMPlexSetAdjacencyUseCone(dm, PETSC_TRUE);CHKERRQ(ierr);
   ierr = DMPlexSetAdjacencyUseClosure(dm, PETSC_FALSE);CHKERRQ(ierr);
-  if (nroots > 0) {
+  if (nroots >= 0) {
     ierr = DMPlexGetCellNumbering(dm, &cellNumbering);CHKERRQ(ierr);
     ierr = ISGetIndices(cellNumbering, &cellNum);CHKERRQ(ierr);
   }
   for (*numVertices = 0, p = pStart; p < pEnd; p++) {
     /* Skip non-owned cells in parallel (ParMetis expects no overlap) */
-    if (nroots > 0) {if (cellNum[p] < 0) continue;}
+    if (nroots >= 0) {if (cellNum[p] < 0) continue;}
     adjSize = PETSC_DETERMINE;
     ierr = DMPlexGetAdjacency(dm, p, &adjSize, &adj);CHKERRQ(ierr);
     for (a = 0; a < adjSize; ++a) {
@@ -102,13 +102,13 @@ PetscErrorCode DMPlexCreatePartitionerGraph(DM dm, PetscInt height, PetscInt *nu
   ierr = PetscSectionGetStorageSize(section, &size);CHKERRQ(ierr);
   ierr = PetscMalloc1(*numVertices+1, &vOffsets);CHKERRQ(ierr);
   for (idx = 0, p = pStart; p < pEnd; p++) {
-    if (nroots > 0) {if (cellNum[p] < 0) continue;}
+    if (nroots >= 0) {if (cellNum[p] < 0) continue;}
     ierr = PetscSectionGetOffset(section, p, &(vOffsets[idx++]));CHKERRQ(ierr);
   }
   vOffsets[*numVertices] = size;
   if (offsets) *offsets = vOffsets;
   ierr = PetscSegBufferExtractAlloc(adjBuffer, &graph);CHKERRQ(ierr);
-  if (nroots > 0) {
+  if (nroots >= 0) {
     ISLocalToGlobalMapping ltogCells;
     PetscInt n, size, *cells_arr;
     /* In parallel, apply a global cell numbering to the graph */
@@ -465,8 +465,16 @@ PetscErrorCode PetscPartitionerSetTypeFromOptions_Internal(PetscPartitioner part
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(part, PETSCPARTITIONER_CLASSID, 1);
-  if (!((PetscObject) part)->type_name) defaultType = PETSCPARTITIONERCHACO;
-  else                                  defaultType = ((PetscObject) part)->type_name;
+  if (!((PetscObject) part)->type_name)
+#if defined(PETSC_HAVE_CHACO)
+    defaultType = PETSCPARTITIONERCHACO;
+#elif defined(PETSC_HAVE_PARMETIS)
+    defaultType = PETSCPARTITIONERPARMETIS;
+#else
+    defaultType = PETSCPARTITIONERRCB;
+#endif
+  else
+    defaultType = ((PetscObject) part)->type_name;
   ierr = PetscPartitionerRegisterAll();CHKERRQ(ierr);
 
   ierr = PetscObjectOptionsBegin((PetscObject) part);CHKERRQ(ierr);
@@ -503,7 +511,9 @@ PetscErrorCode PetscPartitionerSetFromOptions(PetscPartitioner part)
   ierr = PetscPartitionerSetTypeFromOptions_Internal(part);CHKERRQ(ierr);
 
   ierr = PetscObjectOptionsBegin((PetscObject) part);CHKERRQ(ierr);
-  if (part->ops->setfromoptions) {ierr = (*part->ops->setfromoptions)(part);CHKERRQ(ierr);}
+  ierr = PetscOptionsBool("-petscpartitioner_face_dof_weights", "Weight graph edges by the dofs on the shared face", "PetscPartitionerSetFaceDofWeights", part->faceDofWeights, &part->faceDofWeights, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-petscpartitioner_topology_aware", "Assign neighboring parts to processes on the same node", "PetscPartitionerSetTopologyAware", part->topologyAware, &part->topologyAware, NULL);CHKERRQ(ierr);
+  if (part->ops->setfromoptions) {ierr = (*part->ops->setfromoptions)(PetscOptionsObject,part);CHKERRQ(ierr);}
   /* process any options handlers added with PetscObjectAddOptionsHandler() */
   ierr = PetscObjectProcessOptionsHandlers((PetscObject) part);CHKERRQ(ierr);
   ierr = PetscOptionsEnd();CHKERRQ(ierr);
@@ -561,6 +571,7 @@ PetscErrorCode PetscPartitionerDestroy(PetscPartitioner *part)
   ((PetscObject) (*part))->refct = 0;
 
   if ((*part)->ops->destroy) {ierr = (*(*part)->ops->destroy)(*part);CHKERRQ(ierr);}
+  ierr = PetscFree((*part)->weights);CHKERRQ(ierr);
   ierr = PetscHeaderDestroy(part);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -598,6 +609,395 @@ PetscErrorCode PetscPartitionerCreate(MPI_Comm comm, PetscPartitioner *part)
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "PetscPartitionerCreateGraphWeights_Static"
+/*
+  Set part->vwgt and part->adjwgt for the graph from DMPlexCreatePartitionerGraph(), visiting the owned points and
+  their adjacency in the same order. The edge weight between two cells is one plus the number of dofs of the default
+  section in the closure of the points they share.
+*/
+static PetscErrorCode PetscPartitionerCreateGraphWeights_Static(PetscPartitioner part, DM dm, PetscInt numVertices, const PetscInt start[])
+{
+  MPI_Comm        comm;
+  PetscSF         sfPoint;
+  PetscSection    section = NULL;
+  IS              cellNumbering;
+  const PetscInt *cellNum = NULL;
+  PetscInt       *adj = NULL, flags[2], gflags[2];
+  PetscInt        nroots, pStart, pEnd, p, v, a, e, c;
+  PetscBool       useCone, useClosure;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject) part, &comm);CHKERRQ(ierr);
+  part->vwgt   = NULL;
+  part->adjwgt = NULL;
+  /* Weights are optional input on each process, but the weighting must agree across the graph */
+  flags[0] = part->ncon;
+  flags[1] = part->faceDofWeights;
+  ierr = MPI_Allreduce(flags, gflags, 2, MPIU_INT, MPI_MAX, comm);CHKERRQ(ierr);
+  if (part->ncon && part->ncon != gflags[0]) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Number of vertex weights %D differs from %D on another process", part->ncon, gflags[0]);
+  part->ncon = gflags[0];
+  ierr = DMPlexGetHeightStratum(dm, part->height, &pStart, &pEnd);CHKERRQ(ierr);
+  ierr = DMGetPointSF(dm, &sfPoint);CHKERRQ(ierr);
+  ierr = PetscSFGetGraph(sfPoint, &nroots, NULL, NULL, NULL);CHKERRQ(ierr);
+  if (nroots >= 0) {
+    ierr = DMPlexGetCellNumbering(dm, &cellNumbering);CHKERRQ(ierr);
+    ierr = ISGetIndices(cellNumbering, &cellNum);CHKERRQ(ierr);
+  }
+  if (part->ncon) {
+    if (part->weights && part->numWeights != pEnd-pStart) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_ARG_SIZ, "Vertex weights were given for %D points, but the mesh has %D", part->numWeights, pEnd-pStart);
+    ierr = PetscMalloc1(numVertices*part->ncon, &part->vwgt);CHKERRQ(ierr);
+    for (p = pStart, v = 0; p < pEnd; ++p) {
+      if (cellNum && cellNum[p] < 0) continue;
+      for (c = 0; c < part->ncon; ++c) part->vwgt[v*part->ncon+c] = part->weights ? part->weights[(p-pStart)*part->ncon+c] : 1;
+      ++v;
+    }
+  }
+  if (gflags[1]) {
+    ierr = DMGetDefaultSection(dm, &section);CHKERRQ(ierr);
+    ierr = PetscMalloc1(start[numVertices], &part->adjwgt);CHKERRQ(ierr);
+    ierr = DMPlexGetAdjacencyUseCone(dm, &useCone);CHKERRQ(ierr);
+    ierr = DMPlexGetAdjacencyUseClosure(dm, &useClosure);CHKERRQ(ierr);
+    ierr = DMPlexSetAdjacencyUseCone(dm, PETSC_TRUE);CHKERRQ(ierr);
+    ierr = DMPlexSetAdjacencyUseClosure(dm, PETSC_FALSE);CHKERRQ(ierr);
+    for (p = pStart, v = 0; p < pEnd; ++p) {
+      PetscInt adjSize = PETSC_DETERMINE;
+
+      if (cellNum && cellNum[p] < 0) continue;
+      ierr = DMPlexGetAdjacency(dm, p, &adjSize, &adj);CHKERRQ(ierr);
+      for (a = 0, e = start[v]; a < adjSize; ++a) {
+        const PetscInt  q = adj[a];
+        const PetscInt *meet, pair[2] = {p, q};
+        PetscInt        numMeet, m, wgt = 1;
+
+        if (q == p || q < pStart || q >= pEnd) continue;
+        if (section) {
+          ierr = DMPlexGetMeet(dm, 2, pair, &numMeet, &meet);CHKERRQ(ierr);
+          for (m = 0; m < numMeet; ++m) {
+            PetscInt *closure = NULL, clSize, cl, dof;
+
+            ierr = DMPlexGetTransitiveClosure(dm, meet[m], PETSC_TRUE, &clSize, &closure);CHKERRQ(ierr);
+            for (cl = 0; cl < clSize*2; cl += 2) {
+              ierr = PetscSectionGetDof(section, closure[cl], &dof);CHKERRQ(ierr);
+              wgt += dof;
+            }
+            ierr = DMPlexRestoreTransitiveClosure(dm, meet[m], PETSC_TRUE, &clSize, &closure);CHKERRQ(ierr);
+          }
+          ierr = DMPlexRestoreMeet(dm, 2, pair, &numMeet, &meet);CHKERRQ(ierr);
+        }
+        part->adjwgt[e++] = wgt;
+      }
+      if (e != start[v+1]) SETERRQ3(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Vertex %D has %D weighted edges, but %D in the graph", v, e-start[v], start[v+1]-start[v]);
+      ++v;
+    }
+    ierr = DMPlexSetAdjacencyUseCone(dm, useCone);CHKERRQ(ierr);
+    ierr = DMPlexSetAdjacencyUseClosure(dm, useClosure);CHKERRQ(ierr);
+    ierr = PetscFree(adj);CHKERRQ(ierr);
+  }
+  if (cellNum) {ierr = ISRestoreIndices(cellNumbering, &cellNum);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscPartitionerGroupParts_Static"
+/*
+  Reorder the n parts in parts[] so that the g-th group of offsets[g+1]-offsets[g] consecutive parts is strongly connected,
+  growing each group greedily from its lowest unassigned part by the part with the heaviest edges into the group. Each
+  group is left sorted. The graph between parts is given by adjStart[], adj[] and wgt[]; avail[] and conn[] must be zero
+  for all parts, and are left so, and cand[] is workspace of length n.
+*/
+static PetscErrorCode PetscPartitionerGroupParts_Static(PetscInt n, PetscInt parts[], PetscMPIInt numGroups, const PetscMPIInt offsets[], const PetscInt adjStart[], const PetscInt adj[], const PetscInt wgt[], PetscInt avail[], PetscInt conn[], PetscInt cand[])
+{
+  PetscInt      *order, h = 0, next = 0, i, k, c, e, nc, best, u;
+  PetscMPIInt    g;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscMalloc1(n, &order);CHKERRQ(ierr);
+  for (i = 0; i < n; ++i) avail[parts[i]] = 1;
+  for (g = 0; g < numGroups; ++g) {
+    const PetscInt groupSize = offsets[g+1] - offsets[g];
+
+    for (k = 0, nc = 0; k < groupSize; ++k) {
+      for (c = 0, best = -1; c < nc; ++c) {
+        u = cand[c];
+        if (avail[u] && (best < 0 || conn[u] > conn[best] || (conn[u] == conn[best] && u < best))) best = u;
+      }
+      if (best < 0) {
+        while (!avail[parts[next]]) ++next;
+        best = parts[next];
+      }
+      avail[best] = 0;
+      order[h++]  = best;
+      for (e = adjStart[best]; e < adjStart[best+1]; ++e) {
+        u = adj[e];
+        if (!avail[u]) continue;
+        if (!conn[u]) cand[nc++] = u;
+        conn[u] += wgt[e];
+      }
+    }
+    for (c = 0; c < nc; ++c) conn[cand[c]] = 0;
+    ierr = PetscSortInt(groupSize, &order[h-groupSize]);CHKERRQ(ierr);
+  }
+  ierr = PetscMemcpy(parts, order, n * sizeof(PetscInt));CHKERRQ(ierr);
+  ierr = PetscFree(order);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscPartitionerCutWeight_Static"
+/*
+  Sum the weights of the edges between parts in different groups, when the g-th group is made of parts[offsets[g]] to
+  parts[offsets[g+1]-1]. group[] is workspace of length n.
+*/
+static PetscErrorCode PetscPartitionerCutWeight_Static(PetscInt n, const PetscInt parts[], PetscMPIInt numGroups, const PetscMPIInt offsets[], const PetscInt adjStart[], const PetscInt adj[], const PetscInt wgt[], PetscInt group[], PetscInt *cut)
+{
+  PetscInt    i, e;
+  PetscMPIInt g;
+
+  PetscFunctionBegin;
+  for (g = 0; g < numGroups; ++g) for (i = offsets[g]; i < offsets[g+1]; ++i) group[parts[i]] = g;
+  for (i = 0, *cut = 0; i < n; ++i) for (e = adjStart[i]; e < adjStart[i+1]; ++e) if (group[i] != group[adj[e]]) *cut += wgt[e];
+  *cut /= 2;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscPartitionerRefineGroups_Static"
+/*
+  Improve the grouping of the n parts in parts[], as in PetscPartitionerGroupParts_Static(), by swapping pairs of
+  adjacent parts in different groups while this lowers the weight of the edges between groups. group[] must be -1 for
+  all parts not in parts[], and pos[] is workspace, both indexed by part.
+*/
+static PetscErrorCode PetscPartitionerRefineGroups_Static(PetscInt n, PetscInt parts[], PetscMPIInt numGroups, const PetscMPIInt offsets[], const PetscInt adjStart[], const PetscInt adj[], const PetscInt wgt[], PetscInt group[], PetscInt pos[])
+{
+  PetscInt    i, a, b, e, f, gain, pass, tmp;
+  PetscMPIInt g;
+  PetscBool   improved = PETSC_TRUE;
+
+  PetscFunctionBegin;
+  for (g = 0; g < numGroups; ++g) for (i = offsets[g]-offsets[0]; i < offsets[g+1]-offsets[0]; ++i) {group[parts[i]] = g; pos[parts[i]] = i;}
+  for (pass = 0; improved && pass < n; ++pass) {
+    improved = PETSC_FALSE;
+    for (i = 0; i < n; ++i) {
+      a = parts[i];
+      for (e = adjStart[a]; e < adjStart[a+1]; ++e) {
+        b = adj[e];
+        if (group[b] < 0 || group[a] == group[b]) continue;
+        /* Moving a to the group of b, and b to the group of a, gains their edges into the other group, loses their
+           edges into their own group, and keeps the edge between them cut */
+        for (f = adjStart[a], gain = 0; f < adjStart[a+1]; ++f) {
+          if (adj[f] == b) continue;
+          if (group[adj[f]] == group[b]) gain += wgt[f];
+          else if (group[adj[f]] == group[a]) gain -= wgt[f];
+        }
+        for (f = adjStart[b]; f < adjStart[b+1]; ++f) {
+          if (adj[f] == a) continue;
+          if (group[adj[f]] == group[a]) gain += wgt[f];
+          else if (group[adj[f]] == group[b]) gain -= wgt[f];
+        }
+        if (gain <= 0) continue;
+        tmp = group[a]; group[a] = group[b]; group[b] = tmp;
+        tmp = pos[a];   pos[a]   = pos[b];   pos[b]   = tmp;
+        parts[pos[a]] = a; parts[pos[b]] = b;
+        improved = PETSC_TRUE;
+      }
+    }
+  }
+  for (i = 0; i < n; ++i) group[parts[i]] = -1;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscPartitionerMapToTopology_Static"
+/*
+  Renumber the parts of a partition of the graph from DMPlexCreatePartitionerGraph(), and so the processes which receive
+  them, so that parts sharing many graph edges go to processes on the same node, and within a node the same socket.
+*/
+static PetscErrorCode PetscPartitionerMapToTopology_Static(PetscPartitioner part, PetscInt numVertices, const PetscInt start[], const PetscInt adjacency[], PetscSection partSection, IS *partition)
+{
+  MPI_Comm        comm;
+  PetscLayout     layout;
+  PetscSF         sf;
+  IS              newPart;
+  const PetscInt *points;
+  PetscInt       *vpart, *apart, *wgt, *touched, *edges, *allEdges = NULL, *oldOff, *oldDof, *newPoints;
+  PetscInt        numEdges = 0, numPoints, nt, p, i, e, u, t;
+  PetscMPIInt     size, rank, numNodes, numSockets, *nodeOffsets, *socketOffsets, *ranks, *rankOfPart, *counts = NULL, *displs = NULL, cnt, g;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject) part, &comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm, &size);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm, &rank);CHKERRQ(ierr);
+  ierr = PetscCommGetNodeLayout(comm, &numNodes, &nodeOffsets, &numSockets, &socketOffsets, &ranks);CHKERRQ(ierr);
+  if (numSockets == 1 || numNodes == size) {
+    ierr = PetscInfo(part, "Every process has the same locality, keeping the partition numbering\n");CHKERRQ(ierr);
+    goto cleanup;
+  }
+  /* Find the part of each local graph vertex, and then of each of its neighbors */
+  ierr = ISGetLocalSize(*partition, &numPoints);CHKERRQ(ierr);
+  ierr = ISGetIndices(*partition, &points);CHKERRQ(ierr);
+  ierr = PetscMalloc2(numVertices, &vpart, start[numVertices], &apart);CHKERRQ(ierr);
+  for (i = 0; i < numVertices; ++i) vpart[i] = -1;
+  for (p = 0; p < size; ++p) {
+    PetscInt dof, off;
+
+    ierr = PetscSectionGetDof(partSection, p, &dof);CHKERRQ(ierr);
+    ierr = PetscSectionGetOffset(partSection, p, &off);CHKERRQ(ierr);
+    for (i = off; i < off+dof; ++i) if (points[i] >= 0 && points[i] < numVertices) vpart[points[i]] = p;
+  }
+  ierr = PetscLayoutCreate(comm, &layout);CHKERRQ(ierr);
+  ierr = PetscLayoutSetLocalSize(layout, numVertices);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(layout);CHKERRQ(ierr);
+  ierr = PetscSFCreate(comm, &sf);CHKERRQ(ierr);
+  ierr = PetscSFSetGraphLayout(sf, layout, start[numVertices], NULL, PETSC_OWN_POINTER, adjacency);CHKERRQ(ierr);
+  ierr = PetscSFBcastBegin(sf, MPIU_INT, vpart, apart);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(sf, MPIU_INT, vpart, apart);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sf);CHKERRQ(ierr);
+  ierr = PetscLayoutDestroy(&layout);CHKERRQ(ierr);
+  /* Sum the edge weights between each pair of parts, as triples (p, q, weight) */
+  ierr = PetscCalloc1(size, &wgt);CHKERRQ(ierr);
+  ierr = PetscMalloc2(size, &touched, 3*start[numVertices], &edges);CHKERRQ(ierr);
+  for (p = 0; p < size; ++p) {
+    PetscInt dof, off;
+
+    ierr = PetscSectionGetDof(partSection, p, &dof);CHKERRQ(ierr);
+    ierr = PetscSectionGetOffset(partSection, p, &off);CHKERRQ(ierr);
+    for (i = off, nt = 0; i < off+dof; ++i) {
+      const PetscInt v = points[i];
+
+      if (v < 0 || v >= numVertices) continue;
+      for (e = start[v]; e < start[v+1]; ++e) {
+        u = apart[e];
+        if (u < 0 || u == p) continue;
+        if (!wgt[u]) touched[nt++] = u;
+        wgt[u] += part->adjwgt ? part->adjwgt[e] : 1;
+      }
+    }
+    for (t = 0; t < nt; ++t) {
+      edges[numEdges*3+0] = p;
+      edges[numEdges*3+1] = touched[t];
+      edges[numEdges*3+2] = wgt[touched[t]];
+      wgt[touched[t]]     = 0;
+      ++numEdges;
+    }
+  }
+  ierr = PetscFree(wgt);CHKERRQ(ierr);
+  ierr = PetscFree2(vpart, apart);CHKERRQ(ierr);
+  /* Group the parts on the first process, where the whole part graph is gathered */
+  ierr = PetscMalloc1(size, &rankOfPart);CHKERRQ(ierr);
+  ierr = PetscMPIIntCast(3*numEdges, &cnt);CHKERRQ(ierr);
+  if (!rank) {ierr = PetscMalloc2(size, &counts, size+1, &displs);CHKERRQ(ierr);}
+  ierr = MPI_Gather(&cnt, 1, MPI_INT, counts, 1, MPI_INT, 0, comm);CHKERRQ(ierr);
+  if (!rank) {
+    displs[0] = 0;
+    for (g = 0; g < size; ++g) displs[g+1] = displs[g] + counts[g];
+    ierr = PetscMalloc1(displs[size], &allEdges);CHKERRQ(ierr);
+  }
+  ierr = MPI_Gatherv(edges, cnt, MPIU_INT, allEdges, counts, displs, MPIU_INT, 0, comm);CHKERRQ(ierr);
+  ierr = PetscFree2(touched, edges);CHKERRQ(ierr);
+  if (!rank) {
+    PetscInt *adjStart, *adj, *adjWgt, *parts, *greedy, *avail, *conn, *cand, totEdges = displs[size]/3, before = 0, after = 0;
+
+    ierr = PetscCalloc1(size+1, &adjStart);CHKERRQ(ierr);
+    ierr = PetscMalloc2(totEdges, &adj, totEdges, &adjWgt);CHKERRQ(ierr);
+    for (e = 0; e < totEdges; ++e) ++adjStart[allEdges[e*3+0]+1];
+    for (p = 0; p < size; ++p) adjStart[p+1] += adjStart[p];
+    for (e = 0; e < totEdges; ++e) {
+      p = allEdges[e*3+0];
+      adj[adjStart[p]]      = allEdges[e*3+1];
+      adjWgt[adjStart[p]++] = allEdges[e*3+2];
+    }
+    for (p = size; p > 0; --p) adjStart[p] = adjStart[p-1];
+    adjStart[0] = 0;
+    ierr = PetscMalloc2(size, &parts, size, &greedy);CHKERRQ(ierr);
+    ierr = PetscCalloc3(size, &avail, size, &conn, size, &cand);CHKERRQ(ierr);
+    /* Group the parts into nodes, starting from the better of the default numbering and a greedy grouping, and then
+       the parts of each node into sockets in the same way */
+    for (i = 0; i < size; ++i) {parts[i] = ranks[i]; greedy[i] = i;}
+    ierr = PetscPartitionerGroupParts_Static(size, greedy, numNodes, nodeOffsets, adjStart, adj, adjWgt, avail, conn, cand);CHKERRQ(ierr);
+    ierr = PetscPartitionerCutWeight_Static(size, parts, numNodes, nodeOffsets, adjStart, adj, adjWgt, avail, &before);CHKERRQ(ierr);
+    ierr = PetscPartitionerCutWeight_Static(size, greedy, numNodes, nodeOffsets, adjStart, adj, adjWgt, avail, &after);CHKERRQ(ierr);
+    if (after < before) {ierr = PetscMemcpy(parts, greedy, size * sizeof(PetscInt));CHKERRQ(ierr);}
+    for (p = 0; p < size; ++p) avail[p] = -1;
+    ierr = PetscPartitionerRefineGroups_Static(size, parts, numNodes, nodeOffsets, adjStart, adj, adjWgt, avail, conn);CHKERRQ(ierr);
+    for (g = 0, t = 0; g < numNodes; ++g) {
+      const PetscInt n0 = nodeOffsets[g], nn = nodeOffsets[g+1]-nodeOffsets[g];
+      PetscMPIInt    s0;
+
+      for (s0 = t; socketOffsets[t+1] < nodeOffsets[g+1]; ++t);
+      if (t > s0) {
+        PetscInt cutParts, cutGreedy;
+
+        ierr = PetscMemcpy(greedy, parts, size * sizeof(PetscInt));CHKERRQ(ierr);
+        ierr = PetscMemzero(avail, size * sizeof(PetscInt));CHKERRQ(ierr);
+        ierr = PetscMemzero(conn, size * sizeof(PetscInt));CHKERRQ(ierr);
+        ierr = PetscSortInt(nn, &greedy[n0]);CHKERRQ(ierr);
+        ierr = PetscPartitionerGroupParts_Static(nn, &greedy[n0], t-s0+1, &socketOffsets[s0], adjStart, adj, adjWgt, avail, conn, cand);CHKERRQ(ierr);
+        ierr = PetscPartitionerCutWeight_Static(size, parts, numSockets, socketOffsets, adjStart, adj, adjWgt, avail, &cutParts);CHKERRQ(ierr);
+        ierr = PetscPartitionerCutWeight_Static(size, greedy, numSockets, socketOffsets, adjStart, adj, adjWgt, avail, &cutGreedy);CHKERRQ(ierr);
+        if (cutGreedy < cutParts) {ierr = PetscMemcpy(&parts[n0], &greedy[n0], nn * sizeof(PetscInt));CHKERRQ(ierr);}
+        for (p = 0; p < size; ++p) avail[p] = -1;
+        ierr = PetscPartitionerRefineGroups_Static(nn, &parts[n0], t-s0+1, &socketOffsets[s0], adjStart, adj, adjWgt, avail, conn);CHKERRQ(ierr);
+      }
+      ++t;
+    }
+    /* Keep the default numbering unless the new one cuts less between nodes, or as much between nodes and less between sockets */
+    ierr = PetscPartitionerCutWeight_Static(size, parts, numNodes, nodeOffsets, adjStart, adj, adjWgt, avail, &after);CHKERRQ(ierr);
+    ierr = PetscInfo2(part, "Edge weight between nodes %D with the default numbering, %D with the topology aware numbering\n", before, after);CHKERRQ(ierr);
+    if (after == before) {
+      for (i = 0; i < size; ++i) greedy[i] = ranks[i];
+      ierr = PetscPartitionerCutWeight_Static(size, greedy, numSockets, socketOffsets, adjStart, adj, adjWgt, avail, &before);CHKERRQ(ierr);
+      ierr = PetscPartitionerCutWeight_Static(size, parts, numSockets, socketOffsets, adjStart, adj, adjWgt, avail, &after);CHKERRQ(ierr);
+      ierr = PetscInfo2(part, "Edge weight between sockets %D with the default numbering, %D with the topology aware numbering\n", before, after);CHKERRQ(ierr);
+    }
+    for (i = 0; i < size; ++i) rankOfPart[parts[i]] = after < before ? ranks[i] : parts[i];
+    ierr = PetscFree3(avail, conn, cand);CHKERRQ(ierr);
+    ierr = PetscFree2(parts, greedy);CHKERRQ(ierr);
+    ierr = PetscFree2(adj, adjWgt);CHKERRQ(ierr);
+    ierr = PetscFree(adjStart);CHKERRQ(ierr);
+    ierr = PetscFree(allEdges);CHKERRQ(ierr);
+    ierr = PetscFree2(counts, displs);CHKERRQ(ierr);
+  }
+  ierr = MPI_Bcast(rankOfPart, size, MPI_INT, 0, comm);CHKERRQ(ierr);
+  for (p = 0; p < size; ++p) if (rankOfPart[p] != p) break;
+  if (p == size) {
+    ierr = PetscFree(rankOfPart);CHKERRQ(ierr);
+    ierr = ISRestoreIndices(*partition, &points);CHKERRQ(ierr);
+    goto cleanup;
+  }
+  /* Part p now goes to process rankOfPart[p] */
+  ierr = PetscMalloc2(size, &oldOff, size, &oldDof);CHKERRQ(ierr);
+  for (p = 0; p < size; ++p) {
+    ierr = PetscSectionGetDof(partSection, p, &oldDof[p]);CHKERRQ(ierr);
+    ierr = PetscSectionGetOffset(partSection, p, &oldOff[p]);CHKERRQ(ierr);
+  }
+  ierr = PetscSectionReset(partSection);CHKERRQ(ierr);
+  ierr = PetscSectionSetChart(partSection, 0, size);CHKERRQ(ierr);
+  for (p = 0; p < size; ++p) {ierr = PetscSectionSetDof(partSection, rankOfPart[p], oldDof[p]);CHKERRQ(ierr);}
+  ierr = PetscSectionSetUp(partSection);CHKERRQ(ierr);
+  ierr = PetscMalloc1(numPoints, &newPoints);CHKERRQ(ierr);
+  for (p = 0; p < size; ++p) {
+    PetscInt off;
+
+    ierr = PetscSectionGetOffset(partSection, rankOfPart[p], &off);CHKERRQ(ierr);
+    ierr = PetscMemcpy(&newPoints[off], &points[oldOff[p]], oldDof[p] * sizeof(PetscInt));CHKERRQ(ierr);
+  }
+  ierr = PetscFree2(oldOff, oldDof);CHKERRQ(ierr);
+  ierr = PetscFree(rankOfPart);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(*partition, &points);CHKERRQ(ierr);
+  ierr = ISCreateGeneral(PetscObjectComm((PetscObject) *partition), numPoints, newPoints, PETSC_OWN_POINTER, &newPart);CHKERRQ(ierr);
+  ierr = ISDestroy(partition);CHKERRQ(ierr);
+  *partition = newPart;
+cleanup:
+  ierr = PetscFree(nodeOffsets);CHKERRQ(ierr);
+  ierr = PetscFree(socketOffsets);CHKERRQ(ierr);
+  ierr = PetscFree(ranks);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "PetscPartitionerPartition"
 /*@
@@ -650,13 +1050,175 @@ PetscErrorCode PetscPartitionerPartition(PetscPartitioner part, DM dm, PetscSect
 
     ierr = DMPlexCreatePartitionerGraph(dm, 0, &numVertices, &start, &adjacency);CHKERRQ(ierr);
     if (!part->ops->partition) SETERRQ(PetscObjectComm((PetscObject) part), PETSC_ERR_ARG_WRONGSTATE, "PetscPartitioner has no type");
+    ierr = PetscPartitionerCreateGraphWeights_Static(part, dm, numVertices, start);CHKERRQ(ierr);
     ierr = (*part->ops->partition)(part, dm, size, numVertices, start, adjacency, partSection, partition);CHKERRQ(ierr);
+    if (part->topologyAware) {ierr = PetscPartitionerMapToTopology_Static(part, numVertices, start, adjacency, partSection, partition);CHKERRQ(ierr);}
+    ierr = PetscFree(part->vwgt);CHKERRQ(ierr);
+    ierr = PetscFree(part->adjwgt);CHKERRQ(ierr);
     ierr = PetscFree(start);CHKERRQ(ierr);
     ierr = PetscFree(adjacency);CHKERRQ(ierr);
   } else SETERRQ1(PetscObjectComm((PetscObject) part), PETSC_ERR_ARG_OUTOFRANGE, "Invalid height %D for points to partition", part->height);
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "PetscPartitionerSetVertexWeights"
+/*@
+  PetscPartitionerSetVertexWeights - Set the weights of the graph vertices, which are the points being partitioned
+
+  Not collective
+
+  Input Parameters:
++ part      - The PetscPartitioner
+. ncon      - The number of weights, or balance constraints, for each point
+. numPoints - The number of points in the partitioned stratum of the local mesh, usually the number of cells
+- weights   - The weights, ncon for each point in the stratum, or NULL to remove the weights
+
+  Notes:
+  The weights are copied. Multiple constraints, such as work and memory, are balanced simultaneously by
+  PETSCPARTITIONERPARMETIS. PETSCPARTITIONERCHACO accepts a single weight, and PETSCPARTITIONERRCB balances the sum of
+  the weights of each point. Processes which do not set weights use unit weights, but ncon must agree.
+
+  Level: intermediate
+
+.seealso: PetscPartitionerPartition(), PetscPartitionerSetFaceDofWeights()
+@*/
+PetscErrorCode PetscPartitionerSetVertexWeights(PetscPartitioner part, PetscInt ncon, PetscInt numPoints, const PetscInt weights[])
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(part, PETSCPARTITIONER_CLASSID, 1);
+  if (weights) PetscValidPointer(weights, 4);
+  if (ncon < 0)      SETERRQ1(PetscObjectComm((PetscObject) part), PETSC_ERR_ARG_OUTOFRANGE, "Number of weights per vertex %D must be nonnegative", ncon);
+  if (numPoints < 0) SETERRQ1(PetscObjectComm((PetscObject) part), PETSC_ERR_ARG_OUTOFRANGE, "Number of points %D must be nonnegative", numPoints);
+  ierr = PetscFree(part->weights);CHKERRQ(ierr);
+  part->ncon       = weights ? ncon : 0;
+  part->numWeights = weights ? numPoints : 0;
+  if (weights) {
+    ierr = PetscMalloc1(ncon*numPoints, &part->weights);CHKERRQ(ierr);
+    ierr = PetscMemcpy(part->weights, weights, ncon*numPoints * sizeof(PetscInt));CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscPartitionerSetFaceDofWeights"
+/*@
+  PetscPartitionerSetFaceDofWeights - Weight each graph edge by the communication volume across the shared face
+
+  Logically collective on PetscPartitioner
+
+  Input Parameters:
++ part - The PetscPartitioner
+- flg  - PETSC_TRUE to weight the edges
+
+  Options Database Key:
+. -petscpartitioner_face_dof_weights - Weight the graph edges
+
+  Note: The weight of the edge between two cells is one plus the number of dofs of the default section of the mesh in
+  the closure of their shared face. Only PETSCPARTITIONERPARMETIS and PETSCPARTITIONERCHACO use edge weights.
+
+  Level: intermediate
+
+.seealso: PetscPartitionerGetFaceDofWeights(), PetscPartitionerSetVertexWeights(), DMSetDefaultSection()
+@*/
+PetscErrorCode PetscPartitionerSetFaceDofWeights(PetscPartitioner part, PetscBool flg)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(part, PETSCPARTITIONER_CLASSID, 1);
+  part->faceDofWeights = flg;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscPartitionerGetFaceDofWeights"
+/*@
+  PetscPartitionerGetFaceDofWeights - Check whether graph edges are weighted by the communication volume across the shared face
+
+  Not collective
+
+  Input Parameter:
+. part - The PetscPartitioner
+
+  Output Parameter:
+. flg  - PETSC_TRUE if the edges are weighted
+
+  Level: intermediate
+
+.seealso: PetscPartitionerSetFaceDofWeights()
+@*/
+PetscErrorCode PetscPartitionerGetFaceDofWeights(PetscPartitioner part, PetscBool *flg)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(part, PETSCPARTITIONER_CLASSID, 1);
+  PetscValidPointer(flg, 2);
+  *flg = part->faceDofWeights;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscPartitionerSetTopologyAware"
+/*@
+  PetscPartitionerSetTopologyAware - Assign the parts to processes so that parts sharing many graph edges run on the same node
+
+  Logically collective on PetscPartitioner
+
+  Input Parameters:
++ part - The PetscPartitioner
+- flg  - PETSC_TRUE to use the machine topology
+
+  Options Database Key:
+. -petscpartitioner_topology_aware - Use the machine topology
+
+  Notes: A partitioner only balances the parts and cuts few edges, and part p is sent to process p regardless of where it
+  runs. With this option the parts are renumbered after partitioning: the parts are grouped into nodes, and within each
+  node into sockets, so that the weight of the graph edges between groups is small, and each group goes to the processes
+  of its node or socket found by PetscCommGetNodeLayout(). This keeps most of the halo exchange inside a node. The
+  default numbering is kept unless the new one cuts less between nodes, or as much between nodes and less between
+  sockets, and nothing changes when every process is on a different node, or all on the same socket.
+
+  Like the other partitioner options, the option is only read by PetscPartitionerSetFromOptions(), which DMSetFromOptions()
+  calls for the partitioner of a DMPlex.
+
+  Level: intermediate
+
+.seealso: PetscPartitionerGetTopologyAware(), PetscPartitionerPartition(), PetscCommGetNodeLayout(), DMDASetTopologyAware()
+@*/
+PetscErrorCode PetscPartitionerSetTopologyAware(PetscPartitioner part, PetscBool flg)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(part, PETSCPARTITIONER_CLASSID, 1);
+  part->topologyAware = flg;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscPartitionerGetTopologyAware"
+/*@
+  PetscPartitionerGetTopologyAware - Check whether parts are assigned to processes using the machine topology
+
+  Not collective
+
+  Input Parameter:
+. part - The PetscPartitioner
+
+  Output Parameter:
+. flg  - PETSC_TRUE if the machine topology is used
+
+  Level: intermediate
+
+.seealso: PetscPartitionerSetTopologyAware()
+@*/
+PetscErrorCode PetscPartitionerGetTopologyAware(PetscPartitioner part, PetscBool *flg)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(part, PETSCPARTITIONER_CLASSID, 1);
+  PetscValidPointer(flg, 2);
+  *flg = part->topologyAware;
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "PetscPartitionerDestroy_Shell"
 PetscErrorCode PetscPartitionerDestroy_Shell(PetscPartitioner part)
@@ -889,6 +1451,232 @@ PETSC_EXTERN PetscErrorCode PetscPartitionerCreate_Simple(PetscPartitioner part)
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "PetscPartitionerDestroy_RCB"
+PetscErrorCode PetscPartitionerDestroy_RCB(PetscPartitioner part)
+{
+  PetscPartitioner_RCB *p = (PetscPartitioner_RCB *) part->data;
+  PetscErrorCode        ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree(p);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscPartitionerView_RCB_Ascii"
+PetscErrorCode PetscPartitionerView_RCB_Ascii(PetscPartitioner part, PetscViewer viewer)
+{
+  PetscPartitioner_RCB *p = (PetscPartitioner_RCB *) part->data;
+  PetscViewerFormat     format;
+  PetscErrorCode        ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscViewerGetFormat(viewer, &format);CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer, "Recursive Coordinate Bisection Partitioner:\n");CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPushTab(viewer);CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer, "maximum bisection steps per cut: %D\n", p->maxIts);CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPopTab(viewer);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscPartitionerView_RCB"
+PetscErrorCode PetscPartitionerView_RCB(PetscPartitioner part, PetscViewer viewer)
+{
+  PetscBool      iascii;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(part, PETSCPARTITIONER_CLASSID, 1);
+  PetscValidHeaderSpecific(viewer, PETSC_VIEWER_CLASSID, 2);
+  ierr = PetscObjectTypeCompare((PetscObject) viewer, PETSCVIEWERASCII, &iascii);CHKERRQ(ierr);
+  if (iascii) {ierr = PetscPartitionerView_RCB_Ascii(part, viewer);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscPartitionerSetFromOptions_RCB"
+PetscErrorCode PetscPartitionerSetFromOptions_RCB(PetscOptions *PetscOptionsObject,PetscPartitioner part)
+{
+  PetscPartitioner_RCB *p = (PetscPartitioner_RCB *) part->data;
+  PetscErrorCode        ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject,"PetscPartitioner RCB options");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-petscpartitioner_rcb_max_it", "Maximum number of bisection steps to find each cut", "", p->maxIts, &p->maxIts, NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscPartitionerRCBBisect_Static"
+/*
+  Assign the n local vertices idx[] to parts [p0, p0+np), recursively cutting the longest axis of their global bounding
+  box at the coordinate which splits their weight in proportion to the number of parts on each side. Every process
+  takes part in every cut, whether or not it has vertices in the box.
+*/
+static PetscErrorCode PetscPartitionerRCBBisect_Static(MPI_Comm comm, PetscInt maxIts, PetscInt cdim, const PetscReal coords[], const PetscReal wgts[], PetscInt n, PetscInt idx[], PetscInt p0, PetscInt np, PetscInt assignment[])
+{
+  PetscReal      box[6], gbox[6], w = 0.0, gw, target, lo, hi, cut, best = PETSC_MAX_REAL;
+  PetscInt       nl = np/2, axis = 0, nLeft, i, d, it;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (np == 1) {
+    for (i = 0; i < n; ++i) assignment[idx[i]] = p0;
+    PetscFunctionReturn(0);
+  }
+  for (d = 0; d < cdim; ++d) box[d] = box[cdim+d] = PETSC_MIN_REAL;
+  for (i = 0; i < n; ++i) {
+    for (d = 0; d < cdim; ++d) {
+      box[d]      = PetscMax(box[d],      -coords[idx[i]*cdim+d]);
+      box[cdim+d] = PetscMax(box[cdim+d],  coords[idx[i]*cdim+d]);
+    }
+    w += wgts[idx[i]];
+  }
+  ierr = MPI_Allreduce(box, gbox, 2*cdim, MPIU_REAL, MPIU_MAX, comm);CHKERRQ(ierr);
+  ierr = MPI_Allreduce(&w, &gw, 1, MPIU_REAL, MPIU_SUM, comm);CHKERRQ(ierr);
+  for (d = 1; d < cdim; ++d) if (gbox[cdim+d] + gbox[d] > gbox[cdim+axis] + gbox[axis]) axis = d;
+  lo     = -gbox[axis];
+  hi     = gbox[cdim+axis];
+  cut    = hi;
+  target = gw*nl/np;
+  for (it = 0; it < maxIts && lo < hi; ++it) {
+    const PetscReal mid = 0.5*(lo + hi);
+    PetscReal       wl = 0.0, gwl;
+
+    for (i = 0; i < n; ++i) if (coords[idx[i]*cdim+axis] <= mid) wl += wgts[idx[i]];
+    ierr = MPI_Allreduce(&wl, &gwl, 1, MPIU_REAL, MPIU_SUM, comm);CHKERRQ(ierr);
+    if (PetscAbsReal(gwl - target) < best) {best = PetscAbsReal(gwl - target); cut = mid;}
+    if (gwl < target)      lo = mid;
+    else if (gwl > target) hi = mid;
+    else break;
+  }
+  /* Move the vertices below the cut to the front */
+  for (i = 0, nLeft = 0; i < n; ++i) {
+    if (coords[idx[i]*cdim+axis] <= cut) {
+      const PetscInt tmp = idx[nLeft];
+
+      idx[nLeft++] = idx[i];
+      idx[i]       = tmp;
+    }
+  }
+  ierr = PetscPartitionerRCBBisect_Static(comm, maxIts, cdim, coords, wgts, nLeft,   idx,       p0,    nl,    assignment);CHKERRQ(ierr);
+  ierr = PetscPartitionerRCBBisect_Static(comm, maxIts, cdim, coords, wgts, n-nLeft, &idx[nLeft], p0+nl, np-nl, assignment);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscPartitionerPartition_RCB"
+PetscErrorCode PetscPartitionerPartition_RCB(PetscPartitioner part, DM dm, PetscInt nparts, PetscInt numVertices, PetscInt start[], PetscInt adjacency[], PetscSection partSection, IS *partition)
+{
+  PetscPartitioner_RCB *p = (PetscPartitioner_RCB *) part->data;
+  MPI_Comm              comm;
+  DM                    cdm;
+  PetscSection          csection;
+  PetscSF               sfPoint;
+  Vec                   coordinates;
+  IS                    cellNumbering;
+  const PetscInt       *cellNum = NULL;
+  PetscReal            *coords, *wgts;
+  PetscInt             *idx, *assignment, *offsets, *points;
+  PetscInt              cdim, nroots, pStart, pEnd, pt, v, c, d;
+  PetscErrorCode        ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject) part, &comm);CHKERRQ(ierr);
+  ierr = DMGetCoordinateDim(dm, &cdim);CHKERRQ(ierr);
+  if (cdim > 3) SETERRQ1(comm, PETSC_ERR_SUP, "Coordinate dimension %D > 3 is not supported", cdim);
+  ierr = DMGetCoordinateDM(dm, &cdm);CHKERRQ(ierr);
+  ierr = DMGetDefaultSection(cdm, &csection);CHKERRQ(ierr);
+  ierr = DMGetCoordinatesLocal(dm, &coordinates);CHKERRQ(ierr);
+  ierr = DMPlexGetHeightStratum(dm, part->height, &pStart, &pEnd);CHKERRQ(ierr);
+  ierr = DMGetPointSF(dm, &sfPoint);CHKERRQ(ierr);
+  ierr = PetscSFGetGraph(sfPoint, &nroots, NULL, NULL, NULL);CHKERRQ(ierr);
+  if (nroots >= 0) {
+    ierr = DMPlexGetCellNumbering(dm, &cellNumbering);CHKERRQ(ierr);
+    ierr = ISGetIndices(cellNumbering, &cellNum);CHKERRQ(ierr);
+  }
+  /* Each graph vertex is placed at the mean of the coordinates in the closure of its point */
+  ierr = PetscMalloc4(numVertices*cdim, &coords, numVertices, &wgts, numVertices, &idx, numVertices, &assignment);CHKERRQ(ierr);
+  for (pt = pStart, v = 0; pt < pEnd; ++pt) {
+    PetscScalar *x = NULL;
+    PetscInt     csize, nc;
+
+    if (cellNum && cellNum[pt] < 0) continue;
+    ierr = DMPlexVecGetClosure(cdm, csection, coordinates, pt, &csize, &x);CHKERRQ(ierr);
+    nc   = csize/cdim;
+    for (d = 0; d < cdim; ++d) {
+      coords[v*cdim+d] = 0.0;
+      for (c = 0; c < nc; ++c) coords[v*cdim+d] += PetscRealPart(x[c*cdim+d])/nc;
+    }
+    ierr = DMPlexVecRestoreClosure(cdm, csection, coordinates, pt, &csize, &x);CHKERRQ(ierr);
+    wgts[v] = part->vwgt ? 0.0 : 1.0;
+    for (c = 0; part->vwgt && c < part->ncon; ++c) wgts[v] += part->vwgt[v*part->ncon+c];
+    idx[v]  = v;
+    ++v;
+  }
+  if (cellNum) {ierr = ISRestoreIndices(cellNumbering, &cellNum);CHKERRQ(ierr);}
+  if (v != numVertices) SETERRQ2(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Number of points %D should be %D", v, numVertices);
+  ierr = PetscPartitionerRCBBisect_Static(comm, p->maxIts, cdim, coords, wgts, numVertices, idx, 0, nparts, assignment);CHKERRQ(ierr);
+  /* Convert to PetscSection+IS */
+  ierr = PetscSectionSetChart(partSection, 0, nparts);CHKERRQ(ierr);
+  for (v = 0; v < numVertices; ++v) {ierr = PetscSectionAddDof(partSection, assignment[v], 1);CHKERRQ(ierr);}
+  ierr = PetscSectionSetUp(partSection);CHKERRQ(ierr);
+  ierr = PetscMalloc2(nparts, &offsets, numVertices, &points);CHKERRQ(ierr);
+  for (pt = 0; pt < nparts; ++pt) {ierr = PetscSectionGetOffset(partSection, pt, &offsets[pt]);CHKERRQ(ierr);}
+  for (v = 0; v < numVertices; ++v) points[offsets[assignment[v]]++] = v;
+  ierr = ISCreateGeneral(comm, numVertices, points, PETSC_COPY_VALUES, partition);CHKERRQ(ierr);
+  ierr = PetscFree2(offsets, points);CHKERRQ(ierr);
+  ierr = PetscFree4(coords, wgts, idx, assignment);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscPartitionerInitialize_RCB"
+PetscErrorCode PetscPartitionerInitialize_RCB(PetscPartitioner part)
+{
+  PetscFunctionBegin;
+  part->ops->view           = PetscPartitionerView_RCB;
+  part->ops->setfromoptions = PetscPartitionerSetFromOptions_RCB;
+  part->ops->destroy        = PetscPartitionerDestroy_RCB;
+  part->ops->partition      = PetscPartitionerPartition_RCB;
+  PetscFunctionReturn(0);
+}
+
+/*MC
+  PETSCPARTITIONERRCB = "rcb" - A PetscPartitioner object using recursive coordinate bisection
+
+  Recursively cuts the longest side of the bounding box of the cell centroids, so that the vertex weights on each side
+  are in proportion to the number of partitions on that side. It needs no external package and works on meshes which
+  are already distributed, but ignores the edge weights and only gives compact, not minimal, interfaces.
+
+  Options Database Key:
+. -petscpartitioner_rcb_max_it <n> - The maximum number of bisection steps used to locate each cut
+
+  Level: intermediate
+
+.seealso: PetscPartitionerType, PetscPartitionerCreate(), PetscPartitionerSetType(), PetscPartitionerSetVertexWeights()
+M*/
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscPartitionerCreate_RCB"
+PETSC_EXTERN PetscErrorCode PetscPartitionerCreate_RCB(PetscPartitioner part)
+{
+  PetscPartitioner_RCB *p;
+  PetscErrorCode        ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(part, PETSCPARTITIONER_CLASSID, 1);
+  ierr       = PetscNewLog(part, &p);CHKERRQ(ierr);
+  part->data = p;
+  p->maxIts  = 50;
+
+  ierr = PetscPartitionerInitialize_RCB(part);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "PetscPartitionerDestroy_Chaco"
 PetscErrorCode PetscPartitionerDestroy_Chaco(PetscPartitioner part)
@@ -983,6 +1771,15 @@ PetscErrorCode PetscPartitionerPartition_Chaco(PetscPartitioner part, DM dm, Pet
   }
   FREE_GRAPH = 0;                         /* Do not let Chaco free my memory */
   for (i = 0; i < start[numVertices]; ++i) ++adjacency[i];
+  if (part->ncon > 1) SETERRQ1(comm, PETSC_ERR_SUP, "Chaco supports a single vertex weight, not %D", part->ncon);
+  if (part->vwgt) {
+    ierr = PetscMalloc1(nvtxs, &vwgts);CHKERRQ(ierr);
+    for (v = 0; v < nvtxs; ++v) vwgts[v] = (int) part->vwgt[v];
+  }
+  if (part->adjwgt) {
+    ierr = PetscMalloc1(start[numVertices], &ewgts);CHKERRQ(ierr);
+    for (i = 0; i < start[numVertices]; ++i) ewgts[i] = (float) part->adjwgt[i];
+  }
 
   if (global_method == INERTIAL_METHOD) {
     /* manager.createCellCoordinates(nvtxs, &x, &y, &z); */
@@ -1042,6 +1839,8 @@ PetscErrorCode PetscPartitionerPartition_Chaco(PetscPartitioner part, DM dm, Pet
     /* manager.destroyCellCoordinates(nvtxs, &x, &y, &z); */
   }
   ierr = PetscFree(assignment);CHKERRQ(ierr);
+  ierr = PetscFree(vwgts);CHKERRQ(ierr);
+  ierr = PetscFree(ewgts);CHKERRQ(ierr);
   for (i = 0; i < start[numVertices]; ++i) --adjacency[i];
   PetscFunctionReturn(0);
 #else
@@ -1139,11 +1938,11 @@ PetscErrorCode PetscPartitionerPartition_ParMetis(PetscPartitioner part, DM dm,
   PetscInt      *vtxdist;                  /* Distribution of vertices across processes */
   PetscInt      *xadj       = start;       /* Start of edge list for each vertex */
   PetscInt      *adjncy     = adjacency;   /* Edge lists for all vertices */
-  PetscInt      *vwgt       = NULL;        /* Vertex weights */
-  PetscInt      *adjwgt     = NULL;        /* Edge weights */
-  PetscInt       wgtflag    = 0;           /* Indicates which weights are present */
+  PetscInt      *vwgt       = part->vwgt;  /* Vertex weights */
+  PetscInt      *adjwgt     = part->adjwgt;/* Edge weights */
+  PetscInt       wgtflag    = (vwgt ? 2 : 0) + (adjwgt ? 1 : 0); /* Indicates which weights are present */
   PetscInt       numflag    = 0;           /* Indicates initial offset (0 or 1) */
-  PetscInt       ncon       = 1;           /* The number of weights per vertex */
+  PetscInt       ncon       = PetscMax(part->ncon, 1); /* The number of weights per vertex */
   PetscReal     *tpwgts;                   /* The fraction of vertex weights assigned to each partition */
   PetscReal     *ubvec;                    /* The balance intolerance for vertex weights */
   PetscInt       options[5];               /* Options */
@@ -1165,10 +1964,10 @@ PetscErrorCode PetscPartitionerPartition_ParMetis(PetscPartitioner part, DM dm,
     vtxdist[p] += vtxdist[p-1];
   }
   /* Calculate weights */
-  for (p = 0; p < nparts; ++p) {
+  for (p = 0; p < nparts*ncon; ++p) {
     tpwgts[p] = 1.0/nparts;
   }
-  ubvec[0] = 1.05;
+  for (i = 0; i < ncon; ++i) ubvec[i] = 1.05;
 
   if (nparts == 1) {
     ierr = PetscMemzero(assignment, nvtxs * sizeof(PetscInt));
@@ -1340,10 +2139,10 @@ static PetscErrorCode DMPlexPartitionLabelClosure_Tree(DM dm, DMLabel label, Pet
 @*/
 PetscErrorCode DMPlexPartitionLabelClosure(DM dm, DMLabel label)
 {
-  IS              rankIS,   pointIS;
+  IS              rankIS,   pointIS, closureIS;
   const PetscInt *ranks,   *points;
-  PetscInt        numRanks, numPoints, r, p, c, closureSize;
-  PetscInt       *closure = NULL;
+  PetscInt        numRanks, numPoints, r, p, c, closureSize, maxSize = 0, n;
+  PetscInt       *closure = NULL, *closurePoints = NULL;
   PetscErrorCode  ierr;
 
   PetscFunctionBegin;
@@ -1356,17 +2155,31 @@ PetscErrorCode DMPlexPartitionLabelClosure(DM dm, DMLabel label)
     ierr = DMLabelGetStratumIS(label, rank, &pointIS);CHKERRQ(ierr);
     ierr = ISGetLocalSize(pointIS, &numPoints);CHKERRQ(ierr);
     ierr = ISGetIndices(pointIS, &points);CHKERRQ(ierr);
-    for (p = 0; p < numPoints; ++p) {
+    /* Collect the closure and insert it into the stratum at once */
+    for (n = 0, p = 0; p < numPoints; ++p) {
       ierr = DMPlexGetTransitiveClosure(dm, points[p], PETSC_TRUE, &closureSize, &closure);CHKERRQ(ierr);
+      if (n + closureSize > maxSize) {
+        PetscInt *tmp;
+
+        maxSize = PetscMax(2*maxSize, n + closureSize);
+        ierr = PetscMalloc1(maxSize, &tmp);CHKERRQ(ierr);
+        ierr = PetscMemcpy(tmp, closurePoints, n * sizeof(PetscInt));CHKERRQ(ierr);
+        ierr = PetscFree(closurePoints);CHKERRQ(ierr);
+        closurePoints = tmp;
+      }
       for (c = 0; c < closureSize*2; c += 2) {
-        ierr = DMLabelSetValue(label, closure[c], rank);CHKERRQ(ierr);
+        closurePoints[n++] = closure[c];
         ierr = DMPlexPartitionLabelClosure_Tree(dm,label,rank,closure[c]);CHKERRQ(ierr);
       }
     }
+    ierr = ISCreateGeneral(PETSC_COMM_SELF, n, closurePoints, PETSC_USE_POINTER, &closureIS);CHKERRQ(ierr);
+    ierr = DMLabelInsertIS(label, closureIS, rank);CHKERRQ(ierr);
+    ierr = ISDestroy(&closureIS);CHKERRQ(ierr);
     ierr = ISRestoreIndices(pointIS, &points);CHKERRQ(ierr);
     ierr = ISDestroy(&pointIS);CHKERRQ(ierr);
   }
   if (closure) {ierr = DMPlexRestoreTransitiveClosure(dm, 0, PETSC_TRUE, &closureSize, &closure);CHKERRQ(ierr);}
+  ierr = PetscFree(closurePoints);CHKERRQ(ierr);
   ierr = ISRestoreIndices(rankIS, &ranks);CHKERRQ(ierr);
   ierr = ISDestroy(&rankIS);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -1,6 +1,8 @@
 #include <petsc/private/dmpleximpl.h>   /*I      "petscdmplex.h"   I*/
 #include <petsc/private/matorderimpl.h> /*I      "petscmat.h"      I*/
 
+const char *const DMPlexReorderTypes[] = {"NONE","RCM","HILBERT","MORTON","DMPlexReorderType","DMPLEX_REORDER_",0};
+
 #undef __FUNCT__
 #define __FUNCT__ "DMPlexCreateOrderingClosure_Static"
 PetscErrorCode DMPlexCreateOrderingClosure_Static(DM dm, PetscInt numPoints, const PetscInt pperm[], PetscInt **clperm, PetscInt **invclperm)
@@ -47,6 +49,152 @@ PetscErrorCode DMPlexCreateOrderingClosure_Static(DM dm, PetscInt numPoints, con
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexCreateCellOrderingRCM_Static"
+/* Reverse Cuthill-McKee on the cell adjacency graph, cperm[new] = old */
+static PetscErrorCode DMPlexCreateCellOrderingRCM_Static(DM dm, PetscInt *numCells, PetscInt **cperm)
+{
+  PetscInt      *start = NULL, *adjacency = NULL, *mask, *xls, c, i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  *numCells = 0;
+  ierr = DMPlexCreateNeighborCSR(dm, 0, numCells, &start, &adjacency);CHKERRQ(ierr);
+  ierr = PetscMalloc1(*numCells, cperm);CHKERRQ(ierr);
+  ierr = PetscMalloc2(*numCells,&mask,*numCells*2,&xls);CHKERRQ(ierr);
+  if (*numCells) {
+    /* Shift for Fortran numbering */
+    for (i = 0; i < start[*numCells]; ++i) ++adjacency[i];
+    for (i = 0; i <= *numCells; ++i)       ++start[i];
+    ierr = SPARSEPACKgenrcm(numCells, start, adjacency, *cperm, mask, xls);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(start);CHKERRQ(ierr);
+  ierr = PetscFree(adjacency);CHKERRQ(ierr);
+  ierr = PetscFree2(mask,xls);CHKERRQ(ierr);
+  /* Shift for Fortran numbering */
+  for (c = 0; c < *numCells; ++c) --(*cperm)[c];
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexCurveIndex_Static"
+/*
+  The index of the quantized point X, with b bits per coordinate, along the Morton (Z-order) or Hilbert curve. The
+  Hilbert transform is Skilling's, "Programming the Hilbert curve", AIP Conf. Proc. 707, 2004. X is overwritten.
+*/
+static PetscInt DMPlexCurveIndex_Static(PetscInt dim, PetscInt b, PetscBool hilbert, unsigned int X[])
+{
+  PetscInt key = 0, bit, d;
+
+  if (hilbert) {
+    const unsigned int M = 1U << (b-1);
+    unsigned int       P, Q, t;
+
+    /* Inverse undo */
+    for (Q = M; Q > 1; Q >>= 1) {
+      P = Q - 1;
+      for (d = 0; d < dim; ++d) {
+        if (X[d] & Q) X[0] ^= P;
+        else {
+          t     = (X[0] ^ X[d]) & P;
+          X[0] ^= t;
+          X[d] ^= t;
+        }
+      }
+    }
+    /* Gray encode */
+    for (d = 1; d < dim; ++d) X[d] ^= X[d-1];
+    t = 0;
+    for (Q = M; Q > 1; Q >>= 1) if (X[dim-1] & Q) t ^= Q - 1;
+    for (d = 0; d < dim; ++d) X[d] ^= t;
+  }
+  /* Interleave the bits, most significant first */
+  for (bit = b-1; bit >= 0; --bit) for (d = 0; d < dim; ++d) key = (key << 1) | ((X[d] >> bit) & 1U);
+  return key;
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexCreateCellOrderingCurve_Static"
+/* Sort cells by the position of their vertex centroid along a space filling curve, cperm[new] = old */
+static PetscErrorCode DMPlexCreateCellOrderingCurve_Static(DM dm, PetscBool hilbert, PetscInt *numCells, PetscInt **cperm)
+{
+  DM             cdm;
+  PetscSection   csection;
+  Vec            coordinates;
+  PetscReal     *centroids, lo[3], hi[3], ext = 0.0;
+  PetscInt      *keys, cdim, b, cStart, cEnd, c, d;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMGetCoordinateDim(dm, &cdim);CHKERRQ(ierr);
+  if (cdim > 3) SETERRQ1(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "Space filling curve ordering not supported in dimension %d", cdim);
+  ierr = DMGetCoordinateDM(dm, &cdm);CHKERRQ(ierr);
+  ierr = DMGetDefaultSection(cdm, &csection);CHKERRQ(ierr);
+  ierr = DMGetCoordinatesLocal(dm, &coordinates);CHKERRQ(ierr);
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  *numCells = cEnd - cStart;
+  ierr = PetscMalloc1(*numCells, cperm);CHKERRQ(ierr);
+  ierr = PetscMalloc2(*numCells*cdim, &centroids, *numCells, &keys);CHKERRQ(ierr);
+  for (d = 0; d < cdim; ++d) {lo[d] = PETSC_MAX_REAL; hi[d] = PETSC_MIN_REAL;}
+  for (c = cStart; c < cEnd; ++c) {
+    PetscScalar *coords = NULL;
+    PetscReal   *cent   = &centroids[(c-cStart)*cdim];
+    PetscInt     csize, numVerts, v;
+
+    ierr = DMPlexVecGetClosure(cdm, csection, coordinates, c, &csize, &coords);CHKERRQ(ierr);
+    numVerts = csize/cdim;
+    for (d = 0; d < cdim; ++d) {
+      cent[d] = 0.0;
+      for (v = 0; v < numVerts; ++v) cent[d] += PetscRealPart(coords[v*cdim+d]);
+      cent[d] /= numVerts;
+      lo[d]    = PetscMin(lo[d], cent[d]);
+      hi[d]    = PetscMax(hi[d], cent[d]);
+    }
+    ierr = DMPlexVecRestoreClosure(cdm, csection, coordinates, c, &csize, &coords);CHKERRQ(ierr);
+  }
+  for (d = 0; d < cdim; ++d) ext = PetscMax(ext, hi[d] - lo[d]);
+  /* Use as many bits per coordinate as fit in a nonnegative PetscInt key */
+  b = PetscMin((PetscInt) (sizeof(PetscInt)*8 - 2)/cdim, 31);
+  for (c = 0; c < *numCells; ++c) {
+    unsigned int X[3];
+
+    for (d = 0; d < cdim; ++d) X[d] = ext > 0.0 ? (unsigned int) ((centroids[c*cdim+d] - lo[d])/ext * (PetscReal) ((1U << b) - 1)) : 0;
+    keys[c]      = DMPlexCurveIndex_Static(cdim, b, hilbert, X);
+    (*cperm)[c] = c;
+  }
+  ierr = PetscSortIntWithArray(*numCells, keys, *cperm);CHKERRQ(ierr);
+  ierr = PetscFree2(centroids, keys);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexCreateOrdering_Static"
+/* The point permutation induced by a cell ordering, perm[old] = new */
+static PetscErrorCode DMPlexCreateOrdering_Static(DM dm, DMPlexReorderType rtype, IS *perm)
+{
+  PetscInt      *cperm, *clperm, *invclperm, numCells, pStart, pEnd;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  switch (rtype) {
+  case DMPLEX_REORDER_RCM:
+    ierr = DMPlexCreateCellOrderingRCM_Static(dm, &numCells, &cperm);CHKERRQ(ierr);break;
+  case DMPLEX_REORDER_HILBERT:
+  case DMPLEX_REORDER_MORTON:
+    ierr = DMPlexCreateCellOrderingCurve_Static(dm, rtype == DMPLEX_REORDER_HILBERT ? PETSC_TRUE : PETSC_FALSE, &numCells, &cperm);CHKERRQ(ierr);break;
+  default:
+    SETERRQ1(PetscObjectComm((PetscObject) dm), PETSC_ERR_ARG_OUTOFRANGE, "Invalid reordering type %s", DMPlexReorderTypes[rtype]);
+  }
+  /* Construct closure */
+  ierr = DMPlexCreateOrderingClosure_Static(dm, numCells, cperm, &clperm, &invclperm);CHKERRQ(ierr);
+  ierr = PetscFree(cperm);CHKERRQ(ierr);
+  ierr = PetscFree(clperm);CHKERRQ(ierr);
+  /* Invert permutation */
+  ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
+  ierr = ISCreateGeneral(PetscObjectComm((PetscObject) dm), pEnd-pStart, invclperm, PETSC_OWN_POINTER, perm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "DMPlexGetOrdering"
 /*@
@@ -70,36 +218,16 @@ $     MATORDERINGQMD - Quotient Minimum Degree
   Level: intermediate
 
 .keywords: mesh
-.seealso: MatGetOrdering()
+.seealso: MatGetOrdering(), DMPlexReorder()
 @*/
 PetscErrorCode DMPlexGetOrdering(DM dm, MatOrderingType otype, IS *perm)
 {
-  PetscInt       numCells = 0;
-  PetscInt      *start = NULL, *adjacency = NULL, *cperm, *clperm, *invclperm, *mask, *xls, pStart, pEnd, c, i;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
   PetscValidPointer(perm, 3);
-  ierr = DMPlexCreateNeighborCSR(dm, 0, &numCells, &start, &adjacency);CHKERRQ(ierr);
-  ierr = PetscMalloc3(numCells,&cperm,numCells,&mask,numCells*2,&xls);CHKERRQ(ierr);
-  if (numCells) {
-    /* Shift for Fortran numbering */
-    for (i = 0; i < start[numCells]; ++i) ++adjacency[i];
-    for (i = 0; i <= numCells; ++i)       ++start[i];
-    ierr = SPARSEPACKgenrcm(&numCells, start, adjacency, cperm, mask, xls);CHKERRQ(ierr);
-  }
-  ierr = PetscFree(start);CHKERRQ(ierr);
-  ierr = PetscFree(adjacency);CHKERRQ(ierr);
-  /* Shift for Fortran numbering */
-  for (c = 0; c < numCells; ++c) --cperm[c];
-  /* Construct closure */
-  ierr = DMPlexCreateOrderingClosure_Static(dm, numCells, cperm, &clperm, &invclperm);CHKERRQ(ierr);
-  ierr = PetscFree3(cperm,mask,xls);CHKERRQ(ierr);
-  ierr = PetscFree(clperm);CHKERRQ(ierr);
-  /* Invert permutation */
-  ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
-  ierr = ISCreateGeneral(PetscObjectComm((PetscObject) dm), pEnd-pStart, invclperm, PETSC_OWN_POINTER, perm);CHKERRQ(ierr);
+  ierr = DMPlexCreateOrdering_Static(dm, DMPLEX_REORDER_RCM, perm);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -144,17 +272,67 @@ PetscErrorCode DMPlexPermute(DM dm, IS perm, DM *pdm)
     ierr = PetscSectionDestroy(&sectionNew);CHKERRQ(ierr);
   }
   plexNew = (DM_Plex *) (*pdm)->data;
+  plexNew->useCone    = plex->useCone;
+  plexNew->useClosure = plex->useClosure;
+  plexNew->useAnchors = plex->useAnchors;
   /* Ignore ltogmap, ltogmapb */
-  /* Ignore sf, defaultSF */
+  /* Ignore defaultSF, it is rebuilt from the point SF */
   /* Ignore globalVertexNumbers, globalCellNumbers */
+  /* Remap point SF */
+  {
+    PetscSF            sf, sfNew;
+    const PetscSFNode *iremote;
+    const PetscInt    *ilocal, *pperm;
+    PetscSFNode       *iremoteNew;
+    PetscInt          *ilocalNew, *remotePoints, *ranks, *indices;
+    PetscInt           nroots, nleaves, pStart, pEnd, l;
+
+    ierr = DMGetPointSF(dm, &sf);CHKERRQ(ierr);
+    ierr = PetscSFGetGraph(sf, &nroots, &nleaves, &ilocal, &iremote);CHKERRQ(ierr);
+    if (nroots >= 0) {
+      ierr = DMPlexGetChart(dm, &pStart, &pEnd);CHKERRQ(ierr);
+      ierr = ISGetIndices(perm, &pperm);CHKERRQ(ierr);
+      /* The new number of each remote point is found on its owner */
+      ierr = PetscMalloc1(pEnd-pStart, &remotePoints);CHKERRQ(ierr);
+      ierr = PetscSFBcastBegin(sf, MPIU_INT, pperm, remotePoints);CHKERRQ(ierr);
+      ierr = PetscSFBcastEnd(sf, MPIU_INT, pperm, remotePoints);CHKERRQ(ierr);
+      ierr = PetscMalloc1(nleaves, &ilocalNew);CHKERRQ(ierr);
+      ierr = PetscMalloc1(nleaves, &iremoteNew);CHKERRQ(ierr);
+      ierr = PetscMalloc2(nleaves, &ranks, nleaves, &indices);CHKERRQ(ierr);
+      for (l = 0; l < nleaves; ++l) {
+        const PetscInt leaf = ilocal ? ilocal[l] : l;
+
+        ilocalNew[l] = pperm[leaf];
+        ranks[l]     = iremote[l].rank;
+        indices[l]   = remotePoints[leaf];
+      }
+      /* Keep the leaves sorted */
+      ierr = PetscSortIntWithArrayPair(nleaves, ilocalNew, ranks, indices);CHKERRQ(ierr);
+      for (l = 0; l < nleaves; ++l) {
+        iremoteNew[l].rank  = ranks[l];
+        iremoteNew[l].index = indices[l];
+      }
+      ierr = PetscFree2(ranks, indices);CHKERRQ(ierr);
+      ierr = PetscFree(remotePoints);CHKERRQ(ierr);
+      ierr = ISRestoreIndices(perm, &pperm);CHKERRQ(ierr);
+      ierr = PetscSFCreate(PetscObjectComm((PetscObject) dm), &sfNew);CHKERRQ(ierr);
+      ierr = PetscObjectSetName((PetscObject) sfNew, "Point SF");CHKERRQ(ierr);
+      ierr = PetscSFSetGraph(sfNew, nroots, nleaves, ilocalNew, PETSC_OWN_POINTER, iremoteNew, PETSC_OWN_POINTER);CHKERRQ(ierr);
+      ierr = DMSetPointSF(*pdm, sfNew);CHKERRQ(ierr);
+      ierr = PetscSFDestroy(&sfNew);CHKERRQ(ierr);
+    }
+  }
   /* Remap coordinates */
   {
-    DM              cdm, cdmNew;
-    PetscSection    csection, csectionNew;
-    Vec             coordinates, coordinatesNew;
-    PetscScalar    *coords, *coordsNew;
-    const PetscInt *pperm;
-    PetscInt        pStart, pEnd, p;
+    DM                    cdm, cdmNew;
+    PetscSF               sfNew;
+    PetscSection          csection, csectionNew;
+    Vec                   coordinates, coordinatesNew;
+    PetscScalar          *coords, *coordsNew;
+    const PetscInt       *pperm;
+    const PetscReal      *maxCell, *L;
+    const DMBoundaryType *bd;
+    PetscInt              pStart, pEnd, p;
 
     ierr = DMGetCoordinateDM(dm, &cdm);CHKERRQ(ierr);
     ierr = DMGetDefaultSection(cdm, &csection);CHKERRQ(ierr);
@@ -178,9 +356,13 @@ PetscErrorCode DMPlexPermute(DM dm, IS perm, DM *pdm)
     ierr = VecRestoreArray(coordinatesNew, &coordsNew);CHKERRQ(ierr);
     ierr = DMGetCoordinateDM(*pdm, &cdmNew);CHKERRQ(ierr);
     ierr = DMSetDefaultSection(cdmNew, csectionNew);CHKERRQ(ierr);
+    ierr = DMGetPointSF(*pdm, &sfNew);CHKERRQ(ierr);
+    ierr = DMSetPointSF(cdmNew, sfNew);CHKERRQ(ierr);
     ierr = DMSetCoordinatesLocal(*pdm, coordinatesNew);CHKERRQ(ierr);
     ierr = PetscSectionDestroy(&csectionNew);CHKERRQ(ierr);
     ierr = VecDestroy(&coordinatesNew);CHKERRQ(ierr);
+    ierr = DMGetPeriodicity(dm, &maxCell, &L, &bd);CHKERRQ(ierr);
+    if (L) {ierr = DMSetPeriodicity(*pdm, maxCell, L, bd);CHKERRQ(ierr);}
   }
   /* Reorder labels */
   {
@@ -240,3 +422,114 @@ PetscErrorCode DMPlexPermute(DM dm, IS perm, DM *pdm)
   }
   PetscFunctionReturn(0);
 }
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexSetReorderType"
+/*@
+  DMPlexSetReorderType - Set the reordering of local mesh points applied after distribution
+
+  Logically collective on DM
+
+  Input Parameters:
++ dm   - The DMPlex object
+- type - The reordering type, DMPLEX_REORDER_NONE, DMPLEX_REORDER_RCM, DMPLEX_REORDER_HILBERT, or DMPLEX_REORDER_MORTON
+
+  Options Database Key:
+. -dm_plex_reorder <none,rcm,hilbert,morton> - The reordering type
+
+  Level: intermediate
+
+.seealso: DMPlexGetReorderType(), DMPlexReorder(), DMPlexDistribute()
+@*/
+PetscErrorCode DMPlexSetReorderType(DM dm, DMPlexReorderType type)
+{
+  DM_Plex *mesh = (DM_Plex *) dm->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  PetscValidLogicalCollectiveEnum(dm, type, 2);
+  mesh->reorderType = type;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexGetReorderType"
+/*@
+  DMPlexGetReorderType - Get the reordering of local mesh points applied after distribution
+
+  Not collective
+
+  Input Parameter:
+. dm   - The DMPlex object
+
+  Output Parameter:
+. type - The reordering type
+
+  Level: intermediate
+
+.seealso: DMPlexSetReorderType(), DMPlexReorder(), DMPlexDistribute()
+@*/
+PetscErrorCode DMPlexGetReorderType(DM dm, DMPlexReorderType *type)
+{
+  DM_Plex *mesh = (DM_Plex *) dm->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  PetscValidPointer(type, 2);
+  *type = mesh->reorderType;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexReorder"
+/*@
+  DMPlexReorder - Renumber the local mesh points to improve cache locality
+
+  Collective on DM
+
+  Input Parameters:
++ dm   - The DMPlex object
+- type - The reordering type
+
+  Output Parameters:
++ perm - The point permutation, perm[old] = new, or NULL
+- rdm  - The reordered DM, or NULL if the mesh was not reordered
+
+  Notes:
+  The cells on each process are ordered either by Reverse Cuthill-McKee on the cell adjacency graph, or by the position of
+  their centroids along a Hilbert or Morton space filling curve. The remaining points are numbered by their first
+  appearance in the closure of a cell, so that faces, edges, and vertices follow the cell order. The default section,
+  coordinates, labels, and point SF are permuted to match. Meshes with hybrid cells, a tree, or anchors are not reordered.
+
+  Level: intermediate
+
+.seealso: DMPlexSetReorderType(), DMPlexGetOrdering(), DMPlexPermute(), DMPlexDistribute()
+@*/
+PetscErrorCode DMPlexReorder(DM dm, DMPlexReorderType type, IS *perm, DM *rdm)
+{
+  DM_Plex       *mesh = (DM_Plex *) dm->data;
+  IS             pperm;
+  PetscInt       cMax;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  if (perm) PetscValidPointer(perm, 3);
+  PetscValidPointer(rdm, 4);
+  if (perm) *perm = NULL;
+  *rdm = NULL;
+  if (type == DMPLEX_REORDER_NONE) PetscFunctionReturn(0);
+  ierr = DMPlexGetHybridBounds(dm, &cMax, NULL, NULL, NULL);CHKERRQ(ierr);
+  if (cMax >= 0 || mesh->parentSection || mesh->anchorSection) {
+    ierr = PetscInfo(dm, "Not reordering a mesh with hybrid cells, a tree, or anchors\n");CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = PetscLogEventBegin(DMPLEX_Reorder,dm,0,0,0);CHKERRQ(ierr);
+  ierr = PetscInfo1(dm, "Reordering local mesh points with %s\n", DMPlexReorderTypes[type]);CHKERRQ(ierr);
+  ierr = DMPlexCreateOrdering_Static(dm, type, &pperm);CHKERRQ(ierr);
+  ierr = DMPlexPermute(dm, pperm, rdm);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(DMPLEX_Reorder,dm,0,0,0);CHKERRQ(ierr);
+  if (perm) *perm = pperm;
+  else {ierr = ISDestroy(&pperm);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
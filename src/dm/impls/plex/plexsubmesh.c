@@ -66,7 +66,8 @@ PetscErrorCode DMPlexLabelComplete(DM dm, DMLabel label)
 {
   IS              valueIS;
   const PetscInt *values;
-  PetscInt        numValues, v;
+  PetscInt        numValues, maxSize = 0, v;
+  PetscInt       *closurePoints = NULL;
   PetscErrorCode  ierr;
 
   PetscFunctionBegin;
@@ -74,9 +75,9 @@ PetscErrorCode DMPlexLabelComplete(DM dm, DMLabel label)
   ierr = DMLabelGetValueIS(label, &valueIS);CHKERRQ(ierr);
   ierr = ISGetIndices(valueIS, &values);CHKERRQ(ierr);
   for (v = 0; v < numValues; ++v) {
-    IS              pointIS;
+    IS              pointIS, closureIS;
     const PetscInt *points;
-    PetscInt        numPoints, p;
+    PetscInt        numPoints, n = 0, p;
 
     ierr = DMLabelGetStratumSize(label, values[v], &numPoints);CHKERRQ(ierr);
     ierr = DMLabelGetStratumIS(label, values[v], &pointIS);CHKERRQ(ierr);
@@ -86,14 +87,26 @@ PetscErrorCode DMPlexLabelComplete(DM dm, DMLabel label)
       PetscInt  closureSize, c;
 
       ierr = DMPlexGetTransitiveClosure(dm, points[p], PETSC_TRUE, &closureSize, &closure);CHKERRQ(ierr);
-      for (c = 0; c < closureSize*2; c += 2) {
-        ierr = DMLabelSetValue(label, closure[c], values[v]);CHKERRQ(ierr);
+      if (n + closureSize > maxSize) {
+        PetscInt *tmp;
+
+        maxSize = PetscMax(2*maxSize, n + closureSize);
+        ierr = PetscMalloc1(maxSize, &tmp);CHKERRQ(ierr);
+        ierr = PetscMemcpy(tmp, closurePoints, n * sizeof(PetscInt));CHKERRQ(ierr);
+        ierr = PetscFree(closurePoints);CHKERRQ(ierr);
+        closurePoints = tmp;
       }
+      for (c = 0; c < closureSize*2; c += 2) closurePoints[n++] = closure[c];
       ierr = DMPlexRestoreTransitiveClosure(dm, points[p], PETSC_TRUE, &closureSize, &closure);CHKERRQ(ierr);
     }
     ierr = ISRestoreIndices(pointIS, &points);CHKERRQ(ierr);
     ierr = ISDestroy(&pointIS);CHKERRQ(ierr);
+    /* Insert the whole closure into the stratum at once */
+    ierr = ISCreateGeneral(PETSC_COMM_SELF, n, closurePoints, PETSC_USE_POINTER, &closureIS);CHKERRQ(ierr);
+    ierr = DMLabelInsertIS(label, closureIS, values[v]);CHKERRQ(ierr);
+    ierr = ISDestroy(&closureIS);CHKERRQ(ierr);
   }
+  ierr = PetscFree(closurePoints);CHKERRQ(ierr);
   ierr = ISRestoreIndices(valueIS, &values);CHKERRQ(ierr);
   ierr = ISDestroy(&valueIS);CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -0,0 +1,150 @@
+static char help[] = "Tests the setup of PCGAMG with reused interpolation for operators with new values and with a new nonzero pattern.\n\n";
+
+/*
+Use the options
+     -n <n>     - the grid is n by n
+     -ninepoint - start from the nine point stencil, so the nonzero pattern does not change
+     -view_smoother - view the finest level smoother after each solve, to show its eigenvalue bounds
+*/
+
+#include <petscksp.h>
+
+#undef __FUNCT__
+#define __FUNCT__ "AssembleOperator"
+/* Assembles a diffusion operator with the coefficient 1 + alpha x y, with the diagonal neighbors when ninepoint is set */
+static PetscErrorCode AssembleOperator(Mat A,PetscInt n,PetscReal alpha,PetscBool ninepoint)
+{
+  PetscInt       rstart,rend,row,col,i,j,di,dj;
+  PetscReal      h = 1.0/(n+1),k;
+  PetscScalar    v;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatZeroEntries(A);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(A,&rstart,&rend);CHKERRQ(ierr);
+  for (row=rstart; row<rend; row++) {
+    i = row % n; j = row / n;
+    k = 1.0 + alpha*(i+1)*h*(j+1)*h;
+    for (dj=-1; dj<=1; dj++) {
+      for (di=-1; di<=1; di++) {
+        if (i+di < 0 || i+di >= n || j+dj < 0 || j+dj >= n) continue;
+        if (di && dj && !ninepoint) continue;
+        col = row + dj*n + di;
+        if (!di && !dj) v = ninepoint ? 8.0*k/3.0 : 4.0*k;
+        else            v = ninepoint ? -k/3.0 : -k;
+        ierr = MatSetValues(A,1,&row,1,&col,&v,INSERT_VALUES);CHKERRQ(ierr);
+      }
+    }
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "CheckCoarseOperators"
+/* Checks that the coarse operators of the hierarchy are the Galerkin products of the current operator */
+static PetscErrorCode CheckCoarseOperators(PC pc,Mat A)
+{
+  KSP            smoother;
+  Mat            Afine = A,Acoarse,P,C;
+  PetscInt       nlevels,l;
+  PetscReal      nrm,err,maxerr = 0.0;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PCMGGetLevels(pc,&nlevels);CHKERRQ(ierr);
+  for (l=nlevels-1; l>0; l--) {
+    ierr = PCMGGetInterpolation(pc,l,&P);CHKERRQ(ierr);
+    ierr = PCMGGetSmoother(pc,l-1,&smoother);CHKERRQ(ierr);
+    ierr = KSPGetOperators(smoother,NULL,&Acoarse);CHKERRQ(ierr);
+    ierr = MatPtAP(Afine,P,MAT_INITIAL_MATRIX,1.0,&C);CHKERRQ(ierr);
+    ierr = MatNorm(C,NORM_FROBENIUS,&nrm);CHKERRQ(ierr);
+    ierr = MatAXPY(C,-1.0,Acoarse,DIFFERENT_NONZERO_PATTERN);CHKERRQ(ierr);
+    ierr = MatNorm(C,NORM_FROBENIUS,&err);CHKERRQ(ierr);
+    ierr = MatDestroy(&C);CHKERRQ(ierr);
+    maxerr = PetscMax(maxerr,err/nrm);
+    Afine  = Acoarse;
+  }
+  if (nlevels < 2)        {ierr = PetscPrintf(PETSC_COMM_WORLD,"  No coarse levels\n");CHKERRQ(ierr);}
+  else if (maxerr > 1e-12) {ierr = PetscPrintf(PETSC_COMM_WORLD,"  Relative error of the coarse operators %g\n",(double)maxerr);CHKERRQ(ierr);}
+  else                    {ierr = PetscPrintf(PETSC_COMM_WORLD,"  Coarse operators agree with the Galerkin products\n");CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "Solve"
+static PetscErrorCode Solve(KSP ksp,Mat A,Vec b,Vec x,const char *name)
+{
+  PC                 pc;
+  KSP                smoother;
+  PetscInt           its,nlevels;
+  PetscBool          view = PETSC_FALSE;
+  KSPConvergedReason reason;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = KSPSetOperators(ksp,A,A);CHKERRQ(ierr);
+  ierr = KSPSolve(ksp,b,x);CHKERRQ(ierr);
+  ierr = KSPGetIterationNumber(ksp,&its);CHKERRQ(ierr);
+  ierr = KSPGetConvergedReason(ksp,&reason);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"%s: %s in %D iterations\n",name,reason > 0 ? "converged" : "diverged",its);CHKERRQ(ierr);
+  ierr = KSPGetPC(ksp,&pc);CHKERRQ(ierr);
+  ierr = CheckCoarseOperators(pc,A);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,"-view_smoother",&view,NULL);CHKERRQ(ierr);
+  if (view) {
+    ierr = PCMGGetLevels(pc,&nlevels);CHKERRQ(ierr);
+    ierr = PCMGGetSmoother(pc,nlevels-1,&smoother);CHKERRQ(ierr);
+    ierr = KSPView(smoother,PETSC_VIEWER_STDOUT_WORLD);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "main"
+int main(int argc,char **argv)
+{
+  Mat            A;
+  Vec            x,b;
+  KSP            ksp;
+  PC             pc;
+  PetscInt       n = 32;
+  PetscBool      ninepoint = PETSC_FALSE;
+  PetscErrorCode ierr;
+
+  PetscInitialize(&argc,&argv,(char*)0,help);
+  ierr = PetscOptionsGetInt(NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,"-ninepoint",&ninepoint,NULL);CHKERRQ(ierr);
+
+  ierr = MatCreateAIJ(PETSC_COMM_WORLD,PETSC_DECIDE,PETSC_DECIDE,n*n,n*n,9,NULL,9,NULL,&A);CHKERRQ(ierr);
+  ierr = MatSetOption(A,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_FALSE);CHKERRQ(ierr);
+  ierr = AssembleOperator(A,n,0.0,ninepoint);CHKERRQ(ierr);
+  ierr = MatCreateVecs(A,&x,&b);CHKERRQ(ierr);
+  ierr = VecSet(b,1.0);CHKERRQ(ierr);
+
+  ierr = KSPCreate(PETSC_COMM_WORLD,&ksp);CHKERRQ(ierr);
+  ierr = KSPSetType(ksp,KSPCG);CHKERRQ(ierr);
+  ierr = KSPGetPC(ksp,&pc);CHKERRQ(ierr);
+  ierr = PCSetType(pc,PCGAMG);CHKERRQ(ierr);
+  ierr = PCGAMGSetReuseInterpolation(pc,PETSC_TRUE);CHKERRQ(ierr);
+  ierr = KSPSetTolerances(ksp,1.e-8,PETSC_DEFAULT,PETSC_DEFAULT,PETSC_DEFAULT);CHKERRQ(ierr);
+  ierr = KSPSetFromOptions(ksp);CHKERRQ(ierr);
+  ierr = Solve(ksp,A,b,x,"First setup");CHKERRQ(ierr);
+
+  /* New values in the same nonzero pattern, only the numeric values of the hierarchy are recomputed */
+  ierr = AssembleOperator(A,n,10.0,ninepoint);CHKERRQ(ierr);
+  ierr = Solve(ksp,A,b,x,"New values");CHKERRQ(ierr);
+  ierr = AssembleOperator(A,n,100.0,ninepoint);CHKERRQ(ierr);
+  ierr = Solve(ksp,A,b,x,"New values again");CHKERRQ(ierr);
+
+  /* The nine point stencil adds nonzeros, so the products are formed again with the same interpolation */
+  ierr = AssembleOperator(A,n,100.0,PETSC_TRUE);CHKERRQ(ierr);
+  ierr = Solve(ksp,A,b,x,"Nine point stencil");CHKERRQ(ierr);
+
+  ierr = KSPDestroy(&ksp);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&b);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return 0;
+}
@@ -0,0 +1,152 @@
+static char help[] = "Tests PCVPBJACOBI with diagonal blocks of different sizes and PCPBJACOBI with large block sizes.\n\n";
+
+/*
+Use the options
+     -nb <nb> - number of diagonal blocks per process
+     -bs <bs> - all the blocks have size bs and the matrix has block size bs, otherwise the block sizes vary from 1 to 32
+*/
+
+#include <petscksp.h>
+
+static const PetscInt sizes[] = {1,9,2,13,5,20,3,32,7,16};
+
+#undef __FUNCT__
+#define __FUNCT__ "AssembleOperator"
+/*
+   Assembles dense diagonal blocks coupled to their neighbors through the first and last rows, the coupling is left out
+   when blockonly is set. Every third block has its rows rotated, so its inversion needs pivoting.
+*/
+static PetscErrorCode AssembleOperator(Mat A,PetscInt nblocks,const PetscInt bsizes[],PetscInt gblock,PetscBool blockonly)
+{
+  PetscInt       b,i,j,s,r,row,ri,col,rstart,N;
+  PetscScalar    v;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatGetOwnershipRange(A,&rstart,NULL);CHKERRQ(ierr);
+  ierr = MatGetSize(A,&N,NULL);CHKERRQ(ierr);
+  for (b=0,row=rstart; b<nblocks; b++) {
+    s = bsizes[b];
+    for (i=0; i<s; i++) {
+      ri = row + i;
+      r  = ((gblock+b) % 3) ? i : (i+1) % s;
+      for (j=0; j<s; j++) {
+        v   = (r == j) ? 2.0*s+1.0 : 1.0/(1.0+PetscAbsInt(r-j)) + ((r > j) ? 0.1 : 0.0);
+        col = row + j;
+        ierr = MatSetValues(A,1,&ri,1,&col,&v,INSERT_VALUES);CHKERRQ(ierr);
+      }
+    }
+    if (!blockonly) {
+      v = -1.0;
+      if (row > 0)       {col = row-1; ierr = MatSetValues(A,1,&row,1,&col,&v,INSERT_VALUES);CHKERRQ(ierr);}
+      ri = row + s - 1;
+      if (row + s < N)   {col = row+s; ierr = MatSetValues(A,1,&ri,1,&col,&v,INSERT_VALUES);CHKERRQ(ierr);}
+    }
+    row += s;
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "CreateOperator"
+static PetscErrorCode CreateOperator(PetscInt m,PetscInt bs,PetscInt maxbs,Mat *A)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatCreate(PETSC_COMM_WORLD,A);CHKERRQ(ierr);
+  ierr = MatSetSizes(*A,m,m,PETSC_DETERMINE,PETSC_DETERMINE);CHKERRQ(ierr);
+  ierr = MatSetType(*A,MATAIJ);CHKERRQ(ierr);
+  if (bs) {ierr = MatSetBlockSize(*A,bs);CHKERRQ(ierr);}
+  ierr = MatSeqAIJSetPreallocation(*A,maxbs+2,NULL);CHKERRQ(ierr);
+  ierr = MatMPIAIJSetPreallocation(*A,maxbs+2,NULL,1,NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "main"
+int main(int argc,char **argv)
+{
+  Mat                A,D;
+  Vec                x,y,z;
+  KSP                ksp;
+  PC                 pc,pcb;
+  PetscRandom        rnd;
+  PetscInt           nb = 40,bs = 0,maxbs = 0,m = 0,gblock,i,its,*bsizes;
+  PetscReal          nrm,err;
+  PetscMPIInt        rank;
+  KSPConvergedReason reason;
+  PetscErrorCode     ierr;
+
+  PetscInitialize(&argc,&argv,(char*)0,help);
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,"-nb",&nb,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,"-bs",&bs,NULL);CHKERRQ(ierr);
+
+  gblock = rank*nb;
+  ierr   = PetscMalloc1(nb,&bsizes);CHKERRQ(ierr);
+  for (i=0; i<nb; i++) {
+    bsizes[i] = bs ? bs : sizes[(gblock+i) % (sizeof(sizes)/sizeof(sizes[0]))];
+    maxbs     = PetscMax(maxbs,bsizes[i]);
+    m        += bsizes[i];
+  }
+  ierr = CreateOperator(m,bs,maxbs,&A);CHKERRQ(ierr);
+  ierr = AssembleOperator(A,nb,bsizes,gblock,PETSC_FALSE);CHKERRQ(ierr);
+  ierr = CreateOperator(m,bs,maxbs,&D);CHKERRQ(ierr);
+  ierr = AssembleOperator(D,nb,bsizes,gblock,PETSC_TRUE);CHKERRQ(ierr);
+  if (!bs) {ierr = MatSetVariableBlockSizes(A,nb,bsizes);CHKERRQ(ierr);}
+
+  ierr = MatCreateVecs(A,&x,&y);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&z);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rnd);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rnd);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,rnd);CHKERRQ(ierr);
+  ierr = VecNorm(x,NORM_2,&nrm);CHKERRQ(ierr);
+
+  /* the preconditioner applied to x, multiplied by the diagonal blocks, gives back x */
+  ierr = KSPCreate(PETSC_COMM_WORLD,&ksp);CHKERRQ(ierr);
+  ierr = KSPSetOperators(ksp,A,A);CHKERRQ(ierr);
+  ierr = KSPGetPC(ksp,&pc);CHKERRQ(ierr);
+  ierr = PCSetType(pc,PCVPBJACOBI);CHKERRQ(ierr);
+  ierr = KSPSetTolerances(ksp,1.e-10,PETSC_DEFAULT,PETSC_DEFAULT,PETSC_DEFAULT);CHKERRQ(ierr);
+  ierr = KSPSetFromOptions(ksp);CHKERRQ(ierr);
+  ierr = KSPSetUp(ksp);CHKERRQ(ierr);
+  ierr = PCApply(pc,x,y);CHKERRQ(ierr);
+  ierr = MatMult(D,y,z);CHKERRQ(ierr);
+  ierr = VecAXPY(z,-1.0,x);CHKERRQ(ierr);
+  ierr = VecNorm(z,NORM_2,&err);CHKERRQ(ierr);
+  if (err/nrm > 1.e-12) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Relative error of the inverse blocks %g\n",(double)(err/nrm));CHKERRQ(ierr);}
+  else                  {ierr = PetscPrintf(PETSC_COMM_WORLD,"The inverse blocks are correct\n");CHKERRQ(ierr);}
+
+  /* with a single block size the point-block Jacobi preconditioner is the same */
+  if (bs) {
+    ierr = PCCreate(PETSC_COMM_WORLD,&pcb);CHKERRQ(ierr);
+    ierr = PCSetOperators(pcb,A,A);CHKERRQ(ierr);
+    ierr = PCSetType(pcb,PCPBJACOBI);CHKERRQ(ierr);
+    ierr = PCSetUp(pcb);CHKERRQ(ierr);
+    ierr = PCApply(pcb,x,z);CHKERRQ(ierr);
+    ierr = VecAXPY(z,-1.0,y);CHKERRQ(ierr);
+    ierr = VecNorm(z,NORM_2,&err);CHKERRQ(ierr);
+    if (err/nrm > 1.e-12) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Relative difference of PCPBJACOBI and PCVPBJACOBI %g\n",(double)(err/nrm));CHKERRQ(ierr);}
+    else                  {ierr = PetscPrintf(PETSC_COMM_WORLD,"PCPBJACOBI and PCVPBJACOBI agree\n");CHKERRQ(ierr);}
+    ierr = PCDestroy(&pcb);CHKERRQ(ierr);
+  }
+
+  ierr = KSPSolve(ksp,x,y);CHKERRQ(ierr);
+  ierr = KSPGetIterationNumber(ksp,&its);CHKERRQ(ierr);
+  ierr = KSPGetConvergedReason(ksp,&reason);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Solve: %s in %D iterations\n",reason > 0 ? "converged" : "diverged",its);CHKERRQ(ierr);
+
+  ierr = PetscFree(bsizes);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rnd);CHKERRQ(ierr);
+  ierr = KSPDestroy(&ksp);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&z);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&D);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return 0;
+}
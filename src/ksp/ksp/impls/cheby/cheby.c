@@ -83,6 +83,7 @@ static PetscErrorCode KSPChebyshevEstEigSet_Chebyshev(KSP ksp,PetscReal a,PetscR
     cheb->pmatid    = 0;
     cheb->amatstate = -1;
     cheb->pmatstate = -1;
+    cheb->nreused   = 0;
   } else {
     ierr = KSPDestroy(&cheb->kspest);CHKERRQ(ierr);
   }
@@ -104,6 +105,37 @@ static PetscErrorCode KSPChebyshevEstEigSetRandom_Chebyshev(KSP ksp,PetscRandom
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "KSPChebyshevEstEigSetUsePower_Chebyshev"
+static PetscErrorCode KSPChebyshevEstEigSetUsePower_Chebyshev(KSP ksp,PetscBool usepower)
+{
+  KSP_Chebyshev *cheb = (KSP_Chebyshev*)ksp->data;
+
+  PetscFunctionBegin;
+  cheb->usepower  = usepower;
+  cheb->amatid    = 0;
+  cheb->pmatid    = 0;
+  cheb->amatstate = -1;
+  cheb->pmatstate = -1;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "KSPChebyshevEstEigSetReuse_Chebyshev"
+static PetscErrorCode KSPChebyshevEstEigSetReuse_Chebyshev(KSP ksp,PetscInt reuse,PetscReal safety)
+{
+  KSP_Chebyshev *cheb = (KSP_Chebyshev*)ksp->data;
+
+  PetscFunctionBegin;
+  if (reuse < 0) SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_ARG_OUTOFRANGE,"Number of reuses %D cannot be negative",reuse);
+  cheb->reuse = reuse;
+  if (safety != PETSC_DEFAULT) {
+    if (safety < 1.0) SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_ARG_OUTOFRANGE,"Safety factor %g must be at least 1",(double)safety);
+    cheb->safety = safety;
+  }
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "KSPChebyshevSetEigenvalues"
 /*@
@@ -215,6 +247,78 @@ PetscErrorCode KSPChebyshevEstEigSetRandom(KSP ksp,PetscRandom random)
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "KSPChebyshevEstEigSetUsePower"
+/*@
+   KSPChebyshevEstEigSetUsePower - Estimate the largest eigenvalue with power iterations instead of a Krylov method
+
+   Logically Collective on KSP
+
+   Input Parameters:
++  ksp - the Krylov space context
+-  usepower - PETSC_TRUE to use power iterations
+
+   Options Database:
+.  -ksp_chebyshev_esteig_power
+
+   Notes:
+   Each of the -ksp_chebyshev_esteig_steps power iterations costs one MatMult(), one preconditioner application and one
+   norm, with none of the orthogonalization of the Krylov method. Only the largest eigenvalue is estimated, the smallest is
+   taken as zero in the transform of KSPChebyshevEstEigSet(), which is what the default transform does anyway.
+
+   Level: intermediate
+
+.seealso: KSPChebyshevEstEigSet(), KSPChebyshevEstEigSetReuse()
+@*/
+PetscErrorCode KSPChebyshevEstEigSetUsePower(KSP ksp,PetscBool usepower)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidLogicalCollectiveBool(ksp,usepower,2);
+  ierr = PetscTryMethod(ksp,"KSPChebyshevEstEigSetUsePower_C",(KSP,PetscBool),(ksp,usepower));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "KSPChebyshevEstEigSetReuse"
+/*@
+   KSPChebyshevEstEigSetReuse - Reuse the eigenvalue estimate when the values of the operators change
+
+   Logically Collective on KSP
+
+   Input Parameters:
++  ksp - the Krylov space context
+.  reuse - the number of times the values of the operators may change before the eigenvalues are estimated again
+-  safety - factor, at least 1, on the maximum bound while the estimate is reused, or PETSC_DEFAULT for 1.05
+
+   Options Database:
++  -ksp_chebyshev_esteig_reuse <reuse>
+-  -ksp_chebyshev_esteig_reuse_safety <safety>
+
+   Notes:
+   The estimate is tied to the operators and their state, so by default it is computed again whenever new values are
+   set, for instance on every Jacobian refresh of a multigrid preconditioner. Nearby operators have nearby spectra, and
+   since Chebyshev is only unstable when the maximum bound is too small, the estimate can be reused with the maximum
+   bound enlarged by the safety factor. New operator objects are always estimated again.
+
+   Level: intermediate
+
+.seealso: KSPChebyshevEstEigSet(), KSPChebyshevEstEigSetUsePower()
+@*/
+PetscErrorCode KSPChebyshevEstEigSetReuse(KSP ksp,PetscInt reuse,PetscReal safety)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidLogicalCollectiveInt(ksp,reuse,2);
+  PetscValidLogicalCollectiveReal(ksp,safety,3);
+  ierr = PetscTryMethod(ksp,"KSPChebyshevEstEigSetReuse_C",(KSP,PetscInt,PetscReal),(ksp,reuse,safety));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "KSPChebyshevEstEigGetKSP"
 /*@
@@ -296,6 +400,9 @@ static PetscErrorCode KSPSetFromOptions_Chebyshev(PetscOptions *PetscOptionsObje
 
   if (cheb->kspest) {
     PetscBool estrand = PETSC_FALSE;
+    ierr = PetscOptionsBool("-ksp_chebyshev_esteig_power","Estimate the largest eigenvalue with power iterations","KSPChebyshevEstEigSetUsePower",cheb->usepower,&cheb->usepower,NULL);CHKERRQ(ierr);
+    ierr = PetscOptionsInt("-ksp_chebyshev_esteig_reuse","Number of changes of the operator values to reuse the estimate for","KSPChebyshevEstEigSetReuse",cheb->reuse,&cheb->reuse,NULL);CHKERRQ(ierr);
+    ierr = PetscOptionsReal("-ksp_chebyshev_esteig_reuse_safety","Factor on the maximum bound while the estimate is reused","KSPChebyshevEstEigSetReuse",cheb->safety,&cheb->safety,NULL);CHKERRQ(ierr);
     ierr = PetscOptionsBool("-ksp_chebyshev_esteig_random","Use Random right hand side for eigenvalue estimation","KSPChebyshevEstEigSetRandom",estrand,&estrand,NULL);CHKERRQ(ierr);
     if (estrand) {
       PetscRandom random;
@@ -342,6 +449,32 @@ static PetscErrorCode KSPChebyshevComputeExtremeEigenvalues_Private(KSP kspest,P
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "KSPChebyshevPowerMax_Private"
+/*
+   KSPChebyshevPowerMax_Private - Estimates the largest eigenvalue of B^{-1}A with power iterations from B, using x and w
+   as work vectors
+*/
+static PetscErrorCode KSPChebyshevPowerMax_Private(KSP ksp,Mat Amat,PetscInt steps,Vec B,Vec x,Vec w,PetscReal *emax)
+{
+  PetscReal      nrm;
+  PetscInt       i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  *emax = 0.0;
+  ierr  = VecCopy(B,x);CHKERRQ(ierr);
+  ierr  = VecNormalize(x,&nrm);CHKERRQ(ierr);
+  if (nrm == 0.0) PetscFunctionReturn(0);
+  for (i=0; i<steps; i++) {
+    ierr = KSP_MatMult(ksp,Amat,x,w);CHKERRQ(ierr);
+    ierr = KSP_PCApply(ksp,w,x);CHKERRQ(ierr);
+    ierr = VecNormalize(x,emax);CHKERRQ(ierr);
+    if (*emax == 0.0) break;
+  }
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "KSPSolve_Chebyshev"
 static PetscErrorCode KSPSolve_Chebyshev(KSP ksp)
@@ -368,7 +501,14 @@ static PetscErrorCode KSPSolve_Chebyshev(KSP ksp)
     ierr = PetscObjectGetId((PetscObject)Pmat,&pmatid);CHKERRQ(ierr);
     ierr = PetscObjectStateGet((PetscObject)Amat,&amatstate);CHKERRQ(ierr);
     ierr = PetscObjectStateGet((PetscObject)Pmat,&pmatstate);CHKERRQ(ierr);
-    if (amatid != cheb->amatid || pmatid != cheb->pmatid || amatstate != cheb->amatstate || pmatstate != cheb->pmatstate) {
+    if (amatid == cheb->amatid && pmatid == cheb->pmatid && (amatstate != cheb->amatstate || pmatstate != cheb->pmatstate) && cheb->nreused < cheb->reuse) {
+      /* the same operators with new values, reuse the estimate with a larger maximum bound */
+      cheb->nreused++;
+      cheb->emax      = cheb->safety*cheb->estmax;
+      cheb->amatstate = amatstate;
+      cheb->pmatstate = pmatstate;
+      ierr = PetscInfo3(ksp,"Reusing eigenvalue estimate %D of %D times, maximum bound %g\n",cheb->nreused,cheb->reuse,(double)cheb->emax);CHKERRQ(ierr);
+    } else if (amatid != cheb->amatid || pmatid != cheb->pmatid || amatstate != cheb->amatstate || pmatstate != cheb->pmatstate) {
       PetscReal max=0.0,min=0.0;
       Vec       X,B;
       X = ksp->work[0];
@@ -378,15 +518,21 @@ static PetscErrorCode KSPSolve_Chebyshev(KSP ksp)
       } else {
         B = ksp->vec_rhs;
       }
-      ierr = KSPSolve(cheb->kspest,B,X);CHKERRQ(ierr);
+      if (cheb->usepower) {
+        ierr = KSPChebyshevPowerMax_Private(ksp,Amat,cheb->eststeps,B,X,ksp->work[2],&max);CHKERRQ(ierr);
+      } else {
+        ierr = KSPSolve(cheb->kspest,B,X);CHKERRQ(ierr);
 
-      if (ksp->guess_zero) {
-        ierr = VecZeroEntries(X);CHKERRQ(ierr);
+        if (ksp->guess_zero) {
+          ierr = VecZeroEntries(X);CHKERRQ(ierr);
+        }
+        ierr = KSPChebyshevComputeExtremeEigenvalues_Private(cheb->kspest,&min,&max);CHKERRQ(ierr);
       }
-      ierr = KSPChebyshevComputeExtremeEigenvalues_Private(cheb->kspest,&min,&max);CHKERRQ(ierr);
 
-      cheb->emin = cheb->tform[0]*min + cheb->tform[1]*max;
-      cheb->emax = cheb->tform[2]*min + cheb->tform[3]*max;
+      cheb->emin    = cheb->tform[0]*min + cheb->tform[1]*max;
+      cheb->emax    = cheb->tform[2]*min + cheb->tform[3]*max;
+      cheb->estmax  = cheb->emax;
+      cheb->nreused = 0;
 
       cheb->amatid    = amatid;
       cheb->pmatid    = pmatid;
@@ -513,10 +659,17 @@ static  PetscErrorCode KSPView_Chebyshev(KSP ksp,PetscViewer viewer)
   if (iascii) {
     ierr = PetscViewerASCIIPrintf(viewer,"  Chebyshev: eigenvalue estimates:  min = %g, max = %g\n",(double)cheb->emin,(double)cheb->emax);CHKERRQ(ierr);
     if (cheb->kspest) {
-      ierr = PetscViewerASCIIPrintf(viewer,"  Chebyshev: eigenvalues estimated using %s with translations  [%g %g; %g %g]\n",((PetscObject) cheb->kspest)->type_name,(double)cheb->tform[0],(double)cheb->tform[1],(double)cheb->tform[2],(double)cheb->tform[3]);CHKERRQ(ierr);
-      ierr = PetscViewerASCIIPushTab(viewer);CHKERRQ(ierr);
-      ierr = KSPView(cheb->kspest,viewer);CHKERRQ(ierr);
-      ierr = PetscViewerASCIIPopTab(viewer);CHKERRQ(ierr);
+      if (cheb->usepower) {
+        ierr = PetscViewerASCIIPrintf(viewer,"  Chebyshev: maximum eigenvalue estimated using %D power iterations with translations  [%g %g; %g %g]\n",cheb->eststeps,(double)cheb->tform[0],(double)cheb->tform[1],(double)cheb->tform[2],(double)cheb->tform[3]);CHKERRQ(ierr);
+      } else {
+        ierr = PetscViewerASCIIPrintf(viewer,"  Chebyshev: eigenvalues estimated using %s with translations  [%g %g; %g %g]\n",((PetscObject) cheb->kspest)->type_name,(double)cheb->tform[0],(double)cheb->tform[1],(double)cheb->tform[2],(double)cheb->tform[3]);CHKERRQ(ierr);
+        ierr = PetscViewerASCIIPushTab(viewer);CHKERRQ(ierr);
+        ierr = KSPView(cheb->kspest,viewer);CHKERRQ(ierr);
+        ierr = PetscViewerASCIIPopTab(viewer);CHKERRQ(ierr);
+      }
+      if (cheb->reuse) {
+        ierr = PetscViewerASCIIPrintf(viewer,"  Chebyshev: estimate reused for up to %D changes of the operator values with safety factor %g\n",cheb->reuse,(double)cheb->safety);CHKERRQ(ierr);
+      }
       if (cheb->random) {
         ierr = PetscViewerASCIIPrintf(viewer,"  Chebyshev: estimating eigenvalues using random right hand side\n");CHKERRQ(ierr);
         ierr = PetscViewerASCIIPushTab(viewer);CHKERRQ(ierr);
@@ -542,6 +695,8 @@ static PetscErrorCode KSPDestroy_Chebyshev(KSP ksp)
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigSet_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigSetRandom_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigGetKSP_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigSetUsePower_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigSetReuse_C",NULL);CHKERRQ(ierr);
   ierr = KSPDestroyDefault(ksp);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -555,7 +710,10 @@ static PetscErrorCode KSPDestroy_Chebyshev(KSP ksp)
 .   -ksp_chebyshev_esteig <a,b,c,d> - estimate eigenvalues using a Krylov method, then use this
                          transform for Chebyshev eigenvalue bounds (KSPChebyshevEstEigSet())
 .   -ksp_chebyshev_esteig_steps - number of estimation steps 
-+   -ksp_chebyshev_esteig_random - use random right hand side for eigenvalue estimation (KSPChebyshevEstEigSetRandom())
+.   -ksp_chebyshev_esteig_random - use random right hand side for eigenvalue estimation (KSPChebyshevEstEigSetRandom())
+.   -ksp_chebyshev_esteig_power - estimate the largest eigenvalue with power iterations (KSPChebyshevEstEigSetUsePower())
+.   -ksp_chebyshev_esteig_reuse <n> - reuse the estimate for n changes of the operator values (KSPChebyshevEstEigSetReuse())
+-   -ksp_chebyshev_esteig_reuse_safety <s> - factor on the maximum bound while the estimate is reused
 
 
    Level: beginner
@@ -568,7 +726,8 @@ static PetscErrorCode KSPDestroy_Chebyshev(KSP ksp)
           The user should call KSPChebyshevSetEigenvalues() if they have eigenvalue estimates.
 
 .seealso:  KSPCreate(), KSPSetType(), KSPType (for list of available types), KSP,
-           KSPChebyshevSetEigenvalues(), KSPChebyshevEstEigSet(), KSPChebyshevEstEigSetRandom(), KSPRICHARDSON, KSPCG, PCMG
+           KSPChebyshevSetEigenvalues(), KSPChebyshevEstEigSet(), KSPChebyshevEstEigSetRandom(), KSPChebyshevEstEigSetUsePower(),
+           KSPChebyshevEstEigSetReuse(), KSPRICHARDSON, KSPCG, PCMG
 
 M*/
 
@@ -594,6 +753,7 @@ PETSC_EXTERN PetscErrorCode KSPCreate_Chebyshev(KSP ksp)
   chebyshevP->tform[2] = 0;
   chebyshevP->tform[3] = 1.1;
   chebyshevP->eststeps = 10;
+  chebyshevP->safety   = 1.05;
   
   ksp->ops->setup          = KSPSetUp_Chebyshev;
   ksp->ops->solve          = KSPSolve_Chebyshev;
@@ -608,5 +768,7 @@ PETSC_EXTERN PetscErrorCode KSPCreate_Chebyshev(KSP ksp)
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigSet_C",KSPChebyshevEstEigSet_Chebyshev);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigSetRandom_C",KSPChebyshevEstEigSetRandom_Chebyshev);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigGetKSP_C",KSPChebyshevEstEigGetKSP_Chebyshev);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigSetUsePower_C",KSPChebyshevEstEigSetUsePower_Chebyshev);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigSetReuse_C",KSPChebyshevEstEigSetReuse_Chebyshev);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -13,6 +13,11 @@ typedef struct {
   PetscObjectState amatstate, pmatstate;
   PetscInt  eststeps;     /* number of est steps in KSP used to estimate eigenvalues */
   PetscRandom random;
+  PetscBool usepower;     /* estimate the largest eigenvalue with power iterations instead of kspest */
+  PetscInt  reuse;        /* number of changes of the operator values the estimate is reused for */
+  PetscInt  nreused;      /* number of times the current estimate has been reused */
+  PetscReal safety;       /* factor on the maximum bound when the estimate is reused */
+  PetscReal estmax;       /* maximum bound from the last estimate */
 } KSP_Chebyshev;
 
 #endif
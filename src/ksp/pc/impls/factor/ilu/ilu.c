@@ -326,6 +326,14 @@ static PetscErrorCode PCApplySymmetricRight_ILU(PC pc,Vec x,Vec y)
           The "symmetric" application of this preconditioner is not actually symmetric since L is not transpose(U)
           even when the matrix is not symmetric since the U stores the diagonals of the factorization.
 
+          For SeqAIJ matrices the option -mat_solve_levels sorts the rows of L and U into levels after each numeric
+          factorization, so the rows of each level are solved at the same time, with OpenMP threads when available.
+
+          For SeqAIJ matrices the option -mat_factor_sweeps <n> computes the factor with n fixed-point sweeps in which
+          all the entries are computed at the same time, each factorization after the first one starting from the
+          previous factor, and -mat_solve_sweeps <n> replaces the triangular solves by n Jacobi sweeps. The resulting
+          preconditioner is only an approximation of ILU, but both parts are fully parallel.
+
           If you are using MATSEQAIJCUSPARSE matrices (or MATMPIAIJCUSPARESE matrices with block Jacobi), factorization 
           is never done on the GPU).
 
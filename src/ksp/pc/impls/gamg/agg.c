@@ -110,6 +110,10 @@ PetscErrorCode PCGAMGSetSymGraph_GAMG(PC pc, PetscBool n)
    Options Database Key:
 .  -pc_gamg_square_graph
 
+   Notes:
+   The square of the graph is formed with MatTransposeMatMult(). With the coarsener MATCOARSENMIS2, -mat_coarsen_type mis2,
+   the aggregates of these levels are made from a distance-2 maximal independent set instead, without forming the square.
+
    Level: intermediate
 
    Concepts: Aggregation AMG preconditioner
@@ -916,7 +920,7 @@ PetscErrorCode PCGAMGGraph_AGG(PC pc,Mat Amat,Mat *a_Gmat)
   Input Parameter:
    . a_pc - this
   Input/Output Parameter:
-   . a_Gmat1 - graph on this fine level - coarsening can change this (squares it)
+   . a_Gmat1 - graph on this fine level - coarsening can change this (squares or symmetrizes it)
   Output Parameter:
    . agg_lists - list of aggregates
 */
@@ -932,7 +936,7 @@ PetscErrorCode PCGAMGCoarsen_AGG(PC a_pc,Mat *a_Gmat1,PetscCoarsenData **agg_lis
   IS             perm;
   PetscInt       Ii,nloc,bs,n,m;
   PetscInt       *permute;
-  PetscBool      *bIndexSet;
+  PetscBool      *bIndexSet,ismis2;
   MatCoarsen     crs;
   MPI_Comm       comm;
   PetscMPIInt    rank;
@@ -946,7 +950,22 @@ PetscErrorCode PCGAMGCoarsen_AGG(PC a_pc,Mat *a_Gmat1,PetscCoarsenData **agg_lis
   if (bs != 1) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_PLIB,"bs %D must be 1",bs);
   nloc = n/bs;
 
-  if (pc_gamg->current_level < pc_gamg_agg->square_graph) {
+  ierr = MatCoarsenCreate(comm, &crs);CHKERRQ(ierr);
+  ierr = MatCoarsenSetFromOptions(crs);CHKERRQ(ierr);
+  /* the MIS-2 coarsener makes the aggregates of the squared graph without forming it, the other levels use MIS */
+  ierr = PetscObjectTypeCompare((PetscObject)crs, MATCOARSENMIS2, &ismis2);CHKERRQ(ierr);
+  if (ismis2 && pc_gamg->current_level >= pc_gamg_agg->square_graph) {
+    ierr = MatCoarsenSetType(crs, MATCOARSENMIS);CHKERRQ(ierr);
+  } else if (ismis2 && !pc_gamg_agg->sym_graph) {
+    /* squaring made the graph symmetric, so without it the graph must be symmetrized as with -pc_gamg_sym_graph */
+    ierr = PetscInfo1(a_pc,"Symmetrize Graph for MIS-2 on level %d\n",pc_gamg->current_level+1);CHKERRQ(ierr);
+    ierr = MatTranspose(Gmat1, MAT_INITIAL_MATRIX, &mat);CHKERRQ(ierr);
+    ierr = MatAXPY(mat, 1.0, Gmat1, DIFFERENT_NONZERO_PATTERN);CHKERRQ(ierr);
+    ierr = MatScale(mat, 0.5);CHKERRQ(ierr);
+    ierr = MatDestroy(&Gmat1);CHKERRQ(ierr);
+    *a_Gmat1 = Gmat1 = mat; /* output */
+  }
+  if (pc_gamg->current_level < pc_gamg_agg->square_graph && !ismis2) {
     ierr = PetscInfo2(a_pc,"Square Graph on level %d of %d to square\n",pc_gamg->current_level+1,pc_gamg_agg->square_graph);
     CHKERRQ(ierr);
     /* ierr = MatMatTransposeMult(Gmat1, Gmat1, MAT_INITIAL_MATRIX, PETSC_DEFAULT, &Gmat2); */
@@ -977,9 +996,6 @@ PetscErrorCode PCGAMGCoarsen_AGG(PC a_pc,Mat *a_Gmat1,PetscCoarsenData **agg_lis
 #if defined PETSC_GAMG_USE_LOG
   ierr = PetscLogEventBegin(petsc_gamg_setup_events[SET4],0,0,0,0);CHKERRQ(ierr);
 #endif
-  ierr = MatCoarsenCreate(comm, &crs);CHKERRQ(ierr);
-  /* ierr = MatCoarsenSetType(crs, MATCOARSENMIS);CHKERRQ(ierr); */
-  ierr = MatCoarsenSetFromOptions(crs);CHKERRQ(ierr);
   ierr = MatCoarsenSetGreedyOrdering(crs, perm);CHKERRQ(ierr);
   ierr = MatCoarsenSetAdjacency(crs, Gmat2);CHKERRQ(ierr);
   ierr = MatCoarsenSetStrictAggs(crs, PETSC_TRUE);CHKERRQ(ierr);
@@ -367,7 +367,7 @@ static PetscErrorCode PCGAMGCreateLevel_GAMG(PC pc,Mat Amat_fine,PetscInt cr_bs,
     ierr = PetscLogEventEnd(petsc_gamg_setup_events[SET13],0,0,0,0);CHKERRQ(ierr);
     ierr = PetscLogEventBegin(petsc_gamg_setup_events[SET14],0,0,0,0);CHKERRQ(ierr);
 #endif
-    /* 'a_Amat_crs' output */
+    /* 'a_Amat_crs' output, MatPtAP() cannot reuse this permuted product, so a resetup with reuse computes it again once */
     {
       Mat mat;
       ierr        = MatGetSubMatrix(Cmat, new_eq_indices, new_eq_indices, MAT_INITIAL_MATRIX, &mat);CHKERRQ(ierr);
@@ -381,6 +381,7 @@ static PetscErrorCode PCGAMGCreateLevel_GAMG(PC pc,Mat Amat_fine,PetscInt cr_bs,
         ierr = PetscPrintf(MPI_COMM_SELF,"[%d]%s New Mat rbs=%d cbs=%d cr_bs=%d\n",rank,__FUNCT__,rbs,cbs,cr_bs);CHKERRQ(ierr);
       }
     }
+    pc_gamg->ptap_coarse = PETSC_FALSE;
     ierr = MatDestroy(&Cmat);CHKERRQ(ierr);
 
 #if defined PETSC_GAMG_USE_LOG
@@ -477,19 +478,18 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
       pc->setupcalled = 0;
     } else {
       PC_MG_Levels **mglevels = mg->levels;
-      /* just do Galerkin grids */
-      Mat          B,dA,dB;
+      /* just do Galerkin grids, the interpolation already holds the repartitioning of each level */
+      Mat          B,dB;
+      MatReuse     reuse;
 
-     if (!pc->setupcalled) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"PCSetUp() has not been called yet");
+      if (!pc->setupcalled) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"PCSetUp() has not been called yet");
       if (pc_gamg->Nlevels > 1) {
-        /* currently only handle case where mat and pmat are the same on coarser levels */
-        ierr = KSPGetOperators(mglevels[pc_gamg->Nlevels-1]->smoothd,&dA,&dB);CHKERRQ(ierr);
-        /* (re)set to get dirty flag */
-        ierr = KSPSetOperators(mglevels[pc_gamg->Nlevels-1]->smoothd,dA,dB);CHKERRQ(ierr);
-
+        /* once the coarse operators are made by MatPtAP() with these interpolations only new values are computed, unless the fine grid nonzero pattern changed */
+        reuse = (pc->flag == SAME_NONZERO_PATTERN && pc_gamg->ptap_coarse) ? MAT_REUSE_MATRIX : MAT_INITIAL_MATRIX;
+        ierr  = PetscInfo2(pc,"%s resetup of %D levels\n",reuse == MAT_REUSE_MATRIX ? "Numeric" : "Symbolic and numeric",pc_gamg->Nlevels);CHKERRQ(ierr);
+        dB    = pc->pmat;
         for (level=pc_gamg->Nlevels-2; level>=0; level--) {
-          /* the first time through the matrix structure has changed from repartitioning */
-          if (pc_gamg->setup_count==2) {
+          if (reuse == MAT_INITIAL_MATRIX) {
             ierr = MatPtAP(dB,mglevels[level+1]->interpolate,MAT_INITIAL_MATRIX,1.0,&B);CHKERRQ(ierr);
             ierr = MatDestroy(&mglevels[level]->A);CHKERRQ(ierr);
 
@@ -498,9 +498,11 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
             ierr = KSPGetOperators(mglevels[level]->smoothd,NULL,&B);CHKERRQ(ierr);
             ierr = MatPtAP(dB,mglevels[level+1]->interpolate,MAT_REUSE_MATRIX,1.0,&B);CHKERRQ(ierr);
           }
+          /* (re)set to get dirty flag, the smoothers then only recompute their numeric data */
           ierr = KSPSetOperators(mglevels[level]->smoothd,B,B);CHKERRQ(ierr);
           dB   = B;
         }
+        pc_gamg->ptap_coarse = PETSC_TRUE;
       }
 
       ierr = PCSetUp_MG(pc);CHKERRQ(ierr);
@@ -546,7 +548,8 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
                     (int)(nnz0/(PetscReal)M+0.5),size);
   CHKERRQ(ierr);
 
-  /* Get A_i and R_i */
+  /* Get A_i and R_i, the levels that are reduced or repartitioned clear ptap_coarse */
+  pc_gamg->ptap_coarse = PETSC_TRUE;
   for (level=0, Aarr[0]=Pmat, nactivepe = size; /* hard wired stopping logic */
        level < (pc_gamg->Nlevels-1) && (level==0 || M>pc_gamg->coarse_eq_limit);
        level++) {
@@ -949,6 +952,13 @@ static PetscErrorCode PCGAMGSetRepartitioning_GAMG(PC pc, PetscBool n)
    Options Database Key:
 .  -pc_gamg_reuse_interpolation <true,false>
 
+   Notes: With reuse a new operator only costs a numeric setup: the graph, the aggregation, the repartitioning and the
+   prolongators of the first setup are kept, the coarse operators are recomputed by MatPtAP() with MAT_REUSE_MATRIX and
+   the smoothers only recompute their numeric data. If the nonzero pattern of the operator changed the symbolic
+   products are computed again, still with the old prolongators. The first setup makes the coarse operators of reduced
+   or repartitioned levels by permuting the Galerkin product, which MatPtAP() cannot reuse, so when there are such
+   levels the first resetup also computes the symbolic products.
+
    Level: intermediate
 
    Concepts: Unstructured multigrid preconditioner
@@ -1274,6 +1284,10 @@ $       Call MatSetBlockSize() to indicate the number of degrees of freedom per
 $       Call MatSetNearNullSpace() (or PCSetCoordinates() if solving the equations of elasticity) to indicate the near null space of the operator
 $       See the Users Manual Chapter 4 for more details
 
+         When the operator is refreshed often, for instance with a new Jacobian at every Newton step, the eigenvalue
+         estimates of the Chebyshev smoothers can be made cheaper with -mg_levels_ksp_chebyshev_esteig_power and reused
+         across refreshes with -mg_levels_ksp_chebyshev_esteig_reuse <n>, see KSPChebyshevEstEigSetReuse().
+
   Level: intermediate
 
   Concepts: algebraic multigrid
@@ -16,7 +16,7 @@ PetscErrorCode PCMGFCycle_Private(PC pc,PC_MG_Levels **mglevels)
   /* restrict the RHS through all levels to coarsest. */
   for (i=l-1; i>0; i--) {
     if (mglevels[i]->eventinterprestrict) {ierr = PetscLogEventBegin(mglevels[i]->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
-    ierr = MatRestrict(mglevels[i]->restrct,mglevels[i]->b,mglevels[i-1]->b);CHKERRQ(ierr);
+    ierr = MatRestrict(PCMGLevelRestriction(mglevels[i]),mglevels[i]->b,mglevels[i-1]->b);CHKERRQ(ierr);
     if (mglevels[i]->eventinterprestrict) {ierr = PetscLogEventEnd(mglevels[i]->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
   }
 
@@ -25,7 +25,7 @@ PetscErrorCode PCMGFCycle_Private(PC pc,PC_MG_Levels **mglevels)
   for (i=0; i<l-1; i++) {
     ierr = PCMGMCycle_Private(pc,&mglevels[i],NULL);CHKERRQ(ierr);
     if (mglevels[i+1]->eventinterprestrict) {ierr = PetscLogEventBegin(mglevels[i+1]->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
-    ierr = MatInterpolate(mglevels[i+1]->interpolate,mglevels[i]->x,mglevels[i+1]->x);CHKERRQ(ierr);
+    ierr = MatInterpolate(PCMGLevelInterpolation(mglevels[i+1]),mglevels[i]->x,mglevels[i+1]->x);CHKERRQ(ierr);
     if (mglevels[i+1]->eventinterprestrict) {ierr = PetscLogEventEnd(mglevels[i+1]->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
   }
   ierr = PCMGMCycle_Private(pc,&mglevels[l-1],NULL);CHKERRQ(ierr);
@@ -43,7 +43,7 @@ PetscErrorCode PCMGKCycle_Private(PC pc,PC_MG_Levels **mglevels)
   /* restrict the RHS through all levels to coarsest. */
   for (i=l-1; i>0; i--) {
     if (mglevels[i]->eventinterprestrict) {ierr = PetscLogEventBegin(mglevels[i]->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
-    ierr = MatRestrict(mglevels[i]->restrct,mglevels[i]->b,mglevels[i-1]->b);CHKERRQ(ierr);
+    ierr = MatRestrict(PCMGLevelRestriction(mglevels[i]),mglevels[i]->b,mglevels[i-1]->b);CHKERRQ(ierr);
     if (mglevels[i]->eventinterprestrict) {ierr = PetscLogEventEnd(mglevels[i]->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
   }
 
@@ -51,14 +51,14 @@ PetscErrorCode PCMGKCycle_Private(PC pc,PC_MG_Levels **mglevels)
   ierr = VecSet(mglevels[0]->x,0.0);CHKERRQ(ierr);
   for (i=0; i<l-1; i++) {
     if (mglevels[i]->eventsmoothsolve) {ierr = PetscLogEventBegin(mglevels[i]->eventsmoothsolve,0,0,0,0);CHKERRQ(ierr);}
-    ierr = KSPSolve(mglevels[i]->smoothd,mglevels[i]->b,mglevels[i]->x);CHKERRQ(ierr);
+    ierr = PCMGLevelSmooth_Private(mglevels[i],mglevels[i]->smoothd);CHKERRQ(ierr);
     if (mglevels[i]->eventsmoothsolve) {ierr = PetscLogEventEnd(mglevels[i]->eventsmoothsolve,0,0,0,0);CHKERRQ(ierr);}
     if (mglevels[i+1]->eventinterprestrict) {ierr = PetscLogEventBegin(mglevels[i+1]->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
-    ierr = MatInterpolate(mglevels[i+1]->interpolate,mglevels[i]->x,mglevels[i+1]->x);CHKERRQ(ierr);
+    ierr = MatInterpolate(PCMGLevelInterpolation(mglevels[i+1]),mglevels[i]->x,mglevels[i+1]->x);CHKERRQ(ierr);
     if (mglevels[i+1]->eventinterprestrict) {ierr = PetscLogEventEnd(mglevels[i+1]->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
   }
   if (mglevels[l-1]->eventsmoothsolve) {ierr = PetscLogEventBegin(mglevels[l-1]->eventsmoothsolve,0,0,0,0);CHKERRQ(ierr);}
-  ierr = KSPSolve(mglevels[l-1]->smoothd,mglevels[l-1]->b,mglevels[l-1]->x);CHKERRQ(ierr);
+  ierr = PCMGLevelSmooth_Private(mglevels[l-1],mglevels[l-1]->smoothd);CHKERRQ(ierr);
   if (mglevels[l-1]->eventsmoothsolve) {ierr = PetscLogEventEnd(mglevels[l-1]->eventsmoothsolve,0,0,0,0);CHKERRQ(ierr);}
   PetscFunctionReturn(0);
 }
@@ -5,6 +5,72 @@
 #include <petsc/private/pcmgimpl.h>                    /*I "petscksp.h" I*/
 #include <petscdm.h>
 
+#undef __FUNCT__
+#define __FUNCT__ "PCMGLevelSmooth_Private"
+/*
+   PCMGLevelSmooth_Private - Applies the smoother ksp, mglevels->smoothd or mglevels->smoothu, to the level vectors.
+
+   When the level is agglomerated the smoothing is done by the matching smoother on the subcommunicator, on
+   vectors that share the arrays of the level vectors; processes outside the subcommunicator do nothing.
+*/
+PetscErrorCode PCMGLevelSmooth_Private(PC_MG_Levels *mglevels,KSP ksp)
+{
+  PetscErrorCode    ierr;
+  const PetscScalar *barray;
+  PetscScalar       *xarray;
+
+  PetscFunctionBegin;
+  if (!mglevels->aggsubcomm) {
+    ierr = KSPSolve(ksp,mglevels->b,mglevels->x);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  if (mglevels->aggsubcomm->color) PetscFunctionReturn(0);
+  ksp  = (ksp == mglevels->smoothd) ? mglevels->aggsmoothd : mglevels->aggsmoothu;
+  ierr = VecGetArrayRead(mglevels->b,&barray);CHKERRQ(ierr);
+  ierr = VecGetArray(mglevels->x,&xarray);CHKERRQ(ierr);
+  ierr = VecPlaceArray(mglevels->aggb,barray);CHKERRQ(ierr);
+  ierr = VecPlaceArray(mglevels->aggx,xarray);CHKERRQ(ierr);
+  ierr = KSPSolve(ksp,mglevels->aggb,mglevels->aggx);CHKERRQ(ierr);
+  ierr = VecResetArray(mglevels->aggb);CHKERRQ(ierr);
+  ierr = VecResetArray(mglevels->aggx);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(mglevels->b,&barray);CHKERRQ(ierr);
+  ierr = VecRestoreArray(mglevels->x,&xarray);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PCMGLevelResidual_Private"
+/*
+   PCMGLevelResidual_Private - Computes the residual r = b - A x of a level, on the subcommunicator when the level is agglomerated
+*/
+PetscErrorCode PCMGLevelResidual_Private(PC_MG_Levels *mglevels,Vec b,Vec x,Vec r)
+{
+  PetscErrorCode    ierr;
+  const PetscScalar *barray,*xarray;
+  PetscScalar       *rarray;
+
+  PetscFunctionBegin;
+  if (!mglevels->aggsubcomm) {
+    ierr = (*mglevels->residual)(mglevels->A,b,x,r);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  if (mglevels->aggsubcomm->color) PetscFunctionReturn(0);
+  ierr = VecGetArrayRead(b,&barray);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(x,&xarray);CHKERRQ(ierr);
+  ierr = VecGetArray(r,&rarray);CHKERRQ(ierr);
+  ierr = VecPlaceArray(mglevels->aggb,barray);CHKERRQ(ierr);
+  ierr = VecPlaceArray(mglevels->aggx,xarray);CHKERRQ(ierr);
+  ierr = VecPlaceArray(mglevels->aggr,rarray);CHKERRQ(ierr);
+  ierr = (*mglevels->residual)(mglevels->aggA,mglevels->aggb,mglevels->aggx,mglevels->aggr);CHKERRQ(ierr);
+  ierr = VecResetArray(mglevels->aggb);CHKERRQ(ierr);
+  ierr = VecResetArray(mglevels->aggx);CHKERRQ(ierr);
+  ierr = VecResetArray(mglevels->aggr);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(b,&barray);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(x,&xarray);CHKERRQ(ierr);
+  ierr = VecRestoreArray(r,&rarray);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "PCMGMCycle_Private"
 PetscErrorCode PCMGMCycle_Private(PC pc,PC_MG_Levels **mglevelsin,PCRichardsonConvergedReason *reason)
@@ -16,11 +82,11 @@ PetscErrorCode PCMGMCycle_Private(PC pc,PC_MG_Levels **mglevelsin,PCRichardsonCo
 
   PetscFunctionBegin;
   if (mglevels->eventsmoothsolve) {ierr = PetscLogEventBegin(mglevels->eventsmoothsolve,0,0,0,0);CHKERRQ(ierr);}
-  ierr = KSPSolve(mglevels->smoothd,mglevels->b,mglevels->x);CHKERRQ(ierr);  /* pre-smooth */
+  ierr = PCMGLevelSmooth_Private(mglevels,mglevels->smoothd);CHKERRQ(ierr);  /* pre-smooth */
   if (mglevels->eventsmoothsolve) {ierr = PetscLogEventEnd(mglevels->eventsmoothsolve,0,0,0,0);CHKERRQ(ierr);}
   if (mglevels->level) {  /* not the coarsest grid */
     if (mglevels->eventresidual) {ierr = PetscLogEventBegin(mglevels->eventresidual,0,0,0,0);CHKERRQ(ierr);}
-    ierr = (*mglevels->residual)(mglevels->A,mglevels->b,mglevels->x,mglevels->r);CHKERRQ(ierr);
+    ierr = PCMGLevelResidual_Private(mglevels,mglevels->b,mglevels->x,mglevels->r);CHKERRQ(ierr);
     if (mglevels->eventresidual) {ierr = PetscLogEventEnd(mglevels->eventresidual,0,0,0,0);CHKERRQ(ierr);}
 
     /* if on finest level and have convergence criteria set */
@@ -41,17 +107,17 @@ PetscErrorCode PCMGMCycle_Private(PC pc,PC_MG_Levels **mglevelsin,PCRichardsonCo
 
     mgc = *(mglevelsin - 1);
     if (mglevels->eventinterprestrict) {ierr = PetscLogEventBegin(mglevels->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
-    ierr = MatRestrict(mglevels->restrct,mglevels->r,mgc->b);CHKERRQ(ierr);
+    ierr = MatRestrict(PCMGLevelRestriction(mglevels),mglevels->r,mgc->b);CHKERRQ(ierr);
     if (mglevels->eventinterprestrict) {ierr = PetscLogEventEnd(mglevels->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
     ierr = VecSet(mgc->x,0.0);CHKERRQ(ierr);
     while (cycles--) {
       ierr = PCMGMCycle_Private(pc,mglevelsin-1,reason);CHKERRQ(ierr);
     }
     if (mglevels->eventinterprestrict) {ierr = PetscLogEventBegin(mglevels->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
-    ierr = MatInterpolateAdd(mglevels->interpolate,mgc->x,mglevels->x,mglevels->x);CHKERRQ(ierr);
+    ierr = MatInterpolateAdd(PCMGLevelInterpolation(mglevels),mgc->x,mglevels->x,mglevels->x);CHKERRQ(ierr);
     if (mglevels->eventinterprestrict) {ierr = PetscLogEventEnd(mglevels->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
     if (mglevels->eventsmoothsolve) {ierr = PetscLogEventBegin(mglevels->eventsmoothsolve,0,0,0,0);CHKERRQ(ierr);}
-    ierr = KSPSolve(mglevels->smoothu,mglevels->b,mglevels->x);CHKERRQ(ierr);    /* post smooth */
+    ierr = PCMGLevelSmooth_Private(mglevels,mglevels->smoothu);CHKERRQ(ierr);    /* post smooth */
     if (mglevels->eventsmoothsolve) {ierr = PetscLogEventEnd(mglevels->eventsmoothsolve,0,0,0,0);CHKERRQ(ierr);}
   }
   PetscFunctionReturn(0);
@@ -100,6 +166,12 @@ static PetscErrorCode PCApplyRichardson_MG(PC pc,Vec b,Vec x,Vec w,PetscReal rto
     if (mglevels[i]->smoothu != mglevels[i]->smoothd) {
       ierr = KSPSetTolerances(mglevels[i]->smoothd,0,PETSC_DEFAULT,PETSC_DEFAULT,PETSC_DEFAULT);CHKERRQ(ierr);
     }
+    if (mglevels[i]->aggsmoothu) {
+      ierr = KSPSetTolerances(mglevels[i]->aggsmoothu,0,PETSC_DEFAULT,PETSC_DEFAULT,PETSC_DEFAULT);CHKERRQ(ierr);
+      if (mglevels[i]->aggsmoothu != mglevels[i]->aggsmoothd) {
+        ierr = KSPSetTolerances(mglevels[i]->aggsmoothd,0,PETSC_DEFAULT,PETSC_DEFAULT,PETSC_DEFAULT);CHKERRQ(ierr);
+      }
+    }
   }
 
   *reason = (PCRichardsonConvergedReason)0;
@@ -139,6 +211,24 @@ PetscErrorCode PCReset_MG(PC pc)
         ierr = KSPReset(mglevels[i]->smoothd);CHKERRQ(ierr);
       }
       ierr = KSPReset(mglevels[i]->smoothu);CHKERRQ(ierr);
+
+      /* the agglomerated levels are built again by the next setup */
+      if (mglevels[i]->aggsmoothd != mglevels[i]->aggsmoothu) {
+        ierr = KSPDestroy(&mglevels[i]->aggsmoothu);CHKERRQ(ierr);
+      }
+      ierr = KSPDestroy(&mglevels[i]->aggsmoothd);CHKERRQ(ierr);
+      mglevels[i]->aggsmoothu = NULL;
+      ierr = MatDestroy(&mglevels[i]->aggA);CHKERRQ(ierr);
+      ierr = MatDestroyMatrices(1,&mglevels[i]->aggAseq);CHKERRQ(ierr);
+      ierr = MatDestroy(&mglevels[i]->agginterp);CHKERRQ(ierr);
+      ierr = MatDestroy(&mglevels[i]->aggrestrct);CHKERRQ(ierr);
+      ierr = VecDestroy(&mglevels[i]->aggb);CHKERRQ(ierr);
+      ierr = VecDestroy(&mglevels[i]->aggx);CHKERRQ(ierr);
+      ierr = VecDestroy(&mglevels[i]->aggr);CHKERRQ(ierr);
+      ierr = ISDestroy(&mglevels[i]->aggis);CHKERRQ(ierr);
+      ierr = PetscSubcommDestroy(&mglevels[i]->aggsubcomm);CHKERRQ(ierr);
+      ierr = VecDestroy(&mglevels[i]->l1dinv);CHKERRQ(ierr);
+      ierr = VecDestroy(&mglevels[i]->work);CHKERRQ(ierr);
     }
   }
   PetscFunctionReturn(0);
@@ -301,8 +391,10 @@ PetscErrorCode PCDestroy_MG(PC pc)
 
 
 extern PetscErrorCode PCMGACycle_Private(PC,PC_MG_Levels**);
+extern PetscErrorCode PCMGMACycle_Private(PC,PC_MG_Levels**);
 extern PetscErrorCode PCMGFCycle_Private(PC,PC_MG_Levels**);
 extern PetscErrorCode PCMGKCycle_Private(PC,PC_MG_Levels**);
+static PetscErrorCode PCMGSetUpMultiAdditive_Private(PC);
 
 /*
    PCApply_MG - Runs either an additive, multiplicative, Kaskadic
@@ -339,6 +431,10 @@ static PetscErrorCode PCApply_MG(PC pc,Vec b,Vec x)
     }
   } else if (mg->am == PC_MG_ADDITIVE) {
     ierr = PCMGACycle_Private(pc,mglevels);CHKERRQ(ierr);
+  } else if (mg->am == PC_MG_MULTIADDITIVE) {
+    /* the type may have been changed with PCMGSetType() after the setup */
+    if (!mg->l1dinvvalid) {ierr = PCMGSetUpMultiAdditive_Private(pc);CHKERRQ(ierr);}
+    ierr = PCMGMACycle_Private(pc,mglevels);CHKERRQ(ierr);
   } else if (mg->am == PC_MG_KASKADE) {
     ierr = PCMGKCycle_Private(pc,mglevels);CHKERRQ(ierr);
   } else {
@@ -397,6 +493,10 @@ PetscErrorCode PCSetFromOptions_MG(PetscOptions *PetscOptionsObject,PC pc)
   if (flg) {
     ierr = PCMGSetType(pc,mgtype);CHKERRQ(ierr);
   }
+  ierr = PetscOptionsInt("-pc_mg_process_eq_limit","Agglomerate coarse levels with fewer equations per process","PCMGSetProcEqLim",mg->proceqlim,&m,&flg);CHKERRQ(ierr);
+  if (flg) {
+    ierr = PCMGSetProcEqLim(pc,m);CHKERRQ(ierr);
+  }
   if (mg->am == PC_MG_MULTIPLICATIVE) {
     ierr = PetscOptionsInt("-pc_mg_multiplicative_cycles","Number of cycles for each preconditioner step","PCMGSetLevels",mg->cyclesperpcapply,&cycles,&flg);CHKERRQ(ierr);
     if (flg) {
@@ -447,7 +547,7 @@ PetscErrorCode PCSetFromOptions_MG(PetscOptions *PetscOptionsObject,PC pc)
   PetscFunctionReturn(0);
 }
 
-const char *const PCMGTypes[] = {"MULTIPLICATIVE","ADDITIVE","FULL","KASKADE","PCMGType","PC_MG",0};
+const char *const PCMGTypes[] = {"MULTIPLICATIVE","ADDITIVE","FULL","KASKADE","MULTIADDITIVE","PCMGType","PC_MG",0};
 const char *const PCMGCycleTypes[] = {"invalid","v","w","PCMGCycleType","PC_MG_CYCLE",0};
 
 #include <petscdraw.h>
@@ -476,6 +576,9 @@ PetscErrorCode PCView_MG(PC pc,PetscViewer viewer)
     } else {
       ierr = PetscViewerASCIIPrintf(viewer,"    Not using Galerkin computed coarse grid matrices\n");CHKERRQ(ierr);
     }
+    if (mg->proceqlim) {
+      ierr = PetscViewerASCIIPrintf(viewer,"    Agglomerating coarse levels with fewer than %D equations per process\n",mg->proceqlim);CHKERRQ(ierr);
+    }
     if (mg->view){
       ierr = (*mg->view)(pc,viewer);CHKERRQ(ierr);
     }
@@ -485,6 +588,26 @@ PetscErrorCode PCView_MG(PC pc,PetscViewer viewer)
       } else {
         ierr = PetscViewerASCIIPrintf(viewer,"Down solver (pre-smoother) on level %D -------------------------------\n",i);CHKERRQ(ierr);
       }
+      if (mglevels[i]->aggsubcomm) {
+        PetscViewer subviewer;
+
+        ierr = PetscViewerASCIIPrintf(viewer,"  Level agglomerated onto %d processes\n",mglevels[i]->aggsubcomm->subsize[0]);CHKERRQ(ierr);
+        ierr = PetscViewerGetSubcomm(viewer,PetscSubcommChild(mglevels[i]->aggsubcomm),&subviewer);CHKERRQ(ierr);
+        if (!mglevels[i]->aggsubcomm->color) {
+          ierr = PetscViewerASCIIPushTab(subviewer);CHKERRQ(ierr);
+          ierr = KSPView(mglevels[i]->aggsmoothd,subviewer);CHKERRQ(ierr);
+          if (i && mglevels[i]->aggsmoothd != mglevels[i]->aggsmoothu) {
+            ierr = PetscViewerASCIIPrintf(subviewer,"Up solver (post-smoother) on level %D -------------------------------\n",i);CHKERRQ(ierr);
+            ierr = KSPView(mglevels[i]->aggsmoothu,subviewer);CHKERRQ(ierr);
+          }
+          ierr = PetscViewerASCIIPopTab(subviewer);CHKERRQ(ierr);
+        }
+        ierr = PetscViewerRestoreSubcomm(viewer,PetscSubcommChild(mglevels[i]->aggsubcomm),&subviewer);CHKERRQ(ierr);
+        if (i && mglevels[i]->smoothd == mglevels[i]->smoothu) {
+          ierr = PetscViewerASCIIPrintf(viewer,"Up solver (post-smoother) same as down solver (pre-smoother)\n");CHKERRQ(ierr);
+        }
+        continue;
+      }
       ierr = PetscViewerASCIIPushTab(viewer);CHKERRQ(ierr);
       ierr = KSPView(mglevels[i]->smoothd,viewer);CHKERRQ(ierr);
       ierr = PetscViewerASCIIPopTab(viewer);CHKERRQ(ierr);
@@ -535,6 +658,251 @@ PetscErrorCode PCView_MG(PC pc,PetscViewer viewer)
 #include <petsc/private/dmimpl.h>
 #include <petsc/private/kspimpl.h>
 
+#undef __FUNCT__
+#define __FUNCT__ "PCMGCreateAggSmoother_Private"
+/*
+   PCMGCreateAggSmoother_Private - Creates a smoother on the subcommunicator of an agglomerated level with the type,
+   tolerances and options prefix of the level smoother ksp
+*/
+static PetscErrorCode PCMGCreateAggSmoother_Private(PC pc,KSP ksp,MPI_Comm subcomm,PetscInt tablevel,KSP *aggksp)
+{
+  PetscErrorCode ierr;
+  KSPType        ksptype;
+  PCType         pctype;
+  PC             ipc;
+  PetscReal      rtol,abstol,dtol;
+  PetscInt       maxits;
+  KSPNormType    normtype;
+  const char     *prefix;
+
+  PetscFunctionBegin;
+  ierr = KSPGetOptionsPrefix(ksp,&prefix);CHKERRQ(ierr);
+  ierr = KSPGetTolerances(ksp,&rtol,&abstol,&dtol,&maxits);CHKERRQ(ierr);
+  ierr = KSPGetType(ksp,&ksptype);CHKERRQ(ierr);
+  ierr = KSPGetNormType(ksp,&normtype);CHKERRQ(ierr);
+  ierr = KSPGetPC(ksp,&ipc);CHKERRQ(ierr);
+  ierr = PCGetType(ipc,&pctype);CHKERRQ(ierr);
+
+  ierr = KSPCreate(subcomm,aggksp);CHKERRQ(ierr);
+  ierr = KSPSetErrorIfNotConverged(*aggksp,pc->erroriffailure);CHKERRQ(ierr);
+  ierr = PetscObjectIncrementTabLevel((PetscObject)*aggksp,(PetscObject)pc,tablevel);CHKERRQ(ierr);
+  ierr = KSPSetOptionsPrefix(*aggksp,prefix);CHKERRQ(ierr);
+  ierr = KSPSetTolerances(*aggksp,rtol,abstol,dtol,maxits);CHKERRQ(ierr);
+  ierr = KSPSetType(*aggksp,ksptype);CHKERRQ(ierr);
+  ierr = KSPSetNormType(*aggksp,normtype);CHKERRQ(ierr);
+  ierr = KSPSetConvergenceTest(*aggksp,KSPConvergedSkip,NULL,NULL);CHKERRQ(ierr);
+  ierr = KSPGetPC(*aggksp,&ipc);CHKERRQ(ierr);
+  ierr = PCSetType(ipc,pctype);CHKERRQ(ierr);
+  ierr = KSPSetFromOptions(*aggksp);CHKERRQ(ierr);
+  ierr = PetscLogObjectParent((PetscObject)pc,(PetscObject)*aggksp);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PCMGSetUpAgglomeration_Private"
+/*
+   PCMGSetUpAgglomeration_Private - Moves each coarse level with fewer than mg->proceqlim equations per process onto
+   the first M/proceqlim processes of the PC communicator.
+
+   The rows of the level operator are gathered onto a subcommunicator of these processes, where the smoothers and the
+   residual work. The level vectors stay on the PC communicator with all their entries on these processes, so the
+   transfers to the finer level are parallel matrices with the matching layouts, and the vectors on the
+   subcommunicator share their arrays.
+*/
+static PetscErrorCode PCMGSetUpAgglomeration_Private(PC pc)
+{
+  PC_MG          *mg        = (PC_MG*)pc->data;
+  PC_MG_Levels   **mglevels = mg->levels;
+  PetscErrorCode ierr;
+  PetscInt       n = mglevels[0]->levels,i,M,Mb,bs,nactive,nlocal,rstart,rend;
+  PetscMPIInt    size,rank,color;
+  MPI_Comm       comm,subcomm;
+  Mat            A,P,R;
+  IS             isall,isfine;
+  Vec            v;
+  MatReuse       reuse;
+  PetscBool      set,isaij;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)pc,&comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
+  if (!mg->proceqlim || size == 1) PetscFunctionReturn(0);
+
+  nactive = size;
+  for (i=n-2; i>=0; i--) {
+    ierr = KSPGetOperatorsSet(mglevels[i]->smoothd,NULL,&set);CHKERRQ(ierr);
+    if (!set) SETERRQ1(comm,PETSC_ERR_ARG_WRONGSTATE,"Level %D has no operator; agglomerating coarse levels requires the operators before the smoothers are set up, use PCMGSetGalerkin() or KSPSetOperators() on each level",i);
+    ierr    = KSPGetOperators(mglevels[i]->smoothd,NULL,&A);CHKERRQ(ierr);
+    ierr    = MatGetSize(A,&M,NULL);CHKERRQ(ierr);
+    ierr    = MatGetBlockSize(A,&bs);CHKERRQ(ierr);
+    nactive = PetscMax(1,PetscMin(nactive,M/mg->proceqlim));
+    if (nactive == size) continue;
+
+    reuse = MAT_REUSE_MATRIX;
+    if (!mglevels[i]->aggsubcomm) {
+      /* the first nactive processes hold the level, with about the same number of blocks each */
+      color = rank < nactive ? 0 : 1;
+      ierr  = PetscSubcommCreate(comm,&mglevels[i]->aggsubcomm);CHKERRQ(ierr);
+      ierr  = PetscSubcommSetNumber(mglevels[i]->aggsubcomm,2);CHKERRQ(ierr);
+      ierr  = PetscSubcommSetTypeGeneral(mglevels[i]->aggsubcomm,color,color ? rank-(PetscMPIInt)nactive : rank);CHKERRQ(ierr);
+      ierr  = PetscLogObjectMemory((PetscObject)pc,sizeof(PetscSubcomm));CHKERRQ(ierr);
+      Mb     = M/bs;
+      rstart = color ? 0 : bs*(rank*(Mb/nactive) + PetscMin(rank,Mb%nactive));
+      nlocal = color ? 0 : bs*(Mb/nactive + (rank < Mb%nactive ? 1 : 0));
+      ierr   = ISCreateStride(comm,nlocal,rstart,1,&mglevels[i]->aggis);CHKERRQ(ierr);
+
+      ierr = VecCreateMPI(comm,nlocal,M,&v);CHKERRQ(ierr);
+      ierr = PCMGSetRhs(pc,i,v);CHKERRQ(ierr);
+      ierr = VecDestroy(&v);CHKERRQ(ierr);
+      ierr = VecCreateMPI(comm,nlocal,M,&v);CHKERRQ(ierr);
+      ierr = PCMGSetX(pc,i,v);CHKERRQ(ierr);
+      ierr = VecDestroy(&v);CHKERRQ(ierr);
+      if (i) {
+        ierr = VecCreateMPI(comm,nlocal,M,&v);CHKERRQ(ierr);
+        ierr = PCMGSetR(pc,i,v);CHKERRQ(ierr);
+        ierr = VecDestroy(&v);CHKERRQ(ierr);
+      }
+      if (!mglevels[i]->residual) mglevels[i]->residual = PCMGResidualDefault;
+      reuse = MAT_INITIAL_MATRIX;
+    } else if (pc->flag != SAME_NONZERO_PATTERN) {
+      ierr  = MatDestroyMatrices(1,&mglevels[i]->aggAseq);CHKERRQ(ierr);
+      ierr  = MatDestroy(&mglevels[i]->aggA);CHKERRQ(ierr);
+      reuse = MAT_INITIAL_MATRIX;
+    }
+    ierr = ISGetLocalSize(mglevels[i]->aggis,&nlocal);CHKERRQ(ierr);
+
+    /* gather the rows of the operator and assemble them on the subcommunicator */
+    ierr = ISCreateStride(PETSC_COMM_SELF,M,0,1,&isall);CHKERRQ(ierr);
+    ierr = MatGetSubMatrices(A,1,&mglevels[i]->aggis,&isall,reuse,&mglevels[i]->aggAseq);CHKERRQ(ierr);
+    ierr = ISDestroy(&isall);CHKERRQ(ierr);
+    if (!mglevels[i]->aggsubcomm->color) {
+      subcomm = PetscSubcommChild(mglevels[i]->aggsubcomm);
+      ierr    = MatCreateMPIMatConcatenateSeqMat(subcomm,mglevels[i]->aggAseq[0],nlocal,reuse,&mglevels[i]->aggA);CHKERRQ(ierr);
+      if (!mglevels[i]->aggsmoothd) {
+        ierr = PCMGCreateAggSmoother_Private(pc,mglevels[i]->smoothd,subcomm,n-i,&mglevels[i]->aggsmoothd);CHKERRQ(ierr);
+        if (mglevels[i]->smoothu != mglevels[i]->smoothd) {
+          ierr = PCMGCreateAggSmoother_Private(pc,mglevels[i]->smoothu,subcomm,n-i,&mglevels[i]->aggsmoothu);CHKERRQ(ierr);
+        } else mglevels[i]->aggsmoothu = mglevels[i]->aggsmoothd;
+        ierr = VecCreateMPIWithArray(subcomm,1,nlocal,M,NULL,&mglevels[i]->aggb);CHKERRQ(ierr);
+        ierr = VecCreateMPIWithArray(subcomm,1,nlocal,M,NULL,&mglevels[i]->aggx);CHKERRQ(ierr);
+        if (i) {ierr = VecCreateMPIWithArray(subcomm,1,nlocal,M,NULL,&mglevels[i]->aggr);CHKERRQ(ierr);}
+      }
+      ierr = KSPSetOperators(mglevels[i]->aggsmoothd,mglevels[i]->aggA,mglevels[i]->aggA);CHKERRQ(ierr);
+      if (mglevels[i]->aggsmoothu != mglevels[i]->aggsmoothd) {
+        ierr = KSPSetOperators(mglevels[i]->aggsmoothu,mglevels[i]->aggA,mglevels[i]->aggA);CHKERRQ(ierr);
+      }
+    }
+
+    /* the transfers from the finer level, whose rows are either agglomerated or in their original layout */
+    ierr = PCMGGetInterpolation(pc,i+1,&P);CHKERRQ(ierr);
+    ierr = PCMGGetRestriction(pc,i+1,&R);CHKERRQ(ierr);
+    if (mglevels[i+1]->aggis) {
+      ierr   = PetscObjectReference((PetscObject)mglevels[i+1]->aggis);CHKERRQ(ierr);
+      isfine = mglevels[i+1]->aggis;
+    } else {
+      ierr = MatGetOwnershipRange(P,&rstart,&rend);CHKERRQ(ierr);
+      ierr = ISCreateStride(comm,rend-rstart,rstart,1,&isfine);CHKERRQ(ierr);
+    }
+    reuse = mglevels[i+1]->agginterp ? MAT_REUSE_MATRIX : MAT_INITIAL_MATRIX;
+    ierr  = PetscObjectTypeCompare((PetscObject)P,MATMPIAIJ,&isaij);CHKERRQ(ierr);
+    if (isaij) {
+      ierr = MatGetSubMatrix(P,isfine,mglevels[i]->aggis,reuse,&mglevels[i+1]->agginterp);CHKERRQ(ierr);
+    } else {
+      Mat Paij;
+      ierr = MatConvert(P,MATAIJ,MAT_INITIAL_MATRIX,&Paij);CHKERRQ(ierr);
+      ierr = MatGetSubMatrix(Paij,isfine,mglevels[i]->aggis,reuse,&mglevels[i+1]->agginterp);CHKERRQ(ierr);
+      ierr = MatDestroy(&Paij);CHKERRQ(ierr);
+    }
+    if (R == P) {
+      if (!mglevels[i+1]->aggrestrct) {
+        ierr = PetscObjectReference((PetscObject)mglevels[i+1]->agginterp);CHKERRQ(ierr);
+        mglevels[i+1]->aggrestrct = mglevels[i+1]->agginterp;
+      }
+    } else {
+      ierr = PetscObjectTypeCompare((PetscObject)R,MATMPIAIJ,&isaij);CHKERRQ(ierr);
+      if (isaij) {
+        ierr = MatGetSubMatrix(R,mglevels[i]->aggis,isfine,reuse,&mglevels[i+1]->aggrestrct);CHKERRQ(ierr);
+      } else {
+        Mat Raij;
+        ierr = MatConvert(R,MATAIJ,MAT_INITIAL_MATRIX,&Raij);CHKERRQ(ierr);
+        ierr = MatGetSubMatrix(Raij,mglevels[i]->aggis,isfine,reuse,&mglevels[i+1]->aggrestrct);CHKERRQ(ierr);
+        ierr = MatDestroy(&Raij);CHKERRQ(ierr);
+      }
+    }
+    ierr = ISDestroy(&isfine);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PCMGComputeL1DInv_Private"
+/*
+   PCMGComputeL1DInv_Private - Computes the inverses of the l1 norms of the local rows of A
+*/
+static PetscErrorCode PCMGComputeL1DInv_Private(Mat A,Vec dinv)
+{
+  PetscErrorCode    ierr;
+  PetscInt          rstart,rend,row,ncols,j;
+  const PetscScalar *vals;
+  PetscScalar       *d;
+  PetscReal         sum;
+
+  PetscFunctionBegin;
+  ierr = MatGetOwnershipRange(A,&rstart,&rend);CHKERRQ(ierr);
+  ierr = VecGetArray(dinv,&d);CHKERRQ(ierr);
+  for (row=rstart; row<rend; row++) {
+    ierr = MatGetRow(A,row,&ncols,NULL,&vals);CHKERRQ(ierr);
+    sum  = 0.0;
+    for (j=0; j<ncols; j++) sum += PetscAbsScalar(vals[j]);
+    ierr = MatRestoreRow(A,row,&ncols,NULL,&vals);CHKERRQ(ierr);
+    if (sum == 0.0) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_MAT_LU_ZRPVT,"Zero row %D in the level operator",row);
+    d[row-rstart] = 1.0/sum;
+  }
+  ierr = VecRestoreArray(dinv,&d);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PCMGSetUpMultiAdditive_Private"
+/*
+   PCMGSetUpMultiAdditive_Private - Computes the l1-Jacobi scaling that smooths the transfers of the multiadditive
+   cycle, from the operators on the subcommunicators for the agglomerated levels
+*/
+static PetscErrorCode PCMGSetUpMultiAdditive_Private(PC pc)
+{
+  PC_MG          *mg        = (PC_MG*)pc->data;
+  PC_MG_Levels   **mglevels = mg->levels;
+  PetscErrorCode ierr;
+  PetscInt       i,n = mglevels[0]->levels;
+  PetscScalar    *d;
+  Mat            A;
+
+  PetscFunctionBegin;
+  for (i=1; i<n; i++) {
+    if (!mglevels[i]->l1dinv) {
+      ierr = VecDuplicate(mglevels[i]->r,&mglevels[i]->l1dinv);CHKERRQ(ierr);
+      ierr = VecDuplicate(mglevels[i]->r,&mglevels[i]->work);CHKERRQ(ierr);
+      ierr = PetscLogObjectParent((PetscObject)pc,(PetscObject)mglevels[i]->l1dinv);CHKERRQ(ierr);
+      ierr = PetscLogObjectParent((PetscObject)pc,(PetscObject)mglevels[i]->work);CHKERRQ(ierr);
+    }
+    if (mglevels[i]->aggsubcomm) {
+      if (mglevels[i]->aggsubcomm->color) continue;
+      ierr = VecGetArray(mglevels[i]->l1dinv,&d);CHKERRQ(ierr);
+      ierr = VecPlaceArray(mglevels[i]->aggr,d);CHKERRQ(ierr);
+      ierr = PCMGComputeL1DInv_Private(mglevels[i]->aggA,mglevels[i]->aggr);CHKERRQ(ierr);
+      ierr = VecResetArray(mglevels[i]->aggr);CHKERRQ(ierr);
+      ierr = VecRestoreArray(mglevels[i]->l1dinv,&d);CHKERRQ(ierr);
+    } else {
+      A = mglevels[i]->A;
+      if (!A) {ierr = KSPGetOperators(mglevels[i]->smoothu,&A,NULL);CHKERRQ(ierr);}
+      ierr = PCMGComputeL1DInv_Private(A,mglevels[i]->l1dinv);CHKERRQ(ierr);
+    }
+  }
+  mg->l1dinvvalid = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
 /*
     Calls setup for the KSP on each level
 */
@@ -550,6 +918,7 @@ PetscErrorCode PCSetUp_MG(PC pc)
   PetscBool      preonly,lu,redundant,cholesky,svd,dump = PETSC_FALSE,opsset,use_amat,missinginterpolate = PETSC_FALSE;
   Mat            dA,dB;
   Vec            tvec;
+  KSP            smoothd,smoothu;
   DM             *dms;
   PetscViewer    viewer = 0;
 
@@ -566,8 +935,6 @@ PetscErrorCode PCSetUp_MG(PC pc)
       mglevels =  mg->levels;
     }
   }
-  ierr = KSPGetPC(mglevels[0]->smoothd,&cpc);CHKERRQ(ierr);
-
 
   /* If user did not provide fine grid operators OR operator was not updated since last global KSPSetOperators() */
   /* so use those from global PC */
@@ -712,6 +1079,8 @@ PetscErrorCode PCSetUp_MG(PC pc)
     }
   }
 
+  ierr = PCMGSetUpAgglomeration_Private(pc);CHKERRQ(ierr);
+
   if (!pc->setupcalled) {
     for (i=0; i<n; i++) {
       ierr = KSPSetFromOptions(mglevels[i]->smoothd);CHKERRQ(ierr);
@@ -761,55 +1130,67 @@ PetscErrorCode PCSetUp_MG(PC pc)
     }
   }
 
+  /* the smoothers of agglomerated levels are those on the subcommunicator, there are none on the other processes */
   for (i=1; i<n; i++) {
+    smoothd = mglevels[i]->aggsubcomm ? mglevels[i]->aggsmoothd : mglevels[i]->smoothd;
+    if (!smoothd) continue;
     if (mglevels[i]->smoothu == mglevels[i]->smoothd || mg->am == PC_MG_FULL || mg->am == PC_MG_KASKADE || mg->cyclesperpcapply > 1){
       /* if doing only down then initial guess is zero */
-      ierr = KSPSetInitialGuessNonzero(mglevels[i]->smoothd,PETSC_TRUE);CHKERRQ(ierr);
+      ierr = KSPSetInitialGuessNonzero(smoothd,PETSC_TRUE);CHKERRQ(ierr);
     }
     if (mglevels[i]->eventsmoothsetup) {ierr = PetscLogEventBegin(mglevels[i]->eventsmoothsetup,0,0,0,0);CHKERRQ(ierr);}
-    ierr = KSPSetUp(mglevels[i]->smoothd);CHKERRQ(ierr);
+    ierr = KSPSetUp(smoothd);CHKERRQ(ierr);
     if (mglevels[i]->eventsmoothsetup) {ierr = PetscLogEventEnd(mglevels[i]->eventsmoothsetup,0,0,0,0);CHKERRQ(ierr);}
     if (!mglevels[i]->residual) {
       Mat mat;
-      ierr = KSPGetOperators(mglevels[i]->smoothd,NULL,&mat);CHKERRQ(ierr);
+      ierr = KSPGetOperators(smoothd,NULL,&mat);CHKERRQ(ierr);
       ierr = PCMGSetResidual(pc,i,PCMGResidualDefault,mat);CHKERRQ(ierr);
     }
   }
   for (i=1; i<n; i++) {
-    if (mglevels[i]->smoothu && mglevels[i]->smoothu != mglevels[i]->smoothd) {
+    smoothd = mglevels[i]->aggsubcomm ? mglevels[i]->aggsmoothd : mglevels[i]->smoothd;
+    smoothu = mglevels[i]->aggsubcomm ? mglevels[i]->aggsmoothu : mglevels[i]->smoothu;
+    if (smoothu && smoothu != smoothd) {
       Mat          downmat,downpmat;
 
       /* check if operators have been set for up, if not use down operators to set them */
-      ierr = KSPGetOperatorsSet(mglevels[i]->smoothu,&opsset,NULL);CHKERRQ(ierr);
+      ierr = KSPGetOperatorsSet(smoothu,&opsset,NULL);CHKERRQ(ierr);
       if (!opsset) {
-        ierr = KSPGetOperators(mglevels[i]->smoothd,&downmat,&downpmat);CHKERRQ(ierr);
-        ierr = KSPSetOperators(mglevels[i]->smoothu,downmat,downpmat);CHKERRQ(ierr);
+        ierr = KSPGetOperators(smoothd,&downmat,&downpmat);CHKERRQ(ierr);
+        ierr = KSPSetOperators(smoothu,downmat,downpmat);CHKERRQ(ierr);
       }
 
-      ierr = KSPSetInitialGuessNonzero(mglevels[i]->smoothu,PETSC_TRUE);CHKERRQ(ierr);
+      ierr = KSPSetInitialGuessNonzero(smoothu,PETSC_TRUE);CHKERRQ(ierr);
       if (mglevels[i]->eventsmoothsetup) {ierr = PetscLogEventBegin(mglevels[i]->eventsmoothsetup,0,0,0,0);CHKERRQ(ierr);}
-      ierr = KSPSetUp(mglevels[i]->smoothu);CHKERRQ(ierr);
+      ierr = KSPSetUp(smoothu);CHKERRQ(ierr);
       if (mglevels[i]->eventsmoothsetup) {ierr = PetscLogEventEnd(mglevels[i]->eventsmoothsetup,0,0,0,0);CHKERRQ(ierr);}
     }
   }
 
-  /*
-      If coarse solver is not direct method then DO NOT USE preonly
-  */
-  ierr = PetscObjectTypeCompare((PetscObject)mglevels[0]->smoothd,KSPPREONLY,&preonly);CHKERRQ(ierr);
-  if (preonly) {
-    ierr = PetscObjectTypeCompare((PetscObject)cpc,PCLU,&lu);CHKERRQ(ierr);
-    ierr = PetscObjectTypeCompare((PetscObject)cpc,PCREDUNDANT,&redundant);CHKERRQ(ierr);
-    ierr = PetscObjectTypeCompare((PetscObject)cpc,PCCHOLESKY,&cholesky);CHKERRQ(ierr);
-    ierr = PetscObjectTypeCompare((PetscObject)cpc,PCSVD,&svd);CHKERRQ(ierr);
-    if (!lu && !redundant && !cholesky && !svd) {
-      ierr = KSPSetType(mglevels[0]->smoothd,KSPGMRES);CHKERRQ(ierr);
+  mg->l1dinvvalid = PETSC_FALSE;
+  if (mg->am == PC_MG_MULTIADDITIVE) {ierr = PCMGSetUpMultiAdditive_Private(pc);CHKERRQ(ierr);}
+
+  smoothd = mglevels[0]->aggsubcomm ? mglevels[0]->aggsmoothd : mglevels[0]->smoothd;
+  if (smoothd) {
+    /*
+        If coarse solver is not direct method then DO NOT USE preonly
+    */
+    ierr = KSPGetPC(smoothd,&cpc);CHKERRQ(ierr);
+    ierr = PetscObjectTypeCompare((PetscObject)smoothd,KSPPREONLY,&preonly);CHKERRQ(ierr);
+    if (preonly) {
+      ierr = PetscObjectTypeCompare((PetscObject)cpc,PCLU,&lu);CHKERRQ(ierr);
+      ierr = PetscObjectTypeCompare((PetscObject)cpc,PCREDUNDANT,&redundant);CHKERRQ(ierr);
+      ierr = PetscObjectTypeCompare((PetscObject)cpc,PCCHOLESKY,&cholesky);CHKERRQ(ierr);
+      ierr = PetscObjectTypeCompare((PetscObject)cpc,PCSVD,&svd);CHKERRQ(ierr);
+      if (!lu && !redundant && !cholesky && !svd) {
+        ierr = KSPSetType(smoothd,KSPGMRES);CHKERRQ(ierr);
+      }
     }
-  }
 
-  if (mglevels[0]->eventsmoothsetup) {ierr = PetscLogEventBegin(mglevels[0]->eventsmoothsetup,0,0,0,0);CHKERRQ(ierr);}
-  ierr = KSPSetUp(mglevels[0]->smoothd);CHKERRQ(ierr);
-  if (mglevels[0]->eventsmoothsetup) {ierr = PetscLogEventEnd(mglevels[0]->eventsmoothsetup,0,0,0,0);CHKERRQ(ierr);}
+    if (mglevels[0]->eventsmoothsetup) {ierr = PetscLogEventBegin(mglevels[0]->eventsmoothsetup,0,0,0,0);CHKERRQ(ierr);}
+    ierr = KSPSetUp(smoothd);CHKERRQ(ierr);
+    if (mglevels[0]->eventsmoothsetup) {ierr = PetscLogEventEnd(mglevels[0]->eventsmoothsetup,0,0,0,0);CHKERRQ(ierr);}
+  }
 
   /*
      Dump the interpolation/restriction matrices plus the
@@ -874,22 +1255,28 @@ PetscErrorCode  PCMGGetLevels(PC pc,PetscInt *levels)
 #define __FUNCT__ "PCMGSetType"
 /*@
    PCMGSetType - Determines the form of multigrid to use:
-   multiplicative, additive, full, or the Kaskade algorithm.
+   multiplicative, additive, full, the Kaskade algorithm or multiadditive.
 
    Logically Collective on PC
 
    Input Parameters:
 +  pc - the preconditioner context
 -  form - multigrid form, one of PC_MG_MULTIPLICATIVE, PC_MG_ADDITIVE,
-   PC_MG_FULL, PC_MG_KASKADE
+   PC_MG_FULL, PC_MG_KASKADE, PC_MG_MULTIADDITIVE
 
    Options Database Key:
 .  -pc_mg_type <form> - Sets <form>, one of multiplicative,
-   additive, full, kaskade
+   additive, full, kaskade, multiadditive
+
+   Notes:
+   The multiadditive form smooths the interpolation of each level with an l1-Jacobi sweep, (I - D^{-1} A) P with D the
+   l1 norms of the rows of A, and the restriction likewise. The restricted right hand sides then carry the effect of the
+   finer smoothing, so unlike the multiplicative cycle the solves on the levels are independent of each other,
+   while the preconditioner converges much like the V-cycle. It requires MatGetRow() for the level operators.
 
    Level: advanced
 
-.keywords: MG, set, method, multiplicative, additive, full, Kaskade, multigrid
+.keywords: MG, set, method, multiplicative, additive, full, Kaskade, multiadditive, multigrid
 
 .seealso: PCMGSetLevels()
 @*/
@@ -908,7 +1295,7 @@ PetscErrorCode  PCMGSetType(PC pc,PCMGType form)
 
 /*@
    PCMGGetType - Determines the form of multigrid to use:
-   multiplicative, additive, full, or the Kaskade algorithm.
+   multiplicative, additive, full, the Kaskade algorithm or multiadditive.
 
    Logically Collective on PC
 
@@ -916,7 +1303,7 @@ PetscErrorCode  PCMGSetType(PC pc,PCMGType form)
 .  pc - the preconditioner context
 
    Output Parameter:
-.  type - one of PC_MG_MULTIPLICATIVE, PC_MG_ADDITIVE,PC_MG_FULL, PC_MG_KASKADE
+.  type - one of PC_MG_MULTIPLICATIVE, PC_MG_ADDITIVE,PC_MG_FULL, PC_MG_KASKADE, PC_MG_MULTIADDITIVE
 
 
    Level: advanced
@@ -1006,6 +1393,49 @@ PetscErrorCode  PCMGMultiplicativeSetCycles(PC pc,PetscInt n)
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "PCMGSetProcEqLim"
+/*@
+   PCMGSetProcEqLim - Sets the number of equations per process below which a coarse level is agglomerated
+      onto fewer processes
+
+   Logically Collective on PC
+
+   Input Parameters:
++  pc - the multigrid context
+-  n - the number of equations per process, 0 to keep every level on all the processes (the default)
+
+   Options Database Key:
+.  -pc_mg_process_eq_limit n
+
+   Level: intermediate
+
+   Notes: A coarse level with M equations is moved onto the first M/n processes of the PC communicator, never onto more
+   processes than the next finer level. Its smoothers, or the coarse grid solver, and the residual work on a
+   subcommunicator of these processes, created with PetscSubcomm; the restriction and interpolation move the vectors
+   between the layouts of the two levels. The smoothers on the subcommunicator are created during the setup with the type,
+   tolerances and options prefix of the level smoothers returned by PCMGGetSmoother(), so they are customized from the
+   options database.
+
+   The coarse operators must exist before the smoothers are set up, either with PCMGSetGalerkin() or with KSPSetOperators()
+   on the level smoothers, and be AIJ or BAIJ matrices.
+
+.keywords: MG, set, agglomeration, coarse grid, processes
+
+.seealso: PCMGSetGalerkin(), PCMGGetSmoother(), PCGAMGSetProcEqLim(), PCREDUNDANT
+@*/
+PetscErrorCode  PCMGSetProcEqLim(PC pc,PetscInt n)
+{
+  PC_MG *mg = (PC_MG*)pc->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidLogicalCollectiveInt(pc,n,2);
+  if (n < 0) SETERRQ1(PetscObjectComm((PetscObject)pc),PETSC_ERR_ARG_OUTOFRANGE,"Number of equations per process %D cannot be negative",n);
+  mg->proceqlim = n;
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "PCMGSetGalerkin_MG"
 PetscErrorCode PCMGSetGalerkin_MG(PC pc,PetscBool use)
@@ -1190,10 +1620,11 @@ PetscErrorCode  PCMGSetNumberSmoothUp(PC pc,PetscInt n)
 .  -pc_mg_cycles <v,w> -
 .  -pc_mg_smoothup <n> - number of smoothing steps after interpolation
 .  -pc_mg_smoothdown <n> - number of smoothing steps before applying restriction operator
-.  -pc_mg_type <additive,multiplicative,full,kaskade> - multiplicative is the default
+.  -pc_mg_type <additive,multiplicative,full,kaskade,multiadditive> - multiplicative is the default
 .  -pc_mg_log - log information about time spent on each level of the solver
 .  -pc_mg_galerkin - use Galerkin process to compute coarser operators, i.e. Acoarse = R A R'
 .  -pc_mg_multiplicative_cycles - number of cycles to use as the preconditioner (defaults to 1)
+.  -pc_mg_process_eq_limit <n> - agglomerate the coarse levels with fewer than n equations per process onto fewer processes
 .  -pc_mg_dump_matlab - dumps the matrices for each level and the restriction/interpolation matrices
                         to the Socket viewer for reading from MATLAB.
 -  -pc_mg_dump_binary - dumps the matrices for each level and the restriction/interpolation matrices
@@ -1211,7 +1642,7 @@ PetscErrorCode  PCMGSetNumberSmoothUp(PC pc,PetscInt n)
            PCMGSetLevels(), PCMGGetLevels(), PCMGSetType(), PCMGSetCycleType(), PCMGSetNumberSmoothDown(),
            PCMGSetNumberSmoothUp(), PCMGGetCoarseSolve(), PCMGSetResidual(), PCMGSetInterpolation(),
            PCMGSetRestriction(), PCMGGetSmoother(), PCMGGetSmootherUp(), PCMGGetSmootherDown(),
-           PCMGSetCycleTypeOnLevel(), PCMGSetRhs(), PCMGSetX(), PCMGSetR()
+           PCMGSetCycleTypeOnLevel(), PCMGSetRhs(), PCMGSetX(), PCMGSetR(), PCMGSetProcEqLim()
 M*/
 
 #undef __FUNCT__
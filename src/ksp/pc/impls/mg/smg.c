@@ -1,6 +1,6 @@
 
 /*
-     Additive Multigrid V Cycle routine
+     Additive and multiadditive Multigrid V Cycle routines
 */
 #include <petsc/private/pcmgimpl.h>
 
@@ -15,20 +15,65 @@ PetscErrorCode PCMGACycle_Private(PC pc,PC_MG_Levels **mglevels)
   /* compute RHS on each level */
   for (i=l-1; i>0; i--) {
     if (mglevels[i]->eventinterprestrict) {ierr = PetscLogEventBegin(mglevels[i]->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
-    ierr = MatRestrict(mglevels[i]->restrct,mglevels[i]->b,mglevels[i-1]->b);CHKERRQ(ierr);
+    ierr = MatRestrict(PCMGLevelRestriction(mglevels[i]),mglevels[i]->b,mglevels[i-1]->b);CHKERRQ(ierr);
     if (mglevels[i]->eventinterprestrict) {ierr = PetscLogEventEnd(mglevels[i]->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
   }
   /* solve separately on each level */
   for (i=0; i<l; i++) {
     ierr = VecSet(mglevels[i]->x,0.0);CHKERRQ(ierr);
     if (mglevels[i]->eventsmoothsolve) {ierr = PetscLogEventBegin(mglevels[i]->eventsmoothsolve,0,0,0,0);CHKERRQ(ierr);}
-    ierr = KSPSolve(mglevels[i]->smoothd,mglevels[i]->b,mglevels[i]->x);CHKERRQ(ierr);
+    ierr = PCMGLevelSmooth_Private(mglevels[i],mglevels[i]->smoothd);CHKERRQ(ierr);
     if (mglevels[i]->eventsmoothsolve) {ierr = PetscLogEventEnd(mglevels[i]->eventsmoothsolve,0,0,0,0);CHKERRQ(ierr);}
   }
   for (i=1; i<l; i++) {
     if (mglevels[i]->eventinterprestrict) {ierr = PetscLogEventBegin(mglevels[i]->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
-    ierr = MatInterpolateAdd(mglevels[i]->interpolate,mglevels[i-1]->x,mglevels[i]->x,mglevels[i]->x);CHKERRQ(ierr);
+    ierr = MatInterpolateAdd(PCMGLevelInterpolation(mglevels[i]),mglevels[i-1]->x,mglevels[i]->x,mglevels[i]->x);CHKERRQ(ierr);
     if (mglevels[i]->eventinterprestrict) {ierr = PetscLogEventEnd(mglevels[i]->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
   }
   PetscFunctionReturn(0);
 }
+
+#undef __FUNCT__
+#define __FUNCT__ "PCMGMACycle_Private"
+/*
+     Multiadditive multigrid: the additive cycle with the interpolations (I - D^{-1} A) P and restrictions R (I - A D^{-1}),
+   D the l1 row sums of each level operator. The coarser right hand sides only depend on the finer ones, so after the
+   restrictions the level solves are independent of each other.
+*/
+PetscErrorCode PCMGMACycle_Private(PC pc,PC_MG_Levels **mglevels)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,l = mglevels[0]->levels;
+
+  PetscFunctionBegin;
+  /* compute RHS on each level, restricting the residual of one l1-Jacobi sweep */
+  for (i=l-1; i>0; i--) {
+    if (mglevels[i]->eventresidual) {ierr = PetscLogEventBegin(mglevels[i]->eventresidual,0,0,0,0);CHKERRQ(ierr);}
+    ierr = VecPointwiseMult(mglevels[i]->work,mglevels[i]->l1dinv,mglevels[i]->b);CHKERRQ(ierr);
+    ierr = PCMGLevelResidual_Private(mglevels[i],mglevels[i]->b,mglevels[i]->work,mglevels[i]->r);CHKERRQ(ierr);
+    if (mglevels[i]->eventresidual) {ierr = PetscLogEventEnd(mglevels[i]->eventresidual,0,0,0,0);CHKERRQ(ierr);}
+    if (mglevels[i]->eventinterprestrict) {ierr = PetscLogEventBegin(mglevels[i]->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
+    ierr = MatRestrict(PCMGLevelRestriction(mglevels[i]),mglevels[i]->r,mglevels[i-1]->b);CHKERRQ(ierr);
+    if (mglevels[i]->eventinterprestrict) {ierr = PetscLogEventEnd(mglevels[i]->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
+  }
+  /* solve separately on each level */
+  for (i=0; i<l; i++) {
+    ierr = VecSet(mglevels[i]->x,0.0);CHKERRQ(ierr);
+    if (mglevels[i]->eventsmoothsolve) {ierr = PetscLogEventBegin(mglevels[i]->eventsmoothsolve,0,0,0,0);CHKERRQ(ierr);}
+    ierr = PCMGLevelSmooth_Private(mglevels[i],mglevels[i]->smoothd);CHKERRQ(ierr);
+    if (mglevels[i]->eventsmoothsolve) {ierr = PetscLogEventEnd(mglevels[i]->eventsmoothsolve,0,0,0,0);CHKERRQ(ierr);}
+  }
+  /* add the interpolated corrections, followed by an l1-Jacobi sweep for the homogeneous problem */
+  for (i=1; i<l; i++) {
+    if (mglevels[i]->eventinterprestrict) {ierr = PetscLogEventBegin(mglevels[i]->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
+    ierr = MatInterpolate(PCMGLevelInterpolation(mglevels[i]),mglevels[i-1]->x,mglevels[i]->work);CHKERRQ(ierr);
+    if (mglevels[i]->eventinterprestrict) {ierr = PetscLogEventEnd(mglevels[i]->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
+    if (mglevels[i]->eventresidual) {ierr = PetscLogEventBegin(mglevels[i]->eventresidual,0,0,0,0);CHKERRQ(ierr);}
+    ierr = PCMGLevelResidual_Private(mglevels[i],mglevels[i]->b,mglevels[i]->work,mglevels[i]->r);CHKERRQ(ierr);
+    if (mglevels[i]->eventresidual) {ierr = PetscLogEventEnd(mglevels[i]->eventresidual,0,0,0,0);CHKERRQ(ierr);}
+    ierr = VecAXPY(mglevels[i]->r,-1.0,mglevels[i]->b);CHKERRQ(ierr);
+    ierr = VecPointwiseMult(mglevels[i]->r,mglevels[i]->l1dinv,mglevels[i]->r);CHKERRQ(ierr);
+    ierr = VecAXPBYPCZ(mglevels[i]->x,1.0,1.0,1.0,mglevels[i]->work,mglevels[i]->r);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
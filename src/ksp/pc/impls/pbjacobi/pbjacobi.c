@@ -207,6 +207,38 @@ static PetscErrorCode PCApply_PBJacobi_7(PC pc,Vec x,Vec y)
   ierr = PetscLogFlops(80.0*m);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
+#undef __FUNCT__
+#define __FUNCT__ "PCApply_PBJacobi_N"
+/*
+   Larger blocks, the inverted blocks are stored by columns so the inner loop runs over contiguous entries
+*/
+static PetscErrorCode PCApply_PBJacobi_N(PC pc,Vec x,Vec y)
+{
+  PC_PBJacobi       *jac = (PC_PBJacobi*)pc->data;
+  PetscErrorCode    ierr;
+  PetscInt          i,r,c,bs = jac->bs,m = jac->mbs;
+  const MatScalar   *diag = jac->diag;
+  const PetscScalar *xx,*xb;
+  PetscScalar       *yy,*yb,xc;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(x,&xx);CHKERRQ(ierr);
+  ierr = VecGetArray(y,&yy);CHKERRQ(ierr);
+  for (i=0; i<m; i++) {
+    xb = xx + bs*i;
+    yb = yy + bs*i;
+    for (r=0; r<bs; r++) yb[r] = 0.0;
+    for (c=0; c<bs; c++) {
+      xc = xb[c];
+      for (r=0; r<bs; r++) yb[r] += diag[r]*xc;
+      diag += bs;
+    }
+  }
+  ierr = VecRestoreArrayRead(x,&xx);CHKERRQ(ierr);
+  ierr = VecRestoreArray(y,&yy);CHKERRQ(ierr);
+  ierr = PetscLogFlops((2.0*bs*bs-bs)*m);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
 /* -------------------------------------------------------------------------- */
 #undef __FUNCT__
 #define __FUNCT__ "PCSetUp_PBJacobi"
@@ -245,7 +277,8 @@ static PetscErrorCode PCSetUp_PBJacobi(PC pc)
     pc->ops->apply = PCApply_PBJacobi_7;
     break;
   default:
-    SETERRQ1(PetscObjectComm((PetscObject)pc),PETSC_ERR_SUP,"not supported for block size %D",jac->bs);
+    pc->ops->apply = PCApply_PBJacobi_N;
+    break;
   }
   PetscFunctionReturn(0);
 }
@@ -287,7 +320,8 @@ static PetscErrorCode PCView_PBJacobi(PC pc,PetscViewer viewer)
 
    Notes: See PCJACOBI for point Jacobi preconditioning
 
-   This works for AIJ and BAIJ matrices and uses the blocksize provided to the matrix
+   This works for AIJ and BAIJ matrices and uses the blocksize provided to the matrix. Block sizes up to 7 use
+   unrolled kernels, larger block sizes a general kernel. See PCVPBJACOBI for blocks of different sizes.
 
    Uses dense LU factorization with partial pivoting to invert the blocks; if a zero pivot
    is detected a PETSc error is generated.
@@ -305,7 +339,7 @@ static PetscErrorCode PCView_PBJacobi(PC pc,PetscViewer viewer)
   Concepts: point block Jacobi
 
 
-.seealso:  PCCreate(), PCSetType(), PCType (for list of available types), PC, PCJACOBI
+.seealso:  PCCreate(), PCSetType(), PCType (for list of available types), PC, PCJACOBI, PCVPBJACOBI
 
 M*/
 
@@ -454,6 +454,10 @@ PetscErrorCode  PCSORSetIterations(PC pc,PetscInt its,PetscInt lits)
           KSPSetErrorIfNotConverged() or -ksp_error_if_not_converged the code will terminate as soon as it detects the 
           zero pivot.
 
+          For AIJ matrices the option -mat_sor_multicolor orders the rows of each process by the colors of a coloring of the
+          matrix graph, so the rows of each color are relaxed at the same time, with OpenMP threads when available. This
+          changes the ordering of the sweeps, and hence the iterates, but not the symmetry of the symmetric sweep.
+
           For SeqBAIJ matrices this implements point-block SOR, but the omega, its, lits options are not supported.
 
           For SeqBAIJ the diagonal blocks are inverted using dense LU with partial pivoting. If a zero pivot is detected 
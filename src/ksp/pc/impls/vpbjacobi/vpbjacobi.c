@@ -0,0 +1,314 @@
+/*
+   Point-block Jacobi with diagonal blocks of different sizes.
+
+   The blocks of each size are grouped in batches of PC_VPBJACOBI_LANES blocks. The entries of the blocks of a
+   batch are interleaved, entry (i,j) of the block in lane l is stored at (i*bs+j)*PC_VPBJACOBI_LANES+l, so the
+   innermost loops of the inversion and of the application run over the lanes with unit stride and the same trip
+   count; the compiler can vectorize them across the blocks of the batch.
+*/
+#include <petsc/private/pcimpl.h>   /*I "petscpc.h" I*/
+
+#define PC_VPBJACOBI_LANES 8
+
+typedef struct {
+  PetscInt       nblocks,minbs,maxbs;
+  PetscInt       nbatch;             /* number of batches of blocks of the same size */
+  PetscInt       *bsize;             /* block size of each batch */
+  PetscInt       *nlanes;            /* number of blocks in each batch, the remaining lanes are padding */
+  PetscInt       *start;             /* first local row of the block in each lane, PC_VPBJACOBI_LANES entries per batch */
+  PetscInt       *offset;            /* location of each batch in diag */
+  PetscScalar    *diag;              /* the interleaved inverses of the blocks */
+  PetscScalar    *work;              /* interleaved input of one batch */
+  PetscInt       *pivots;
+  PetscLogDouble applyflops;         /* flops of one application */
+} PC_VPBJacobi;
+
+#undef __FUNCT__
+#define __FUNCT__ "PCVPBJacobiInvertBatch_Private"
+/*
+   Gauss-Jordan inversion in place of the interleaved blocks of one batch with partial pivoting. Only the row
+   exchanges depend on the lane, the eliminations are done for all the lanes at once.
+*/
+static PetscErrorCode PCVPBJacobiInvertBatch_Private(PetscInt bs,PetscScalar *a,PetscInt *pivots,const PetscInt *start)
+{
+  const PetscInt W = PC_VPBJACOBI_LANES;
+  PetscInt       i,j,k,l,p;
+  PetscScalar    d[PC_VPBJACOBI_LANES],f[PC_VPBJACOBI_LANES],t,*ak,*ai;
+  PetscReal      amax,aik;
+
+  PetscFunctionBegin;
+  for (k=0; k<bs; k++) {
+    ak = a + k*bs*W;
+    for (l=0; l<W; l++) {
+      p    = k;
+      amax = PetscAbsScalar(ak[k*W+l]);
+      for (i=k+1; i<bs; i++) {
+        aik = PetscAbsScalar(a[(i*bs+k)*W+l]);
+        if (aik > amax) {amax = aik; p = i;}
+      }
+      if (amax == 0.0) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_MAT_LU_ZRPVT,"Zero pivot in row %D of the block starting at local row %D",k,start[l]);
+      pivots[k*W+l] = p;
+      if (p != k) {
+        ai = a + p*bs*W;
+        for (j=0; j<bs; j++) {t = ak[j*W+l]; ak[j*W+l] = ai[j*W+l]; ai[j*W+l] = t;}
+      }
+    }
+    for (l=0; l<W; l++) {
+      d[l]      = 1.0/ak[k*W+l];
+      ak[k*W+l] = 1.0;
+    }
+    for (j=0; j<bs; j++) {
+      for (l=0; l<W; l++) ak[j*W+l] *= d[l];
+    }
+    for (i=0; i<bs; i++) {
+      if (i == k) continue;
+      ai = a + i*bs*W;
+      for (l=0; l<W; l++) {
+        f[l]      = ai[k*W+l];
+        ai[k*W+l] = 0.0;
+      }
+      for (j=0; j<bs; j++) {
+        for (l=0; l<W; l++) ai[j*W+l] -= f[l]*ak[j*W+l];
+      }
+    }
+  }
+  /* the row exchanges of the factorization are undone by exchanging the columns in reverse order */
+  for (k=bs-1; k>=0; k--) {
+    for (l=0; l<W; l++) {
+      p = pivots[k*W+l];
+      if (p == k) continue;
+      for (i=0; i<bs; i++) {
+        ai = a + i*bs*W;
+        t = ai[k*W+l]; ai[k*W+l] = ai[p*W+l]; ai[p*W+l] = t;
+      }
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PCApply_VPBJacobi"
+static PetscErrorCode PCApply_VPBJacobi(PC pc,Vec x,Vec y)
+{
+  PC_VPBJacobi      *jac = (PC_VPBJacobi*)pc->data;
+  const PetscInt    W = PC_VPBJACOBI_LANES;
+  PetscErrorCode    ierr;
+  PetscInt          b,i,j,l,bs,n;
+  const PetscInt    *start;
+  const PetscScalar *xx,*a,*ai;
+  PetscScalar       *yy,*xw = jac->work,yw[PC_VPBJACOBI_LANES];
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(x,&xx);CHKERRQ(ierr);
+  ierr = VecGetArray(y,&yy);CHKERRQ(ierr);
+  for (b=0; b<jac->nbatch; b++) {
+    bs    = jac->bsize[b];
+    n     = jac->nlanes[b];
+    start = jac->start + b*W;
+    a     = jac->diag + jac->offset[b];
+    for (l=0; l<n; l++) {
+      for (j=0; j<bs; j++) xw[j*W+l] = xx[start[l]+j];
+    }
+    for (l=n; l<W; l++) {
+      for (j=0; j<bs; j++) xw[j*W+l] = 0.0;
+    }
+    for (i=0; i<bs; i++) {
+      ai = a + i*bs*W;
+      for (l=0; l<W; l++) yw[l] = 0.0;
+      for (j=0; j<bs; j++) {
+        for (l=0; l<W; l++) yw[l] += ai[j*W+l]*xw[j*W+l];
+      }
+      for (l=0; l<n; l++) yy[start[l]+i] = yw[l];
+    }
+  }
+  ierr = VecRestoreArrayRead(x,&xx);CHKERRQ(ierr);
+  ierr = VecRestoreArray(y,&yy);CHKERRQ(ierr);
+  ierr = PetscLogFlops(jac->applyflops);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PCReset_VPBJacobi"
+static PetscErrorCode PCReset_VPBJacobi(PC pc)
+{
+  PC_VPBJacobi   *jac = (PC_VPBJacobi*)pc->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree4(jac->bsize,jac->nlanes,jac->start,jac->offset);CHKERRQ(ierr);
+  ierr = PetscFree3(jac->diag,jac->work,jac->pivots);CHKERRQ(ierr);
+  jac->nblocks    = 0;
+  jac->nbatch     = 0;
+  jac->applyflops = 0.0;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PCSetUp_VPBJacobi"
+static PetscErrorCode PCSetUp_VPBJacobi(PC pc)
+{
+  PC_VPBJacobi   *jac = (PC_VPBJacobi*)pc->data;
+  const PetscInt W = PC_VPBJACOBI_LANES;
+  Mat            A = pc->pmat;
+  PetscErrorCode ierr;
+  PetscInt       nblocks,m,rstart,bs,b,i,j,k,l,row,*count,*batch,*rows,ndiag;
+  const PetscInt *bsizes;
+  PetscInt       *ubsizes = NULL;
+  PetscScalar    *blk,*a;
+  PetscLogDouble invflops = 0.0;
+
+  PetscFunctionBegin;
+  ierr = PCReset_VPBJacobi(pc);CHKERRQ(ierr);
+  ierr = MatGetLocalSize(A,&m,&i);CHKERRQ(ierr);
+  if (m != i) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Supported only for square matrices and square storage");
+  ierr = MatGetOwnershipRange(A,&rstart,NULL);CHKERRQ(ierr);
+  ierr = MatGetVariableBlockSizes(A,&nblocks,&bsizes);CHKERRQ(ierr);
+  if (!nblocks && m) {
+    /* no variable block sizes were provided, use the block size of the matrix */
+    ierr    = MatGetBlockSize(A,&bs);CHKERRQ(ierr);
+    nblocks = m/bs;
+    ierr    = PetscMalloc1(nblocks,&ubsizes);CHKERRQ(ierr);
+    for (i=0; i<nblocks; i++) ubsizes[i] = bs;
+    bsizes = ubsizes;
+  }
+  jac->nblocks = nblocks;
+  jac->minbs   = nblocks ? PETSC_MAX_INT : 0;
+  jac->maxbs   = 0;
+  for (i=0; i<nblocks; i++) {
+    jac->minbs = PetscMin(jac->minbs,bsizes[i]);
+    jac->maxbs = PetscMax(jac->maxbs,bsizes[i]);
+  }
+
+  /* group the blocks by size, the batches of each size are consecutive */
+  ierr = PetscCalloc2(jac->maxbs+1,&count,jac->maxbs+1,&batch);CHKERRQ(ierr);
+  for (i=0; i<nblocks; i++) count[bsizes[i]]++;
+  for (bs=1; bs<=jac->maxbs; bs++) {
+    batch[bs]    = jac->nbatch;
+    jac->nbatch += (count[bs]+W-1)/W;
+  }
+  ierr  = PetscMalloc4(jac->nbatch,&jac->bsize,jac->nbatch,&jac->nlanes,W*jac->nbatch,&jac->start,jac->nbatch,&jac->offset);CHKERRQ(ierr);
+  ndiag = 0;
+  for (bs=1; bs<=jac->maxbs; bs++) {
+    for (b=batch[bs]; b<batch[bs]+(count[bs]+W-1)/W; b++) {
+      jac->bsize[b]  = bs;
+      jac->nlanes[b] = PetscMin(W,count[bs]-(b-batch[bs])*W);
+      jac->offset[b] = ndiag;
+      ndiag         += bs*bs*W;
+      for (l=jac->nlanes[b]; l<W; l++) jac->start[b*W+l] = -1;
+    }
+    count[bs] = 0;
+  }
+  for (i=0,row=0; i<nblocks; i++) {
+    bs = bsizes[i];
+    b  = batch[bs] + count[bs]/W;
+    jac->start[b*W+count[bs]%W] = row;
+    count[bs]++;
+    row += bs;
+  }
+  if (row != m) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_SIZ,"Sum of block sizes %D does not equal the number of local rows %D",row,m);
+  ierr = PetscFree2(count,batch);CHKERRQ(ierr);
+  ierr = PetscFree(ubsizes);CHKERRQ(ierr);
+
+  /* extract the diagonal blocks into the interleaved storage and invert them a batch at a time, padding lanes get the identity */
+  ierr = PetscMalloc3(ndiag,&jac->diag,W*jac->maxbs,&jac->work,W*jac->maxbs,&jac->pivots);CHKERRQ(ierr);
+  ierr = PetscLogObjectMemory((PetscObject)pc,ndiag*sizeof(PetscScalar));CHKERRQ(ierr);
+  ierr = PetscMalloc2(jac->maxbs*jac->maxbs,&blk,jac->maxbs,&rows);CHKERRQ(ierr);
+  for (b=0; b<jac->nbatch; b++) {
+    bs = jac->bsize[b];
+    a  = jac->diag + jac->offset[b];
+    for (l=0; l<W; l++) {
+      if (l < jac->nlanes[b]) {
+        for (k=0; k<bs; k++) rows[k] = rstart + jac->start[b*W+l] + k;
+        ierr = MatGetValues(A,bs,rows,bs,rows,blk);CHKERRQ(ierr);
+        for (k=0; k<bs*bs; k++) a[k*W+l] = blk[k];
+      } else {
+        for (k=0; k<bs; k++) {
+          for (j=0; j<bs; j++) a[(k*bs+j)*W+l] = (k == j) ? 1.0 : 0.0;
+        }
+      }
+    }
+    ierr = PCVPBJacobiInvertBatch_Private(bs,a,jac->pivots,jac->start+b*W);CHKERRQ(ierr);
+    invflops        += (PetscLogDouble)bs*bs*bs*jac->nlanes[b];
+    jac->applyflops += (2.0*bs*bs-bs)*jac->nlanes[b];
+  }
+  ierr = PetscFree2(blk,rows);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*invflops);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PCDestroy_VPBJacobi"
+static PetscErrorCode PCDestroy_VPBJacobi(PC pc)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PCReset_VPBJacobi(pc);CHKERRQ(ierr);
+  ierr = PetscFree(pc->data);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PCView_VPBJacobi"
+static PetscErrorCode PCView_VPBJacobi(PC pc,PetscViewer viewer)
+{
+  PC_VPBJacobi   *jac = (PC_VPBJacobi*)pc->data;
+  PetscErrorCode ierr;
+  PetscBool      iascii;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (iascii) {
+    ierr = PetscViewerASCIIPrintf(viewer,"  variable point-block Jacobi: batches of %D blocks\n",(PetscInt)PC_VPBJACOBI_LANES);CHKERRQ(ierr);
+    ierr = PetscViewerASCIISynchronizedAllow(viewer,PETSC_TRUE);CHKERRQ(ierr);
+    ierr = PetscViewerASCIISynchronizedPrintf(viewer,"  [%d] %D blocks of sizes %D to %D in %D batches\n",PetscGlobalRank,jac->nblocks,jac->minbs,jac->maxbs,jac->nbatch);CHKERRQ(ierr);
+    ierr = PetscViewerFlush(viewer);CHKERRQ(ierr);
+    ierr = PetscViewerASCIISynchronizedAllow(viewer,PETSC_FALSE);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/* -------------------------------------------------------------------------- */
+/*MC
+     PCVPBJACOBI - Variable size point block Jacobi preconditioner
+
+   Notes: The sizes of the diagonal blocks are given with MatSetVariableBlockSizes(), without them the block size of
+   the matrix is used. A block may be larger than the block size of the matrix; it must be owned by one process.
+
+   The blocks of the same size are inverted and applied in batches, with the entries of the blocks of a batch
+   interleaved so the loops vectorize across the blocks. This is most effective for many small blocks.
+
+   Uses Gauss-Jordan elimination with partial pivoting to invert the blocks; if a zero pivot
+   is detected a PETSc error is generated.
+
+   Level: beginner
+
+  Concepts: variable point block Jacobi
+
+.seealso:  PCCreate(), PCSetType(), PCType (for list of available types), PC, PCJACOBI, PCPBJACOBI, MatSetVariableBlockSizes()
+
+M*/
+
+#undef __FUNCT__
+#define __FUNCT__ "PCCreate_VPBJacobi"
+PETSC_EXTERN PetscErrorCode PCCreate_VPBJacobi(PC pc)
+{
+  PC_VPBJacobi   *jac;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr     = PetscNewLog(pc,&jac);CHKERRQ(ierr);
+  pc->data = (void*)jac;
+
+  pc->ops->apply               = PCApply_VPBJacobi;
+  pc->ops->applytranspose      = 0;
+  pc->ops->setup               = PCSetUp_VPBJacobi;
+  pc->ops->reset               = PCReset_VPBJacobi;
+  pc->ops->destroy             = PCDestroy_VPBJacobi;
+  pc->ops->setfromoptions      = 0;
+  pc->ops->view                = PCView_VPBJacobi;
+  pc->ops->applyrichardson     = 0;
+  pc->ops->applysymmetricleft  = 0;
+  pc->ops->applysymmetricright = 0;
+  PetscFunctionReturn(0);
+}
@@ -0,0 +1,268 @@
+#include <petsc/private/matimpl.h>    /*I "petscmat.h" I*/
+#include <../src/mat/impls/aij/seq/aij.h>
+#include <../src/mat/impls/aij/mpi/mpiaij.h>
+#include <petscsf.h>
+
+/* the values of the vertices in the set, out of the set and without neighbors, the priorities are in between */
+#define MIS2_IN      PETSC_MAX_INT
+#define MIS2_OUT     -1
+#define MIS2_REMOVED -2
+
+/*
+   A fixed pseudo-random permutation of 0..N-1 used as the priority of the vertices, so there are no ties and the
+   independent set does not depend on the number of processes. 2654435761 is a prime larger than N.
+*/
+PETSC_STATIC_INLINE PetscInt MIS2Priority(PetscInt gid,PetscInt N)
+{
+  if (N < 2147483647) return (PetscInt)(((Petsc64bitInt)gid*2654435761LL) % N);
+  return gid;
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MIS2NeighborMax_Private"
+/*
+   MIS2NeighborMax_Private - out[i] = max of v[] over row i of the graph and i itself, v[] holds the values of the local
+   vertices followed by those of the ghost vertices, which are first brought up to date from their owners
+*/
+static PetscErrorCode MIS2NeighborMax_Private(PetscSF sf,Mat_SeqAIJ *matA,Mat_SeqAIJ *matB,PetscInt nloc,PetscInt v[],PetscInt out[])
+{
+  PetscInt       i,k,m;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (sf) {
+    ierr = PetscSFBcastBegin(sf,MPIU_INT,v,v+nloc);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sf,MPIU_INT,v,v+nloc);CHKERRQ(ierr);
+  }
+  for (i=0; i<nloc; i++) {
+    m = v[i];
+    for (k=matA->i[i]; k<matA->i[i+1]; k++) m = PetscMax(m,v[matA->j[k]]);
+    if (matB) for (k=matB->i[i]; k<matB->i[i+1]; k++) m = PetscMax(m,v[nloc+matB->j[k]]);
+    out[i] = m;
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatCoarsenMIS2Agg_Private"
+/*
+   MatCoarsenMIS2Agg_Private - aggregation with a distance-2 maximal independent set of the graph, computed on the
+   distributed graph with neighbor exchanges instead of forming the square of the graph.
+
+   The independent set is found by rounds in the style of Luby: an undecided vertex joins the set when its priority is
+   the largest among the undecided vertices within distance 2, and leaves it when a vertex of the set is within
+   distance 2, each round takes two exchanges of the values of the ghost vertices. Then every vertex joins the
+   aggregate of an adjacent root, and after that the aggregate of an adjacent vertex, so the aggregates are those of
+   the squared graph. A vertex joins the aggregate of a neighbor only when the neighbor or the vertex is owned by the
+   process of the root, so the process of a root has all the vertices of its aggregate as local or ghost vertices of
+   the graph. The few vertices left at the process boundaries are aggregated greedily with their local neighbors, or
+   join the aggregate of a local neighbor with a local root, so only the vertices without neighbors are left out.
+
+   Input Parameter:
+   . perm - serial permutation of the local vertices for the greedy aggregation of the vertices left over
+   . Gmat - global matrix of the graph, MATSEQAIJ or MATMPIAIJ with a symmetric nonzero pattern
+
+   Output Parameter:
+   . a_locals_llist - the aggregates as lists of global indices at their local roots
+*/
+static PetscErrorCode MatCoarsenMIS2Agg_Private(IS perm,Mat Gmat,PetscCoarsenData **a_locals_llist)
+{
+  Mat_SeqAIJ       *matA,*matB = NULL;
+  Mat_MPIAIJ       *mpimat = NULL;
+  MPI_Comm         comm;
+  PetscSF          sf = NULL;
+  PetscLayout      layout;
+  PetscCoarsenData *agg_lists;
+  const PetscInt   nloc = Gmat->rmap->n,*perm_ix,*garray = NULL;
+  PetscInt         N,my0,Iend,nghost = 0,i,k,lid,gid,nundone,gundone,iter = 0,nselected = 0,nremoved = 0,nleft = 0;
+  PetscInt         *val,*parent,*m1,*m2;
+  PetscBool        isMPI;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)Gmat,&comm);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)Gmat,MATMPIAIJ,&isMPI);CHKERRQ(ierr);
+  if (isMPI) {
+    mpimat = (Mat_MPIAIJ*)Gmat->data;
+    matA   = (Mat_SeqAIJ*)mpimat->A->data;
+    matB   = (Mat_SeqAIJ*)mpimat->B->data;
+    garray = mpimat->garray;
+    ierr   = VecGetLocalSize(mpimat->lvec,&nghost);CHKERRQ(ierr);
+    ierr   = PetscSFCreate(comm,&sf);CHKERRQ(ierr);
+    ierr   = MatGetLayouts(Gmat,&layout,NULL);CHKERRQ(ierr);
+    ierr   = PetscSFSetGraphLayout(sf,layout,nghost,NULL,PETSC_COPY_VALUES,mpimat->garray);CHKERRQ(ierr);
+  } else {
+    PetscBool isAIJ;
+    ierr = PetscObjectTypeCompare((PetscObject)Gmat,MATSEQAIJ,&isAIJ);CHKERRQ(ierr);
+    if (!isAIJ) SETERRQ1(comm,PETSC_ERR_SUP,"MIS-2 coarsening requires an AIJ graph, not %s",((PetscObject)Gmat)->type_name);
+    matA = (Mat_SeqAIJ*)Gmat->data;
+  }
+  ierr = MatGetOwnershipRange(Gmat,&my0,&Iend);CHKERRQ(ierr);
+  ierr = MatGetSize(Gmat,&N,NULL);CHKERRQ(ierr);
+  ierr = PetscMalloc4(nloc+nghost,&val,nloc+nghost,&parent,nloc+nghost,&m1,nloc,&m2);CHKERRQ(ierr);
+
+  /* the vertices without neighbors are out from the start */
+  for (i=0,nundone=0; i<nloc; i++) {
+    PetscInt nnbr = (matB ? matB->i[i+1] - matB->i[i] : 0);
+    for (k=matA->i[i]; k<matA->i[i+1]; k++) if (matA->j[k] != i) nnbr++;
+    if (nnbr) {val[i] = MIS2Priority(my0+i,N); nundone++;}
+    else      val[i] = MIS2_REMOVED;
+  }
+
+  /* the distance-2 maximal independent set */
+  ierr = MPI_Allreduce(&nundone,&gundone,1,MPIU_INT,MPI_SUM,comm);CHKERRQ(ierr);
+  while (gundone) {
+    iter++;
+    ierr = MIS2NeighborMax_Private(sf,matA,matB,nloc,val,m1);CHKERRQ(ierr);
+    ierr = MIS2NeighborMax_Private(sf,matA,matB,nloc,m1,m2);CHKERRQ(ierr);
+    for (i=0,nundone=0; i<nloc; i++) {
+      if (val[i] == MIS2_IN || val[i] < 0) continue;
+      if (m2[i] == MIS2_IN)     val[i] = MIS2_OUT;
+      else if (m2[i] == val[i]) {val[i] = MIS2_IN; nselected++;}
+      else nundone++;
+    }
+    ierr = MPI_Allreduce(&nundone,&gundone,1,MPIU_INT,MPI_SUM,comm);CHKERRQ(ierr);
+  }
+
+  /* the roots of the aggregates, then the vertices adjacent to a root, which pass on their root if it is local */
+  for (i=0; i<nloc; i++) m1[i] = (val[i] == MIS2_IN) ? my0+i : -1;
+  ierr = MIS2NeighborMax_Private(sf,matA,matB,nloc,m1,parent);CHKERRQ(ierr);
+  for (i=0; i<nloc; i++) m1[i] = (parent[i] >= my0 && parent[i] < Iend) ? parent[i] : -1;
+  ierr = MIS2NeighborMax_Private(sf,matA,matB,nloc,m1,m2);CHKERRQ(ierr);
+  for (i=0; i<nloc; i++) if (parent[i] == -1) parent[i] = m2[i];
+
+  /* a vertex next to the process boundary can also join the aggregate of a ghost neighbor when the root is local */
+  if (sf) {
+    ierr = PetscSFBcastBegin(sf,MPIU_INT,parent,parent+nloc);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sf,MPIU_INT,parent,parent+nloc);CHKERRQ(ierr);
+    for (i=0; i<nloc; i++) {
+      if (parent[i] != -1) continue;
+      for (k=matB->i[i]; k<matB->i[i+1]; k++) {
+        gid = parent[nloc+matB->j[k]];
+        if (gid >= my0 && gid < Iend) parent[i] = PetscMax(parent[i],gid);
+      }
+    }
+  }
+
+  /* the vertices left over are aggregated greedily with their local neighbors left over, a vertex without any joins
+     the aggregate of a local neighbor with a local root, and makes an aggregate of one vertex only if there is none */
+  ierr = ISGetIndices(perm,&perm_ix);CHKERRQ(ierr);
+  for (k=0; k<nloc; k++) {
+    PetscInt nagg = 0;
+    lid = perm_ix[k];
+    if (parent[lid] != -1 || val[lid] == MIS2_REMOVED) continue;
+    for (i=matA->i[lid]; i<matA->i[lid+1]; i++) {
+      if (matA->j[i] != lid && parent[matA->j[i]] == -1) {parent[matA->j[i]] = my0+lid; nagg++;}
+    }
+    if (!nagg) {
+      for (i=matA->i[lid]; i<matA->i[lid+1]; i++) {
+        gid = parent[matA->j[i]];
+        if (matA->j[i] != lid && gid >= my0 && gid < Iend) {parent[lid] = gid; break;}
+      }
+    }
+    if (parent[lid] == -1) {parent[lid] = my0+lid; nleft++;}
+  }
+  ierr = ISRestoreIndices(perm,&perm_ix);CHKERRQ(ierr);
+  for (i=0,nremoved=0; i<nloc; i++) if (parent[i] == -1) nremoved++;
+
+  /* the lists of the aggregates, the roots first and the ghost vertices of the local aggregates last */
+  ierr = PetscCDCreate(nloc,&agg_lists);CHKERRQ(ierr);
+  *a_locals_llist = agg_lists;
+  for (lid=0; lid<nloc; lid++) {
+    if (parent[lid] == my0+lid) {ierr = PetscCDAppendID(agg_lists,lid,my0+lid);CHKERRQ(ierr);}
+  }
+  for (lid=0; lid<nloc; lid++) {
+    gid = parent[lid];
+    if (gid != my0+lid && gid >= my0 && gid < Iend) {ierr = PetscCDAppendID(agg_lists,gid-my0,my0+lid);CHKERRQ(ierr);}
+  }
+  if (sf) {
+    ierr = PetscSFBcastBegin(sf,MPIU_INT,parent,parent+nloc);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sf,MPIU_INT,parent,parent+nloc);CHKERRQ(ierr);
+    for (k=0; k<nghost; k++) {
+      gid = parent[nloc+k];
+      if (gid >= my0 && gid < Iend) {ierr = PetscCDAppendID(agg_lists,gid-my0,garray[k]);CHKERRQ(ierr);}
+    }
+  }
+  ierr = PetscInfo5(Gmat,"\t %D rounds, removed %D of %D vertices, %D selected and %D aggregates of vertices left over\n",iter,nremoved,nloc,nselected,nleft);CHKERRQ(ierr);
+
+  ierr = PetscSFDestroy(&sf);CHKERRQ(ierr);
+  ierr = PetscFree4(val,parent,m1,m2);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatCoarsenApply_MIS2"
+static PetscErrorCode MatCoarsenApply_MIS2(MatCoarsen coarse)
+{
+  PetscErrorCode ierr;
+  Mat            mat = coarse->graph;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(coarse,MAT_COARSEN_CLASSID,1);
+  if (!coarse->strict_aggs) SETERRQ(PetscObjectComm((PetscObject)coarse),PETSC_ERR_SUP,"MIS-2 coarsening only makes strict aggregates");
+  if (!coarse->perm) {
+    IS       perm;
+    PetscInt n,m;
+
+    ierr = MatGetLocalSize(mat,&m,&n);CHKERRQ(ierr);
+    ierr = ISCreateStride(PETSC_COMM_SELF,m,0,1,&perm);CHKERRQ(ierr);
+    ierr = MatCoarsenMIS2Agg_Private(perm,mat,&coarse->agg_lists);CHKERRQ(ierr);
+    ierr = ISDestroy(&perm);CHKERRQ(ierr);
+  } else {
+    ierr = MatCoarsenMIS2Agg_Private(coarse->perm,mat,&coarse->agg_lists);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatCoarsenView_MIS2"
+static PetscErrorCode MatCoarsenView_MIS2(MatCoarsen coarse,PetscViewer viewer)
+{
+  PetscErrorCode ierr;
+  PetscBool      iascii;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(coarse,MAT_COARSEN_CLASSID,1);
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (iascii) {
+    ierr = PetscViewerASCIIPrintf(viewer,"  MIS-2 aggregator\n");CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*MC
+   MATCOARSENMIS2 - Aggregates with a distance-2 maximal independent set of the graph, which gives the aggregates of
+   the squared graph without forming it.
+
+   Collective on MPI_Comm
+
+   Input Parameter:
+.  coarse - the coarsen context
+
+   Notes:
+   The independent set is computed on the distributed graph with exchanges of the values of the ghost vertices, two
+   for each round. The vertices are ordered by a fixed pseudo-random permutation of their global indices, so the
+   independent set does not depend on the number of processes. The greedy ordering is only used for the few vertices
+   at the process boundaries that cannot join an aggregate of another process.
+
+   The graph must be MATSEQAIJ or MATMPIAIJ with a symmetric nonzero pattern and only strict aggregates are made.
+
+   With PCGAMG the option -mat_coarsen_type mis2 replaces the squaring of the graph, -pc_gamg_square_graph, on all levels.
+
+   Level: beginner
+
+.keywords: Coarsen, create, context
+
+.seealso: MatCoarsenSetType(), MatCoarsenType, MATCOARSENMIS, PCGAMGSetSquareGraph()
+
+M*/
+
+#undef __FUNCT__
+#define __FUNCT__ "MatCoarsenCreate_MIS2"
+PETSC_EXTERN PetscErrorCode MatCoarsenCreate_MIS2(MatCoarsen coarse)
+{
+  PetscFunctionBegin;
+  coarse->ops->apply = MatCoarsenApply_MIS2;
+  coarse->ops->view  = MatCoarsenView_MIS2;
+  PetscFunctionReturn(0);
+}
@@ -0,0 +1,129 @@
+static char help[] = "Tests MatSOR() with the rows ordered by color, -mat_sor_multicolor.\n\n";
+
+/*
+Use the options
+     -n <n>          - the grid is n by n
+     -omega <omega>  - the relaxation factor
+     -nonsymmetric   - add couplings in only one direction, so the nonzero structure is not symmetric
+     -sor_mat_view   - view the matrix after the sweeps, with ::ascii_info for the number of colors
+*/
+
+#include <petscmat.h>
+
+#undef __FUNCT__
+#define __FUNCT__ "main"
+int main(int argc,char **argv)
+{
+  Mat            A;
+  Vec            x,b,y,z,u;
+  PetscRandom    rnd;
+  PetscInt       n = 12,i,j,row,rstart,rend,its;
+  PetscReal      omega = 1.0,nrm,err,rnorm0;
+  PetscScalar    v,uz,zu;
+  PetscBool      nonsymmetric = PETSC_FALSE;
+  PetscMPIInt    size;
+  PetscErrorCode ierr;
+
+  PetscInitialize(&argc,&argv,(char*)0,help);
+  ierr = MPI_Comm_size(PETSC_COMM_WORLD,&size);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetReal(NULL,"-omega",&omega,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,"-nonsymmetric",&nonsymmetric,NULL);CHKERRQ(ierr);
+
+  /* The five point Laplacian, with an optional coupling to the point two to the left */
+  ierr = MatCreate(PETSC_COMM_WORLD,&A);CHKERRQ(ierr);
+  ierr = MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,n*n,n*n);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(A);CHKERRQ(ierr);
+  ierr = MatSeqAIJSetPreallocation(A,6,NULL);CHKERRQ(ierr);
+  ierr = MatMPIAIJSetPreallocation(A,6,NULL,6,NULL);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(A,&rstart,&rend);CHKERRQ(ierr);
+  for (row=rstart; row<rend; row++) {
+    i = row % n; j = row / n;
+    v = nonsymmetric ? 4.5 : 4.0;
+    ierr = MatSetValues(A,1,&row,1,&row,&v,INSERT_VALUES);CHKERRQ(ierr);
+    v = -1.0;
+    if (i > 0)   {ierr = MatSetValue(A,row,row-1,v,INSERT_VALUES);CHKERRQ(ierr);}
+    if (i < n-1) {ierr = MatSetValue(A,row,row+1,v,INSERT_VALUES);CHKERRQ(ierr);}
+    if (j > 0)   {ierr = MatSetValue(A,row,row-n,v,INSERT_VALUES);CHKERRQ(ierr);}
+    if (j < n-1) {ierr = MatSetValue(A,row,row+n,v,INSERT_VALUES);CHKERRQ(ierr);}
+    if (nonsymmetric && i > 1) {ierr = MatSetValue(A,row,row-2,-0.5,INSERT_VALUES);CHKERRQ(ierr);}
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+
+  ierr = MatCreateVecs(A,&x,&b);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&y);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&z);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&u);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rnd);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rnd);CHKERRQ(ierr);
+
+  /* The exact solution is not changed by the sweeps */
+  ierr = VecSetRandom(x,rnd);CHKERRQ(ierr);
+  ierr = MatMult(A,x,b);CHKERRQ(ierr);
+  ierr = VecCopy(x,y);CHKERRQ(ierr);
+  ierr = MatSOR(A,b,omega,SOR_LOCAL_SYMMETRIC_SWEEP,0.0,2,1,y);CHKERRQ(ierr);
+  ierr = VecNorm(x,NORM_2,&nrm);CHKERRQ(ierr);
+  ierr = VecAXPY(y,-1.0,x);CHKERRQ(ierr);
+  ierr = VecNorm(y,NORM_2,&err);CHKERRQ(ierr);
+  if (err > 1.e-12*nrm) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Sweeps change the exact solution by %g\n",(double)(err/nrm));CHKERRQ(ierr);}
+  else                  {ierr = PetscPrintf(PETSC_COMM_WORLD,"The exact solution is a fixed point of the sweeps\n");CHKERRQ(ierr);}
+
+  /* New values with the same nonzero structure are used by the following sweeps */
+  ierr = MatShift(A,1.0);CHKERRQ(ierr);
+  ierr = MatMult(A,x,b);CHKERRQ(ierr);
+  ierr = VecCopy(x,y);CHKERRQ(ierr);
+  ierr = MatSOR(A,b,omega,SOR_LOCAL_SYMMETRIC_SWEEP,0.0,1,1,y);CHKERRQ(ierr);
+  ierr = VecAXPY(y,-1.0,x);CHKERRQ(ierr);
+  ierr = VecNorm(y,NORM_2,&err);CHKERRQ(ierr);
+  if (err > 1.e-12*nrm) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Sweeps change the exact solution of the shifted matrix by %g\n",(double)(err/nrm));CHKERRQ(ierr);}
+  else                  {ierr = PetscPrintf(PETSC_COMM_WORLD,"The exact solution of the shifted matrix is a fixed point of the sweeps\n");CHKERRQ(ierr);}
+
+  /* A forward sweep followed by a backward sweep is a symmetric sweep; in parallel the second sweep would use new ghost values */
+  if (size == 1) {
+    ierr = MatSOR(A,b,omega,(MatSORType)(SOR_FORWARD_SWEEP | SOR_ZERO_INITIAL_GUESS),0.0,1,1,y);CHKERRQ(ierr);
+    ierr = MatSOR(A,b,omega,SOR_BACKWARD_SWEEP,0.0,1,1,y);CHKERRQ(ierr);
+    ierr = MatSOR(A,b,omega,(MatSORType)(SOR_SYMMETRIC_SWEEP | SOR_ZERO_INITIAL_GUESS),0.0,1,1,z);CHKERRQ(ierr);
+    ierr = VecNorm(z,NORM_2,&nrm);CHKERRQ(ierr);
+    ierr = VecAXPY(y,-1.0,z);CHKERRQ(ierr);
+    ierr = VecNorm(y,NORM_2,&err);CHKERRQ(ierr);
+    if (err > 1.e-12*nrm) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Forward and backward sweeps differ from the symmetric sweep by %g\n",(double)(err/nrm));CHKERRQ(ierr);}
+    else                  {ierr = PetscPrintf(PETSC_COMM_WORLD,"Forward and backward sweeps agree with the symmetric sweep\n");CHKERRQ(ierr);}
+  }
+
+  /* With a symmetric matrix the symmetric sweep from a zero initial guess is a symmetric operator */
+  if (!nonsymmetric) {
+    ierr = VecSetRandom(y,rnd);CHKERRQ(ierr);
+    ierr = VecSetRandom(z,rnd);CHKERRQ(ierr);
+    ierr = MatSOR(A,y,omega,(MatSORType)(SOR_LOCAL_SYMMETRIC_SWEEP | SOR_ZERO_INITIAL_GUESS),0.0,1,1,u);CHKERRQ(ierr);
+    ierr = VecDot(z,u,&zu);CHKERRQ(ierr);
+    ierr = MatSOR(A,z,omega,(MatSORType)(SOR_LOCAL_SYMMETRIC_SWEEP | SOR_ZERO_INITIAL_GUESS),0.0,1,1,u);CHKERRQ(ierr);
+    ierr = VecDot(y,u,&uz);CHKERRQ(ierr);
+    if (PetscAbsScalar(zu-uz) > 1.e-12*PetscAbsScalar(zu)) {ierr = PetscPrintf(PETSC_COMM_WORLD,"The symmetric sweep is not symmetric, %g\n",(double)PetscAbsScalar(zu-uz));CHKERRQ(ierr);}
+    else                                                     {ierr = PetscPrintf(PETSC_COMM_WORLD,"The symmetric sweep is a symmetric operator\n");CHKERRQ(ierr);}
+  }
+
+  /* Relaxation reduces the residual, though the multicolor ordering needs more sweeps than the natural ordering */
+  ierr = VecSet(y,0.0);CHKERRQ(ierr);
+  ierr = VecNorm(b,NORM_2,&rnorm0);CHKERRQ(ierr);
+  for (its=0; its<200; its++) {
+    ierr = MatSOR(A,b,omega,SOR_LOCAL_SYMMETRIC_SWEEP,0.0,1,1,y);CHKERRQ(ierr);
+    ierr = MatMult(A,y,z);CHKERRQ(ierr);
+    ierr = VecAYPX(z,-1.0,b);CHKERRQ(ierr);
+    ierr = VecNorm(z,NORM_2,&nrm);CHKERRQ(ierr);
+    if (nrm < 1.e-2*rnorm0) break;
+  }
+  if (its == 200) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Relaxation does not converge\n");CHKERRQ(ierr);}
+  else            {ierr = PetscPrintf(PETSC_COMM_WORLD,"Relaxation converges\n");CHKERRQ(ierr);}
+  ierr = MatViewFromOptions(A,NULL,"-sor_mat_view");CHKERRQ(ierr);
+
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&b);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&z);CHKERRQ(ierr);
+  ierr = VecDestroy(&u);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rnd);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return 0;
+}
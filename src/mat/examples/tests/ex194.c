@@ -0,0 +1,122 @@
+static char help[] = "Tests MatSolve() with the LU and ILU factors solved level by level, -mat_solve_levels.\n\n";
+
+/*
+Use the options
+     -n <n>                 - the grid is n by n
+     -dof <dof>             - number of coupled components at each grid point, so the factor has inodes when dof > 1
+     -lu                    - use a complete LU factorization instead of ILU
+     -levels <k>            - the levels of fill of the ILU factorization
+     -mat_ordering_type <t> - the ordering of the factorization
+*/
+
+#include <petscmat.h>
+
+#undef __FUNCT__
+#define __FUNCT__ "main"
+int main(int argc,char **argv)
+{
+  Mat             A,F[2];
+  Vec             x,b,y[2];
+  IS              isrow,iscol;
+  MatFactorInfo   info;
+  MatFactorType   ftype;
+  PetscRandom     rnd;
+  PetscInt        n = 32,dof = 1,levels = 0,i,j,c,d,k,row,col;
+  PetscReal       nrm,err;
+  PetscScalar     v;
+  PetscBool       lu = PETSC_FALSE;
+  char            ordering[256] = MATORDERINGNATURAL;
+  PetscErrorCode  ierr;
+
+  PetscInitialize(&argc,&argv,(char*)0,help);
+  ierr = PetscOptionsGetInt(NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,"-dof",&dof,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,"-levels",&levels,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,"-lu",&lu,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetString(NULL,"-mat_ordering_type",ordering,sizeof(ordering),NULL);CHKERRQ(ierr);
+
+  /* The five point Laplacian with an upwind advection term in x, and couplings between the components */
+  ierr = MatCreateSeqAIJ(PETSC_COMM_SELF,n*n*dof,n*n*dof,5*dof,NULL,&A);CHKERRQ(ierr);
+  for (j=0; j<n; j++) {
+    for (i=0; i<n; i++) {
+      for (c=0; c<dof; c++) {
+        row = (j*n+i)*dof + c;
+        for (d=0; d<dof; d++) {
+          v = (c == d) ? 4.5 : -0.2;
+          col = (j*n+i)*dof + d;
+          ierr = MatSetValues(A,1,&row,1,&col,&v,INSERT_VALUES);CHKERRQ(ierr);
+          if (c != d) continue;
+          v = -1.5;
+          if (i > 0)   {col = row-dof;   ierr = MatSetValues(A,1,&row,1,&col,&v,INSERT_VALUES);CHKERRQ(ierr);}
+          v = -1.0;
+          if (i < n-1) {col = row+dof;   ierr = MatSetValues(A,1,&row,1,&col,&v,INSERT_VALUES);CHKERRQ(ierr);}
+          if (j > 0)   {col = row-n*dof; ierr = MatSetValues(A,1,&row,1,&col,&v,INSERT_VALUES);CHKERRQ(ierr);}
+          if (j < n-1) {col = row+n*dof; ierr = MatSetValues(A,1,&row,1,&col,&v,INSERT_VALUES);CHKERRQ(ierr);}
+        }
+      }
+    }
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+
+  ierr = MatCreateVecs(A,&x,&b);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&y[0]);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&y[1]);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_SELF,&rnd);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rnd);CHKERRQ(ierr);
+  ierr = VecSetRandom(b,rnd);CHKERRQ(ierr);
+
+  /* Factor twice, the second time solving level by level */
+  ierr  = MatGetOrdering(A,ordering,&isrow,&iscol);CHKERRQ(ierr);
+  ierr  = MatFactorInfoInitialize(&info);CHKERRQ(ierr);
+  info.levels = levels;
+  info.fill   = 5.0;
+  ftype       = lu ? MAT_FACTOR_LU : MAT_FACTOR_ILU;
+  for (k=0; k<2; k++) {
+    if (k) {ierr = PetscOptionsSetValue("-mat_solve_levels","1");CHKERRQ(ierr);}
+    ierr = MatGetFactor(A,MATSOLVERPETSC,ftype,&F[k]);CHKERRQ(ierr);
+    if (lu) {ierr = MatLUFactorSymbolic(F[k],A,isrow,iscol,&info);CHKERRQ(ierr);}
+    else    {ierr = MatILUFactorSymbolic(F[k],A,isrow,iscol,&info);CHKERRQ(ierr);}
+    ierr = MatLUFactorNumeric(F[k],A,&info);CHKERRQ(ierr);
+    ierr = MatSolve(F[k],b,y[k]);CHKERRQ(ierr);
+  }
+  ierr = VecNorm(y[0],NORM_2,&nrm);CHKERRQ(ierr);
+  ierr = VecAXPY(y[1],-1.0,y[0]);CHKERRQ(ierr);
+  ierr = VecNorm(y[1],NORM_2,&err);CHKERRQ(ierr);
+  if (err > 1.e-12*nrm) {ierr = PetscPrintf(PETSC_COMM_SELF,"Relative error in MatSolve() %g\n",(double)(err/nrm));CHKERRQ(ierr);}
+  else                  {ierr = PetscPrintf(PETSC_COMM_SELF,"MatSolve() level by level agrees\n");CHKERRQ(ierr);}
+
+  /* The levels are recomputed by a second numeric factorization with new values */
+  ierr = MatShift(A,1.0);CHKERRQ(ierr);
+  for (k=0; k<2; k++) {
+    ierr = MatLUFactorNumeric(F[k],A,&info);CHKERRQ(ierr);
+    ierr = MatSolve(F[k],b,y[k]);CHKERRQ(ierr);
+  }
+  ierr = VecNorm(y[0],NORM_2,&nrm);CHKERRQ(ierr);
+  ierr = VecAXPY(y[1],-1.0,y[0]);CHKERRQ(ierr);
+  ierr = VecNorm(y[1],NORM_2,&err);CHKERRQ(ierr);
+  if (err > 1.e-12*nrm) {ierr = PetscPrintf(PETSC_COMM_SELF,"Relative error in MatSolve() after refactoring %g\n",(double)(err/nrm));CHKERRQ(ierr);}
+  else                  {ierr = PetscPrintf(PETSC_COMM_SELF,"MatSolve() level by level agrees after refactoring\n");CHKERRQ(ierr);}
+
+  /* A complete factorization solves the system */
+  if (lu) {
+    ierr = MatMult(A,y[0],x);CHKERRQ(ierr);
+    ierr = VecAXPY(x,-1.0,b);CHKERRQ(ierr);
+    ierr = VecNorm(b,NORM_2,&nrm);CHKERRQ(ierr);
+    ierr = VecNorm(x,NORM_2,&err);CHKERRQ(ierr);
+    if (err > 1.e-10*nrm) {ierr = PetscPrintf(PETSC_COMM_SELF,"Relative residual of the LU solve %g\n",(double)(err/nrm));CHKERRQ(ierr);}
+  }
+
+  ierr = ISDestroy(&isrow);CHKERRQ(ierr);
+  ierr = ISDestroy(&iscol);CHKERRQ(ierr);
+  ierr = MatDestroy(&F[0]);CHKERRQ(ierr);
+  ierr = MatDestroy(&F[1]);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&b);CHKERRQ(ierr);
+  ierr = VecDestroy(&y[0]);CHKERRQ(ierr);
+  ierr = VecDestroy(&y[1]);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rnd);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return 0;
+}
@@ -0,0 +1,141 @@
+static char help[] = "Tests the fixed-point ILU factorization, -mat_factor_sweeps, and the Jacobi triangular solves, -mat_solve_sweeps.\n\n";
+
+/*
+Use the options
+     -n <n>                 - the grid is n by n
+     -dof <dof>             - number of coupled components at each grid point, so the factor has inodes when dof > 1
+     -levels <k>            - the levels of fill of the ILU factorization
+     -mat_ordering_type <t> - the ordering of the factorization
+*/
+
+#include <petscmat.h>
+
+#undef __FUNCT__
+#define __FUNCT__ "FactorCreate"
+/* Creates an ILU factor, the factor matrix reads the options set here */
+static PetscErrorCode FactorCreate(Mat A,IS isrow,IS iscol,const MatFactorInfo *info,const char fsweeps[],const char ssweeps[],Mat *F)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (fsweeps) {ierr = PetscOptionsSetValue("-mat_factor_sweeps",fsweeps);CHKERRQ(ierr);}
+  if (ssweeps) {ierr = PetscOptionsSetValue("-mat_solve_sweeps",ssweeps);CHKERRQ(ierr);}
+  ierr = MatGetFactor(A,MATSOLVERPETSC,MAT_FACTOR_ILU,F);CHKERRQ(ierr);
+  ierr = PetscOptionsClearValue("-mat_factor_sweeps");CHKERRQ(ierr);
+  ierr = PetscOptionsClearValue("-mat_solve_sweeps");CHKERRQ(ierr);
+  ierr = MatILUFactorSymbolic(*F,A,isrow,iscol,info);CHKERRQ(ierr);
+  ierr = MatLUFactorNumeric(*F,A,info);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "SolveError"
+/* The relative difference of the solves with F and with the reference factor F0 */
+static PetscErrorCode SolveError(Mat F0,Mat F,Vec b,Vec y0,Vec y,PetscReal *err)
+{
+  PetscReal      nrm;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSolve(F0,b,y0);CHKERRQ(ierr);
+  ierr = MatSolve(F,b,y);CHKERRQ(ierr);
+  ierr = VecNorm(y0,NORM_2,&nrm);CHKERRQ(ierr);
+  ierr = VecAXPY(y,-1.0,y0);CHKERRQ(ierr);
+  ierr = VecNorm(y,NORM_2,err);CHKERRQ(ierr);
+  *err /= nrm;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "main"
+int main(int argc,char **argv)
+{
+  Mat             A,F0,Fit,Fjac,Fwarm,Fcold;
+  Vec             b,y0,y;
+  IS              isrow,iscol;
+  MatFactorInfo   info;
+  PetscRandom     rnd;
+  PetscInt        n = 32,dof = 1,levels = 0,i,j,c,d,row,col;
+  PetscReal       err,errwarm,errcold;
+  PetscScalar     v;
+  char            ordering[256] = MATORDERINGNATURAL;
+  PetscErrorCode  ierr;
+
+  PetscInitialize(&argc,&argv,(char*)0,help);
+  ierr = PetscOptionsGetInt(NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,"-dof",&dof,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,"-levels",&levels,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetString(NULL,"-mat_ordering_type",ordering,sizeof(ordering),NULL);CHKERRQ(ierr);
+
+  /* The five point Laplacian with an upwind advection term in x, and couplings between the components */
+  ierr = MatCreateSeqAIJ(PETSC_COMM_SELF,n*n*dof,n*n*dof,5*dof,NULL,&A);CHKERRQ(ierr);
+  for (j=0; j<n; j++) {
+    for (i=0; i<n; i++) {
+      for (c=0; c<dof; c++) {
+        row = (j*n+i)*dof + c;
+        for (d=0; d<dof; d++) {
+          v = (c == d) ? 4.5 : -0.2;
+          col = (j*n+i)*dof + d;
+          ierr = MatSetValues(A,1,&row,1,&col,&v,INSERT_VALUES);CHKERRQ(ierr);
+          if (c != d) continue;
+          v = -1.5;
+          if (i > 0)   {col = row-dof;   ierr = MatSetValues(A,1,&row,1,&col,&v,INSERT_VALUES);CHKERRQ(ierr);}
+          v = -1.0;
+          if (i < n-1) {col = row+dof;   ierr = MatSetValues(A,1,&row,1,&col,&v,INSERT_VALUES);CHKERRQ(ierr);}
+          if (j > 0)   {col = row-n*dof; ierr = MatSetValues(A,1,&row,1,&col,&v,INSERT_VALUES);CHKERRQ(ierr);}
+          if (j < n-1) {col = row+n*dof; ierr = MatSetValues(A,1,&row,1,&col,&v,INSERT_VALUES);CHKERRQ(ierr);}
+        }
+      }
+    }
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+
+  ierr = MatCreateVecs(A,&y0,&b);CHKERRQ(ierr);
+  ierr = VecDuplicate(y0,&y);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_SELF,&rnd);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rnd);CHKERRQ(ierr);
+  ierr = VecSetRandom(b,rnd);CHKERRQ(ierr);
+
+  ierr = MatGetOrdering(A,ordering,&isrow,&iscol);CHKERRQ(ierr);
+  ierr = MatFactorInfoInitialize(&info);CHKERRQ(ierr);
+  info.levels = levels;
+  info.fill   = 5.0;
+  ierr = FactorCreate(A,isrow,iscol,&info,NULL,NULL,&F0);CHKERRQ(ierr);
+
+  /* Enough sweeps converge to the ILU factor; the Jacobi sweeps are exact after as many sweeps as levels of L and U */
+  ierr = FactorCreate(A,isrow,iscol,&info,"60",NULL,&Fit);CHKERRQ(ierr);
+  ierr = FactorCreate(A,isrow,iscol,&info,NULL,"500",&Fjac);CHKERRQ(ierr);
+  ierr = SolveError(F0,Fit,b,y0,y,&err);CHKERRQ(ierr);
+  if (err > 1.e-10) {ierr = PetscPrintf(PETSC_COMM_SELF,"Relative error of the iterative factorization %g\n",(double)err);CHKERRQ(ierr);}
+  else              {ierr = PetscPrintf(PETSC_COMM_SELF,"The iterative factorization converges to the ILU factor\n");CHKERRQ(ierr);}
+  ierr = SolveError(F0,Fjac,b,y0,y,&err);CHKERRQ(ierr);
+  if (err > 1.e-10) {ierr = PetscPrintf(PETSC_COMM_SELF,"Relative error of the Jacobi solves %g\n",(double)err);CHKERRQ(ierr);}
+  else              {ierr = PetscPrintf(PETSC_COMM_SELF,"The Jacobi sweeps converge to the triangular solves\n");CHKERRQ(ierr);}
+
+  /* After a small change of the values a few sweeps from the previous factor are better than from the matrix */
+  ierr = FactorCreate(A,isrow,iscol,&info,"3",NULL,&Fwarm);CHKERRQ(ierr);
+  ierr = MatShift(A,0.05);CHKERRQ(ierr);
+  ierr = MatLUFactorNumeric(F0,A,&info);CHKERRQ(ierr);
+  ierr = MatLUFactorNumeric(Fwarm,A,&info);CHKERRQ(ierr);
+  ierr = FactorCreate(A,isrow,iscol,&info,"3",NULL,&Fcold);CHKERRQ(ierr);
+  ierr = SolveError(F0,Fwarm,b,y0,y,&errwarm);CHKERRQ(ierr);
+  ierr = SolveError(F0,Fcold,b,y0,y,&errcold);CHKERRQ(ierr);
+  if (errwarm >= errcold) {ierr = PetscPrintf(PETSC_COMM_SELF,"Warm start error %g, cold start error %g\n",(double)errwarm,(double)errcold);CHKERRQ(ierr);}
+  else                    {ierr = PetscPrintf(PETSC_COMM_SELF,"Sweeps from the previous factor are closer to the ILU factor\n");CHKERRQ(ierr);}
+
+  ierr = ISDestroy(&isrow);CHKERRQ(ierr);
+  ierr = ISDestroy(&iscol);CHKERRQ(ierr);
+  ierr = MatDestroy(&F0);CHKERRQ(ierr);
+  ierr = MatDestroy(&Fit);CHKERRQ(ierr);
+  ierr = MatDestroy(&Fjac);CHKERRQ(ierr);
+  ierr = MatDestroy(&Fwarm);CHKERRQ(ierr);
+  ierr = MatDestroy(&Fcold);CHKERRQ(ierr);
+  ierr = VecDestroy(&b);CHKERRQ(ierr);
+  ierr = VecDestroy(&y0);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rnd);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return 0;
+}
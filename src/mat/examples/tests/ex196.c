@@ -0,0 +1,198 @@
+static char help[] = "Tests MatIncreaseOverlap() and MatGetSubMatrices() with MAT_REUSE_MATRIX for MPIAIJ matrices against the sequential results.\n\n";
+
+/*
+Use the options
+     -n <n>   - the grid is n by n
+     -nd <nd> - number of subdomains per process
+     -ov <ov> - amount of overlap between the subdomains
+*/
+
+#include <petscmat.h>
+#include <petsc/private/petscimpl.h> /* for PetscObjectGetId() */
+
+#undef __FUNCT__
+#define __FUNCT__ "AssembleOperator"
+/* Assembles the rows rstart to rend of a convection diffusion operator, the nonzero pattern does not depend on alpha */
+static PetscErrorCode AssembleOperator(Mat A,PetscInt n,PetscInt rstart,PetscInt rend,PetscReal alpha)
+{
+  PetscInt       row,col,i,j;
+  PetscScalar    v;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (row=rstart; row<rend; row++) {
+    i = row % n; j = row / n;
+    v = 4.0 + alpha*i;
+    ierr = MatSetValues(A,1,&row,1,&row,&v,INSERT_VALUES);CHKERRQ(ierr);
+    v = -1.0 - alpha;
+    if (i > 0)   {col = row-1; ierr = MatSetValues(A,1,&row,1,&col,&v,INSERT_VALUES);CHKERRQ(ierr);}
+    v = -1.0 + 0.5*alpha*j;
+    if (i < n-1) {col = row+1; ierr = MatSetValues(A,1,&row,1,&col,&v,INSERT_VALUES);CHKERRQ(ierr);}
+    v = -1.0;
+    if (j > 0)   {col = row-n; ierr = MatSetValues(A,1,&row,1,&col,&v,INSERT_VALUES);CHKERRQ(ierr);}
+    if (j < n-1) {col = row+n; ierr = MatSetValues(A,1,&row,1,&col,&v,INSERT_VALUES);CHKERRQ(ierr);}
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "CompareSubMatrices"
+/* Compares the parallel and sequential submatrices on all processes */
+static PetscErrorCode CompareSubMatrices(PetscInt nis,Mat *subA,Mat *subB,const char *name)
+{
+  PetscBool      flg,equal = PETSC_TRUE,tequal;
+  PetscInt       i;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  for (i=0; i<nis; i++) {
+    ierr  = MatEqual(subA[i],subB[i],&flg);CHKERRQ(ierr);
+    equal = (PetscBool)(equal && flg);
+  }
+  ierr = MPI_Allreduce(&equal,&tequal,1,MPIU_BOOL,MPI_LAND,PETSC_COMM_WORLD);CHKERRQ(ierr);
+  if (tequal) {ierr = PetscPrintf(PETSC_COMM_WORLD,"%s: the submatrices agree\n",name);CHKERRQ(ierr);}
+  else        {ierr = PetscPrintf(PETSC_COMM_WORLD,"%s: the submatrices differ\n",name);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "CheckReuse"
+/*
+   Checks on all processes whether the last MAT_REUSE_MATRIX extraction used the plan composed with the submatrices,
+   the plan is composed again whenever the extraction is done from scratch, so its id changes
+*/
+static PetscErrorCode CheckReuse(Mat sub,PetscObjectId *planid,const char *name)
+{
+  PetscObject    plan;
+  PetscObjectId  id = 0;
+  PetscBool      reused,treused,tredone;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr   = PetscObjectQuery((PetscObject)sub,"MatGetSubMatricesReuse_MPIAIJ",&plan);CHKERRQ(ierr);
+  if (plan) {ierr = PetscObjectGetId(plan,&id);CHKERRQ(ierr);}
+  reused = (PetscBool)(plan && id == *planid);
+  ierr   = MPI_Allreduce(&reused,&treused,1,MPIU_BOOL,MPI_LAND,PETSC_COMM_WORLD);CHKERRQ(ierr);
+  reused = (PetscBool)!reused;
+  ierr   = MPI_Allreduce(&reused,&tredone,1,MPIU_BOOL,MPI_LAND,PETSC_COMM_WORLD);CHKERRQ(ierr);
+  if (treused)      {ierr = PetscPrintf(PETSC_COMM_WORLD,"%s: the extraction was reused on all processes\n",name);CHKERRQ(ierr);}
+  else if (tredone) {ierr = PetscPrintf(PETSC_COMM_WORLD,"%s: the extraction was done again on all processes\n",name);CHKERRQ(ierr);}
+  else              {ierr = PetscPrintf(PETSC_COMM_WORLD,"%s: the extraction was reused on some processes only\n",name);CHKERRQ(ierr);}
+  *planid = id;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "main"
+int main(int argc,char **argv)
+{
+  Mat            A,B,*subA,*subB;
+  IS             *isA,*isB,*iscol,isnew;
+  PetscInt       n = 16,nd = 2,ov = 2,N,rstart,rend,start,i,nis,len;
+  PetscObjectId  planid = 0;
+  PetscMPIInt    rank;
+  PetscBool      flg,equal = PETSC_TRUE,tequal;
+  PetscErrorCode ierr;
+
+  PetscInitialize(&argc,&argv,(char*)0,help);
+  ierr = PetscOptionsGetInt(NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,"-nd",&nd,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,"-ov",&ov,NULL);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRQ(ierr);
+  N    = n*n;
+
+  ierr = MatCreateAIJ(PETSC_COMM_WORLD,PETSC_DECIDE,PETSC_DECIDE,N,N,5,NULL,5,NULL,&A);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(A,&rstart,&rend);CHKERRQ(ierr);
+  ierr = AssembleOperator(A,n,rstart,rend,0.0);CHKERRQ(ierr);
+  ierr = MatCreateSeqAIJ(PETSC_COMM_SELF,N,N,5,NULL,&B);CHKERRQ(ierr);
+  ierr = AssembleOperator(B,n,0,N,0.0);CHKERRQ(ierr);
+
+  /* The local rows split in nd subdomains, the last one is extracted again with all the columns */
+  nis  = nd+1;
+  ierr = PetscMalloc3(nis,&isA,nis,&isB,nis,&iscol);CHKERRQ(ierr);
+  for (i=0,start=rstart; i<nd; i++) {
+    len    = (rend-rstart)/nd + ((rend-rstart) % nd > i);
+    ierr   = ISCreateStride(PETSC_COMM_SELF,len,start,1,isA+i);CHKERRQ(ierr);
+    ierr   = ISCreateStride(PETSC_COMM_SELF,len,start,1,isB+i);CHKERRQ(ierr);
+    start += len;
+  }
+  ierr = MatIncreaseOverlap(A,nd,isA,ov);CHKERRQ(ierr);
+  ierr = MatIncreaseOverlap(B,nd,isB,ov);CHKERRQ(ierr);
+  for (i=0; i<nd; i++) {
+    ierr  = ISSort(isA[i]);CHKERRQ(ierr);
+    ierr  = ISSort(isB[i]);CHKERRQ(ierr);
+    ierr  = ISEqual(isA[i],isB[i],&flg);CHKERRQ(ierr);
+    equal = (PetscBool)(equal && flg);
+  }
+  ierr = MPI_Allreduce(&equal,&tequal,1,MPIU_BOOL,MPI_LAND,PETSC_COMM_WORLD);CHKERRQ(ierr);
+  if (tequal) {ierr = PetscPrintf(PETSC_COMM_WORLD,"The overlapping subdomains agree\n");CHKERRQ(ierr);}
+  else        {ierr = PetscPrintf(PETSC_COMM_WORLD,"The overlapping subdomains differ\n");CHKERRQ(ierr);}
+  ierr = PetscObjectReference((PetscObject)isA[nd-1]);CHKERRQ(ierr);
+  ierr = PetscObjectReference((PetscObject)isB[nd-1]);CHKERRQ(ierr);
+  isA[nd] = isA[nd-1];
+  isB[nd] = isB[nd-1];
+  for (i=0; i<nd; i++) {
+    ierr = PetscObjectReference((PetscObject)isA[i]);CHKERRQ(ierr);
+    iscol[i] = isA[i];
+  }
+  ierr = ISCreateStride(PETSC_COMM_SELF,N,0,1,iscol+nd);CHKERRQ(ierr);
+
+  ierr = MatGetSubMatrices(A,nis,isA,iscol,MAT_INITIAL_MATRIX,&subA);CHKERRQ(ierr);
+  ierr = MatGetSubMatrices(B,nis,isB,iscol,MAT_INITIAL_MATRIX,&subB);CHKERRQ(ierr);
+  ierr = CompareSubMatrices(nis,subA,subB,"First extraction");CHKERRQ(ierr);
+
+  /* New values in the same nonzero pattern, only the values are exchanged again */
+  ierr = AssembleOperator(A,n,rstart,rend,0.5);CHKERRQ(ierr);
+  ierr = AssembleOperator(B,n,0,N,0.5);CHKERRQ(ierr);
+  ierr = MatGetSubMatrices(A,nis,isA,iscol,MAT_REUSE_MATRIX,&subA);CHKERRQ(ierr);
+  ierr = MatGetSubMatrices(B,nis,isB,iscol,MAT_REUSE_MATRIX,&subB);CHKERRQ(ierr);
+  ierr = CompareSubMatrices(nis,subA,subB,"New values");CHKERRQ(ierr);
+  ierr = CheckReuse(subA[0],&planid,"New values");CHKERRQ(ierr);
+
+  /* A new index set with the same rows, the submatrices are extracted from scratch and then reused again */
+  ierr = ISDuplicate(isA[0],&isnew);CHKERRQ(ierr);
+  ierr = ISCopy(isA[0],isnew);CHKERRQ(ierr);
+  ierr = ISDestroy(&isA[0]);CHKERRQ(ierr);
+  isA[0] = isnew;
+  ierr = AssembleOperator(A,n,rstart,rend,2.0);CHKERRQ(ierr);
+  ierr = AssembleOperator(B,n,0,N,2.0);CHKERRQ(ierr);
+  ierr = MatGetSubMatrices(A,nis,isA,iscol,MAT_REUSE_MATRIX,&subA);CHKERRQ(ierr);
+  ierr = MatGetSubMatrices(B,nis,isB,iscol,MAT_REUSE_MATRIX,&subB);CHKERRQ(ierr);
+  ierr = CompareSubMatrices(nis,subA,subB,"New index set");CHKERRQ(ierr);
+  ierr = CheckReuse(subA[0],&planid,"New index set");CHKERRQ(ierr);
+  ierr = AssembleOperator(A,n,rstart,rend,1.0);CHKERRQ(ierr);
+  ierr = AssembleOperator(B,n,0,N,1.0);CHKERRQ(ierr);
+  ierr = MatGetSubMatrices(A,nis,isA,iscol,MAT_REUSE_MATRIX,&subA);CHKERRQ(ierr);
+  ierr = MatGetSubMatrices(B,nis,isB,iscol,MAT_REUSE_MATRIX,&subB);CHKERRQ(ierr);
+  ierr = CompareSubMatrices(nis,subA,subB,"New values again");CHKERRQ(ierr);
+  ierr = CheckReuse(subA[0],&planid,"New values again");CHKERRQ(ierr);
+
+  /* A new index set on the first process only, so the others have a valid plan but must extract from scratch too */
+  if (!rank) {
+    ierr = ISDuplicate(isA[0],&isnew);CHKERRQ(ierr);
+    ierr = ISCopy(isA[0],isnew);CHKERRQ(ierr);
+    ierr = ISDestroy(&isA[0]);CHKERRQ(ierr);
+    isA[0] = isnew;
+  }
+  ierr = AssembleOperator(A,n,rstart,rend,3.0);CHKERRQ(ierr);
+  ierr = AssembleOperator(B,n,0,N,3.0);CHKERRQ(ierr);
+  ierr = MatGetSubMatrices(A,nis,isA,iscol,MAT_REUSE_MATRIX,&subA);CHKERRQ(ierr);
+  ierr = MatGetSubMatrices(B,nis,isB,iscol,MAT_REUSE_MATRIX,&subB);CHKERRQ(ierr);
+  ierr = CompareSubMatrices(nis,subA,subB,"New index set on one process");CHKERRQ(ierr);
+  ierr = CheckReuse(subA[0],&planid,"New index set on one process");CHKERRQ(ierr);
+
+  ierr = MatDestroyMatrices(nis,&subA);CHKERRQ(ierr);
+  ierr = MatDestroyMatrices(nis,&subB);CHKERRQ(ierr);
+  for (i=0; i<nis; i++) {
+    ierr = ISDestroy(&isA[i]);CHKERRQ(ierr);
+    ierr = ISDestroy(&isB[i]);CHKERRQ(ierr);
+    ierr = ISDestroy(&iscol[i]);CHKERRQ(ierr);
+  }
+  ierr = PetscFree3(isA,isB,iscol);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return 0;
+}
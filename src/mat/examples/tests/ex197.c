@@ -0,0 +1,163 @@
+static char help[] = "Tests the distance-2 maximal independent set coarsener, -mat_coarsen_type mis2.\n\n";
+
+/*
+Use the options
+     -n <n>         - the graph is the 5 point stencil of an n by n grid
+     -isolated <k>  - every k-th vertex has no neighbors, 0 for none
+
+   The independent set does not depend on the number of processes, so the set found by the serial coarsening of the
+   whole graph on each process is checked for distance-2 independence and maximality, and compared with the roots of
+   the parallel coarsening, which must also aggregate every vertex with neighbors exactly once.
+*/
+
+#include <petscmat.h>
+#include <petsc/private/matimpl.h>
+
+#undef __FUNCT__
+#define __FUNCT__ "CreateGraph"
+/* The graph of the 5 point stencil with all entries 1, the isolated vertices have only their diagonal */
+static PetscErrorCode CreateGraph(MPI_Comm comm,PetscInt n,PetscInt isolated,Mat *G)
+{
+  PetscInt       N = n*n,row,col[5],ncols,i,j,k,rstart,rend;
+  PetscScalar    one[5] = {1.0,1.0,1.0,1.0,1.0};
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatCreate(comm,G);CHKERRQ(ierr);
+  ierr = MatSetSizes(*G,PETSC_DECIDE,PETSC_DECIDE,N,N);CHKERRQ(ierr);
+  ierr = MatSetType(*G,MATAIJ);CHKERRQ(ierr);
+  ierr = MatSeqAIJSetPreallocation(*G,5,NULL);CHKERRQ(ierr);
+  ierr = MatMPIAIJSetPreallocation(*G,5,NULL,4,NULL);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(*G,&rstart,&rend);CHKERRQ(ierr);
+  for (row=rstart; row<rend; row++) {
+    i = row/n; j = row%n; ncols = 0;
+    col[ncols++] = row;
+    if (!isolated || row%isolated) {
+      if (i > 0)   col[ncols++] = row-n;
+      if (i < n-1) col[ncols++] = row+n;
+      if (j > 0)   col[ncols++] = row-1;
+      if (j < n-1) col[ncols++] = row+1;
+      for (k=1; k<ncols; ) {
+        if (isolated && !(col[k]%isolated)) col[k] = col[--ncols];
+        else k++;
+      }
+    }
+    ierr = MatSetValues(*G,1,&row,ncols,col,one,INSERT_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(*G,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(*G,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "Coarsen"
+/* Sets roots[i] = 1 at the local roots and adds 1 to count[gid] for each vertex gid of their aggregates */
+static PetscErrorCode Coarsen(Mat G,Vec roots,Vec count)
+{
+  MatCoarsen       crs;
+  PetscCoarsenData *agg_lists;
+  PetscCDPos       pos;
+  PetscInt         rstart,rend,lid,gid;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  ierr = MatCoarsenCreate(PetscObjectComm((PetscObject)G),&crs);CHKERRQ(ierr);
+  ierr = MatCoarsenSetType(crs,MATCOARSENMIS2);CHKERRQ(ierr);
+  ierr = MatCoarsenSetAdjacency(crs,G);CHKERRQ(ierr);
+  ierr = MatCoarsenSetStrictAggs(crs,PETSC_TRUE);CHKERRQ(ierr);
+  ierr = MatCoarsenApply(crs);CHKERRQ(ierr);
+  ierr = MatCoarsenGetData(crs,&agg_lists);CHKERRQ(ierr);
+  ierr = MatCoarsenDestroy(&crs);CHKERRQ(ierr);
+
+  ierr = VecSet(roots,0.0);CHKERRQ(ierr);
+  ierr = VecSet(count,0.0);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(G,&rstart,&rend);CHKERRQ(ierr);
+  for (lid=0; lid<rend-rstart; lid++) {
+    ierr = PetscCDGetHeadPos(agg_lists,lid,&pos);CHKERRQ(ierr);
+    if (pos) {ierr = VecSetValue(roots,rstart+lid,1.0,INSERT_VALUES);CHKERRQ(ierr);}
+    while (pos) {
+      ierr = PetscLLNGetID(pos,&gid);CHKERRQ(ierr);
+      ierr = VecSetValue(count,gid,1.0,ADD_VALUES);CHKERRQ(ierr);
+      ierr = PetscCDGetNextPos(agg_lists,lid,&pos);CHKERRQ(ierr);
+    }
+  }
+  ierr = VecAssemblyBegin(roots);CHKERRQ(ierr);
+  ierr = VecAssemblyEnd(roots);CHKERRQ(ierr);
+  ierr = VecAssemblyBegin(count);CHKERRQ(ierr);
+  ierr = VecAssemblyEnd(count);CHKERRQ(ierr);
+  ierr = PetscCDDestroy(agg_lists);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "main"
+int main(int argc,char **argv)
+{
+  Mat               G,Gs;
+  Vec               roots,count,sroots,scount,y,z;
+  const PetscScalar *r,*sr,*c,*zz;
+  PetscInt          n = 20,isolated = 13,N,rstart,rend,row,nroots,naggregated = 0,nmissed = 0;
+  PetscScalar       sum;
+  PetscReal         ymax;
+  PetscErrorCode    ierr;
+
+  PetscInitialize(&argc,&argv,(char*)0,help);
+  ierr = PetscOptionsGetInt(NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,"-isolated",&isolated,NULL);CHKERRQ(ierr);
+  N    = n*n;
+
+  /* The serial set: no two roots have a common neighbor, or y = G roots would be larger than 1 somewhere, and every
+     vertex with neighbors is within distance 2 of a root, z = G y */
+  ierr = CreateGraph(PETSC_COMM_SELF,n,isolated,&Gs);CHKERRQ(ierr);
+  ierr = MatCreateVecs(Gs,&sroots,&y);CHKERRQ(ierr);
+  ierr = VecDuplicate(y,&z);CHKERRQ(ierr);
+  ierr = VecDuplicate(y,&scount);CHKERRQ(ierr);
+  ierr = Coarsen(Gs,sroots,scount);CHKERRQ(ierr);
+  ierr = MatMult(Gs,sroots,y);CHKERRQ(ierr);
+  ierr = VecMax(y,NULL,&ymax);CHKERRQ(ierr);
+  if (ymax > 1.0) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"The roots are not distance-2 independent");
+  ierr = MatMult(Gs,y,z);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(z,&zz);CHKERRQ(ierr);
+  for (row=0; row<N; row++) {
+    if ((!isolated || row%isolated) && zz[row] == 0.0) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Vertex %D is not within distance 2 of a root",row);
+  }
+  ierr = VecRestoreArrayRead(z,&zz);CHKERRQ(ierr);
+  ierr = VecSum(sroots,&sum);CHKERRQ(ierr);
+  nroots = (PetscInt)PetscRealPart(sum);
+
+  /* The parallel coarsening selects the same roots, and possibly a few more for the vertices left over at the
+     process boundaries, and aggregates every vertex with neighbors exactly once */
+  ierr = CreateGraph(PETSC_COMM_WORLD,n,isolated,&G);CHKERRQ(ierr);
+  ierr = MatCreateVecs(G,&roots,&count);CHKERRQ(ierr);
+  ierr = Coarsen(G,roots,count);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(G,&rstart,&rend);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(sroots,&sr);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(roots,&r);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(count,&c);CHKERRQ(ierr);
+  for (row=rstart; row<rend; row++) {
+    if (sr[row] == 1.0 && r[row-rstart] != 1.0) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Vertex %D is a root in serial but not in parallel",row);
+    if (isolated && !(row%isolated)) {
+      if (c[row-rstart] != 0.0) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Isolated vertex %D is aggregated",row);
+    } else if (c[row-rstart] == 1.0) naggregated++;
+    else nmissed++;
+  }
+  ierr = VecRestoreArrayRead(count,&c);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(roots,&r);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(sroots,&sr);CHKERRQ(ierr);
+  ierr = MPI_Allreduce(MPI_IN_PLACE,&naggregated,1,MPIU_INT,MPI_SUM,PETSC_COMM_WORLD);CHKERRQ(ierr);
+  ierr = MPI_Allreduce(MPI_IN_PLACE,&nmissed,1,MPIU_INT,MPI_SUM,PETSC_COMM_WORLD);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"Distance-2 independent set of %D roots, %D vertices aggregated once",nroots,naggregated);CHKERRQ(ierr);
+  if (nmissed) {ierr = PetscPrintf(PETSC_COMM_WORLD,", %D vertices not aggregated or aggregated twice",nmissed);CHKERRQ(ierr);}
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"\n");CHKERRQ(ierr);
+
+  ierr = VecDestroy(&roots);CHKERRQ(ierr);
+  ierr = VecDestroy(&count);CHKERRQ(ierr);
+  ierr = VecDestroy(&sroots);CHKERRQ(ierr);
+  ierr = VecDestroy(&scount);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&z);CHKERRQ(ierr);
+  ierr = MatDestroy(&G);CHKERRQ(ierr);
+  ierr = MatDestroy(&Gs);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return 0;
+}
@@ -5,14 +5,75 @@
 */
 #include <../src/mat/impls/aij/seq/aij.h>
 #include <../src/mat/impls/aij/mpi/mpiaij.h>
-#include <petscbt.h>
+#include <petscctable.h>
 
 static PetscErrorCode MatIncreaseOverlap_MPIAIJ_Once(Mat,PetscInt,IS*);
-static PetscErrorCode MatIncreaseOverlap_MPIAIJ_Local(Mat,PetscInt,char**,PetscInt*,PetscInt**);
+static PetscErrorCode MatIncreaseOverlap_MPIAIJ_Local(Mat,PetscInt,PetscTable*,PetscInt*,PetscInt*,PetscInt**);
 static PetscErrorCode MatIncreaseOverlap_MPIAIJ_Receive(Mat,PetscInt,PetscInt**,PetscInt**,PetscInt*);
 extern PetscErrorCode MatGetRow_MPIAIJ(Mat,PetscInt,PetscInt*,PetscInt**,PetscScalar**);
 extern PetscErrorCode MatRestoreRow_MPIAIJ(Mat,PetscInt,PetscInt*,PetscInt**,PetscScalar**);
 
+#undef __FUNCT__
+#define __FUNCT__ "MatGatherMessageLengths_MPIAIJ_Private"
+/*
+   Finds the processes sending messages to this process and the lengths of those messages, nrqs messages
+   of lengths w1[pa[i]] are sent to the processes pa[i].
+
+   Unlike PetscGatherNumberOfMessages() and PetscGatherMessageLengths() no array of the size of the
+   communicator is reduced, with PetscCommBuildTwoSided() only the processes exchanging messages communicate.
+*/
+static PetscErrorCode MatGatherMessageLengths_MPIAIJ_Private(MPI_Comm comm,PetscMPIInt nrqs,const PetscMPIInt pa[],const PetscMPIInt w1[],PetscMPIInt *nrqr,PetscMPIInt **onodes,PetscMPIInt **olengths)
+{
+  PetscErrorCode ierr;
+  PetscMPIInt    *lengths;
+  PetscInt       i,nfrom;
+
+  PetscFunctionBegin;
+  ierr = PetscMalloc1(nrqs+1,&lengths);CHKERRQ(ierr);
+  for (i=0; i<nrqs; i++) lengths[i] = w1[pa[i]];
+  ierr = PetscCommBuildTwoSided(comm,1,MPI_INT,nrqs,pa,lengths,&nfrom,onodes,olengths);CHKERRQ(ierr);
+  ierr = PetscMPIIntCast(nfrom,nrqr);CHKERRQ(ierr);
+  ierr = PetscFree(lengths);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatIncreaseOverlap_MPIAIJ_Grow_Private"
+/* Makes room for at least need entries in the array data of length *dmax, keeping its first isz entries */
+static PetscErrorCode MatIncreaseOverlap_MPIAIJ_Grow_Private(PetscInt need,PetscInt isz,PetscInt *dmax,PetscInt **data)
+{
+  PetscErrorCode ierr;
+  PetscInt       *tmp;
+
+  PetscFunctionBegin;
+  if (need <= *dmax) PetscFunctionReturn(0);
+  need = PetscMax(need,(PetscInt)(1.5*(*dmax))+1);
+  ierr = PetscMalloc1(need,&tmp);CHKERRQ(ierr);
+  ierr = PetscMemcpy(tmp,*data,isz*sizeof(PetscInt));CHKERRQ(ierr);
+  ierr = PetscFree(*data);CHKERRQ(ierr);
+  *data = tmp;
+  *dmax = need;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatIncreaseOverlap_MPIAIJ_LookupSet_Private"
+/*
+   Like PetscBTLookupSet(), for the rows of an index set kept in a PetscTable, whose size follows the number of rows
+   in the set instead of the global number of rows. PetscTableAddCount() only inserts new keys, so the row was
+   already there if the count did not change. The keys are shifted by one since the table does not take zero.
+*/
+PETSC_STATIC_INLINE PetscErrorCode MatIncreaseOverlap_MPIAIJ_LookupSet_Private(PetscTable table,PetscInt row,PetscBool *found)
+{
+  PetscInt       count = table->count;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr   = PetscTableAddCount(table,row+1);CHKERRQ(ierr);
+  *found = (table->count == count) ? PETSC_TRUE : PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "MatIncreaseOverlap_MPIAIJ"
 PetscErrorCode MatIncreaseOverlap_MPIAIJ(Mat C,PetscInt imax,IS is[],PetscInt ov)
@@ -61,13 +122,14 @@ static PetscErrorCode MatIncreaseOverlap_MPIAIJ_Once(Mat C,PetscInt imax,IS is[]
   PetscInt       *n,**data,len;
   PetscErrorCode ierr;
   PetscMPIInt    size,rank,tag1,tag2;
-  PetscInt       M,i,j,k,**rbuf,row,proc = 0,nrqs,msz,**outdat,**ptr;
-  PetscInt       *ctr,*pa,*tmp,*isz,*isz1,**xdata,**rbuf2,*d_p;
-  PetscBT        *table;
+  PetscInt       M,i,j,k,**rbuf,row,proc = 0,msz,**outdat,**ptr;
+  PetscInt       *ctr,*tmp,*isz,*dmax,*isz1,**xdata,**rbuf2;
+  PetscMPIInt    nrqs,*pa;
+  PetscTable     *table;
+  PetscBool      found = PETSC_FALSE;
   MPI_Comm       comm;
   MPI_Request    *s_waits1,*r_waits1,*s_waits2,*r_waits2;
   MPI_Status     *s_status,*recv_status;
-  char           *t_p;
 
   PetscFunctionBegin;
   ierr = PetscObjectGetComm((PetscObject)C,&comm);CHKERRQ(ierr);
@@ -127,8 +189,7 @@ static PetscErrorCode MatIncreaseOverlap_MPIAIJ_Once(Mat C,PetscInt imax,IS is[]
   }
 
   /* Determine the number of messages to expect, their lengths, from from-ids */
-  ierr = PetscGatherNumberOfMessages(comm,w2,w1,&nrqr);CHKERRQ(ierr);
-  ierr = PetscGatherMessageLengths(comm,nrqs,nrqr,w1,&onodes1,&olengths1);CHKERRQ(ierr);
+  ierr = MatGatherMessageLengths_MPIAIJ_Private(comm,nrqs,pa,w1,&nrqr,&onodes1,&olengths1);CHKERRQ(ierr);
 
   /* Now post the Irecvs corresponding to these messages */
   ierr = PetscPostIrecvInt(comm,tag1,nrqr,onodes1,olengths1,&rbuf,&r_waits1);CHKERRQ(ierr);
@@ -157,20 +218,21 @@ static PetscErrorCode MatIncreaseOverlap_MPIAIJ_Once(Mat C,PetscInt imax,IS is[]
     ptr[j]       = outdat[j] + 2*w3[j] + 1;
   }
 
-  /* Memory for doing local proc's work*/
+  /* Memory for doing local proc's work, the arrays of the new index sets and the tables of their rows grow with the overlap */
   {
-    ierr = PetscCalloc5(imax,&table, imax,&data, imax,&isz, M*imax,&d_p, (M/PETSC_BITS_PER_BYTE+1)*imax,&t_p);CHKERRQ(ierr);
+    ierr = PetscCalloc4(imax,&table, imax,&data, imax,&isz, imax,&dmax);CHKERRQ(ierr);
 
     for (i=0; i<imax; i++) {
-      table[i] = t_p + (M/PETSC_BITS_PER_BYTE+1)*i;
-      data[i]  = d_p + M*i;
+      dmax[i] = n[i]+1;
+      ierr    = PetscMalloc1(dmax[i],&data[i]);CHKERRQ(ierr);
+      ierr    = PetscTableCreate(dmax[i],M,&table[i]);CHKERRQ(ierr);
     }
   }
 
   /* Parse the IS and update local tables and the outgoing buf with the data*/
   {
-    PetscInt n_i,*data_i,isz_i,*outdat_j,ctr_j;
-    PetscBT  table_i;
+    PetscInt   n_i,*data_i,isz_i,*outdat_j,ctr_j;
+    PetscTable table_i;
 
     for (i=0; i<imax; i++) {
       ierr    = PetscMemzero(ctr,size*sizeof(PetscInt));CHKERRQ(ierr);
@@ -186,7 +248,10 @@ static PetscErrorCode MatIncreaseOverlap_MPIAIJ_Once(Mat C,PetscInt imax,IS is[]
           ctr[proc]++;
           *ptr[proc] = row;
           ptr[proc]++;
-        } else if (!PetscBTLookupSet(table_i,row)) data_i[isz_i++] = row; /* Update the local table */
+        } else { /* Update the local table */
+          ierr = MatIncreaseOverlap_MPIAIJ_LookupSet_Private(table_i,row,&found);CHKERRQ(ierr);
+          if (!found) data_i[isz_i++] = row;
+        }
       }
       /* Update the headers for the current IS */
       for (j=0; j<size; j++) { /* Can Optimise this loop by using pa[] */
@@ -219,7 +284,7 @@ static PetscErrorCode MatIncreaseOverlap_MPIAIJ_Once(Mat C,PetscInt imax,IS is[]
   }
 
   /* Do Local work*/
-  ierr = MatIncreaseOverlap_MPIAIJ_Local(C,imax,table,isz,data);CHKERRQ(ierr);
+  ierr = MatIncreaseOverlap_MPIAIJ_Local(C,imax,table,isz,dmax,data);CHKERRQ(ierr);
 
   /* Receive messages*/
   ierr = PetscMalloc1(nrqr+1,&recv_status);CHKERRQ(ierr);
@@ -273,7 +338,7 @@ static PetscErrorCode MatIncreaseOverlap_MPIAIJ_Once(Mat C,PetscInt imax,IS is[]
   {
     PetscInt    is_no,ct1,max,*rbuf2_i,isz_i,*data_i,jmax;
     PetscMPIInt idex;
-    PetscBT     table_i;
+    PetscTable  table_i;
     MPI_Status  *status2;
 
     ierr = PetscMalloc1((PetscMax(nrqr,nrqs)+1),&status2);CHKERRQ(ierr);
@@ -287,11 +352,13 @@ static PetscErrorCode MatIncreaseOverlap_MPIAIJ_Once(Mat C,PetscInt imax,IS is[]
         max     = rbuf2_i[2*j];
         is_no   = rbuf2_i[2*j-1];
         isz_i   = isz[is_no];
+        ierr    = MatIncreaseOverlap_MPIAIJ_Grow_Private(isz_i+max,isz_i,dmax+is_no,data+is_no);CHKERRQ(ierr);
         data_i  = data[is_no];
         table_i = table[is_no];
         for (k=0; k<max; k++,ct1++) {
-          row = rbuf2_i[ct1];
-          if (!PetscBTLookupSet(table_i,row)) data_i[isz_i++] = row;
+          row  = rbuf2_i[ct1];
+          ierr = MatIncreaseOverlap_MPIAIJ_LookupSet_Private(table_i,row,&found);CHKERRQ(ierr);
+          if (!found) data_i[isz_i++] = row;
         }
         isz[is_no] = isz_i;
       }
@@ -302,7 +369,8 @@ static PetscErrorCode MatIncreaseOverlap_MPIAIJ_Once(Mat C,PetscInt imax,IS is[]
   }
 
   for (i=0; i<imax; ++i) {
-    ierr = ISCreateGeneral(PETSC_COMM_SELF,isz[i],data[i],PETSC_COPY_VALUES,is+i);CHKERRQ(ierr);
+    ierr = ISCreateGeneral(PETSC_COMM_SELF,isz[i],data[i],PETSC_OWN_POINTER,is+i);CHKERRQ(ierr);
+    ierr = PetscTableDestroy(&table[i]);CHKERRQ(ierr);
   }
 
   ierr = PetscFree(onodes2);CHKERRQ(ierr);
@@ -315,7 +383,7 @@ static PetscErrorCode MatIncreaseOverlap_MPIAIJ_Once(Mat C,PetscInt imax,IS is[]
   ierr = PetscFree(r_waits1);CHKERRQ(ierr);
   ierr = PetscFree(s_waits2);CHKERRQ(ierr);
   ierr = PetscFree(r_waits2);CHKERRQ(ierr);
-  ierr = PetscFree5(table,data,isz,d_p,t_p);CHKERRQ(ierr);
+  ierr = PetscFree4(table,data,isz,dmax);CHKERRQ(ierr);
   ierr = PetscFree(s_status);CHKERRQ(ierr);
   ierr = PetscFree(recv_status);CHKERRQ(ierr);
   ierr = PetscFree(xdata[0]);CHKERRQ(ierr);
@@ -333,21 +401,24 @@ static PetscErrorCode MatIncreaseOverlap_MPIAIJ_Once(Mat C,PetscInt imax,IS is[]
      Inputs:
       C      - MAT_MPIAIJ;
       imax - total no of index sets processed at a time;
-      table  - an array of char - size = m bits.
+      table  - the rows already in each index set
 
      Output:
       isz    - array containing the count of the solution elements corresponding
                to each index set;
+      dmax   - the allocated length of each array of data, increased when needed
       data   - pointer to the solutions
 */
-static PetscErrorCode MatIncreaseOverlap_MPIAIJ_Local(Mat C,PetscInt imax,PetscBT *table,PetscInt *isz,PetscInt **data)
+static PetscErrorCode MatIncreaseOverlap_MPIAIJ_Local(Mat C,PetscInt imax,PetscTable *table,PetscInt *isz,PetscInt *dmax,PetscInt **data)
 {
-  Mat_MPIAIJ *c = (Mat_MPIAIJ*)C->data;
-  Mat        A  = c->A,B = c->B;
-  Mat_SeqAIJ *a = (Mat_SeqAIJ*)A->data,*b = (Mat_SeqAIJ*)B->data;
-  PetscInt   start,end,val,max,rstart,cstart,*ai,*aj;
-  PetscInt   *bi,*bj,*garray,i,j,k,row,*data_i,isz_i;
-  PetscBT    table_i;
+  Mat_MPIAIJ     *c = (Mat_MPIAIJ*)C->data;
+  Mat            A  = c->A,B = c->B;
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data,*b = (Mat_SeqAIJ*)B->data;
+  PetscInt       start,end,val,max,rstart,cstart,*ai,*aj,need;
+  PetscInt       *bi,*bj,*garray,i,j,k,row,*data_i,isz_i;
+  PetscTable     table_i;
+  PetscBool      found = PETSC_FALSE;
+  PetscErrorCode ierr;
 
   PetscFunctionBegin;
   rstart = C->rmap->rstart;
@@ -360,22 +431,29 @@ static PetscErrorCode MatIncreaseOverlap_MPIAIJ_Local(Mat C,PetscInt imax,PetscB
 
 
   for (i=0; i<imax; i++) {
+    isz_i = isz[i];
+    for (j=0,need=isz_i; j<isz_i; j++) {
+      row   = data[i][j] - rstart;
+      need += ai[row+1] - ai[row] + bi[row+1] - bi[row];
+    }
+    ierr    = MatIncreaseOverlap_MPIAIJ_Grow_Private(need,isz_i,dmax+i,data+i);CHKERRQ(ierr);
     data_i  = data[i];
     table_i = table[i];
-    isz_i   = isz[i];
     for (j=0,max=isz[i]; j<max; j++) {
       row   = data_i[j] - rstart;
       start = ai[row];
       end   = ai[row+1];
       for (k=start; k<end; k++) { /* Amat */
-        val = aj[k] + cstart;
-        if (!PetscBTLookupSet(table_i,val)) data_i[isz_i++] = val;
+        val  = aj[k] + cstart;
+        ierr = MatIncreaseOverlap_MPIAIJ_LookupSet_Private(table_i,val,&found);CHKERRQ(ierr);
+        if (!found) data_i[isz_i++] = val;
       }
       start = bi[row];
       end   = bi[row+1];
       for (k=start; k<end; k++) { /* Bmat */
-        val = garray[bj[k]];
-        if (!PetscBTLookupSet(table_i,val)) data_i[isz_i++] = val;
+        val  = garray[bj[k]];
+        ierr = MatIncreaseOverlap_MPIAIJ_LookupSet_Private(table_i,val,&found);CHKERRQ(ierr);
+        if (!found) data_i[isz_i++] = val;
       }
     }
     isz[i] = isz_i;
@@ -412,9 +490,10 @@ static PetscErrorCode MatIncreaseOverlap_MPIAIJ_Receive(Mat C,PetscInt nrqr,Pets
   PetscErrorCode ierr;
   PetscInt       rstart,cstart,*ai,*aj,*bi,*bj,*garray,i,j,k;
   PetscInt       row,total_sz,ct,ct1,ct2,ct3,mem_estimate,oct2,l,start,end;
-  PetscInt       val,max1,max2,m,no_malloc =0,*tmp,new_estimate,ctr;
+  PetscInt       val,max1,max2,m,no_malloc =0,*tmp,new_estimate,ctr,szmax = 0;
   PetscInt       *rbuf_i,kmax,rbuf_0;
-  PetscBT        xtable;
+  PetscTable     xtable;
+  PetscBool      found = PETSC_FALSE;
 
   PetscFunctionBegin;
   m      = C->rmap->N;
@@ -431,7 +510,10 @@ static PetscErrorCode MatIncreaseOverlap_MPIAIJ_Receive(Mat C,PetscInt nrqr,Pets
     rbuf_i =  rbuf[i];
     rbuf_0 =  rbuf_i[0];
     ct    += rbuf_0;
-    for (j=1; j<=rbuf_0; j++) total_sz += rbuf_i[2*j];
+    for (j=1; j<=rbuf_0; j++) {
+      total_sz += rbuf_i[2*j];
+      szmax     = PetscMax(szmax,rbuf_i[2*j]);
+    }
   }
 
   if (C->rmap->n) max1 = ct*(a->nz + b->nz)/C->rmap->n;
@@ -439,7 +521,8 @@ static PetscErrorCode MatIncreaseOverlap_MPIAIJ_Receive(Mat C,PetscInt nrqr,Pets
   mem_estimate = 3*((total_sz > max1 ? total_sz : max1)+1);
   ierr         = PetscMalloc1(mem_estimate,&xdata[0]);CHKERRQ(ierr);
   ++no_malloc;
-  ierr = PetscBTCreate(m,&xtable);CHKERRQ(ierr);
+  /* Sized for the largest IS received, it is emptied for each IS */
+  ierr = PetscTableCreate(szmax,m,&xtable);CHKERRQ(ierr);
   ierr = PetscMemzero(isz1,nrqr*sizeof(PetscInt));CHKERRQ(ierr);
 
   ct3 = 0;
@@ -450,12 +533,12 @@ static PetscErrorCode MatIncreaseOverlap_MPIAIJ_Receive(Mat C,PetscInt nrqr,Pets
     ct2    =  ct1;
     ct3   += ct1;
     for (j=1; j<=rbuf_0; j++) { /* for each IS from proc i*/
-      ierr = PetscBTMemzero(m,xtable);CHKERRQ(ierr);
       oct2 = ct2;
       kmax = rbuf_i[2*j];
       for (k=0; k<kmax; k++,ct1++) {
-        row = rbuf_i[ct1];
-        if (!PetscBTLookupSet(xtable,row)) {
+        row  = rbuf_i[ct1];
+        ierr = MatIncreaseOverlap_MPIAIJ_LookupSet_Private(xtable,row,&found);CHKERRQ(ierr);
+        if (!found) {
           if (!(ct3 < mem_estimate)) {
             new_estimate = (PetscInt)(1.5*mem_estimate)+1;
             ierr         = PetscMalloc1(new_estimate,&tmp);CHKERRQ(ierr);
@@ -474,8 +557,9 @@ static PetscErrorCode MatIncreaseOverlap_MPIAIJ_Receive(Mat C,PetscInt nrqr,Pets
         start = ai[row];
         end   = ai[row+1];
         for (l=start; l<end; l++) {
-          val = aj[l] + cstart;
-          if (!PetscBTLookupSet(xtable,val)) {
+          val  = aj[l] + cstart;
+          ierr = MatIncreaseOverlap_MPIAIJ_LookupSet_Private(xtable,val,&found);CHKERRQ(ierr);
+          if (!found) {
             if (!(ct3 < mem_estimate)) {
               new_estimate = (PetscInt)(1.5*mem_estimate)+1;
               ierr         = PetscMalloc1(new_estimate,&tmp);CHKERRQ(ierr);
@@ -492,8 +576,9 @@ static PetscErrorCode MatIncreaseOverlap_MPIAIJ_Receive(Mat C,PetscInt nrqr,Pets
         start = bi[row];
         end   = bi[row+1];
         for (l=start; l<end; l++) {
-          val = garray[bj[l]];
-          if (!PetscBTLookupSet(xtable,val)) {
+          val  = garray[bj[l]];
+          ierr = MatIncreaseOverlap_MPIAIJ_LookupSet_Private(xtable,val,&found);CHKERRQ(ierr);
+          if (!found) {
             if (!(ct3 < mem_estimate)) {
               new_estimate = (PetscInt)(1.5*mem_estimate)+1;
               ierr         = PetscMalloc1(new_estimate,&tmp);CHKERRQ(ierr);
@@ -511,12 +596,14 @@ static PetscErrorCode MatIncreaseOverlap_MPIAIJ_Receive(Mat C,PetscInt nrqr,Pets
       /* Update the header*/
       xdata[i][2*j]   = ct2 - oct2; /* Undo the vector isz1 and use only a var*/
       xdata[i][2*j-1] = rbuf_i[2*j-1];
+      /* The table only grows with the largest IS and its overlap, so emptying it for the next IS is not O(m) */
+      ierr = PetscTableRemoveAll(xtable);CHKERRQ(ierr);
     }
     xdata[i][0] = rbuf_0;
     xdata[i+1]  = xdata[i] + ct2;
     isz1[i]     = ct2; /* size of each message */
   }
-  ierr = PetscBTDestroy(&xtable);CHKERRQ(ierr);
+  ierr = PetscTableDestroy(&xtable);CHKERRQ(ierr);
   ierr = PetscInfo3(C,"Allocated %D bytes, required %D bytes, no of mallocs = %D\n",mem_estimate,ct3,no_malloc);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -787,6 +874,217 @@ PetscErrorCode MatGetSubMatrices_MPIAIJ(Mat C,PetscInt ismax,const IS isrow[],co
 }
 
 /* -------------------------------------------------------------------------*/
+/*
+   The communication pattern of MatGetSubMatrices_MPIAIJ_Local() and the location of every value in the
+   submatrices, composed with the first submatrix of each stage by the first extraction with MAT_REUSE_MATRIX
+   that cannot use an existing plan. Extracting the values again with MAT_REUSE_MATRIX, for the same index sets
+   and the same nonzero pattern, then needs only the requests for the rows and the values in return instead of
+   four rounds of messages and the symbolic work.
+*/
+typedef struct {
+  PetscInt         ismax;
+  PetscObjectId    Cid,*rowid,*colid;          /* the matrix and the index sets the submatrices were extracted with */
+  PetscObjectState Cstate,*rowstate,*colstate;
+  PetscObjectState *substate;                  /* the nonzero states of the submatrices */
+  PetscMPIInt      nrqs,*pa,*slen,*rlen;       /* the processes owning requested rows, the lengths of the requests and of the replies */
+  PetscInt         **sbuf;                     /* the requests, in the format of sbuf1 in MatGetSubMatrices_MPIAIJ_Local() */
+  PetscInt         **rlens;                    /* the lengths of the requested rows, at the locations of the rows in sbuf */
+  PetscInt         **rpos;                     /* location of each received value in its submatrix, -1 if its column is not in the submatrix */
+  PetscInt         nl,*lrow,*lis,*lpos;        /* the local rows of the submatrices and the locations of their values */
+} MatGetSubMatricesReuse_MPIAIJ;
+
+#undef __FUNCT__
+#define __FUNCT__ "MatGetSubMatricesReuseDestroy_MPIAIJ"
+static PetscErrorCode MatGetSubMatricesReuseDestroy_MPIAIJ(void *ptr)
+{
+  MatGetSubMatricesReuse_MPIAIJ *plan = (MatGetSubMatricesReuse_MPIAIJ*)ptr;
+  PetscErrorCode                ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree5(plan->rowid,plan->colid,plan->rowstate,plan->colstate,plan->substate);CHKERRQ(ierr);
+  if (plan->nrqs) {
+    ierr = PetscFree(plan->sbuf[0]);CHKERRQ(ierr);
+    ierr = PetscFree(plan->rlens[0]);CHKERRQ(ierr);
+    ierr = PetscFree(plan->rpos[0]);CHKERRQ(ierr);
+  }
+  ierr = PetscFree4(plan->pa,plan->slen,plan->rlen,plan->sbuf);CHKERRQ(ierr);
+  ierr = PetscFree2(plan->rlens,plan->rpos);CHKERRQ(ierr);
+  ierr = PetscFree3(plan->lrow,plan->lis,plan->lpos);CHKERRQ(ierr);
+  ierr = PetscFree(plan);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatGetSubMatricesReuseFind_MPIAIJ"
+/* The location of the entry (row,col) in a submatrix, the columns of the rows are sorted */
+PETSC_STATIC_INLINE PetscErrorCode MatGetSubMatricesReuseFind_MPIAIJ(Mat_SeqAIJ *mat,PetscInt row,PetscInt col,PetscInt *pos)
+{
+  PetscErrorCode ierr;
+  PetscInt       loc;
+
+  PetscFunctionBegin;
+  ierr = PetscFindInt(col,mat->i[row+1]-mat->i[row],mat->j+mat->i[row],&loc);CHKERRQ(ierr);
+  if (loc < 0) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Entry (%D,%D) not found in the submatrix",row,col);
+  *pos = mat->i[row] + loc;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatGetSubMatricesReuseGet_MPIAIJ"
+/* Returns the plan composed with the submatrices if it is still valid for them, otherwise NULL */
+static PetscErrorCode MatGetSubMatricesReuseGet_MPIAIJ(Mat C,PetscInt ismax,const IS isrow[],const IS iscol[],Mat *submats,MatGetSubMatricesReuse_MPIAIJ **plan)
+{
+  MatGetSubMatricesReuse_MPIAIJ *p;
+  PetscContainer                container;
+  PetscObjectId                 id;
+  PetscObjectState              state;
+  PetscInt                      i;
+  PetscErrorCode                ierr;
+
+  PetscFunctionBegin;
+  *plan = NULL;
+  ierr  = PetscObjectQuery((PetscObject)submats[0],"MatGetSubMatricesReuse_MPIAIJ",(PetscObject*)&container);CHKERRQ(ierr);
+  if (!container) PetscFunctionReturn(0);
+  ierr = PetscContainerGetPointer(container,(void**)&p);CHKERRQ(ierr);
+  if (p->ismax != ismax) PetscFunctionReturn(0);
+  ierr = PetscObjectGetId((PetscObject)C,&id);CHKERRQ(ierr);
+  ierr = MatGetNonzeroState(C,&state);CHKERRQ(ierr);
+  if (id != p->Cid || state != p->Cstate) PetscFunctionReturn(0);
+  for (i=0; i<ismax; i++) {
+    ierr = PetscObjectGetId((PetscObject)isrow[i],&id);CHKERRQ(ierr);
+    ierr = PetscObjectStateGet((PetscObject)isrow[i],&state);CHKERRQ(ierr);
+    if (id != p->rowid[i] || state != p->rowstate[i]) PetscFunctionReturn(0);
+    ierr = PetscObjectGetId((PetscObject)iscol[i],&id);CHKERRQ(ierr);
+    ierr = PetscObjectStateGet((PetscObject)iscol[i],&state);CHKERRQ(ierr);
+    if (id != p->colid[i] || state != p->colstate[i]) PetscFunctionReturn(0);
+    ierr = MatGetNonzeroState(submats[i],&state);CHKERRQ(ierr);
+    if (state != p->substate[i]) PetscFunctionReturn(0);
+  }
+  *plan = p;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatGetSubMatrices_MPIAIJ_Reuse"
+/*
+   Extracts the values of the submatrices again with the plan of a previous extraction. The requests for the
+   rows go only to their owners, the replies are received without blocking while the local values are copied.
+   Every process of the communicator takes part, plan is NULL on processes without submatrices in this stage.
+*/
+static PetscErrorCode MatGetSubMatrices_MPIAIJ_Reuse(Mat C,PetscInt ismax,Mat *submats,MatGetSubMatricesReuse_MPIAIJ *plan)
+{
+  Mat_MPIAIJ     *c = (Mat_MPIAIJ*)C->data;
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)c->A->data,*b = (Mat_SeqAIJ*)c->B->data;
+  MPI_Comm       comm;
+  MPI_Request    *s_waits1,*r_waits1,*s_waits2,*r_waits2;
+  PetscMPIInt    tag1,tag2,nrqs = 0,nrqr,*pa = NULL,*slen = NULL,*onodes1,*olengths1,idex;
+  PetscInt       **rbuf1,*rbuf1_i,*sbuf1_i,*rlens_i,*rpos_i,*lpos,nfrom,i,j,k,l,ct1,ct2,jmax,max1,max2,row,ncols,nvals;
+  PetscInt       rstart = C->rmap->rstart;
+  PetscScalar    **rbuf2,**sbuf2,*rbuf2_i,*sbuf2_i,*vals,*imat_a;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)C,&comm);CHKERRQ(ierr);
+  ierr = PetscObjectGetNewTag((PetscObject)C,&tag1);CHKERRQ(ierr);
+  ierr = PetscObjectGetNewTag((PetscObject)C,&tag2);CHKERRQ(ierr);
+  if (plan) {
+    nrqs = plan->nrqs;
+    pa   = plan->pa;
+    slen = plan->slen;
+    ierr = PetscInfo2(C,"Reusing the extraction of %D submatrices, %D outgoing messages\n",ismax,(PetscInt)nrqs);CHKERRQ(ierr);
+  }
+
+  /* The replies have known lengths, their receives are posted first */
+  ierr = PetscMalloc3(nrqs+1,&rbuf2,nrqs+1,&r_waits2,nrqs+1,&s_waits1);CHKERRQ(ierr);
+  for (i=0; i<nrqs; i++) {
+    ierr = PetscMalloc1(plan->rlen[i]+1,&rbuf2[i]);CHKERRQ(ierr);
+    ierr = MPI_Irecv(rbuf2[i],plan->rlen[i],MPIU_SCALAR,pa[i],tag2,comm,r_waits2+i);CHKERRQ(ierr);
+  }
+
+  /* Only the owners of the requested rows learn about the requests */
+  ierr = PetscCommBuildTwoSided(comm,1,MPI_INT,nrqs,pa,slen,&nfrom,&onodes1,&olengths1);CHKERRQ(ierr);
+  ierr = PetscMPIIntCast(nfrom,&nrqr);CHKERRQ(ierr);
+  ierr = PetscPostIrecvInt(comm,tag1,nrqr,onodes1,olengths1,&rbuf1,&r_waits1);CHKERRQ(ierr);
+  for (i=0; i<nrqs; i++) {
+    ierr = MPI_Isend(plan->sbuf[i],slen[i],MPIU_INT,pa[i],tag1,comm,s_waits1+i);CHKERRQ(ierr);
+  }
+
+  /* Copy the values of the local rows while the requests are on their way */
+  if (plan) {
+    lpos = plan->lpos;
+    for (i=0; i<plan->nl; i++) {
+      imat_a = ((Mat_SeqAIJ*)submats[plan->lis[i]]->data)->a;
+      ierr   = MatGetRow_MPIAIJ(C,plan->lrow[i],&ncols,NULL,&vals);CHKERRQ(ierr);
+      for (k=0; k<ncols; k++) {
+        if (lpos[k] >= 0) imat_a[lpos[k]] = vals[k];
+      }
+      lpos += ncols;
+      ierr  = MatRestoreRow_MPIAIJ(C,plan->lrow[i],&ncols,NULL,&vals);CHKERRQ(ierr);
+    }
+  }
+
+  /* Reply to the requests in the order they arrive, with the values of each row in the order of MatGetRow() */
+  ierr = PetscMalloc2(nrqr+1,&sbuf2,nrqr+1,&s_waits2);CHKERRQ(ierr);
+  for (i=0; i<nrqr; i++) {
+    ierr    = MPI_Waitany(nrqr,r_waits1,&idex,MPI_STATUS_IGNORE);CHKERRQ(ierr);
+    rbuf1_i = rbuf1[idex];
+    for (j=2*rbuf1_i[0]+1,nvals=0; j<olengths1[idex]; j++) {
+      row    = rbuf1_i[j] - rstart;
+      nvals += a->i[row+1] - a->i[row] + b->i[row+1] - b->i[row];
+    }
+    ierr    = PetscMalloc1(nvals+1,&sbuf2[idex]);CHKERRQ(ierr);
+    sbuf2_i = sbuf2[idex];
+    for (j=2*rbuf1_i[0]+1; j<olengths1[idex]; j++) {
+      ierr     = MatGetRow_MPIAIJ(C,rbuf1_i[j],&ncols,NULL,&vals);CHKERRQ(ierr);
+      ierr     = PetscMemcpy(sbuf2_i,vals,ncols*sizeof(PetscScalar));CHKERRQ(ierr);
+      sbuf2_i += ncols;
+      ierr     = MatRestoreRow_MPIAIJ(C,rbuf1_i[j],&ncols,NULL,&vals);CHKERRQ(ierr);
+    }
+    ierr = MPI_Isend(sbuf2[idex],nvals,MPIU_SCALAR,onodes1[idex],tag2,comm,s_waits2+idex);CHKERRQ(ierr);
+  }
+
+  /* Put the received values in place */
+  for (i=0; i<nrqs; i++) {
+    ierr    = MPI_Waitany(nrqs,r_waits2,&idex,MPI_STATUS_IGNORE);CHKERRQ(ierr);
+    sbuf1_i = plan->sbuf[idex];
+    rlens_i = plan->rlens[idex];
+    rpos_i  = plan->rpos[idex];
+    rbuf2_i = rbuf2[idex];
+    jmax    = sbuf1_i[0];
+    ct1     = 2*jmax+1;
+    ct2     = 0;
+    for (j=1; j<=jmax; j++) {
+      imat_a = ((Mat_SeqAIJ*)submats[sbuf1_i[2*j-1]]->data)->a;
+      max1   = sbuf1_i[2*j];
+      for (k=0; k<max1; k++,ct1++) {
+        max2 = rlens_i[ct1];
+        for (l=0; l<max2; l++,ct2++) {
+          if (rpos_i[ct2] >= 0) imat_a[rpos_i[ct2]] = rbuf2_i[ct2];
+        }
+      }
+    }
+  }
+
+  if (nrqs) {ierr = MPI_Waitall(nrqs,s_waits1,MPI_STATUSES_IGNORE);CHKERRQ(ierr);}
+  if (nrqr) {ierr = MPI_Waitall(nrqr,s_waits2,MPI_STATUSES_IGNORE);CHKERRQ(ierr);}
+  for (i=0; i<nrqs; i++) {ierr = PetscFree(rbuf2[i]);CHKERRQ(ierr);}
+  for (i=0; i<nrqr; i++) {ierr = PetscFree(sbuf2[i]);CHKERRQ(ierr);}
+  ierr = PetscFree3(rbuf2,r_waits2,s_waits1);CHKERRQ(ierr);
+  ierr = PetscFree2(sbuf2,s_waits2);CHKERRQ(ierr);
+  if (nrqr) {ierr = PetscFree(rbuf1[0]);CHKERRQ(ierr);}
+  ierr = PetscFree(rbuf1);CHKERRQ(ierr);
+  ierr = PetscFree(r_waits1);CHKERRQ(ierr);
+  ierr = PetscFree(onodes1);CHKERRQ(ierr);
+  ierr = PetscFree(olengths1);CHKERRQ(ierr);
+
+  for (i=0; i<ismax; i++) {
+    ierr = MatAssemblyBegin(submats[i],MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(submats[i],MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatGetNonzeroState(submats[i],&plan->substate[i]);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "MatGetSubMatrices_MPIAIJ_Local"
 PetscErrorCode MatGetSubMatrices_MPIAIJ_Local(Mat C,PetscInt ismax,const IS isrow[],const IS iscol[],MatReuse scall,PetscBool *allcolumns,Mat *submats)
@@ -799,7 +1097,7 @@ PetscErrorCode MatGetSubMatrices_MPIAIJ_Local(Mat C,PetscInt ismax,const IS isro
   PetscErrorCode ierr;
   PetscMPIInt    rank,size,tag0,tag1,tag2,tag3,*w1,*w2,*w3,*w4,nrqr;
   PetscInt       **sbuf1,**sbuf2,i,j,k,l,ct1,ct2,**rbuf1,row,proc;
-  PetscInt       nrqs,msz,**ptr,*req_size,*ctr,*pa,*tmp,tcol;
+  PetscInt       msz,**ptr,*req_size,*ctr,*tmp,tcol;
   PetscInt       **rbuf3,*req_source,**sbuf_aj,**rbuf2,max1,max2;
   PetscInt       **lens,is_no,ncols,*cols,mat_i,*mat_j,tmp2,jmax;
 #if defined(PETSC_USE_CTABLE)
@@ -815,7 +1113,7 @@ PetscErrorCode MatGetSubMatrices_MPIAIJ_Local(Mat C,PetscInt ismax,const IS isro
   MPI_Status     *r_status3,*r_status4,*s_status4;
   MPI_Comm       comm;
   PetscScalar    **rbuf4,**sbuf_aa,*vals,*mat_a,*sbuf_aa_i;
-  PetscMPIInt    *onodes1,*olengths1;
+  PetscMPIInt    *onodes1,*olengths1,nrqs,*pa;
   PetscMPIInt    idex,idex2,end;
 
   PetscFunctionBegin;
@@ -824,6 +1122,22 @@ PetscErrorCode MatGetSubMatrices_MPIAIJ_Local(Mat C,PetscInt ismax,const IS isro
   size = c->size;
   rank = c->rank;
 
+  /* Extract only the values if every process can reuse the plan of the previous extraction */
+  if (scall == MAT_REUSE_MATRIX) {
+    MatGetSubMatricesReuse_MPIAIJ *plan = NULL;
+    PetscBool                     reuse = PETSC_TRUE,treuse;
+
+    if (ismax) {
+      ierr  = MatGetSubMatricesReuseGet_MPIAIJ(C,ismax,isrow,iscol,submats,&plan);CHKERRQ(ierr);
+      reuse = plan ? PETSC_TRUE : PETSC_FALSE;
+    }
+    ierr = MPI_Allreduce(&reuse,&treuse,1,MPIU_BOOL,MPI_MIN,comm);CHKERRQ(ierr);
+    if (treuse) {
+      ierr = MatGetSubMatrices_MPIAIJ_Reuse(C,ismax,submats,plan);CHKERRQ(ierr);
+      PetscFunctionReturn(0);
+    }
+  }
+
   /* Get some new tags to keep the communication clean */
   ierr = PetscObjectGetNewTag((PetscObject)C,&tag1);CHKERRQ(ierr);
   ierr = PetscObjectGetNewTag((PetscObject)C,&tag2);CHKERRQ(ierr);
@@ -854,10 +1168,8 @@ PetscErrorCode MatGetSubMatrices_MPIAIJ_Local(Mat C,PetscInt ismax,const IS isro
     jmax   = nrow[i];
     irow_i = irow[i];
     for (j=0; j<jmax; j++) {
-      l   = 0;
-      row = irow_i[j];
-      while (row >= C->rmap->range[l+1]) l++;
-      proc = l;
+      row  = irow_i[j];
+      ierr = PetscLayoutFindOwner(C->rmap,row,&proc);CHKERRQ(ierr);
       w4[proc]++;
     }
     for (j=0; j<size; j++) {
@@ -883,11 +1195,10 @@ PetscErrorCode MatGetSubMatrices_MPIAIJ_Local(Mat C,PetscInt ismax,const IS isro
     w1[j] += w2[j] + 2* w3[j];
     msz   += w1[j];
   }
-  ierr = PetscInfo2(0,"Number of outgoing messages %D Total message length %D\n",nrqs,msz);CHKERRQ(ierr);
+  ierr = PetscInfo2(0,"Number of outgoing messages %D Total message length %D\n",(PetscInt)nrqs,msz);CHKERRQ(ierr);
 
   /* Determine the number of messages to expect, their lengths, from from-ids */
-  ierr = PetscGatherNumberOfMessages(comm,w2,w1,&nrqr);CHKERRQ(ierr);
-  ierr = PetscGatherMessageLengths(comm,nrqs,nrqr,w1,&onodes1,&olengths1);CHKERRQ(ierr);
+  ierr = MatGatherMessageLengths_MPIAIJ_Private(comm,nrqs,pa,w1,&nrqr,&onodes1,&olengths1);CHKERRQ(ierr);
 
   /* Now post the Irecvs corresponding to these messages */
   ierr = PetscPostIrecvInt(comm,tag0,nrqr,onodes1,olengths1,&rbuf1,&r_waits1);CHKERRQ(ierr);
@@ -925,10 +1236,8 @@ PetscErrorCode MatGetSubMatrices_MPIAIJ_Local(Mat C,PetscInt ismax,const IS isro
     irow_i = irow[i];
     jmax   = nrow[i];
     for (j=0; j<jmax; j++) {  /* parse the indices of each IS */
-      l   = 0;
-      row = irow_i[j];
-      while (row >= C->rmap->range[l+1]) l++;
-      proc = l;
+      row  = irow_i[j];
+      ierr = PetscLayoutFindOwner(C->rmap,row,&proc);CHKERRQ(ierr);
       if (proc != rank) { /* copy to the outgoing buf*/
         ctr[proc]++;
         *ptr[proc] = row;
@@ -1187,11 +1496,8 @@ PetscErrorCode MatGetSubMatrices_MPIAIJ_Local(Mat C,PetscInt ismax,const IS isro
     irow_i = irow[i];
     lens_i = lens[i];
     for (j=0; j<jmax; j++) {
-      l   = 0;
       row = irow_i[j];
-      while (row >= C->rmap->range[l+1]) l++;
-      proc = l;
-      if (proc == rank) {
+      if (row >= C->rmap->rstart && row < C->rmap->rend) {
         ierr = MatGetRow_MPIAIJ(C,row,&ncols,&cols,0);CHKERRQ(ierr);
         if (!allcolumns[i]) {
           for (k=0; k<ncols; k++) {
@@ -1339,11 +1645,8 @@ PetscErrorCode MatGetSubMatrices_MPIAIJ_Local(Mat C,PetscInt ismax,const IS isro
       irow_i = irow[i];
       jmax   = nrow[i];
       for (j=0; j<jmax; j++) {
-        l   = 0;
         row = irow_i[j];
-        while (row >= C->rmap->range[l+1]) l++;
-        proc = l;
-        if (proc == rank) {
+        if (row >= C->rmap->rstart && row < C->rmap->rend) {
           old_row = row;
 #if defined(PETSC_USE_CTABLE)
           ierr = PetscTableFind(rmap_i,row+1,&row);CHKERRQ(ierr);
@@ -1482,6 +1785,147 @@ PetscErrorCode MatGetSubMatrices_MPIAIJ_Local(Mat C,PetscInt ismax,const IS isro
   ierr = PetscFree(s_waits4);CHKERRQ(ierr);
   ierr = PetscFree(s_status4);CHKERRQ(ierr);
 
+  for (i=0; i<ismax; i++) {
+    ierr = MatAssemblyBegin(submats[i],MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(submats[i],MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  }
+
+  /*
+     Keep the requests and the locations of the values in the submatrices for extracting the values again. This is
+     only done once the submatrices are extracted with MAT_REUSE_MATRIX, so that a single extraction pays nothing for it.
+  */
+  if (ismax && scall == MAT_REUSE_MATRIX) {
+    MatGetSubMatricesReuse_MPIAIJ *plan;
+    PetscContainer                container;
+    PetscInt                      *sbuf1_i,*rbuf2_i,*rbuf3_i,*rpos_i,*lpos,nl = 0,nlv = 0;
+
+    ierr        = PetscNew(&plan);CHKERRQ(ierr);
+    plan->ismax = ismax;
+    ierr        = PetscObjectGetId((PetscObject)C,&plan->Cid);CHKERRQ(ierr);
+    ierr        = MatGetNonzeroState(C,&plan->Cstate);CHKERRQ(ierr);
+    ierr        = PetscMalloc5(ismax,&plan->rowid,ismax,&plan->colid,ismax,&plan->rowstate,ismax,&plan->colstate,ismax,&plan->substate);CHKERRQ(ierr);
+    for (i=0; i<ismax; i++) {
+      ierr = PetscObjectGetId((PetscObject)isrow[i],&plan->rowid[i]);CHKERRQ(ierr);
+      ierr = PetscObjectStateGet((PetscObject)isrow[i],&plan->rowstate[i]);CHKERRQ(ierr);
+      ierr = PetscObjectGetId((PetscObject)iscol[i],&plan->colid[i]);CHKERRQ(ierr);
+      ierr = PetscObjectStateGet((PetscObject)iscol[i],&plan->colstate[i]);CHKERRQ(ierr);
+      ierr = MatGetNonzeroState(submats[i],&plan->substate[i]);CHKERRQ(ierr);
+    }
+
+    plan->nrqs = nrqs;
+    ierr       = PetscMalloc4(nrqs,&plan->pa,nrqs,&plan->slen,nrqs,&plan->rlen,nrqs,&plan->sbuf);CHKERRQ(ierr);
+    ierr       = PetscMalloc2(nrqs,&plan->rlens,nrqs,&plan->rpos);CHKERRQ(ierr);
+    for (i=0,ct1=0,ct2=0; i<nrqs; i++) {
+      plan->pa[i]   = pa[i];
+      plan->slen[i] = w1[pa[i]];
+      ierr          = PetscMPIIntCast(rbuf2[i][0],&plan->rlen[i]);CHKERRQ(ierr);
+      ct1          += plan->slen[i];
+      ct2          += plan->rlen[i];
+    }
+    if (nrqs) {
+      ierr = PetscMalloc1(ct1,&plan->sbuf[0]);CHKERRQ(ierr);
+      ierr = PetscMalloc1(ct1,&plan->rlens[0]);CHKERRQ(ierr);
+      ierr = PetscMalloc1(ct2+1,&plan->rpos[0]);CHKERRQ(ierr);
+    }
+    for (i=1; i<nrqs; i++) {
+      plan->sbuf[i]  = plan->sbuf[i-1] + plan->slen[i-1];
+      plan->rlens[i] = plan->rlens[i-1] + plan->slen[i-1];
+      plan->rpos[i]  = plan->rpos[i-1] + plan->rlen[i-1];
+    }
+    for (i=0; i<nrqs; i++) {
+      sbuf1_i = sbuf1[pa[i]];
+      rbuf2_i = rbuf2[i];
+      rbuf3_i = rbuf3[i];
+      rpos_i  = plan->rpos[i];
+      ierr    = PetscMemcpy(plan->sbuf[i],sbuf1_i,plan->slen[i]*sizeof(PetscInt));CHKERRQ(ierr);
+      ierr    = PetscMemcpy(plan->rlens[i],rbuf2_i,plan->slen[i]*sizeof(PetscInt));CHKERRQ(ierr);
+      jmax    = sbuf1_i[0];
+      ct1     = 2*jmax+1;
+      ct2     = 0;
+      for (j=1; j<=jmax; j++) {
+        is_no  = sbuf1_i[2*j-1];
+        max1   = sbuf1_i[2*j];
+        mat    = (Mat_SeqAIJ*)submats[is_no]->data;
+        rmap_i = rmap[is_no];
+        if (!allcolumns[is_no]) cmap_i = cmap[is_no];
+        for (k=0; k<max1; k++,ct1++) {
+#if defined(PETSC_USE_CTABLE)
+          ierr = PetscTableFind(rmap_i,sbuf1_i[ct1]+1,&row);CHKERRQ(ierr);
+          row--;
+#else
+          row = rmap_i[sbuf1_i[ct1]];
+#endif
+          max2 = rbuf2_i[ct1];
+          for (l=0; l<max2; l++,ct2++) {
+            if (allcolumns[is_no]) tcol = rbuf3_i[ct2] + 1;
+            else {
+#if defined(PETSC_USE_CTABLE)
+              ierr = PetscTableFind(cmap_i,rbuf3_i[ct2]+1,&tcol);CHKERRQ(ierr);
+#else
+              tcol = cmap_i[rbuf3_i[ct2]];
+#endif
+            }
+            if (tcol) {ierr = MatGetSubMatricesReuseFind_MPIAIJ(mat,row,tcol-1,rpos_i+ct2);CHKERRQ(ierr);}
+            else rpos_i[ct2] = -1;
+          }
+        }
+      }
+    }
+
+    /* the local rows, their values are taken in the order of MatGetRow() */
+    for (i=0; i<ismax; i++) {
+      for (j=0; j<nrow[i]; j++) {
+        row = irow[i][j];
+        if (row >= C->rmap->rstart && row < C->rmap->rend) {
+          row -= C->rmap->rstart;
+          nl++;
+          nlv += a->i[row+1] - a->i[row] + b->i[row+1] - b->i[row];
+        }
+      }
+    }
+    plan->nl = nl;
+    ierr     = PetscMalloc3(nl,&plan->lrow,nl,&plan->lis,nlv,&plan->lpos);CHKERRQ(ierr);
+    lpos     = plan->lpos;
+    for (i=0,nl=0; i<ismax; i++) {
+      mat    = (Mat_SeqAIJ*)submats[i]->data;
+      rmap_i = rmap[i];
+      if (!allcolumns[i]) cmap_i = cmap[i];
+      for (j=0; j<nrow[i]; j++) {
+        row = irow[i][j];
+        if (row < C->rmap->rstart || row >= C->rmap->rend) continue;
+        plan->lrow[nl]  = row;
+        plan->lis[nl++] = i;
+#if defined(PETSC_USE_CTABLE)
+        ierr = PetscTableFind(rmap_i,row+1,&l);CHKERRQ(ierr);
+        l--;
+#else
+        l = rmap_i[row];
+#endif
+        ierr = MatGetRow_MPIAIJ(C,row,&ncols,&cols,NULL);CHKERRQ(ierr);
+        for (k=0; k<ncols; k++) {
+          if (allcolumns[i]) tcol = cols[k] + 1;
+          else {
+#if defined(PETSC_USE_CTABLE)
+            ierr = PetscTableFind(cmap_i,cols[k]+1,&tcol);CHKERRQ(ierr);
+#else
+            tcol = cmap_i[cols[k]];
+#endif
+          }
+          if (tcol) {ierr = MatGetSubMatricesReuseFind_MPIAIJ(mat,l,tcol-1,lpos+k);CHKERRQ(ierr);}
+          else lpos[k] = -1;
+        }
+        lpos += ncols;
+        ierr  = MatRestoreRow_MPIAIJ(C,row,&ncols,&cols,NULL);CHKERRQ(ierr);
+      }
+    }
+
+    ierr = PetscContainerCreate(PETSC_COMM_SELF,&container);CHKERRQ(ierr);
+    ierr = PetscContainerSetPointer(container,plan);CHKERRQ(ierr);
+    ierr = PetscContainerSetUserDestroy(container,MatGetSubMatricesReuseDestroy_MPIAIJ);CHKERRQ(ierr);
+    ierr = PetscObjectCompose((PetscObject)submats[0],"MatGetSubMatricesReuse_MPIAIJ",(PetscObject)container);CHKERRQ(ierr);
+    ierr = PetscContainerDestroy(&container);CHKERRQ(ierr);
+  }
+
   /* Restore the indices */
   for (i=0; i<ismax; i++) {
     ierr = ISRestoreIndices(isrow[i],irow+i);CHKERRQ(ierr);
@@ -1532,11 +1976,6 @@ PetscErrorCode MatGetSubMatrices_MPIAIJ_Local(Mat C,PetscInt ismax,const IS isro
   ierr = PetscFree(cmap);CHKERRQ(ierr);
   if (ismax) {ierr = PetscFree(lens[0]);CHKERRQ(ierr);}
   ierr = PetscFree(lens);CHKERRQ(ierr);
-
-  for (i=0; i<ismax; i++) {
-    ierr = MatAssemblyBegin(submats[i],MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
-    ierr = MatAssemblyEnd(submats[i],MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
-  }
   PetscFunctionReturn(0);
 }
 
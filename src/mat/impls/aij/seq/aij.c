@@ -1092,6 +1092,9 @@ PetscErrorCode MatDestroy_SeqAIJ(Mat A)
   ierr = PetscFree(a->matmult_abdense);CHKERRQ(ierr);
 
   ierr = MatDestroy_SeqAIJ_Inode(A);CHKERRQ(ierr);
+  ierr = MatDestroy_SeqAIJ_MultiColor(A);CHKERRQ(ierr);
+  ierr = MatDestroy_SeqAIJ_Levels(A);CHKERRQ(ierr);
+  ierr = MatDestroy_SeqAIJ_Iterative(A);CHKERRQ(ierr);
   ierr = PetscFree(A->data);CHKERRQ(ierr);
 
   ierr = PetscObjectChangeTypeName((PetscObject)A,0);CHKERRQ(ierr);
@@ -1613,6 +1616,10 @@ PetscErrorCode MatSOR_SeqAIJ(Mat A,Vec bb,PetscReal omega,MatSORType flag,PetscR
   const PetscInt    *idx,*diag;
 
   PetscFunctionBegin;
+  if (a->multicolor.use && !(flag & (SOR_EISENSTAT | SOR_APPLY_UPPER | SOR_APPLY_LOWER))) {
+    ierr = MatSOR_SeqAIJ_MultiColor(A,bb,omega,flag,fshift,its,lits,xx);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   its = its*lits;
 
   if (fshift != a->fshift || omega != a->omega) a->idiagvalid = PETSC_FALSE; /* must recompute idiag[] */
@@ -3010,7 +3017,7 @@ PetscErrorCode  MatInvertBlockDiagonal_SeqAIJ(Mat A,const PetscScalar **values)
     break;
   case 7:
     for (i=0; i<mbs; i++) {
-      ij[0] = 7*i; ij[1] = 7*i + 1; ij[2] = 7*i + 2; ij[3] = 7*i + 3; ij[4] = 7*i + 4; ij[5] = 7*i + 5; ij[5] = 7*i + 6;
+      ij[0] = 7*i; ij[1] = 7*i + 1; ij[2] = 7*i + 2; ij[3] = 7*i + 3; ij[4] = 7*i + 4; ij[5] = 7*i + 5; ij[6] = 7*i + 6;
       ierr  = MatGetValues(A,7,ij,7,ij,diag);CHKERRQ(ierr);
       ierr  = PetscKernel_A_gets_inverse_A_7(diag,shift);CHKERRQ(ierr);
       ierr  = PetscKernel_A_gets_transpose_A_7(diag);CHKERRQ(ierr);
@@ -3456,7 +3463,11 @@ PetscErrorCode  MatRetrieveValues(Mat mat)
 
    Options Database Keys:
 +  -mat_no_inode  - Do not use inodes
--  -mat_inode_limit <limit> - Sets inode limit (max limit=5)
+.  -mat_inode_limit <limit> - Sets inode limit (max limit=5)
+.  -mat_sor_multicolor - Order the rows by color in MatSOR(), relaxing the rows of each color at the same time
+.  -mat_solve_levels - Solve with the LU and ILU factors level by level, solving the rows of each level at the same time
+.  -mat_factor_sweeps <n> - Compute ILU factors with n fixed-point sweeps, computing all the entries of each sweep at the same time
+-  -mat_solve_sweeps <n> - Replace each triangular solve with the factors by n Jacobi sweeps
 
    Level: intermediate
 
@@ -3520,6 +3531,10 @@ PetscErrorCode  MatCreateSeqAIJ(MPI_Comm comm,PetscInt m,PetscInt n,PetscInt nz,
    Options Database Keys:
 +  -mat_no_inode  - Do not use inodes
 .  -mat_inode_limit <limit> - Sets inode limit (max limit=5)
+.  -mat_sor_multicolor - Order the rows by color in MatSOR(), relaxing the rows of each color at the same time
+.  -mat_solve_levels - Solve with the LU and ILU factors level by level, solving the rows of each level at the same time
+.  -mat_factor_sweeps <n> - Compute ILU factors with n fixed-point sweeps, computing all the entries of each sweep at the same time
+.  -mat_solve_sweeps <n> - Replace each triangular solve with the factors by n Jacobi sweeps
 -  -mat_aij_oneindex - Internally use indexing starting at 1
         rather than 0.  Note that when calling MatSetValues(),
         the user still MUST index entries starting at 0!
@@ -4058,6 +4073,7 @@ PetscErrorCode MatDuplicateNoCreate_SeqAIJ(Mat C,Mat A,MatDuplicateOption cpvalu
   c->saved_values       = 0;
   c->idiag              = 0;
   c->ssor_work          = 0;
+  c->multicolor.use     = a->multicolor.use;
   c->keepnonzeropattern = a->keepnonzeropattern;
   c->free_a             = PETSC_TRUE;
   c->free_ij            = PETSC_TRUE;
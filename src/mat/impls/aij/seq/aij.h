@@ -93,6 +93,39 @@ typedef struct {
   PetscObjectState mat_nonzerostate;               /* non-zero state when inodes were checked for */
 } Mat_SeqAIJ_Inode;
 
+/* Info about the multicolor ordering used by MatSOR_SeqAIJ_MultiColor() */
+typedef struct {
+  PetscBool        use;                            /* sweep by colors in MatSOR() */
+  PetscInt         ncolors;                        /* number of colors */
+  PetscInt         *offsets;                       /* rows of color c are rows[offsets[c]] to rows[offsets[c+1]-1] */
+  PetscInt         *rows;                          /* rows ordered by color */
+  PetscInt         *i,*j;                          /* off-diagonal part of the matrix, with its rows in that order */
+  MatScalar        *a;
+  PetscObjectState mat_nonzerostate;               /* non-zero state when the coloring was computed */
+  PetscObjectState mat_state;                      /* state when a[] was copied */
+} Mat_SeqAIJ_MultiColor;
+
+/* Info about the level schedule of an LU factor used by MatSolve_SeqAIJ_Levels() */
+typedef struct {
+  PetscBool        use;                            /* solve level by level after each numeric factorization */
+  PetscInt         lnlevels,unlevels;              /* number of levels of L and of U */
+  PetscInt         *loffsets,*lrows;               /* rows of level k of L are lrows[loffsets[k]] to lrows[loffsets[k+1]-1] */
+  PetscInt         *uoffsets,*urows;               /* likewise for U, whose levels are solved from the last row up */
+  PetscInt         *li,*lj,*ui,*uj;                /* strictly triangular parts of L and U, with their rows in level order */
+  MatScalar        *la,*ua;
+  MatScalar        *uidiag;                        /* inverse of the diagonal of U, in the level order of U */
+} Mat_SeqAIJ_Levels;
+
+/* Info about the fixed-point ILU factorization and the Jacobi triangular solves, see iterfact.c */
+typedef struct {
+  PetscInt         fsweeps;                        /* sweeps of the iterative ILU factorization, 0 for the exact factorization */
+  PetscInt         ssweeps;                        /* Jacobi sweeps replacing each triangular solve, 0 for the exact solves */
+  PetscBool        initialized;                    /* the factor holds values from an earlier factorization, the initial guess */
+  PetscInt         nwork;                          /* number of rows of length n in work, one per thread */
+  MatScalar        *work,*anew;                    /* dense rows for the sweeps and the values of the next sweep */
+  PetscScalar      *solve_work;                    /* two vectors of length n for the Jacobi solves */
+} Mat_SeqAIJ_Iterative;
+
 PETSC_INTERN PetscErrorCode MatView_SeqAIJ_Inode(Mat,PetscViewer);
 PETSC_INTERN PetscErrorCode MatAssemblyEnd_SeqAIJ_Inode(Mat,MatAssemblyType);
 PETSC_INTERN PetscErrorCode MatDestroy_SeqAIJ_Inode(Mat);
@@ -106,6 +139,9 @@ PETSC_INTERN PetscErrorCode MatLUFactorNumeric_SeqAIJ_Inode(Mat,Mat,const MatFac
 typedef struct {
   SEQAIJHEADER(MatScalar);
   Mat_SeqAIJ_Inode inode;
+  Mat_SeqAIJ_MultiColor multicolor;
+  Mat_SeqAIJ_Levels levels;
+  Mat_SeqAIJ_Iterative iterative;
   MatScalar        *saved_values;             /* location for stashing nonzero values of matrix */
 
   PetscScalar *idiag,*mdiag,*ssor_work;       /* inverse of diagonal entries, diagonal values and workspace for Eisenstat trick */
@@ -201,6 +237,7 @@ PETSC_INTERN PetscErrorCode MatMultAdd_SeqAIJ(Mat A,Vec,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatMultTranspose_SeqAIJ(Mat A,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatMultTransposeAdd_SeqAIJ(Mat A,Vec,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatSOR_SeqAIJ(Mat,Vec,PetscReal,MatSORType,PetscReal,PetscInt,PetscInt,Vec);
+PETSC_INTERN PetscErrorCode MatInvertDiagonal_SeqAIJ(Mat,PetscScalar,PetscScalar);
 
 PETSC_INTERN PetscErrorCode MatSetOption_SeqAIJ(Mat,MatOption,PetscBool);
 PETSC_INTERN PetscErrorCode MatSetColoring_SeqAIJ(Mat,ISColoring);
@@ -299,6 +336,14 @@ PETSC_INTERN PetscErrorCode MatView_SeqAIJ(Mat,PetscViewer);
 PETSC_INTERN PetscErrorCode MatSeqAIJInvalidateDiagonal(Mat);
 PETSC_INTERN PetscErrorCode MatSeqAIJInvalidateDiagonal_Inode(Mat);
 PETSC_INTERN PetscErrorCode MatSeqAIJCheckInode(Mat);
+PETSC_INTERN PetscErrorCode MatSOR_SeqAIJ_MultiColor(Mat,Vec,PetscReal,MatSORType,PetscReal,PetscInt,PetscInt,Vec);
+PETSC_INTERN PetscErrorCode MatDestroy_SeqAIJ_MultiColor(Mat);
+PETSC_INTERN PetscErrorCode MatLUFactorSetUpLevels_SeqAIJ(Mat);
+PETSC_INTERN PetscErrorCode MatSolve_SeqAIJ_Levels(Mat,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatDestroy_SeqAIJ_Levels(Mat);
+PETSC_INTERN PetscErrorCode MatILUFactorNumeric_SeqAIJ_Iterative(Mat,Mat,const MatFactorInfo*);
+PETSC_INTERN PetscErrorCode MatSolve_SeqAIJ_Jacobi(Mat,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatDestroy_SeqAIJ_Iterative(Mat);
 PETSC_INTERN PetscErrorCode MatSeqAIJCheckInode_FactorLU(Mat);
 
 PETSC_INTERN PetscErrorCode MatAXPYGetPreallocation_SeqAIJ(Mat,Mat,PetscInt*);
@@ -600,6 +600,8 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ(Mat B,Mat A,const MatFactorInfo *info)
   } else {
     C->ops->solve = MatSolve_SeqAIJ;
   }
+  if (b->levels.use) {ierr = MatLUFactorSetUpLevels_SeqAIJ(C);CHKERRQ(ierr);}
+  if (b->iterative.ssweeps) C->ops->solve = MatSolve_SeqAIJ_Jacobi;
   C->ops->solveadd          = MatSolveAdd_SeqAIJ;
   C->ops->solvetranspose    = MatSolveTranspose_SeqAIJ;
   C->ops->solvetransposeadd = MatSolveTransposeAdd_SeqAIJ;
@@ -1737,6 +1739,9 @@ PetscErrorCode MatILUFactorSymbolic_SeqAIJ(Mat fact,Mat A,IS isrow,IS iscol,cons
     if (a->inode.size) {
       fact->ops->lufactornumeric = MatLUFactorNumeric_SeqAIJ_Inode;
     }
+    b    = (Mat_SeqAIJ*)fact->data;
+    ierr = MatDestroy_SeqAIJ_Iterative(fact);CHKERRQ(ierr);
+    if (b->iterative.fsweeps) fact->ops->lufactornumeric = MatILUFactorNumeric_SeqAIJ_Iterative;
     PetscFunctionReturn(0);
   }
 
@@ -1877,6 +1882,8 @@ PetscErrorCode MatILUFactorSymbolic_SeqAIJ(Mat fact,Mat A,IS isrow,IS iscol,cons
   if (a->inode.size) {
     (fact)->ops->lufactornumeric = MatLUFactorNumeric_SeqAIJ_Inode;
   }
+  ierr = MatDestroy_SeqAIJ_Iterative(fact);CHKERRQ(ierr);
+  if (b->iterative.fsweeps) (fact)->ops->lufactornumeric = MatILUFactorNumeric_SeqAIJ_Iterative;
   ierr = MatSeqAIJCheckInode_FactorLU(fact);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
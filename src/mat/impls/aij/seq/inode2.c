@@ -25,6 +25,11 @@ PetscErrorCode MatView_SeqAIJ_Inode(Mat A,PetscViewer viewer)
       } else {
         ierr = PetscViewerASCIIPrintf(viewer,"not using I-node routines\n");CHKERRQ(ierr);
       }
+      if (a->multicolor.use && a->multicolor.ncolors) {
+        ierr = PetscViewerASCIIPrintf(viewer,"using multicolor SOR with %D colors\n",a->multicolor.ncolors);CHKERRQ(ierr);
+      } else if (a->multicolor.use) {
+        ierr = PetscViewerASCIIPrintf(viewer,"using multicolor SOR\n");CHKERRQ(ierr);
+      }
     }
   }
   PetscFunctionReturn(0);
@@ -92,6 +97,10 @@ PetscErrorCode MatCreate_SeqAIJ_Inode(Mat B)
     ierr = PetscInfo(B,"Not using Inode routines due to -mat_no_inode\n");CHKERRQ(ierr);
   }
   ierr = PetscOptionsInt("-mat_inode_limit","Do not use inodes larger then this value",NULL,b->inode.limit,&b->inode.limit,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-mat_sor_multicolor","Order the rows by color in MatSOR()","MatSOR",b->multicolor.use,&b->multicolor.use,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-mat_solve_levels","Solve with LU and ILU factors level by level","MatSolve",b->levels.use,&b->levels.use,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-mat_factor_sweeps","Number of fixed-point sweeps of an iterative ILU factorization","MatLUFactorNumeric",b->iterative.fsweeps,&b->iterative.fsweeps,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-mat_solve_sweeps","Number of Jacobi sweeps replacing each triangular solve with the factor","MatSolve",b->iterative.ssweeps,&b->iterative.ssweeps,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsEnd();CHKERRQ(ierr);
 
   b->inode.use = (PetscBool)(!(no_unroll || no_inode));
@@ -0,0 +1,288 @@
+/*
+    Fixed-point ILU factorization and Jacobi triangular solves for SeqAIJ. Each sweep of the factorization computes
+    every entry of L and U in the ILU pattern from the values of the previous sweep,
+
+       l_ij = (a_ij - sum_{k<j} l_ik u_kj)/u_jj   for i > j,     u_ij = a_ij - sum_{k<i} l_ik u_kj   for i <= j,
+
+    so all the rows are computed at the same time and the result does not depend on the number of threads. The
+    triangular solves may likewise be replaced by a few Jacobi sweeps, each one a product with the strictly
+    triangular part of the factor.
+*/
+#include <../src/mat/impls/aij/seq/aij.h>
+#if defined(PETSC_HAVE_OPENMP)
+#include <omp.h>
+#endif
+
+/* Below this number of nonzeros in the factor the sweeps run on one thread */
+#define MATITERATIVE_THREAD_NZ 8192
+
+#undef __FUNCT__
+#define __FUNCT__ "MatDestroy_SeqAIJ_Iterative"
+PetscErrorCode MatDestroy_SeqAIJ_Iterative(Mat A)
+{
+  Mat_SeqAIJ           *a  = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJ_Iterative *it = &a->iterative;
+  PetscErrorCode       ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree2(it->work,it->anew);CHKERRQ(ierr);
+  ierr = PetscFree(it->solve_work);CHKERRQ(ierr);
+  it->nwork       = 0;
+  it->initialized = PETSC_FALSE;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatILUFactorSweep_SeqAIJ_Private"
+/*
+   One sweep of the fixed-point factorization, computing the factor anew[] from the factor aold[]. When init is set the
+   factor is instead the initial guess, U the upper triangular part of A and L its lower triangular part scaled by the
+   diagonal. The rows are scattered to a dense row of work per thread, as in MatLUFactorNumeric_SeqAIJ(), so the
+   updates to entries outside the pattern are computed and dropped.
+
+   Returns the row of a zero pivot in zrow, or -1
+*/
+static PetscErrorCode MatILUFactorSweep_SeqAIJ_Private(Mat fact,Mat A,const PetscInt r[],const PetscInt ic[],PetscBool init,const MatScalar aold[],MatScalar anew[],PetscInt *zrow)
+{
+  Mat_SeqAIJ           *a  = (Mat_SeqAIJ*)A->data,*b = (Mat_SeqAIJ*)fact->data;
+  Mat_SeqAIJ_Iterative *it = &b->iterative;
+  const PetscInt       n   = A->rmap->n,*ai = a->i,*aj = a->j,*bi = b->i,*bj = b->j,*bdiag = b->diag;
+  const MatScalar      *aa = a->a;
+  PetscInt             zero = -1;
+
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel if (b->nz > MATITERATIVE_THREAD_NZ)
+#endif
+  {
+    MatScalar       *w = it->work;
+    const PetscInt  *pj;
+    const MatScalar *pv;
+    MatScalar       lik;
+    PetscInt        i,j,k,t,nz,nzL;
+
+#if defined(PETSC_HAVE_OPENMP)
+    w += omp_get_thread_num()*n;
+#endif
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+    for (i=0; i<n; i++) {
+      /* zero the pattern of row i, then load the row of A */
+      pj = bj + bi[i];
+      nz = bi[i+1] - bi[i];
+      for (j=0; j<nz; j++) w[pj[j]] = 0.0;
+      pj = bj + bdiag[i+1] + 1;
+      nz = bdiag[i] - bdiag[i+1];
+      for (j=0; j<nz; j++) w[pj[j]] = 0.0;
+      pj = aj + ai[r[i]];
+      pv = aa + ai[r[i]];
+      nz = ai[r[i]+1] - ai[r[i]];
+      for (j=0; j<nz; j++) w[ic[pj[j]]] = pv[j];
+
+      if (!init) {
+        /* subtract l_ik u_kj for each k in row i of L; the columns of U(k,:) are all larger than k */
+        nzL = bi[i+1] - bi[i];
+        for (t=0; t<nzL; t++) {
+          k   = bj[bi[i]+t];
+          lik = aold[bi[i]+t];
+          pj  = bj + bdiag[k+1] + 1;
+          pv  = aold + bdiag[k+1] + 1;
+          nz  = bdiag[k] - bdiag[k+1] - 1;
+          for (j=0; j<nz; j++) w[pj[j]] -= lik*pv[j];
+        }
+      }
+
+      /* L(i,j) is divided by U(j,j) of the previous sweep, whose inverse is stored in the factor */
+      pj = bj + bi[i];
+      nz = bi[i+1] - bi[i];
+      if (init) {for (j=0; j<nz; j++) anew[bi[i]+j] = w[pj[j]];}
+      else      {for (j=0; j<nz; j++) anew[bi[i]+j] = w[pj[j]]*aold[bdiag[pj[j]]];}
+      pj = bj + bdiag[i+1] + 1;
+      nz = bdiag[i] - bdiag[i+1] - 1;
+      for (j=0; j<nz; j++) anew[bdiag[i+1]+1+j] = w[pj[j]];
+      if (w[i] == 0.0) {
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp critical
+#endif
+        zero = i;
+        anew[bdiag[i]] = 0.0;
+      } else anew[bdiag[i]] = 1.0/w[i];
+    }
+
+    /* scale the initial L by the diagonal of A */
+    if (init) {
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+      for (i=0; i<n; i++) {
+        for (t=bi[i]; t<bi[i+1]; t++) anew[t] *= anew[bdiag[bj[t]]];
+      }
+    }
+  }
+  *zrow = zero;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatILUFactorNumeric_SeqAIJ_Iterative"
+/*
+   MatILUFactorNumeric_SeqAIJ_Iterative - Numeric ILU factorization by fixed-point sweeps, installed by the ILU
+   symbolic factorization with the -mat_factor_sweeps option.
+
+   The first factorization starts from the triangular parts of A, later ones start from the previous factor, so a
+   factor refreshed for slowly changing values needs few sweeps.
+*/
+PetscErrorCode MatILUFactorNumeric_SeqAIJ_Iterative(Mat B,Mat A,const MatFactorInfo *info)
+{
+  Mat                  C   = B;
+  Mat_SeqAIJ           *b  = (Mat_SeqAIJ*)C->data;
+  Mat_SeqAIJ_Iterative *it = &b->iterative;
+  IS                   isrow = b->row,isicol = b->icol;
+  const PetscInt       n = A->rmap->n,*bdiag = b->diag;
+  const PetscInt       *r,*ic;
+  PetscInt             s,nwork = 1,zrow,nzL,nzU;
+  PetscBool            row_identity,col_identity;
+  PetscErrorCode       ierr;
+
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_OPENMP)
+  nwork = omp_get_max_threads();
+#endif
+  if (it->nwork != nwork) {
+    ierr      = PetscFree2(it->work,it->anew);CHKERRQ(ierr);
+    ierr      = PetscMalloc2(nwork*n,&it->work,bdiag[0]+1,&it->anew);CHKERRQ(ierr);
+    it->nwork = nwork;
+  }
+  ierr = ISGetIndices(isrow,&r);CHKERRQ(ierr);
+  ierr = ISGetIndices(isicol,&ic);CHKERRQ(ierr);
+  if (!it->initialized) {
+    ierr = MatILUFactorSweep_SeqAIJ_Private(C,A,r,ic,PETSC_TRUE,NULL,b->a,&zrow);CHKERRQ(ierr);
+    if (zrow >= 0) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_MAT_LU_ZRPVT,"Zero pivot in row %D",zrow);
+    it->initialized = PETSC_TRUE;
+  }
+  for (s=0; s<it->fsweeps; s++) {
+    ierr = MatILUFactorSweep_SeqAIJ_Private(C,A,r,ic,PETSC_FALSE,b->a,it->anew,&zrow);CHKERRQ(ierr);
+    if (zrow >= 0) {
+      it->initialized = PETSC_FALSE;
+      SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_MAT_LU_ZRPVT,"Zero pivot in row %D in sweep %D",zrow,s);
+    }
+    ierr = PetscMemcpy(b->a,it->anew,(bdiag[0]+1)*sizeof(MatScalar));CHKERRQ(ierr);
+  }
+  ierr = ISRestoreIndices(isicol,&ic);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(isrow,&r);CHKERRQ(ierr);
+  nzL  = b->i[n];
+  nzU  = bdiag[0] - bdiag[n] - n;
+  ierr = PetscInfo3(C,"%D sweeps over %D entries of L and %D of U\n",it->fsweeps,nzL,nzU);CHKERRQ(ierr);
+
+  ierr = ISIdentity(isrow,&row_identity);CHKERRQ(ierr);
+  ierr = ISIdentity(isicol,&col_identity);CHKERRQ(ierr);
+  if (b->inode.size) {
+    C->ops->solve = MatSolve_SeqAIJ_Inode;
+  } else if (row_identity && col_identity) {
+    C->ops->solve = MatSolve_SeqAIJ_NaturalOrdering;
+  } else {
+    C->ops->solve = MatSolve_SeqAIJ;
+  }
+  if (b->levels.use) {ierr = MatLUFactorSetUpLevels_SeqAIJ(C);CHKERRQ(ierr);}
+  if (it->ssweeps) C->ops->solve = MatSolve_SeqAIJ_Jacobi;
+  C->ops->solveadd          = MatSolveAdd_SeqAIJ;
+  C->ops->solvetranspose    = MatSolveTranspose_SeqAIJ;
+  C->ops->solvetransposeadd = MatSolveTransposeAdd_SeqAIJ;
+  C->ops->matsolve          = MatMatSolve_SeqAIJ;
+  C->assembled              = PETSC_TRUE;
+  C->preallocated           = PETSC_TRUE;
+
+  ierr = PetscLogFlops(it->fsweeps*2.0*b->nz);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatSolve_SeqAIJ_Jacobi"
+/*
+   MatSolve_SeqAIJ_Jacobi - Approximate solve with the LU or ILU factor, each triangular solve replaced by a fixed number
+   of Jacobi sweeps started from the right hand side. The result is a linear function of the right hand side, so it
+   may be used as a preconditioner in any Krylov method.
+*/
+PetscErrorCode MatSolve_SeqAIJ_Jacobi(Mat A,Vec bb,Vec xx)
+{
+  Mat_SeqAIJ           *a  = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJ_Iterative *it = &a->iterative;
+  IS                   iscol = a->col,isrow = a->row;
+  PetscInt             n = A->rmap->n;
+  const PetscInt       *r,*c,*ai = a->i,*aj = a->j,*adiag = a->diag;
+  const MatScalar      *aa = a->a;
+  PetscScalar          *x,*tmp = a->solve_work;
+  const PetscScalar    *b;
+  PetscErrorCode       ierr;
+
+  PetscFunctionBegin;
+  if (!n) PetscFunctionReturn(0);
+  if (!it->solve_work) {ierr = PetscMalloc1(2*n,&it->solve_work);CHKERRQ(ierr);}
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecGetArray(xx,&x);CHKERRQ(ierr);
+  ierr = ISGetIndices(isrow,&r);CHKERRQ(ierr);
+  ierr = ISGetIndices(iscol,&c);CHKERRQ(ierr);
+
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel if (a->nz > MATITERATIVE_THREAD_NZ)
+#endif
+  {
+    PetscScalar     *rhs = tmp,*cur = it->solve_work,*next = it->solve_work + n,*swap,sum;
+    const PetscInt  *vi;
+    const MatScalar *v;
+    PetscInt        i,s,nz;
+
+    /* L has a unit diagonal, so the sweeps are cur = rhs - (L - I) cur */
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+    for (i=0; i<n; i++) cur[i] = rhs[i] = b[r[i]];
+    for (s=0; s<it->ssweeps; s++) {
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+      for (i=0; i<n; i++) {
+        v   = aa + ai[i];
+        vi  = aj + ai[i];
+        nz  = ai[i+1] - ai[i];
+        sum = rhs[i];
+        PetscSparseDenseMinusDot(sum,cur,v,vi,nz);
+        next[i] = sum;
+      }
+      swap = cur; cur = next; next = swap;
+    }
+
+    /* the solution of L is the right hand side of U, the sweeps are cur = D^{-1} (rhs - (U - D) cur) */
+    swap = rhs; rhs = cur; cur = swap;
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+    for (i=0; i<n; i++) cur[i] = rhs[i]*aa[adiag[i]];
+    for (s=0; s<it->ssweeps; s++) {
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+      for (i=0; i<n; i++) {
+        v   = aa + adiag[i+1] + 1;
+        vi  = aj + adiag[i+1] + 1;
+        nz  = adiag[i] - adiag[i+1] - 1;
+        sum = rhs[i];
+        PetscSparseDenseMinusDot(sum,cur,v,vi,nz);
+        next[i] = sum*aa[adiag[i]];
+      }
+      swap = cur; cur = next; next = swap;
+    }
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+    for (i=0; i<n; i++) x[c[i]] = cur[i];
+  }
+
+  ierr = ISRestoreIndices(isrow,&r);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(iscol,&c);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecRestoreArray(xx,&x);CHKERRQ(ierr);
+  ierr = PetscLogFlops(it->ssweeps*(2.0*a->nz - A->cmap->n) + A->cmap->n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -0,0 +1,216 @@
+/*
+    Multicolor SOR for the SeqAIJ format. The rows of each color of a distance one coloring of the matrix graph do not
+    couple, so all rows of a color are relaxed at the same time, one thread per block of rows.
+*/
+#include <../src/mat/impls/aij/seq/aij.h>
+
+/* Below this number of nonzeros the sweeps run on one thread */
+#define MATSOR_MULTICOLOR_THREAD_NZ 8192
+
+#undef __FUNCT__
+#define __FUNCT__ "MatDestroy_SeqAIJ_MultiColor"
+PetscErrorCode MatDestroy_SeqAIJ_MultiColor(Mat A)
+{
+  Mat_SeqAIJ            *a  = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJ_MultiColor *mc = &a->multicolor;
+  PetscErrorCode        ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree(mc->offsets);CHKERRQ(ierr);
+  ierr = PetscFree2(mc->rows,mc->i);CHKERRQ(ierr);
+  ierr = PetscFree2(mc->j,mc->a);CHKERRQ(ierr);
+  mc->ncolors = 0;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatSeqAIJMultiColorColor_Private"
+/*
+   Colors the graph of G, returning the color of each row and the rows of each color
+*/
+static PetscErrorCode MatSeqAIJMultiColorColor_Private(Mat G,PetscInt *ncolors,PetscInt offsets[],PetscInt rows[],PetscInt color[])
+{
+  MatColoring    mc;
+  ISColoring     iscoloring;
+  IS             *is;
+  const PetscInt *idx;
+  PetscInt       c,k,n;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatColoringCreate(G,&mc);CHKERRQ(ierr);
+  ierr = MatColoringSetType(mc,MATCOLORINGGREEDY);CHKERRQ(ierr);
+  ierr = MatColoringSetDistance(mc,1);CHKERRQ(ierr);
+  ierr = MatColoringSetWeightType(mc,MAT_COLORING_WEIGHT_LEXICAL);CHKERRQ(ierr);
+  ierr = MatColoringApply(mc,&iscoloring);CHKERRQ(ierr);
+  ierr = MatColoringDestroy(&mc);CHKERRQ(ierr);
+  ierr = ISColoringGetIS(iscoloring,ncolors,&is);CHKERRQ(ierr);
+  offsets[0] = 0;
+  for (c=0; c<*ncolors; c++) {
+    ierr = ISGetLocalSize(is[c],&n);CHKERRQ(ierr);
+    ierr = ISGetIndices(is[c],&idx);CHKERRQ(ierr);
+    for (k=0; k<n; k++) {
+      rows[offsets[c]+k] = idx[k];
+      color[idx[k]]      = c;
+    }
+    ierr = ISRestoreIndices(is[c],&idx);CHKERRQ(ierr);
+    offsets[c+1] = offsets[c] + n;
+  }
+  ierr = ISColoringRestoreIS(iscoloring,&is);CHKERRQ(ierr);
+  ierr = ISColoringDestroy(&iscoloring);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatSeqAIJMultiColorSetUp_Private"
+/*
+   Orders the rows by color and copies their off-diagonal entries in that order. The coloring is only recomputed when
+   the nonzero structure changes, and the entries only copied again when the matrix changes.
+*/
+static PetscErrorCode MatSeqAIJMultiColorSetUp_Private(Mat A)
+{
+  Mat_SeqAIJ            *a  = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJ_MultiColor *mc = &a->multicolor;
+  const PetscInt        *ai = a->i,*aj = a->j;
+  const MatScalar       *aa = a->a;
+  PetscInt              m   = A->rmap->n,r,k,l,row;
+  PetscObjectState      state;
+  PetscBool             copy = PETSC_FALSE;
+  PetscErrorCode        ierr;
+
+  PetscFunctionBegin;
+  if (!mc->rows || mc->mat_nonzerostate != A->nonzerostate) {
+    Mat      G,Gt;
+    PetscInt *offsets,*color;
+
+    ierr = MatDestroy_SeqAIJ_MultiColor(A);CHKERRQ(ierr);
+    ierr = PetscMalloc2(m,&mc->rows,m+1,&mc->i);CHKERRQ(ierr);
+    ierr = PetscMalloc2(m+1,&offsets,m,&color);CHKERRQ(ierr);
+    /* A plain SeqAIJ matrix sharing the structure, since the coloring does not accept the subclasses of SeqAIJ */
+    ierr = MatCreateSeqAIJWithArrays(PETSC_COMM_SELF,m,A->cmap->n,a->i,a->j,a->a,&G);CHKERRQ(ierr);
+    ierr = MatSeqAIJMultiColorColor_Private(G,&mc->ncolors,offsets,mc->rows,color);CHKERRQ(ierr);
+    /* The greedy coloring only looks at the rows, so rows of the same color may couple if the structure is not symmetric */
+    for (row=0; row<m; row++) {
+      for (k=ai[row]; k<ai[row+1]; k++) if (aj[k] != row && color[aj[k]] == color[row]) break;
+      if (k < ai[row+1]) break;
+    }
+    if (row < m) {
+      ierr = PetscInfo(A,"Coloring the symmetrized graph since the nonzero structure is not symmetric\n");CHKERRQ(ierr);
+      ierr = MatTranspose(G,MAT_INITIAL_MATRIX,&Gt);CHKERRQ(ierr);
+      ierr = MatAXPY(Gt,1.0,G,DIFFERENT_NONZERO_PATTERN);CHKERRQ(ierr);
+      ierr = MatSeqAIJMultiColorColor_Private(Gt,&mc->ncolors,offsets,mc->rows,color);CHKERRQ(ierr);
+      ierr = MatDestroy(&Gt);CHKERRQ(ierr);
+    }
+    ierr = MatDestroy(&G);CHKERRQ(ierr);
+    ierr = PetscMalloc1(mc->ncolors+1,&mc->offsets);CHKERRQ(ierr);
+    ierr = PetscMemcpy(mc->offsets,offsets,(mc->ncolors+1)*sizeof(PetscInt));CHKERRQ(ierr);
+    ierr = PetscFree2(offsets,color);CHKERRQ(ierr);
+
+    mc->i[0] = 0;
+    for (r=0; r<m; r++) {
+      row        = mc->rows[r];
+      mc->i[r+1] = mc->i[r];
+      for (k=ai[row]; k<ai[row+1]; k++) if (aj[k] != row) mc->i[r+1]++;
+    }
+    ierr = PetscMalloc2(mc->i[m],&mc->j,mc->i[m],&mc->a);CHKERRQ(ierr);
+    ierr = PetscLogObjectMemory((PetscObject)A,(mc->ncolors+2*m+2)*sizeof(PetscInt)+mc->i[m]*(sizeof(PetscInt)+sizeof(MatScalar)));CHKERRQ(ierr);
+    for (r=0; r<m; r++) {
+      row = mc->rows[r];
+      for (k=ai[row],l=mc->i[r]; k<ai[row+1]; k++) if (aj[k] != row) mc->j[l++] = aj[k];
+    }
+    ierr = PetscInfo2(A,"Multicolor SOR with %D colors for %D rows\n",mc->ncolors,m);CHKERRQ(ierr);
+    mc->mat_nonzerostate = A->nonzerostate;
+    copy                 = PETSC_TRUE;
+  }
+  ierr = PetscObjectStateGet((PetscObject)A,&state);CHKERRQ(ierr);
+  if (copy || mc->mat_state != state) {
+    for (r=0; r<m; r++) {
+      row = mc->rows[r];
+      for (k=ai[row],l=mc->i[r]; k<ai[row+1]; k++) if (aj[k] != row) mc->a[l++] = aa[k];
+    }
+    mc->mat_state = state;
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatSeqAIJMultiColorSweep_Private"
+/*
+   One sweep over the colors, in increasing order if forward and else in decreasing order. The rows of a color are split
+   between the threads, and each row only reads entries of x[] belonging to the other colors.
+*/
+static PetscErrorCode MatSeqAIJMultiColorSweep_Private(Mat_SeqAIJ_MultiColor *mc,const PetscScalar *b,const PetscScalar *idiag,PetscReal omega,PetscBool forward,PetscScalar *x)
+{
+  const PetscInt  nc = mc->ncolors,*offsets = mc->offsets,*rows = mc->rows,*mi = mc->i,*mj = mc->j;
+  const MatScalar *ma = mc->a;
+
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel if (mi[offsets[nc]] > MATSOR_MULTICOLOR_THREAD_NZ)
+#endif
+  {
+    PetscInt s,c,r;
+
+    for (s=0; s<nc; s++) {
+      c = forward ? s : nc-1-s;
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+      for (r=offsets[c]; r<offsets[c+1]; r++) {
+        const PetscInt  row = rows[r],*idx = mj + mi[r];
+        const MatScalar *v  = ma + mi[r];
+        PetscInt        n   = mi[r+1] - mi[r];
+        PetscScalar     sum = b[row];
+
+        PetscSparseDenseMinusDot(sum,x,v,idx,n);
+        x[row] = (1. - omega)*x[row] + sum*idiag[row]; /* omega in idiag */
+      }
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatSOR_SeqAIJ_MultiColor"
+/*
+   MatSOR_SeqAIJ_MultiColor - SOR with the rows ordered by the colors of a coloring of the matrix graph
+
+   A forward sweep relaxes the colors in increasing order and a backward sweep in decreasing order, so a symmetric sweep
+   is a symmetric operator as with the natural ordering. The Eisenstat trick and the application of the triangular
+   parts are defined by the natural ordering and are left to MatSOR_SeqAIJ().
+*/
+PetscErrorCode MatSOR_SeqAIJ_MultiColor(Mat A,Vec bb,PetscReal omega,MatSORType flag,PetscReal fshift,PetscInt its,PetscInt lits,Vec xx)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  PetscScalar       *x;
+  const PetscScalar *b;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (flag & (SOR_EISENSTAT | SOR_APPLY_UPPER | SOR_APPLY_LOWER)) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"No support for Eisenstat or applying a triangular part with multicolor SOR");
+  if (A->rmap->n != A->cmap->n) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_SIZ,"Multicolor SOR requires a square matrix, not %D by %D",A->rmap->n,A->cmap->n);
+  its = its*lits;
+
+  if (fshift != a->fshift || omega != a->omega) a->idiagvalid = PETSC_FALSE; /* must recompute idiag[] */
+  if (!a->idiagvalid) {ierr = MatInvertDiagonal_SeqAIJ(A,omega,fshift);CHKERRQ(ierr);}
+  a->fshift = fshift;
+  a->omega  = omega;
+  ierr = MatSeqAIJMultiColorSetUp_Private(A);CHKERRQ(ierr);
+
+  ierr = VecGetArray(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  if (flag & SOR_ZERO_INITIAL_GUESS) {ierr = PetscMemzero(x,A->rmap->n*sizeof(PetscScalar));CHKERRQ(ierr);}
+  while (its--) {
+    if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
+      ierr = MatSeqAIJMultiColorSweep_Private(&a->multicolor,b,a->idiag,omega,PETSC_TRUE,x);CHKERRQ(ierr);
+      ierr = PetscLogFlops(2.0*a->nz + 2.0*A->rmap->n);CHKERRQ(ierr);
+    }
+    if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
+      ierr = MatSeqAIJMultiColorSweep_Private(&a->multicolor,b,a->idiag,omega,PETSC_FALSE,x);CHKERRQ(ierr);
+      ierr = PetscLogFlops(2.0*a->nz + 2.0*A->rmap->n);CHKERRQ(ierr);
+    }
+  }
+  ierr = VecRestoreArray(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -0,0 +1,187 @@
+/*
+    Level scheduled triangular solves for the SeqAIJ LU and ILU factors. A row of L is in level k when the rows it
+    depends on are in levels below k, so all rows of a level are solved at the same time, one thread per block of
+    rows, and likewise for U from the last row up.
+*/
+#include <../src/mat/impls/aij/seq/aij.h>
+
+/* Below this average number of rows per level the rows are solved one at a time */
+#define MATSOLVE_LEVELS_MIN_ROWS 8
+/* Below this number of nonzeros in the factor the solves run on one thread */
+#define MATSOLVE_LEVELS_THREAD_NZ 8192
+
+#undef __FUNCT__
+#define __FUNCT__ "MatDestroy_SeqAIJ_Levels"
+PetscErrorCode MatDestroy_SeqAIJ_Levels(Mat A)
+{
+  Mat_SeqAIJ        *a  = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJ_Levels *lv = &a->levels;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree2(lv->loffsets,lv->uoffsets);CHKERRQ(ierr);
+  ierr = PetscFree4(lv->lrows,lv->urows,lv->li,lv->ui);CHKERRQ(ierr);
+  ierr = PetscFree5(lv->lj,lv->la,lv->uj,lv->ua,lv->uidiag);CHKERRQ(ierr);
+  lv->lnlevels = lv->unlevels = 0;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatSeqAIJSortLevels_Private"
+/*
+   Orders the rows by level, keeping the rows of each level in increasing order, and counts the rows of each level
+*/
+static PetscErrorCode MatSeqAIJSortLevels_Private(PetscInt n,const PetscInt level[],PetscInt nlevels,PetscInt offsets[],PetscInt rows[])
+{
+  PetscInt       i,k;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscMemzero(offsets,(nlevels+1)*sizeof(PetscInt));CHKERRQ(ierr);
+  for (i=0; i<n; i++) offsets[level[i]+1]++;
+  for (k=0; k<nlevels; k++) offsets[k+1] += offsets[k];
+  for (i=0; i<n; i++) rows[offsets[level[i]]++] = i;
+  for (k=nlevels; k>0; k--) offsets[k] = offsets[k-1];
+  offsets[0] = 0;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatLUFactorSetUpLevels_SeqAIJ"
+/*
+   MatLUFactorSetUpLevels_SeqAIJ - Called at the end of a numeric LU or ILU factorization with the -mat_solve_levels
+   option. Computes the levels of L and U and copies the factors in level order, then installs MatSolve_SeqAIJ_Levels()
+   unless the levels are too small to be worth the synchronization.
+
+   In the factor row i of L is aj[ai[i]] to aj[ai[i+1]-1], and row i of U is aj[adiag[i+1]+1] to aj[adiag[i]-1]
+   with the inverse of its diagonal at aa[adiag[i]].
+*/
+PetscErrorCode MatLUFactorSetUpLevels_SeqAIJ(Mat fact)
+{
+  Mat_SeqAIJ        *b  = (Mat_SeqAIJ*)fact->data;
+  Mat_SeqAIJ_Levels *lv = &b->levels;
+  const PetscInt    *ai = b->i,*aj = b->j,*adiag = b->diag;
+  const MatScalar   *aa = b->a;
+  PetscInt          n   = fact->rmap->n,i,k,t,l,nz,*llevel,*ulevel,lnz,unz;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = MatDestroy_SeqAIJ_Levels(fact);CHKERRQ(ierr);
+  if (!n) PetscFunctionReturn(0);
+  ierr = PetscMalloc2(n,&llevel,n,&ulevel);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    for (k=ai[i],l=0; k<ai[i+1]; k++) l = PetscMax(l,llevel[aj[k]]+1);
+    llevel[i]    = l;
+    lv->lnlevels = PetscMax(lv->lnlevels,l+1);
+  }
+  for (i=n-1; i>=0; i--) {
+    for (k=adiag[i+1]+1,l=0; k<adiag[i]; k++) l = PetscMax(l,ulevel[aj[k]]+1);
+    ulevel[i]    = l;
+    lv->unlevels = PetscMax(lv->unlevels,l+1);
+  }
+  if (n < MATSOLVE_LEVELS_MIN_ROWS*PetscMax(lv->lnlevels,lv->unlevels)) {
+    ierr = PetscInfo3(fact,"%D levels in L and %D in U for %D rows, keeping the row by row solve\n",lv->lnlevels,lv->unlevels,n);CHKERRQ(ierr);
+    lv->lnlevels = lv->unlevels = 0;
+    ierr = PetscFree2(llevel,ulevel);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = PetscInfo3(fact,"%D levels in L and %D in U for %D rows\n",lv->lnlevels,lv->unlevels,n);CHKERRQ(ierr);
+
+  lnz  = ai[n];
+  unz  = adiag[0] - adiag[n] - n;
+  ierr = PetscMalloc2(lv->lnlevels+1,&lv->loffsets,lv->unlevels+1,&lv->uoffsets);CHKERRQ(ierr);
+  ierr = PetscMalloc4(n,&lv->lrows,n,&lv->urows,n+1,&lv->li,n+1,&lv->ui);CHKERRQ(ierr);
+  ierr = PetscMalloc5(lnz,&lv->lj,lnz,&lv->la,unz,&lv->uj,unz,&lv->ua,n,&lv->uidiag);CHKERRQ(ierr);
+  ierr = MatSeqAIJSortLevels_Private(n,llevel,lv->lnlevels,lv->loffsets,lv->lrows);CHKERRQ(ierr);
+  ierr = MatSeqAIJSortLevels_Private(n,ulevel,lv->unlevels,lv->uoffsets,lv->urows);CHKERRQ(ierr);
+  ierr = PetscFree2(llevel,ulevel);CHKERRQ(ierr);
+
+  lv->li[0] = 0;
+  for (t=0; t<n; t++) {
+    i  = lv->lrows[t];
+    nz = ai[i+1] - ai[i];
+    ierr = PetscMemcpy(lv->lj+lv->li[t],aj+ai[i],nz*sizeof(PetscInt));CHKERRQ(ierr);
+    ierr = PetscMemcpy(lv->la+lv->li[t],aa+ai[i],nz*sizeof(MatScalar));CHKERRQ(ierr);
+    lv->li[t+1] = lv->li[t] + nz;
+  }
+  lv->ui[0] = 0;
+  for (t=0; t<n; t++) {
+    i  = lv->urows[t];
+    nz = adiag[i] - adiag[i+1] - 1;
+    ierr = PetscMemcpy(lv->uj+lv->ui[t],aj+adiag[i+1]+1,nz*sizeof(PetscInt));CHKERRQ(ierr);
+    ierr = PetscMemcpy(lv->ua+lv->ui[t],aa+adiag[i+1]+1,nz*sizeof(MatScalar));CHKERRQ(ierr);
+    lv->ui[t+1]   = lv->ui[t] + nz;
+    lv->uidiag[t] = aa[adiag[i]];
+  }
+  fact->ops->solve = MatSolve_SeqAIJ_Levels;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatSolve_SeqAIJ_Levels"
+PetscErrorCode MatSolve_SeqAIJ_Levels(Mat A,Vec bb,Vec xx)
+{
+  Mat_SeqAIJ        *a  = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJ_Levels *lv = &a->levels;
+  IS                iscol = a->col,isrow = a->row;
+  PetscInt          n = A->rmap->n;
+  const PetscInt    *r,*c;
+  PetscScalar       *x,*tmp = a->solve_work;
+  const PetscScalar *b;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (!n) PetscFunctionReturn(0);
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecGetArray(xx,&x);CHKERRQ(ierr);
+  ierr = ISGetIndices(isrow,&r);CHKERRQ(ierr);
+  ierr = ISGetIndices(iscol,&c);CHKERRQ(ierr);
+
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel if (a->nz > MATSOLVE_LEVELS_THREAD_NZ)
+#endif
+  {
+    const PetscInt  *vi;
+    const MatScalar *v;
+    PetscScalar     sum;
+    PetscInt        k,t,i,nz;
+
+    /* forward solve the lower triangular, the rows of each level only depend on rows of the levels before it */
+    for (k=0; k<lv->lnlevels; k++) {
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+      for (t=lv->loffsets[k]; t<lv->loffsets[k+1]; t++) {
+        i   = lv->lrows[t];
+        v   = lv->la + lv->li[t];
+        vi  = lv->lj + lv->li[t];
+        nz  = lv->li[t+1] - lv->li[t];
+        sum = b[r[i]];
+        PetscSparseDenseMinusDot(sum,tmp,v,vi,nz);
+        tmp[i] = sum;
+      }
+    }
+    /* backward solve the upper triangular */
+    for (k=0; k<lv->unlevels; k++) {
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+      for (t=lv->uoffsets[k]; t<lv->uoffsets[k+1]; t++) {
+        i   = lv->urows[t];
+        v   = lv->ua + lv->ui[t];
+        vi  = lv->uj + lv->ui[t];
+        nz  = lv->ui[t+1] - lv->ui[t];
+        sum = tmp[i];
+        PetscSparseDenseMinusDot(sum,tmp,v,vi,nz);
+        x[c[i]] = tmp[i] = sum*lv->uidiag[t];
+      }
+    }
+  }
+
+  ierr = ISRestoreIndices(isrow,&r);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(iscol,&c);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecRestoreArray(xx,&x);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2*a->nz - A->cmap->n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -1077,6 +1077,7 @@ PetscErrorCode  MatDestroy(Mat *A)
   ierr = MatNullSpaceDestroy(&(*A)->nullsp);CHKERRQ(ierr);
   ierr = MatNullSpaceDestroy(&(*A)->transnullsp);CHKERRQ(ierr);
   ierr = MatNullSpaceDestroy(&(*A)->nearnullsp);CHKERRQ(ierr);
+  ierr = PetscFree((*A)->bsizes);CHKERRQ(ierr);
   ierr = PetscLayoutDestroy(&(*A)->rmap);CHKERRQ(ierr);
   ierr = PetscLayoutDestroy(&(*A)->cmap);CHKERRQ(ierr);
   ierr = PetscHeaderDestroy(A);CHKERRQ(ierr);
@@ -6961,6 +6962,80 @@ PetscErrorCode  MatSetBlockSizes(Mat mat,PetscInt rbs,PetscInt cbs)
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "MatSetVariableBlockSizes"
+/*@
+   MatSetVariableBlockSizes - Sets the sizes of the diagonal blocks of the local rows, the blocks need not all have the same size.
+
+   Not Collective
+
+   Input Parameters:
++  mat - the matrix
+.  nblocks - the number of blocks on this process
+-  bsizes - the block sizes, in the order of the local rows
+
+   Notes:
+    The block sizes must add up to the number of local rows. They are used by PCVPBJACOBI and do not change the storage
+    of the matrix, a block may be larger than the block size of the matrix.
+
+    This must be called after the local sizes of the matrix are known, for example after MatSetUp() or MatXXXSetPreallocation(). The array bsizes is copied.
+
+   Level: intermediate
+
+   Concepts: matrices^block size
+
+.seealso: MatCreateSeqBAIJ(), MatCreateBAIJ(), MatGetBlockSize(), MatSetBlockSizes(), MatGetVariableBlockSizes(), PCVPBJACOBI
+@*/
+PetscErrorCode  MatSetVariableBlockSizes(Mat mat,PetscInt nblocks,const PetscInt bsizes[])
+{
+  PetscErrorCode ierr;
+  PetscInt       i,ncnt = 0;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(mat,MAT_CLASSID,1);
+  if (nblocks < 0) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Number of blocks %D cannot be negative",nblocks);
+  if (nblocks) PetscValidIntPointer(bsizes,3);
+  for (i=0; i<nblocks; i++) {
+    if (bsizes[i] < 1) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Block %D has size %D, sizes must be positive",i,bsizes[i]);
+    ncnt += bsizes[i];
+  }
+  if (ncnt != mat->rmap->n) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_SIZ,"Sum of block sizes %D does not equal the number of local rows %D",ncnt,mat->rmap->n);
+  ierr = PetscFree(mat->bsizes);CHKERRQ(ierr);
+  mat->nblocks = nblocks;
+  ierr = PetscMalloc1(nblocks,&mat->bsizes);CHKERRQ(ierr);
+  ierr = PetscMemcpy(mat->bsizes,bsizes,nblocks*sizeof(PetscInt));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatGetVariableBlockSizes"
+/*@C
+   MatGetVariableBlockSizes - Gets the sizes of the diagonal blocks of the local rows set with MatSetVariableBlockSizes()
+
+   Not Collective
+
+   Input Parameter:
+.  mat - the matrix
+
+   Output Parameters:
++  nblocks - the number of blocks on this process, zero if no variable block sizes were set
+-  bsizes - the block sizes, owned by the matrix
+
+   Level: intermediate
+
+   Concepts: matrices^block size
+
+.seealso: MatCreateSeqBAIJ(), MatCreateBAIJ(), MatGetBlockSize(), MatSetBlockSizes(), MatSetVariableBlockSizes()
+@*/
+PetscErrorCode  MatGetVariableBlockSizes(Mat mat,PetscInt *nblocks,const PetscInt *bsizes[])
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(mat,MAT_CLASSID,1);
+  if (nblocks) *nblocks = mat->nblocks;
+  if (bsizes)  *bsizes  = mat->bsizes;
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "MatSetBlockSizesFromMats"
 /*@
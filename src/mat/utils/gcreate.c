@@ -350,6 +350,7 @@ PetscErrorCode MatHeaderMerge(Mat A,Mat C)
 
   ierr = PetscLayoutDestroy(&A->rmap);CHKERRQ(ierr);
   ierr = PetscLayoutDestroy(&A->cmap);CHKERRQ(ierr);
+  ierr = PetscFree(A->bsizes);CHKERRQ(ierr);
   ierr = PetscFunctionListDestroy(&((PetscObject)A)->qlist);CHKERRQ(ierr);
   ierr = PetscObjectListDestroy(&((PetscObject)A)->olist);CHKERRQ(ierr);
 
@@ -401,6 +402,7 @@ PETSC_EXTERN PetscErrorCode MatHeaderReplace(Mat A,Mat C)
   ierr = PetscLayoutDestroy(&A->rmap);CHKERRQ(ierr);
   ierr = PetscLayoutDestroy(&A->cmap);CHKERRQ(ierr);
   ierr = PetscFree(A->spptr);CHKERRQ(ierr);
+  ierr = PetscFree(A->bsizes);CHKERRQ(ierr);
 
   /* copy C over to A */
   refct = ((PetscObject)A)->refct;
@@ -536,7 +536,6 @@ int main(int argc, char **argv)
   Mat            A,J;         /* Jacobian matrix */
   MatNullSpace   nullSpace;   /* May be necessary for Neumann conditions */
   AppCtx         user;        /* user-defined work context */
-  JacActionCtx   userJ;       /* context for Jacobian MF action */
   PetscInt       its;         /* iterations for convergence */
   PetscReal      error = 0.0; /* L_2 error in the solution */
   PetscErrorCode ierr;
@@ -558,25 +557,13 @@ int main(int argc, char **argv)
   ierr = DMSetMatType(dm,MATAIJ);CHKERRQ(ierr);
   ierr = DMCreateMatrix(dm, &J);CHKERRQ(ierr);
   if (user.jacobianMF) {
-    PetscInt M, m, N, n;
-
-    ierr = MatGetSize(J, &M, &N);CHKERRQ(ierr);
-    ierr = MatGetLocalSize(J, &m, &n);CHKERRQ(ierr);
-    ierr = MatCreate(PETSC_COMM_WORLD, &A);CHKERRQ(ierr);
-    ierr = MatSetSizes(A, m, n, M, N);CHKERRQ(ierr);
-    ierr = MatSetType(A, MATSHELL);CHKERRQ(ierr);
-    ierr = MatSetUp(A);CHKERRQ(ierr);
-#if 0
-    ierr = MatShellSetOperation(A, MATOP_MULT, (void (*)(void))FormJacobianAction);CHKERRQ(ierr);
-#endif
-
-    userJ.dm   = dm;
-    userJ.J    = J;
-    userJ.user = &user;
+    Vec uloc;
 
-    ierr = DMCreateLocalVector(dm, &userJ.u);CHKERRQ(ierr);
-    ierr = DMPlexProjectFunctionLocal(dm, user.exactFuncs, NULL, INSERT_BC_VALUES, userJ.u);CHKERRQ(ierr);
-    ierr = MatShellSetContext(A, &userJ);CHKERRQ(ierr);
+    ierr = DMGetLocalVector(dm, &uloc);CHKERRQ(ierr);
+    ierr = VecZeroEntries(uloc);CHKERRQ(ierr);
+    ierr = DMPlexProjectFunctionLocal(dm, user.exactFuncs, NULL, INSERT_BC_VALUES, uloc);CHKERRQ(ierr);
+    ierr = DMPlexSNESCreateJacobianMF(dm, uloc, &user, &A);CHKERRQ(ierr);
+    ierr = DMRestoreLocalVector(dm, &uloc);CHKERRQ(ierr);
   } else {
     A = J;
   }
@@ -672,7 +659,6 @@ int main(int argc, char **argv)
   ierr = VecViewFromOptions(u, NULL, "-vec_view");CHKERRQ(ierr);
 
   if (user.bcType == NEUMANN) {ierr = MatNullSpaceDestroy(&nullSpace);CHKERRQ(ierr);}
-  if (user.jacobianMF) {ierr = VecDestroy(&userJ.u);CHKERRQ(ierr);}
   if (A != J) {ierr = MatDestroy(&A);CHKERRQ(ierr);}
   ierr = MatDestroy(&J);CHKERRQ(ierr);
   ierr = VecDestroy(&u);CHKERRQ(ierr);
@@ -1988,6 +1988,23 @@ PetscErrorCode DMPlexComputeJacobian_Internal(DM dm, PetscInt cStart, PetscInt c
     ierr = PetscDSGetTotalDimension(probAux, &totDimAux);CHKERRQ(ierr);
   }
   ierr = DMPlexInsertBoundaryValues(dm, X, 0.0, NULL, NULL, NULL);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject) JacP, MATSHELL, &isShell);CHKERRQ(ierr);
+  if (isShell) {
+    JacActionCtx *jctx;
+
+    /* A matrix-free preconditioner, as from DMPlexSNESCreateJacobianMF(), only needs the new linearization point */
+    ierr = MatShellGetContext(JacP, &jctx);CHKERRQ(ierr);
+    ierr = VecCopy(X, jctx->u);CHKERRQ(ierr);
+    if (Jac != JacP) {
+      ierr = PetscObjectTypeCompare((PetscObject) Jac, MATSHELL, &isShell);CHKERRQ(ierr);
+      if (isShell) {
+        ierr = MatShellGetContext(Jac, &jctx);CHKERRQ(ierr);
+        ierr = VecCopy(X, jctx->u);CHKERRQ(ierr);
+      }
+    }
+    ierr = PetscLogEventEnd(DMPLEX_JacobianFEM,dm,0,0,0);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = MatZeroEntries(JacP);CHKERRQ(ierr);
   ierr = PetscMalloc3(numCells*totDim,&u,X_t ? numCells*totDim : 0,&u_t,numCells*totDim*totDim,&elemMat);CHKERRQ(ierr);
   if (dmAux) {ierr = PetscMalloc1(numCells*totDimAux, &a);CHKERRQ(ierr);}
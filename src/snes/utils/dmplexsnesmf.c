@@ -0,0 +1,846 @@
+#include <petsc/private/dmpleximpl.h>   /*I "petscdmplex.h" I*/
+#include <petsc/private/snesimpl.h>     /*I "petscsnes.h"   I*/
+#include <petscds.h>
+#include <petsc/private/petscfeimpl.h>
+
+/************************** Matrix-free Jacobian action *******************************/
+
+/*
+  A tensor product element on [-1,1]^dim whose nodal basis and quadrature both factor into 1D pieces. Points are
+  numbered lexicographically, with the first coordinate varying slowest, so that a function on the nodes or the
+  quadrature points can be contracted one direction at a time (sum factorization).
+*/
+typedef struct {
+  PetscInt   nb[3];         /* Number of nodes in each direction */
+  PetscInt   nq[3];         /* Number of quadrature points in each direction */
+  PetscInt  *bperm;         /* bperm[b] is the lexicographic index of basis function b */
+  PetscReal *B[3], *D[3];   /* 1D basis values and derivatives at the quadrature points, nq[d] x nb[d] */
+  PetscReal *Bt[3], *Dt[3]; /* The transposes, nb[d] x nq[d] */
+} PlexMFTensor;
+
+#undef __FUNCT__
+#define __FUNCT__ "PlexMFLexicographic_Static"
+/* Find the 1D nodes of a tensor product point set, and the lexicographic index of each point. Returns isTensor = PETSC_FALSE if the points are not a full tensor grid. */
+static PetscErrorCode PlexMFLexicographic_Static(PetscInt dim, PetscInt N, const PetscReal pts[], PetscInt n[], PetscReal *nodes[], PetscInt perm[], PetscBool *isTensor)
+{
+  const PetscReal tol = 1.0e-10;
+  PetscBT         seen;
+  PetscInt        d, i, j, k, size = 1;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  *isTensor = PETSC_TRUE;
+  for (d = 0; d < dim; ++d) {
+    ierr = PetscMalloc1(N, &nodes[d]);CHKERRQ(ierr);
+    for (i = 0, n[d] = 0; i < N; ++i) {
+      const PetscReal v = pts[i*dim+d];
+
+      for (j = 0; j < n[d]; ++j) if (PetscAbsReal(nodes[d][j] - v) < tol) break;
+      if (j < n[d]) continue;
+      /* Insertion sort keeps the nodes increasing */
+      for (k = n[d]; k > 0 && nodes[d][k-1] > v; --k) nodes[d][k] = nodes[d][k-1];
+      nodes[d][k] = v;
+      ++n[d];
+    }
+    size *= n[d];
+  }
+  if (size != N) {*isTensor = PETSC_FALSE; PetscFunctionReturn(0);}
+  ierr = PetscBTCreate(N, &seen);CHKERRQ(ierr);
+  for (i = 0; i < N; ++i) {
+    PetscInt l = 0;
+
+    for (d = 0; d < dim; ++d) {
+      for (j = 0; j < n[d]; ++j) if (PetscAbsReal(nodes[d][j] - pts[i*dim+d]) < tol) break;
+      l = l*n[d] + j;
+    }
+    if (PetscBTLookupSet(seen, l)) {*isTensor = PETSC_FALSE; break;}
+    perm[i] = l;
+  }
+  ierr = PetscBTDestroy(&seen);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PlexMFLagrange_Static"
+/* Tabulate the 1D Lagrange polynomials through nodes[0..nb) and their derivatives at the points pts[0..nq) */
+static void PlexMFLagrange_Static(PetscInt nb, const PetscReal nodes[], PetscInt nq, const PetscReal pts[], PetscReal B[], PetscReal D[])
+{
+  PetscInt q, i, j, m;
+
+  for (q = 0; q < nq; ++q) {
+    for (i = 0; i < nb; ++i) {
+      PetscReal val = 1.0, der = 0.0;
+
+      for (j = 0; j < nb; ++j) if (j != i) val *= (pts[q] - nodes[j])/(nodes[i] - nodes[j]);
+      for (m = 0; m < nb; ++m) {
+        PetscReal term;
+
+        if (m == i) continue;
+        term = 1.0/(nodes[i] - nodes[m]);
+        for (j = 0; j < nb; ++j) if (j != i && j != m) term *= (pts[q] - nodes[j])/(nodes[i] - nodes[j]);
+        der += term;
+      }
+      B[q*nb+i] = val;
+      D[q*nb+i] = der;
+    }
+  }
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PlexMFTensorDestroy_Static"
+static PetscErrorCode PlexMFTensorDestroy_Static(PlexMFTensor *t)
+{
+  PetscInt       d;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree(t->bperm);CHKERRQ(ierr);
+  for (d = 0; d < 3; ++d) {ierr = PetscFree4(t->B[d], t->D[d], t->Bt[d], t->Dt[d]);CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PlexMFTensorCreate_Static"
+/*
+  Factor the tabulation of field f into 1D pieces. The nodes come from the point evaluation functionals of the dual
+  space, and the factorization is checked against the full tabulation, so any element that is not a nodal tensor
+  product on a tensor quadrature returns isTensor = PETSC_FALSE.
+*/
+static PetscErrorCode PlexMFTensorCreate_Static(PetscDS prob, PetscInt f, PetscInt qperm[], PlexMFTensor *t, PetscBool *isTensor)
+{
+  PetscFE          fe;
+  PetscObject      obj;
+  PetscClassId     id;
+  PetscDualSpace   sp;
+  PetscQuadrature  quad;
+  PetscReal      **basisField, **basisFieldDer, *bpts, *bnodes[3] = {NULL, NULL, NULL}, *qnodes[3] = {NULL, NULL, NULL};
+  const PetscReal *qpts;
+  PetscInt        *qp, dim, Nb, Nc, Nq, b, q, d;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscMemzero(t, sizeof(PlexMFTensor));CHKERRQ(ierr);
+  *isTensor = PETSC_FALSE;
+  ierr = PetscDSGetDiscretization(prob, f, &obj);CHKERRQ(ierr);
+  ierr = PetscObjectGetClassId(obj, &id);CHKERRQ(ierr);
+  if (id != PETSCFE_CLASSID) PetscFunctionReturn(0);
+  fe   = (PetscFE) obj;
+  ierr = PetscFEGetSpatialDimension(fe, &dim);CHKERRQ(ierr);
+  ierr = PetscFEGetDimension(fe, &Nb);CHKERRQ(ierr);
+  ierr = PetscFEGetNumComponents(fe, &Nc);CHKERRQ(ierr);
+  ierr = PetscFEGetDualSpace(fe, &sp);CHKERRQ(ierr);
+  ierr = PetscFEGetQuadrature(fe, &quad);CHKERRQ(ierr);
+  ierr = PetscQuadratureGetData(quad, NULL, &Nq, &qpts, NULL);CHKERRQ(ierr);
+  if (dim > 3) PetscFunctionReturn(0);
+  ierr = PetscMalloc1(Nb, &t->bperm);CHKERRQ(ierr);
+  ierr = PetscMalloc2(Nb*dim, &bpts, Nq, &qp);CHKERRQ(ierr);
+  for (b = 0; b < Nb; ++b) {
+    PetscQuadrature  func;
+    const PetscReal *fpts;
+    PetscInt         Np;
+
+    ierr = PetscDualSpaceGetFunctional(sp, b, &func);CHKERRQ(ierr);
+    ierr = PetscQuadratureGetData(func, NULL, &Np, &fpts, NULL);CHKERRQ(ierr);
+    if (Np != 1) goto cleanup;
+    for (d = 0; d < dim; ++d) bpts[b*dim+d] = fpts[d];
+  }
+  ierr = PlexMFLexicographic_Static(dim, Nb, bpts, t->nb, bnodes, t->bperm, isTensor);CHKERRQ(ierr);
+  if (!*isTensor) goto cleanup;
+  ierr = PlexMFLexicographic_Static(dim, Nq, qpts, t->nq, qnodes, qp, isTensor);CHKERRQ(ierr);
+  if (!*isTensor) goto cleanup;
+  for (q = 0; q < Nq; ++q) {
+    if (qperm[q] < 0) qperm[q] = qp[q];
+    else if (qperm[q] != qp[q]) {*isTensor = PETSC_FALSE; goto cleanup;}
+  }
+  for (d = 0; d < dim; ++d) {
+    const PetscInt nb = t->nb[d], nq = t->nq[d];
+    PetscInt       i, j;
+
+    ierr = PetscMalloc4(nq*nb, &t->B[d], nq*nb, &t->D[d], nb*nq, &t->Bt[d], nb*nq, &t->Dt[d]);CHKERRQ(ierr);
+    PlexMFLagrange_Static(nb, bnodes[d], nq, qnodes[d], t->B[d], t->D[d]);
+    for (i = 0; i < nq; ++i) for (j = 0; j < nb; ++j) {t->Bt[d][j*nq+i] = t->B[d][i*nb+j]; t->Dt[d][j*nq+i] = t->D[d][i*nb+j];}
+  }
+  /* Check the factorization against the tabulation actually used for integration */
+  ierr = PetscDSGetTabulation(prob, &basisField, &basisFieldDer);CHKERRQ(ierr);
+  for (q = 0; q < Nq && *isTensor; ++q) {
+    for (b = 0; b < Nb && *isTensor; ++b) {
+      const PetscReal *basis    = &basisField[f][(q*Nb+b)*Nc];
+      const PetscReal *basisDer = &basisFieldDer[f][(q*Nb+b)*Nc*dim];
+      PetscReal        val = 1.0, der[3] = {1.0, 1.0, 1.0};
+      PetscInt         lq = qp[q], lb = t->bperm[b], e;
+
+      for (d = dim-1; d >= 0; --d) {
+        const PetscInt i = lq % t->nq[d], j = lb % t->nb[d];
+
+        lq  /= t->nq[d];
+        lb  /= t->nb[d];
+        val *= t->B[d][i*t->nb[d]+j];
+        for (e = 0; e < dim; ++e) der[e] *= (e == d ? t->D[d][i*t->nb[d]+j] : t->B[d][i*t->nb[d]+j]);
+      }
+      if (PetscAbsReal(val - basis[0]) > 1.0e-8*(1.0 + PetscAbsReal(basis[0]))) *isTensor = PETSC_FALSE;
+      for (e = 0; e < dim; ++e) if (PetscAbsReal(der[e] - basisDer[e]) > 1.0e-8*(1.0 + PetscAbsReal(basisDer[e]))) *isTensor = PETSC_FALSE;
+    }
+  }
+  cleanup:
+  for (d = 0; d < 3; ++d) {ierr = PetscFree(bnodes[d]);CHKERRQ(ierr); ierr = PetscFree(qnodes[d]);CHKERRQ(ierr);}
+  ierr = PetscFree2(bpts, qp);CHKERRQ(ierr);
+  if (!*isTensor) {
+    ierr = PlexMFTensorDestroy_Static(t);CHKERRQ(ierr);
+    ierr = PetscMemzero(t, sizeof(PlexMFTensor));CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PlexMFContract_Static"
+/*
+  Apply the 1D matrices A[d], each nout[d] x nin[d], to the tensor product array in[], one direction at a time:
+
+    out[(p*m+i)*post+s] = \sum_j A[i*n+j] in[(p*n+j)*post+s]
+
+  where n = nin[d], m = nout[d]. The work arrays must hold \prod_d max(nin[d], nout[d]) entries. If add is true, the
+  result is added to out[].
+*/
+static void PlexMFContract_Static(PetscInt dim, const PetscInt nin[], const PetscInt nout[], PetscReal *A[], const PetscScalar in[], PetscScalar out[], PetscBool add, PetscScalar work0[], PetscScalar work1[])
+{
+  const PetscScalar *src = in;
+  PetscScalar       *dst = work0;
+  PetscInt           size[3], d, e, total = 1;
+
+  for (d = 0; d < dim; ++d) size[d] = nin[d];
+  for (d = 0; d < dim; ++d) {
+    const PetscInt n = nin[d], m = nout[d];
+    PetscInt       pre = 1, post = 1, p, i, j, s;
+
+    for (e = 0; e < d; ++e)       pre  *= size[e];
+    for (e = d+1; e < dim; ++e)   post *= size[e];
+    for (p = 0; p < pre; ++p) {
+      for (i = 0; i < m; ++i) {
+        PetscScalar *o = &dst[(p*m+i)*post];
+
+        for (s = 0; s < post; ++s) o[s] = 0.0;
+        for (j = 0; j < n; ++j) {
+          const PetscReal    a  = A[d][i*n+j];
+          const PetscScalar *v = &src[(p*n+j)*post];
+
+          for (s = 0; s < post; ++s) o[s] += a*v[s];
+        }
+      }
+    }
+    size[d] = m;
+    src     = dst;
+    dst     = dst == work0 ? work1 : work0;
+  }
+  for (d = 0; d < dim; ++d) total *= size[d];
+  if (add) for (e = 0; e < total; ++e) out[e] += src[e];
+  else     for (e = 0; e < total; ++e) out[e]  = src[e];
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PlexMFEvaluate_Static"
+/* Evaluate component c of field f, and its reference gradient, at the quadrature points in lexicographic order */
+static void PlexMFEvaluate_Static(PetscInt dim, PlexMFTensor *t, PetscInt Nb, PetscInt Nc, PetscInt c, const PetscScalar coef[], PetscScalar lex[], PetscScalar val[], PetscScalar der[], PetscInt Nq, PetscScalar work0[], PetscScalar work1[])
+{
+  PetscReal *A[3];
+  PetscInt   b, d, e;
+
+  for (b = 0; b < Nb; ++b) lex[t->bperm[b]] = coef[b*Nc+c];
+  PlexMFContract_Static(dim, t->nb, t->nq, t->B, lex, val, PETSC_FALSE, work0, work1);
+  for (d = 0; d < dim; ++d) {
+    for (e = 0; e < dim; ++e) A[e] = e == d ? t->D[e] : t->B[e];
+    PlexMFContract_Static(dim, t->nb, t->nq, A, lex, &der[d*Nq], PETSC_FALSE, work0, work1);
+  }
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PlexMFIntegrate_Static"
+/* Integrate the quadrature values val[] against the basis and der[] against the reference basis gradient, adding into component c of the element vector */
+static void PlexMFIntegrate_Static(PetscInt dim, PlexMFTensor *t, PetscInt Nb, PetscInt Nc, PetscInt c, const PetscScalar val[], const PetscScalar der[], PetscInt Nq, PetscScalar lex[], PetscScalar elemVec[], PetscScalar work0[], PetscScalar work1[])
+{
+  PetscReal *A[3];
+  PetscInt   b, d, e;
+
+  PlexMFContract_Static(dim, t->nq, t->nb, t->Bt, val, lex, PETSC_FALSE, work0, work1);
+  for (d = 0; d < dim; ++d) {
+    for (e = 0; e < dim; ++e) A[e] = e == d ? t->Dt[e] : t->Bt[e];
+    PlexMFContract_Static(dim, t->nq, t->nb, A, &der[d*Nq], lex, PETSC_TRUE, work0, work1);
+  }
+  for (b = 0; b < Nb; ++b) elemVec[b*Nc+c] += lex[t->bperm[b]];
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PlexMFPointwiseJacobian_Static"
+/* Evaluate the pointwise Jacobian for fields (fieldI, fieldJ) at one point and map g1, g2, g3 to the reference cell, scaled by the quadrature weight w, exactly as PetscFEIntegrateJacobian() does */
+static PetscErrorCode PlexMFPointwiseJacobian_Static(PetscDS prob, PetscInt fieldI, PetscInt fieldJ, PetscInt NcI, PetscInt NcJ, PetscInt NfAux, const PetscInt aOff[], const PetscInt aOff_x[],
+                                                     const PetscScalar u[], const PetscScalar u_x[], const PetscScalar a[], const PetscScalar a_x[], const PetscReal x[],
+                                                     const PetscReal invJ[], PetscReal w, PetscScalar tmp[], PetscScalar g0[], PetscScalar g1[], PetscScalar g2[], PetscScalar g3[], PetscBool *hasJac)
+{
+  PetscPointJac   g0_func, g1_func, g2_func, g3_func;
+  const PetscInt *uOff, *uOff_x;
+  PetscInt        dim, Nf, fc, gc, d, d2, dp, d3;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscDSGetSpatialDimension(prob, &dim);CHKERRQ(ierr);
+  ierr = PetscDSGetNumFields(prob, &Nf);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentOffsets(prob, (PetscInt **) &uOff);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentDerivativeOffsets(prob, (PetscInt **) &uOff_x);CHKERRQ(ierr);
+  ierr = PetscDSGetJacobian(prob, fieldI, fieldJ, &g0_func, &g1_func, &g2_func, &g3_func);CHKERRQ(ierr);
+  *hasJac = g0_func || g1_func || g2_func || g3_func ? PETSC_TRUE : PETSC_FALSE;
+  ierr = PetscMemzero(g0, NcI*NcJ * sizeof(PetscScalar));CHKERRQ(ierr);
+  ierr = PetscMemzero(g1, NcI*NcJ*dim * sizeof(PetscScalar));CHKERRQ(ierr);
+  ierr = PetscMemzero(g2, NcI*NcJ*dim * sizeof(PetscScalar));CHKERRQ(ierr);
+  ierr = PetscMemzero(g3, NcI*NcJ*dim*dim * sizeof(PetscScalar));CHKERRQ(ierr);
+  if (g0_func) {
+    g0_func(dim, Nf, NfAux, uOff, uOff_x, u, NULL, u_x, aOff, aOff_x, a, NULL, a_x, 0.0, 0.0, x, g0);
+    for (fc = 0; fc < NcI*NcJ; ++fc) g0[fc] *= w;
+  }
+  if (g1_func) {
+    ierr = PetscMemzero(tmp, NcI*NcJ*dim * sizeof(PetscScalar));CHKERRQ(ierr);
+    g1_func(dim, Nf, NfAux, uOff, uOff_x, u, NULL, u_x, aOff, aOff_x, a, NULL, a_x, 0.0, 0.0, x, tmp);
+    for (fc = 0; fc < NcI*NcJ; ++fc) for (d = 0; d < dim; ++d) {
+      for (d2 = 0; d2 < dim; ++d2) g1[fc*dim+d] += invJ[d*dim+d2]*tmp[fc*dim+d2];
+      g1[fc*dim+d] *= w;
+    }
+  }
+  if (g2_func) {
+    ierr = PetscMemzero(tmp, NcI*NcJ*dim * sizeof(PetscScalar));CHKERRQ(ierr);
+    g2_func(dim, Nf, NfAux, uOff, uOff_x, u, NULL, u_x, aOff, aOff_x, a, NULL, a_x, 0.0, 0.0, x, tmp);
+    for (fc = 0; fc < NcI*NcJ; ++fc) for (d = 0; d < dim; ++d) {
+      for (d2 = 0; d2 < dim; ++d2) g2[fc*dim+d] += invJ[d*dim+d2]*tmp[fc*dim+d2];
+      g2[fc*dim+d] *= w;
+    }
+  }
+  if (g3_func) {
+    ierr = PetscMemzero(tmp, NcI*NcJ*dim*dim * sizeof(PetscScalar));CHKERRQ(ierr);
+    g3_func(dim, Nf, NfAux, uOff, uOff_x, u, NULL, u_x, aOff, aOff_x, a, NULL, a_x, 0.0, 0.0, x, tmp);
+    for (fc = 0; fc < NcI; ++fc) for (gc = 0; gc < NcJ; ++gc) for (d = 0; d < dim; ++d) for (dp = 0; dp < dim; ++dp) {
+      PetscScalar *g = &g3[((fc*NcJ+gc)*dim+d)*dim+dp];
+
+      for (d2 = 0; d2 < dim; ++d2) for (d3 = 0; d3 < dim; ++d3) *g += invJ[d*dim+d2]*tmp[((fc*NcJ+gc)*dim+d2)*dim+d3]*invJ[dp*dim+d3];
+      *g *= w;
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PlexMFCheckSupported_Static"
+static PetscErrorCode PlexMFCheckSupported_Static(DM dm, PetscDS prob)
+{
+  PetscSection   anchorSection;
+  PetscInt       Nf, f, numBd, bd;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = DMPlexGetAnchors(dm, &anchorSection, NULL);CHKERRQ(ierr);
+  if (anchorSection) SETERRQ(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "The matrix-free Jacobian does not support anchor constraints");
+  ierr = PetscDSGetNumFields(prob, &Nf);CHKERRQ(ierr);
+  for (f = 0; f < Nf; ++f) {
+    PetscObject  obj;
+    PetscClassId id;
+
+    ierr = PetscDSGetDiscretization(prob, f, &obj);CHKERRQ(ierr);
+    ierr = PetscObjectGetClassId(obj, &id);CHKERRQ(ierr);
+    if (id != PETSCFE_CLASSID) SETERRQ1(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "The matrix-free Jacobian requires a PetscFE discretization for field %d", f);
+  }
+  ierr = DMPlexGetNumBoundary(dm, &numBd);CHKERRQ(ierr);
+  for (bd = 0; bd < numBd; ++bd) {
+    PetscBool isEssential;
+
+    ierr = DMPlexGetBoundary(dm, bd, &isEssential, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);CHKERRQ(ierr);
+    if (!isEssential) SETERRQ(PetscObjectComm((PetscObject) dm), PETSC_ERR_SUP, "The matrix-free Jacobian does not support natural boundary conditions");
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexComputeJacobianAction_Internal"
+PetscErrorCode DMPlexComputeJacobianAction_Internal(DM dm, PetscInt cStart, PetscInt cEnd, Vec U, Vec X, Vec Y, void *user)
+{
+  DM                dmAux;
+  Vec               A, cellgeom;
+  PetscDS           prob, probAux = NULL;
+  PetscSection      section, sectionAux;
+  PetscQuadrature   quad;
+  PetscFECellGeom  *cgeom;
+  PlexMFTensor     *tensor;
+  PetscBool        *hasJac, isTensor = PETSC_TRUE;
+  const PetscReal  *quadPoints, *quadWeights;
+  PetscScalar      *elemVec, *elemMat = NULL, *a = NULL, *a_x = NULL;
+  PetscScalar      *su = NULL, *sur = NULL, *du = NULL, *dur = NULL, *f0 = NULL, *f1 = NULL, *lex = NULL, *work0 = NULL, *work1 = NULL;
+  PetscScalar      *uq = NULL, *uq_x = NULL, *g0 = NULL, *g1 = NULL, *g2 = NULL, *g3 = NULL, *tmp = NULL;
+  PetscReal        *x = NULL;
+  PetscInt         *uOff, *aOff = NULL, *aOff_x = NULL, *qperm, *qinv = NULL, *Nb, *Nc, *off;
+  PetscInt          dim, Nf, NfAux = 0, Nq, totDim, totDimAux = 0, totComp, maxNc = 0, maxLex = 0, f, g, c, q;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscLogEventBegin(DMPLEX_JacobianActionFEM,dm,0,0,0);CHKERRQ(ierr);
+  ierr = DMGetDimension(dm, &dim);CHKERRQ(ierr);
+  ierr = DMGetDefaultSection(dm, &section);CHKERRQ(ierr);
+  ierr = DMGetDS(dm, &prob);CHKERRQ(ierr);
+  ierr = PlexMFCheckSupported_Static(dm, prob);CHKERRQ(ierr);
+  ierr = PetscDSGetNumFields(prob, &Nf);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalDimension(prob, &totDim);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalComponents(prob, &totComp);CHKERRQ(ierr);
+  ierr = PetscDSGetComponentOffsets(prob, &uOff);CHKERRQ(ierr);
+  ierr = PetscObjectQuery((PetscObject) dm, "dmAux", (PetscObject *) &dmAux);CHKERRQ(ierr);
+  ierr = PetscObjectQuery((PetscObject) dm, "A", (PetscObject *) &A);CHKERRQ(ierr);
+  if (dmAux) {
+    ierr = DMGetDefaultSection(dmAux, &sectionAux);CHKERRQ(ierr);
+    ierr = DMGetDS(dmAux, &probAux);CHKERRQ(ierr);
+    ierr = PetscDSGetNumFields(probAux, &NfAux);CHKERRQ(ierr);
+    ierr = PetscDSGetTotalDimension(probAux, &totDimAux);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentOffsets(probAux, &aOff);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentDerivativeOffsets(probAux, &aOff_x);CHKERRQ(ierr);
+    ierr = PetscDSGetEvaluationArrays(probAux, &a, NULL, &a_x);CHKERRQ(ierr);
+  }
+  {
+    PetscFE fe;
+
+    ierr = PetscDSGetDiscretization(prob, 0, (PetscObject *) &fe);CHKERRQ(ierr);
+    ierr = PetscFEGetQuadrature(fe, &quad);CHKERRQ(ierr);
+    ierr = PetscQuadratureGetData(quad, NULL, &Nq, &quadPoints, &quadWeights);CHKERRQ(ierr);
+  }
+  ierr = PetscMalloc5(Nf, &tensor, Nf*Nf, &hasJac, Nf, &Nb, Nf, &Nc, Nf, &off);CHKERRQ(ierr);
+  ierr = PetscMalloc1(Nq, &qperm);CHKERRQ(ierr);
+  for (q = 0; q < Nq; ++q) qperm[q] = -1;
+  for (f = 0; f < Nf; ++f) {
+    PetscFE         fe;
+    PetscQuadrature fquad;
+    PetscBool       fTensor;
+
+    ierr = PetscDSGetDiscretization(prob, f, (PetscObject *) &fe);CHKERRQ(ierr);
+    ierr = PetscFEGetDimension(fe, &Nb[f]);CHKERRQ(ierr);
+    ierr = PetscFEGetNumComponents(fe, &Nc[f]);CHKERRQ(ierr);
+    ierr = PetscDSGetFieldOffset(prob, f, &off[f]);CHKERRQ(ierr);
+    ierr = PetscFEGetQuadrature(fe, &fquad);CHKERRQ(ierr);
+    maxNc = PetscMax(maxNc, Nc[f]);
+    for (g = 0; g < Nf; ++g) {
+      PetscPointJac g0_func, g1_func, g2_func, g3_func;
+
+      ierr = PetscDSGetJacobian(prob, f, g, &g0_func, &g1_func, &g2_func, &g3_func);CHKERRQ(ierr);
+      hasJac[f*Nf+g] = g0_func || g1_func || g2_func || g3_func ? PETSC_TRUE : PETSC_FALSE;
+    }
+    ierr = PlexMFTensorCreate_Static(prob, f, qperm, &tensor[f], &fTensor);CHKERRQ(ierr);
+    if (fquad != quad) fTensor = PETSC_FALSE;
+    if (fTensor) {
+      PetscInt size = 1, d;
+
+      for (d = 0; d < dim; ++d) size *= PetscMax(tensor[f].nb[d], tensor[f].nq[d]);
+      maxLex = PetscMax(maxLex, size);
+    }
+    isTensor = (PetscBool) (isTensor && fTensor);
+  }
+  ierr = PetscInfo1(dm, "Applying the Jacobian %s\n", isTensor ? "with sum factorization" : "with element matrices");CHKERRQ(ierr);
+  if (isTensor) {
+    ierr = PetscMalloc5(totComp*Nq, &su, totComp*dim*Nq, &sur, totComp*Nq, &du, totComp*dim*Nq, &dur, Nq, &qinv);CHKERRQ(ierr);
+    ierr = PetscMalloc5(totComp*Nq, &f0, totComp*dim*Nq, &f1, maxLex, &lex, maxLex, &work0, maxLex, &work1);CHKERRQ(ierr);
+    ierr = PetscMalloc5(totComp, &uq, totComp*dim, &uq_x, maxNc*maxNc, &g0, maxNc*maxNc*dim, &g1, maxNc*maxNc*dim, &g2);CHKERRQ(ierr);
+    ierr = PetscMalloc3(maxNc*maxNc*dim*dim, &g3, maxNc*maxNc*dim*dim, &tmp, dim, &x);CHKERRQ(ierr);
+    for (q = 0; q < Nq; ++q) qinv[qperm[q]] = q;
+  } else {
+    ierr = PetscMalloc1(totDim*totDim, &elemMat);CHKERRQ(ierr);
+  }
+  ierr = PetscMalloc1(totDim, &elemVec);CHKERRQ(ierr);
+  ierr = VecZeroEntries(Y);CHKERRQ(ierr);
+  ierr = DMPlexSNESGetGeometryFEM(dm, &cellgeom);CHKERRQ(ierr);
+  ierr = VecGetArray(cellgeom, (PetscScalar **) &cgeom);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {
+    PetscFECellGeom *geom = &cgeom[c-cStart];
+    PetscScalar     *u = NULL, *y = NULL, *ua = NULL;
+    PetscInt         i, j;
+
+    ierr = DMPlexVecGetClosure(dm, section, U, c, NULL, &u);CHKERRQ(ierr);
+    ierr = DMPlexVecGetClosure(dm, section, X, c, NULL, &y);CHKERRQ(ierr);
+    if (dmAux) {ierr = DMPlexVecGetClosure(dmAux, sectionAux, A, c, NULL, &ua);CHKERRQ(ierr);}
+    ierr = PetscMemzero(elemVec, totDim * sizeof(PetscScalar));CHKERRQ(ierr);
+    if (isTensor) {
+      /* Sum factorization: interpolate the state and the direction to the quadrature points direction by direction,
+         apply the pointwise linearization, and integrate back against the basis with the transposed 1D factors */
+      for (f = 0; f < Nf; ++f) {
+        PetscInt fc;
+
+        for (fc = 0; fc < Nc[f]; ++fc) {
+          const PetscInt k = uOff[f]+fc;
+
+          PlexMFEvaluate_Static(dim, &tensor[f], Nb[f], Nc[f], fc, &u[off[f]], lex, &su[k*Nq], &sur[k*dim*Nq], Nq, work0, work1);
+          PlexMFEvaluate_Static(dim, &tensor[f], Nb[f], Nc[f], fc, &y[off[f]], lex, &du[k*Nq], &dur[k*dim*Nq], Nq, work0, work1);
+        }
+      }
+      ierr = PetscMemzero(f0, totComp*Nq * sizeof(PetscScalar));CHKERRQ(ierr);
+      ierr = PetscMemzero(f1, totComp*dim*Nq * sizeof(PetscScalar));CHKERRQ(ierr);
+      for (i = 0; i < Nq; ++i) {
+        const PetscReal w = geom->detJ*quadWeights[qinv[i]];
+        PetscInt        k, d, e;
+
+        q = qinv[i];
+        CoordinatesRefToReal(dim, dim, geom->v0, geom->J, &quadPoints[q*dim], x);
+        for (k = 0; k < totComp; ++k) {
+          uq[k] = su[k*Nq+i];
+          for (d = 0; d < dim; ++d) {
+            uq_x[k*dim+d] = 0.0;
+            for (e = 0; e < dim; ++e) uq_x[k*dim+d] += geom->invJ[e*dim+d]*sur[(k*dim+e)*Nq+i];
+          }
+        }
+        ierr = EvaluateFieldJets(probAux, PETSC_FALSE, q, geom->invJ, ua, NULL, a, a_x, NULL);CHKERRQ(ierr);
+        for (f = 0; f < Nf; ++f) {
+          for (g = 0; g < Nf; ++g) {
+            PetscBool has;
+            PetscInt  fc, gc;
+
+            if (!hasJac[f*Nf+g]) continue;
+            ierr = PlexMFPointwiseJacobian_Static(prob, f, g, Nc[f], Nc[g], NfAux, aOff, aOff_x, uq, uq_x, a, a_x, x, geom->invJ, w, tmp, g0, g1, g2, g3, &has);CHKERRQ(ierr);
+            for (fc = 0; fc < Nc[f]; ++fc) {
+              const PetscInt kf = uOff[f]+fc;
+
+              for (gc = 0; gc < Nc[g]; ++gc) {
+                const PetscInt    kg  = uOff[g]+gc;
+                const PetscInt    fgc = fc*Nc[g]+gc;
+                const PetscScalar v   = du[kg*Nq+i];
+
+                f0[kf*Nq+i] += g0[fgc]*v;
+                for (d = 0; d < dim; ++d) {
+                  f0[kf*Nq+i]          += g1[fgc*dim+d]*dur[(kg*dim+d)*Nq+i];
+                  f1[(kf*dim+d)*Nq+i]  += g2[fgc*dim+d]*v;
+                  for (e = 0; e < dim; ++e) f1[(kf*dim+d)*Nq+i] += g3[(fgc*dim+d)*dim+e]*dur[(kg*dim+e)*Nq+i];
+                }
+              }
+            }
+          }
+        }
+      }
+      for (f = 0; f < Nf; ++f) {
+        PetscInt fc;
+
+        for (fc = 0; fc < Nc[f]; ++fc) {
+          const PetscInt k = uOff[f]+fc;
+
+          PlexMFIntegrate_Static(dim, &tensor[f], Nb[f], Nc[f], fc, &f0[k*Nq], &f1[k*dim*Nq], Nq, lex, &elemVec[off[f]], work0, work1);
+        }
+      }
+    } else {
+      /* Fall back to the element matrix for elements which do not factor */
+      ierr = PetscMemzero(elemMat, totDim*totDim * sizeof(PetscScalar));CHKERRQ(ierr);
+      for (f = 0; f < Nf; ++f) {
+        PetscFE fe;
+
+        ierr = PetscDSGetDiscretization(prob, f, (PetscObject *) &fe);CHKERRQ(ierr);
+        for (g = 0; g < Nf; ++g) {
+          if (!hasJac[f*Nf+g]) continue;
+          ierr = PetscFEIntegrateJacobian(fe, prob, f, g, 1, geom, u, NULL, probAux, ua, elemMat);CHKERRQ(ierr);
+        }
+      }
+      for (i = 0; i < totDim; ++i) for (j = 0; j < totDim; ++j) elemVec[i] += elemMat[i*totDim+j]*y[j];
+    }
+    ierr = DMPlexVecRestoreClosure(dm, section, U, c, NULL, &u);CHKERRQ(ierr);
+    ierr = DMPlexVecRestoreClosure(dm, section, X, c, NULL, &y);CHKERRQ(ierr);
+    if (dmAux) {ierr = DMPlexVecRestoreClosure(dmAux, sectionAux, A, c, NULL, &ua);CHKERRQ(ierr);}
+    ierr = DMPlexVecSetClosure(dm, section, Y, c, elemVec, ADD_VALUES);CHKERRQ(ierr);
+  }
+  ierr = VecRestoreArray(cellgeom, (PetscScalar **) &cgeom);CHKERRQ(ierr);
+  if (isTensor) {
+    ierr = PetscFree5(su, sur, du, dur, qinv);CHKERRQ(ierr);
+    ierr = PetscFree5(f0, f1, lex, work0, work1);CHKERRQ(ierr);
+    ierr = PetscFree5(uq, uq_x, g0, g1, g2);CHKERRQ(ierr);
+    ierr = PetscFree3(g3, tmp, x);CHKERRQ(ierr);
+  } else {
+    ierr = PetscFree(elemMat);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(elemVec);CHKERRQ(ierr);
+  for (f = 0; f < Nf; ++f) {ierr = PlexMFTensorDestroy_Static(&tensor[f]);CHKERRQ(ierr);}
+  ierr = PetscFree(qperm);CHKERRQ(ierr);
+  ierr = PetscFree5(tensor, hasJac, Nb, Nc, off);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(DMPLEX_JacobianActionFEM,dm,0,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexComputeJacobianDiagonal_Internal"
+PetscErrorCode DMPlexComputeJacobianDiagonal_Internal(DM dm, PetscInt cStart, PetscInt cEnd, Vec U, Vec D, void *user)
+{
+  DM                dmAux;
+  Vec               A, cellgeom;
+  PetscDS           prob, probAux = NULL;
+  PetscSection      section, sectionAux;
+  PetscQuadrature   quad;
+  PetscFECellGeom  *cgeom;
+  const PetscReal  *quadPoints, *quadWeights;
+  PetscReal       **basisField, **basisFieldDer, *x;
+  PetscScalar      *elemDiag, *a = NULL, *a_x = NULL, *uq, *uq_x, *g0, *g1, *g2, *g3, *tmp;
+  PetscInt         *aOff = NULL, *aOff_x = NULL;
+  PetscInt          dim, Nf, NfAux = 0, Nq, totDim, totComp, maxNc = 0, f, c, q;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = DMGetDimension(dm, &dim);CHKERRQ(ierr);
+  ierr = DMGetDefaultSection(dm, &section);CHKERRQ(ierr);
+  ierr = DMGetDS(dm, &prob);CHKERRQ(ierr);
+  ierr = PlexMFCheckSupported_Static(dm, prob);CHKERRQ(ierr);
+  ierr = PetscDSGetNumFields(prob, &Nf);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalDimension(prob, &totDim);CHKERRQ(ierr);
+  ierr = PetscDSGetTotalComponents(prob, &totComp);CHKERRQ(ierr);
+  ierr = PetscDSGetTabulation(prob, &basisField, &basisFieldDer);CHKERRQ(ierr);
+  ierr = PetscObjectQuery((PetscObject) dm, "dmAux", (PetscObject *) &dmAux);CHKERRQ(ierr);
+  ierr = PetscObjectQuery((PetscObject) dm, "A", (PetscObject *) &A);CHKERRQ(ierr);
+  if (dmAux) {
+    ierr = DMGetDefaultSection(dmAux, &sectionAux);CHKERRQ(ierr);
+    ierr = DMGetDS(dmAux, &probAux);CHKERRQ(ierr);
+    ierr = PetscDSGetNumFields(probAux, &NfAux);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentOffsets(probAux, &aOff);CHKERRQ(ierr);
+    ierr = PetscDSGetComponentDerivativeOffsets(probAux, &aOff_x);CHKERRQ(ierr);
+    ierr = PetscDSGetEvaluationArrays(probAux, &a, NULL, &a_x);CHKERRQ(ierr);
+  }
+  for (f = 0; f < Nf; ++f) {
+    PetscFE  fe;
+    PetscInt Ncf;
+
+    ierr = PetscDSGetDiscretization(prob, f, (PetscObject *) &fe);CHKERRQ(ierr);
+    ierr = PetscFEGetNumComponents(fe, &Ncf);CHKERRQ(ierr);
+    maxNc = PetscMax(maxNc, Ncf);
+    if (!f) {
+      ierr = PetscFEGetQuadrature(fe, &quad);CHKERRQ(ierr);
+      ierr = PetscQuadratureGetData(quad, NULL, &Nq, &quadPoints, &quadWeights);CHKERRQ(ierr);
+    }
+  }
+  ierr = PetscMalloc5(totDim, &elemDiag, totComp, &uq, totComp*dim, &uq_x, maxNc*maxNc, &g0, maxNc*maxNc*dim, &g1);CHKERRQ(ierr);
+  ierr = PetscMalloc4(maxNc*maxNc*dim, &g2, maxNc*maxNc*dim*dim, &g3, maxNc*maxNc*dim*dim, &tmp, dim, &x);CHKERRQ(ierr);
+  ierr = VecZeroEntries(D);CHKERRQ(ierr);
+  ierr = DMPlexSNESGetGeometryFEM(dm, &cellgeom);CHKERRQ(ierr);
+  ierr = VecGetArray(cellgeom, (PetscScalar **) &cgeom);CHKERRQ(ierr);
+  for (c = cStart; c < cEnd; ++c) {
+    PetscFECellGeom *geom = &cgeom[c-cStart];
+    PetscScalar     *u = NULL, *ua = NULL;
+
+    ierr = DMPlexVecGetClosure(dm, section, U, c, NULL, &u);CHKERRQ(ierr);
+    if (dmAux) {ierr = DMPlexVecGetClosure(dmAux, sectionAux, A, c, NULL, &ua);CHKERRQ(ierr);}
+    ierr = PetscMemzero(elemDiag, totDim * sizeof(PetscScalar));CHKERRQ(ierr);
+    for (q = 0; q < Nq; ++q) {
+      CoordinatesRefToReal(dim, dim, geom->v0, geom->J, &quadPoints[q*dim], x);
+      ierr = EvaluateFieldJets(prob,    PETSC_FALSE, q, geom->invJ, u,  NULL, uq, uq_x, NULL);CHKERRQ(ierr);
+      ierr = EvaluateFieldJets(probAux, PETSC_FALSE, q, geom->invJ, ua, NULL, a,  a_x,  NULL);CHKERRQ(ierr);
+      for (f = 0; f < Nf; ++f) {
+        const PetscReal *basis    = basisField[f];
+        const PetscReal *basisDer = basisFieldDer[f];
+        PetscFE          fe;
+        PetscBool        has;
+        PetscInt         Nb, Ncf, offset, b, fc, d, e;
+
+        ierr = PetscDSGetDiscretization(prob, f, (PetscObject *) &fe);CHKERRQ(ierr);
+        ierr = PetscFEGetDimension(fe, &Nb);CHKERRQ(ierr);
+        ierr = PetscFEGetNumComponents(fe, &Ncf);CHKERRQ(ierr);
+        ierr = PetscDSGetFieldOffset(prob, f, &offset);CHKERRQ(ierr);
+        ierr = PlexMFPointwiseJacobian_Static(prob, f, f, Ncf, Ncf, NfAux, aOff, aOff_x, uq, uq_x, a, a_x, x, geom->invJ, geom->detJ*quadWeights[q], tmp, g0, g1, g2, g3, &has);CHKERRQ(ierr);
+        if (!has) continue;
+        for (b = 0; b < Nb; ++b) {
+          for (fc = 0; fc < Ncf; ++fc) {
+            const PetscInt   idx  = b*Ncf+fc;
+            const PetscInt   ff   = fc*Ncf+fc;
+            const PetscReal  phi  = basis[q*Nb*Ncf+idx];
+            const PetscReal *dphi = &basisDer[(q*Nb*Ncf+idx)*dim];
+
+            elemDiag[offset+idx] += phi*g0[ff]*phi;
+            for (d = 0; d < dim; ++d) {
+              elemDiag[offset+idx] += phi*g1[ff*dim+d]*dphi[d] + dphi[d]*g2[ff*dim+d]*phi;
+              for (e = 0; e < dim; ++e) elemDiag[offset+idx] += dphi[d]*g3[(ff*dim+d)*dim+e]*dphi[e];
+            }
+          }
+        }
+      }
+    }
+    ierr = DMPlexVecRestoreClosure(dm, section, U, c, NULL, &u);CHKERRQ(ierr);
+    if (dmAux) {ierr = DMPlexVecRestoreClosure(dmAux, sectionAux, A, c, NULL, &ua);CHKERRQ(ierr);}
+    ierr = DMPlexVecSetClosure(dm, section, D, c, elemDiag, ADD_VALUES);CHKERRQ(ierr);
+  }
+  ierr = VecRestoreArray(cellgeom, (PetscScalar **) &cgeom);CHKERRQ(ierr);
+  ierr = PetscFree5(elemDiag, uq, uq_x, g0, g1);CHKERRQ(ierr);
+  ierr = PetscFree4(g2, g3, tmp, x);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexComputeJacobianActionFEM"
+/*@
+  DMPlexComputeJacobianActionFEM - Form the local action Y = J(U) X of the Jacobian at the local state U, without assembling J
+
+  Input Parameters:
++ dm - The mesh
+. U  - Local state at which the Jacobian is linearized
+. X  - Local input vector, with zero in the constrained dofs
+- user - The user context
+
+  Output Parameter:
+. Y  - Local output vector
+
+  Note:
+  The pointwise Jacobian functions set with PetscDSSetJacobian() are used. When every field is a nodal tensor product
+  element on a tensor product quadrature, as for PetscFECreateDefault() on quadrilaterals and hexahedra, the basis is
+  applied one direction at a time (sum factorization), so the work per cell is O(k^(d+1)) for polynomial order k rather
+  than the O(k^(2d)) of an element matrix. Other elements fall back to applying the element matrix on the fly.
+
+  Level: developer
+
+.seealso: DMPlexComputeJacobianDiagonalFEM(), DMPlexSNESCreateJacobianMF(), DMPlexSNESComputeJacobianFEM()
+@*/
+PetscErrorCode DMPlexComputeJacobianActionFEM(DM dm, Vec U, Vec X, Vec Y, void *user)
+{
+  PetscInt       cStart, cEnd, cEndInterior;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  PetscValidHeaderSpecific(U, VEC_CLASSID, 2);
+  PetscValidHeaderSpecific(X, VEC_CLASSID, 3);
+  PetscValidHeaderSpecific(Y, VEC_CLASSID, 4);
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetHybridBounds(dm, &cEndInterior, NULL, NULL, NULL);CHKERRQ(ierr);
+  cEnd = cEndInterior < 0 ? cEnd : cEndInterior;
+  ierr = DMPlexComputeJacobianAction_Internal(dm, cStart, cEnd, U, X, Y, user);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexComputeJacobianDiagonalFEM"
+/*@
+  DMPlexComputeJacobianDiagonalFEM - Form the local diagonal of the Jacobian at the local state U, without assembling the Jacobian
+
+  Input Parameters:
++ dm - The mesh
+. U  - Local state at which the Jacobian is linearized
+- user - The user context
+
+  Output Parameter:
+. D  - Local diagonal
+
+  Level: developer
+
+.seealso: DMPlexComputeJacobianActionFEM(), DMPlexSNESCreateJacobianMF()
+@*/
+PetscErrorCode DMPlexComputeJacobianDiagonalFEM(DM dm, Vec U, Vec D, void *user)
+{
+  PetscInt       cStart, cEnd, cEndInterior;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  PetscValidHeaderSpecific(U, VEC_CLASSID, 2);
+  PetscValidHeaderSpecific(D, VEC_CLASSID, 3);
+  ierr = DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd);CHKERRQ(ierr);
+  ierr = DMPlexGetHybridBounds(dm, &cEndInterior, NULL, NULL, NULL);CHKERRQ(ierr);
+  cEnd = cEndInterior < 0 ? cEnd : cEndInterior;
+  ierr = DMPlexComputeJacobianDiagonal_Internal(dm, cStart, cEnd, U, D, user);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatMult_DMPlexMF"
+static PetscErrorCode MatMult_DMPlexMF(Mat J, Vec X, Vec Y)
+{
+  JacActionCtx  *jctx;
+  Vec            locX, locY;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(J, &jctx);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(jctx->dm, &locX);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(jctx->dm, &locY);CHKERRQ(ierr);
+  /* Constrained dofs are not in the global vector, so they stay zero */
+  ierr = VecZeroEntries(locX);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalBegin(jctx->dm, X, INSERT_VALUES, locX);CHKERRQ(ierr);
+  ierr = DMGlobalToLocalEnd(jctx->dm, X, INSERT_VALUES, locX);CHKERRQ(ierr);
+  ierr = DMPlexComputeJacobianActionFEM(jctx->dm, jctx->u, locX, locY, jctx->user);CHKERRQ(ierr);
+  ierr = VecZeroEntries(Y);CHKERRQ(ierr);
+  ierr = DMLocalToGlobalBegin(jctx->dm, locY, ADD_VALUES, Y);CHKERRQ(ierr);
+  ierr = DMLocalToGlobalEnd(jctx->dm, locY, ADD_VALUES, Y);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(jctx->dm, &locX);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(jctx->dm, &locY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatGetDiagonal_DMPlexMF"
+static PetscErrorCode MatGetDiagonal_DMPlexMF(Mat J, Vec D)
+{
+  JacActionCtx  *jctx;
+  Vec            locD;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(J, &jctx);CHKERRQ(ierr);
+  ierr = DMGetLocalVector(jctx->dm, &locD);CHKERRQ(ierr);
+  ierr = DMPlexComputeJacobianDiagonalFEM(jctx->dm, jctx->u, locD, jctx->user);CHKERRQ(ierr);
+  ierr = VecZeroEntries(D);CHKERRQ(ierr);
+  ierr = DMLocalToGlobalBegin(jctx->dm, locD, ADD_VALUES, D);CHKERRQ(ierr);
+  ierr = DMLocalToGlobalEnd(jctx->dm, locD, ADD_VALUES, D);CHKERRQ(ierr);
+  ierr = DMRestoreLocalVector(jctx->dm, &locD);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "MatDestroy_DMPlexMF"
+static PetscErrorCode MatDestroy_DMPlexMF(Mat J)
+{
+  JacActionCtx  *jctx;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(J, &jctx);CHKERRQ(ierr);
+  ierr = VecDestroy(&jctx->u);CHKERRQ(ierr);
+  ierr = DMDestroy(&jctx->dm);CHKERRQ(ierr);
+  ierr = PetscFree(jctx);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "DMPlexSNESCreateJacobianMF"
+/*@
+  DMPlexSNESCreateJacobianMF - Create a MATSHELL which applies the Jacobian of the pointwise FEM problem without assembling it
+
+  Collective on DM
+
+  Input Parameters:
++ dm   - The mesh
+. X    - The local state for the initial linearization, or NULL for zero
+- user - The user context passed to DMPlexComputeJacobianActionFEM()
+
+  Output Parameter:
+. J - The matrix-free Jacobian, which supports MatMult() and MatGetDiagonal()
+
+  Notes:
+  The shell context is a JacActionCtx, so when J is passed as either matrix to SNESSetJacobian() with
+  DMPlexSNESComputeJacobianFEM() as the local Jacobian, each Jacobian evaluation moves the linearization point to the
+  current iterate. If J is also the preconditioning matrix nothing is assembled, and the diagonal is available for
+  Jacobi or Chebyshev smoothing.
+
+  Level: intermediate
+
+.seealso: DMPlexComputeJacobianActionFEM(), DMPlexComputeJacobianDiagonalFEM(), DMPlexSNESComputeJacobianFEM()
+@*/
+PetscErrorCode DMPlexSNESCreateJacobianMF(DM dm, Vec X, void *user, Mat *J)
+{
+  JacActionCtx  *jctx;
+  Vec            g;
+  PetscInt       m, M;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  if (X) PetscValidHeaderSpecific(X, VEC_CLASSID, 2);
+  PetscValidPointer(J, 4);
+  ierr = PetscNew(&jctx);CHKERRQ(ierr);
+  ierr = PetscObjectReference((PetscObject) dm);CHKERRQ(ierr);
+  jctx->dm   = dm;
+  jctx->user = user;
+  ierr = DMCreateLocalVector(dm, &jctx->u);CHKERRQ(ierr);
+  if (X) {ierr = VecCopy(X, jctx->u);CHKERRQ(ierr);}
+  ierr = DMGetGlobalVector(dm, &g);CHKERRQ(ierr);
+  ierr = VecGetLocalSize(g, &m);CHKERRQ(ierr);
+  ierr = VecGetSize(g, &M);CHKERRQ(ierr);
+  ierr = DMRestoreGlobalVector(dm, &g);CHKERRQ(ierr);
+  ierr = MatCreateShell(PetscObjectComm((PetscObject) dm), m, m, M, M, jctx, J);CHKERRQ(ierr);
+  ierr = MatShellSetOperation(*J, MATOP_MULT,         (void (*)(void)) MatMult_DMPlexMF);CHKERRQ(ierr);
+  ierr = MatShellSetOperation(*J, MATOP_GET_DIAGONAL, (void (*)(void)) MatGetDiagonal_DMPlexMF);CHKERRQ(ierr);
+  ierr = MatShellSetOperation(*J, MATOP_DESTROY,      (void (*)(void)) MatDestroy_DMPlexMF);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -23,6 +23,8 @@ typedef struct  {
   PetscBool     skipoptions;          /* don't use PETSc options database when loading */
   PetscInt      flowcontrol;          /* allow only <flowcontrol> messages outstanding at a time while doing IO */
   PetscBool     skipheader;           /* don't write header, only raw data */
+  PetscBool     veccompress;          /* write vectors as compressed records */
+  PetscReal     veccompresstol;       /* absolute error allowed when compressing vectors, 0 means lossless */
   PetscBool     matlabheaderwritten;  /* if format is PETSC_VIEWER_BINARY_MATLAB has the MATLAB .info header been written yet */
   PetscBool     setfromoptionscalled;
 } PetscViewer_Binary;
@@ -626,6 +628,106 @@ PetscErrorCode PetscViewerBinaryGetSkipHeader(PetscViewer viewer,PetscBool  *ski
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "PetscViewerBinarySetVecCompression_Binary"
+PetscErrorCode PetscViewerBinarySetVecCompression_Binary(PetscViewer viewer,PetscBool flg,PetscReal tol)
+{
+  PetscViewer_Binary *vbinary = (PetscViewer_Binary*)viewer->data;
+
+  PetscFunctionBegin;
+  if (tol != PETSC_DEFAULT) {
+    if (tol < 0.0) SETERRQ(PetscObjectComm((PetscObject)viewer),PETSC_ERR_ARG_OUTOFRANGE,"Compression tolerance must be nonnegative");
+    vbinary->veccompresstol = tol;
+  }
+  vbinary->veccompress = flg;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscViewerBinarySetVecCompression"
+/*@
+    PetscViewerBinarySetVecCompression - write vectors compressed instead of as raw arrays of scalars
+
+    Logically Collective on PetscViewer
+
+    Input Parameters:
++   viewer - PetscViewer context, obtained from PetscViewerBinaryOpen()
+.   flg - PETSC_TRUE to compress vectors written with VecView()
+-   tol - absolute error allowed in each entry, 0.0 for lossless compression, or PETSC_DEFAULT to keep the current value
+
+    Options Database Keys:
++   -viewer_binary_vec_compress - compress vectors
+-   -viewer_binary_vec_compress_tolerance <tol> - absolute error allowed in each entry
+
+    Level: advanced
+
+    Notes: This must be called after PetscViewerSetType()
+
+    Lossless compression shuffles the bytes of the entries so that bytes of equal significance are stored together
+    and then compresses them with PetscLZCompress(). With a positive tolerance each real value is first rounded to a
+    multiple of 2*tol, so the entries are reproduced to within tol, and the integer multiples are compressed.
+
+    The compressed vectors are stored with their own class id, VecLoad() recognizes them and decompresses them on the fly
+    no matter how the viewer it reads from is configured. Compression cannot be combined with MPI-IO or PetscViewerBinarySetSkipHeader().
+
+.seealso: PetscViewerBinaryOpen(), PetscViewerBinaryGetVecCompression(), PetscLZCompress(), VecView(), VecLoad()
+@*/
+PetscErrorCode PetscViewerBinarySetVecCompression(PetscViewer viewer,PetscBool flg,PetscReal tol)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(viewer,PETSC_VIEWER_CLASSID,1);
+  PetscValidLogicalCollectiveBool(viewer,flg,2);
+  PetscValidLogicalCollectiveReal(viewer,tol,3);
+  ierr = PetscTryMethod(viewer,"PetscViewerBinarySetVecCompression_C",(PetscViewer,PetscBool,PetscReal),(viewer,flg,tol));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscViewerBinaryGetVecCompression_Binary"
+PetscErrorCode PetscViewerBinaryGetVecCompression_Binary(PetscViewer viewer,PetscBool *flg,PetscReal *tol)
+{
+  PetscViewer_Binary *vbinary = (PetscViewer_Binary*)viewer->data;
+
+  PetscFunctionBegin;
+  if (flg) *flg = vbinary->veccompress;
+  if (tol) *tol = vbinary->veccompresstol;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscViewerBinaryGetVecCompression"
+/*@
+    PetscViewerBinaryGetVecCompression - checks whether vectors are written compressed
+
+    Not Collective
+
+    Input Parameter:
+.   viewer - PetscViewer context, obtained from PetscViewerBinaryOpen()
+
+    Output Parameters:
++   flg - PETSC_TRUE if vectors are compressed
+-   tol - absolute error allowed in each entry, 0.0 means lossless
+
+    Level: advanced
+
+    Notes: Returns false for PETSCSOCKETVIEWER
+
+.seealso: PetscViewerBinaryOpen(), PetscViewerBinarySetVecCompression()
+@*/
+PetscErrorCode PetscViewerBinaryGetVecCompression(PetscViewer viewer,PetscBool *flg,PetscReal *tol)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(viewer,PETSC_VIEWER_CLASSID,1);
+  if (flg) *flg = PETSC_FALSE;
+  if (tol) *tol = 0.0;
+  ierr = PetscTryMethod(viewer,"PetscViewerBinaryGetVecCompression_C",(PetscViewer,PetscBool*,PetscReal*),(viewer,flg,tol));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "PetscViewerBinaryGetInfoPointer_Binary"
 PetscErrorCode PetscViewerBinaryGetInfoPointer_Binary(PetscViewer viewer,FILE **file)
@@ -1405,6 +1507,9 @@ static PetscErrorCode PetscViewerSetFromOptions_Binary(PetscOptions *PetscOption
   ierr = PetscOptionsBool("-viewer_binary_skip_info","Skip writing/reading .info file","PetscViewerBinarySetSkipInfo",PETSC_FALSE,&binary->skipinfo,&flg);CHKERRQ(ierr);
   ierr = PetscOptionsBool("-viewer_binary_skip_options","Skip parsing vec load options","PetscViewerBinarySetSkipOptions",PETSC_TRUE,&binary->skipoptions,&flg);CHKERRQ(ierr);
   ierr = PetscOptionsBool("-viewer_binary_skip_header","Skip writing/reading header information","PetscViewerBinarySetSkipHeader",PETSC_FALSE,&binary->skipheader,&flg);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-viewer_binary_vec_compress","Compress vectors when writing them","PetscViewerBinarySetVecCompression",binary->veccompress,&binary->veccompress,&flg);CHKERRQ(ierr);
+  ierr = PetscOptionsReal("-viewer_binary_vec_compress_tolerance","Absolute error allowed when compressing vectors, 0 for lossless","PetscViewerBinarySetVecCompression",binary->veccompresstol,&binary->veccompresstol,&flg);CHKERRQ(ierr);
+  if (binary->veccompresstol < 0.0) SETERRQ(PetscObjectComm((PetscObject)v),PETSC_ERR_ARG_OUTOFRANGE,"Compression tolerance must be nonnegative");
 #if defined(PETSC_HAVE_MPIIO)
   ierr = PetscOptionsBool("-viewer_binary_mpiio","Use MPI-IO functionality to write/read binary file","PetscViewerBinarySetUseMPIIO",PETSC_FALSE,&binary->usempiio,&flg);CHKERRQ(ierr);
 #endif
@@ -1433,6 +1538,8 @@ PETSC_EXTERN PetscErrorCode PetscViewerCreate_Binary(PetscViewer v)
   vbinary->skipinfo        = PETSC_FALSE;
   vbinary->skipoptions     = PETSC_TRUE;
   vbinary->skipheader      = PETSC_FALSE;
+  vbinary->veccompress     = PETSC_FALSE;
+  vbinary->veccompresstol  = 0.0;
   vbinary->setfromoptionscalled = PETSC_FALSE;
   v->ops->getsingleton     = PetscViewerGetSingleton_Binary;
   v->ops->restoresingleton = PetscViewerRestoreSingleton_Binary;
@@ -1446,6 +1553,8 @@ PETSC_EXTERN PetscErrorCode PetscViewerCreate_Binary(PetscViewer v)
   ierr = PetscObjectComposeFunction((PetscObject)v,"PetscViewerBinarySetFlowControl_C",PetscViewerBinarySetFlowControl_Binary);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)v,"PetscViewerBinarySetSkipHeader_C",PetscViewerBinarySetSkipHeader_Binary);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)v,"PetscViewerBinaryGetSkipHeader_C",PetscViewerBinaryGetSkipHeader_Binary);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)v,"PetscViewerBinarySetVecCompression_C",PetscViewerBinarySetVecCompression_Binary);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)v,"PetscViewerBinaryGetVecCompression_C",PetscViewerBinaryGetVecCompression_Binary);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)v,"PetscViewerBinaryGetSkipOptions_C",PetscViewerBinaryGetSkipOptions_Binary);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)v,"PetscViewerBinarySetSkipOptions_C",PetscViewerBinarySetSkipOptions_Binary);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)v,"PetscViewerBinaryGetSkipInfo_C",PetscViewerBinaryGetSkipInfo_Binary);CHKERRQ(ierr);
@@ -14,6 +14,10 @@ typedef struct {
   GroupList     *groups;
   PetscBool     basedimension2;  /* save vectors and DMDA vectors with a dimension of at least 2 even if the bs/dof is 1 */
   PetscBool     spoutput;  /* write data in single precision even if PETSc is compiled with double precision PetscReal */
+  PetscBool     chunkpartition;      /* chunk datasets to match the parallel distribution of the data */
+  PetscInt      compress;            /* deflate level of new datasets, 0 means no compression */
+  PetscBool     collectivemetadata;  /* read and write the file metadata collectively */
+  PetscBool     timestepappend;      /* write each dataset as a new timestep at the end of its time dimension */
 } PetscViewer_HDF5;
 
 #undef __FUNCT__
@@ -27,6 +31,11 @@ static PetscErrorCode PetscViewerSetFromOptions_HDF5(PetscOptions *PetscOptionsO
   ierr = PetscOptionsHead(PetscOptionsObject,"HDF5 PetscViewer Options");CHKERRQ(ierr);
   ierr = PetscOptionsBool("-viewer_hdf5_base_dimension2","1d Vectors get 2 dimensions in HDF5","PetscViewerHDF5SetBaseDimension2",hdf5->basedimension2,&hdf5->basedimension2,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsBool("-viewer_hdf5_sp_output","Force data to be written in single precision","PetscViewerHDF5SetSPOutput",hdf5->spoutput,&hdf5->spoutput,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-viewer_hdf5_chunk_partition","Chunk datasets to match the parallel distribution","PetscViewerHDF5SetChunkPartition",hdf5->chunkpartition,&hdf5->chunkpartition,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-viewer_hdf5_compress","Deflate level (0-9) of new datasets, 0 for none","PetscViewerHDF5SetCompress",hdf5->compress,&hdf5->compress,NULL);CHKERRQ(ierr);
+  if (hdf5->compress < 0 || hdf5->compress > 9) SETERRQ1(PetscObjectComm((PetscObject)v),PETSC_ERR_ARG_OUTOFRANGE,"Deflate level %D must be in [0, 9]",hdf5->compress);
+  ierr = PetscOptionsBool("-viewer_hdf5_collective_metadata","Read and write the file metadata collectively","PetscViewerHDF5SetCollectiveMetadata",hdf5->collectivemetadata,&hdf5->collectivemetadata,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-viewer_hdf5_timestep_append","Append each dataset written as a new timestep","PetscViewerHDF5SetTimestepAppend",hdf5->timestepappend,&hdf5->timestepappend,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsTail();CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -63,6 +72,10 @@ PetscErrorCode PetscViewerDestroy_HDF5(PetscViewer viewer)
   ierr = PetscFree(hdf5);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)viewer,"PetscViewerFileSetName_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)viewer,"PetscViewerFileSetMode_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)viewer,"PetscViewerHDF5SetChunkPartition_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)viewer,"PetscViewerHDF5SetCompress_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)viewer,"PetscViewerHDF5SetCollectiveMetadata_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)viewer,"PetscViewerHDF5SetTimestepAppend_C",NULL);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -234,6 +247,400 @@ PetscErrorCode PetscViewerHDF5GetSPOutput(PetscViewer viewer,PetscBool *flg)
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "PetscViewerHDF5SetChunkPartition_HDF5"
+PetscErrorCode  PetscViewerHDF5SetChunkPartition_HDF5(PetscViewer viewer, PetscBool flg)
+{
+  PetscViewer_HDF5 *hdf5 = (PetscViewer_HDF5*) viewer->data;
+
+  PetscFunctionBegin;
+  hdf5->chunkpartition = flg;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscViewerHDF5SetChunkPartition"
+/*@C
+     PetscViewerHDF5SetChunkPartition - New datasets are chunked to match the parallel distribution of the data
+       written into them, so that each process writes whole chunks.
+
+    Logically Collective on PetscViewer
+
+  Input Parameters:
++  viewer - the PetscViewer; if it is not hdf5 then this command is ignored
+-  flg - if PETSC_TRUE the chunk size along each distributed dimension is the largest local size along it
+
+  Options Database:
+.  -viewer_hdf5_chunk_partition - turns on (true) or off (false) chunking by the parallel distribution
+
+  Notes: By default vectors are stored in a single chunk per timestep (DMDA vectors in chunks chosen from the global size),
+         which all processes write into. Chunks matching the distribution avoid contention on the chunks and are required
+         for good performance with PetscViewerHDF5SetCompress(). Chunks larger than the 4 GiB HDF5 limit fall back to the default.
+
+  Level: intermediate
+
+.seealso: PetscViewerHDF5GetChunkPartition(), PetscViewerHDF5SetCompress(), PetscViewerHDF5Open()
+@*/
+PetscErrorCode PetscViewerHDF5SetChunkPartition(PetscViewer viewer,PetscBool flg)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(viewer,PETSC_VIEWER_CLASSID,1);
+  ierr = PetscTryMethod(viewer,"PetscViewerHDF5SetChunkPartition_C",(PetscViewer,PetscBool),(viewer,flg));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscViewerHDF5GetChunkPartition"
+/*@C
+     PetscViewerHDF5GetChunkPartition - Checks if new datasets are chunked to match the parallel distribution of the data
+
+    Not Collective
+
+  Input Parameter:
+.  viewer - the PetscViewer, must be of type HDF5
+
+  Output Parameter:
+.  flg - if PETSC_TRUE datasets are chunked by the parallel distribution
+
+  Level: intermediate
+
+.seealso: PetscViewerHDF5SetChunkPartition()
+@*/
+PetscErrorCode PetscViewerHDF5GetChunkPartition(PetscViewer viewer,PetscBool *flg)
+{
+  PetscViewer_HDF5 *hdf5 = (PetscViewer_HDF5*) viewer->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(viewer,PETSC_VIEWER_CLASSID,1);
+  *flg = hdf5->chunkpartition;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscViewerHDF5SetCompress_HDF5"
+PetscErrorCode  PetscViewerHDF5SetCompress_HDF5(PetscViewer viewer, PetscInt level)
+{
+  PetscViewer_HDF5 *hdf5 = (PetscViewer_HDF5*) viewer->data;
+
+  PetscFunctionBegin;
+  if (level < 0 || level > 9) SETERRQ1(PetscObjectComm((PetscObject)viewer),PETSC_ERR_ARG_OUTOFRANGE,"Deflate level %D must be in [0, 9]",level);
+  hdf5->compress = level;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscViewerHDF5SetCompress"
+/*@C
+     PetscViewerHDF5SetCompress - New datasets are compressed with the HDF5 shuffle and deflate filters
+
+    Logically Collective on PetscViewer
+
+  Input Parameters:
++  viewer - the PetscViewer; if it is not hdf5 then this command is ignored
+-  level - the deflate level, from 1 (fastest) to 9 (smallest), or 0 to not compress
+
+  Options Database:
+.  -viewer_hdf5_compress <level> - the deflate level
+
+  Notes: Writing compressed datasets from more than one process requires HDF5 1.10.2 or later. Use it together
+         with PetscViewerHDF5SetChunkPartition(), otherwise all processes compress the same chunk. Compressed
+         datasets are read transparently by VecLoad().
+
+  Level: intermediate
+
+.seealso: PetscViewerHDF5GetCompress(), PetscViewerHDF5SetChunkPartition(), PetscViewerHDF5Open()
+@*/
+PetscErrorCode PetscViewerHDF5SetCompress(PetscViewer viewer,PetscInt level)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(viewer,PETSC_VIEWER_CLASSID,1);
+  PetscValidLogicalCollectiveInt(viewer,level,2);
+  ierr = PetscTryMethod(viewer,"PetscViewerHDF5SetCompress_C",(PetscViewer,PetscInt),(viewer,level));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscViewerHDF5GetCompress"
+/*@C
+     PetscViewerHDF5GetCompress - Gets the deflate level used for new datasets
+
+    Not Collective
+
+  Input Parameter:
+.  viewer - the PetscViewer, must be of type HDF5
+
+  Output Parameter:
+.  level - the deflate level, 0 means not compressed
+
+  Level: intermediate
+
+.seealso: PetscViewerHDF5SetCompress()
+@*/
+PetscErrorCode PetscViewerHDF5GetCompress(PetscViewer viewer,PetscInt *level)
+{
+  PetscViewer_HDF5 *hdf5 = (PetscViewer_HDF5*) viewer->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(viewer,PETSC_VIEWER_CLASSID,1);
+  *level = hdf5->compress;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscViewerHDF5SetCollectiveMetadata_HDF5"
+PetscErrorCode  PetscViewerHDF5SetCollectiveMetadata_HDF5(PetscViewer viewer, PetscBool flg)
+{
+  PetscViewer_HDF5 *hdf5 = (PetscViewer_HDF5*) viewer->data;
+
+  PetscFunctionBegin;
+  if (hdf5->file_id) SETERRQ(PetscObjectComm((PetscObject)viewer),PETSC_ERR_ORDER,"Must call before PetscViewerFileSetName()");
+  hdf5->collectivemetadata = flg;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscViewerHDF5SetCollectiveMetadata"
+/*@C
+     PetscViewerHDF5SetCollectiveMetadata - The metadata of the file (groups, dataset headers, attributes) is read by one
+       process and broadcast, and written collectively, instead of being accessed by every process.
+
+    Logically Collective on PetscViewer
+
+  Input Parameters:
++  viewer - the PetscViewer; if it is not hdf5 then this command is ignored
+-  flg - if PETSC_TRUE use collective metadata operations
+
+  Options Database:
+.  -viewer_hdf5_collective_metadata - turns on (true) or off (false) collective metadata operations
+
+  Notes: Must be called before PetscViewerFileSetName(); the option is processed when the file is opened.
+         Requires parallel HDF5 1.10.0 or later, it is ignored otherwise. It greatly reduces the load on the file system
+         when many processes write files with many datasets, such as files with many timesteps.
+
+  Level: intermediate
+
+.seealso: PetscViewerHDF5GetCollectiveMetadata(), PetscViewerHDF5Open()
+@*/
+PetscErrorCode PetscViewerHDF5SetCollectiveMetadata(PetscViewer viewer,PetscBool flg)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(viewer,PETSC_VIEWER_CLASSID,1);
+  PetscValidLogicalCollectiveBool(viewer,flg,2);
+  ierr = PetscTryMethod(viewer,"PetscViewerHDF5SetCollectiveMetadata_C",(PetscViewer,PetscBool),(viewer,flg));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscViewerHDF5GetCollectiveMetadata"
+/*@C
+     PetscViewerHDF5GetCollectiveMetadata - Checks if the metadata of the file is accessed collectively
+
+    Not Collective
+
+  Input Parameter:
+.  viewer - the PetscViewer, must be of type HDF5
+
+  Output Parameter:
+.  flg - if PETSC_TRUE collective metadata operations are requested
+
+  Level: intermediate
+
+.seealso: PetscViewerHDF5SetCollectiveMetadata()
+@*/
+PetscErrorCode PetscViewerHDF5GetCollectiveMetadata(PetscViewer viewer,PetscBool *flg)
+{
+  PetscViewer_HDF5 *hdf5 = (PetscViewer_HDF5*) viewer->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(viewer,PETSC_VIEWER_CLASSID,1);
+  *flg = hdf5->collectivemetadata;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscViewerHDF5SetTimestepAppend_HDF5"
+PetscErrorCode  PetscViewerHDF5SetTimestepAppend_HDF5(PetscViewer viewer, PetscBool flg)
+{
+  PetscViewer_HDF5 *hdf5 = (PetscViewer_HDF5*) viewer->data;
+
+  PetscFunctionBegin;
+  hdf5->timestepappend = flg;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscViewerHDF5SetTimestepAppend"
+/*@C
+     PetscViewerHDF5SetTimestepAppend - Each vector or index set written is appended as a new timestep at the end of
+       the time dimension of its dataset, the dataset is created with a time dimension when it does not exist.
+
+    Logically Collective on PetscViewer
+
+  Input Parameters:
++  viewer - the PetscViewer; if it is not hdf5 then this command is ignored
+-  flg - if PETSC_TRUE append new timesteps
+
+  Options Database:
+.  -viewer_hdf5_timestep_append - turns on (true) or off (false) appending timesteps
+
+  Notes: This replaces the timestep set with PetscViewerHDF5SetTimestep() when writing, so a transient simulation can write its
+         fields at every step into the same datasets, which are extended in place, without keeping track of the step number
+         or pushing a new group per step. Use FILE_MODE_APPEND to continue a file written earlier. Reading is not affected; use
+         PetscViewerHDF5SetTimestep() to select the timestep to load.
+
+  Level: intermediate
+
+.seealso: PetscViewerHDF5GetTimestepAppend(), PetscViewerHDF5SetTimestep(), PetscViewerHDF5Open()
+@*/
+PetscErrorCode PetscViewerHDF5SetTimestepAppend(PetscViewer viewer,PetscBool flg)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(viewer,PETSC_VIEWER_CLASSID,1);
+  PetscValidLogicalCollectiveBool(viewer,flg,2);
+  ierr = PetscTryMethod(viewer,"PetscViewerHDF5SetTimestepAppend_C",(PetscViewer,PetscBool),(viewer,flg));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscViewerHDF5GetTimestepAppend"
+/*@C
+     PetscViewerHDF5GetTimestepAppend - Checks if written datasets are appended as new timesteps
+
+    Not Collective
+
+  Input Parameter:
+.  viewer - the PetscViewer, must be of type HDF5
+
+  Output Parameter:
+.  flg - if PETSC_TRUE new timesteps are appended
+
+  Level: intermediate
+
+.seealso: PetscViewerHDF5SetTimestepAppend()
+@*/
+PetscErrorCode PetscViewerHDF5GetTimestepAppend(PetscViewer viewer,PetscBool *flg)
+{
+  PetscViewer_HDF5 *hdf5 = (PetscViewer_HDF5*) viewer->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(viewer,PETSC_VIEWER_CLASSID,1);
+  *flg = hdf5->timestepappend;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscViewerHDF5GetWriteTimestep"
+/*@C
+  PetscViewerHDF5GetWriteTimestep - Get the timestep at which a dataset is to be written
+
+  Collective on PetscViewer
+
+  Input Parameters:
++ viewer - the PetscViewer
+. group - the group containing the dataset, from PetscViewerHDF5OpenGroup()
+- name - the name of the dataset
+
+  Output Parameter:
+. timestep - the timestep number, -1 if the dataset has no time dimension
+
+  Notes: This is the timestep of the viewer, unless PetscViewerHDF5SetTimestepAppend() was used, in which case it
+  is the number of timesteps already in the dataset.
+
+  Level: developer
+
+.seealso: PetscViewerHDF5GetTimestep(), PetscViewerHDF5SetTimestepAppend()
+@*/
+PetscErrorCode PetscViewerHDF5GetWriteTimestep(PetscViewer viewer, hid_t group, const char name[], PetscInt *timestep)
+{
+  PetscViewer_HDF5 *hdf5 = (PetscViewer_HDF5*) viewer->data;
+  hid_t            dset_id, filespace;
+  hsize_t          dims[5], maxDims[5];
+  int              rdim;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(viewer,PETSC_VIEWER_CLASSID,1);
+  PetscValidPointer(timestep,4);
+  *timestep = hdf5->timestep;
+  if (!hdf5->timestepappend) PetscFunctionReturn(0);
+  *timestep = 0;
+  if (H5Lexists(group, name, H5P_DEFAULT) <= 0) PetscFunctionReturn(0);
+  PetscStackCallHDF5Return(dset_id,H5Dopen2,(group, name, H5P_DEFAULT));
+  PetscStackCallHDF5Return(filespace,H5Dget_space,(dset_id));
+  PetscStackCallHDF5Return(rdim,H5Sget_simple_extent_dims,(filespace, dims, maxDims));
+  PetscStackCallHDF5(H5Sclose,(filespace));
+  PetscStackCallHDF5(H5Dclose,(dset_id));
+  if (rdim < 1 || maxDims[0] != H5S_UNLIMITED) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"Dataset %s has no time dimension to append to",name);
+  *timestep = (PetscInt) dims[0];
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscViewerHDF5CreateDatasetProperties"
+/*@C
+  PetscViewerHDF5CreateDatasetProperties - Creates the dataset creation property list used for a new dataset written
+  by this viewer, with its chunking and filters
+
+  Collective on PetscViewer
+
+  Input Parameters:
++ viewer - the PetscViewer
+. dim - the number of dimensions of the dataset
+. count - the size of the part of the dataset written by this process along each dimension
+- chunkDims - the default chunk dimensions
+
+  Output Parameter:
+. plist - the property list, free it with H5Pclose()
+
+  Level: developer
+
+.seealso: PetscViewerHDF5SetChunkPartition(), PetscViewerHDF5SetCompress()
+@*/
+PetscErrorCode PetscViewerHDF5CreateDatasetProperties(PetscViewer viewer, int dim, const hsize_t count[], const hsize_t chunkDims[], hid_t *plist)
+{
+  PetscViewer_HDF5 *hdf5 = (PetscViewer_HDF5*) viewer->data;
+  hsize_t          chunk[6];
+  PetscMPIInt      size;
+  PetscInt         d;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  if (dim > 6) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Dataset dimension %d too large",dim);
+  for (d=0; d<dim; d++) chunk[d] = chunkDims[d];
+  if (hdf5->chunkpartition) {
+    unsigned long long lcount[6],gcount[6];
+    double             bytes = sizeof(PetscReal);
+
+    for (d=0; d<dim; d++) lcount[d] = (unsigned long long) count[d];
+    ierr = MPI_Allreduce(lcount,gcount,dim,MPI_UNSIGNED_LONG_LONG,MPI_MAX,PetscObjectComm((PetscObject)viewer));CHKERRQ(ierr);
+    for (d=0; d<dim; d++) bytes *= (double) PetscMax(gcount[d],1);
+    if (bytes < 4.0*1024*1024*1024) {
+      for (d=0; d<dim; d++) chunk[d] = (hsize_t) PetscMax(gcount[d],1);
+    } else {
+      ierr = PetscInfo(viewer,"Local parts of the dataset are larger than the HDF5 chunk limit, using the default chunks\n");CHKERRQ(ierr);
+    }
+  }
+  PetscStackCallHDF5Return(*plist,H5Pcreate,(H5P_DATASET_CREATE));
+  PetscStackCallHDF5(H5Pset_chunk,(*plist, dim, chunk));
+  if (hdf5->compress) {
+    ierr = MPI_Comm_size(PetscObjectComm((PetscObject)viewer),&size);CHKERRQ(ierr);
+#if (H5_VERS_MAJOR * 10000 + H5_VERS_MINOR * 100 + H5_VERS_RELEASE < 11002)
+    if (size > 1) SETERRQ(PetscObjectComm((PetscObject)viewer),PETSC_ERR_SUP_SYS,"Writing compressed datasets in parallel requires HDF5 1.10.2 or later");
+#endif
+    if (H5Zfilter_avail(H5Z_FILTER_DEFLATE) <= 0) SETERRQ(PetscObjectComm((PetscObject)viewer),PETSC_ERR_SUP_SYS,"HDF5 was built without the deflate filter");
+    PetscStackCallHDF5(H5Pset_shuffle,(*plist));
+    PetscStackCallHDF5(H5Pset_deflate,(*plist, (unsigned) hdf5->compress));
+  }
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "PetscViewerFileSetName_HDF5"
 PetscErrorCode  PetscViewerFileSetName_HDF5(PetscViewer viewer, const char name[])
@@ -252,6 +659,16 @@ PetscErrorCode  PetscViewerFileSetName_HDF5(PetscViewer viewer, const char name[
 #if defined(PETSC_HAVE_H5PSET_FAPL_MPIO)
   PetscStackCallHDF5(H5Pset_fapl_mpio,(plist_id, PetscObjectComm((PetscObject)viewer), info));
 #endif
+  /* the file access properties are fixed when the file is opened, which usually happens before PetscViewerSetFromOptions() */
+  ierr = PetscOptionsGetBool(((PetscObject)viewer)->prefix,"-viewer_hdf5_collective_metadata",&hdf5->collectivemetadata,NULL);CHKERRQ(ierr);
+  if (hdf5->collectivemetadata) {
+#if defined(PETSC_HAVE_H5PSET_FAPL_MPIO) && (H5_VERS_MAJOR * 10000 + H5_VERS_MINOR * 100 + H5_VERS_RELEASE >= 11000)
+    PetscStackCallHDF5(H5Pset_all_coll_metadata_ops,(plist_id, 1));
+    PetscStackCallHDF5(H5Pset_coll_metadata_write,(plist_id, 1));
+#else
+    ierr = PetscInfo(viewer,"Collective metadata requires parallel HDF5 1.10.0 or later, ignoring it\n");CHKERRQ(ierr);
+#endif
+  }
   /* Create or open the file collectively */
   switch (hdf5->btype) {
   case FILE_MODE_READ:
@@ -294,6 +711,10 @@ PETSC_EXTERN PetscErrorCode PetscViewerCreate_HDF5(PetscViewer v)
   ierr = PetscObjectComposeFunction((PetscObject)v,"PetscViewerFileSetMode_C",PetscViewerFileSetMode_HDF5);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)v,"PetscViewerHDF5SetBaseDimension2_C",PetscViewerHDF5SetBaseDimension2_HDF5);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)v,"PetscViewerHDF5SetSPOutput_C",PetscViewerHDF5SetSPOutput_HDF5);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)v,"PetscViewerHDF5SetChunkPartition_C",PetscViewerHDF5SetChunkPartition_HDF5);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)v,"PetscViewerHDF5SetCompress_C",PetscViewerHDF5SetCompress_HDF5);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)v,"PetscViewerHDF5SetCollectiveMetadata_C",PetscViewerHDF5SetCollectiveMetadata_HDF5);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)v,"PetscViewerHDF5SetTimestepAppend_C",PetscViewerHDF5SetTimestepAppend_HDF5);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -318,6 +739,10 @@ $    FILE_MODE_APPEND - open existing file for binary output
   Options Database:
 .  -viewer_hdf5_base_dimension2 - turns on (true) or off (false) using a dimension of 2 in the HDF5 file even if the bs/dof of the vector is 1
 .  -viewer_hdf5_sp_output - forces (if true) the viewer to write data in single precision independent on the precision of PetscReal
+.  -viewer_hdf5_chunk_partition - chunk new datasets to match the parallel distribution of the data
+.  -viewer_hdf5_compress <level> - compress new datasets with the given deflate level
+.  -viewer_hdf5_collective_metadata - access the file metadata collectively
+.  -viewer_hdf5_timestep_append - append each dataset written as a new timestep
 
    Level: beginner
 
@@ -0,0 +1,217 @@
+
+/*
+     Simple, dependency free, compression of binary data: a byte shuffle, which groups the bytes of equal
+   significance of an array of numbers together, and an LZ77 coder in the style of LZF.
+*/
+#include <petscsys.h>   /*I  "petscsys.h"  I*/
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscByteShuffle"
+/*@C
+   PetscByteShuffle - Reorders the bytes of an array of fixed size items so that byte b of every item is stored
+   before byte b+1 of any item
+
+   Not Collective
+
+   Input Parameters:
++  in - the items
+.  count - the number of items
+-  size - the size of each item in bytes
+
+   Output Parameter:
+.  out - the shuffled bytes, must not overlap in
+
+   Notes: Floating point and integer data of similar magnitude share their high bytes, so the shuffled data
+   compresses much better with PetscLZCompress() than the original.
+
+   Level: developer
+
+.seealso: PetscByteUnshuffle(), PetscLZCompress()
+@*/
+PetscErrorCode PetscByteShuffle(const void *in,void *out,size_t count,size_t size)
+{
+  const unsigned char *src = (const unsigned char*)in;
+  unsigned char       *dst = (unsigned char*)out;
+  size_t              i,b;
+
+  PetscFunctionBegin;
+  for (b=0; b<size; b++) {
+    for (i=0; i<count; i++) dst[b*count+i] = src[i*size+b];
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscByteUnshuffle"
+/*@C
+   PetscByteUnshuffle - Reverses PetscByteShuffle()
+
+   Not Collective
+
+   Input Parameters:
++  in - the shuffled bytes
+.  count - the number of items
+-  size - the size of each item in bytes
+
+   Output Parameter:
+.  out - the items, must not overlap in
+
+   Level: developer
+
+.seealso: PetscByteShuffle()
+@*/
+PetscErrorCode PetscByteUnshuffle(const void *in,void *out,size_t count,size_t size)
+{
+  const unsigned char *src = (const unsigned char*)in;
+  unsigned char       *dst = (unsigned char*)out;
+  size_t              i,b;
+
+  PetscFunctionBegin;
+  for (b=0; b<size; b++) {
+    for (i=0; i<count; i++) dst[i*size+b] = src[b*count+i];
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   The compressed stream is a sequence of runs, each starting with a control byte c:
+     c < 32        - a literal run, the next c+1 bytes are copied to the output
+     c >= 32       - a back reference of length l+2 where l = c>>5, if l == 7 the next byte is added to l;
+                     the following byte is the low part of the offset, the distance back in the output is
+                     ((c & 31) << 8) + byte + 1
+*/
+#define PETSC_LZ_HASHLOG   14
+#define PETSC_LZ_MAXOFF    8192
+#define PETSC_LZ_MAXLIT    32
+#define PETSC_LZ_MAXREF    (255 + 7 + 2)
+#define PETSC_LZ_HASH(p)   ((((unsigned int)(p)[0] << 16 | (unsigned int)(p)[1] << 8 | (unsigned int)(p)[2])*2654435761U) >> (32 - PETSC_LZ_HASHLOG))
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscLZCompress"
+/*@C
+   PetscLZCompress - Compresses a buffer with a fast LZ77 coder
+
+   Not Collective
+
+   Input Parameters:
++  in - the data
+.  n - the number of bytes of data
+-  cap - the space available in out
+
+   Output Parameters:
++  out - the compressed data
+-  outlen - the number of bytes of compressed data, or 0 if the data does not fit in cap bytes
+
+   Notes: Pass cap smaller than n to only accept output that is actually compressed.
+
+   Level: developer
+
+.seealso: PetscLZDecompress(), PetscByteShuffle()
+@*/
+PetscErrorCode PetscLZCompress(const void *in,size_t n,void *out,size_t cap,size_t *outlen)
+{
+  const unsigned char *ip = (const unsigned char*)in;
+  unsigned char       *op = (unsigned char*)out;
+  size_t              i = 0,o = 0,lit = 0,litpos,*htab,h;
+  PetscErrorCode      ierr;
+
+  PetscFunctionBegin;
+  *outlen = 0;
+  if (!n || !cap) PetscFunctionReturn(0);
+  ierr = PetscMalloc1(1 << PETSC_LZ_HASHLOG,&htab);CHKERRQ(ierr);
+  for (h=0; h<(1 << PETSC_LZ_HASHLOG); h++) htab[h] = (size_t)-1;
+  litpos = o++;
+  while (i < n) {
+    size_t ref = (size_t)-1;
+
+    if (i + 2 < n) {
+      h       = PETSC_LZ_HASH(ip+i);
+      ref     = htab[h];
+      htab[h] = i;
+    }
+    if (ref != (size_t)-1 && i - ref <= PETSC_LZ_MAXOFF && ip[ref] == ip[i] && ip[ref+1] == ip[i+1] && ip[ref+2] == ip[i+2]) {
+      size_t off = i - ref - 1,len = 3,maxlen = PetscMin(n - i,PETSC_LZ_MAXREF),l;
+
+      while (len < maxlen && ip[ref+len] == ip[i+len]) len++;
+      if (lit) op[litpos] = (unsigned char)(lit - 1);
+      else o--;
+      if (o + 4 > cap) goto incompressible;
+      l = len - 2;
+      if (l < 7) op[o++] = (unsigned char)((off >> 8) + (l << 5));
+      else {
+        op[o++] = (unsigned char)((off >> 8) + (7 << 5));
+        op[o++] = (unsigned char)(l - 7);
+      }
+      op[o++] = (unsigned char)(off & 0xff);
+      i      += len;
+      lit     = 0;
+      litpos  = o++;
+    } else {
+      if (o + 1 > cap) goto incompressible;
+      op[o++] = ip[i++];
+      if (++lit == PETSC_LZ_MAXLIT) {
+        op[litpos] = (unsigned char)(lit - 1);
+        lit        = 0;
+        if (o + 1 > cap) goto incompressible;
+        litpos = o++;
+      }
+    }
+  }
+  if (lit) op[litpos] = (unsigned char)(lit - 1);
+  else o--;
+  *outlen = o;
+incompressible:
+  ierr = PetscFree(htab);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscLZDecompress"
+/*@C
+   PetscLZDecompress - Decompresses data produced by PetscLZCompress()
+
+   Not Collective
+
+   Input Parameters:
++  in - the compressed data
+.  n - the number of bytes of compressed data
+-  outlen - the number of bytes of uncompressed data
+
+   Output Parameter:
+.  out - the uncompressed data
+
+   Level: developer
+
+.seealso: PetscLZCompress(), PetscByteUnshuffle()
+@*/
+PetscErrorCode PetscLZDecompress(const void *in,size_t n,void *out,size_t outlen)
+{
+  const unsigned char *ip = (const unsigned char*)in;
+  unsigned char       *op = (unsigned char*)out;
+  size_t              i = 0,o = 0,len,off,k;
+
+  PetscFunctionBegin;
+  while (i < n) {
+    unsigned int c = ip[i++];
+
+    if (c < PETSC_LZ_MAXLIT) {
+      len = c + 1;
+      if (i + len > n || o + len > outlen) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"Corrupt compressed data");
+      for (k=0; k<len; k++) op[o++] = ip[i++];
+    } else {
+      len = c >> 5;
+      if (len == 7) {
+        if (i >= n) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"Corrupt compressed data");
+        len += ip[i++];
+      }
+      len += 2;
+      if (i >= n) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"Corrupt compressed data");
+      off = ((size_t)(c & 31) << 8) + ip[i++] + 1;
+      if (off > o || o + len > outlen) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"Corrupt compressed data");
+      /* the reference may overlap the bytes being produced */
+      for (k=0; k<len; k++, o++) op[o] = op[o-off];
+    }
+  }
+  if (o != outlen) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"Compressed data expands to %D bytes, expected %D",(PetscInt)o,(PetscInt)outlen);
+  PetscFunctionReturn(0);
+}
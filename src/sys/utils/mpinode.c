@@ -0,0 +1,155 @@
+#include <petscsys.h>        /*I  "petscsys.h"  I*/
+#if defined(PETSC_HAVE_HWLOC)
+#include <hwloc.h>
+#endif
+
+#if !defined(PETSC_HAVE_MPI_COMM_SPLIT_TYPE)
+#undef __FUNCT__
+#define __FUNCT__ "PetscHashProcessorName_Private"
+/* A nonnegative hash of the processor name, used to split the communicator by node when MPI cannot do it for us */
+static PetscErrorCode PetscHashProcessorName_Private(PetscMPIInt *color)
+{
+  char           name[MPI_MAX_PROCESSOR_NAME];
+  PetscMPIInt    len,i;
+  unsigned int   h = 5381;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscMemzero(name,sizeof(name));CHKERRQ(ierr);
+  ierr = MPI_Get_processor_name(name,&len);CHKERRQ(ierr);
+  for (i=0; i<len; i++) h = 33*h + (unsigned char) name[i];
+  *color = (PetscMPIInt) (h & 0x7fffffff);
+  PetscFunctionReturn(0);
+}
+#endif
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscGetSocket_Private"
+/* The logical index of the socket this process is bound to, or 0 if it is not bound to a single socket */
+static PetscErrorCode PetscGetSocket_Private(PetscMPIInt *socket)
+{
+  PetscFunctionBegin;
+  *socket = 0;
+#if defined(PETSC_HAVE_HWLOC)
+  {
+    hwloc_topology_t topology;
+    hwloc_bitmap_t   set;
+    hwloc_obj_t      obj;
+
+    if (hwloc_topology_init(&topology)) PetscFunctionReturn(0);
+    if (!hwloc_topology_load(topology)) {
+      set = hwloc_bitmap_alloc();
+      if (!hwloc_get_cpubind(topology,set,HWLOC_CPUBIND_PROCESS)) {
+        obj = hwloc_get_next_obj_covering_cpuset_by_type(topology,set,HWLOC_OBJ_SOCKET,NULL);
+        if (obj && !hwloc_get_next_obj_covering_cpuset_by_type(topology,set,HWLOC_OBJ_SOCKET,obj)) *socket = (PetscMPIInt) obj->logical_index;
+      }
+      hwloc_bitmap_free(set);
+    }
+    hwloc_topology_destroy(topology);
+  }
+#endif
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscCommGetNodeLayout"
+/*@C
+   PetscCommGetNodeLayout - Groups the processes of a communicator by the compute node, and within each node by
+   the processor socket, on which they run
+
+   Collective on MPI_Comm
+
+   Input Parameter:
+.  comm - the communicator
+
+   Output Parameters:
++  numNodes      - the number of compute nodes
+.  nodeOffsets   - the offset in ranks[] of the first process of each node, with numNodes+1 entries
+.  numSockets    - the number of sockets, counted over all nodes
+.  socketOffsets - the offset in ranks[] of the first process of each socket, with numSockets+1 entries
+-  ranks         - the ranks of comm ordered by node, then by socket, then by rank
+
+   Options Database Keys:
++  -comm_node_size <n>   - treat each n consecutive ranks as one node, instead of the discovered nodes
+-  -comm_socket_size <n> - treat each n consecutive ranks of a node as one socket
+
+   Level: developer
+
+   Notes:
+   Nodes are the groups of MPI_Comm_split_type(MPI_COMM_TYPE_SHARED) when MPI provides it, and otherwise the processes
+   reporting the same MPI_Get_processor_name(). Sockets are found with hwloc when PETSc is configured with it, and
+   otherwise each node is a single socket. Nodes are ordered by their lowest rank. Sockets never span nodes, so
+   socketOffsets[] refines nodeOffsets[].
+
+   The arrays are allocated with PetscMalloc() and must be freed by the caller with PetscFree().
+
+.seealso: DMDASetTopologyAware(), PetscPartitionerSetTopologyAware()
+@*/
+PetscErrorCode PetscCommGetNodeLayout(MPI_Comm comm,PetscMPIInt *numNodes,PetscMPIInt *nodeOffsets[],PetscMPIInt *numSockets,PetscMPIInt *socketOffsets[],PetscMPIInt *ranks[])
+{
+  PetscMPIInt    size,rank,key[2],*keys,*count,*tmp,*order,maxSocket,i,n,s;
+  PetscInt       nodeSize = 0,socketSize = 0;
+  PetscBool      flg;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,"-comm_node_size",&nodeSize,&flg);CHKERRQ(ierr);
+  if (flg && nodeSize < 1) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Node size %D must be positive",nodeSize);
+  ierr = PetscOptionsGetInt(NULL,"-comm_socket_size",&socketSize,&flg);CHKERRQ(ierr);
+  if (flg && socketSize < 1) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Socket size %D must be positive",socketSize);
+
+  /* key[0] is the lowest rank on our node, and key[1] our socket within it */
+  if (nodeSize) key[0] = (rank/nodeSize)*nodeSize;
+  else {
+    MPI_Comm    nodecomm;
+#if defined(PETSC_HAVE_MPI_COMM_SPLIT_TYPE)
+    ierr = MPI_Comm_split_type(comm,MPI_COMM_TYPE_SHARED,rank,MPI_INFO_NULL,&nodecomm);CHKERRQ(ierr);
+#else
+    PetscMPIInt color;
+
+    ierr = PetscHashProcessorName_Private(&color);CHKERRQ(ierr);
+    ierr = MPI_Comm_split(comm,color,rank,&nodecomm);CHKERRQ(ierr);
+#endif
+    ierr = MPI_Allreduce(&rank,&key[0],1,MPI_INT,MPI_MIN,nodecomm);CHKERRQ(ierr);
+    ierr = MPI_Comm_free(&nodecomm);CHKERRQ(ierr);
+  }
+  if (socketSize) key[1] = (rank-key[0])/socketSize;
+  else {ierr = PetscGetSocket_Private(&key[1]);CHKERRQ(ierr);}
+  ierr = PetscMalloc3(2*size,&keys,size,&order,size,&tmp);CHKERRQ(ierr);
+  ierr = MPI_Allgather(key,2,MPI_INT,keys,2,MPI_INT,comm);CHKERRQ(ierr);
+
+  /* Stable counting sorts, first by socket and then by node, leave the ranks sorted within each socket */
+  for (i=0,maxSocket=0; i<size; i++) maxSocket = PetscMax(maxSocket,keys[2*i+1]);
+  ierr = PetscCalloc1(PetscMax(size,maxSocket+1)+1,&count);CHKERRQ(ierr);
+  for (i=0; i<size; i++) count[keys[2*i+1]+1]++;
+  for (s=0; s<maxSocket; s++) count[s+1] += count[s];
+  for (i=0; i<size; i++) tmp[count[keys[2*i+1]]++] = i;
+  ierr = PetscMemzero(count,(size+1)*sizeof(PetscMPIInt));CHKERRQ(ierr);
+  for (i=0; i<size; i++) count[keys[2*i]+1]++;
+  for (n=0; n<size; n++) count[n+1] += count[n];
+  for (i=0; i<size; i++) order[count[keys[2*tmp[i]]]++] = tmp[i];
+
+  *numNodes   = 0;
+  *numSockets = 0;
+  for (i=0; i<size; i++) {
+    if (!i || keys[2*order[i]] != keys[2*order[i-1]]) {
+      ++(*numNodes); ++(*numSockets);
+    } else if (keys[2*order[i]+1] != keys[2*order[i-1]+1]) ++(*numSockets);
+  }
+  ierr = PetscMalloc1(*numNodes+1,nodeOffsets);CHKERRQ(ierr);
+  ierr = PetscMalloc1(*numSockets+1,socketOffsets);CHKERRQ(ierr);
+  for (i=0,n=0,s=0; i<size; i++) {
+    if (!i || keys[2*order[i]] != keys[2*order[i-1]]) {
+      (*nodeOffsets)[n++] = i; (*socketOffsets)[s++] = i;
+    } else if (keys[2*order[i]+1] != keys[2*order[i-1]+1]) (*socketOffsets)[s++] = i;
+  }
+  (*nodeOffsets)[n]   = size;
+  (*socketOffsets)[s] = size;
+  ierr = PetscMalloc1(size,ranks);CHKERRQ(ierr);
+  ierr = PetscMemcpy(*ranks,order,size*sizeof(PetscMPIInt));CHKERRQ(ierr);
+  ierr = PetscFree3(keys,order,tmp);CHKERRQ(ierr);
+  ierr = PetscFree(count);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
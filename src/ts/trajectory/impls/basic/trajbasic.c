@@ -1,6 +1,41 @@
 
 #include <petsc/private/tsimpl.h>        /*I "petscts.h"  I*/
 
+#if defined(PETSC_HAVE_MPIIO)
+/*
+   With -tstrajectory_basic_async the state and stages of a step are copied into a staging buffer and written with
+   nonblocking MPI-IO, so the forward integration continues while the previous step is still going to disk. Two
+   staging buffers are used: a buffer is only reused (and its file closed) once the step written two steps earlier
+   has completed. During the adjoint sweep the same buffers are used to prefetch the step preceding the one that
+   has just been loaded.
+
+   The files have exactly the layout produced by the blocking code path (PETSc binary format, big-endian) so either
+   code path can read them back.
+*/
+typedef enum {TSTRAJ_BUFFER_EMPTY,TSTRAJ_BUFFER_WRITING,TSTRAJ_BUFFER_READING} TSTrajectoryBufferState;
+
+typedef struct {
+  TSTrajectoryBufferState state;
+  PetscInt                step;    /* step number stored in or being transferred to this buffer */
+  MPI_File                fh;
+  MPI_Request             *req;    /* one request per vector block, plus headers and times on the first process */
+  PetscScalar             *array;  /* local parts of the solution and the stages, in file byte order */
+  PetscInt                *head;   /* vector headers, in file byte order */
+  PetscReal               time[2]; /* time and previous time, in file byte order */
+} TSTrajectoryBuffer;
+#endif
+
+typedef struct {
+  PetscBool          async;
+#if defined(PETSC_HAVE_MPIIO)
+  PetscInt           nvec;      /* number of vectors stored per step: the solution plus the stages */
+  PetscInt           n;         /* local length of each vector */
+  PetscInt           nreq;
+  TSTrajectoryBuffer buffer[2];
+  PetscInt           current;   /* buffer that was used last */
+#endif
+} TSTrajectory_Basic;
+
 #undef __FUNCT__
 #define __FUNCT__ "OutputBIN"
 static PetscErrorCode OutputBIN(const char *filename, PetscViewer *viewer)
@@ -16,10 +51,241 @@ static PetscErrorCode OutputBIN(const char *filename, PetscViewer *viewer)
 }
 
 
+#if defined(PETSC_HAVE_MPIIO)
+#undef __FUNCT__
+#define __FUNCT__ "TSTrajectoryBufferWait_Basic"
+/* Completes the transfer pending on a staging buffer and closes its file */
+static PetscErrorCode TSTrajectoryBufferWait_Basic(TSTrajectory tj,TSTrajectoryBuffer *buf)
+{
+  TSTrajectory_Basic *basic = (TSTrajectory_Basic*)tj->data;
+  PetscMPIInt        nreq;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  if (buf->state == TSTRAJ_BUFFER_EMPTY) PetscFunctionReturn(0);
+  ierr = PetscMPIIntCast(basic->nreq,&nreq);CHKERRQ(ierr);
+  ierr = MPI_Waitall(nreq,buf->req,MPI_STATUSES_IGNORE);CHKERRQ(ierr);
+  ierr = MPI_File_close(&buf->fh);CHKERRQ(ierr);
+  buf->state = TSTRAJ_BUFFER_EMPTY;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "TSTrajectoryFlush_Basic"
+static PetscErrorCode TSTrajectoryFlush_Basic(TSTrajectory tj)
+{
+  TSTrajectory_Basic *basic = (TSTrajectory_Basic*)tj->data;
+  PetscInt           i;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  for (i=0; i<2; i++) {
+    ierr = TSTrajectoryBufferWait_Basic(tj,&basic->buffer[i]);CHKERRQ(ierr);
+    basic->buffer[i].step = -1;
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "TSTrajectorySetUpBuffers_Basic"
+/* Sizes the staging buffers for the stages and the local size of X, the pending transfers are completed if they change */
+static PetscErrorCode TSTrajectorySetUpBuffers_Basic(TSTrajectory tj,TS ts,Vec X)
+{
+  TSTrajectory_Basic *basic = (TSTrajectory_Basic*)tj->data;
+  PetscInt           ns,n,i,j;
+  PetscBool          changed,tchanged;
+  Vec                *Y;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr    = TSGetStages(ts,&ns,&Y);CHKERRQ(ierr);
+  ierr    = VecGetLocalSize(X,&n);CHKERRQ(ierr);
+  changed = (PetscBool)(basic->nvec != ns+1 || basic->n != n);
+  /* closing the files is collective, so every process reallocates if any has to */
+  ierr    = MPI_Allreduce(&changed,&tchanged,1,MPIU_BOOL,MPI_LOR,PetscObjectComm((PetscObject)X));CHKERRQ(ierr);
+  if (!tchanged) PetscFunctionReturn(0);
+  if (basic->nvec) {
+    ierr = TSTrajectoryFlush_Basic(tj);CHKERRQ(ierr);
+    for (i=0; i<2; i++) {
+      ierr = PetscFree3(basic->buffer[i].req,basic->buffer[i].array,basic->buffer[i].head);CHKERRQ(ierr);
+    }
+  }
+  basic->n    = n;
+  basic->nvec = ns+1;
+  basic->nreq = 2*basic->nvec+2;
+  for (i=0; i<2; i++) {
+    TSTrajectoryBuffer *buf = &basic->buffer[i];
+
+    ierr = PetscMalloc3(basic->nreq,&buf->req,basic->nvec*basic->n,&buf->array,2*basic->nvec,&buf->head);CHKERRQ(ierr);
+    for (j=0; j<basic->nreq; j++) buf->req[j] = MPI_REQUEST_NULL;
+    buf->state = TSTRAJ_BUFFER_EMPTY;
+    buf->step  = -1;
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "TSTrajectoryBufferPost_Basic"
+/*
+   Opens the file of a step and posts the nonblocking transfers between it and the staging buffer. Each process
+   moves its own part of every vector; the vector headers are written by the first process only, while the two
+   times are read by every process so that no broadcast is needed.
+
+   File layout (identical to the one written through PetscViewerBinary):
+     [header X] [X] [time] [header Y_0] [Y_0] ... [header Y_{ns-1}] [Y_{ns-1}] [previous time]
+*/
+static PetscErrorCode TSTrajectoryBufferPost_Basic(TSTrajectory tj,Vec X,TSTrajectoryBuffer *buf,PetscInt step,PetscBool write)
+{
+  TSTrajectory_Basic *basic = (TSTrajectory_Basic*)tj->data;
+  MPI_Comm           comm   = PetscObjectComm((PetscObject)X);
+  char               filename[PETSC_MAX_PATH_LEN];
+  PetscInt           N,rstart,j;
+  PetscMPIInt        rank,n;
+  MPI_Offset         hsize,bsize,off;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
+  ierr = VecGetSize(X,&N);CHKERRQ(ierr);
+  ierr = VecGetOwnershipRange(X,&rstart,NULL);CHKERRQ(ierr);
+  ierr = PetscMPIIntCast(basic->n,&n);CHKERRQ(ierr);
+  ierr = PetscSNPrintf(filename,sizeof(filename),"SA-data/SA-%06d.bin",step);CHKERRQ(ierr);
+  if (write) {
+    ierr = MPI_File_open(comm,filename,MPI_MODE_WRONLY | MPI_MODE_CREATE,MPI_INFO_NULL,&buf->fh);CHKERRQ(ierr);
+    /* truncate the longer file an earlier run may have left, as the blocking code path does */
+    ierr = MPI_File_set_size(buf->fh,0);CHKERRQ(ierr);
+  } else {
+    ierr = MPI_File_open(comm,filename,MPI_MODE_RDONLY,MPI_INFO_NULL,&buf->fh);CHKERRQ(ierr);
+  }
+  hsize = 2*(MPI_Offset)sizeof(PetscInt);
+  bsize = hsize + (MPI_Offset)N*sizeof(PetscScalar);
+  for (j=0; j<basic->nvec; j++) {
+    off = j ? (MPI_Offset)sizeof(PetscReal) + j*bsize : 0;
+    if (write) {
+      if (!rank) {ierr = MPI_File_iwrite_at(buf->fh,off,buf->head+2*j,2,MPIU_INT,&buf->req[basic->nvec+j]);CHKERRQ(ierr);}
+      ierr = MPI_File_iwrite_at(buf->fh,off+hsize+rstart*(MPI_Offset)sizeof(PetscScalar),buf->array+j*basic->n,n,MPIU_SCALAR,&buf->req[j]);CHKERRQ(ierr);
+    } else {
+      ierr = MPI_File_iread_at(buf->fh,off+hsize+rstart*(MPI_Offset)sizeof(PetscScalar),buf->array+j*basic->n,n,MPIU_SCALAR,&buf->req[j]);CHKERRQ(ierr);
+    }
+  }
+  if (write) {
+    if (!rank) {
+      ierr = MPI_File_iwrite_at(buf->fh,bsize,&buf->time[0],1,MPIU_REAL,&buf->req[2*basic->nvec]);CHKERRQ(ierr);
+      ierr = MPI_File_iwrite_at(buf->fh,(MPI_Offset)sizeof(PetscReal)+basic->nvec*bsize,&buf->time[1],1,MPIU_REAL,&buf->req[2*basic->nvec+1]);CHKERRQ(ierr);
+    }
+  } else {
+    ierr = MPI_File_iread_at(buf->fh,bsize,&buf->time[0],1,MPIU_REAL,&buf->req[2*basic->nvec]);CHKERRQ(ierr);
+    ierr = MPI_File_iread_at(buf->fh,(MPI_Offset)sizeof(PetscReal)+basic->nvec*bsize,&buf->time[1],1,MPIU_REAL,&buf->req[2*basic->nvec+1]);CHKERRQ(ierr);
+  }
+  buf->state = write ? TSTRAJ_BUFFER_WRITING : TSTRAJ_BUFFER_READING;
+  buf->step  = step;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "TSTrajectorySetAsync_Basic"
+static PetscErrorCode TSTrajectorySetAsync_Basic(TSTrajectory tj,TS ts,PetscInt stepnum,PetscReal time,Vec X)
+{
+  TSTrajectory_Basic *basic = (TSTrajectory_Basic*)tj->data;
+  TSTrajectoryBuffer *buf;
+  PetscInt           ns,i,N;
+  Vec                *Y;
+  const PetscScalar  *x;
+  PetscMPIInt        rank;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = TSTrajectorySetUpBuffers_Basic(tj,ts,X);CHKERRQ(ierr);
+  basic->current = (basic->current+1)%2;
+  buf            = &basic->buffer[basic->current];
+  /* the write issued two steps ago from this buffer must be complete before the buffer is refilled */
+  ierr = TSTrajectoryBufferWait_Basic(tj,buf);CHKERRQ(ierr);
+
+  ierr = VecGetArrayRead(X,&x);CHKERRQ(ierr);
+  ierr = PetscMemcpy(buf->array,x,basic->n*sizeof(PetscScalar));CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(X,&x);CHKERRQ(ierr);
+  ierr = TSGetStages(ts,&ns,&Y);CHKERRQ(ierr);
+  for (i=0; i<ns; i++) {
+    ierr = VecGetArrayRead(Y[i],&x);CHKERRQ(ierr);
+    ierr = PetscMemcpy(buf->array+(i+1)*basic->n,x,basic->n*sizeof(PetscScalar));CHKERRQ(ierr);
+    ierr = VecRestoreArrayRead(Y[i],&x);CHKERRQ(ierr);
+  }
+  buf->time[0] = time;
+  ierr = TSGetPrevTime(ts,&buf->time[1]);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(PetscObjectComm((PetscObject)X),&rank);CHKERRQ(ierr);
+  if (!rank) {
+    ierr = VecGetSize(X,&N);CHKERRQ(ierr);
+    for (i=0; i<basic->nvec; i++) {
+      buf->head[2*i]   = VEC_FILE_CLASSID;
+      buf->head[2*i+1] = N;
+    }
+  }
+#if !defined(PETSC_WORDS_BIGENDIAN)
+  ierr = PetscByteSwap(buf->array,PETSC_SCALAR,basic->nvec*basic->n);CHKERRQ(ierr);
+  ierr = PetscByteSwap(buf->head,PETSC_INT,2*basic->nvec);CHKERRQ(ierr);
+  ierr = PetscByteSwap(buf->time,PETSC_REAL,2);CHKERRQ(ierr);
+#endif
+  ierr = TSTrajectoryBufferPost_Basic(tj,X,buf,stepnum,PETSC_TRUE);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "TSTrajectoryGetAsync_Basic"
+static PetscErrorCode TSTrajectoryGetAsync_Basic(TSTrajectory tj,TS ts,PetscInt step,PetscReal *t)
+{
+  TSTrajectory_Basic *basic = (TSTrajectory_Basic*)tj->data;
+  TSTrajectoryBuffer *buf,*next;
+  PetscInt           ns,i;
+  Vec                Sol,*Y;
+  PetscScalar        *x;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = TSGetSolution(ts,&Sol);CHKERRQ(ierr);
+  ierr = TSTrajectorySetUpBuffers_Basic(tj,ts,Sol);CHKERRQ(ierr);
+  for (i=0; i<2; i++) {
+    if (basic->buffer[i].state == TSTRAJ_BUFFER_WRITING) {ierr = TSTrajectoryFlush_Basic(tj);CHKERRQ(ierr);}
+  }
+  if (basic->buffer[0].state == TSTRAJ_BUFFER_READING && basic->buffer[0].step == step) basic->current = 0;
+  else if (basic->buffer[1].state == TSTRAJ_BUFFER_READING && basic->buffer[1].step == step) basic->current = 1;
+  else {
+    /* not prefetched, for example the first step of the adjoint sweep */
+    ierr = TSTrajectoryBufferWait_Basic(tj,&basic->buffer[basic->current]);CHKERRQ(ierr);
+    ierr = TSTrajectoryBufferPost_Basic(tj,Sol,&basic->buffer[basic->current],step,PETSC_FALSE);CHKERRQ(ierr);
+  }
+  buf  = &basic->buffer[basic->current];
+  next = &basic->buffer[(basic->current+1)%2];
+  ierr = TSTrajectoryBufferWait_Basic(tj,buf);CHKERRQ(ierr);
+
+  /* read ahead the step the adjoint sweep needs next while this one is being used */
+  ierr = TSTrajectoryBufferWait_Basic(tj,next);CHKERRQ(ierr);
+  if (step > 1) {ierr = TSTrajectoryBufferPost_Basic(tj,Sol,next,step-1,PETSC_FALSE);CHKERRQ(ierr);}
+
+#if !defined(PETSC_WORDS_BIGENDIAN)
+  ierr = PetscByteSwap(buf->array,PETSC_SCALAR,basic->nvec*basic->n);CHKERRQ(ierr);
+  ierr = PetscByteSwap(buf->time,PETSC_REAL,2);CHKERRQ(ierr);
+#endif
+  ierr = VecGetArray(Sol,&x);CHKERRQ(ierr);
+  ierr = PetscMemcpy(x,buf->array,basic->n*sizeof(PetscScalar));CHKERRQ(ierr);
+  ierr = VecRestoreArray(Sol,&x);CHKERRQ(ierr);
+  ierr = TSGetStages(ts,&ns,&Y);CHKERRQ(ierr);
+  for (i=0; i<ns; i++) {
+    ierr = VecGetArray(Y[i],&x);CHKERRQ(ierr);
+    ierr = PetscMemcpy(x,buf->array+(i+1)*basic->n,basic->n*sizeof(PetscScalar));CHKERRQ(ierr);
+    ierr = VecRestoreArray(Y[i],&x);CHKERRQ(ierr);
+  }
+  *t   = buf->time[0];
+  ierr = TSSetTimeStep(ts,-(*t)+buf->time[1]);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+#endif
+
+
 #undef __FUNCT__
 #define __FUNCT__ "TSTrajectorySet_Basic"
 PetscErrorCode TSTrajectorySet_Basic(TSTrajectory jac,TS ts,PetscInt stepnum,PetscReal time,Vec X)
 {
+  TSTrajectory_Basic *basic = (TSTrajectory_Basic*)jac->data;
   PetscViewer    viewer;
   PetscInt       ns,i;
   Vec            *Y;
@@ -29,6 +295,10 @@ PetscErrorCode TSTrajectorySet_Basic(TSTrajectory jac,TS ts,PetscInt stepnum,Pet
 
   PetscFunctionBeginUser;
   if (stepnum == 0) {
+#if defined(PETSC_HAVE_MPIIO)
+    /* a new forward run may overwrite files that are still being written */
+    ierr = TSTrajectoryFlush_Basic(jac);CHKERRQ(ierr);
+#endif
 #if defined(PETSC_HAVE_POPEN)
     ierr = TSGetTotalSteps(ts,&stepnum);CHKERRQ(ierr);
     if (stepnum == 0) {
@@ -52,6 +322,12 @@ PetscErrorCode TSTrajectorySet_Basic(TSTrajectory jac,TS ts,PetscInt stepnum,Pet
     PetscFunctionReturn(0);
   }
   ierr = TSGetTotalSteps(ts,&stepnum);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_MPIIO)
+  if (basic->async) {
+    ierr = TSTrajectorySetAsync_Basic(jac,ts,stepnum,time,X);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
   ierr = PetscSNPrintf(filename,sizeof(filename),"SA-data/SA-%06d.bin",stepnum);CHKERRQ(ierr);
   ierr = OutputBIN(filename,&viewer);CHKERRQ(ierr);
   ierr = VecView(X,viewer);CHKERRQ(ierr);
@@ -73,6 +349,7 @@ PetscErrorCode TSTrajectorySet_Basic(TSTrajectory jac,TS ts,PetscInt stepnum,Pet
 #define __FUNCT__ "TSTrajectoryGet_Basic"
 PetscErrorCode TSTrajectoryGet_Basic(TSTrajectory jac,TS ts,PetscInt step,PetscReal *t)
 {
+  TSTrajectory_Basic *basic = (TSTrajectory_Basic*)jac->data;
   Vec            Sol,*Y;
   PetscInt       Nr,i;
   PetscViewer    viewer;
@@ -82,6 +359,12 @@ PetscErrorCode TSTrajectoryGet_Basic(TSTrajectory jac,TS ts,PetscInt step,PetscR
 
   PetscFunctionBeginUser;
   ierr = TSGetTotalSteps(ts,&step);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_MPIIO)
+  if (basic->async) {
+    ierr = TSTrajectoryGetAsync_Basic(jac,ts,step,t);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
   ierr = PetscSNPrintf(filename,sizeof filename,"SA-data/SA-%06d.bin",step);CHKERRQ(ierr);
   ierr = PetscViewerBinaryOpen(PETSC_COMM_WORLD,filename,FILE_MODE_READ,&viewer);CHKERRQ(ierr);
 
@@ -105,9 +388,67 @@ PetscErrorCode TSTrajectoryGet_Basic(TSTrajectory jac,TS ts,PetscInt step,PetscR
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "TSTrajectorySetFromOptions_Basic"
+static PetscErrorCode TSTrajectorySetFromOptions_Basic(PetscOptions *PetscOptionsObject,TSTrajectory tj)
+{
+  TSTrajectory_Basic *basic = (TSTrajectory_Basic*)tj->data;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject,"Basic trajectory options");CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-tstrajectory_basic_async","Write and prefetch the checkpoint files with nonblocking MPI-IO","",basic->async,&basic->async,NULL);CHKERRQ(ierr);
+#if !defined(PETSC_HAVE_MPIIO)
+  if (basic->async) SETERRQ(PetscObjectComm((PetscObject)tj),PETSC_ERR_SUP_SYS,"Asynchronous trajectory storage requires MPI-IO");
+#elif defined(PETSC_USE_REAL___FLOAT128)
+  if (basic->async) SETERRQ(PetscObjectComm((PetscObject)tj),PETSC_ERR_SUP,"Asynchronous trajectory storage not available for __float128");
+#endif
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "TSTrajectoryView_Basic"
+static PetscErrorCode TSTrajectoryView_Basic(TSTrajectory tj,PetscViewer viewer)
+{
+  TSTrajectory_Basic *basic = (TSTrajectory_Basic*)tj->data;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  if (basic->async) {ierr = PetscViewerASCIIPrintf(viewer,"  Asynchronous (double-buffered MPI-IO) writes\n");CHKERRQ(ierr);}
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "TSTrajectoryDestroy_Basic"
+static PetscErrorCode TSTrajectoryDestroy_Basic(TSTrajectory tj)
+{
+#if defined(PETSC_HAVE_MPIIO)
+  TSTrajectory_Basic *basic = (TSTrajectory_Basic*)tj->data;
+  PetscInt           i;
+#endif
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_MPIIO)
+  ierr = TSTrajectoryFlush_Basic(tj);CHKERRQ(ierr);
+  for (i=0; i<2; i++) {
+    ierr = PetscFree3(basic->buffer[i].req,basic->buffer[i].array,basic->buffer[i].head);CHKERRQ(ierr);
+  }
+#endif
+  ierr = PetscFree(tj->data);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*MC
       TSTRAJECTORYBASIC - Stores each solution of the ODE/ADE in a file
 
+  Options Database Keys:
+.  -tstrajectory_basic_async - copy each step into a staging buffer and write it with nonblocking MPI-IO; during the
+      adjoint sweep the preceding step is read ahead in the same way
+
+  Notes: The files are stored in the directory SA-data, one file per time step.
+
   Level: intermediate
 
 .seealso:  TSTrajectoryCreate(), TS, TSTrajectorySetType()
@@ -117,8 +458,16 @@ M*/
 #define __FUNCT__ "TSTrajectoryCreate_Basic"
 PETSC_EXTERN PetscErrorCode TSTrajectoryCreate_Basic(TSTrajectory ts)
 {
+  TSTrajectory_Basic *basic;
+  PetscErrorCode     ierr;
+
   PetscFunctionBegin;
-  ts->ops->set  = TSTrajectorySet_Basic;
-  ts->ops->get  = TSTrajectoryGet_Basic;
+  ierr = PetscNew(&basic);CHKERRQ(ierr);
+  ts->data                = basic;
+  ts->ops->set            = TSTrajectorySet_Basic;
+  ts->ops->get            = TSTrajectoryGet_Basic;
+  ts->ops->setfromoptions = TSTrajectorySetFromOptions_Basic;
+  ts->ops->view           = TSTrajectoryView_Basic;
+  ts->ops->destroy        = TSTrajectoryDestroy_Basic;
   PetscFunctionReturn(0);
 }
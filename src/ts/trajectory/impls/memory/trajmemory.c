@@ -0,0 +1,339 @@
+
+#include <petsc/private/tsimpl.h>        /*I "petscts.h"  I*/
+
+/*
+   Binomial (Revolve) checkpointing, see
+
+     A. Griewank and A. Walther, Algorithm 799: Revolve: An implementation of checkpointing for the reverse or
+     adjoint mode of computational differentiation, ACM Trans. Math. Softw. 26 (2000).
+
+   Only the solution is checkpointed. The checkpoints form a stack ordered by step number; the bottom of the stack
+   is always the initial condition. TSTrajectoryGet() for step k restores the newest checkpoint before k and
+   recomputes forward to k with TSStep(), which leaves both the solution and the stages of step k in the TS. While
+   recomputing, new checkpoints are placed at the binomially optimal positions for the free slots.
+
+   The first max_cps_disk slots of the stack live on disk, the remaining max_cps_ram in memory, so the coarse
+   checkpoints taken early in the forward sweep (which are restored least often) are the ones written to disk.
+*/
+typedef struct {
+  PetscInt step;    /* step (relative to the start of the forward sweep) whose solution is stored */
+} TSTrajectoryCheckpoint;
+
+typedef struct {
+  PetscInt               max_cps_ram,max_cps_disk;
+  PetscInt               nstack;       /* number of checkpoints currently stored */
+  TSTrajectoryCheckpoint *stack;
+  Vec                    *X;           /* memory slots, allocated on first use */
+  PetscInt               base;         /* total number of steps of the TS when the forward sweep started */
+  PetscInt               nsteps;       /* number of steps taken in the forward sweep */
+  PetscInt               next;         /* next step of the forward sweep to checkpoint, or -1 */
+  PetscReal              *times;       /* time at every step, the time steps must be reproduced exactly */
+  PetscInt               maxtimes;
+  PetscInt               nrecompute;   /* number of steps recomputed during the adjoint sweep */
+  PetscBool              diskdir;      /* directory for the disk checkpoints has been created */
+} TSTrajectory_Memory;
+
+#undef __FUNCT__
+#define __FUNCT__ "TSTrajectoryMemoryNextCheckpoint"
+/*
+   Given s stored states available (including the one at the start of the interval) for reversing m steps, returns
+   the offset of the next checkpoint from the start of the interval, or 0 if no further checkpoint is useful.
+
+   With t the smallest repetition number such that beta(s,t) = binomial(s+t,s) >= m, the interval is split so that
+   the right part can be reversed with s-1 states and t repetitions and the left part with s states and t-1
+   repetitions, using beta(s,t) = beta(s,t-1) + beta(s-1,t).
+*/
+static PetscErrorCode TSTrajectoryMemoryNextCheckpoint(PetscInt s,PetscInt m,PetscInt *offset)
+{
+  PetscReal beta = 1.0,beta1;
+  PetscInt  t = 0,j;
+
+  PetscFunctionBegin;
+  *offset = 0;
+  if (s < 2 || m < 3) PetscFunctionReturn(0);
+  while (beta < (PetscReal)m) {
+    t++;
+    beta = beta*(s+t)/t;
+  }
+  beta1 = beta*s/(s+t);
+  j     = (PetscInt)PetscMax(1.0,(PetscReal)m - beta1);
+  /* a checkpoint at the last state of the interval is only used by the step being reversed */
+  if (j <= m-2) *offset = j;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "TSTrajectoryMemoryFileName"
+static PetscErrorCode TSTrajectoryMemoryFileName(PetscInt slot,char *filename,size_t len)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscSNPrintf(filename,len,"SA-data/SA-checkpoint-%06D.bin",slot);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "TSTrajectoryMemoryPush"
+/* Stores the solution as the newest checkpoint */
+static PetscErrorCode TSTrajectoryMemoryPush(TSTrajectory tj,PetscInt step,Vec X)
+{
+  TSTrajectory_Memory *mem = (TSTrajectory_Memory*)tj->data;
+  PetscInt            slot = mem->nstack;
+  PetscErrorCode      ierr;
+
+  PetscFunctionBegin;
+  if (slot >= mem->max_cps_ram+mem->max_cps_disk) SETERRQ(PetscObjectComm((PetscObject)tj),PETSC_ERR_PLIB,"No free checkpoint slot");
+  if (slot < mem->max_cps_disk) {
+    PetscViewer viewer;
+    char        filename[PETSC_MAX_PATH_LEN];
+
+    if (!mem->diskdir) {
+#if defined(PETSC_HAVE_POPEN)
+      PetscMPIInt rank;
+
+      ierr = MPI_Comm_rank(PetscObjectComm((PetscObject)X),&rank);CHKERRQ(ierr);
+      if (!rank) {
+        FILE *fd;
+        int  err;
+
+        ierr = PetscPOpen(PETSC_COMM_SELF,NULL,"mkdir -p SA-data","r",&fd);CHKERRQ(ierr);
+        ierr = PetscPClose(PETSC_COMM_SELF,fd,&err);CHKERRQ(ierr);
+      }
+      ierr = MPI_Barrier(PetscObjectComm((PetscObject)X));CHKERRQ(ierr);
+#endif
+      mem->diskdir = PETSC_TRUE;
+    }
+    ierr = TSTrajectoryMemoryFileName(slot,filename,sizeof(filename));CHKERRQ(ierr);
+    ierr = PetscViewerBinaryOpen(PetscObjectComm((PetscObject)X),filename,FILE_MODE_WRITE,&viewer);CHKERRQ(ierr);
+    ierr = PetscViewerBinarySetSkipInfo(viewer,PETSC_TRUE);CHKERRQ(ierr);
+    ierr = VecView(X,viewer);CHKERRQ(ierr);
+    ierr = PetscViewerDestroy(&viewer);CHKERRQ(ierr);
+  } else {
+    if (!mem->X[slot-mem->max_cps_disk]) {ierr = VecDuplicate(X,&mem->X[slot-mem->max_cps_disk]);CHKERRQ(ierr);}
+    ierr = VecCopy(X,mem->X[slot-mem->max_cps_disk]);CHKERRQ(ierr);
+  }
+  mem->stack[slot].step = step;
+  mem->nstack++;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "TSTrajectoryMemoryRestore"
+/* Copies the newest checkpoint into X */
+static PetscErrorCode TSTrajectoryMemoryRestore(TSTrajectory tj,Vec X)
+{
+  TSTrajectory_Memory *mem = (TSTrajectory_Memory*)tj->data;
+  PetscInt            slot = mem->nstack-1;
+  PetscErrorCode      ierr;
+
+  PetscFunctionBegin;
+  if (slot < mem->max_cps_disk) {
+    PetscViewer viewer;
+    char        filename[PETSC_MAX_PATH_LEN];
+
+    ierr = TSTrajectoryMemoryFileName(slot,filename,sizeof(filename));CHKERRQ(ierr);
+    ierr = PetscViewerBinaryOpen(PetscObjectComm((PetscObject)X),filename,FILE_MODE_READ,&viewer);CHKERRQ(ierr);
+    ierr = VecLoad(X,viewer);CHKERRQ(ierr);
+    ierr = PetscViewerDestroy(&viewer);CHKERRQ(ierr);
+  } else {
+    ierr = VecCopy(mem->X[slot-mem->max_cps_disk],X);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "TSTrajectorySet_Memory"
+static PetscErrorCode TSTrajectorySet_Memory(TSTrajectory tj,TS ts,PetscInt stepnum,PetscReal time,Vec X)
+{
+  TSTrajectory_Memory *mem = (TSTrajectory_Memory*)tj->data;
+  PetscInt            step,offset,max_steps;
+  PetscErrorCode      ierr;
+
+  PetscFunctionBegin;
+  ierr = TSGetTotalSteps(ts,&step);CHKERRQ(ierr);
+  if (stepnum == 0) {
+    mem->base       = step;
+    mem->nstack     = 0;
+    mem->nsteps     = 0;
+    mem->nrecompute = 0;
+  }
+  step -= mem->base;
+  if (step >= mem->maxtimes) {
+    PetscReal *times;
+
+    mem->maxtimes = PetscMax(2*mem->maxtimes,step+128);
+    ierr = PetscMalloc1(mem->maxtimes,&times);CHKERRQ(ierr);
+    if (mem->times) {ierr = PetscMemcpy(times,mem->times,(mem->nsteps+1)*sizeof(PetscReal));CHKERRQ(ierr);}
+    ierr = PetscFree(mem->times);CHKERRQ(ierr);
+    mem->times = times;
+  }
+  mem->times[step] = time;
+  mem->nsteps      = step;
+  if (stepnum == 0 || step == mem->next) {
+    ierr = TSTrajectoryMemoryPush(tj,step,X);CHKERRQ(ierr);
+    /* the schedule is planned for the maximum number of steps, the sweep may end earlier */
+    ierr      = TSGetDuration(ts,&max_steps,NULL);CHKERRQ(ierr);
+    ierr      = TSTrajectoryMemoryNextCheckpoint(mem->max_cps_ram+mem->max_cps_disk-mem->nstack+1,max_steps-step,&offset);CHKERRQ(ierr);
+    mem->next = offset ? step+offset : -1;
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "TSTrajectoryGet_Memory"
+static PetscErrorCode TSTrajectoryGet_Memory(TSTrajectory tj,TS ts,PetscInt stepnum,PetscReal *t)
+{
+  TSTrajectory_Memory *mem = (TSTrajectory_Memory*)tj->data;
+  Vec                 Sol,costintegral;
+  PetscInt            step,i,c,offset,target,steps,total_steps;
+  PetscReal           ptime_prev,time_step_prev;
+  PetscBool           costintegralfwd;
+  TSConvergedReason   reason;
+  PetscErrorCode      ierr;
+
+  PetscFunctionBegin;
+  ierr = TSGetTotalSteps(ts,&step);CHKERRQ(ierr);
+  step -= mem->base;
+  if (step < 1 || step > mem->nsteps) SETERRQ2(PetscObjectComm((PetscObject)tj),PETSC_ERR_ARG_OUTOFRANGE,"Step %D not in the stored trajectory of %D steps",step,mem->nsteps);
+  /* checkpoints at or after this step are of no further use for the adjoint sweep */
+  while (mem->nstack > 1 && mem->stack[mem->nstack-1].step >= step) mem->nstack--;
+  c    = mem->stack[mem->nstack-1].step;
+  ierr = TSGetSolution(ts,&Sol);CHKERRQ(ierr);
+  ierr = TSTrajectoryMemoryRestore(tj,Sol);CHKERRQ(ierr);
+
+  /* recompute the forward steps without disturbing the state of the adjoint integration */
+  steps           = ts->steps;
+  total_steps     = ts->total_steps;
+  reason          = ts->reason;
+  ptime_prev      = ts->ptime_prev;
+  time_step_prev  = ts->time_step_prev;
+  costintegral    = ts->vec_costintegral;
+  costintegralfwd = ts->costintegralfwd;
+  ts->vec_costintegral = NULL;
+  ts->costintegralfwd  = PETSC_FALSE;
+  ierr = PetscInfo2(tj,"Recomputing from the checkpoint at step %D to step %D\n",c,step);CHKERRQ(ierr);
+  while (c < step) {
+    ierr   = TSTrajectoryMemoryNextCheckpoint(mem->max_cps_ram+mem->max_cps_disk-mem->nstack+1,step-c,&offset);CHKERRQ(ierr);
+    target = offset ? c+offset : step;
+    for (i=c; i<target; i++) {
+      ts->ptime     = mem->times[i];
+      ts->time_step = mem->times[i+1]-mem->times[i];
+      ts->steps     = i;
+      ierr = TSStep(ts);CHKERRQ(ierr);
+      if (ts->reason < 0) SETERRQ2(PetscObjectComm((PetscObject)tj),PETSC_ERR_NOT_CONVERGED,"Recomputation of step %D failed due to %s",i+1,TSConvergedReasons[ts->reason]);
+      if (PetscAbsReal(ts->ptime-mem->times[i+1]) > 100*PETSC_MACHINE_EPSILON*PetscMax(1.0,PetscAbsReal(mem->times[i+1]))) SETERRQ1(PetscObjectComm((PetscObject)tj),PETSC_ERR_PLIB,"Recomputation of step %D did not reproduce the time step of the forward sweep",i+1);
+      mem->nrecompute++;
+    }
+    if (offset) {ierr = TSTrajectoryMemoryPush(tj,target,Sol);CHKERRQ(ierr);}
+    c = target;
+  }
+  ts->steps            = steps;
+  ts->total_steps      = total_steps;
+  ts->reason           = reason;
+  ts->ptime_prev       = ptime_prev;
+  ts->time_step_prev   = time_step_prev;
+  ts->vec_costintegral = costintegral;
+  ts->costintegralfwd  = costintegralfwd;
+
+  *t   = mem->times[step];
+  ierr = TSSetTimeStep(ts,mem->times[step-1]-mem->times[step]);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "TSTrajectorySetFromOptions_Memory"
+static PetscErrorCode TSTrajectorySetFromOptions_Memory(PetscOptions *PetscOptionsObject,TSTrajectory tj)
+{
+  TSTrajectory_Memory *mem = (TSTrajectory_Memory*)tj->data;
+  PetscInt            max_cps_ram = mem->max_cps_ram,max_cps_disk = mem->max_cps_disk;
+  PetscErrorCode      ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject,"Memory (binomial checkpointing) trajectory options");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-tstrajectory_max_cps_ram","Maximum number of checkpoints kept in memory","",max_cps_ram,&max_cps_ram,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-tstrajectory_max_cps_disk","Maximum number of checkpoints written to disk","",max_cps_disk,&max_cps_disk,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+  if (max_cps_ram < 0 || max_cps_disk < 0) SETERRQ(PetscObjectComm((PetscObject)tj),PETSC_ERR_ARG_OUTOFRANGE,"Number of checkpoints cannot be negative");
+  if (max_cps_ram+max_cps_disk < 1) SETERRQ(PetscObjectComm((PetscObject)tj),PETSC_ERR_ARG_OUTOFRANGE,"At least one checkpoint is needed for the initial condition");
+  if (max_cps_ram != mem->max_cps_ram || max_cps_disk != mem->max_cps_disk) {
+    PetscInt i;
+
+    if (mem->nstack) SETERRQ(PetscObjectComm((PetscObject)tj),PETSC_ERR_ARG_WRONGSTATE,"Cannot change the number of checkpoints while a trajectory is stored");
+    for (i=0; i<mem->max_cps_ram; i++) {ierr = VecDestroy(&mem->X[i]);CHKERRQ(ierr);}
+    ierr = PetscFree2(mem->stack,mem->X);CHKERRQ(ierr);
+    mem->max_cps_ram  = max_cps_ram;
+    mem->max_cps_disk = max_cps_disk;
+    ierr = PetscCalloc2(max_cps_ram+max_cps_disk,&mem->stack,max_cps_ram,&mem->X);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "TSTrajectoryView_Memory"
+static PetscErrorCode TSTrajectoryView_Memory(TSTrajectory tj,PetscViewer viewer)
+{
+  TSTrajectory_Memory *mem = (TSTrajectory_Memory*)tj->data;
+  PetscErrorCode      ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscViewerASCIIPrintf(viewer,"  Maximum number of checkpoints in memory %D, on disk %D\n",mem->max_cps_ram,mem->max_cps_disk);CHKERRQ(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer,"  Steps stored %D, recomputed %D\n",mem->nsteps,mem->nrecompute);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "TSTrajectoryDestroy_Memory"
+static PetscErrorCode TSTrajectoryDestroy_Memory(TSTrajectory tj)
+{
+  TSTrajectory_Memory *mem = (TSTrajectory_Memory*)tj->data;
+  PetscInt            i;
+  PetscErrorCode      ierr;
+
+  PetscFunctionBegin;
+  for (i=0; i<mem->max_cps_ram; i++) {ierr = VecDestroy(&mem->X[i]);CHKERRQ(ierr);}
+  ierr = PetscFree2(mem->stack,mem->X);CHKERRQ(ierr);
+  ierr = PetscFree(mem->times);CHKERRQ(ierr);
+  ierr = PetscFree(tj->data);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*MC
+      TSTRAJECTORYMEMORY - Stores a binomial (Revolve) selection of solutions and recomputes the others during the adjoint sweep
+
+  Options Database Keys:
++  -tstrajectory_max_cps_ram <n> - maximum number of checkpoints kept in memory (default 10)
+-  -tstrajectory_max_cps_disk <n> - maximum number of additional checkpoints written to disk in the directory SA-data (default 0)
+
+  Notes:
+  The memory needed is independent of the number of time steps. The checkpoint schedule of the forward sweep is
+  planned for the maximum number of steps set with TSSetDuration(); it is optimal when the sweep takes that many
+  steps and remains valid when it stops earlier. The recomputed steps must reproduce the time steps of the forward
+  sweep, so the time step adaptivity has to be deterministic.
+
+  Level: intermediate
+
+.seealso:  TSTrajectoryCreate(), TS, TSTrajectorySetType(), TSTRAJECTORYBASIC
+M*/
+#undef __FUNCT__
+#define __FUNCT__ "TSTrajectoryCreate_Memory"
+PETSC_EXTERN PetscErrorCode TSTrajectoryCreate_Memory(TSTrajectory tj)
+{
+  TSTrajectory_Memory *mem;
+  PetscErrorCode      ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscNew(&mem);CHKERRQ(ierr);
+  mem->max_cps_ram  = 10;
+  mem->max_cps_disk = 0;
+  mem->next         = -1;
+  ierr = PetscCalloc2(mem->max_cps_ram+mem->max_cps_disk,&mem->stack,mem->max_cps_ram,&mem->X);CHKERRQ(ierr);
+
+  tj->data                = mem;
+  tj->ops->set            = TSTrajectorySet_Memory;
+  tj->ops->get            = TSTrajectoryGet_Memory;
+  tj->ops->setfromoptions = TSTrajectorySetFromOptions_Memory;
+  tj->ops->view           = TSTrajectoryView_Memory;
+  tj->ops->destroy        = TSTrajectoryDestroy_Memory;
+  PetscFunctionReturn(0);
+}
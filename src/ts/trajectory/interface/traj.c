@@ -196,6 +196,7 @@ PetscErrorCode  TSTrajectorySetType(TSTrajectory ts,const TSTrajectoryType type)
 
 PETSC_EXTERN PetscErrorCode TSTrajectoryCreate_Basic(TSTrajectory);
 PETSC_EXTERN PetscErrorCode TSTrajectoryCreate_Singlefile(TSTrajectory);
+PETSC_EXTERN PetscErrorCode TSTrajectoryCreate_Memory(TSTrajectory);
 
 #undef __FUNCT__
 #define __FUNCT__ "TSTrajectoryRegisterAll"
@@ -218,6 +219,7 @@ PetscErrorCode  TSTrajectoryRegisterAll(void)
 
   ierr = TSTrajectoryRegister(TSTRAJECTORYBASIC,TSTrajectoryCreate_Basic);CHKERRQ(ierr);
   ierr = TSTrajectoryRegister(TSTRAJECTORYSINGLEFILE,TSTrajectoryCreate_Singlefile);CHKERRQ(ierr);  
+  ierr = TSTrajectoryRegister(TSTRAJECTORYMEMORY,TSTrajectoryCreate_Memory);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -298,13 +300,17 @@ static PetscErrorCode TSTrajectorySetTypeFromOptions_Private(PetscOptions *Petsc
 .  ts - the TSTrajectory context obtained from TSTrajectoryCreate()
 
    Options Database Keys:
-.  -tstrajectory_type <type> - TSTRAJECTORYBASIC
++  -tstrajectory_type <type> - TSTRAJECTORYBASIC
+-  -tstrajectory_basic_async - write and prefetch TSTRAJECTORYBASIC checkpoints with nonblocking MPI-IO
 
    Level: advanced
 
    Notes: This is not normally called directly by users, instead it is called by TSSetFromOptions() after a call to 
    TSSetSaveTrajectory()
 
+   The checkpoints written through binary viewers are compressed with -viewer_binary_vec_compress, see
+   PetscViewerBinarySetVecCompression(); the asynchronous checkpoints of TSTRAJECTORYBASIC are always written uncompressed.
+
 .keywords: TS, timestep, set, options, database
 
 .seealso: TSGetType(), TSSetSaveTrajectory(), TSGetTrajectory()
@@ -317,6 +323,7 @@ PetscErrorCode  TSTrajectorySetFromOptions(TSTrajectory ts)
   PetscValidHeaderSpecific(ts, TSTRAJECTORY_CLASSID,1);
   ierr = PetscObjectOptionsBegin((PetscObject)ts);CHKERRQ(ierr);
   ierr = TSTrajectorySetTypeFromOptions_Private(PetscOptionsObject,ts);CHKERRQ(ierr);
+  if (ts->ops->setfromoptions) {ierr = (*ts->ops->setfromoptions)(PetscOptionsObject,ts);CHKERRQ(ierr);}
   ierr = PetscOptionsEnd();CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -257,7 +257,8 @@ PetscErrorCode ISView_General_HDF5(IS is, PetscViewer viewer)
   PetscFunctionBegin;
   ierr = ISGetBlockSize(is,&bs);CHKERRQ(ierr);
   ierr = PetscViewerHDF5OpenGroup(viewer, &file_id, &group);CHKERRQ(ierr);
-  ierr = PetscViewerHDF5GetTimestep(viewer, &timestep);CHKERRQ(ierr);
+  ierr = PetscObjectGetName((PetscObject) is, &isname);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5GetWriteTimestep(viewer, group, isname, &timestep);CHKERRQ(ierr);
 
   /* Create the dataspace for the dataset.
    *
@@ -298,12 +299,23 @@ PetscErrorCode ISView_General_HDF5(IS is, PetscViewer viewer)
   inttype = H5T_NATIVE_INT;
 #endif
 
+  /* Each process defines a dataset and writes it to the hyperslab in the file, the sizes also determine the chunks */
+  dim = 0;
+  if (timestep >= 0) {
+    count[dim] = 1;
+    ++dim;
+  }
+  ierr = PetscHDF5IntCast(n/bs,count + dim);CHKERRQ(ierr);
+  ++dim;
+  if (bs >= 1) {
+    count[dim] = bs;
+    ++dim;
+  }
+
   /* Create the dataset with default properties and close filespace */
-  ierr = PetscObjectGetName((PetscObject) is, &isname);CHKERRQ(ierr);
   if (!H5Lexists(group, isname, H5P_DEFAULT)) {
     /* Create chunk */
-    PetscStackCallHDF5Return(chunkspace,H5Pcreate,(H5P_DATASET_CREATE));
-    PetscStackCallHDF5(H5Pset_chunk,(chunkspace, dim, chunkDims));
+    ierr = PetscViewerHDF5CreateDatasetProperties(viewer, dim, count, chunkDims, &chunkspace);CHKERRQ(ierr);
 
 #if (H5_VERS_MAJOR * 10000 + H5_VERS_MINOR * 100 + H5_VERS_RELEASE >= 10800)
     PetscStackCallHDF5Return(dset_id,H5Dcreate2,(group, isname, inttype, filespace, H5P_DEFAULT, chunkspace, H5P_DEFAULT));
@@ -317,18 +329,6 @@ PetscErrorCode ISView_General_HDF5(IS is, PetscViewer viewer)
   }
   PetscStackCallHDF5(H5Sclose,(filespace));
 
-  /* Each process defines a dataset and writes it to the hyperslab in the file */
-  dim = 0;
-  if (timestep >= 0) {
-    count[dim] = 1;
-    ++dim;
-  }
-  ierr = PetscHDF5IntCast(n/bs,count + dim);CHKERRQ(ierr);
-  ++dim;
-  if (bs >= 1) {
-    count[dim] = bs;
-    ++dim;
-  }
   if (n > 0) {
     PetscStackCallHDF5Return(memspace,H5Screate_simple,(dim, count, NULL));
   } else {
@@ -8,6 +8,23 @@
 
 PetscClassId PETSC_SECTION_CLASSID;
 
+#undef __FUNCT__
+#define __FUNCT__ "PetscSectionResetClosureDofIndex_Private"
+/* The closure dof index depends on the offsets and constraints, so it is dropped when they change */
+static PetscErrorCode PetscSectionResetClosureDofIndex_Private(PetscSection s)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree(s->clDofOff);CHKERRQ(ierr);
+  ierr = PetscFree(s->clDofs);CHKERRQ(ierr);
+  s->clDofId    = 0;
+  s->clDofState = 0;
+  s->clDofStart = 0;
+  s->clDofEnd   = 0;
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "PetscSectionCreate"
 /*@
@@ -60,6 +77,12 @@ PetscErrorCode PetscSectionCreate(MPI_Comm comm, PetscSection *s)
   (*s)->clObj              = NULL;
   (*s)->clSection          = NULL;
   (*s)->clPoints          = NULL;
+  (*s)->clDofId            = 0;
+  (*s)->clDofState         = 0;
+  (*s)->clDofStart         = 0;
+  (*s)->clDofEnd           = 0;
+  (*s)->clDofOff           = NULL;
+  (*s)->clDofs             = NULL;
   PetscFunctionReturn(0);
 }
 
@@ -840,6 +863,7 @@ PetscErrorCode PetscSectionSetUp(PetscSection s)
   PetscFunctionBegin;
   if (s->setup) PetscFunctionReturn(0);
   s->setup = PETSC_TRUE;
+  ierr = PetscSectionResetClosureDofIndex_Private(s);CHKERRQ(ierr);
   if (s->perm) {ierr = ISGetIndices(s->perm, &pind);CHKERRQ(ierr);}
   for (p = 0; p < s->pEnd - s->pStart; ++p) {
     const PetscInt q = pind ? pind[p] : p;
@@ -1230,9 +1254,12 @@ PetscErrorCode PetscSectionGetOffset(PetscSection s, PetscInt point, PetscInt *o
 @*/
 PetscErrorCode PetscSectionSetOffset(PetscSection s, PetscInt point, PetscInt offset)
 {
+  PetscErrorCode ierr;
+
   PetscFunctionBegin;
   if ((point < s->pStart) || (point >= s->pEnd)) SETERRQ3(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Section point %d should be in [%d, %d)", point, s->pStart, s->pEnd);
   s->atlasOff[point - s->pStart] = offset;
+  if (s->clDofOff) {ierr = PetscSectionResetClosureDofIndex_Private(s);CHKERRQ(ierr);}
   PetscFunctionReturn(0);
 }
 
@@ -1291,6 +1318,7 @@ PetscErrorCode PetscSectionSetFieldOffset(PetscSection s, PetscInt point, PetscI
   PetscFunctionBegin;
   if ((field < 0) || (field >= s->numFields)) SETERRQ3(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Section field %d should be in [%d, %d)", field, 0, s->numFields);
   ierr = PetscSectionSetOffset(s->field[field], point, offset);CHKERRQ(ierr);
+  if (s->clDofOff) {ierr = PetscSectionResetClosureDofIndex_Private(s);CHKERRQ(ierr);}
   PetscFunctionReturn(0);
 }
 
@@ -1603,6 +1631,7 @@ PetscErrorCode PetscSectionReset(PetscSection s)
   ierr = PetscFree2(s->atlasDof, s->atlasOff);CHKERRQ(ierr);
   ierr = PetscSectionDestroy(&s->clSection);CHKERRQ(ierr);
   ierr = ISDestroy(&s->clPoints);CHKERRQ(ierr);
+  ierr = PetscSectionResetClosureDofIndex_Private(s);CHKERRQ(ierr);
   ierr = ISDestroy(&s->perm);CHKERRQ(ierr);
 
   s->pStart    = -1;
@@ -1799,6 +1828,7 @@ PetscErrorCode PetscSectionSetConstraintIndices(PetscSection s, PetscInt point,
   if (s->bc) {
     ierr = VecIntSetValuesSection(s->bcIndices, s->bc, point, indices, INSERT_VALUES);CHKERRQ(ierr);
   }
+  if (s->clDofOff) {ierr = PetscSectionResetClosureDofIndex_Private(s);CHKERRQ(ierr);}
   PetscFunctionReturn(0);
 }
 
@@ -1823,6 +1853,7 @@ PetscErrorCode PetscSectionSetFieldConstraintIndices(PetscSection s, PetscInt po
   PetscFunctionBegin;
   if ((field < 0) || (field >= s->numFields)) SETERRQ3(PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Section field %d should be in [%d, %d)", field, 0, s->numFields);
   ierr = PetscSectionSetConstraintIndices(s->field[field], point, indices);CHKERRQ(ierr);
+  if (s->clDofOff) {ierr = PetscSectionResetClosureDofIndex_Private(s);CHKERRQ(ierr);}
   PetscFunctionReturn(0);
 }
 
@@ -2149,6 +2180,90 @@ PetscErrorCode PetscSectionGetClosureIndex(PetscSection section, PetscObject obj
   PetscFunctionReturn(0);
 }
 
+#undef __FUNCT__
+#define __FUNCT__ "PetscSectionSetClosureDofIndex"
+/*@
+  PetscSectionSetClosureDofIndex - Set a cache of the dof indices in the closure of a range of points in the section
+
+  Input Parameters:
++ section   - The PetscSection
+. obj       - A PetscObject which serves as the key for this index
+. pStart    - The first point with a closure in the index
+. pEnd      - One past the last point with a closure in the index
+. clOffsets - The offset of the closure of each point p in clDofs is clOffsets[p-pStart], and clOffsets[pEnd-pStart] is the size of clDofs
+- clDofs    - The dof indices in each closure, with orientations applied and constrained dofs stored as -(index+1)
+
+  Note: The section takes ownership of the arrays, which must be allocated with PetscMalloc(). The section holds a single
+  index, which is keyed by the id and state of obj rather than its address, so it is never returned for another object.
+  The index is dropped when the state of obj changes, or when the offsets or constraints of the section change.
+
+  Level: developer
+
+.seealso: PetscSectionGetClosureDofIndex(), PetscSectionSetClosureIndex(), DMPlexVecGetClosure()
+@*/
+PetscErrorCode PetscSectionSetClosureDofIndex(PetscSection section, PetscObject obj, PetscInt pStart, PetscInt pEnd, PetscInt clOffsets[], PetscInt clDofs[])
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(section, PETSC_SECTION_CLASSID, 1);
+  PetscValidHeader(obj, 2);
+  ierr = PetscSectionResetClosureDofIndex_Private(section);CHKERRQ(ierr);
+  ierr = PetscObjectGetId(obj, &section->clDofId);CHKERRQ(ierr);
+  ierr = PetscObjectStateGet(obj, &section->clDofState);CHKERRQ(ierr);
+  section->clDofStart = pStart;
+  section->clDofEnd   = pEnd;
+  section->clDofOff   = clOffsets;
+  section->clDofs     = clDofs;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "PetscSectionGetClosureDofIndex"
+/*@C
+  PetscSectionGetClosureDofIndex - Get the cache of the dof indices in the closure of a range of points in the section
+
+  Input Parameters:
++ section   - The PetscSection
+- obj       - A PetscObject which serves as the key for this index
+
+  Output Parameters:
++ pStart    - The first point with a closure in the index
+. pEnd      - One past the last point with a closure in the index
+. clOffsets - The offset of the closure of each point p in clDofs is clOffsets[p-pStart]
+- clDofs    - The dof indices in each closure, with orientations applied and constrained dofs stored as -(index+1)
+
+  Note: If there is no valid index for obj, the range is empty and the arrays are NULL. An index made for obj before its
+  state changed is dropped.
+
+  Level: developer
+
+.seealso: PetscSectionSetClosureDofIndex(), PetscSectionGetClosureIndex()
+@*/
+PetscErrorCode PetscSectionGetClosureDofIndex(PetscSection section, PetscObject obj, PetscInt *pStart, PetscInt *pEnd, const PetscInt *clOffsets[], const PetscInt *clDofs[])
+{
+  PetscObjectState state;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  if (section->clDofOff && (section->clDofId == obj->id)) {
+    ierr = PetscObjectStateGet(obj, &state);CHKERRQ(ierr);
+    if (state != section->clDofState) {ierr = PetscSectionResetClosureDofIndex_Private(section);CHKERRQ(ierr);}
+  }
+  if (section->clDofOff && (section->clDofId == obj->id)) {
+    if (pStart)    *pStart    = section->clDofStart;
+    if (pEnd)      *pEnd      = section->clDofEnd;
+    if (clOffsets) *clOffsets = section->clDofOff;
+    if (clDofs)    *clDofs    = section->clDofs;
+  } else {
+    if (pStart)    *pStart    = 0;
+    if (pEnd)      *pEnd      = 0;
+    if (clOffsets) *clOffsets = NULL;
+    if (clDofs)    *clDofs    = NULL;
+  }
+  PetscFunctionReturn(0);
+}
+
 #undef __FUNCT__
 #define __FUNCT__ "PetscSectionGetField"
 /*@
@@ -6,7 +6,18 @@ static char help[] = "Tests I/O of vectors for different data formats (binary,HD
 
 /* Note:  Most applications would not read and write a vector within
   the same program.  This example is intended only to demonstrate
-  both input and output and is written for use with either 1,2,or 4 processors. */
+  both input and output and is written for use with either 1,2,or 4 processors.
+
+  With -check_error the vector is filled with non-integer values that depend only on the global index and, instead
+  of printing the vector that was read back, the largest error of its entries is compared against the compression
+  tolerance of the binary viewer (zero unless lossy compression was requested). */
+
+#undef __FUNCT__
+#define __FUNCT__ "TestValue"
+static PetscScalar TestValue(PetscInt iglobal)
+{
+  return (PetscScalar)(100.0*PetscSinReal(0.37*iglobal) + iglobal/3.0);
+}
 
 #undef __FUNCT__
 #define __FUNCT__ "main"
@@ -16,22 +27,25 @@ int main(int argc,char **args)
   PetscMPIInt    rank,size;
   PetscInt       i,m = 20,low,high,ldim,iglobal,lsize;
   PetscScalar    v;
+  PetscScalar    *array;
+  PetscReal      tol = 0.0,err,gerr;
   Vec            u;
   PetscViewer    viewer;
-  PetscBool      vstage2,vstage3,mpiio_use,isbinary,ishdf5;
+  PetscBool      vstage2,vstage3,mpiio_use,isbinary,ishdf5,checkerror;
 #if defined(PETSC_USE_LOG)
   PetscLogEvent  VECTOR_GENERATE,VECTOR_READ;
 #endif
 
   PetscInitialize(&argc,&args,(char*)0,help);
   isbinary  = ishdf5 = PETSC_FALSE;
-  mpiio_use = vstage2 = vstage3 = PETSC_FALSE;
+  mpiio_use = vstage2 = vstage3 = checkerror = PETSC_FALSE;
 
   ierr = PetscOptionsGetBool(NULL,"-binary",&isbinary,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsGetBool(NULL,"-hdf5",&ishdf5,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsGetBool(NULL,"-mpiio",&mpiio_use,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsGetBool(NULL,"-sizes_set",&vstage2,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsGetBool(NULL,"-type_set",&vstage3,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,"-check_error",&checkerror,NULL);CHKERRQ(ierr);
 
   ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRQ(ierr);
   ierr = MPI_Comm_size(PETSC_COMM_WORLD,&size);CHKERRQ(ierr);
@@ -50,7 +64,7 @@ int main(int argc,char **args)
   ierr = VecGetLocalSize(u,&ldim);CHKERRQ(ierr);
   for (i=0; i<ldim; i++) {
     iglobal = i + low;
-    v       = (PetscScalar)(i + 100*rank);
+    v       = checkerror ? TestValue(iglobal) : (PetscScalar)(i + 100*rank);
     ierr    = VecSetValues(u,1,&iglobal,&v,INSERT_VALUES);CHKERRQ(ierr);
   }
   ierr = VecAssemblyBegin(u);CHKERRQ(ierr);
@@ -67,6 +81,7 @@ int main(int argc,char **args)
 #endif
   } else SETERRQ(PETSC_COMM_WORLD,PETSC_ERR_SUP,"No data format specified, run with either -binary or -hdf5 option\n");
   ierr = VecView(u,viewer);CHKERRQ(ierr);
+  if (isbinary) {ierr = PetscViewerBinaryGetVecCompression(viewer,NULL,&tol);CHKERRQ(ierr);}
   ierr = PetscViewerDestroy(&viewer);CHKERRQ(ierr);
   ierr = VecDestroy(&u);CHKERRQ(ierr);
   /*  ierr = PetscOptionsClear();CHKERRQ(ierr); */
@@ -121,7 +136,18 @@ int main(int argc,char **args)
   ierr = VecLoad(u,viewer);CHKERRQ(ierr);
   ierr = PetscViewerDestroy(&viewer);CHKERRQ(ierr);
   ierr = PetscLogEventEnd(VECTOR_READ,0,0,0,0);CHKERRQ(ierr);
-  ierr = VecView(u,PETSC_VIEWER_STDOUT_WORLD);CHKERRQ(ierr);
+  if (checkerror) {
+    ierr = VecGetOwnershipRange(u,&low,&high);CHKERRQ(ierr);
+    ierr = VecGetArray(u,&array);CHKERRQ(ierr);
+    for (iglobal=low,err=0.0; iglobal<high; iglobal++) err = PetscMax(err,PetscAbsScalar(array[iglobal-low]-TestValue(iglobal)));
+    ierr = VecRestoreArray(u,&array);CHKERRQ(ierr);
+    ierr = MPI_Allreduce(&err,&gerr,1,MPIU_REAL,MPIU_MAX,PETSC_COMM_WORLD);CHKERRQ(ierr);
+    if (gerr > tol) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Error %g of the vector read back exceeds the tolerance %g\n",(double)gerr,(double)tol);CHKERRQ(ierr);}
+    else if (tol > 0.0) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Vector read back is within the tolerance %g\n",(double)tol);CHKERRQ(ierr);}
+    else {ierr = PetscPrintf(PETSC_COMM_WORLD,"Vector read back is exact\n");CHKERRQ(ierr);}
+  } else {
+    ierr = VecView(u,PETSC_VIEWER_STDOUT_WORLD);CHKERRQ(ierr);
+  }
 
   /* Free data structures */
   ierr = VecDestroy(&u);CHKERRQ(ierr);
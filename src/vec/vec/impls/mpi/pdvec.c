@@ -353,11 +353,17 @@ PetscErrorCode VecView_MPI_Binary(Vec xin,PetscViewer viewer)
 #if defined(PETSC_HAVE_MPIIO)
   PetscBool         isMPIIO;
 #endif
-  PetscBool         skipHeader;
+  PetscBool         skipHeader,compress;
   PetscInt          message_count,flowcontrolcount;
   PetscViewerFormat format;
 
   PetscFunctionBegin;
+  ierr = PetscViewerSetUp(viewer);CHKERRQ(ierr); /* so that the compression options have been processed */
+  ierr = PetscViewerBinaryGetVecCompression(viewer,&compress,NULL);CHKERRQ(ierr);
+  if (compress) {
+    ierr = VecView_Binary_Compressed(xin,viewer);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = VecGetArrayRead(xin,&xarray);CHKERRQ(ierr);
   ierr = PetscViewerBinaryGetDescriptor(viewer,&fdes);CHKERRQ(ierr);
   ierr = PetscViewerBinaryGetSkipHeader(viewer,&skipHeader);CHKERRQ(ierr);
@@ -657,7 +663,8 @@ PetscErrorCode VecView_MPI_HDF5(Vec xin, PetscViewer viewer)
 
   PetscFunctionBegin;
   ierr = PetscViewerHDF5OpenGroup(viewer, &file_id, &group);CHKERRQ(ierr);
-  ierr = PetscViewerHDF5GetTimestep(viewer, &timestep);CHKERRQ(ierr);
+  ierr = PetscObjectGetName((PetscObject) xin, &vecname);CHKERRQ(ierr);
+  ierr = PetscViewerHDF5GetWriteTimestep(viewer, group, vecname, &timestep);CHKERRQ(ierr);
   ierr = PetscViewerHDF5GetBaseDimension2(viewer,&dim2);CHKERRQ(ierr);
   ierr = PetscViewerHDF5GetSPOutput(viewer,&spoutput);CHKERRQ(ierr);
 
@@ -709,12 +716,27 @@ PetscErrorCode VecView_MPI_HDF5(Vec xin, PetscViewer viewer)
   else filescalartype = H5T_NATIVE_DOUBLE;
 #endif
 
+  /* Each process defines a dataset and writes it to the hyperslab in the file, the sizes also determine the chunks */
+  dim = 0;
+  if (timestep >= 0) {
+    count[dim] = 1;
+    ++dim;
+  }
+  ierr = PetscHDF5IntCast(xin->map->n/bs,count + dim);CHKERRQ(ierr);
+  ++dim;
+  if (bs > 1 || dim2) {
+    count[dim] = bs;
+    ++dim;
+  }
+#if defined(PETSC_USE_COMPLEX)
+  count[dim] = 2;
+  ++dim;
+#endif
+
   /* Create the dataset with default properties and close filespace */
-  ierr = PetscObjectGetName((PetscObject) xin, &vecname);CHKERRQ(ierr);
   if (!H5Lexists(group, vecname, H5P_DEFAULT)) {
     /* Create chunk */
-    PetscStackCallHDF5Return(chunkspace,H5Pcreate,(H5P_DATASET_CREATE));
-    PetscStackCallHDF5(H5Pset_chunk,(chunkspace, dim, chunkDims));
+    ierr = PetscViewerHDF5CreateDatasetProperties(viewer, dim, count, chunkDims, &chunkspace);CHKERRQ(ierr);
 
 #if (H5_VERS_MAJOR * 10000 + H5_VERS_MINOR * 100 + H5_VERS_RELEASE >= 10800)
     PetscStackCallHDF5Return(dset_id,H5Dcreate2,(group, vecname, filescalartype, filespace, H5P_DEFAULT, chunkspace, H5P_DEFAULT));
@@ -728,22 +750,6 @@ PetscErrorCode VecView_MPI_HDF5(Vec xin, PetscViewer viewer)
   }
   PetscStackCallHDF5(H5Sclose,(filespace));
 
-  /* Each process defines a dataset and writes it to the hyperslab in the file */
-  dim = 0;
-  if (timestep >= 0) {
-    count[dim] = 1;
-    ++dim;
-  }
-  ierr = PetscHDF5IntCast(xin->map->n/bs,count + dim);CHKERRQ(ierr);
-  ++dim;
-  if (bs > 1 || dim2) {
-    count[dim] = bs;
-    ++dim;
-  }
-#if defined(PETSC_USE_COMPLEX)
-  count[dim] = 2;
-  ++dim;
-#endif
   if (xin->map->n > 0) {
     PetscStackCallHDF5Return(memspace,H5Screate_simple,(dim, count, NULL));
   } else {
@@ -519,10 +519,16 @@ PetscErrorCode VecView_Seq_Binary(Vec xin,PetscViewer viewer)
 #if defined(PETSC_HAVE_MPIIO)
   PetscBool         isMPIIO;
 #endif
-  PetscBool         skipHeader;
+  PetscBool         skipHeader,compress;
   PetscViewerFormat format;
 
   PetscFunctionBegin;
+  ierr = PetscViewerSetUp(viewer);CHKERRQ(ierr); /* so that the compression options have been processed */
+  ierr = PetscViewerBinaryGetVecCompression(viewer,&compress,NULL);CHKERRQ(ierr);
+  if (compress) {
+    ierr = VecView_Binary_Compressed(xin,viewer);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   /* Write vector header */
   ierr = PetscViewerBinaryGetSkipHeader(viewer,&skipHeader);CHKERRQ(ierr);
   if (!skipHeader) {
@@ -0,0 +1,351 @@
+
+/*
+   Binary input and output of vectors stored compressed, see PetscViewerBinarySetVecCompression().
+
+   A compressed vector is stored in the file as
+.vb
+       VEC_FILE_COMPRESSED_CLASSID N                  (PETSC_INT)
+       codec nchunks                                   (PETSC_INT)
+       tol                                             (PETSC_REAL)
+       length of each chunk                            (PETSC_INT[nchunks])
+       number of bytes of each compressed chunk       (PETSC_INT[nchunks])
+       the compressed chunks
+.ve
+   where a chunk is the part of the vector owned by one process when it was written. Each chunk is compressed on its
+   own by the process owning it, so the work is done in parallel and the chunks can be sent compressed to their owners
+   when the vector is loaded with the same layout. A chunk that does not compress is stored uncompressed, which is
+   indicated by its number of bytes being equal to its uncompressed size.
+*/
+#include <petsc/private/vecimpl.h>    /*I  "petscvec.h"  I*/
+
+/* real values, big-endian, byte shuffled and compressed */
+#define VEC_COMPRESS_SHUFFLE  1
+/* real values rounded to multiples of 2*tol, stored as zigzag encoded 64 bit integers, byte shuffled and compressed */
+#define VEC_COMPRESS_QUANTIZE 2
+
+#if defined(PETSC_USE_COMPLEX)
+#define VEC_COMPRESS_RS 2
+#else
+#define VEC_COMPRESS_RS 1
+#endif
+
+#undef __FUNCT__
+#define __FUNCT__ "VecCompressRawSize_Private"
+static PetscErrorCode VecCompressRawSize_Private(PetscInt codec,PetscInt n,size_t *raw)
+{
+  PetscFunctionBegin;
+  *raw = (size_t)n*VEC_COMPRESS_RS*(codec == VEC_COMPRESS_QUANTIZE ? 8 : sizeof(PetscReal));
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "VecCompressQuantizable_Private"
+/* checks if the values can be rounded to integer multiples of 2*tol that fit in 64 bits */
+static PetscErrorCode VecCompressQuantizable_Private(const PetscScalar *x,PetscInt n,PetscReal tol,PetscBool *flg)
+{
+  const PetscReal *r = (const PetscReal*)x;
+  PetscReal       qmax = 4611686018427387904.0; /* 2^62 */
+  PetscInt        i;
+
+  PetscFunctionBegin;
+  *flg = PETSC_TRUE;
+  for (i=0; i<n*VEC_COMPRESS_RS; i++) {
+    if (PetscIsInfOrNanReal(r[i]) || PetscAbsReal(r[i])/(2.0*tol) >= qmax) {*flg = PETSC_FALSE; break;}
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "VecCompressEncode_Private"
+/* compresses n scalars into a newly allocated buffer of *nbytes bytes */
+static PetscErrorCode VecCompressEncode_Private(const PetscScalar *x,PetscInt n,PetscInt codec,PetscReal tol,unsigned char **buf,size_t *nbytes)
+{
+  const PetscReal *r = (const PetscReal*)x;
+  PetscInt        i,nr = n*VEC_COMPRESS_RS;
+  size_t          raw,len;
+  unsigned char   *work;
+  PetscErrorCode  ierr;
+
+  PetscFunctionBegin;
+  ierr = VecCompressRawSize_Private(codec,n,&raw);CHKERRQ(ierr);
+  ierr = PetscMalloc1(raw+1,buf);CHKERRQ(ierr);
+  ierr = PetscMalloc1(raw+1,&work);CHKERRQ(ierr);
+  if (codec == VEC_COMPRESS_QUANTIZE) {
+    for (i=0; i<nr; i++) {
+      Petsc64bitInt      q = (Petsc64bitInt)PetscFloorReal(r[i]/(2.0*tol) + 0.5);
+      unsigned long long z = ((unsigned long long)q << 1) ^ (unsigned long long)(q >> 63);
+      int                b;
+
+      for (b=0; b<8; b++) (*buf)[8*i+b] = (unsigned char)(z >> (56 - 8*b));
+    }
+    ierr = PetscByteShuffle(*buf,work,nr,8);CHKERRQ(ierr);
+  } else {
+    ierr = PetscMemcpy(*buf,r,raw);CHKERRQ(ierr);
+#if !defined(PETSC_WORDS_BIGENDIAN)
+    ierr = PetscByteSwap(*buf,PETSC_REAL,nr);CHKERRQ(ierr);
+#endif
+    ierr = PetscByteShuffle(*buf,work,nr,sizeof(PetscReal));CHKERRQ(ierr);
+  }
+  ierr = PetscLZCompress(work,raw,*buf,raw ? raw-1 : 0,&len);CHKERRQ(ierr);
+  if (!len) {
+    ierr = PetscMemcpy(*buf,work,raw);CHKERRQ(ierr);
+    len  = raw;
+  }
+  ierr    = PetscFree(work);CHKERRQ(ierr);
+  *nbytes = len;
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "VecCompressDecode_Private"
+/* decompresses nbytes bytes into n scalars */
+static PetscErrorCode VecCompressDecode_Private(const unsigned char *buf,size_t nbytes,PetscInt codec,PetscReal tol,PetscScalar *x,PetscInt n)
+{
+  PetscReal      *r = (PetscReal*)x;
+  PetscInt       i,nr = n*VEC_COMPRESS_RS;
+  size_t         raw;
+  unsigned char  *work,*shuffled;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecCompressRawSize_Private(codec,n,&raw);CHKERRQ(ierr);
+  if (nbytes > raw) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED,"Compressed chunk has %D bytes, more than its uncompressed size %D",(PetscInt)nbytes,(PetscInt)raw);
+  ierr = PetscMalloc2(raw+1,&work,raw+1,&shuffled);CHKERRQ(ierr);
+  if (nbytes == raw) {
+    ierr = PetscMemcpy(shuffled,buf,raw);CHKERRQ(ierr);
+  } else {
+    ierr = PetscLZDecompress(buf,nbytes,shuffled,raw);CHKERRQ(ierr);
+  }
+  if (codec == VEC_COMPRESS_QUANTIZE) {
+    ierr = PetscByteUnshuffle(shuffled,work,nr,8);CHKERRQ(ierr);
+    for (i=0; i<nr; i++) {
+      unsigned long long z = 0;
+      Petsc64bitInt      q;
+      int                b;
+
+      for (b=0; b<8; b++) z = (z << 8) | work[8*i+b];
+      q    = (Petsc64bitInt)(z >> 1) ^ -(Petsc64bitInt)(z & 1);
+      r[i] = (PetscReal)q*2.0*tol;
+    }
+  } else {
+    ierr = PetscByteUnshuffle(shuffled,r,nr,sizeof(PetscReal));CHKERRQ(ierr);
+#if !defined(PETSC_WORDS_BIGENDIAN)
+    ierr = PetscByteSwap(r,PETSC_REAL,nr);CHKERRQ(ierr);
+#endif
+  }
+  ierr = PetscFree2(work,shuffled);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "VecView_Binary_Compressed"
+PetscErrorCode VecView_Binary_Compressed(Vec xin,PetscViewer viewer)
+{
+  PetscErrorCode    ierr;
+  MPI_Comm          comm;
+  PetscMPIInt       rank,size,tag = ((PetscObject)viewer)->tag,mesgsize;
+  PetscInt          j,codec,tr[2],info[2],*sizes = NULL,*lens = NULL,maxbytes,message_count,flowcontrolcount;
+  int               fdes;
+  const PetscScalar *xarray;
+  unsigned char     *buf,*values;
+  size_t            nbytes = 0;
+  PetscReal         tol;
+  PetscBool         skipHeader,flg;
+  MPI_Status        status;
+  FILE              *file;
+#if defined(PETSC_HAVE_MPIIO)
+  PetscBool         isMPIIO;
+#endif
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)xin,&comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+  ierr = PetscViewerBinaryGetSkipHeader(viewer,&skipHeader);CHKERRQ(ierr);
+  if (skipHeader) SETERRQ(PetscObjectComm((PetscObject)viewer),PETSC_ERR_SUP,"Cannot compress vectors written without a header");
+#if defined(PETSC_HAVE_MPIIO)
+  ierr = PetscViewerBinaryGetUseMPIIO(viewer,&isMPIIO);CHKERRQ(ierr);
+  if (isMPIIO) SETERRQ(PetscObjectComm((PetscObject)viewer),PETSC_ERR_SUP,"Cannot compress vectors written with MPI-IO");
+#endif
+  ierr = PetscViewerBinaryGetDescriptor(viewer,&fdes);CHKERRQ(ierr);
+  ierr = PetscViewerBinaryGetVecCompression(viewer,NULL,&tol);CHKERRQ(ierr);
+
+  ierr  = VecGetArrayRead(xin,&xarray);CHKERRQ(ierr);
+  codec = VEC_COMPRESS_SHUFFLE;
+  if (tol > 0.0) {
+    PetscMPIInt lflg,gflg;
+
+    ierr = VecCompressQuantizable_Private(xarray,xin->map->n,tol,&flg);CHKERRQ(ierr);
+    lflg = (PetscMPIInt)flg;
+    ierr = MPI_Allreduce(&lflg,&gflg,1,MPI_INT,MPI_MIN,comm);CHKERRQ(ierr);
+    if (gflg) codec = VEC_COMPRESS_QUANTIZE;
+    else {
+      ierr = PetscInfo1(viewer,"Vector has entries too large for tolerance %g, compressing it losslessly\n",(double)tol);CHKERRQ(ierr);
+      tol  = 0.0;
+    }
+  }
+  ierr = VecCompressEncode_Private(xarray,xin->map->n,codec,tol,&buf,&nbytes);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xin,&xarray);CHKERRQ(ierr);
+  if (nbytes > (size_t)PETSC_MAX_INT) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Local part of vector too large to compress, use more processes");
+  info[0] = xin->map->n;
+  info[1] = (PetscInt)nbytes;
+
+  if (!rank) {ierr = PetscMalloc2(size,&lens,size,&sizes);CHKERRQ(ierr);}
+  ierr = MPI_Gather(info,1,MPIU_INT,lens,1,MPIU_INT,0,comm);CHKERRQ(ierr);
+  ierr = MPI_Gather(info+1,1,MPIU_INT,sizes,1,MPIU_INT,0,comm);CHKERRQ(ierr);
+
+  tr[0] = VEC_FILE_COMPRESSED_CLASSID;
+  tr[1] = xin->map->N;
+  ierr  = PetscViewerBinaryWrite(viewer,tr,2,PETSC_INT,PETSC_FALSE);CHKERRQ(ierr);
+  tr[0] = codec;
+  tr[1] = size;
+  ierr  = PetscViewerBinaryWrite(viewer,tr,2,PETSC_INT,PETSC_FALSE);CHKERRQ(ierr);
+  ierr  = PetscViewerBinaryWrite(viewer,&tol,1,PETSC_REAL,PETSC_FALSE);CHKERRQ(ierr);
+  ierr  = PetscViewerBinaryWrite(viewer,lens,size,PETSC_INT,PETSC_FALSE);CHKERRQ(ierr);
+  ierr  = PetscViewerBinaryWrite(viewer,sizes,size,PETSC_INT,PETSC_FALSE);CHKERRQ(ierr);
+
+  ierr = PetscViewerFlowControlStart(viewer,&message_count,&flowcontrolcount);CHKERRQ(ierr);
+  if (!rank) {
+    ierr = PetscBinaryWrite(fdes,buf,(PetscInt)nbytes,PETSC_CHAR,PETSC_FALSE);CHKERRQ(ierr);
+
+    maxbytes = 0;
+    for (j=1; j<size; j++) maxbytes = PetscMax(maxbytes,sizes[j]);
+    ierr = PetscMalloc1(maxbytes,&values);CHKERRQ(ierr);
+    /* receive and save the compressed parts */
+    for (j=1; j<size; j++) {
+      ierr = PetscViewerFlowControlStepMaster(viewer,j,&message_count,flowcontrolcount);CHKERRQ(ierr);
+      ierr = PetscMPIIntCast(sizes[j],&mesgsize);CHKERRQ(ierr);
+      ierr = MPI_Recv(values,mesgsize,MPI_BYTE,j,tag,comm,&status);CHKERRQ(ierr);
+      ierr = PetscBinaryWrite(fdes,values,sizes[j],PETSC_CHAR,PETSC_TRUE);CHKERRQ(ierr);
+    }
+    ierr = PetscViewerFlowControlEndMaster(viewer,&message_count);CHKERRQ(ierr);
+    ierr = PetscFree(values);CHKERRQ(ierr);
+    ierr = PetscFree2(lens,sizes);CHKERRQ(ierr);
+  } else {
+    ierr = PetscViewerFlowControlStepWorker(viewer,rank,&message_count);CHKERRQ(ierr);
+    ierr = PetscMPIIntCast(info[1],&mesgsize);CHKERRQ(ierr);
+    ierr = MPI_Send(buf,mesgsize,MPI_BYTE,0,tag,comm);CHKERRQ(ierr);
+    ierr = PetscViewerFlowControlEndWorker(viewer,&message_count);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(buf);CHKERRQ(ierr);
+
+  if (!rank) {
+    ierr = PetscViewerBinaryGetInfoPointer(viewer,&file);CHKERRQ(ierr);
+    if (file) {
+      if (((PetscObject)xin)->prefix) {
+        ierr = PetscFPrintf(PETSC_COMM_SELF,file,"-%svecload_block_size %D\n",((PetscObject)xin)->prefix,PetscAbs(xin->map->bs));CHKERRQ(ierr);
+      } else {
+        ierr = PetscFPrintf(PETSC_COMM_SELF,file,"-vecload_block_size %D\n",PetscAbs(xin->map->bs));CHKERRQ(ierr);
+      }
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+#undef __FUNCT__
+#define __FUNCT__ "VecLoad_Binary_Compressed"
+/*
+   Reads the part of a compressed vector following its header; the size of vec has already been set
+*/
+PetscErrorCode VecLoad_Binary_Compressed(Vec vec,PetscViewer viewer)
+{
+  PetscErrorCode ierr;
+  MPI_Comm       comm;
+  PetscMPIInt    rank,size,tag,cnt;
+  PetscInt       tr[2],codec,nchunks,*lens,*sizes,j,r,N = 0,maxbytes = 0,maxlen = 0,start,end,lo,hi;
+  PetscInt       *range = vec->map->range;
+  PetscReal      tol;
+  PetscScalar    *avec,*work = NULL;
+  unsigned char  *buf = NULL;
+  PetscBool      samelayout;
+  int            fd;
+  MPI_Status     status;
+#if defined(PETSC_HAVE_MPIIO)
+  PetscBool      useMPIIO;
+#endif
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)viewer,&comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm,&size);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_MPIIO)
+  ierr = PetscViewerBinaryGetUseMPIIO(viewer,&useMPIIO);CHKERRQ(ierr);
+  if (useMPIIO) SETERRQ(comm,PETSC_ERR_SUP,"Cannot load compressed vectors with MPI-IO");
+#endif
+  ierr = PetscViewerBinaryGetDescriptor(viewer,&fd);CHKERRQ(ierr);
+  ierr = PetscObjectGetNewTag((PetscObject)viewer,&tag);CHKERRQ(ierr);
+
+  ierr    = PetscViewerBinaryRead(viewer,tr,2,NULL,PETSC_INT);CHKERRQ(ierr);
+  codec   = tr[0];
+  nchunks = tr[1];
+  if (codec != VEC_COMPRESS_SHUFFLE && codec != VEC_COMPRESS_QUANTIZE) SETERRQ1(comm,PETSC_ERR_FILE_UNEXPECTED,"Unknown vector compression codec %D in file",codec);
+  if (nchunks < 0) SETERRQ1(comm,PETSC_ERR_FILE_UNEXPECTED,"Invalid number of compressed chunks %D in file",nchunks);
+  ierr = PetscViewerBinaryRead(viewer,&tol,1,NULL,PETSC_REAL);CHKERRQ(ierr);
+  ierr = PetscMalloc2(nchunks,&lens,nchunks,&sizes);CHKERRQ(ierr);
+  ierr = PetscViewerBinaryRead(viewer,lens,nchunks,NULL,PETSC_INT);CHKERRQ(ierr);
+  ierr = PetscViewerBinaryRead(viewer,sizes,nchunks,NULL,PETSC_INT);CHKERRQ(ierr);
+  for (j=0; j<nchunks; j++) {
+    if (lens[j] < 0 || sizes[j] < 0) SETERRQ(comm,PETSC_ERR_FILE_UNEXPECTED,"Corrupt compressed vector header");
+    N       += lens[j];
+    maxbytes = PetscMax(maxbytes,sizes[j]);
+    maxlen   = PetscMax(maxlen,lens[j]);
+  }
+  if (N != vec->map->N) SETERRQ2(comm,PETSC_ERR_FILE_UNEXPECTED,"Compressed vector in file has length %D, not %D",N,vec->map->N);
+  /* when the vector is loaded with the layout it was written with each process decompresses its own part */
+  samelayout = (PetscBool)(nchunks == size);
+  for (j=0; samelayout && j<nchunks; j++) if (lens[j] != range[j+1]-range[j]) samelayout = PETSC_FALSE;
+
+  ierr = VecGetArray(vec,&avec);CHKERRQ(ierr);
+  if (samelayout) {
+    if (!rank) {
+      ierr = PetscMalloc1(maxbytes,&buf);CHKERRQ(ierr);
+      ierr = PetscBinaryRead(fd,buf,sizes[0],PETSC_CHAR);CHKERRQ(ierr);
+      ierr = VecCompressDecode_Private(buf,(size_t)sizes[0],codec,tol,avec,lens[0]);CHKERRQ(ierr);
+      for (j=1; j<size; j++) {
+        ierr = PetscBinaryRead(fd,buf,sizes[j],PETSC_CHAR);CHKERRQ(ierr);
+        ierr = PetscMPIIntCast(sizes[j],&cnt);CHKERRQ(ierr);
+        ierr = MPI_Send(buf,cnt,MPI_BYTE,j,tag,comm);CHKERRQ(ierr);
+      }
+    } else {
+      ierr = PetscMalloc1(sizes[rank],&buf);CHKERRQ(ierr);
+      ierr = PetscMPIIntCast(sizes[rank],&cnt);CHKERRQ(ierr);
+      ierr = MPI_Recv(buf,cnt,MPI_BYTE,0,tag,comm,&status);CHKERRQ(ierr);
+      ierr = VecCompressDecode_Private(buf,(size_t)sizes[rank],codec,tol,avec,lens[rank]);CHKERRQ(ierr);
+    }
+  } else {
+    /* the first process decompresses each chunk and sends its pieces to the processes owning them */
+    if (!rank) {
+      ierr = PetscMalloc1(maxbytes,&buf);CHKERRQ(ierr);
+      ierr = PetscMalloc1(maxlen,&work);CHKERRQ(ierr);
+    }
+    for (j=0,start=0; j<nchunks; start+=lens[j],j++) {
+      end = start + lens[j];
+      if (!rank) {
+        ierr = PetscBinaryRead(fd,buf,sizes[j],PETSC_CHAR);CHKERRQ(ierr);
+        ierr = VecCompressDecode_Private(buf,(size_t)sizes[j],codec,tol,work,lens[j]);CHKERRQ(ierr);
+      }
+      for (r=0; r<size; r++) {
+        lo = PetscMax(start,range[r]);
+        hi = PetscMin(end,range[r+1]);
+        if (lo >= hi) continue;
+        ierr = PetscMPIIntCast(hi-lo,&cnt);CHKERRQ(ierr);
+        if (!rank) {
+          if (!r) {
+            ierr = PetscMemcpy(avec+lo,work+lo-start,(hi-lo)*sizeof(PetscScalar));CHKERRQ(ierr);
+          } else {
+            ierr = MPI_Send(work+lo-start,cnt,MPIU_SCALAR,r,tag,comm);CHKERRQ(ierr);
+          }
+        } else if (r == rank) {
+          ierr = MPI_Recv(avec+lo-range[rank],cnt,MPIU_SCALAR,0,tag,comm,&status);CHKERRQ(ierr);
+        }
+      }
+    }
+    ierr = PetscFree(work);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(buf);CHKERRQ(ierr);
+  ierr = PetscFree2(lens,sizes);CHKERRQ(ierr);
+  ierr = VecRestoreArray(vec,&avec);CHKERRQ(ierr);
+  ierr = VecAssemblyBegin(vec);CHKERRQ(ierr);
+  ierr = VecAssemblyEnd(vec);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
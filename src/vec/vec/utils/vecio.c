@@ -13,7 +13,7 @@
 
 #undef __FUNCT__
 #define __FUNCT__ "PetscViewerBinaryReadVecHeader_Private"
-static PetscErrorCode PetscViewerBinaryReadVecHeader_Private(PetscViewer viewer,PetscInt *rows)
+static PetscErrorCode PetscViewerBinaryReadVecHeader_Private(PetscViewer viewer,PetscInt *rows,PetscBool *compressed)
 {
   PetscErrorCode ierr;
   MPI_Comm       comm;
@@ -24,12 +24,13 @@ static PetscErrorCode PetscViewerBinaryReadVecHeader_Private(PetscViewer viewer,
   /* Read vector header */
   ierr = PetscViewerBinaryRead(viewer,tr,2,NULL,PETSC_INT);CHKERRQ(ierr);
   type = tr[0];
-  if (type != VEC_FILE_CLASSID) {
+  if (type != VEC_FILE_CLASSID && type != VEC_FILE_COMPRESSED_CLASSID) {
     ierr = PetscLogEventEnd(VEC_Load,viewer,0,0,0);CHKERRQ(ierr);
     if (type == MAT_FILE_CLASSID) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONG,"Matrix is next in file, not a vector as you requested");
     else SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONG,"Not a vector next in file");
   }
-  *rows = tr[1];
+  *rows       = tr[1];
+  *compressed = (PetscBool)(type == VEC_FILE_COMPRESSED_CLASSID);
   PetscFunctionReturn(0);
 }
 
@@ -70,7 +71,7 @@ PetscErrorCode VecLoad_Binary(Vec vec, PetscViewer viewer)
   int            fd;
   PetscInt       i,rows = 0,n,*range,N,bs;
   PetscErrorCode ierr;
-  PetscBool      flag,skipheader;
+  PetscBool      flag,skipheader,compressed = PETSC_FALSE;
   PetscScalar    *avec,*avecwork;
   MPI_Comm       comm;
   MPI_Request    request;
@@ -89,7 +90,7 @@ PetscErrorCode VecLoad_Binary(Vec vec, PetscViewer viewer)
   ierr = PetscViewerBinaryGetDescriptor(viewer,&fd);CHKERRQ(ierr);
   ierr = PetscViewerBinaryGetSkipHeader(viewer,&skipheader);CHKERRQ(ierr);
   if (!skipheader) {
-    ierr = PetscViewerBinaryReadVecHeader_Private(viewer,&rows);CHKERRQ(ierr);
+    ierr = PetscViewerBinaryReadVecHeader_Private(viewer,&rows,&compressed);CHKERRQ(ierr);
   } else {
     VecType vtype;
     ierr = VecGetType(vec,&vtype);CHKERRQ(ierr);
@@ -111,6 +112,11 @@ PetscErrorCode VecLoad_Binary(Vec vec, PetscViewer viewer)
   ierr = VecGetSize(vec, &N);CHKERRQ(ierr);
   if (N != rows) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_FILE_UNEXPECTED, "Vector in file different length (%D) then input vector (%D)", rows, N);
 
+  if (compressed) {
+    ierr = VecLoad_Binary_Compressed(vec,viewer);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+
 #if defined(PETSC_HAVE_MPIIO)
   ierr = PetscViewerBinaryGetUseMPIIO(viewer,&useMPIIO);CHKERRQ(ierr);
   if (useMPIIO) {